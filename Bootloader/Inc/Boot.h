@@ -0,0 +1,107 @@
+/*
+ * Boot.h
+ *
+ *  CAN 부트로더 UDS 서버 (ISO 14229-1 프로그래밍 서비스, ISO-TP 는 Core/Src/IsoTp.c 공유)
+ *  - 주소: 요청 0x7E0 / 기능 0x7DF, 응답 0x7E8 (애플리케이션과 같음)
+ *  - 0x10 01/02, 0x11 01, 0x3E, 0x31 01 FF00 (메모리 지우기), 0x34 / 0x36 / 0x37
+ *  - 순서: 10 02 → 31 01 FF00 44 addr size → 34 00 44 addr size → 36 ... → 37 [crc] → 11 01
+ *  - 0x34 응답 maxNumberOfBlockLength = 2 + FLASHPROG_BLOCK_MAX (SID + BSC + 데이터)
+ *  - 0x34 dataFormatIdentifier: 0x00 = 그대로, 0x10 = heatshrink 압축 (memorySize 는 풀린 크기,
+ *    0x36 블록 길이 제한 없음 → FlashTask 가 풀어서 기록, 0x37 CRC 도 풀린 이미지 기준)
+ *  - 0x36 은 블록을 FlashTask 에 넘기고 바로 응답 (기록은 다음 블록 수신과 겹침)
+ *  - 0x37 = 남은 기록 완료 대기 → 테스터 CRC 비교 → 앱 시작 주소부터 받은 이미지면 부트 정보 기록
+ *  - 부팅: 유효한 앱이면 BOOT_WINDOW_MS 동안 요청을 기다리고, 없으면 앱으로 (Boot_Reset)
+ */
+
+#ifndef INC_BOOT_H_
+#define INC_BOOT_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "FlashProg.h"
+#include <stdint.h>
+
+#define BOOT_REQ_CANID          0x7E0u
+#define BOOT_FUNC_CANID         0x7DFu
+#define BOOT_RES_CANID          0x7E8u
+
+#define BOOT_WINDOW_MS          50u
+#define BOOT_S3_MS              5000u
+#define BOOT_RX_DEPTH           32u       // CF 연속 수신 (FC BS=0)
+#define BOOT_REQ_MAX            32u       // 0x36 이외 요청
+#define BOOT_BUF_WAIT_MS        500u      // 빈 수신 버퍼 대기 (테스터 N_Bs 1s 안)
+#define BOOT_PROG_WAIT_MS       2000u
+
+/* 세션 */
+#define BOOT_SESSION_DEFAULT      0x01u
+#define BOOT_SESSION_PROGRAMMING  0x02u
+
+/* 서비스 */
+#define BOOT_SVC_SESSION          0x10u
+#define BOOT_SVC_ECU_RESET        0x11u
+#define BOOT_SVC_ROUTINE          0x31u
+#define BOOT_SVC_REQUEST_DOWNLOAD 0x34u
+#define BOOT_SVC_TRANSFER_DATA    0x36u
+#define BOOT_SVC_TRANSFER_EXIT    0x37u
+#define BOOT_SVC_TESTER_PRESENT   0x3Eu
+#define BOOT_SID_NEGATIVE         0x7Fu
+#define BOOT_SPRMIB               0x80u
+
+#define BOOT_RID_ERASE_MEMORY     0xFF00u
+#define BOOT_ALFID                0x44u   // 주소 4B + 크기 4B
+#define BOOT_DFI_RAW              0x00u
+#define BOOT_DFI_HEATSHRINK       0x10u   // compressionMethod 1, 암호화 없음
+
+/* NRC */
+#define BOOT_NRC_SERVICE_NOT_SUPPORTED     0x11u
+#define BOOT_NRC_SUBFUNC_NOT_SUPPORTED     0x12u
+#define BOOT_NRC_INCORRECT_LENGTH          0x13u
+#define BOOT_NRC_CONDITIONS_NOT_CORRECT    0x22u
+#define BOOT_NRC_REQUEST_SEQUENCE_ERROR    0x24u
+#define BOOT_NRC_REQUEST_OUT_OF_RANGE      0x31u
+#define BOOT_NRC_UPLOAD_DOWNLOAD_REJECTED  0x70u
+#define BOOT_NRC_TRANSFER_SUSPENDED        0x71u
+#define BOOT_NRC_PROGRAMMING_FAILURE       0x72u
+#define BOOT_NRC_WRONG_BLOCK_SEQUENCE      0x73u
+#define BOOT_NRC_RESPONSE_PENDING          0x78u
+#define BOOT_NRC_SERVICE_NOT_IN_SESSION    0x7Fu
+
+/* Boot_Reset 이후 동작 (noinit 변수, 리셋 직후 main 에서 확인) */
+#define BOOT_FLAG_NONE          0u
+#define BOOT_FLAG_JUMP          0x4A4D5021u   // 주변장치 초기화 전에 바로 앱으로
+
+typedef struct {
+    uint8_t  data[8];
+    uint8_t  functional;
+} Boot_RxFrame_t;
+
+typedef struct {
+    uint8_t  session;
+    uint8_t  stay;                // 요청을 받았거나 앱이 없음 → 창이 지나도 남음
+    uint8_t  overlap;             // 0 = 0x36 마다 기록 완료 후 응답 (비교용)
+
+    /* 0x34 ~ 0x37 */
+    uint8_t  active;
+    uint8_t  bsc;                 // 마지막으로 수락한 blockSequenceCounter
+    uint8_t  method;              // FLASHPROG_METHOD_* (dataFormatIdentifier 상위 nibble)
+    uint32_t addr, size;          // size = 풀린 이미지 크기
+    uint32_t done;                // 수락한 0x36 데이터 (압축 전송이면 압축된 바이트)
+
+    uint32_t requests;
+    uint32_t blocks;
+    uint32_t repeats;             // 같은 BSC 재전송 (기록하지 않고 긍정 응답)
+    uint32_t resets;
+    uint32_t last_rx_tick;
+} Boot_State_t;
+
+extern Boot_State_t bootState;
+extern osMessageQueueId_t BootQueueHandle;
+
+// stay = 앱으로 가지 않음 (앱 무효/앱이 요청). 커널 객체 생성 후
+void     Boot_Init(uint8_t stay);
+void     StartBootTask(void *argument);
+
+/* 플랫폼 (boot_main.c / 호스트 보드): 응답 송신 후 리셋. flag = BOOT_FLAG_* */
+void     Boot_Reset(uint32_t flag);
+
+#endif /* INC_BOOT_H_ */
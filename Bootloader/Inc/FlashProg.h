@@ -0,0 +1,133 @@
+/*
+ * FlashProg.h
+ *
+ *  부트로더 내장 flash 기록 (STM32F413ZH, 1.5MB 단일 bank)
+ *  - 배치: 부트로더 sector 0~2 (48K) / 부트 정보 sector 3 / 애플리케이션 sector 4~15
+ *  - 이중 수신 버퍼: BootTask 가 한 버퍼에 0x36 블록을 받는 동안 FlashTask 가 다른 버퍼를
+ *    word 단위로 기록 → CAN 수신과 flash 기록이 겹침 (기록 중 CPU 정지는 word 당 16us)
+ *  - 기록한 word 는 바로 읽어 비교, 지워진 값 그대로인 word 는 건너뜀
+ *  - 기록한 데이터의 CRC-32 는 FlashTask 가 누적 (0x37 에서 다시 읽지 않고 비교)
+ *  - 기록 오류는 다음 0x36 / 0x37 에서 보고 (NRC 0x72)
+ *  - 압축 전송 (Begin method = FLASHPROG_METHOD_HS): FlashTask 가 블록을 HsDecode 로 풀어
+ *    staging 버퍼가 word 로 차는 대로 이어서 기록 (블록 경계는 압축 스트림 어디든 됨)
+ */
+
+#ifndef INC_FLASHPROG_H_
+#define INC_FLASHPROG_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "HsDecode.h"
+#include <stdint.h>
+
+#define FLASHPROG_BOOT_START   0x08000000u
+#define FLASHPROG_INFO_ADDR    0x0800C000u        // sector 3
+#define FLASHPROG_INFO_SECTOR  3u
+#define FLASHPROG_DIRTY_ADDR   (FLASHPROG_INFO_ADDR + 0x20u)   // 0 = 31 01 이 부트 정보를 지움 (다운로드 시작)
+#define FLASHPROG_APP_START    0x08010000u        // sector 4 (앱 벡터 테이블)
+#define FLASHPROG_APP_END      0x08180000u
+#define FLASHPROG_SECTORS      16u
+#define FLASHPROG_RAM_START    0x20000000u        // 앱 초기 SP 범위 (벡터 테이블 확인)
+#define FLASHPROG_RAM_END      0x20050000u
+
+#define FLASHPROG_BLOCK_MAX    1024u              // 0x36 블록 데이터 (word 배수)
+#define FLASHPROG_NBUF         2u
+#define FLASHPROG_INFO_MAGIC   0xB007A55Au
+#define FLASHPROG_STAGE        256u               // 압축 해제 출력 → word 기록
+
+/* 전송 형식 (0x34 dataFormatIdentifier 상위 nibble) */
+#define FLASHPROG_METHOD_RAW   0u
+#define FLASHPROG_METHOD_HS    1u                 // HsDecode (heatshrink -w 11 -l 4)
+
+/* flash 읽기: 타깃은 주소 그대로, 호스트는 flash 모델 */
+#ifdef HOST_BUILD
+const uint8_t* HostFlash_Ptr(uint32_t addr);
+#define FLASHPROG_PTR(addr)    HostFlash_Ptr(addr)
+/* 호스트: 압축 해제 CPU 시간 (Cortex-M4 출력 바이트당 추정 cycle, 비트 단위 읽기 + 창 복사) */
+void HostSim_CpuCycles(uint32_t cycles);
+#define FLASHPROG_CPU(cycles)  HostSim_CpuCycles(cycles)
+#else
+#define FLASHPROG_PTR(addr)    ((const uint8_t*)(addr))
+#define FLASHPROG_CPU(cycles)  ((void)0)
+#endif
+#define FLASHPROG_DECODE_CYCLES  40u
+
+/* sector 3 첫 20B. 지운 상태(0xFF) = 부트로더로 받은 앱 없음
+ * (dirty 도 지운 상태면 디버거로 올린 앱: 벡터 테이블만 확인) */
+typedef struct {
+    uint32_t magic;
+    uint32_t start;
+    uint32_t size;
+    uint32_t crc;                 // [start, start + size) CRC-32
+    uint32_t magic_inv;
+} FlashProg_Info_t;
+
+typedef struct {
+    uint8_t  buf;                 // 수신 버퍼 index
+    uint16_t off;                 // 버퍼 안 데이터 시작 (0x36 SID + BSC 다음)
+    uint16_t len;
+    uint32_t addr;
+} FlashProg_Job_t;
+
+typedef struct {
+    uint8_t  buf[FLASHPROG_NBUF][2u + FLASHPROG_BLOCK_MAX];   // 0x36 요청 전체 (ISO-TP 재조립 대상)
+    uint8_t  next;                // 다음에 내줄 버퍼
+    osSemaphoreId_t    free;      // 빈 버퍼 수
+    osMessageQueueId_t jobs;      // BootTask → FlashTask
+    osSemaphoreId_t    done;      // 작업 1 개 끝남 (Wait 용)
+
+    volatile uint32_t pending;    // 대기 + 기록 중 작업 수
+    volatile HAL_StatusTypeDef status;    // 첫 오류 (다음 Begin 까지 유지)
+    volatile uint32_t err_addr;
+    volatile uint32_t crc;        // Begin 이후 기록한 데이터 CRC-32
+    uint32_t erased;              // 이번 전원 주기에 지운 sector (bit)
+
+    /* Begin 이후 기록 위치 (압축 해제 출력 순서) */
+    uint8_t  method;              // FLASHPROG_METHOD_*
+    uint32_t addr, size;
+    volatile uint32_t out;        // 기록한 바이트 (원래 이미지 기준)
+    HsDecode_t hs;
+    uint8_t  stage[FLASHPROG_STAGE];
+    uint16_t fill;
+
+    uint32_t blocks, words;
+    uint32_t buf_waits;           // 빈 버퍼를 기다린 횟수 (기록이 수신보다 느림)
+} FlashProg_t;
+
+extern FlashProg_t flashProg;
+
+void              FlashProg_Init(FlashProg_t* fp);
+// 주소 → sector (범위 밖 0xFF), sector → 시작 주소/크기
+uint8_t           FlashProg_Sector(uint32_t addr);
+uint32_t          FlashProg_SectorAddr(uint8_t sector);
+uint32_t          FlashProg_SectorSize(uint8_t sector);
+// sector 1 개 지움 (차단: 16K 250ms ~ 128K 1s)
+HAL_StatusTypeDef FlashProg_EraseSector(FlashProg_t* fp, uint8_t sector);
+// [addr, addr + len) 의 sector 가 모두 지워져 있음 (이번 전원 주기에 지운 것만 인정)
+uint8_t           FlashProg_IsErased(const FlashProg_t* fp, uint32_t addr, uint32_t len);
+
+// 새 다운로드 [addr, addr + size) (size = 원래 이미지 크기): 오류/CRC/압축 해제 상태 초기화
+void              FlashProg_Begin(FlashProg_t* fp, uint32_t addr, uint32_t size, uint8_t method);
+// 빈 수신 버퍼 (두 버퍼가 모두 기록 대기 중이면 하나가 끝날 때까지 대기). 시간 초과 NULL
+uint8_t*          FlashProg_GetBuffer(FlashProg_t* fp, uint32_t timeout_ms);
+// 방금 받은 버퍼를 기록하지 않고 되돌림 (거절/중복 블록)
+void              FlashProg_PutBack(FlashProg_t* fp);
+// 방금 받은 버퍼의 [off, off + len) 을 addr 에 기록하도록 FlashTask 에 넘김 (즉시 반환)
+// 압축 전송이면 addr 는 무시 (풀린 데이터는 Begin 주소부터 이어서)
+HAL_StatusTypeDef FlashProg_Submit(FlashProg_t* fp, uint16_t off, uint16_t len, uint32_t addr);
+// 넘긴 작업이 모두 끝날 때까지 대기 → 누적 상태
+HAL_StatusTypeDef FlashProg_Wait(FlashProg_t* fp, uint32_t timeout_ms);
+
+// 부트 정보 기록 (sector 3 은 지워져 있어야 함) / 유효한 앱 확인 (full = CRC 까지)
+// 부트 정보가 없으면: dirty 가 지운 상태이고 벡터 테이블 (SP, reset) 이 맞을 때만 유효
+HAL_StatusTypeDef FlashProg_WriteInfo(FlashProg_t* fp, uint32_t start, uint32_t size, uint32_t crc);
+uint8_t           FlashProg_AppValid(uint8_t full);
+// sector 3 을 지운 직후: 다운로드가 끝나기 전 (부트 정보 없음) 의 앱은 시작하지 않음
+HAL_StatusTypeDef FlashProg_MarkDirty(FlashProg_t* fp);
+
+// CRC-32 (IEEE, reflected) 이어 계산: crc = FlashProg_Crc32(crc, ...) 시작 값 0
+uint32_t          FlashProg_Crc32(uint32_t crc, const uint8_t* p, uint32_t len);
+
+void StartFlashTask(void *argument);
+
+#endif /* INC_FLASHPROG_H_ */
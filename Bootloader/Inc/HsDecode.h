@@ -0,0 +1,36 @@
+/*
+ * HsDecode.h
+ *
+ *  LZSS 스트리밍 압축 해제 (heatshrink 비트스트림, -w 11 -l 4)
+ *  - 0x34 dataFormatIdentifier 상위 nibble = BOOT_DFI_HEATSHRINK 일 때 0x36 데이터 해제용
+ *  - 토큰 (MSB 먼저): 1 + 8 비트 = literal, 0 + index-1 (W 비트) + count-1 (L 비트) = 뒤 참조
+ *  - 입력/출력 어디서 끊겨도 이어서 해제 (비트 단위 상태 유지). RAM = 창 2KB + 상태
+ *  - 끝 표시 없음: 호출자가 원래 크기(0x34 memorySize)만큼 받으면 멈춤 (마지막 바이트의 남는 비트는 0)
+ */
+
+#ifndef INC_HSDECODE_H_
+#define INC_HSDECODE_H_
+
+#include <stdint.h>
+
+#define HS_WINDOW_BITS      11u
+#define HS_LOOKAHEAD_BITS   4u
+#define HS_WINDOW           (1u << HS_WINDOW_BITS)
+
+typedef struct {
+    uint8_t  window[HS_WINDOW];   // 최근 출력 (원형)
+    uint16_t head;                // 다음 출력 위치 (mod HS_WINDOW)
+    uint8_t  state;
+    uint8_t  cur, mask;           // 읽는 중인 입력 바이트 / 다음 비트
+    uint8_t  acc_n;               // 모은 비트 수
+    uint16_t acc;                 // 모으는 중인 필드
+    uint16_t index, count;        // 뒤 참조 거리 / 남은 바이트
+    uint32_t total;               // Init 이후 출력 바이트
+} HsDecode_t;
+
+void     HsDecode_Init(HsDecode_t* d);
+// in[0, len) 을 소비하며 out 에 최대 max 바이트 출력 → 출력 바이트 수, *used = 소비한 입력 바이트.
+// 반환 < max 이면 입력을 모두 소비함 (*used == len)
+uint16_t HsDecode_Run(HsDecode_t* d, const uint8_t* in, uint16_t len, uint16_t* used, uint8_t* out, uint16_t max);
+
+#endif /* INC_HSDECODE_H_ */
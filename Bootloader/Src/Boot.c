@@ -0,0 +1,420 @@
+/*
+ * Boot.c
+ *
+ *  CAN 부트로더 UDS 서버 (Boot.h 참조)
+ */
+
+#include "Boot.h"
+#include "IsoTp.h"
+#include <string.h>
+
+extern CAN_HandleTypeDef hcan1;
+
+Boot_State_t bootState;
+
+static CAN_TxHeaderTypeDef bootTxHeader = {
+    .StdId = BOOT_RES_CANID,
+    .ExtId = 0,
+    .IDE   = CAN_ID_STD,
+    .RTR   = CAN_RTR_DATA,
+    .DLC   = 8,
+    .TransmitGlobalTime = DISABLE,
+};
+static uint32_t bootTxMailbox;
+
+static uint8_t bootReq[BOOT_REQ_MAX];
+static uint8_t bootRsp[8];
+static uint32_t bootResetFlag;
+static uint8_t bootResetPending;
+
+/* ===== 링크 ===== */
+
+/* classic CAN 만: 프레임은 항상 8B (IsoTp_PadLen) */
+static HAL_StatusTypeDef Boot_LinkSend(const uint8_t* frame, uint8_t len)
+{
+    (void)len;
+    return HAL_CAN_AddTxMessage(&hcan1, &bootTxHeader, (uint8_t*)frame, &bootTxMailbox);
+}
+
+static HAL_StatusTypeDef Boot_LinkRecv(uint8_t* frame, uint8_t* len, uint32_t timeout_ms)
+{
+    Boot_RxFrame_t rx;
+    uint32_t start = osKernelGetTickCount();
+
+    for (;;) {
+        uint32_t spent = osKernelGetTickCount() - start;
+        if (spent > timeout_ms) return HAL_TIMEOUT;
+        if (osMessageQueueGet(BootQueueHandle, &rx, NULL, timeout_ms - spent) != osOK) return HAL_TIMEOUT;
+        if (rx.functional) continue;
+        memcpy(frame, rx.data, ISOTP_FRAME_LEN);
+        *len = ISOTP_FRAME_LEN;
+        return HAL_OK;
+    }
+}
+
+static IsoTp_Link_t bootLink = { .send = Boot_LinkSend, .recv = Boot_LinkRecv };
+
+/* 응답 송신: 메일박스가 빌 때까지 1 tick 간격 재시도 */
+static void Boot_Send(const uint8_t* rsp, uint16_t len)
+{
+    uint8_t frame[ISOTP_FRAME_LEN];
+    uint8_t flen;
+    uint16_t sent = IsoTp_FirstFrame(&bootLink, rsp, len, frame, &flen);
+
+    for (uint32_t retry = 0; retry < 10u; retry++) {
+        if (Boot_LinkSend(frame, flen) == HAL_OK) {
+            if (sent < len) (void)IsoTp_SendRest(&bootLink, rsp, len, sent);
+            return;
+        }
+        osDelay(1);
+    }
+}
+
+static uint16_t Boot_Negative(uint8_t sid, uint8_t nrc, uint8_t* rsp)
+{
+    rsp[0] = BOOT_SID_NEGATIVE;
+    rsp[1] = sid;
+    rsp[2] = nrc;
+    return 3;
+}
+
+/* 긴 처리 전 0x78 (P2* 안에 다음 0x78 또는 최종 응답) */
+static void Boot_Pending(uint8_t sid)
+{
+    uint8_t rsp[3];
+    Boot_Send(rsp, Boot_Negative(sid, BOOT_NRC_RESPONSE_PENDING, rsp));
+}
+
+static uint32_t Boot_Be32(const uint8_t* p, uint8_t n)
+{
+    uint32_t v = 0;
+    while (n--) v = (v << 8) | *p++;
+    return v;
+}
+
+static void Boot_Abort(void)
+{
+    if (bootState.active) (void)FlashProg_Wait(&flashProg, BOOT_PROG_WAIT_MS);
+    bootState.active = 0;
+}
+
+/* ===== 서비스 ===== */
+
+static uint16_t Boot_SessionControl(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    uint8_t sub = req[1] & (uint8_t)~BOOT_SPRMIB;
+
+    if (len != 2u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    if (sub != BOOT_SESSION_DEFAULT && sub != BOOT_SESSION_PROGRAMMING) {
+        return Boot_Negative(req[0], BOOT_NRC_SUBFUNC_NOT_SUPPORTED, rsp);
+    }
+    if (sub == BOOT_SESSION_DEFAULT) Boot_Abort();
+    bootState.session = sub;
+    rsp[0] = req[0] + 0x40u;
+    rsp[1] = sub;
+    rsp[2] = 0x00; rsp[3] = 0x32;                 // P2 50ms
+    rsp[4] = 0x01; rsp[5] = 0xF4;                 // P2* 5000ms (10ms 단위)
+    return 6;
+}
+
+static uint16_t Boot_EcuReset(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len != 2u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    if ((req[1] & (uint8_t)~BOOT_SPRMIB) != 0x01u) return Boot_Negative(req[0], BOOT_NRC_SUBFUNC_NOT_SUPPORTED, rsp);
+    Boot_Abort();
+    bootResetPending = 1;
+    bootResetFlag = BOOT_FLAG_NONE;               // 리셋 후 앱 CRC 확인 → 부팅 창
+    rsp[0] = req[0] + 0x40u;
+    rsp[1] = 0x01;
+    return 2;
+}
+
+static uint16_t Boot_TesterPresent(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len != 2u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    if ((req[1] & (uint8_t)~BOOT_SPRMIB) != 0x00u) return Boot_Negative(req[0], BOOT_NRC_SUBFUNC_NOT_SUPPORTED, rsp);
+    rsp[0] = req[0] + 0x40u;
+    rsp[1] = 0x00;
+    return 2;
+}
+
+/* 31 01 FF00 44 addr size: 부트 정보 + 범위를 덮는 sector 지움 (sector 마다 0x78 먼저)
+ * 부트 정보를 지운 직후 dirty 표시: 중단된 다운로드를 디버거로 올린 앱으로 보지 않음 */
+static uint16_t Boot_RoutineControl(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if ((req[1] & (uint8_t)~BOOT_SPRMIB) != 0x01u) return Boot_Negative(req[0], BOOT_NRC_SUBFUNC_NOT_SUPPORTED, rsp);
+    if (len < 4u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    if (((uint16_t)req[2] << 8 | req[3]) != BOOT_RID_ERASE_MEMORY) return Boot_Negative(req[0], BOOT_NRC_REQUEST_OUT_OF_RANGE, rsp);
+    if (len != 13u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+
+    uint32_t addr = Boot_Be32(&req[5], 4);
+    uint32_t size = Boot_Be32(&req[9], 4);
+    if (req[4] != BOOT_ALFID || addr < FLASHPROG_APP_START || size == 0u || size > FLASHPROG_APP_END - addr) {
+        return Boot_Negative(req[0], BOOT_NRC_REQUEST_OUT_OF_RANGE, rsp);
+    }
+
+    Boot_Abort();
+    uint8_t last = FlashProg_Sector(addr + size - 1u);
+    for (uint8_t s = FLASHPROG_INFO_SECTOR; s <= last; s++) {
+        if (s != FLASHPROG_INFO_SECTOR && s < FlashProg_Sector(addr)) continue;
+        Boot_Pending(req[0]);
+        if (FlashProg_EraseSector(&flashProg, s) != HAL_OK ||
+            (s == FLASHPROG_INFO_SECTOR && FlashProg_MarkDirty(&flashProg) != HAL_OK)) {
+            return Boot_Negative(req[0], BOOT_NRC_PROGRAMMING_FAILURE, rsp);
+        }
+    }
+    rsp[0] = req[0] + 0x40u;
+    rsp[1] = req[1];
+    rsp[2] = req[2];
+    rsp[3] = req[3];
+    rsp[4] = 0x00;                                // routineStatus: 완료
+    return 5;
+}
+
+static uint16_t Boot_RequestDownload(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len < 3u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    uint8_t na = req[2] & 0x0Fu, ns = req[2] >> 4;
+    if (na == 0u || na > 4u || ns == 0u || ns > 4u) return Boot_Negative(req[0], BOOT_NRC_REQUEST_OUT_OF_RANGE, rsp);
+    if (len != 3u + na + ns) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    if (bootState.active) return Boot_Negative(req[0], BOOT_NRC_CONDITIONS_NOT_CORRECT, rsp);
+
+    uint32_t addr = Boot_Be32(&req[3], na);
+    uint32_t size = Boot_Be32(&req[3u + na], ns);
+    if ((req[1] != BOOT_DFI_RAW && req[1] != BOOT_DFI_HEATSHRINK) || addr < FLASHPROG_APP_START ||
+        (addr & 3u) != 0u || size == 0u || size > FLASHPROG_APP_END - addr) {
+        return Boot_Negative(req[0], BOOT_NRC_REQUEST_OUT_OF_RANGE, rsp);
+    }
+    if (!FlashProg_IsErased(&flashProg, addr, size)) return Boot_Negative(req[0], BOOT_NRC_UPLOAD_DOWNLOAD_REJECTED, rsp);
+
+    bootState.method = (uint8_t)(req[1] >> 4);
+    FlashProg_Begin(&flashProg, addr, size, bootState.method);
+    bootState.active = 1;
+    bootState.bsc = 0;
+    bootState.addr = addr;
+    bootState.size = size;
+    bootState.done = 0;
+    rsp[0] = req[0] + 0x40u;
+    rsp[1] = 0x20;                                // lengthFormatIdentifier: 2B
+    rsp[2] = (uint8_t)((2u + FLASHPROG_BLOCK_MAX) >> 8);
+    rsp[3] = (uint8_t)(2u + FLASHPROG_BLOCK_MAX);
+    return 4;
+}
+
+/* req = FlashProg 수신 버퍼. 수락하면 FlashTask 로, 아니면 버퍼 반환 */
+static uint16_t Boot_TransferData(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    uint8_t nrc = 0;
+
+    if (!bootState.active) {
+        nrc = BOOT_NRC_REQUEST_SEQUENCE_ERROR;
+    } else if (len < 2u) {
+        nrc = BOOT_NRC_INCORRECT_LENGTH;
+    } else if (flashProg.status != HAL_OK) {
+        nrc = BOOT_NRC_PROGRAMMING_FAILURE;
+        Boot_Abort();
+    } else if (req[1] == (uint8_t)(bootState.bsc + 1u)) {
+        uint16_t n = (uint16_t)(len - 2u);
+        uint8_t raw = (bootState.method == FLASHPROG_METHOD_RAW);
+        if (n == 0u || (raw && n > bootState.size - bootState.done)) {
+            nrc = BOOT_NRC_TRANSFER_SUSPENDED;        // 압축 전송의 크기 초과는 FlashTask 가 (0x72)
+        } else if (raw && (n & 3u) != 0u && bootState.done + n != bootState.size) {
+            nrc = BOOT_NRC_REQUEST_OUT_OF_RANGE;      // 마지막 블록만 word 배수가 아니어도 됨
+        } else if (FlashProg_Submit(&flashProg, 2u, n, bootState.addr + bootState.done) != HAL_OK) {
+            return Boot_Negative(req[0], BOOT_NRC_PROGRAMMING_FAILURE, rsp);   // 버퍼는 Submit 이 반환
+        } else {
+            bootState.bsc = req[1];
+            bootState.done += n;
+            bootState.blocks++;
+            if (!bootState.overlap && FlashProg_Wait(&flashProg, BOOT_PROG_WAIT_MS) != HAL_OK) {
+                Boot_Abort();
+                return Boot_Negative(req[0], BOOT_NRC_PROGRAMMING_FAILURE, rsp);
+            }
+            rsp[0] = req[0] + 0x40u;
+            rsp[1] = req[1];
+            return 2;
+        }
+    } else if (req[1] == bootState.bsc && bootState.done != 0u) {
+        bootState.repeats++;                      // 응답 유실 → 재전송: 기록하지 않고 긍정 응답
+        FlashProg_PutBack(&flashProg);
+        rsp[0] = req[0] + 0x40u;
+        rsp[1] = req[1];
+        return 2;
+    } else {
+        nrc = BOOT_NRC_WRONG_BLOCK_SEQUENCE;
+    }
+    FlashProg_PutBack(&flashProg);
+    return Boot_Negative(req[0], nrc, rsp);
+}
+
+/* 37 [crc32]: 기록 완료 대기 → CRC 비교 → 부트 정보 */
+static uint16_t Boot_TransferExit(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len != 1u && len != 5u) return Boot_Negative(req[0], BOOT_NRC_INCORRECT_LENGTH, rsp);
+    if (!bootState.active || (bootState.method == FLASHPROG_METHOD_RAW && bootState.done != bootState.size)) {
+        return Boot_Negative(req[0], BOOT_NRC_REQUEST_SEQUENCE_ERROR, rsp);
+    }
+
+    HAL_StatusTypeDef st = FlashProg_Wait(&flashProg, BOOT_PROG_WAIT_MS);
+    if (st == HAL_OK && flashProg.out != bootState.size) {
+        return Boot_Negative(req[0], BOOT_NRC_REQUEST_SEQUENCE_ERROR, rsp);      // 압축 스트림이 덜 옴
+    }
+    bootState.active = 0;
+    uint32_t crc = flashProg.crc;
+    if (st != HAL_OK || (len == 5u && Boot_Be32(&req[1], 4) != crc)) {
+        return Boot_Negative(req[0], BOOT_NRC_PROGRAMMING_FAILURE, rsp);
+    }
+    if (bootState.addr == FLASHPROG_APP_START &&
+        FlashProg_WriteInfo(&flashProg, bootState.addr, bootState.size, crc) != HAL_OK) {
+        return Boot_Negative(req[0], BOOT_NRC_PROGRAMMING_FAILURE, rsp);
+    }
+    rsp[0] = req[0] + 0x40u;
+    rsp[1] = (uint8_t)(crc >> 24);
+    rsp[2] = (uint8_t)(crc >> 16);
+    rsp[3] = (uint8_t)(crc >> 8);
+    rsp[4] = (uint8_t)crc;
+    return 5;
+}
+
+/* xfer = req 가 FlashProg 수신 버퍼 (물리 주소 0x36) */
+static uint16_t Boot_Handle(const uint8_t* req, uint16_t len, uint8_t xfer, uint8_t* rsp)
+{
+    uint8_t sid = req[0];
+
+    switch (sid) {
+    case BOOT_SVC_SESSION:
+    case BOOT_SVC_ECU_RESET:
+    case BOOT_SVC_TESTER_PRESENT:
+    case BOOT_SVC_ROUTINE:
+        if (len < 2u) return Boot_Negative(sid, BOOT_NRC_INCORRECT_LENGTH, rsp);
+        if (sid == BOOT_SVC_SESSION)        return Boot_SessionControl(req, len, rsp);
+        if (sid == BOOT_SVC_ECU_RESET)      return Boot_EcuReset(req, len, rsp);
+        if (sid == BOOT_SVC_TESTER_PRESENT) return Boot_TesterPresent(req, len, rsp);
+        break;
+    case BOOT_SVC_REQUEST_DOWNLOAD:
+    case BOOT_SVC_TRANSFER_DATA:
+    case BOOT_SVC_TRANSFER_EXIT:
+        break;
+    default:
+        return Boot_Negative(sid, BOOT_NRC_SERVICE_NOT_SUPPORTED, rsp);
+    }
+
+    if (bootState.session != BOOT_SESSION_PROGRAMMING) {
+        if (xfer) FlashProg_PutBack(&flashProg);
+        return Boot_Negative(sid, BOOT_NRC_SERVICE_NOT_IN_SESSION, rsp);
+    }
+    if (sid == BOOT_SVC_ROUTINE)          return Boot_RoutineControl(req, len, rsp);
+    if (sid == BOOT_SVC_REQUEST_DOWNLOAD) return Boot_RequestDownload(req, len, rsp);
+    if (sid == BOOT_SVC_TRANSFER_EXIT)    return Boot_TransferExit(req, len, rsp);
+    if (!xfer) return Boot_Negative(sid, BOOT_NRC_CONDITIONS_NOT_CORRECT, rsp);     // 기능 주소 0x36
+    return Boot_TransferData(req, len, rsp);
+}
+
+/* 응답 생략: SPRMIB 긍정 응답, 기능 주소의 미지원/범위 NRC */
+static uint8_t Boot_Suppressed(const uint8_t* req, const uint8_t* rsp, uint8_t functional)
+{
+    if (rsp[0] != BOOT_SID_NEGATIVE) {
+        return (req[0] == BOOT_SVC_SESSION || req[0] == BOOT_SVC_ECU_RESET || req[0] == BOOT_SVC_TESTER_PRESENT ||
+                req[0] == BOOT_SVC_ROUTINE) && (req[1] & BOOT_SPRMIB);
+    }
+    uint8_t nrc = rsp[2];
+    return functional && (nrc == BOOT_NRC_SERVICE_NOT_SUPPORTED || nrc == BOOT_NRC_SUBFUNC_NOT_SUPPORTED ||
+                          nrc == BOOT_NRC_REQUEST_OUT_OF_RANGE || nrc == BOOT_NRC_SERVICE_NOT_IN_SESSION);
+}
+
+void Boot_Init(uint8_t stay)
+{
+    memset(&bootState, 0, sizeof(bootState));
+    bootState.session = BOOT_SESSION_DEFAULT;
+    bootState.stay = stay;
+    bootState.overlap = 1;
+}
+
+/* ===== 수신 ===== */
+
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_RxHeaderTypeDef rxHeader;
+    Boot_RxFrame_t rx;
+
+    while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0u) {
+        if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rxHeader, rx.data) != HAL_OK) break;
+        if (rxHeader.IDE != CAN_ID_STD || rxHeader.RTR != CAN_RTR_DATA) continue;
+        if (rxHeader.StdId != BOOT_REQ_CANID && rxHeader.StdId != BOOT_FUNC_CANID) continue;
+        for (uint32_t i = rxHeader.DLC; i < sizeof(rx.data); i++) rx.data[i] = 0;
+        rx.functional = (rxHeader.StdId == BOOT_FUNC_CANID);
+        (void)osMessageQueuePut(BootQueueHandle, &rx, 0, 0);
+    }
+}
+
+void StartBootTask(void *argument)
+{
+    Boot_RxFrame_t rx;
+    uint32_t start = osKernelGetTickCount();
+
+    (void)argument;
+    for (;;)
+    {
+        uint32_t now = osKernelGetTickCount();
+        uint32_t wait = 100u;
+
+        // 부팅 창: 요청이 없으면 앱으로
+        if (!bootState.stay) {
+            if (now - start >= BOOT_WINDOW_MS) {
+                Boot_Reset(BOOT_FLAG_JUMP);
+                bootState.stay = 1;               // 호스트: 리셋은 기록만
+                continue;
+            }
+            wait = BOOT_WINDOW_MS - (now - start);
+        }
+
+        uint8_t got;
+        if (bootLink.held_valid) {
+            memcpy(rx.data, bootLink.held, ISOTP_FRAME_LEN);
+            rx.functional = 0;
+            bootLink.held_valid = 0;
+            got = 1;
+        } else {
+            got = (osMessageQueueGet(BootQueueHandle, &rx, NULL, wait) == osOK);
+        }
+        if (!got) {
+            // S3: 프로그래밍 세션 유지 요청 없음 → default (진행 중인 다운로드 중단)
+            if (bootState.session != BOOT_SESSION_DEFAULT && now - bootState.last_rx_tick >= BOOT_S3_MS) {
+                Boot_Abort();
+                bootState.session = BOOT_SESSION_DEFAULT;
+            }
+            continue;
+        }
+
+        uint8_t type = IsoTp_FrameType(rx.data, ISOTP_FRAME_LEN);
+        if (type != ISOTP_PCI_SF && type != ISOTP_PCI_FF) continue;
+        uint8_t sid = (type == ISOTP_PCI_SF) ? rx.data[1] : rx.data[2];
+        bootState.stay = 1;
+        bootState.last_rx_tick = osKernelGetTickCount();
+
+        // 0x36 은 빈 FlashProg 버퍼에 바로 재조립 (FC 는 버퍼가 생긴 뒤)
+        uint8_t xfer = (sid == BOOT_SVC_TRANSFER_DATA && !rx.functional);
+        uint8_t* buf = bootReq;
+        uint16_t max = sizeof(bootReq), len;
+        if (xfer) {
+            buf = FlashProg_GetBuffer(&flashProg, BOOT_BUF_WAIT_MS);
+            if (buf == NULL) continue;
+            max = 2u + FLASHPROG_BLOCK_MAX;
+        }
+        if (IsoTp_Receive(&bootLink, rx.data, ISOTP_FRAME_LEN, buf, max, &len) != HAL_OK) {
+            if (xfer) FlashProg_PutBack(&flashProg);
+            continue;
+        }
+
+        uint16_t n = Boot_Handle(buf, len, xfer, bootRsp);
+        bootState.requests++;
+        bootState.last_rx_tick = osKernelGetTickCount();
+        if (n != 0u && !Boot_Suppressed(buf, bootRsp, rx.functional)) Boot_Send(bootRsp, n);
+        if (bootResetPending) {
+            bootResetPending = 0;
+            osDelay(2);                           // 응답 프레임 송신 완료
+            Boot_Reset(bootResetFlag);
+            bootState.session = BOOT_SESSION_DEFAULT;
+        }
+    }
+}
@@ -0,0 +1,296 @@
+/*
+ * FlashProg.c
+ *
+ *  부트로더 내장 flash 기록 (FlashProg.h 참조)
+ */
+
+#include "FlashProg.h"
+#include <string.h>
+
+FlashProg_t flashProg;
+
+void FlashProg_Init(FlashProg_t* fp)
+{
+    fp->free = osSemaphoreNew(FLASHPROG_NBUF, FLASHPROG_NBUF, NULL);
+    fp->done = osSemaphoreNew(1, 0, NULL);
+    fp->jobs = osMessageQueueNew(FLASHPROG_NBUF, sizeof(FlashProg_Job_t), NULL);
+    fp->status = HAL_OK;
+}
+
+/* ===== sector (STM32F413: 4x16K, 1x64K, 11x128K) ===== */
+
+uint8_t FlashProg_Sector(uint32_t addr)
+{
+    if (addr < FLASHPROG_BOOT_START || addr >= FLASHPROG_APP_END) return 0xFFu;
+    uint32_t off = addr - FLASHPROG_BOOT_START;
+    if (off < 0x10000u) return (uint8_t)(off / 0x4000u);
+    if (off < 0x20000u) return 4u;
+    return (uint8_t)(4u + off / 0x20000u);
+}
+
+uint32_t FlashProg_SectorAddr(uint8_t sector)
+{
+    if (sector < 4u)   return FLASHPROG_BOOT_START + sector * 0x4000u;
+    if (sector == 4u)  return FLASHPROG_BOOT_START + 0x10000u;
+    return FLASHPROG_BOOT_START + (sector - 4u) * 0x20000u;
+}
+
+uint32_t FlashProg_SectorSize(uint8_t sector)
+{
+    if (sector < 4u)   return 0x4000u;
+    if (sector == 4u)  return 0x10000u;
+    return 0x20000u;
+}
+
+HAL_StatusTypeDef FlashProg_EraseSector(FlashProg_t* fp, uint8_t sector)
+{
+    FLASH_EraseInitTypeDef er = {
+        .TypeErase = FLASH_TYPEERASE_SECTORS,
+        .Banks = FLASH_BANK_1,
+        .Sector = sector,
+        .NbSectors = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3,
+    };
+    uint32_t bad;
+
+    if (sector >= FLASHPROG_SECTORS || sector < FLASHPROG_INFO_SECTOR) return HAL_ERROR;   // 부트로더 보호
+    (void)HAL_FLASH_Unlock();
+    HAL_StatusTypeDef st = HAL_FLASHEx_Erase(&er, &bad);
+    (void)HAL_FLASH_Lock();
+    if (st == HAL_OK) fp->erased |= 1u << sector;
+    else              fp->erased &= ~(1u << sector);
+    return st;
+}
+
+uint8_t FlashProg_IsErased(const FlashProg_t* fp, uint32_t addr, uint32_t len)
+{
+    if (len == 0u) return 1;
+    uint8_t first = FlashProg_Sector(addr);
+    uint8_t last = FlashProg_Sector(addr + len - 1u);
+    if (first == 0xFFu || last == 0xFFu) return 0;
+    for (uint8_t s = first; s <= last; s++) {
+        if (!(fp->erased & (1u << s))) return 0;
+    }
+    return 1;
+}
+
+/* ===== 기록 ===== */
+
+uint32_t FlashProg_Crc32(uint32_t crc, const uint8_t* p, uint32_t len)
+{
+    static const uint32_t tbl[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ tbl[crc & 0x0Fu];
+        crc = (crc >> 4) ^ tbl[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/* word 단위 기록 + 읽어서 비교. 끝 word 의 남는 바이트는 0xFF */
+static HAL_StatusTypeDef FlashProg_Program(FlashProg_t* fp, const uint8_t* src, uint32_t len, uint32_t addr)
+{
+    HAL_StatusTypeDef st = HAL_OK;
+
+    (void)HAL_FLASH_Unlock();
+    for (uint32_t i = 0; i < len && st == HAL_OK; i += 4u) {
+        uint8_t w[4] = { 0xFFu, 0xFFu, 0xFFu, 0xFFu };
+        uint32_t word;
+
+        memcpy(w, &src[i], (len - i < 4u) ? len - i : 4u);
+        memcpy(&word, w, 4);
+        if (word != 0xFFFFFFFFu) {
+            st = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i, word);
+            fp->words++;
+        }
+        if (st == HAL_OK && memcmp(FLASHPROG_PTR(addr + i), w, 4) != 0) st = HAL_ERROR;
+        if (st != HAL_OK) fp->err_addr = addr + i;
+    }
+    (void)HAL_FLASH_Lock();
+    return st;
+}
+
+void FlashProg_Begin(FlashProg_t* fp, uint32_t addr, uint32_t size, uint8_t method)
+{
+    fp->status = HAL_OK;
+    fp->err_addr = 0;
+    fp->crc = 0;
+    fp->method = method;
+    fp->addr = addr;
+    fp->size = size;
+    fp->out = 0;
+    fp->fill = 0;
+    HsDecode_Init(&fp->hs);
+}
+
+/* 압축 블록 1 개: 풀린 데이터를 staging 에 모아 word 단위로 기록 (마지막은 남는 바이트까지).
+ * 원래 크기를 넘는 출력 / 다 푼 뒤 남는 입력은 오류 */
+static HAL_StatusTypeDef FlashProg_Inflate(FlashProg_t* fp, const uint8_t* src, uint16_t len)
+{
+    uint16_t pos = 0;
+
+    for (;;) {
+        uint32_t left = fp->size - fp->hs.total;
+        uint16_t room = (uint16_t)(FLASHPROG_STAGE - fp->fill);
+        uint16_t used = 0, n = 0;
+
+        if (room > left) room = (uint16_t)left;
+        if (room != 0u) n = HsDecode_Run(&fp->hs, &src[pos], (uint16_t)(len - pos), &used, &fp->stage[fp->fill], room);
+        FLASHPROG_CPU(n * FLASHPROG_DECODE_CYCLES);
+        pos = (uint16_t)(pos + used);
+        fp->fill = (uint16_t)(fp->fill + n);
+
+        uint8_t last = (fp->hs.total == fp->size);
+        uint16_t w = last ? fp->fill : (uint16_t)(fp->fill & ~3u);
+        if (w != 0u) {
+            if (FlashProg_Program(fp, fp->stage, w, fp->addr + fp->out) != HAL_OK) return HAL_ERROR;
+            fp->crc = FlashProg_Crc32(fp->crc, fp->stage, w);
+            fp->out += w;
+            fp->fill = (uint16_t)(fp->fill - w);
+            memmove(fp->stage, &fp->stage[w], fp->fill);
+        }
+        if (last) {
+            if (pos == len) return HAL_OK;
+            fp->err_addr = fp->addr + fp->size;             // 이미지보다 긴 압축 데이터
+            return HAL_ERROR;
+        }
+        if (n == 0u && w == 0u) return HAL_OK;              // 블록 다 풂, 다음 블록 대기
+    }
+}
+
+uint8_t* FlashProg_GetBuffer(FlashProg_t* fp, uint32_t timeout_ms)
+{
+    if (osSemaphoreGetCount(fp->free) == 0u) fp->buf_waits++;
+    if (osSemaphoreAcquire(fp->free, timeout_ms) != osOK) return NULL;
+    uint8_t* b = fp->buf[fp->next];
+    fp->next = (uint8_t)((fp->next + 1u) % FLASHPROG_NBUF);
+    return b;
+}
+
+void FlashProg_PutBack(FlashProg_t* fp)
+{
+    fp->next = (uint8_t)((fp->next + FLASHPROG_NBUF - 1u) % FLASHPROG_NBUF);
+    (void)osSemaphoreRelease(fp->free);
+}
+
+HAL_StatusTypeDef FlashProg_Submit(FlashProg_t* fp, uint16_t off, uint16_t len, uint32_t addr)
+{
+    FlashProg_Job_t job = {
+        .buf = (uint8_t)((fp->next + FLASHPROG_NBUF - 1u) % FLASHPROG_NBUF),
+        .off = off,
+        .len = len,
+        .addr = addr,
+    };
+
+    __disable_irq();
+    fp->pending++;
+    __enable_irq();
+    // 버퍼 수 = 큐 깊이 → 빈 버퍼를 받았으면 큐에도 자리가 있음
+    if (osMessageQueuePut(fp->jobs, &job, 0, 0) != osOK) {
+        __disable_irq();
+        fp->pending--;
+        __enable_irq();
+        FlashProg_PutBack(fp);
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef FlashProg_Wait(FlashProg_t* fp, uint32_t timeout_ms)
+{
+    uint32_t start = osKernelGetTickCount();
+
+    while (fp->pending != 0u) {
+        uint32_t spent = osKernelGetTickCount() - start;
+        if (spent >= timeout_ms) return HAL_TIMEOUT;
+        (void)osSemaphoreAcquire(fp->done, timeout_ms - spent);
+    }
+    return fp->status;
+}
+
+HAL_StatusTypeDef FlashProg_WriteInfo(FlashProg_t* fp, uint32_t start, uint32_t size, uint32_t crc)
+{
+    FlashProg_Info_t info = {
+        .magic = FLASHPROG_INFO_MAGIC,
+        .start = start,
+        .size = size,
+        .crc = crc,
+        .magic_inv = ~FLASHPROG_INFO_MAGIC,
+    };
+
+    if (!FlashProg_IsErased(fp, FLASHPROG_INFO_ADDR, sizeof(info))) return HAL_ERROR;
+    return FlashProg_Program(fp, (const uint8_t*)&info, sizeof(info), FLASHPROG_INFO_ADDR);
+}
+
+HAL_StatusTypeDef FlashProg_MarkDirty(FlashProg_t* fp)
+{
+    static const uint32_t dirty = 0;
+
+    if (!FlashProg_IsErased(fp, FLASHPROG_DIRTY_ADDR, sizeof(dirty))) return HAL_ERROR;
+    return FlashProg_Program(fp, (const uint8_t*)&dirty, sizeof(dirty), FLASHPROG_DIRTY_ADDR);
+}
+
+/* 초기 SP 가 RAM 안 (word 정렬), reset 벡터가 앱 영역 안 thumb 주소 */
+static uint8_t FlashProg_VectorValid(void)
+{
+    uint32_t vec[2];
+
+    memcpy(vec, FLASHPROG_PTR(FLASHPROG_APP_START), sizeof(vec));
+    return (vec[0] & 3u) == 0u && vec[0] > FLASHPROG_RAM_START && vec[0] <= FLASHPROG_RAM_END &&
+           (vec[1] & 1u) != 0u && vec[1] > FLASHPROG_APP_START && vec[1] < FLASHPROG_APP_END;
+}
+
+uint8_t FlashProg_AppValid(uint8_t full)
+{
+    FlashProg_Info_t info;
+    uint32_t dirty;
+
+    memcpy(&info, FLASHPROG_PTR(FLASHPROG_INFO_ADDR), sizeof(info));
+    memcpy(&dirty, FLASHPROG_PTR(FLASHPROG_DIRTY_ADDR), sizeof(dirty));
+    if (info.magic != FLASHPROG_INFO_MAGIC || info.magic_inv != ~FLASHPROG_INFO_MAGIC) {
+        // 부트 정보 없음: 디버거로 올린 앱 (sector 3 을 건드린 적 없음) 만
+        const uint8_t* p = (const uint8_t*)&info;
+        for (uint32_t i = 0; i < sizeof(info); i++) {
+            if (p[i] != 0xFFu) return 0;
+        }
+        return dirty == 0xFFFFFFFFu && FlashProg_VectorValid();
+    }
+    if (info.start != FLASHPROG_APP_START || info.size == 0u || info.size > FLASHPROG_APP_END - info.start) return 0;
+    if (!full) return 1;
+    return FlashProg_Crc32(0, FLASHPROG_PTR(info.start), info.size) == info.crc;
+}
+
+/* 작업 순서대로 기록 → 버퍼 반환. 오류 이후 작업은 기록하지 않고 버퍼만 반환 */
+void StartFlashTask(void *argument)
+{
+    FlashProg_t* fp = (FlashProg_t*)argument;
+    FlashProg_Job_t job;
+
+    for (;;)
+    {
+        if (osMessageQueueGet(fp->jobs, &job, NULL, osWaitForever) != osOK) continue;
+
+        const uint8_t* src = &fp->buf[job.buf][job.off];
+        if (fp->status == HAL_OK && fp->method == FLASHPROG_METHOD_HS) {
+            if (FlashProg_Inflate(fp, src, job.len) != HAL_OK) fp->status = HAL_ERROR;
+            fp->blocks++;
+        } else if (fp->status == HAL_OK) {
+            if (FlashProg_Program(fp, src, job.len, job.addr) != HAL_OK) fp->status = HAL_ERROR;
+            fp->crc = FlashProg_Crc32(fp->crc, src, job.len);
+            fp->out += job.len;
+            fp->blocks++;
+        }
+        (void)osSemaphoreRelease(fp->free);
+        __disable_irq();
+        fp->pending--;
+        __enable_irq();
+        (void)osSemaphoreRelease(fp->done);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * HsDecode.c
+ *
+ *  LZSS 스트리밍 압축 해제 (HsDecode.h 참조)
+ */
+
+#include "HsDecode.h"
+#include <string.h>
+
+#define HS_MASK  (HS_WINDOW - 1u)
+
+enum {
+    HS_TAG = 0,
+    HS_LITERAL,
+    HS_INDEX,
+    HS_COUNT,
+    HS_COPY,
+};
+
+void HsDecode_Init(HsDecode_t* d)
+{
+    memset(d, 0, sizeof(*d));     // 창 0 (heatshrink 와 같음), HS_TAG
+}
+
+/* n 비트를 acc 에 (MSB 먼저). 입력이 모자라면 모은 비트는 남겨 두고 0 */
+static uint8_t HsDecode_Bits(HsDecode_t* d, uint8_t n, const uint8_t* in, uint16_t len, uint16_t* pos)
+{
+    while (d->acc_n < n) {
+        if (d->mask == 0u) {
+            if (*pos >= len) return 0;
+            d->cur = in[(*pos)++];
+            d->mask = 0x80u;
+        }
+        d->acc = (uint16_t)((d->acc << 1) | ((d->cur & d->mask) != 0u));
+        d->mask >>= 1;
+        d->acc_n++;
+    }
+    return 1;
+}
+
+uint16_t HsDecode_Run(HsDecode_t* d, const uint8_t* in, uint16_t len, uint16_t* used, uint8_t* out, uint16_t max)
+{
+    static const uint8_t width[] = { 1u, 8u, HS_WINDOW_BITS, HS_LOOKAHEAD_BITS };
+    uint16_t pos = 0, n = 0;
+
+    while (n < max) {
+        if (d->state == HS_COPY) {
+            while (d->count != 0u && n < max) {
+                uint8_t b = d->window[(uint16_t)(d->head - d->index) & HS_MASK];
+                d->window[d->head & HS_MASK] = b;
+                d->head++;
+                out[n++] = b;
+                d->count--;
+            }
+            if (d->count == 0u) d->state = HS_TAG;
+            continue;
+        }
+
+        if (!HsDecode_Bits(d, width[d->state], in, len, &pos)) break;
+        uint16_t v = d->acc;
+        d->acc = 0;
+        d->acc_n = 0;
+
+        switch (d->state) {
+        case HS_TAG:
+            d->state = v ? HS_LITERAL : HS_INDEX;
+            break;
+        case HS_LITERAL:
+            d->window[d->head & HS_MASK] = (uint8_t)v;
+            d->head++;
+            out[n++] = (uint8_t)v;
+            d->state = HS_TAG;
+            break;
+        case HS_INDEX:
+            d->index = (uint16_t)(v + 1u);
+            d->state = HS_COUNT;
+            break;
+        default:
+            d->count = (uint16_t)(v + 1u);
+            d->state = HS_COPY;
+            break;
+        }
+    }
+    *used = pos;
+    d->total += n;
+    return n;
+}
@@ -0,0 +1,66 @@
+/*
+ * boot_it.c
+ *
+ *  부트로더 인터럽트 핸들러 + MSP (타깃 전용, Core/Src/stm32f4xx_it.c / stm32f4xx_hal_msp.c 중 CAN1 만)
+ */
+
+#include "Boot.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+extern CAN_HandleTypeDef hcan1;
+
+/* ===== Cortex-M4 ===== */
+void NMI_Handler(void)        { while (1) { } }
+void HardFault_Handler(void)  { while (1) { } }
+void MemManage_Handler(void)  { while (1) { } }
+void BusFault_Handler(void)   { while (1) { } }
+void UsageFault_Handler(void) { while (1) { } }
+void DebugMon_Handler(void)   { }
+
+void SysTick_Handler(void)
+{
+  HAL_IncTick();
+#if (INCLUDE_xTaskGetSchedulerState == 1 )
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+#endif /* INCLUDE_xTaskGetSchedulerState */
+  xPortSysTickHandler();
+#if (INCLUDE_xTaskGetSchedulerState == 1 )
+  }
+#endif /* INCLUDE_xTaskGetSchedulerState */
+}
+
+/* ===== 주변장치 ===== */
+void CAN1_RX0_IRQHandler(void)
+{
+  HAL_CAN_IRQHandler(&hcan1);
+}
+
+/* ===== MSP ===== */
+void HAL_MspInit(void)
+{
+  __HAL_RCC_SYSCFG_CLK_ENABLE();
+  __HAL_RCC_PWR_CLK_ENABLE();
+
+  HAL_NVIC_SetPriority(PendSV_IRQn, 15, 0);
+}
+
+void HAL_CAN_MspInit(CAN_HandleTypeDef* hcan)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  if (hcan->Instance == CAN1)
+  {
+    __HAL_RCC_CAN1_CLK_ENABLE();
+    __HAL_RCC_GPIOG_CLK_ENABLE();
+
+    // PG0 CAN1_RX, PG1 CAN1_TX
+    GPIO_InitStruct.Pin = GPIO_PIN_0|GPIO_PIN_1;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF9_CAN1;
+    HAL_GPIO_Init(GPIOG, &GPIO_InitStruct);
+  }
+}
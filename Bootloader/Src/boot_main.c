@@ -0,0 +1,156 @@
+/*
+ * boot_main.c
+ *
+ *  CAN 부트로더 진입점 (타깃 전용, STM32F413ZHTX_BOOT.ld)
+ *  - 빌드: CubeIDE "Boot" 구성 (.cproject) → RTOS_DTC_Comento_Boot.elf
+ *    Bootloader/Src/*.c + Core/Src/IsoTp.c, system_stm32f4xx.c, syscalls.c, sysmem.c
+ *    + Core/Startup + HAL + FreeRTOS (CMSIS-RTOS2). 쓰지 않는 HAL 은 --gc-sections 로 빠짐
+ *  - 클럭/CAN1 설정은 main.c 와 같음 (같은 비트 레이트, 같은 진단 ID)
+ *  - 앱이 유효하면 BOOT_WINDOW_MS 동안 요청을 기다린 뒤 리셋 → 리셋 직후 앱으로 점프
+ */
+
+#include "Boot.h"
+#include "FlashProg.h"
+
+CAN_HandleTypeDef   hcan1;
+osMessageQueueId_t  BootQueueHandle;
+
+osThreadId_t BootTaskHandle;
+osThreadId_t FlashTaskHandle;
+
+/* 리셋을 넘어 유지 (.noinit, startup 이 지우지 않음) */
+static volatile uint32_t bootFlag __attribute__((section(".noinit")));
+
+void SystemClock_Config(void);
+static void MX_CAN1_Init(void);
+void Error_Handler(void);
+
+/* 리셋 직후 상태 그대로 앱 벡터 테이블로 (주변장치/인터럽트 미사용 상태) */
+static void Boot_JumpToApp(void)
+{
+  uint32_t sp = *(volatile uint32_t*)FLASHPROG_APP_START;
+  uint32_t pc = *(volatile uint32_t*)(FLASHPROG_APP_START + 4u);
+
+  SCB->VTOR = FLASHPROG_APP_START;
+  __set_MSP(sp);
+  ((void (*)(void))pc)();
+}
+
+void Boot_Reset(uint32_t flag)
+{
+  bootFlag = flag;
+  NVIC_SystemReset();
+}
+
+int main(void)
+{
+  // 부팅 창이 끝나 리셋한 경우: 헤더만 확인 (CRC 는 리셋 전에 확인함)
+  if (bootFlag == BOOT_FLAG_JUMP && FlashProg_AppValid(0)) {
+    bootFlag = BOOT_FLAG_NONE;
+    Boot_JumpToApp();
+  }
+  bootFlag = BOOT_FLAG_NONE;
+
+  HAL_Init();
+  SystemClock_Config();
+  MX_CAN1_Init();
+
+  // === RTOS 커널 초기화 ===
+  osKernelInitialize();
+
+  BootQueueHandle = osMessageQueueNew(BOOT_RX_DEPTH, sizeof(Boot_RxFrame_t), NULL);
+  FlashProg_Init(&flashProg);
+  Boot_Init(!FlashProg_AppValid(1));
+
+  // === Task 생성: 수신/응답이 기록보다 우선 ===
+  const osThreadAttr_t BootTask_attributes = {
+    .name = "BootTask", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityAboveNormal,
+  };
+  BootTaskHandle = osThreadNew(StartBootTask, NULL, &BootTask_attributes);
+
+  const osThreadAttr_t FlashTask_attributes = {
+    .name = "FlashTask", .stack_size = 192 * 4, .priority = (osPriority_t)osPriorityBelowNormal,
+  };
+  FlashTaskHandle = osThreadNew(StartFlashTask, &flashProg, &FlashTask_attributes);
+
+  // === RTOS 시작 ===
+  osKernelStart();
+
+  while (1) { }
+}
+
+/* =========================
+ * Clock / Periph Inits (main.c 와 같음)
+ * ========================= */
+void SystemClock_Config(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  __HAL_RCC_PWR_CLK_ENABLE();
+  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) { Error_Handler(); }
+
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+                              | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource   = RCC_SYSCLKSOURCE_HSI;
+  RCC_ClkInitStruct.AHBCLKDivider  = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK) { Error_Handler(); }
+}
+
+static void MX_CAN1_Init(void)
+{
+  hcan1.Instance = CAN1;
+  hcan1.Init.Prescaler           = 16;
+  hcan1.Init.Mode                = CAN_MODE_NORMAL;
+  hcan1.Init.SyncJumpWidth       = CAN_SJW_1TQ;
+  hcan1.Init.TimeSeg1            = CAN_BS1_1TQ;
+  hcan1.Init.TimeSeg2            = CAN_BS2_1TQ;
+  hcan1.Init.TimeTriggeredMode   = DISABLE;
+  hcan1.Init.AutoBusOff          = DISABLE;
+  hcan1.Init.AutoWakeUp          = DISABLE;
+  hcan1.Init.AutoRetransmission  = DISABLE;
+  hcan1.Init.ReceiveFifoLocked   = DISABLE;
+  hcan1.Init.TransmitFifoPriority= DISABLE;
+  if (HAL_CAN_Init(&hcan1) != HAL_OK) { Error_Handler(); }
+
+  // 물리 요청(0x7E0) bank 0, 기능 요청(0x7DF) bank 1 → FIFO0
+  CAN_FilterTypeDef sFilterConfig = {0};
+  sFilterConfig.FilterBank           = 0;
+  sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
+  sFilterConfig.FilterScale          = CAN_FILTERSCALE_32BIT;
+  sFilterConfig.FilterIdHigh         = BOOT_REQ_CANID << 5;
+  sFilterConfig.FilterIdLow          = 0x0000;
+  sFilterConfig.FilterMaskIdHigh     = 0x7FFu << 5;
+  sFilterConfig.FilterMaskIdLow      = 0x0006;
+  sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+  sFilterConfig.FilterActivation     = ENABLE;
+  sFilterConfig.SlaveStartFilterBank = 14;
+  if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+  sFilterConfig.FilterBank           = 1;
+  sFilterConfig.FilterIdHigh         = BOOT_FUNC_CANID << 5;
+  if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+  if (HAL_CAN_Start(&hcan1) != HAL_OK) { Error_Handler(); }
+  if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK) { Error_Handler(); }
+
+  HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
+}
+
+/* =========================
+ * Error Handler
+ * ========================= */
+void Error_Handler(void)
+{
+  __disable_irq();
+  while (1) { }
+}
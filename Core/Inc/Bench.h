@@ -0,0 +1,51 @@
+/*
+ * Bench.h
+ *
+ *  진단 경로 마이크로 벤치마크
+ *  - 타깃: DWT CYCCNT (cycle), 호스트(HOST_BUILD): CLOCK_MONOTONIC (ns)
+ *  - 결과 1줄 = 1 시나리오, 형식 고정 (커밋 간 회귀 비교용):
+ *      BENCH v=1 name=<이름> unit=<cyc|ns> ops=<op 수> min=<op당 최소> med=<op당 중앙값>
+ *  - Host/Bench/bench_pmic 는 같은 형식에 unit=us (가상 버스 시간) 로 출력
+ */
+
+#ifndef INC_BENCH_H_
+#define INC_BENCH_H_
+
+#include <stdint.h>
+
+#define BENCH_FORMAT_VERSION   1u
+#define BENCH_MAX_REPEATS      15u
+
+/* 측정 대상: iters 회 반복 실행 */
+typedef void (*Bench_Fn)(void* ctx, uint32_t iters);
+/* 결과 라인 출력 (개행 포함 문자열) */
+typedef void (*Bench_WriteFn)(const char* line);
+
+typedef struct {
+    const char* name;
+    Bench_Fn    fn;
+    void*       ctx;
+    uint32_t    ops_per_iter;   // 1 iteration 당 op 수 (op당 비용 환산용)
+} Bench_Case_t;
+
+typedef struct {
+    uint32_t      iters;        // 반복 1회당 iteration 수
+    uint32_t      repeats;      // 반복 횟수 (min/median 산출, <= BENCH_MAX_REPEATS)
+    Bench_WriteFn write;
+} Bench_Config_t;
+
+typedef struct {
+    uint32_t ops;
+    uint32_t min_x100;          // op당 비용 * 100
+    uint32_t med_x100;
+} Bench_Result_t;
+
+void        Bench_CounterInit(void);
+uint32_t    Bench_Now(void);
+const char* Bench_Unit(void);
+
+void Bench_RunCase(const Bench_Config_t* cfg, const Bench_Case_t* c, Bench_Result_t* out);
+/* DTC/UDS/CRC/EEPROM 직렬화/PMIC 디코드 시나리오 전체 실행 */
+void Bench_RunDiagSuite(const Bench_Config_t* cfg);
+
+#endif /* INC_BENCH_H_ */
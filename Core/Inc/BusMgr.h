@@ -0,0 +1,79 @@
+/*
+ * BusMgr.h
+ *
+ *  I2C1/I2C2/SPI1/SPI2 버스 관리 + 디바이스 레지스트리
+ *  - 디바이스(PMIC, SPI EEPROM, SPI NOR flash)를 어느 버스에든 등록하고 id 로 접근
+ *  - 버스마다 뮤텍스 1개: 다른 버스의 전송은 서로 막지 않는다
+ *  - 데이터 구간은 DMA + 완료 대기(thread flag) → 대기 중 CPU 는 다른 버스 전송을 시작
+ *  - EEPROM 쓰기 사이클(WIP) 동안에는 버스를 놓고 1 tick 간격으로 폴링
+ *    (EEPROM 별 잠금은 유지 → 다른 태스크의 명령이 WIP 중에 무시되지 않음)
+ *  - DMA 완료 타임아웃: 전송을 중단(SPI abort / I2C 재초기화)하고 CS 를 올린 뒤 잠금 해제
+ */
+
+#ifndef INC_BUSMGR_H_
+#define INC_BUSMGR_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include <stdint.h>
+
+#define BUSMGR_MAX_DEVICES    8u
+#define BUSMGR_TIMEOUT_MS     20u          // DMA 완료 대기 (SPI 8MHz 8KB ≈ 8ms)
+#define BUSMGR_WIP_POLL_MAX   20u          // 25LC256 Twc 5ms → tick 폴링 상한
+#define BUSMGR_FLAG_DONE      (1u << 8)    // 대기 태스크 thread flag (태스크 고유 flag 와 겹치지 않게)
+
+typedef enum {
+    BUS_I2C1 = 0,
+    BUS_I2C2,
+    BUS_SPI1,
+    BUS_SPI2,
+    BUS_COUNT
+} BusId_t;
+
+typedef enum {
+    BUSDEV_PMIC = 0,      // MP5475: 8-bit 레지스터 주소, auto-increment
+    BUSDEV_EEPROM,        // 25LC256: 16-bit 주소, 64B page
+    BUSDEV_SPI_FLASH,     // W25Qxx: 24-bit 주소 (쓰기/소거는 SpiFlash.c)
+} BusDevType_t;
+
+typedef struct {
+    const char*    name;
+    BusDevType_t   type;
+    BusId_t        bus;
+    uint16_t       i2c_addr;      // HAL 8-bit 주소 (I2C 디바이스)
+    GPIO_TypeDef*  cs_port;       // SPI CS (NULL = 보드 레벨 CS)
+    uint16_t       cs_pin;
+} BusDev_t;
+
+typedef struct {
+    void*            handle;      // I2C_HandleTypeDef* / SPI_HandleTypeDef*
+    osMutexId_t      lock;
+    osThreadId_t     waiter;      // DMA 완료를 기다리는 태스크
+    volatile uint8_t err;
+    uint32_t         xfers;
+    uint32_t         bytes;
+    uint32_t         errors;
+    uint32_t         contended;   // 잠금 시도 시 다른 태스크가 사용 중이었던 횟수
+} Bus_t;
+
+extern Bus_t busTable[BUS_COUNT];
+
+// main.c에서 정의
+extern I2C_HandleTypeDef hi2c1, hi2c2;
+extern SPI_HandleTypeDef hspi1, hspi2;
+
+void               BusMgr_Init(void);                                  // osKernelInitialize 이후
+void               BusMgr_ShareLock(BusId_t bus, osMutexId_t lock);    // 기존 뮤텍스로 버스 보호 (CommMutex 등)
+int8_t             BusMgr_Register(const BusDev_t* dev);               // 디바이스 id, 실패 시 -1
+int8_t             BusMgr_Find(const char* name);
+const BusDev_t*    BusMgr_Device(int8_t id);
+
+HAL_StatusTypeDef  BusMgr_Read(int8_t id, uint32_t addr, uint8_t* buf, uint16_t len);
+HAL_StatusTypeDef  BusMgr_Write(int8_t id, uint32_t addr, const uint8_t* buf, uint16_t len);
+// SPI 디바이스 명령 1개: 잠금 → CS → 헤더(blocking) → 데이터(DMA) → CS 해제 → 해제
+HAL_StatusTypeDef  BusMgr_SpiCommand(int8_t id, const uint8_t* hdr, uint16_t hdrLen,
+                                     uint8_t* data, uint16_t len, uint8_t isRead);
+
+void               BusMgr_XferDoneFromISR(const void* handle, uint8_t error);
+
+#endif /* INC_BUSMGR_H_ */
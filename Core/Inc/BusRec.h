@@ -0,0 +1,88 @@
+/*
+ * BusRec.h
+ *
+ *  CAN / I2C / SPI 트래픽 기록기 (현장 타이밍 문제 재현용)
+ *  - 드라이버 경계에서 기록: CAN 수신/송신 적재, I2C 레지스터 읽기/쓰기, SPI 메모리 읽기/쓰기
+ *    (flash 프로그램/소거 포함. WIP 폴링 같은 상태 읽기는 타이밍에 따라 횟수가 바뀌므로 기록하지 않음)
+ *  - Task/ISR 어디서나 호출 가능: Trace 와 같은 atomic 예약, 가득 차면 오래된 것부터 덮어씀
+ *  - 긴 데이터는 연속 항목 (한 번에 예약) 에 나눠 담고, BUSREC_MAX_DATA 넘는 부분은 길이만 남김
+ *  - 타임스탬프: DWT CYCCNT + 그 시점 클럭 (MHz). DVFS 전환이 있어도 항목 간 시간 차를 복원
+ *  - UART4 'B' → BusRec_Dump 텍스트. 호스트 Host/Src/host_replay.c 가 같은 텍스트를 재생
+ */
+
+#ifndef INC_BUSREC_H_
+#define INC_BUSREC_H_
+
+#include "stm32f4xx_hal.h"
+#include "BusMgr.h"
+#include <stdint.h>
+
+#ifndef BUSREC_ENABLE
+#define BUSREC_ENABLE        1
+#endif
+
+#ifndef BUSREC_BUF_SIZE
+#define BUSREC_BUF_SIZE      256u      // 항목 수, 2의 거듭제곱 (32B x 256 = 8KB, 호스트는 빌드 옵션으로 확장)
+#endif
+#define BUSREC_CHUNK         15u       // 항목 1 개의 데이터
+#define BUSREC_MAX_DATA      64u       // 레코드 1 개에 담는 최대 데이터 (CAN FD 1 프레임 / EEPROM 1 page)
+#define BUSREC_FORMAT_VERSION 1u
+
+/* 버스: BusId_t (I2C1, I2C2, SPI1, SPI2) 다음에 CAN1 */
+#define BUSREC_BUS_CAN1      ((uint8_t)BUS_COUNT)
+#define BUSREC_BUS_NONE      0xFFu
+
+/* 동작 (분석기/재생기와 공유, 값 변경 금지) */
+typedef enum {
+    BUSREC_OP_CONT = 0,       // 앞 항목의 데이터 이어짐
+    BUSREC_OP_RX   = 1,       // CAN 수신 (ISR 에서 FIFO 를 읽은 시점)
+    BUSREC_OP_TX   = 2,       // CAN 송신 적재 (메일박스 / FD TX 버퍼)
+    BUSREC_OP_RD   = 3,       // I2C 레지스터 / SPI 메모리 읽기 완료
+    BUSREC_OP_WR   = 4,       // I2C 레지스터 / SPI 메모리 쓰기 (flash 소거는 데이터 없이 len = sector)
+} BusRec_Op_t;
+
+/* id:
+     CAN  StdId 또는 ExtId | BUSREC_CAN_EXT, FD 프레임은 | BUSREC_CAN_FD
+     I2C  (HAL 8-bit 주소 << 8) | 첫 레지스터
+     SPI  (BusDevType_t << 24) | 메모리 주소 */
+#define BUSREC_CAN_EXT       0x20000000u
+#define BUSREC_CAN_FD        0x40000000u
+#define BUSREC_I2C_ID(addr8, reg)   (((uint32_t)(addr8) << 8) | (uint8_t)(reg))
+#define BUSREC_SPI_ID(type, addr)   (((uint32_t)(type) << 24) | ((uint32_t)(addr) & 0xFFFFFFu))
+
+typedef struct {
+    uint32_t ts;              // CYCCNT (연속 항목은 0)
+    uint32_t id;
+    uint16_t len;             // 실제 전송 길이 (데이터는 BUSREC_MAX_DATA 까지)
+    uint8_t  bus;
+    uint8_t  op;              // BusRec_Op_t
+    uint8_t  mhz;             // 기록 시점 SystemCoreClock (MHz)
+    uint8_t  data[BUSREC_CHUNK];
+    uint32_t seq;             // 기록 완료 표시 (예약 인덱스 + 1)
+} BusRec_Entry_t;
+
+typedef void (*BusRec_WriteFn)(const char* line);
+
+void     BusRec_Init(void);
+void     BusRec_Log(uint8_t bus, uint8_t op, uint32_t id, const uint8_t* data, uint16_t len);
+// HAL 핸들 → 버스 (모르는 핸들은 BUSREC_BUS_NONE)
+uint8_t  BusRec_BusOf(const void* handle);
+// I2C DMA 완료 콜백: 핸들에 남은 주소/레지스터/버퍼로 기록
+void     BusRec_LogI2C(I2C_HandleTypeDef* hi2c, uint8_t op);
+uint32_t BusRec_Count(void);       // 지금까지 예약된 항목 수
+/* 텍스트 덤프 (오래된 순, 연속 항목은 한 줄로 합침):
+     BUSREC v=1 n=<레코드> dropped=<덮어쓴 항목>
+     B <cyccnt> <mhz> <bus> <op> <id hex> <len> <데이터 hex>
+     E */
+void     BusRec_Dump(BusRec_WriteFn write);
+
+#if BUSREC_ENABLE
+#define BUSREC(bus, op, id, data, len) \
+    BusRec_Log((uint8_t)(bus), (uint8_t)(op), (uint32_t)(id), (const uint8_t*)(data), (uint16_t)(len))
+#define BUSREC_I2C(hi2c, op)           BusRec_LogI2C((hi2c), (uint8_t)(op))
+#else
+#define BUSREC(bus, op, id, data, len) ((void)0)
+#define BUSREC_I2C(hi2c, op)           ((void)0)
+#endif
+
+#endif /* INC_BUSREC_H_ */
@@ -0,0 +1,64 @@
+/*
+ * DID.h
+ *
+ *  DataIdentifier 엔진 (UDS 0x22 ReadDataByIdentifier / 0x2E WriteDataByIdentifier)
+ *  - DID 표는 const (flash), DID 오름차순으로 작성 → 이진 탐색. 순서/중복은 DID_CheckTable 로 확인
+ *  - 읽기: live 포인터가 있으면 그 변수에서 응답 버퍼로 바로 복사 (중간 스냅샷 없음)
+ *          원소 폭(fmt) 단위로 big-endian 변환, 계산이 필요한 값만 read 함수
+ *  - 여러 DID 요청은 응답 하나로 조립 (DID + 데이터 반복, 길이는 ISO-TP 버퍼까지)
+ *  - 쓰기: non-default 세션, DID_ACC_SECURE 는 보안 해제 필요. write 함수가 없으면 live 에 직접 기록
+ */
+
+#ifndef INC_DID_H_
+#define INC_DID_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdint.h>
+
+#define DID_MAX_PER_REQ     16u       // 0x22 한 번에 요청 가능한 DID 수
+#define DID_MAX_DATA        32u       // DID 1 개 데이터 최대 길이
+
+/* 원소 폭: live 변수는 CPU 순서(little-endian), 응답은 big-endian */
+#define DID_FMT_U8          1u
+#define DID_FMT_U16         2u
+#define DID_FMT_U32         4u
+
+#define DID_ACC_READ        0x01u
+#define DID_ACC_WRITE       0x02u     // non-default 세션에서 쓰기 가능
+#define DID_ACC_SECURE      0x04u     // 쓰기에 SecurityAccess 해제 필요
+
+typedef struct DID_Entry DID_Entry_t;
+
+struct DID_Entry {
+    uint16_t did;
+    uint8_t  fmt;                     // DID_FMT_*
+    uint8_t  len;                     // 데이터 바이트 수 (fmt 의 배수)
+    uint8_t  access;                  // DID_ACC_*
+    const volatile void* live;        // zero-copy 원본 (NULL → read)
+    uint8_t  (*read)(uint8_t* out);                                    // 계산 값 → big-endian 데이터
+    HAL_StatusTypeDef (*write)(const DID_Entry_t* e, const uint8_t* in);  // 값 검사 (HAL_ERROR → 0x31)
+};
+
+typedef struct {
+    const DID_Entry_t* e;
+    uint16_t n;
+} DID_Table_t;
+
+extern const DID_Table_t didTable;
+
+// 오름차순, 중복 없음, 길이/폭/원본 확인
+HAL_StatusTypeDef  DID_CheckTable(const DID_Table_t* t);
+const DID_Entry_t* DID_Find(const DID_Table_t* t, uint16_t did);
+// DID 데이터 → out (big-endian), 반환: 길이
+uint8_t            DID_ReadData(const DID_Entry_t* e, uint8_t* out);
+// big-endian 데이터 → live (write 함수에서 검사 후 호출)
+void               DID_Store(const DID_Entry_t* e, const uint8_t* in);
+
+/* 요청 처리: req = SID 다음 바이트부터, 반환 = NRC (0 = 긍정)
+ * Read: rsp 에 DID + 데이터를 이어 붙임 (지원하지 않는 DID 는 건너뜀, 전부 미지원이면 0x31) */
+uint8_t DID_ReadRequest(const DID_Table_t* t, const uint8_t* req, uint16_t len,
+                        uint8_t* rsp, uint16_t max, uint16_t* rspLen);
+uint8_t DID_WriteRequest(const DID_Table_t* t, const uint8_t* req, uint16_t len,
+                         uint8_t session, uint8_t unlocked);
+
+#endif /* INC_DID_H_ */
@@ -23,6 +23,8 @@
 /* CAN ID (예시: 파워트레인 기본) */
 #define UDS_REQ_CANID                      0x7E0u
 #define UDS_RES_CANID                      0x7E8u
+#define UDS_FUNC_REQ_CANID                 0x7DFu   // 기능 주소 (전체 ECU 브로드캐스트), 응답은 UDS_RES_CANID
+#define UDS_PERIODIC_CANID                 0x7F8u   // 0x2A 주기 응답 (응답 0x7E8 보다 낮은 중재 우선순위)
 
 /* DTC 포맷: ISO 14229 3-byte DTC + 1-byte status */
 typedef struct {
@@ -30,13 +32,41 @@ typedef struct {
     uint8_t status;        // UDS status availability mask bits
 } DTC_Record_t;
 
+/* statusOfDTC 비트 (ISO 14229-1 D.2) */
+#define DTC_ST_TF        (1u << 0)  // testFailed
+#define DTC_ST_TFTOC     (1u << 1)  // testFailedThisOperationCycle
+#define DTC_ST_PDTC      (1u << 2)  // pendingDTC
+#define DTC_ST_CDTC      (1u << 3)  // confirmedDTC
+#define DTC_ST_TNCSLC    (1u << 4)  // testNotCompletedSinceLastClear
+#define DTC_ST_TFSLC     (1u << 5)  // testFailedSinceLastClear
+#define DTC_ST_TNCTOC    (1u << 6)  // testNotCompletedThisOperationCycle
+#define DTC_ST_WIR       (1u << 7)  // warningIndicatorRequested
+
 /* 단일 DTC 스토리지(EEPROM) */
 typedef struct {
     DTC_Record_t rec;
-    uint32_t     timestamp_ms; // 선택: 저장 시각
+    uint32_t     timestamp_ms; // 선택: 저장 시각 (압축 테이블: 마지막 발생)
     uint32_t     crc32;        // 간단 무결성(옵션)
+    uint32_t     first_ms;     // 압축 테이블: 첫 발생 시각 (직렬화 12B 에는 없음)
+    uint8_t      occurrence;   // 압축 테이블: 발생 횟수
 } DTC_Entry_t;
 
+#define DTC_ENTRY_SIZE   12u       // EEPROM 상 직렬화 크기 (little-endian)
+
+/* 압축 DTC 테이블 (EEPROM page 단위, 연속 page → 한 번의 순차 READ). 저장 위치/커밋은 DTCMem
+ * page(64B) = [ver:1][page:1][npages:1][count:1][gen:4][base_ts:4] [record...] (0xFF 채움) [crc16:2]
+ * record    = [dtc:3][status:1][occ:1][ts delta: zigzag varint, page 첫 record 는 생략 (= base_ts)]
+ *             [ts - first_ms: varint, occ <= 1 이면 생략 (first_ms = ts)]
+ * status 는 statusOfDTC 비트필드 1B 그대로, CRC-16 은 page 당 1개 (bytes 0..61)
+ * gen 은 모든 page 에 같은 값 → 덮어쓰다 끊긴 이미지 (이전 세대 page 가 섞임) 를 거부 */
+#define DTC_PK_VERSION     0xD2u        // 상위 nibble 0xD = DTC 테이블, 하위 = 형식 버전 2
+#define DTC_PK_PAGE_SIZE   64u          // 25LC256 page
+#define DTC_PK_HDR_SIZE    12u
+#define DTC_PK_CRC_SIZE    2u
+#define DTC_PK_REC_MIN     5u           // dtc + status + occ (delta/first 생략 시)
+#define DTC_PK_MAX_PAGES   8u           // record 최대 15B → 24 DTC 최악의 경우 8 page
+#define DTC_PK_MAX_BYTES   (DTC_PK_MAX_PAGES * DTC_PK_PAGE_SIZE)
+
 /* TJA1051 제어 핀(보드에 맞게 주입) */
 typedef struct {
     GPIO_TypeDef* S_Port;  uint16_t S_Pin;   // S=LOW: Normal, HIGH: Silent (p.5)
@@ -65,11 +95,28 @@ HAL_StatusTypeDef DTC_UDS_ReadByStatusMask(DTC_Ctx_t* ctx,
                                            DTC_Record_t* outList,
                                            uint8_t* inoutCount);
 
-/* EEPROM 연동: 단일 DTC 저장/로드 */
-HAL_StatusTypeDef DTC_SaveToEEPROM(DTC_Ctx_t* ctx, const DTC_Entry_t* e);
-HAL_StatusTypeDef DTC_LoadFromEEPROM(DTC_Ctx_t* ctx, DTC_Entry_t* e);
+/* 0x59/0x02 응답 버퍼 파싱 (DTC_UDS_ReadByStatusMask 내부에서도 사용) */
+HAL_StatusTypeDef DTC_UDS_ParseReadByStatusMask(const uint8_t* resp, uint8_t rlen,
+                                                DTC_Record_t* outList,
+                                                uint8_t* inoutCount);
+
+/* Status 갱신: 테스트 결과 반영 / 운전 사이클 시작 */
+void DTC_UpdateStatus(DTC_Record_t* r, bool failed);
+void DTC_StartOperationCycle(DTC_Record_t* r);
+
+/* EEPROM 레코드 직렬화 */
+void DTC_SerializeEntry(const DTC_Entry_t* e, uint8_t out[DTC_ENTRY_SIZE]);
+void DTC_DeserializeEntry(const uint8_t in[DTC_ENTRY_SIZE], DTC_Entry_t* e);
+
+/* 압축 테이블 인코딩 (list[i].crc32 는 사용하지 않음)
+ * Pack  : *inoutLen = out 크기 → 사용한 바이트 (page 배수). 공간 부족 시 HAL_ERROR
+ * Unpack: *inoutCount = list 크기 → 읽은 개수 (초과분은 버림, 0 이면 검사만). gen 은 NULL 가능
+ *         버전/page 번호/세대/CRC 불일치 시 HAL_ERROR */
+HAL_StatusTypeDef DTC_PackTable(const DTC_Entry_t* list, uint16_t n, uint32_t gen, uint8_t* out, uint16_t* inoutLen);
+HAL_StatusTypeDef DTC_UnpackTable(const uint8_t* in, uint16_t len, DTC_Entry_t* list, uint16_t* inoutCount, uint32_t* gen);
 
 /* 유틸 */
 uint32_t DTC_CalcCRC32(const void* data, uint32_t len);
+uint16_t DTC_CalcCRC16(const void* data, uint32_t len);      // CRC-16/CCITT-FALSE
 
 #endif /* INC_DTC_H_ */
@@ -0,0 +1,101 @@
+/*
+ * DTCMem.h
+ *
+ *  DTC 메모리 (25LC256: 압축 테이블 A/B bank + index page)
+ *  - bank: DTC_PackTable 형식 (DTC.h) 으로 테이블 전체, 세대(gen) 포함. 두 bank 에 번갈아 기록
+ *  - index: 커밋된 bank/gen + 점유 bitmap + slot 별 dtc/status 요약 + CRC-16 (2 page, 한 번의 READ)
+ *  - 부팅: index 만 읽고 UDS 응답 가능 → bank 상세는 그 뒤에 한 번의 burst 로 로드
+ *    index 무효(CRC/버전/기록 중 전원 차단) 시 두 bank 를 한 번에 읽어 유효한 최신 gen 선택 후 index 재작성
+ *  - 갱신 순서: 비활성 bank 에 gen+1 기록 → index 기록 (커밋 지점). 중간에 끊겨도 이전 bank 는 그대로
+ *  - Report 는 RAM 만 갱신 (버스 잠금을 쥔 파이프라인에서 호출), EEPROM 기록은 UDSTask 가 Flush
+ */
+
+#ifndef INC_DTCMEM_H_
+#define INC_DTCMEM_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "DTC.h"
+#include "Mpu.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DTCMEM_SLOTS          24u
+#define DTCMEM_INDEX_SIZE     128u         // 2 page
+#define DTCMEM_INDEX_ADDR     0x0080u      // 0x0080..0x00FF
+#define DTCMEM_BANK_SIZE      DTC_PK_MAX_BYTES
+#define DTCMEM_BANK_A         0x0100u      // 0x0100..0x02FF
+#define DTCMEM_BANK_B         0x0300u      // 0x0300..0x04FF (A 바로 뒤 → scan 은 한 번의 READ)
+#define DTCMEM_BANK_ADDR(b)   ((uint16_t)(DTCMEM_BANK_A + (uint32_t)(b) * DTCMEM_BANK_SIZE))
+
+#define DTCMEM_IDX_VERSION    0xE2u        // 상위 nibble 0xE = DTC index, 하위 = 형식 버전 2
+#define DTCMEM_STATUS_AVAIL   0x7Fu        // 지원 status 비트 (WIR 미사용)
+
+/* index (128B)
+ *   [0] ver [1] bank (0=A 1=B) [2..5] gen [6..9] 점유 bitmap [10] count [11] status OR
+ *   [12] bank page 수 [13..15] 0xFF
+ *   [16 + 4*i] slot i: dtc(3) status(1) (빈 slot 0xFF) ... [126..127] CRC-16 (bytes 0..125)
+ * bank: 점유 slot 을 slot 순서대로 DTC_PackTable (timestamp = 마지막 발생, first_ms, occurrence) */
+
+typedef enum {
+    DTCMEM_PATH_NONE = 0,
+    DTCMEM_PATH_INDEX,        // index 1 회 읽기로 mount
+    DTCMEM_PATH_SCAN,         // index 무효 → 두 bank scan
+} DTCMem_Path_t;
+
+typedef struct {
+    uint8_t  used;
+    uint8_t  dtc[3];
+    uint8_t  status;
+    uint8_t  occurrence;      // 실패 진입 횟수 (255 포화). 상세 로드 전에는 mount 이후 증가분
+    uint32_t first_ms;
+    uint32_t last_ms;
+} DTCMem_Slot_t;
+
+typedef struct {
+    int8_t           dev;         // BusMgr EEPROM 디바이스
+    osMutexId_t      lock;
+    volatile uint8_t ready;       // UDS 조회 가능
+    uint8_t          details;     // slot 상세(발생 횟수/시각) 로드 완료
+    uint8_t          path;        // DTCMem_Path_t
+    uint8_t          idx_dirty;   // index 재작성 필요 (scan 후 등)
+    uint8_t          bank;        // 커밋된 bank (다음 Flush 는 반대편)
+    uint8_t          npages;      // 커밋된 bank 의 page 수
+    uint32_t         gen;         // 커밋된 bank 세대
+    uint32_t         dirty;       // bit i: slot i 변경 (다음 Flush 에서 bank 커밋)
+    DTCMem_Slot_t    slot[DTCMEM_SLOTS];
+
+    uint32_t mount_reads;         // mount 에 쓴 EEPROM READ 횟수 / 바이트
+    uint32_t mount_bytes;
+    uint32_t mismatches;          // 상세 로드 시 index 와 다른 slot
+    uint32_t page_writes;         // bank page
+    uint32_t index_writes;
+    uint32_t errors;
+    uint32_t full;                // 빈 slot 이 없어 거절된 Report
+} MPU_REGION(MPU_DTCMEM_SIZE) DTCMem_t;   // MPU region 하나 (저장 서비스 + I2C/SPI 파이프라인 Task 만 쓰기)
+
+extern DTCMem_t dtcMem;
+
+void              DTCMem_Init(DTCMem_t* m, int8_t busDev);         // osKernelInitialize 이후
+// index → (무효 시) 두 bank scan. 버스 잠금을 쥔 채 호출 금지
+HAL_StatusTypeDef DTCMem_Mount(DTCMem_t* m);
+HAL_StatusTypeDef DTCMem_LoadDetails(DTCMem_t* m);
+bool              DTCMem_Ready(const DTCMem_t* m);
+
+// 테스트 결과 반영 (RAM 만). mount 전 HAL_BUSY, slot 부족 HAL_ERROR
+HAL_StatusTypeDef DTCMem_Report(DTCMem_t* m, const uint8_t dtc3[3], bool failed);
+void              DTCMem_Clear(DTCMem_t* m);
+uint16_t          DTCMem_CountByMask(DTCMem_t* m, uint8_t mask);
+// 일치 DTC 를 slot 순서로 최대 max 개 복사, 반환 = 일치 총 개수
+uint16_t          DTCMem_ReadByMask(DTCMem_t* m, uint8_t mask, DTC_Record_t* out, uint16_t max);
+
+bool              DTCMem_Pending(DTCMem_t* m);
+HAL_StatusTypeDef DTCMem_Flush(DTCMem_t* m);
+
+/* EEPROM 이미지 직렬화 (Flush 와 테스트 준비에 사용)
+ * Bank: *inoutLen = out 크기 → 사용한 바이트 (page 배수) */
+HAL_StatusTypeDef DTCMem_EncodeBank(const DTCMem_t* m, uint32_t gen, uint8_t* out, uint16_t* inoutLen);
+void              DTCMem_EncodeIndex(const DTCMem_t* m, uint8_t bank, uint32_t gen, uint8_t npages,
+                                     uint8_t out[DTCMEM_INDEX_SIZE]);
+
+#endif /* INC_DTCMEM_H_ */
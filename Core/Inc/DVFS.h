@@ -0,0 +1,78 @@
+/*
+ * DVFS.h
+ *
+ *  동작점(OPP) 거버너: SYSCLK(PLL) 와 MP5475 Buck A(코어 레일) 를 함께 전환
+ *  - 진단 세션/CAN 부하가 있으면 클럭 상승, 유휴가 지속되면 클럭·전압 하강
+ *  - 순서: 올릴 때 전압 → 클럭, 내릴 때 클럭 → 전압
+ *  - 모든 OPP 에서 PCLK1/PCLK2 = 16MHz 유지 (CAN/UART/I2C/SPI 재초기화 불필요).
+ *    APB 분주 ≠ 1 이면 타이머 클럭만 x2 가 되므로 TIM2 ARR 을 다시 맞춘다.
+ */
+
+#ifndef INC_DVFS_H_
+#define INC_DVFS_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include <stdint.h>
+
+#define DVFS_PERIOD_MS        10u     // 거버너 평가 주기
+#define DVFS_DOWN_HOLD_MS     100u    // 낮은 요구가 이만큼 지속돼야 하강
+#define DVFS_CAN_MID_FPS      200u    // CAN 프레임/s 이상 → MID
+#define DVFS_CAN_HIGH_FPS     1000u   // 이상 → HIGH
+#define DVFS_CAN_EMA_SHIFT    2u      // 프레임율 1차 IIR (주기당 1/4 반영, 10ms 창의 양자화 완화)
+#define DVFS_VRAMP_STEP_LSB   5u      // Buck 램프 50mV/step, step 간 1 tick
+
+/* 성능 요구 원천 (비트) */
+#define DVFS_DEMAND_DIAG      (1u << 0)   // UDS 진단 세션 (default 세션 외)
+#define DVFS_DEMAND_FLASH     (1u << 1)   // 다운로드/재프로그래밍
+
+typedef enum {
+    DVFS_OPP_LOW = 0,     // HSI 16MHz (SystemClock_Config 부팅 상태)
+    DVFS_OPP_MID,         // PLL 32MHz
+    DVFS_OPP_HIGH,        // PLL 64MHz
+    DVFS_OPP_COUNT
+} DVFS_OppId_t;
+
+typedef struct {
+    const char* name;
+    uint32_t sysclk_hz;
+    uint8_t  use_pll;
+    uint16_t pll_n;           // PLLM = 8 고정 (VCO 입력 2MHz)
+    uint8_t  pll_p;
+    uint32_t apb_div;         // APB1/APB2 공통 (PCLK 16MHz)
+    uint32_t flash_latency;
+    uint16_t vcore_mV;        // Buck A
+} DVFS_Opp_t;
+
+typedef struct {
+    uint8_t  cur;                           // 현재 클럭 OPP
+    int8_t   forced;                        // -1: 거버너, 그 외: 고정 OPP
+    uint8_t  vcore_pending;                 // 전압 하강 미완료 (다음 주기 재시도)
+    volatile uint8_t  demand;               // DVFS_DEMAND_*
+    volatile uint32_t can_frames;           // 평가 주기 내 CAN 프레임 (ISR 누적)
+    uint32_t can_fps;                       // 필터된 프레임/s
+    uint32_t down_hold_ms;
+    uint32_t residency_ms[DVFS_OPP_COUNT];
+    uint32_t transitions;
+    uint32_t failures;
+    uint32_t last_switch_ms;
+    uint32_t max_switch_ms;
+} DVFS_State_t;
+
+extern const DVFS_Opp_t DVFS_OppTable[DVFS_OPP_COUNT];
+extern DVFS_State_t dvfs;
+
+// main.c에서 생성/정의
+extern osMutexId_t CommMutexHandle;
+
+void              DVFS_Init(void);                             // PMIC_ShadowInit 이후, 커널 시작 전
+void              DVFS_SetDemand(uint8_t src, uint8_t active);
+void              DVFS_NotifyCanFrame(void);                   // ISR 에서 호출 가능
+void              DVFS_Force(int8_t opp);                      // -1 = 거버너 복귀
+uint8_t           DVFS_Decide(DVFS_State_t* s, uint32_t canFps, uint32_t elapsedMs);
+HAL_StatusTypeDef DVFS_Apply(uint8_t target);
+
+// RTOS task entry
+void StartDvfsTask(void *argument);
+
+#endif /* INC_DVFS_H_ */
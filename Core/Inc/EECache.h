@@ -0,0 +1,67 @@
+/*
+ * EECache.h
+ *
+ *  25LC256 앞단 RAM write-back 캐시 (page 단위)
+ *  - 생산자 EECache_Write 는 RAM 복사만: 버스/쓰기 사이클을 기다리지 않는다
+ *  - line = EEPROM page 1 개, 바이트 단위 valid/dirty 비트맵 → 같은 page 반복 갱신은 1 회 기록으로 합쳐짐
+ *  - EECacheTask: dirty 가 된 시점 + FLUSH_DELAY 까지 기록 (deadline 순), dirty 구간만 page write
+ *  - 강제 flush: PMIC UV 경고 / 공급 전압 저하 시 EECache_RequestFlush (ISR 에서도 호출 가능)
+ *  - 빈 line 이 없으면 clean line 을 재사용, 전부 dirty 면 HAL_BUSY (생산자는 버스 잠금을 잡지 않음)
+ */
+
+#ifndef INC_EECACHE_H_
+#define INC_EECACHE_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "EEPROM.h"
+#include "Mpu.h"
+#include <stdint.h>
+
+#define EECACHE_LINES            8u
+#define EECACHE_FLUSH_DELAY_MS   200u     // dirty 후 기록까지 최대 지연 (합치기 창)
+#define EECACHE_FLAG_KICK        (1u << 0)
+#define EECACHE_FLAG_FORCE       (1u << 1)
+
+typedef struct {
+    uint16_t page;            // EEPROM 주소 / EEPROM_PAGE_SIZE
+    uint8_t  used;
+    uint8_t  busy;            // flush 중 (재사용 금지)
+    uint64_t valid;           // bit n: page 내 n 번째 바이트 값을 알고 있음
+    uint64_t dirty;           // bit n: 기록 대기
+    uint32_t deadline;        // tick: 첫 dirty + FLUSH_DELAY
+    uint32_t lru;
+    uint8_t  data[EEPROM_PAGE_SIZE];
+} EECache_Line_t;
+
+typedef struct {
+    int8_t         dev;       // BusMgr EEPROM 디바이스
+    osMutexId_t    lock;
+    osThreadId_t   thread;
+    uint32_t       lru_clock;
+    EECache_Line_t line[EECACHE_LINES];
+
+    uint32_t writes;          // 생산자 쓰기 호출
+    uint32_t coalesced;       // 이미 dirty 인 line 에 합쳐진 쓰기
+    uint32_t dev_writes;      // 실제 EEPROM WRITE 명령 (dirty 구간 1 개 = 1 회)
+    uint32_t full;            // 모든 line 이 dirty 라 거절
+    uint32_t forced;          // 처리한 강제 flush (EECacheTask 가 셈: 요청자는 이 구조체에 쓰지 않음)
+    uint32_t flush_errors;
+    uint32_t peek_hits, peek_misses;
+} MPU_REGION(MPU_EECACHE_SIZE) EECache_t;   // MPU region 하나 (저장 서비스 + I2C/SPI 파이프라인 Task 만 쓰기)
+
+extern EECache_t eeCache;
+
+void              EECache_Init(EECache_t* c, int8_t busDev);      // osKernelInitialize 이후
+HAL_StatusTypeDef EECache_Write(EECache_t* c, uint16_t addr, const uint8_t* data, uint16_t len);
+// 캐시에 있는 값만으로 채울 수 있으면 HAL_OK (버스 접근 없음)
+HAL_StatusTypeDef EECache_Peek(EECache_t* c, uint16_t addr, uint8_t* buf, uint16_t len);
+// EEPROM 읽기 + 캐시 값 덮어쓰기 (버스 잠금을 쥔 채 호출 금지)
+HAL_StatusTypeDef EECache_Read(EECache_t* c, uint16_t addr, uint8_t* buf, uint16_t len);
+void              EECache_RequestFlush(EECache_t* c);
+uint32_t          EECache_DirtyLines(EECache_t* c);
+
+// RTOS task entry
+void StartEECacheTask(void *argument);
+
+#endif /* INC_EECACHE_H_ */
@@ -0,0 +1,90 @@
+/*
+ * FlashLog.h
+ *
+ *  SPI NOR flash 위의 로그 구조(circular) 저장소: DTC 이력, trace 등 대용량 append 전용
+ *  - 영역 = 연속한 4KB sector N 개. sector 머리(20B)에 sector seq / 첫 record seq / 소거 횟수
+ *  - record = [A5][type][len:2][seq:4][payload][crc32:4], 4B 정렬, CRC 는 type~payload
+ *  - append 는 head sector 의 소거된 영역에만 기록 (erase-before-write)
+ *  - head sector 가 차면 다음 sector 를 소거해서 열고, 한 바퀴 돌면 가장 오래된 sector 를 버림
+ *  - 마운트: sector 머리 N 개 + head sector 1 개만 읽음 → 복구 시간은 영역 크기에 거의 무관
+ *    전원 차단으로 잘린 record 는 CRC 로 걸러 내고, 머리가 잘린 경우 그 sector 는 닫는다
+ *  - 작고 자주 바뀌는 레코드(현재 DTC 등)는 계속 25LC256 에 둔다
+ */
+
+#ifndef INC_FLASHLOG_H_
+#define INC_FLASHLOG_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "SpiFlash.h"
+#include <stdint.h>
+
+#define FLASHLOG_SECTOR_MAGIC    0x314C4746u      // "FGL1"
+#define FLASHLOG_REC_MAGIC       0xA5u
+#define FLASHLOG_SECTOR_HDR      20u
+#define FLASHLOG_REC_OVERHEAD    12u
+#define FLASHLOG_MAX_PAYLOAD     256u
+
+/* 보드 배치: W25Q16 앞 1MB 를 로그 영역으로 */
+#define FLASHLOG_BASE            0x000000u
+#define FLASHLOG_SECTORS         256u
+
+/* record type */
+#define FLASHLOG_REC_DTC         0x01u   // code(2) status(1) tick_ms(4)
+#define FLASHLOG_REC_TRACE       0x02u   // Trace_Rec_t 묶음
+
+/* LogTask 큐 메시지 */
+#define FLASHLOG_MSG_DATA        14u
+#define FLASHLOG_QUEUE_DEPTH     16u
+
+typedef struct {
+    uint8_t type;
+    uint8_t len;
+    uint8_t data[FLASHLOG_MSG_DATA];
+} FlashLog_Msg_t;
+
+typedef struct {
+    SpiFlash_t* fl;
+    uint32_t base;
+    uint32_t sectors;
+    uint32_t head;            // 기록 중인 sector
+    uint32_t head_off;        // head sector 내 다음 기록 위치
+    uint32_t head_seq;
+    uint32_t tail;            // 가장 오래된 유효 sector
+    uint32_t next_rec;        // 다음 record seq
+    uint8_t  mounted;
+
+    uint32_t appended;
+    uint32_t dropped_sectors; // 한 바퀴 돌아 버린 sector
+    uint32_t torn;            // 마운트/읽기 중 CRC 불일치 또는 잘린 머리
+    uint32_t queue_drops;     // FlashLog_Post 큐 가득
+} FlashLog_t;
+
+typedef struct {
+    uint32_t sector;
+    uint32_t off;
+    uint32_t visited;         // 지나온 sector 수
+} FlashLog_Iter_t;
+
+extern FlashLog_t flashLog;
+extern SpiFlash_t spiFlash;
+
+// main.c에서 생성
+extern osMessageQueueId_t LogQueueHandle;
+
+HAL_StatusTypeDef FlashLog_Mount(FlashLog_t* log, SpiFlash_t* fl, uint32_t base, uint32_t sectors);
+HAL_StatusTypeDef FlashLog_Format(FlashLog_t* log);
+HAL_StatusTypeDef FlashLog_Append(FlashLog_t* log, uint8_t type, const void* data, uint16_t len);
+
+void              FlashLog_IterBegin(const FlashLog_t* log, FlashLog_Iter_t* it);
+// tail → head 순서로 다음 유효 record (CRC 불일치는 건너뜀). 더 없으면 HAL_ERROR
+HAL_StatusTypeDef FlashLog_IterNext(FlashLog_t* log, FlashLog_Iter_t* it, uint8_t* type, uint32_t* seq,
+                                    uint8_t* buf, uint16_t bufLen, uint16_t* len);
+
+// 태스크/ISR 어디서든: LogTask 큐에 넣기 (가득 차면 버림)
+void FlashLog_Post(uint8_t type, const void* data, uint8_t len);
+
+// RTOS task entry
+void StartLogTask(void *argument);
+
+#endif /* INC_FLASHLOG_H_ */
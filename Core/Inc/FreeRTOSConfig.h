@@ -52,12 +52,16 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
   void xPortSysTickHandler(void);
+#ifdef APP_BUILD
+  void Mpu_SwitchIn(void* tag);
+#endif
 #endif
 #ifndef CMSIS_device_header
 #define CMSIS_device_header "stm32f4xx.h"
 #endif /* CMSIS_device_header */
 
 #define configENABLE_FPU                         0
+/* ARMv8-M 포트 전용 (ARM_CM4F 에는 영향 없음). Task 격리는 Mpu.c: 전환 훅에서 region 교체 */
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
@@ -65,6 +69,10 @@
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
 #define configUSE_TICK_HOOK                      0
+/* 스택 오버플로: 전환 시 SP 범위 + 스택 바닥 16B 채움 패턴 검사 → StackMon 훅 (기록 후 리셋)
+   heap_4 할당 실패 → StackMon 훅 (횟수/DTC) */
+#define configCHECK_FOR_STACK_OVERFLOW           2
+#define configUSE_MALLOC_FAILED_HOOK             1
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
@@ -72,6 +80,8 @@
 #define configTOTAL_HEAP_SIZE                    ((size_t)15360)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
+/* task tag = Task 별 MPU region 값 (Mpu_Attach) */
+#define configUSE_APPLICATION_TASK_TAG           1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
@@ -90,7 +100,8 @@
 
 /* Software timer definitions. */
 #define configUSE_TIMERS                         1
-#define configTIMER_TASK_PRIORITY                ( 2 )
+/* UDS P2/S3 타이머 콜백이 UDSTask(osPriorityAboveNormal) 를 선점해 0x78 을 보내도록 osPriorityHigh(40) */
+#define configTIMER_TASK_PRIORITY                ( 40 )
 #define configTIMER_QUEUE_LENGTH                 10
 #define configTIMER_TASK_STACK_DEPTH             256
 
@@ -166,6 +177,11 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* 새 Task 로 전환될 때 (PendSV / 스케줄러 시작): 그 Task 의 MPU region 적용.
+   앱 빌드만 (APP_BUILD): 부트로더는 같은 설정을 쓰지만 Mpu.c 를 링크하지 않음 */
+#ifdef APP_BUILD
+#define traceTASK_SWITCHED_IN()    Mpu_SwitchIn((void*)pxCurrentTCB->pxTaskTag)
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,78 @@
+/*
+ * IsoTp.h
+ *
+ *  ISO 15765-2 전송 계층 (normal addressing, classic CAN 8B / CAN FD 64B)
+ *  - SF / FF + CF 분할 송신, 재조립 수신, FC (CTS / WAIT / OVFLW)
+ *  - 프레임 송수신은 링크 함수로 주입 (UDS_CAN: CAN1 메일박스 또는 FD 포트 + udsRxRing)
+ *  - 프레임은 (데이터, 길이) 쌍. 송신 TX_DL 은 링크 설정 (8 = classic, 12~64 = FD)
+ *    SF 가 7B 를 넘으면 escape SF (00 len), FF 는 TX_DL 만큼, CF 는 마지막만 짧게 (다음 유효 DLC 길이까지 패딩)
+ *    수신 RX_DL 은 FF 프레임 길이로 정함 (escape FF 의 32 비트 길이는 OVFLW)
+ *  - 수신 측 FC 는 BS=0, STmin=0 (한 번에 전부 받음)
+ *  - 블로킹 API: 호출한 Task 가 FC/CF 를 기다림 (UDSTask 전용)
+ */
+
+#ifndef INC_ISOTP_H_
+#define INC_ISOTP_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include <stdint.h>
+
+#define ISOTP_FRAME_LEN     8u        // classic CAN (TX_DL 기본값)
+#define ISOTP_FRAME_MAX     64u       // CAN FD
+#define ISOTP_SF_MAX        7u        // PCI 1B SF (escape 없음)
+#define ISOTP_FF_DATA       6u        // classic FF 데이터 (TX_DL - 2)
+#define ISOTP_CF_DATA       7u        // classic CF 데이터 (TX_DL - 1)
+#define ISOTP_MAX_LEN       4095u     // 응답 버퍼 (FF 길이 12 비트 전체, escape FF 는 보내지 않음)
+#define ISOTP_PAD_BYTE      0xAAu
+
+/* PCI 상위 nibble */
+#define ISOTP_PCI_SF        0x00u
+#define ISOTP_PCI_FF        0x10u
+#define ISOTP_PCI_CF        0x20u
+#define ISOTP_PCI_FC        0x30u
+
+#define ISOTP_FC_CTS        0x00u
+#define ISOTP_FC_WAIT       0x01u
+#define ISOTP_FC_OVFLW      0x02u
+
+/* 타임아웃 (ISO 15765-2 기본값) */
+#define ISOTP_N_BS_MS       1000u     // FF/CF 블록 송신 후 FC 대기
+#define ISOTP_N_CR_MS       1000u     // 다음 CF 대기
+#define ISOTP_N_AS_MS       1000u     // 메일박스 확보 대기
+#define ISOTP_WFT_MAX       8u        // 연속 FC WAIT 허용 수
+
+typedef struct {
+    HAL_StatusTypeDef (*send)(const uint8_t* frame, uint8_t len);                 // 1 개 (len = 유효 DLC 길이, 메일박스 없음 = HAL_BUSY)
+    HAL_StatusTypeDef (*recv)(uint8_t* frame, uint8_t* len, uint32_t timeout_ms); // 피어 프레임 1 개 (없음 = HAL_TIMEOUT)
+    uint8_t  tx_dl;                   // 송신 프레임 최대 길이 (0 = ISOTP_FRAME_LEN)
+
+    /* 재조립 중 끼어든 새 요청 (SF/FF): 호출자가 다음에 처리 */
+    uint8_t  held[ISOTP_FRAME_MAX];
+    uint8_t  held_len;
+    uint8_t  held_valid;
+
+    uint32_t rx_msgs, tx_msgs;
+    uint32_t timeouts;
+    uint32_t seq_errors;
+    uint32_t overflows;               // 버퍼보다 긴 FF (OVFLW 응답) / 피어의 OVFLW
+} IsoTp_Link_t;
+
+/* CAN FD DLC ↔ 데이터 길이 (0~8, 12, 16, 20, 24, 32, 48, 64) */
+uint8_t           IsoTp_DlcToLen(uint8_t dlc);
+uint8_t           IsoTp_LenToDlc(uint8_t len);         // len 이상인 가장 작은 유효 길이의 DLC
+// 패딩 후 프레임 길이: 8 이하는 8 (classic 과 같음), 그 외 다음 유효 DLC 길이
+uint8_t           IsoTp_PadLen(uint8_t len);
+
+// 수신 프레임 종류 (ISOTP_PCI_*), 길이 검사 포함. 0xFF = 잘못된 프레임
+uint8_t           IsoTp_FrameType(const uint8_t* frame, uint8_t len);
+// SF 데이터 (escape 포함) → 길이, SF 가 아니면 0
+uint8_t           IsoTp_SingleData(const uint8_t* frame, uint8_t len, const uint8_t** data);
+// first = SF 또는 FF (flen = 프레임 길이). FF 면 FC 송신 후 CF 를 모아 buf 에 재조립
+HAL_StatusTypeDef IsoTp_Receive(IsoTp_Link_t* l, const uint8_t* first, uint8_t flen, uint8_t* buf, uint16_t max, uint16_t* len);
+// 첫 프레임 (SF 에 들어가면 SF, 그 외 FF) 구성 → 실린 데이터 바이트 수, *flen = 프레임 길이
+uint16_t          IsoTp_FirstFrame(const IsoTp_Link_t* l, const uint8_t* buf, uint16_t len, uint8_t* frame, uint8_t* flen);
+// FF 송신 이후: FC 대기 → CF 송신 (pos = 이미 보낸 데이터 바이트 수)
+HAL_StatusTypeDef IsoTp_SendRest(IsoTp_Link_t* l, const uint8_t* buf, uint16_t len, uint16_t pos);
+
+#endif /* INC_ISOTP_H_ */
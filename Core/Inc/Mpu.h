@@ -0,0 +1,102 @@
+/*
+ * Mpu.h
+ *
+ *  MPU 로 Task 간 메모리 격리 (Cortex-M4 PMSAv7, region 8 개)
+ *  - 포트는 ARM_CM4F 그대로 (Task 는 privileged). configENABLE_MPU 는 ARMv8-M 포트 전용이고
+ *    ARM_CM4_MPU 포트는 restricted Task 가 필요해 CMSIS-RTOS2 osThreadNew 와 맞지 않음
+ *    → privileged 접근에도 적용되는 읽기 전용 region 으로 보호, 밖은 기본 메모리 맵 (PRIVDEFENA)
+ *  - region (객체 타입이 region 크기로 정렬/패딩 → 이웃 변수가 같은 region 에 들어오지 않음)
+ *      R5 dtcMem, R6 eeCache : 저장 서비스 (defaultTask, EECacheTask, UDSTask) 와
+ *                              파이프라인 I2CTask (DTC 보고, 캐시 쓰기) / SPITask (캐시 조회 LRU) 만 RW
+ *      R7 pipeBuf (256B, slice 32B = subregion): 자기 slice 만 subregion 비활성 (= RW), 나머지 RO
+ *  - Task 별 RBAR/RASR 3 쌍을 미리 계산, traceTASK_SWITCHED_IN 에서 alias 레지스터에 6 word store
+ *  - 위반 → MemManage: 주소/Task 를 .noinit 에 남기고 리셋, 다음 부팅에 DTC P0604-03
+ */
+
+#ifndef INC_MPU_H_
+#define INC_MPU_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "Bench.h"
+#include <stdint.h>
+
+#define MPU_DTCMEM_SIZE       512u
+#define MPU_EECACHE_SIZE      1024u
+#define MPU_PIPE_SIZE         256u
+#define MPU_PIPE_SLICE        (MPU_PIPE_SIZE / 8u)    // subregion 1 개
+
+#define MPU_RGN_DTCMEM        5u
+#define MPU_RGN_EECACHE       6u
+#define MPU_RGN_PIPE          7u
+#define MPU_SWITCH_REGIONS    3u                      // 전환 시 다시 쓰는 region (R5..R7)
+
+// 타입/변수를 region 크기로 정렬 (타입에 붙이면 sizeof 도 region 크기로 패딩)
+#define MPU_REGION(size)      __attribute__((aligned(size)))
+
+// P0604 (Internal Control Module RAM Error), 하위 바이트 = failure type (StackMon 01/02 다음)
+#define MPU_DTC_VIOLATION     0x060403u
+
+/* 파이프라인 버퍼 slice 번호 (Task.c pipeBuf 의 멤버 순서) */
+#define MPU_SLICE_I2C         0u
+#define MPU_SLICE_SPI         1u
+#define MPU_SLICE_NONE        0xFFu
+
+typedef enum {
+    MPU_DOM_BOOT = 0,         // 스케줄러 시작 전 (main): 전부 RW
+    MPU_DOM_DEFAULT,          // 태그 없는 Task (IDLE, Tmr_Svc 포함): 저장 상태 / 버퍼 RO
+    MPU_DOM_STORAGE,          // 저장 서비스: dtcMem / eeCache RW
+    MPU_DOM_I2C,              // I2CTask: dtcMem / eeCache RW (DTC 보고, 캐시 쓰기) + I2C slice
+    MPU_DOM_SPI,              // SPITask: dtcMem / eeCache RW (캐시 조회가 LRU/통계 갱신) + SPI slice
+    MPU_DOM_COUNT
+} Mpu_DomainId_t;
+
+/* 전환 시 그대로 MPU->RBAR.. (alias 포함 6 word) 에 쓰는 값 */
+typedef struct {
+    uint32_t regs[MPU_SWITCH_REGIONS * 2u];
+} Mpu_Domain_t;
+
+/* region 배치 (Mpu_Init 검사, Host/Tools/mpu_check 가 같은 표를 출력/검사) */
+typedef struct {
+    const char* name;         // 변수 이름 (타깃 .map 의 .bss.<name>)
+    uint8_t     region;
+    uint32_t    base;
+    uint32_t    size;         // region 크기
+    uint32_t    obj_size;     // sizeof(변수): region 크기와 같아야 함
+} Mpu_Region_t;
+
+typedef struct {
+    uint8_t           enabled;      // 전환 시 region 갱신 (벤치에서 끄고 켬)
+    uint8_t           layout_ok;    // Init 검사 통과 (실패 시 MPU 를 켜지 않음)
+    uint32_t          faults;       // MemManage 누적 (리셋을 넘어 유지)
+    uint32_t          fault_addr;   // 마지막 위반 주소 (MMFAR, 모르면 0)
+    char              fault_task[16];
+} Mpu_State_t;
+
+extern Mpu_State_t mpuState;
+
+// 부팅 시 1 회 (StackMon_Init 뒤, 저장 모듈 Init 전이어도 됨): 배치 검사 + Task 별 값 계산 + BOOT 로 활성
+void              Mpu_Init(void);
+// Task 생성 직후: 전환 시 적용할 domain (task tag 로 보관)
+void              Mpu_Attach(osThreadId_t thread, Mpu_DomainId_t dom);
+const Mpu_Domain_t* Mpu_Domain(Mpu_DomainId_t dom);
+// traceTASK_SWITCHED_IN (PendSV 안). tag = 새 Task 의 pxTaskTag (NULL = DEFAULT)
+void              Mpu_SwitchIn(void* tag);
+// 0: MPU 끔 + 전환 시 갱신 생략 (벤치 비교용), 1: 현재 Task domain 으로 다시 켬
+void              Mpu_SetEnabled(uint8_t on);
+
+const Mpu_Region_t* Mpu_Layout(uint32_t* count);
+// PMSAv7 제약: 크기 2^n (>= 32), base 가 크기로 정렬, 객체가 region 을 정확히 채움
+HAL_StatusTypeDef Mpu_CheckRegion(const Mpu_Region_t* r);
+
+// MemManage_Handler: 기록 후 리셋 (호스트는 기록만)
+void              Mpu_Fault(uint32_t addr);
+// Task 에서 주기 호출: 보고 대기 중인 위반을 DTC 메모리에 (mount 후)
+void              Mpu_Service(void);
+
+/* 문맥 전환 비용: 두 Task 가 thread flag 로 주고받는 왕복 (op = 전환 1 회)
+     BENCH v=1 name=ctxsw_mpu_off ...   /   name=ctxsw_mpu_on ...
+   호출 Task 의 우선순위를 잠시 올림. 다른 Task 는 쉬고 있어야 함 (DIAG_BENCH: CommMutex 보유) */
+void              Mpu_RunSwitchBench(const Bench_Config_t* cfg);
+
+#endif /* INC_MPU_H_ */
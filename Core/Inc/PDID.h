@@ -0,0 +1,79 @@
+/*
+ * PDID.h
+ *
+ *  ReadDataByPeriodicIdentifier (0x2A) 스케줄러
+ *  - periodic DID = 0xF2xx (요청에는 하위 바이트만), 데이터는 DID 표 (live 원본, 7B 이하)
+ *  - 주기 응답 = single CAN frame 1 개: pDID + 데이터 (PCI 없음, ISO 14229-2 type 1)
+ *  - 기준 tick 1 개 (software timer, 빠른 주기) 에서 만기 DID 를 송신 대기열에 넣고,
+ *    이후 프레임은 CAN TX 완료 인터럽트에서 채움 → 프레임마다 Task 를 깨우지 않음
+ *  - 같은 주기의 DID 는 첫 송신 tick 을 나눠 배치 (한 tick 에 몰리지 않도록)
+ *  - 송신 전에 아직 대기 중인 DID 가 다시 만기 → 이번 주기는 건너뜀 (late)
+ *  - 예약이 없으면 타이머 정지, 세션 전환 시 전부 해제
+ */
+
+#ifndef INC_PDID_H_
+#define INC_PDID_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "DID.h"
+#include <stdint.h>
+
+#define PDID_MAX            128u      // 동시에 예약 가능한 periodic DID 수
+#define PDID_DID_BASE       0xF200u
+#define PDID_DATA_MAX       7u        // 8B 프레임 - pDID 1B
+
+/* transmissionMode */
+#define PDID_MODE_SLOW      0x01u
+#define PDID_MODE_MEDIUM    0x02u
+#define PDID_MODE_FAST      0x03u
+#define PDID_MODE_STOP      0x04u
+
+#define PDID_TICK_MS        10u       // 기준 tick = 빠른 주기
+#define PDID_RATE_SLOW_MS   1000u
+#define PDID_RATE_MEDIUM_MS 100u
+#define PDID_RATE_FAST_MS   PDID_TICK_MS
+
+typedef struct {
+    const DID_Entry_t* e;             // NULL = 빈 slot
+    uint8_t  pdid;
+    uint8_t  mode;                    // PDID_MODE_*
+    uint16_t period;                  // tick
+    uint16_t countdown;               // 다음 만기까지 tick
+    volatile uint8_t queued;          // 송신 대기열에 있음 (slot 당 최대 1 개)
+} PDID_Slot_t;
+
+typedef struct {
+    const DID_Table_t* table;
+    // 8B 프레임 1 개. 남는 메일박스가 없으면 HAL_BUSY (응답용 메일박스는 남겨 둠)
+    HAL_StatusTypeDef (*send)(const uint8_t* frame);
+    osTimerId_t timer;
+
+    PDID_Slot_t slot[PDID_MAX];
+    uint16_t used;
+    uint16_t phase[3];                // 주기별 다음 첫 송신 tick (분산 배치)
+
+    /* 송신 대기열 (slot index). TX 완료 인터럽트와 공유 → __disable_irq 구간에서만 접근
+       head == tail 이 빈 상태이므로 PDID_MAX 개가 모두 대기해도 1 칸 남김 */
+    uint8_t  q[PDID_MAX + 1u];
+    uint16_t q_head, q_tail;
+
+    uint32_t ticks;
+    uint32_t sent;
+    uint32_t late;                    // 대기 중 다시 만기 → 건너뛴 주기
+} PDID_Sched_t;
+
+extern PDID_Sched_t pdidSched;
+
+// 표/송신 함수 설정 (타이머는 처음 한 번만 생성)
+void    PDID_Init(PDID_Sched_t* s, const DID_Table_t* table, HAL_StatusTypeDef (*send)(const uint8_t* frame));
+// req = transmissionMode + pDID... (SID 다음부터), 반환 = NRC (0 = 긍정)
+// 한 pDID 라도 미지원/7B 초과면 0x31, 아무것도 바꾸지 않음. 이미 예약된 pDID 는 주기만 변경
+uint8_t PDID_Request(PDID_Sched_t* s, const uint8_t* req, uint16_t len);
+void    PDID_StopAll(PDID_Sched_t* s);
+// 기준 tick 1 회 (타이머 콜백). 벤치에서 직접 호출 가능
+void    PDID_Tick(PDID_Sched_t* s);
+// CAN TX 완료 (ISR): 대기열의 다음 프레임
+void    PDID_TxDoneFromISR(PDID_Sched_t* s);
+
+#endif /* INC_PDID_H_ */
@@ -19,7 +19,9 @@ extern "C" {
 
 
 #define MP5475_I2C_ADDR_7bit   (0x60)               	    // 0xC0, MP5475GU Address (5p)
-#define I2C_SLAVE_ADDRESS      (MP5475_I2C_ADDR_7bit << 1)  // HAL용 8-bit
+#define I2C_SLAVE_ADDRESS      (MP5475_I2C_ADDR_7bit << 1)  // HAL용 8-bit (HAL_I2C_* 에는 항상 이 값)
+
+#define PMIC_I2C_TIMEOUT_MS    10u                          // 400kHz 9바이트 burst ≈ 0.3ms
 
 
 // Register Address
@@ -69,6 +71,45 @@ typedef enum {
 #define PMIC_SYS_TEMP_SHDN_Msk          (1u << 0)
 
 
+/* ================================
+ * 레지스터 맵 / Shadow
+ *  연속 구간 2개를 각각 auto-increment burst 1회로 읽는다 (Datasheet p.40)
+ * ================================ */
+#define PMIC_STATUS_FIRST      PMIC_REG_FSM_PWR       // 0x05 ~ 0x09
+#define PMIC_STATUS_COUNT      5u
+#define PMIC_VOUT_FIRST        PMIC_REG_BUCKA_VOUT    // 0x16 ~ 0x19
+#define PMIC_VOUT_COUNT        4u
+#define PMIC_SHADOW_COUNT      (PMIC_STATUS_COUNT + PMIC_VOUT_COUNT)
+
+// Refresh 그룹
+#define PMIC_GRP_STATUS        (1u << 0)
+#define PMIC_GRP_VOUT          (1u << 1)
+#define PMIC_GRP_ALL           (PMIC_GRP_STATUS | PMIC_GRP_VOUT)
+
+// VOUT_COMMAND: 1 LSB = 10 mV (Datasheet p.41)
+#define PMIC_VOUT_LSB_mV       10u
+#define PMIC_VOUT_MAX_mV       (255u * PMIC_VOUT_LSB_mV)
+#define PMIC_BUCK_MASK_ALL     0x0Fu      // bit0=A .. bit3=D
+
+typedef struct
+{
+    I2C_HandleTypeDef *hi2c;
+    uint8_t  regs[PMIC_SHADOW_COUNT];   // [0..4]=0x05~0x09, [5..8]=0x16~0x19
+    uint16_t valid;                     // 한 번이라도 읽힌 항목 (bit = shadow index)
+    uint16_t dirty;                     // 로컬에서 수정, 아직 기록 안 됨
+    uint16_t changed;                   // Refresh 에서 값이 바뀐 항목 (소비자가 지움)
+    uint32_t xfers;                     // I2C 트랜잭션 수
+    uint32_t errors;
+
+    /* Buck 전압 제어 */
+    uint8_t  target[PMIC_VOUT_COUNT];   // 램프 목표 (VOUT code)
+    uint8_t  target_set;                // 목표가 정해진 buck (bit n). 나머지는 Step/Pending 에서 제외
+    uint8_t  ramp_step;                 // Step 1회 최대 변화량 (LSB, 0 = 한 번에)
+    uint8_t  verify;                    // 1: Flush 후 read-back 비교
+    uint32_t suppressed;                // 값이 같아 생략된 쓰기
+    uint32_t verify_fails;
+} PMIC_Shadow_t;
+
 // Fault 전체 읽기 구조체
 typedef struct
 {
@@ -77,12 +118,34 @@ typedef struct
     uint8_t system;    // Reg 0x09
 } PMIC_Faults_t;
 
+extern PMIC_Shadow_t pmicShadow;    // I2C1 MP5475 (StartI2CTask 가 갱신)
+
 /* ================================
  * 함수 프로토타입
  * ================================ */
 HAL_StatusTypeDef PMIC_ReadFaultRegister(I2C_HandleTypeDef *hi2c, PMIC_Register_t reg, uint8_t *data);
 HAL_StatusTypeDef PMIC_ReadAllFaults(I2C_HandleTypeDef *hi2c, PMIC_Faults_t *faults);
 HAL_StatusTypeDef PMIC_SetBuckVoltage(I2C_HandleTypeDef *hi2c, PMIC_Register_t buckReg, float voltage_mV);
+HAL_StatusTypeDef PMIC_ReadRange(I2C_HandleTypeDef *hi2c, uint8_t firstReg, uint8_t *data, uint16_t count);
+HAL_StatusTypeDef PMIC_WriteRange(I2C_HandleTypeDef *hi2c, uint8_t firstReg, const uint8_t *data, uint16_t count);
+
+/* Shadow: Refresh/Flush 만 버스를 사용하고 Get/Set 은 캐시만 접근 */
+int               PMIC_ShadowIndex(uint8_t reg);       // shadow 밖이면 -1
+void              PMIC_ShadowInit(PMIC_Shadow_t *sh, I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef PMIC_ShadowRefresh(PMIC_Shadow_t *sh, uint8_t groups);
+void              PMIC_ShadowApply(PMIC_Shadow_t *sh, uint8_t firstReg, const uint8_t *data, uint16_t count);
+HAL_StatusTypeDef PMIC_ShadowGet(const PMIC_Shadow_t *sh, uint8_t reg, uint8_t *value);
+HAL_StatusTypeDef PMIC_ShadowSet(PMIC_Shadow_t *sh, uint8_t reg, uint8_t value);
+HAL_StatusTypeDef PMIC_ShadowFlush(PMIC_Shadow_t *sh);
+void              PMIC_ShadowConfig(PMIC_Shadow_t *sh, uint8_t verify, uint8_t rampStepLsb);
+uint16_t          PMIC_ShadowTakeChanged(PMIC_Shadow_t *sh);
+void              PMIC_ShadowFaults(const PMIC_Shadow_t *sh, PMIC_Faults_t *faults);
+
+/* Buck 전압 (shadow 경유): mask 의 buck 목표를 바꾸고 첫 step 수행.
+ * ramp_step 이 있으면 목표까지 PMIC_BuckStep() 을 주기적으로 호출 */
+HAL_StatusTypeDef PMIC_BuckSetTargets(PMIC_Shadow_t *sh, const uint16_t mV[PMIC_VOUT_COUNT], uint8_t mask);
+HAL_StatusTypeDef PMIC_BuckStep(PMIC_Shadow_t *sh);
+uint8_t           PMIC_BuckPending(const PMIC_Shadow_t *sh);   // 목표 미도달 buck mask
 
 uint8_t PMIC_HasVoltageFault(const PMIC_Faults_t *faults);
 uint8_t PMIC_HasCurrentFault(const PMIC_Faults_t *faults);
@@ -0,0 +1,39 @@
+/*
+ * Pool.h
+ *
+ *  고정 크기 블록 메모리 풀 (CMSIS-RTOS2 osMemoryPool, freertos_mpool.h)
+ *  - 제어 블록/블록 배열 모두 호출자가 준 정적 메모리: FreeRTOS heap 을 쓰지 않음 (단편화 없음)
+ *  - 할당/해제 O(1): 빈 블록 목록 앞에서 꺼내고 앞에 넣음 (카운팅 세마포어 + 짧은 임계 구역)
+ *  - ISR 에서 할당 (timeout 0) / 해제 가능
+ *  - 진단: 사용 중 블록 수, 최대 동시 사용 (high-water), 고갈로 실패한 할당 수
+ */
+
+#ifndef INC_POOL_H_
+#define INC_POOL_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "freertos_mpool.h"
+#include <stdint.h>
+
+// 블록 배열 크기 (블록은 4B 단위로 올림)
+#define POOL_MEM_SIZE(count, size)   MEMPOOL_ARR_SIZE((count), (size))
+
+typedef struct {
+    osMemoryPoolId_t  id;
+    StaticMemPool_t   cb;               // osMemoryPool 제어 블록
+    uint16_t          size;             // 블록 크기 (B)
+    uint16_t          count;            // 블록 수
+    volatile uint32_t used;             // 사용 중 블록
+    volatile uint32_t hwm;              // 최대 동시 사용
+    volatile uint32_t allocs;
+    volatile uint32_t exhausted;        // 빈 블록이 없어 NULL 을 준 할당
+} Pool_t;
+
+// osKernelInitialize 이후. mem: POOL_MEM_SIZE(count, size) 바이트
+HAL_StatusTypeDef Pool_Init(Pool_t* p, const char* name, void* mem, uint16_t size, uint16_t count);
+// timeout_ms: ISR 는 0. NULL = 고갈 (exhausted 증가)
+void*             Pool_Alloc(Pool_t* p, uint32_t timeout_ms);
+void              Pool_Free(Pool_t* p, void* block);
+
+#endif /* INC_POOL_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Ring.h
+ *
+ *  단일 생산자 / 단일 소비자 (SPSC) lock-free 링 버퍼
+ *  - 생산자 1 개 (ISR 또는 Task) + 소비자 1 개 (Task): 잠금/커널 호출 없이 인덱스만 주고받음
+ *  - 크기는 2의 거듭제곱: 인덱스는 단조 증가, 슬롯 = 인덱스 & mask (가득/빔 구분에 슬롯을 버리지 않음)
+ *  - head(생산자 소유)와 tail(소비자 소유)은 다른 캐시 라인, 상대 인덱스는 각자 사본을 두고 부족할 때만 다시 읽음
+ *  - 여러 개 Push/Pop 은 memcpy 최대 2 번 (경계에서 한 번 나뉨)
+ *  - 선택: 빈 링에 넣으면 소비자 Task 에 thread flag (Ring_Wait 으로 대기)
+ *  - 가득 차면 들어가는 만큼만 넣고 나머지는 dropped 로 센다 (덮어쓰지 않음)
+ */
+
+#ifndef INC_RING_H_
+#define INC_RING_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include <stdint.h>
+
+#ifndef RING_LINE
+#ifdef HOST_BUILD
+#define RING_LINE   64u       // 호스트 스트레스 테스트: 생산자/소비자 스레드가 다른 코어
+#else
+#define RING_LINE   32u       // Cortex-M4 는 D-cache 없음: 정렬만 맞추고 RAM 은 적게
+#endif
+#endif
+
+typedef struct {
+    /* 생산자 측 */
+    volatile uint32_t head;       // 다음 쓰기 인덱스
+    uint32_t     tail_seen;       // 생산자가 마지막으로 읽은 tail
+    uint32_t     dropped;         // 자리가 없어 넣지 못한 항목 수 (다시 넣는 생산자는 시도마다 셈)
+    uint8_t      pad0[RING_LINE - 12u];
+    /* 소비자 측 */
+    volatile uint32_t tail;       // 다음 읽기 인덱스
+    uint32_t     head_seen;       // 소비자가 마지막으로 읽은 head
+    uint8_t      pad1[RING_LINE - 8u];
+    /* 초기화 후 고정 */
+    uint8_t*     buf;
+    uint32_t     mask;            // 항목 수 - 1
+    uint16_t     elem;            // 항목 크기 (B)
+    osThreadId_t notify;          // NULL = 알림 없음
+    uint32_t     notify_flags;
+} Ring_t;
+
+// count: 2의 거듭제곱 항목 수, buf: elem * count 바이트 (호출자 소유)
+HAL_StatusTypeDef Ring_Init(Ring_t* r, void* buf, uint16_t elem, uint32_t count);
+// 소비자 Task 에서 1 회: 빈 링에 들어오면 thread 에 flags
+void              Ring_SetNotify(Ring_t* r, osThreadId_t thread, uint32_t flags);
+
+// 생산자 (ISR 가능). 반환: 넣은 항목 수
+uint32_t          Ring_Push(Ring_t* r, const void* items, uint32_t n);
+// 소비자 Task. 반환: 꺼낸 항목 수
+uint32_t          Ring_Pop(Ring_t* r, void* items, uint32_t n);
+// 소비자 Task: 항목이 생길 때까지 대기 (Ring_SetNotify 필요). HAL_OK / HAL_TIMEOUT
+HAL_StatusTypeDef Ring_Wait(Ring_t* r, uint32_t timeout_ms);
+
+uint32_t          Ring_Count(const Ring_t* r);     // 어느 쪽에서 불러도 근사값
+
+#endif /* INC_RING_H_ */
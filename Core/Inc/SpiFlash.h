@@ -0,0 +1,50 @@
+/*
+ * SpiFlash.h
+ *
+ *  SPI NOR flash (Winbond W25Q16JV 계열, JEDEC 명령) 드라이버
+ *  - BusMgr 디바이스로 접근 (SPI2, CS = FLASH_CS). 읽기 데이터 구간은 DMA
+ *  - 프로그램: 256B page 단위, 1→0 만 가능 → 쓰기 전 4KB sector 소거 필요
+ *  - page program(≈0.7ms) 은 짧게 폴링, sector erase(≈45ms) 는 tick 단위로 양보
+ */
+
+#ifndef INC_SPIFLASH_H_
+#define INC_SPIFLASH_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdint.h>
+
+/* W25Q Command Set */
+#define SPIFLASH_CMD_WREN        0x06
+#define SPIFLASH_CMD_RDSR1       0x05
+#define SPIFLASH_CMD_READ        0x03
+#define SPIFLASH_CMD_PP          0x02
+#define SPIFLASH_CMD_SE_4K       0x20
+#define SPIFLASH_CMD_JEDEC_ID    0x9F
+
+#define SPIFLASH_SR_BUSY         (1u << 0)
+#define SPIFLASH_SR_WEL          (1u << 1)
+
+#define SPIFLASH_PAGE_SIZE       256u
+#define SPIFLASH_SECTOR_SIZE     4096u
+#define SPIFLASH_MFR_WINBOND     0xEFu
+
+#define SPIFLASH_PP_SPIN_MAX     256u     // page program: RDSR 연속 폴링(≈1ms) 후 tick 양보
+#define SPIFLASH_PP_TIMEOUT_MS   5u       // tPP max 3ms
+#define SPIFLASH_SE_TIMEOUT_MS   500u     // tSE max 400ms
+
+typedef struct {
+    int8_t   dev;             // BusMgr 디바이스 id
+    uint32_t size;            // bytes (JEDEC capacity 에서)
+    uint32_t jedec;           // mfr<<16 | type<<8 | capacity
+    uint32_t pages;           // 프로그램한 page 수
+    uint32_t erases;
+    uint32_t busy_polls;
+} SpiFlash_t;
+
+HAL_StatusTypeDef SpiFlash_Init(SpiFlash_t* f, int8_t busDev);
+HAL_StatusTypeDef SpiFlash_Read(SpiFlash_t* f, uint32_t addr, uint8_t* buf, uint32_t len);
+HAL_StatusTypeDef SpiFlash_Program(SpiFlash_t* f, uint32_t addr, const uint8_t* buf, uint32_t len);
+HAL_StatusTypeDef SpiFlash_EraseSector(SpiFlash_t* f, uint32_t addr);
+HAL_StatusTypeDef SpiFlash_ReadStatus(SpiFlash_t* f, uint8_t* sr);
+
+#endif /* INC_SPIFLASH_H_ */
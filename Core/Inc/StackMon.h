@@ -0,0 +1,54 @@
+/*
+ * StackMon.h
+ *
+ *  Task 스택 / heap / MSP 사용량 감시와 오버플로 기록
+ *  - Task 스택: 생성 시 0xA5 로 채워짐 (FreeRTOS), 남은 패턴 = 최소 여유 (high-water)
+ *  - 오버플로 (configCHECK_FOR_STACK_OVERFLOW 2): 훅은 Task 이름을 .noinit 에 남기고 리셋.
+ *    다음 부팅에 DTC 메모리가 mount 되면 StackMon_Service 가 DTC 로 보고 (멈춰 있지 않음)
+ *  - heap_4: malloc 실패 훅 → 횟수 + DTC (리셋 없음, 호출자가 NULL 처리)
+ *  - MSP: 부팅 시 예약 영역(_Min_Stack_Size) 중 쓰지 않은 부분을 채워 인터럽트 최대 사용량 측정
+ *  - UART 'S' → StackMon_Dump. Host/Tools/stack_report -r 로 정적 분석(.su) 과 같은 표에 합침
+ */
+
+#ifndef INC_STACKMON_H_
+#define INC_STACKMON_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include <stdint.h>
+
+#define STACKMON_FILL          0xA5A5A5A5u   // tskSTACK_FILL_BYTE 4 개
+#define STACKMON_MAX_TASKS     16u
+#define STACKMON_NAME_LEN      16u           // configMAX_TASK_NAME_LEN
+
+// P0604 (Internal Control Module RAM Error), 하위 바이트 = failure type
+#define STACKMON_DTC_STACK     0x060401u
+#define STACKMON_DTC_HEAP      0x060402u
+
+typedef struct {
+    uint32_t          overflows;                  // 스택 오버플로 누적 (리셋을 넘어 유지)
+    char              task[STACKMON_NAME_LEN];    // 마지막으로 넘친 Task
+    volatile uint32_t malloc_fails;
+    uint32_t          msp_size;                   // 채워 둔 MSP 영역 (B, 호스트 0)
+    uint8_t           heap_reported;
+} StackMon_t;
+
+extern StackMon_t stackMon;
+
+typedef void (*StackMon_WriteFn)(const char* line);
+
+// 부팅 시 1 회 (osKernelStart 전, MSP 사용 중): .noinit 기록 확인 + MSP 채우기
+void     StackMon_Init(void);
+// Task 에서 주기 호출: 보고 대기 중인 오버플로 / heap 고갈을 DTC 메모리에 (mount 후)
+void     StackMon_Service(void);
+// MSP 최대 사용량 (B). 호스트 0
+uint32_t StackMon_MspPeak(void);
+/* 텍스트 덤프 (Task 이름의 공백은 '_'):
+     STACK v=1 task=<이름> free_min=<B>
+     HEAP v=1 size= free= free_min= largest= blocks= allocs= frees= fails=
+     MSP v=1 size= peak= sbrk= sbrk_refused=
+     OVF v=1 count= task=<이름|->
+     E */
+void     StackMon_Dump(StackMon_WriteFn write);
+
+#endif /* INC_STACKMON_H_ */
@@ -0,0 +1,71 @@
+/*
+ * SupplyMon.h
+ *
+ *  ADC1 기반 공급 전압 감시
+ *  - TIM2 TRGO (12.8kHz) 트리거 → ADC1 CH2 → DMA2 Stream4 순환 더블 버퍼
+ *  - DMA Half/Cplt 인터럽트마다 64 샘플 블록 처리 (샘플당 CPU 개입 없음)
+ *  - 필터: 블록 평균(moving average) → 1차 IIR (Q4 고정소수점)
+ *  - 임계값 교차(히스테리시스 + 디바운스) 시 DTC P0562(저전압)/P0563(과전압)
+ */
+
+#ifndef INC_SUPPLYMON_H_
+#define INC_SUPPLYMON_H_
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "DTC.h"
+#include <stdint.h>
+
+#define SUPPLYMON_FS_HZ          12800u   // TIM2 TRGO 샘플링 주파수
+#define SUPPLYMON_BLOCK          64u      // 반 버퍼 샘플 수 (12.8kHz 에서 5ms)
+#define SUPPLYMON_ADC_VREF_mV    3300u
+#define SUPPLYMON_ADC_FULL       4095u
+
+/* 2바이트 DTC 코드 (파이프라인 EEPROM/CAN 포맷) */
+#define SUPPLYMON_DTC_UV         0x0562u  // P0562 System Voltage Low
+#define SUPPLYMON_DTC_OV         0x0563u  // P0563 System Voltage High
+
+/* ProcessBlock 반환 이벤트 */
+#define SUPPLYMON_EV_UV_SET      (1u << 0)
+#define SUPPLYMON_EV_UV_CLR      (1u << 1)
+#define SUPPLYMON_EV_OV_SET      (1u << 2)
+#define SUPPLYMON_EV_OV_CLR      (1u << 3)
+
+typedef struct {
+    uint16_t uv_mV, uv_clear_mV;   // 저전압 진입/해제
+    uint16_t ov_mV, ov_clear_mV;   // 과전압 진입/해제
+    uint8_t  debounce_blocks;      // 연속 블록 수
+    uint8_t  iir_shift;            // y += (x - y) >> shift
+    uint16_t div_num, div_den;     // 공급 전압 = Vadc * num / den (저항 분압 역수)
+} SupplyMon_Config_t;
+
+typedef struct {
+    SupplyMon_Config_t cfg;
+    int32_t  y_q4;                 // 필터 출력 (ADC count * 16)
+    uint8_t  primed;
+    uint8_t  uv_cnt, ov_cnt;
+    uint8_t  uv_active, ov_active;
+    uint16_t supply_mV;            // 최근 필터 값 (mV)
+    DTC_Record_t dtc_uv, dtc_ov;
+    uint32_t blocks;
+    uint32_t overruns;             // 처리 전에 다음 반 버퍼가 찬 횟수
+} SupplyMon_t;
+
+extern const SupplyMon_Config_t SupplyMon_DefaultConfig;
+extern SupplyMon_t supplyMon;
+
+// main.c에서 생성/정의
+extern ADC_HandleTypeDef hadc1;
+extern TIM_HandleTypeDef htim2;
+
+void     SupplyMon_Init(SupplyMon_t* m, const SupplyMon_Config_t* cfg);
+uint8_t  SupplyMon_ProcessBlock(SupplyMon_t* m, const uint16_t* samples, uint32_t n);
+uint16_t SupplyMon_CountsToSupply_mV(const SupplyMon_t* m, int32_t counts_q4);
+/* 파이프라인용: 활성 공급 전압 DTC (없으면 0) */
+uint16_t SupplyMon_ActiveDtc(const SupplyMon_t* m);
+void     SupplyMon_OnClockChange(void);       // SYSCLK/APB 변경 후 TIM2 ARR 재계산
+
+// RTOS task entry
+void StartSupplyMonTask(void *argument);
+
+#endif /* INC_SUPPLYMON_H_ */
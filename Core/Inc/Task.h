@@ -11,6 +11,28 @@
 
 #include "cmsis_os.h"
 #include "stm32f4xx_hal.h"
+#include "Ring.h"
+#include "PMIC.h"
+#include "Mpu.h"
+
+// UART4 수신: RX 인터럽트 1B 씩 → uartRxRing (SPSC) → UARTTask 가 명령으로 처리
+#define UART_RX_RING_LEN   64u
+#define UART_CMD_TRACE     'T'     // trace 버퍼 텍스트 덤프 (Trace_Dump 형식)
+#define UART_CMD_STACK     'S'     // 스택/heap 사용량 덤프 (StackMon_Dump 형식)
+#define UART_CMD_BUSREC    'B'     // 버스 트래픽 기록 덤프 (BusRec_Dump 형식)
+
+// Task 스택 (B). Host/Tools/stack_report 의 정적 최악 경로 + 문맥 저장, 'S' 덤프의 free_min 으로 확인
+// UARTTask: 덤프 경로 (snprintf) 가 128 word 에서 여유가 없어 192 word
+#define TASK_STACK_DEFAULT     (128u * 4u)
+#define TASK_STACK_I2C         (128u * 4u)
+#define TASK_STACK_SPI         (128u * 4u)
+#define TASK_STACK_CAN         (128u * 4u)
+#define TASK_STACK_UART        (192u * 4u)
+#define TASK_STACK_SUPPLYMON   (128u * 4u)
+#define TASK_STACK_DVFS        (128u * 4u)
+#define TASK_STACK_LOG         (192u * 4u)
+#define TASK_STACK_EECACHE     (192u * 4u)
+#define TASK_STACK_UDS         (256u * 4u)
 
 // main.c에서 생성/정의
 extern osMutexId_t CommMutexHandle;
@@ -23,6 +45,21 @@ extern UART_HandleTypeDef huart4;
 extern CAN_TxHeaderTypeDef TxHeader;
 extern uint32_t TxMailbox;
 
+extern Ring_t uartRxRing;
+
+// 파이프라인 버퍼: MPU R7 (Mpu.h). slice 32B = subregion 1 개, 소유 Task 만 쓰기 (나머지는 읽기)
+typedef struct {
+    struct {
+        uint8_t rxStatus[PMIC_STATUS_COUNT];   // PMIC 0x05~0x09 raw (burst 1회, DMA)
+        uint8_t dtc[2];                        // EEPROM 저장용 (DTC 코드 2B)
+    } i2c MPU_REGION(MPU_PIPE_SLICE);          // slice 0: I2CTask
+    struct {
+        uint8_t eepromRead[2];                 // CAN/USART 송신용
+    } spi MPU_REGION(MPU_PIPE_SLICE);          // slice 1: SPITask
+} MPU_REGION(MPU_PIPE_SIZE) Task_PipeBuf_t;
+
+extern Task_PipeBuf_t pipeBuf;
+
 // RTOS task entry
 void StartDefaultTask(void *argument);
 void StartI2CTask(void *argument);
@@ -0,0 +1,63 @@
+/*
+ * Trace.h
+ *
+ *  Fault→Bus 지연 추적용 경량 trace 버퍼
+ *  - Task/ISR 어디서나 호출 가능 (lock-free: 슬롯 예약은 atomic fetch-add)
+ *  - 타임스탬프: DWT CYCCNT (호스트는 가상 시간 기반 CYCCNT)
+ *  - 버퍼가 차면 가장 오래된 이벤트부터 덮어씀 (dropped 로 보고)
+ *  - Trace_Dump 출력은 Host/Tools/trace_analyze 로 분석
+ */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+#include <stdint.h>
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE     1
+#endif
+
+#ifndef TRACE_BUF_SIZE
+#define TRACE_BUF_SIZE   256u      // 2의 거듭제곱 (호스트 시뮬레이션은 빌드 옵션으로 확장)
+#endif
+#define TRACE_FORMAT_VERSION 1u
+
+/* 이벤트 ID (분석기와 공유, 값 변경 금지) */
+typedef enum {
+    TRACE_EV_FAULT_INJECT   = 0x01, // 시뮬레이션: PMIC 에 fault 주입 시점
+    TRACE_EV_I2C_READ_START = 0x10, // Fault 레지스터 DMA 읽기 시작
+    TRACE_EV_I2C_READ_DONE  = 0x11, // I2C DMA 완료 (ISR)
+    TRACE_EV_FAULT_DECIDED  = 0x20, // Fault 판정 (DTC 확정)
+    TRACE_EV_SUPPLY_FAULT   = 0x21, // ADC 공급 전압 임계값 교차 (arg = mV)
+    TRACE_EV_EE_WRITE_DONE  = 0x30, // EEPROM 기록 완료 (WIP 해제)
+    TRACE_EV_EE_READ_DONE   = 0x31,
+    TRACE_EV_CAN_TX_QUEUED  = 0x40, // 메일박스 적재
+    TRACE_EV_CAN_TX_DONE    = 0x41, // 버스 송신 완료 (ISR)
+    TRACE_EV_UART_TX_DONE   = 0x50,
+    TRACE_EV_DVFS_SWITCH    = 0x60, // 동작점 전환 완료 (arg = from<<8 | to). 이후 ts 의 cycle/us 환산 변경
+} Trace_Event_t;
+
+typedef struct {
+    uint32_t ts;        // CYCCNT
+    uint16_t event;     // Trace_Event_t
+    uint16_t arg;       // 파이프라인 회차 등
+    uint32_t seq;       // 기록 완료 표시 (예약 인덱스 + 1)
+} Trace_Entry_t;
+
+typedef void (*Trace_WriteFn)(const char* line);
+
+void     Trace_Init(void);
+void     Trace_Log(uint16_t event, uint16_t arg);
+uint32_t Trace_Count(void);     // 지금까지 기록된 총 이벤트 수
+/* 텍스트 덤프:
+     TRACE v=1 hz=<cyc/s> n=<개수> dropped=<덮어쓴 개수>
+     E <ts> <event hex> <arg>          (오래된 순) */
+void     Trace_Dump(Trace_WriteFn write);
+
+#if TRACE_ENABLE
+#define TRACE(ev, arg)   Trace_Log((uint16_t)(ev), (uint16_t)(arg))
+#else
+#define TRACE(ev, arg)   ((void)0)
+#endif
+
+#endif /* INC_TRACE_H_ */
@@ -3,11 +3,156 @@
  *
  *  Created on: Aug 13, 2025
  *      Author: 김나윤
+ *
+ *  UDS 서버 (물리 주소 0x7E0 / 기능 주소 0x7DF → 0x7E8)
+ *  - ISO-TP (IsoTp.c): 물리 주소는 멀티 프레임 요청/응답, 기능 주소는 single frame 만
+ *  - 전송: 기본은 CAN1 (bxCAN, classic 8B). UDS_SetFdPort 로 CAN FD 포트 (외부 컨트롤러 / 시뮬레이션) 를
+ *    주면 요청/응답/주기 응답을 그 포트로 주고받음 (ISO-TP TX_DL = 포트 설정, 최대 64B)
+ *  - RX FIFO0 콜백 (FD 포트는 UDS_FdRxFromISR): 수신 프레임 (풀 블록, 수신 tick 기록) 을 udsRxRing (SPSC 링, 소비자 UDSTask) 으로 전달
+ *    P2 는 요청마다 수신 tick 부터: 서버가 쉬고 있으면 (다음에 처리될 요청) 콜백에서, 아니면 UDSTask 가 꺼낼 때 남은 시간으로 시작
+ *    기능 주소는 콜백에서 먼저 걸러냄 (UDS_PreParse): 지원하지 않는 SID/서브펑션은 버리고,
+ *    3E 80 (응답 생략 TesterPresent) 은 S3 만 재시작 → UDSTask 를 깨우지 않음
+ *  - suppressPosRspMsgIndicationBit (0x10/0x27/0x3E): 긍정 응답 생략, 0x78 을 보낸 뒤에는 생략 불가
+ *  - UDSTask: 부팅 시 DTC 메모리 mount 후 요청 처리, 유휴 시 slot 상세 로드/EEPROM 기록
+ *  - 0x10 세션 (02 programming 은 부트로더 전환이 없으므로 NRC 0x22) / 0x27 SecurityAccess / 0x3E TesterPresent
+ *  - 0x19 01/02 (ReadDTCInformation, 02 는 DTC 메모리 전체를 멀티 프레임으로), 0x14 (ClearDiagnosticInformation, 전체 그룹)
+ *  - 0x22 / 0x2E (DID.c 의 DID 표)
+ *  - 0x2A (PDID.c): non-default 세션, 주기 응답은 UDS_PERIODIC_CANID. 세션 전환/S3 만료 시 전부 정지
+ *  - 타이머는 FreeRTOS software timer (타이머 Task 가 UDSTask 보다 높은 우선순위)
+ *    P2 : 수신 후 P2 - 여유 안에 최종 응답이 없으면 0x78, 이후 P2* 주기로 반복
+ *    S3 : default 외 세션에서 요청이 끊기면 default 로 복귀 (보안 잠금, DVFS 요구 해제)
  */
 
 #ifndef INC_UDS_CAN_H_
 #define INC_UDS_CAN_H_
 
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "IsoTp.h"
+#include "Ring.h"
+#include "Pool.h"
+#include <stdint.h>
+
+#define UDS_SID_NEGATIVE_RESPONSE   0x7Fu
+#define UDS_POSITIVE_OFFSET         0x40u
+#define UDS_SVC_SESSION_CONTROL     0x10u
+#define UDS_SVC_READ_DID            0x22u
+#define UDS_SVC_SECURITY_ACCESS     0x27u
+#define UDS_SVC_READ_PERIODIC_DID   0x2Au
+#define UDS_SVC_WRITE_DID           0x2Eu
+#define UDS_SVC_TESTER_PRESENT      0x3Eu
+#define UDS_SPRMIB                  0x80u     // 서브펑션 bit 7: suppressPosRspMsgIndicationBit
+
+#define UDS_SESSION_DEFAULT         0x01u
+#define UDS_SESSION_PROGRAMMING     0x02u
+#define UDS_SESSION_EXTENDED        0x03u
+
+/* NRC (ISO 14229-1 A.1) */
+#define UDS_NRC_SERVICE_NOT_SUPPORTED      0x11u
+#define UDS_NRC_SUBFUNC_NOT_SUPPORTED      0x12u
+#define UDS_NRC_INCORRECT_LENGTH           0x13u
+#define UDS_NRC_RESPONSE_TOO_LONG          0x14u
+#define UDS_NRC_CONDITIONS_NOT_CORRECT     0x22u
+#define UDS_NRC_REQUEST_SEQUENCE_ERROR     0x24u
+#define UDS_NRC_REQUEST_OUT_OF_RANGE       0x31u
+#define UDS_NRC_SECURITY_ACCESS_DENIED     0x33u
+#define UDS_NRC_INVALID_KEY                0x35u
+#define UDS_NRC_EXCEEDED_ATTEMPTS          0x36u
+#define UDS_NRC_TIME_DELAY_NOT_EXPIRED     0x37u
+#define UDS_NRC_GENERAL_PROGRAMMING_FAIL   0x72u
+#define UDS_NRC_RESPONSE_PENDING           0x78u
+#define UDS_NRC_SUBFUNC_NOT_IN_SESSION     0x7Eu
+#define UDS_NRC_SERVICE_NOT_IN_SESSION     0x7Fu
+
+#define UDS_DTC_FORMAT_ISO14229_1   0x01u
+#define UDS_SF_MAX_LEN              ISOTP_SF_MAX
+#define UDS_PAD_BYTE                ISOTP_PAD_BYTE
+#define UDS_IDLE_MS                 10u       // 요청이 없을 때 DTC 기록 확인 주기
+#define UDS_REQ_MAX_LEN             512u      // 요청 재조립 버퍼 (넘으면 FC OVFLW), 응답은 ISOTP_MAX_LEN
+#define UDS_RX_RING_LEN             8u        // 수신 프레임 링 (2의 거듭제곱) = 프레임 풀 블록 수
+#define UDS_REQ_BUFS                1u        // 요청 재조립 버퍼 풀 (UDSTask 1 개: 요청 1 개씩)
+#define UDS_RSP_BUFS                1u        // 응답 버퍼 풀 (ISOTP_MAX_LEN)
+#define UDS_FLAG_RX                 (1u << 0) // UDSTask thread flag: 빈 수신 링에 프레임 도착
+
+/* 응답 시간 (ISO 14229-2). 0x10 응답에 P2 (1ms 단위), P2* (10ms 단위) 로 알림 */
+#define UDS_P2_SERVER_MS            50u
+#define UDS_P2X_SERVER_MS           5000u
+#define UDS_P2_MARGIN_MS            10u       // 타이머 만료 → 0x78 프레임 전송 완료까지 여유 (중재 대기 포함)
+#define UDS_S3_SERVER_MS            5000u
+
+/* SecurityAccess level 1 (seed 01 / key 02) */
+#define UDS_SA_LEVEL                0x01u
+#define UDS_SA_MAX_ATTEMPTS         3u
+#define UDS_SA_DELAY_MS             10000u    // 시도 초과 후 seed 요청 금지 시간
+#define UDS_SA_KEY_MASK             0x5A3CC3A5u
+
+typedef struct {
+    uint8_t  session;             // UDS_SESSION_*
+    uint8_t  sa_unlocked;         // 해제된 보안 레벨 (0 = 잠김)
+    uint8_t  sa_seed_sent;        // seed 를 보냈고 key 를 기다리는 중
+    uint8_t  sa_attempts;
+    uint32_t sa_seed;
+    uint32_t sa_delay_until;      // tick (0 = 지연 없음)
+    uint32_t seed_state;
+
+    volatile uint8_t busy;        // 수신 ~ 최종 응답 (P2 타이머가 0x78 을 보낼 수 있는 구간)
+    volatile uint8_t sid;         // 처리 중인 요청 SID
+    volatile uint8_t pending;     // 처리 중인 요청에 0x78 을 보냄 (최종 응답 생략 불가)
+    volatile uint8_t serving;     // UDSTask 가 요청을 꺼내 처리 중 (수신 콜백은 P2 를 건드리지 않음)
+    uint32_t requests;
+    uint32_t pending_sent;        // 보낸 0x78
+    uint32_t s3_timeouts;
+    uint32_t func_requests;       // UDSTask 까지 간 기능 주소 요청
+    uint32_t func_keepalive;      // 콜백에서 끝낸 기능 주소 3E 80
+    uint32_t func_dropped;        // 콜백에서 버린 기능 주소 요청 (응답 없는 NRC / multi frame)
+    uint32_t suppressed;          // 생략한 응답
+} UDS_Server_t;
+/* DID 0xD130/0xD131 이 requests.. / func_requests.. 를 연속 uint32 로 읽음 (필드 순서 유지) */
+
+/* udsRxRing 항목: 수신 프레임 + 주소 방식 */
+typedef struct {
+    uint8_t data[ISOTP_FRAME_MAX];  // PCI + 요청 (classic 은 DLC 이후 0, len = 8)
+    uint8_t len;
+    uint8_t functional;           // 1 = UDS_FUNC_REQ_CANID
+    uint8_t p2_armed;             // 수신 콜백이 이 요청의 P2 를 시작함
+    uint32_t rx_tick;             // 수신 tick (P2 기준)
+} UDS_RxFrame_t;
+
+/* CAN FD 포트: send 는 프레임 1 개 (len = 유효 DLC 길이, 송신 버퍼 없음 = HAL_BUSY) */
+typedef struct {
+    HAL_StatusTypeDef (*send)(uint32_t stdId, const uint8_t* data, uint8_t len);
+    uint8_t tx_dl;                // ISO-TP TX_DL (12, 16, 20, 24, 32, 48, 64)
+} UDS_FdPort_t;
+
+/* 수신 콜백의 기능 주소 사전 판별 결과 */
+typedef enum {
+    UDS_RX_DROP = 0,              // 응답하지 않는 요청: 큐에 넣지 않음
+    UDS_RX_QUEUE,                 // UDSTask 에서 처리
+    UDS_RX_KEEPALIVE,             // 3E 80: S3 재시작만
+} UDS_RxAction_t;
+
+extern UDS_Server_t udsServer;
+
+// 항목 = udsFramePool 블록 포인터. 생산자: RX FIFO0 콜백 / UDS_FdRxFromISR (같은 우선순위, 서로 선점하지 않음).
+// 소비자: UDSTask (첫 프레임을 읽은 뒤 블록 해제)
+extern Ring_t udsRxRing;
+// 고정 블록 풀 (heap 미사용): 수신 프레임 (ISR 할당), 요청 재조립 / 응답 버퍼 (UDSTask, 요청마다 할당/해제)
+extern Pool_t udsFramePool, udsReqPool, udsRspPool;
+
+void     UDS_Init(void);                  // osKernelInitialize 이후 (타이머 생성)
+// CAN FD 포트 연결 (UDS_Init 전, NULL = CAN1 classic). 포트는 호출자가 유지
+void     UDS_SetFdPort(const UDS_FdPort_t* port);
+// FD 포트 수신 ISR: UDS 요청 ID (0x7E0/0x7DF) 프레임을 RX FIFO0 콜백과 같은 경로로
+void     UDS_FdRxFromISR(uint32_t stdId, const uint8_t* data, uint8_t len);
+// 수신 프레임 (PCI 포함) 사전 판별. 물리 주소는 항상 UDS_RX_QUEUE (ISR 에서 호출)
+UDS_RxAction_t UDS_PreParse(const uint8_t* frame, uint8_t len, uint8_t functional);
+// 요청 1 개 (SID 부터) 처리 → 응답 길이 (0 = 응답 없음). rsp 는 ISOTP_MAX_LEN.
+// *suppressed = 1: 응답을 만들었지만 보내지 않아도 됨 (SPRMIB, 기능 주소의 0x11/0x12/0x31/0x7E/0x7F)
+uint16_t UDS_HandleRequest(const uint8_t* req, uint16_t len, uint8_t functional, uint8_t* rsp, uint8_t* suppressed);
+// SecurityAccess key 계산 (테스터와 공유하는 비밀 함수)
+uint32_t UDS_SecurityKey(uint32_t seed);
 
+// RTOS task entry
+void StartUDSTask(void *argument);
 
 #endif /* INC_UDS_CAN_H_ */
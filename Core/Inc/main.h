@@ -35,6 +35,16 @@ extern "C" {
 #include "UDS_CAN.h"
 #include "PMIC.h"
 #include "Task.h"
+#include "SupplyMon.h"
+#include "DVFS.h"
+#include "BusMgr.h"
+#include "FlashLog.h"
+#include "EECache.h"
+#include "DTCMem.h"
+#include "DID.h"
+#include "PDID.h"
+#include "StackMon.h"
+#include "Mpu.h"
 
 
 void Error_Handler(void);
@@ -45,6 +55,10 @@ void Error_Handler(void);
 
 /* Private defines -----------------------------------------------------------*/
 /* USER CODE BEGIN Private defines */
+#define EE2_CS_Pin         GPIO_PIN_12     // SPI2 25LC256 CS (active-low)
+#define EE2_CS_GPIO_Port   GPIOB
+#define FLASH_CS_Pin       GPIO_PIN_14     // SPI2 W25Q16 CS (active-low)
+#define FLASH_CS_GPIO_Port GPIOB
 
 /* USER CODE END Private defines */
 
@@ -0,0 +1,252 @@
+/*
+ * Bench.c
+ *
+ *  진단 경로 마이크로 벤치마크 (Bench.h 참조)
+ *  입력은 모두 고정 패턴/고정 시드 → 실행마다 동일한 시나리오
+ */
+
+#include "Bench.h"
+#include "DTC.h"
+#include "PMIC.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HOST_BUILD
+#include <time.h>
+#endif
+
+/* 최적화로 측정 대상이 제거되지 않도록 결과를 흘려보내는 곳 */
+static volatile uint32_t s_sink;
+
+/* ===== 카운터 ===== */
+void Bench_CounterInit(void)
+{
+#ifndef HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t Bench_Now(void)
+{
+#ifdef HOST_BUILD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+const char* Bench_Unit(void)
+{
+#ifdef HOST_BUILD
+    return "ns";
+#else
+    return "cyc";
+#endif
+}
+
+/* ===== 실행/집계 ===== */
+static void Bench_SortU32(uint32_t* v, uint32_t n)
+{
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t x = v[i], j = i;
+        while (j > 0 && v[j - 1] > x) { v[j] = v[j - 1]; j--; }
+        v[j] = x;
+    }
+}
+
+static void Bench_FmtX100(char* buf, uint32_t size, uint32_t x100)
+{
+    snprintf(buf, size, "%lu.%02lu", (unsigned long)(x100 / 100u), (unsigned long)(x100 % 100u));
+}
+
+void Bench_RunCase(const Bench_Config_t* cfg, const Bench_Case_t* c, Bench_Result_t* out)
+{
+    uint32_t samples[BENCH_MAX_REPEATS];
+    uint32_t reps = cfg->repeats;
+    uint32_t iters = (cfg->iters == 0u) ? 1u : cfg->iters;
+    uint64_t ops = (uint64_t)iters * c->ops_per_iter;
+
+    if (reps == 0u) reps = 1u;
+    if (reps > BENCH_MAX_REPEATS) reps = BENCH_MAX_REPEATS;
+
+    c->fn(c->ctx, 1u);  // warm-up (캐시/분기 예측)
+
+    for (uint32_t r = 0; r < reps; r++) {
+        uint32_t t0 = Bench_Now();
+        c->fn(c->ctx, iters);
+        samples[r] = Bench_Now() - t0;
+    }
+    Bench_SortU32(samples, reps);
+
+    Bench_Result_t res;
+    res.ops      = (uint32_t)ops;
+    res.min_x100 = (uint32_t)(((uint64_t)samples[0] * 100u) / ops);
+    res.med_x100 = (uint32_t)(((uint64_t)samples[reps / 2u] * 100u) / ops);
+    if (out) *out = res;
+
+    if (cfg->write) {
+        char line[128], mn[16], md[16];
+        Bench_FmtX100(mn, sizeof(mn), res.min_x100);
+        Bench_FmtX100(md, sizeof(md), res.med_x100);
+        snprintf(line, sizeof(line), "BENCH v=%u name=%s unit=%s ops=%lu min=%s med=%s\n",
+                 (unsigned)BENCH_FORMAT_VERSION, c->name, Bench_Unit(),
+                 (unsigned long)res.ops, mn, md);
+        cfg->write(line);
+    }
+}
+
+/* ===== 시나리오: 0x59/0x02 응답 파싱 ===== */
+typedef struct {
+    uint8_t      resp[255];
+    uint8_t      rlen;
+    DTC_Record_t out[63];
+} BenchParse_t;
+
+static BenchParse_t s_parse1, s_parse63;
+
+static void Bench_PrepParse(BenchParse_t* p, uint8_t nrec)
+{
+    p->resp[0] = UDS_SVC_READ_DTC_INFO | 0x40u;
+    p->resp[1] = UDS_RDI_REPORT_DTC_BY_STATUS_MASK;
+    p->resp[2] = 0xFFu;
+    for (uint8_t i = 0; i < nrec; i++) {
+        p->resp[3 + i*4 + 0] = 0xC1u;
+        p->resp[3 + i*4 + 1] = (uint8_t)(0x20u + i);
+        p->resp[3 + i*4 + 2] = (uint8_t)(i * 7u);
+        p->resp[3 + i*4 + 3] = (uint8_t)(DTC_ST_TF | DTC_ST_CDTC);
+    }
+    p->rlen = (uint8_t)(3u + 4u * nrec);
+}
+
+static void Bench_Parse(void* ctx, uint32_t iters)
+{
+    BenchParse_t* p = (BenchParse_t*)ctx;
+    uint32_t acc = 0;
+    while (iters--) {
+        uint8_t n = (uint8_t)(sizeof(p->out) / sizeof(p->out[0]));
+        (void)DTC_UDS_ParseReadByStatusMask(p->resp, p->rlen, p->out, &n);
+        acc += n + p->out[0].status;
+    }
+    s_sink += acc;
+}
+
+/* ===== 시나리오: statusOfDTC 갱신 (32개 DTC, 실패/정상 교대 + 사이클 경계) ===== */
+static DTC_Record_t s_records[32];
+
+static void Bench_StatusUpdate(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    uint32_t lfsr = 0xACE1u;
+    while (iters--) {
+        for (uint32_t i = 0; i < 32u; i++) {
+            lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+            DTC_UpdateStatus(&s_records[i], (lfsr & 1u) != 0u);
+        }
+        DTC_StartOperationCycle(&s_records[iters & 31u]);
+    }
+    s_sink += s_records[0].status;
+}
+
+/* ===== 시나리오: CRC-32 ===== */
+static uint8_t s_crcbuf[256];
+
+static void Bench_Crc12(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    uint32_t acc = 0;
+    while (iters--) acc ^= DTC_CalcCRC32(s_crcbuf, DTC_ENTRY_SIZE);
+    s_sink += acc;
+}
+
+static void Bench_Crc256(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    uint32_t acc = 0;
+    while (iters--) acc ^= DTC_CalcCRC32(s_crcbuf, sizeof(s_crcbuf));
+    s_sink += acc;
+}
+
+/* ===== 시나리오: EEPROM 레코드 직렬화/역직렬화 (+CRC) ===== */
+static void Bench_Serialize(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    DTC_Entry_t e = { .rec = { { 0xC1u, 0x23u, 0x00u }, DTC_ST_TF }, .timestamp_ms = 0u, .crc32 = 0u };
+    uint8_t img[DTC_ENTRY_SIZE];
+    while (iters--) {
+        e.timestamp_ms += 10u;
+        e.crc32 = DTC_CalcCRC32(&e.rec, sizeof(e.rec));
+        DTC_SerializeEntry(&e, img);
+    }
+    s_sink += img[11];
+}
+
+static void Bench_Deserialize(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    DTC_Entry_t e = { .rec = { { 0xC1u, 0x23u, 0x00u }, DTC_ST_TF }, .timestamp_ms = 1234u };
+    uint8_t img[DTC_ENTRY_SIZE];
+    uint32_t ok = 0;
+
+    e.crc32 = DTC_CalcCRC32(&e.rec, sizeof(e.rec));
+    DTC_SerializeEntry(&e, img);
+    while (iters--) {
+        DTC_Entry_t d;
+        DTC_DeserializeEntry(img, &d);
+        ok += (DTC_CalcCRC32(&d.rec, sizeof(d.rec)) == d.crc32);
+    }
+    s_sink += ok;
+}
+
+/* ===== 시나리오: PMIC fault 레지스터 디코드 (64 샘플) ===== */
+static PMIC_Faults_t s_faults[64];
+
+static void Bench_PmicDecode(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    uint32_t acc = 0;
+    while (iters--) {
+        for (uint32_t i = 0; i < 64u; i++) {
+            const PMIC_Faults_t* f = &s_faults[i];
+            acc += (PMIC_HasVoltageFault(f) != 0u) + (PMIC_HasCurrentFault(f) != 0u) + (PMIC_HasTempFault(f) != 0u);
+        }
+    }
+    s_sink += acc;
+}
+
+void Bench_RunDiagSuite(const Bench_Config_t* cfg)
+{
+    uint32_t lfsr = 0x1D2Cu;
+
+    Bench_CounterInit();
+
+    Bench_PrepParse(&s_parse1, 1u);
+    Bench_PrepParse(&s_parse63, 63u);
+    memset(s_records, 0, sizeof(s_records));
+    for (uint32_t i = 0; i < sizeof(s_crcbuf); i++) s_crcbuf[i] = (uint8_t)(i * 31u + 7u);
+    for (uint32_t i = 0; i < 64u; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        s_faults[i].uv_ov   = (uint8_t)((i % 4u == 0u) ? lfsr : 0u);
+        s_faults[i].oc_warn = (uint8_t)((i % 8u == 1u) ? (lfsr >> 8) : 0u);
+        s_faults[i].system  = (uint8_t)((i % 16u == 2u) ? PMIC_SYS_TEMP_WARN_Msk : 0u);
+    }
+
+    const Bench_Case_t cases[] = {
+        { "dtc_parse_rbsm_1rec",  Bench_Parse,        &s_parse1,  1u  },
+        { "dtc_parse_rbsm_63rec", Bench_Parse,        &s_parse63, 1u  },
+        { "dtc_status_update",    Bench_StatusUpdate, NULL,       32u },
+        { "crc32_12B",            Bench_Crc12,        NULL,       1u  },
+        { "crc32_256B",           Bench_Crc256,       NULL,       1u  },
+        { "ee_entry_serialize",   Bench_Serialize,    NULL,       1u  },
+        { "ee_entry_deserialize", Bench_Deserialize,  NULL,       1u  },
+        { "pmic_fault_decode",    Bench_PmicDecode,   NULL,       64u },
+    };
+
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        Bench_RunCase(cfg, &cases[i], NULL);
+    }
+}
@@ -0,0 +1,332 @@
+/*
+ * BusMgr.c
+ *
+ *  버스 관리 + 디바이스 레지스트리 (BusMgr.h 참조)
+ */
+
+#include "BusMgr.h"
+#include "EEPROM.h"
+#include "BusRec.h"
+#include <string.h>
+
+Bus_t busTable[BUS_COUNT];
+
+static BusDev_t devTable[BUSMGR_MAX_DEVICES];
+static uint8_t  devCount;
+static osMutexId_t devLock[BUSMGR_MAX_DEVICES];  // EEPROM: READ/WRITE ~ WIP 종료까지 (다른 태스크의 명령이 WIP 중 무시되지 않게)
+
+void BusMgr_Init(void)
+{
+    memset(busTable, 0, sizeof(busTable));
+    busTable[BUS_I2C1].handle = &hi2c1;
+    busTable[BUS_I2C2].handle = &hi2c2;
+    busTable[BUS_SPI1].handle = &hspi1;
+    busTable[BUS_SPI2].handle = &hspi2;
+    for (uint32_t i = 0; i < BUS_COUNT; i++) {
+        busTable[i].lock = osMutexNew(NULL);
+    }
+    devCount = 0;
+}
+
+void BusMgr_ShareLock(BusId_t bus, osMutexId_t lock)
+{
+    if (bus >= BUS_COUNT || lock == NULL) return;
+    if (busTable[bus].lock != NULL && busTable[bus].lock != lock) osMutexDelete(busTable[bus].lock);
+    busTable[bus].lock = lock;
+}
+
+int8_t BusMgr_Register(const BusDev_t* dev)
+{
+    if (dev == NULL || dev->bus >= BUS_COUNT || devCount >= BUSMGR_MAX_DEVICES) return -1;
+    if ((dev->type == BUSDEV_PMIC) != (dev->bus == BUS_I2C1 || dev->bus == BUS_I2C2)) return -1;
+
+    devTable[devCount] = *dev;
+    devLock[devCount] = (dev->type == BUSDEV_EEPROM) ? osMutexNew(NULL) : NULL;
+    return (int8_t)devCount++;
+}
+
+int8_t BusMgr_Find(const char* name)
+{
+    for (uint8_t i = 0; i < devCount; i++) {
+        if (devTable[i].name != NULL && strcmp(devTable[i].name, name) == 0) return (int8_t)i;
+    }
+    return -1;
+}
+
+const BusDev_t* BusMgr_Device(int8_t id)
+{
+    return (id >= 0 && (uint8_t)id < devCount) ? &devTable[id] : NULL;
+}
+
+/* ===== 버스 잠금 / DMA 완료 대기 ===== */
+static void BusMgr_Lock(Bus_t* b)
+{
+    if (osMutexAcquire(b->lock, 0) != osOK) {
+        b->contended++;
+        osMutexAcquire(b->lock, osWaitForever);
+    }
+}
+
+static void BusMgr_Unlock(Bus_t* b)
+{
+    osMutexRelease(b->lock);
+}
+
+/* DMA 시작 전에 호출 (완료가 대기보다 먼저 와도 flag 로 남는다) */
+static void BusMgr_Arm(Bus_t* b)
+{
+    b->err = 0;
+    b->waiter = osThreadGetId();
+    osThreadFlagsClear(BUSMGR_FLAG_DONE);
+}
+
+/* 완료가 오지 않은 DMA 전송 중단: 잠금을 놓기 전에 핸들을 READY 로 (호출자 버퍼에 더 쓰지 않게) */
+static void BusMgr_Abort(const BusDev_t* d, Bus_t* b)
+{
+    if (d->type == BUSDEV_PMIC) {
+        // HAL_I2C_Master_Abort_IT 는 Mem 전송(MODE_MEM)을 거부 → 재초기화:
+        // MspDeInit 이 DMA stream 을 멈추고, PE 리셋으로 SCL/SDA 를 놓는다
+        I2C_HandleTypeDef* hi2c = (I2C_HandleTypeDef*)b->handle;
+        (void)HAL_I2C_DeInit(hi2c);
+        (void)HAL_I2C_Init(hi2c);
+    } else {
+        (void)HAL_SPI_Abort((SPI_HandleTypeDef*)b->handle);     // CS 는 호출자가 이어서 해제
+    }
+}
+
+static HAL_StatusTypeDef BusMgr_Wait(const BusDev_t* d, Bus_t* b, HAL_StatusTypeDef started)
+{
+    uint32_t f = 0;
+
+    if (started == HAL_OK) {
+        f = osThreadFlagsWait(BUSMGR_FLAG_DONE, osFlagsWaitAny, BUSMGR_TIMEOUT_MS);
+        // 대기 중 도착한 태스크 고유 flag 는 값에는 남지만 notify 상태가 소비되어
+        // 다음 osThreadFlagsWait 가 놓친다 → 다시 set 해서 pending 으로 되돌림
+        uint32_t other = osThreadFlagsGet() & ~BUSMGR_FLAG_DONE;
+        if (other != 0u) osThreadFlagsSet(osThreadGetId(), other);
+    }
+    b->waiter = NULL;           // 중단 뒤 늦게 오는 콜백은 무시
+
+    if (started != HAL_OK)     return started;
+    if (f & osFlagsError) {
+        BusMgr_Abort(d, b);
+        return HAL_TIMEOUT;
+    }
+    return b->err ? HAL_ERROR : HAL_OK;
+}
+
+void BusMgr_XferDoneFromISR(const void* handle, uint8_t error)
+{
+    for (uint32_t i = 0; i < BUS_COUNT; i++) {
+        Bus_t* b = &busTable[i];
+        if (b->handle == handle) {
+            if (b->waiter != NULL) {     // BusMgr 밖의 DMA(파이프라인 등)는 무시
+                b->err = error;
+                osThreadFlagsSet(b->waiter, BUSMGR_FLAG_DONE);
+            }
+            return;
+        }
+    }
+}
+
+/* ===== PMIC (I2C, 레지스터 auto-increment) ===== */
+static HAL_StatusTypeDef BusMgr_PmicXfer(const BusDev_t* d, Bus_t* b, uint8_t reg, uint8_t* buf, uint16_t len, uint8_t isRead)
+{
+    I2C_HandleTypeDef* hi2c = (I2C_HandleTypeDef*)b->handle;
+    HAL_StatusTypeDef st;
+
+    BusMgr_Lock(b);
+    BusMgr_Arm(b);
+    st = isRead ? HAL_I2C_Mem_Read_DMA(hi2c, d->i2c_addr, reg, I2C_MEMADD_SIZE_8BIT, buf, len)
+                : HAL_I2C_Mem_Write_DMA(hi2c, d->i2c_addr, reg, I2C_MEMADD_SIZE_8BIT, buf, len);
+    st = BusMgr_Wait(d, b, st);
+    BusMgr_Unlock(b);
+    return st;
+}
+
+/* ===== SPI EEPROM (25LC256) ===== */
+static void BusMgr_Cs(const BusDev_t* d, GPIO_PinState s)
+{
+    if (d->cs_port != NULL) HAL_GPIO_WritePin(d->cs_port, d->cs_pin, s);
+}
+
+/* 명령/주소는 blocking, 데이터 구간은 DMA. 호출자가 버스 잠금 보유 */
+static HAL_StatusTypeDef BusMgr_SpiCmd(const BusDev_t* d, Bus_t* b, uint8_t* hdr, uint16_t hdrLen,
+                                       uint8_t* data, uint16_t len, uint8_t isRead)
+{
+    SPI_HandleTypeDef* hspi = (SPI_HandleTypeDef*)b->handle;
+    HAL_StatusTypeDef st;
+
+    BusMgr_Cs(d, GPIO_PIN_RESET);
+    st = HAL_SPI_Transmit(hspi, hdr, hdrLen, BUSMGR_TIMEOUT_MS);
+    if (st == HAL_OK && len != 0u) {
+        BusMgr_Arm(b);
+        st = isRead ? HAL_SPI_Receive_DMA(hspi, data, len) : HAL_SPI_Transmit_DMA(hspi, data, len);
+        st = BusMgr_Wait(d, b, st);
+    }
+    BusMgr_Cs(d, GPIO_PIN_SET);
+    return st;
+}
+
+static HAL_StatusTypeDef BusMgr_EeReadStatus(const BusDev_t* d, Bus_t* b, uint8_t* status)
+{
+    uint8_t tx[2] = { EEPROM_CMD_RDSR, 0xFF };
+    uint8_t rx[2] = { 0 };
+    HAL_StatusTypeDef st;
+
+    BusMgr_Cs(d, GPIO_PIN_RESET);
+    st = HAL_SPI_TransmitReceive((SPI_HandleTypeDef*)b->handle, tx, rx, 2, BUSMGR_TIMEOUT_MS);
+    BusMgr_Cs(d, GPIO_PIN_SET);
+    *status = rx[1];
+    return st;
+}
+
+static HAL_StatusTypeDef BusMgr_EeRead(const BusDev_t* d, Bus_t* b, uint16_t addr, uint8_t* buf, uint16_t len)
+{
+    uint8_t hdr[3] = { EEPROM_CMD_READ, (uint8_t)(addr >> 8), (uint8_t)addr };
+    HAL_StatusTypeDef st;
+
+    BusMgr_Lock(b);
+    st = BusMgr_SpiCmd(d, b, hdr, sizeof(hdr), buf, len, 1);
+    BusMgr_Unlock(b);
+    return st;
+}
+
+/* page 단위 WREN → WRITE, 쓰기 사이클 동안은 버스를 놓고 tick 폴링 */
+static HAL_StatusTypeDef BusMgr_EeWrite(const BusDev_t* d, Bus_t* b, uint16_t addr, const uint8_t* buf, uint16_t len)
+{
+    while (len > 0u) {
+        uint16_t n = (uint16_t)(EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE));
+        uint8_t wren = EEPROM_CMD_WREN;
+        uint8_t hdr[3] = { EEPROM_CMD_WRITE, (uint8_t)(addr >> 8), (uint8_t)addr };
+        uint8_t status = 0;
+        uint32_t polls = 0;
+        HAL_StatusTypeDef st;
+
+        if (n > len) n = len;
+
+        BusMgr_Lock(b);
+        st = BusMgr_SpiCmd(d, b, &wren, 1, NULL, 0, 0);
+        if (st == HAL_OK) st = BusMgr_SpiCmd(d, b, hdr, sizeof(hdr), (uint8_t*)buf, n, 0);
+        BusMgr_Unlock(b);
+        if (st != HAL_OK) return st;
+
+        do {
+            osDelay(1);
+            if (++polls > BUSMGR_WIP_POLL_MAX) return HAL_TIMEOUT;
+            BusMgr_Lock(b);
+            st = BusMgr_EeReadStatus(d, b, &status);
+            BusMgr_Unlock(b);
+            if (st != HAL_OK) return st;
+        } while (status & EEPROM_SR_WIP);
+
+        addr = (uint16_t)(addr + n);
+        buf += n;
+        len = (uint16_t)(len - n);
+    }
+    return HAL_OK;
+}
+
+/* ===== SPI NOR flash: 읽기만 (24-bit 주소). 프로그램/소거는 SpiFlash.c ===== */
+static HAL_StatusTypeDef BusMgr_FlashRead(const BusDev_t* d, Bus_t* b, uint32_t addr, uint8_t* buf, uint16_t len)
+{
+    uint8_t hdr[4] = { 0x03, (uint8_t)(addr >> 16), (uint8_t)(addr >> 8), (uint8_t)addr };
+    HAL_StatusTypeDef st;
+
+    BusMgr_Lock(b);
+    st = BusMgr_SpiCmd(d, b, hdr, sizeof(hdr), buf, len, 1);
+    BusMgr_Unlock(b);
+    return st;
+}
+
+HAL_StatusTypeDef BusMgr_SpiCommand(int8_t id, const uint8_t* hdr, uint16_t hdrLen,
+                                    uint8_t* data, uint16_t len, uint8_t isRead)
+{
+    const BusDev_t* d = BusMgr_Device(id);
+    Bus_t* b;
+    HAL_StatusTypeDef st;
+
+    if (d == NULL || d->type == BUSDEV_PMIC || hdr == NULL || hdrLen == 0u) return HAL_ERROR;
+    if (len != 0u && data == NULL) return HAL_ERROR;
+    b = &busTable[d->bus];
+
+    BusMgr_Lock(b);
+    if (isRead && len != 0u && len <= 8u) {
+        /* 상태 레지스터 등 짧은 응답은 DMA 설정 비용보다 blocking 이 싸다 */
+        SPI_HandleTypeDef* hspi = (SPI_HandleTypeDef*)b->handle;
+        BusMgr_Cs(d, GPIO_PIN_RESET);
+        st = HAL_SPI_Transmit(hspi, (uint8_t*)hdr, hdrLen, BUSMGR_TIMEOUT_MS);
+        if (st == HAL_OK) st = HAL_SPI_Receive(hspi, data, len, BUSMGR_TIMEOUT_MS);
+        BusMgr_Cs(d, GPIO_PIN_SET);
+    } else {
+        st = BusMgr_SpiCmd(d, b, (uint8_t*)hdr, hdrLen, data, len, isRead);
+    }
+    BusMgr_Unlock(b);
+
+    if (st == HAL_OK) {
+        b->xfers++;
+        b->bytes += len;
+    } else {
+        b->errors++;
+    }
+    return st;
+}
+
+/* ===== 공통 진입점 ===== */
+static HAL_StatusTypeDef BusMgr_Xfer(int8_t id, uint32_t addr, uint8_t* buf, uint16_t len, uint8_t isRead)
+{
+    const BusDev_t* d = BusMgr_Device(id);
+    Bus_t* b;
+    HAL_StatusTypeDef st;
+
+    if (d == NULL || buf == NULL || len == 0u) return HAL_ERROR;
+    b = &busTable[d->bus];
+
+    if (d->type == BUSDEV_PMIC) {
+        if (addr + len > 0x100u) return HAL_ERROR;
+        st = BusMgr_PmicXfer(d, b, (uint8_t)addr, buf, len, isRead);
+    } else if (d->type == BUSDEV_SPI_FLASH) {
+        if (!isRead) return HAL_ERROR;      // erase-before-write 관리는 SpiFlash_Program
+        st = BusMgr_FlashRead(d, b, addr, buf, len);
+    } else {
+        if (addr + len > EEPROM_SIZE_BYTES) return HAL_ERROR;
+        osMutexAcquire(devLock[id], osWaitForever);
+        st = isRead ? BusMgr_EeRead(d, b, (uint16_t)addr, buf, len)
+                    : BusMgr_EeWrite(d, b, (uint16_t)addr, buf, len);
+        osMutexRelease(devLock[id]);
+    }
+
+    if (st == HAL_OK) {
+        b->xfers++;
+        b->bytes += len;
+        // PMIC 은 DMA 완료 콜백에서 기록
+        if (d->type != BUSDEV_PMIC) {
+            BUSREC(d->bus, isRead ? BUSREC_OP_RD : BUSREC_OP_WR, BUSREC_SPI_ID(d->type, addr), buf, len);
+        }
+    } else {
+        b->errors++;
+    }
+    return st;
+}
+
+HAL_StatusTypeDef BusMgr_Read(int8_t id, uint32_t addr, uint8_t* buf, uint16_t len)
+{
+    return BusMgr_Xfer(id, addr, buf, len, 1);
+}
+
+HAL_StatusTypeDef BusMgr_Write(int8_t id, uint32_t addr, const uint8_t* buf, uint16_t len)
+{
+    return BusMgr_Xfer(id, addr, (uint8_t*)buf, len, 0);
+}
+
+/* ===== DMA 완료 콜백 (I2C MemRx 는 Task.c 의 trace 훅에서 전달) ===== */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    BUSREC_I2C(hi2c, BUSREC_OP_WR);          // 파이프라인 밖 PMIC DMA 쓰기 (BusMgr)
+    BusMgr_XferDoneFromISR(hi2c, 0);
+}
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)     { BusMgr_XferDoneFromISR(hi2c, 1); }
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)    { BusMgr_XferDoneFromISR(hspi, 0); }
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)    { BusMgr_XferDoneFromISR(hspi, 0); }
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)  { BusMgr_XferDoneFromISR(hspi, 0); }
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)     { BusMgr_XferDoneFromISR(hspi, 1); }
@@ -0,0 +1,128 @@
+/*
+ * BusRec.c
+ *
+ *  CAN / I2C / SPI 트래픽 기록기 (BusRec.h 참조)
+ */
+
+#include "BusRec.h"
+
+#include <stdio.h>
+#include <string.h>
+
+extern CAN_HandleTypeDef hcan1;
+
+static BusRec_Entry_t    s_buf[BUSREC_BUF_SIZE];
+static volatile uint32_t s_head;     // 다음 예약 인덱스 (단조 증가)
+
+void BusRec_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    for (uint32_t i = 0; i < BUSREC_BUF_SIZE; i++) s_buf[i].seq = 0;
+    s_head = 0;
+}
+
+uint8_t BusRec_BusOf(const void* handle)
+{
+    if (handle == &hi2c1) return BUS_I2C1;
+    if (handle == &hi2c2) return BUS_I2C2;
+    if (handle == &hspi1) return BUS_SPI1;
+    if (handle == &hspi2) return BUS_SPI2;
+    if (handle == &hcan1) return BUSREC_BUS_CAN1;
+    return BUSREC_BUS_NONE;
+}
+
+static uint32_t BusRec_Chunks(uint16_t keep)
+{
+    return (keep == 0u) ? 1u : ((uint32_t)keep + BUSREC_CHUNK - 1u) / BUSREC_CHUNK;
+}
+
+void BusRec_Log(uint8_t bus, uint8_t op, uint32_t id, const uint8_t* data, uint16_t len)
+{
+    uint16_t keep = (data == NULL) ? 0u : ((len > BUSREC_MAX_DATA) ? BUSREC_MAX_DATA : len);
+    uint32_t n = BusRec_Chunks(keep);
+    /* 연속 항목까지 한 번에 예약 → 다른 생산자가 사이에 끼지 않음.
+       ts 는 예약 뒤에 읽으므로 선점된 경우 이웃 항목과 순서가 약간 뒤바뀔 수 있음 (분석기는 부호 있는 차로 계산) */
+    uint32_t idx = __atomic_fetch_add(&s_head, n, __ATOMIC_RELAXED);
+    uint32_t ts = DWT->CYCCNT;
+    uint8_t  mhz = (uint8_t)(SystemCoreClock / 1000000u);
+
+    for (uint32_t k = 0; k < n; k++) {
+        BusRec_Entry_t* e = &s_buf[(idx + k) & (BUSREC_BUF_SIZE - 1u)];
+        uint32_t off = k * BUSREC_CHUNK;
+        uint32_t m = (keep > off) ? (uint32_t)keep - off : 0u;
+        if (m > BUSREC_CHUNK) m = BUSREC_CHUNK;
+
+        e->seq = 0;                 // 기록 중 표시
+        e->ts  = (k == 0u) ? ts : 0u;
+        e->id  = id;
+        e->len = len;
+        e->bus = bus;
+        e->op  = (k == 0u) ? op : (uint8_t)BUSREC_OP_CONT;
+        e->mhz = mhz;
+        if (m != 0u) memcpy(e->data, &data[off], m);
+        __atomic_store_n(&e->seq, idx + k + 1u, __ATOMIC_RELEASE);
+    }
+}
+
+// DMA 모드 HAL 은 완료 후에도 pBuffPtr / XferSize / 주소를 그대로 둔다
+void BusRec_LogI2C(I2C_HandleTypeDef* hi2c, uint8_t op)
+{
+    BusRec_Log(BusRec_BusOf(hi2c), op, BUSREC_I2C_ID(hi2c->Devaddress, hi2c->Memaddress),
+               hi2c->pBuffPtr, hi2c->XferSize);
+}
+
+uint32_t BusRec_Count(void)
+{
+    return __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+}
+
+static int BusRec_Valid(uint32_t i)
+{
+    return __atomic_load_n(&s_buf[i & (BUSREC_BUF_SIZE - 1u)].seq, __ATOMIC_ACQUIRE) == i + 1u;
+}
+
+/* 줄을 나눠 보냄 (UARTTask 스택): 머리 + 항목별 hex + 줄바꿈 */
+void BusRec_Dump(BusRec_WriteFn write)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char line[2u * BUSREC_CHUNK + 1u + 32u];
+    uint32_t head = BusRec_Count();
+    uint32_t n = (head > BUSREC_BUF_SIZE) ? BUSREC_BUF_SIZE : head;
+    uint32_t first = head - n;
+
+    snprintf(line, sizeof(line), "BUSREC v=%u n=%lu dropped=%lu\n",
+             (unsigned)BUSREC_FORMAT_VERSION, (unsigned long)n, (unsigned long)first);
+    write(line);
+
+    for (uint32_t i = first; i < head; i++) {
+        const BusRec_Entry_t* e = &s_buf[i & (BUSREC_BUF_SIZE - 1u)];
+        if (!BusRec_Valid(i) || e->op == BUSREC_OP_CONT) continue;   // 기록 중 / 앞부분을 덮어씀
+
+        uint16_t keep = (e->len > BUSREC_MAX_DATA) ? BUSREC_MAX_DATA : e->len;
+        uint32_t chunks = BusRec_Chunks(keep);
+        uint32_t ok = (i + chunks <= head);
+        for (uint32_t k = 1; ok && k < chunks; k++) ok = BusRec_Valid(i + k);
+        if (!ok) continue;
+
+        snprintf(line, sizeof(line), "B %lu %u %u %u %lX %u ", (unsigned long)e->ts, (unsigned)e->mhz,
+                 (unsigned)e->bus, (unsigned)e->op, (unsigned long)e->id, (unsigned)e->len);
+        write(line);
+        for (uint32_t k = 0; k < chunks; k++) {
+            const BusRec_Entry_t* c = &s_buf[(i + k) & (BUSREC_BUF_SIZE - 1u)];
+            uint32_t off = k * BUSREC_CHUNK;
+            uint32_t m = (keep > off) ? (uint32_t)keep - off : 0u;
+            if (m > BUSREC_CHUNK) m = BUSREC_CHUNK;
+            for (uint32_t j = 0; j < m; j++) {
+                line[2u * j]      = hex[c->data[j] >> 4];
+                line[2u * j + 1u] = hex[c->data[j] & 0x0Fu];
+            }
+            line[2u * m] = '\0';
+            if (keep == 0u) strcpy(line, "-");
+            write(line);
+        }
+        write("\n");
+        i += chunks - 1u;
+    }
+    write("E\n");
+}
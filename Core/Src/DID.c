@@ -0,0 +1,268 @@
+/*
+ * DID.c
+ *
+ *  DataIdentifier 표 + 0x22/0x2E 처리 (DID.h 참조)
+ */
+
+#include "DID.h"
+#include "UDS_CAN.h"
+#include "DTCMem.h"
+#include "DVFS.h"
+#include "PMIC.h"
+#include "SupplyMon.h"
+#include "Trace.h"
+#include "StackMon.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* ===== 구성 데이터 ===== */
+
+static uint8_t didVin[17] = "KNACOMENTO0000001";            // F190: RAM (0x2E 로 변경, 보안 필요)
+static const uint8_t didEcuSerial[10] = "F413-00001";       // F18C
+
+/* ===== 계산 값 ===== */
+
+static uint8_t DID_ReadDtcCount(uint8_t* out)
+{
+    uint16_t n = DTCMem_Ready(&dtcMem) ? DTCMem_CountByMask(&dtcMem, 0xFFu) : 0u;
+    out[0] = (uint8_t)(n >> 8);
+    out[1] = (uint8_t)n;
+    return 2;
+}
+
+/* Task 수, Task 스택 최소 여유 (word), trace 이벤트 수 */
+static uint8_t DID_ReadTaskStats(uint8_t* out)
+{
+    static TaskStatus_t st[16];
+    UBaseType_t n = uxTaskGetSystemState(st, sizeof(st) / sizeof(st[0]), NULL);
+    uint16_t minFree = 0xFFFFu;
+    uint32_t ev = Trace_Count();
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        if (st[i].usStackHighWaterMark < minFree) minFree = st[i].usStackHighWaterMark;
+    }
+    out[0] = (uint8_t)n;
+    out[1] = (uint8_t)(minFree >> 8); out[2] = (uint8_t)minFree;
+    out[3] = (uint8_t)(ev >> 24); out[4] = (uint8_t)(ev >> 16); out[5] = (uint8_t)(ev >> 8); out[6] = (uint8_t)ev;
+    return 7;
+}
+
+/* 풀마다 사용 중, 최대 동시 사용, 고갈 횟수 (16 비트 포화): 수신 프레임 / 요청 / 응답 */
+static uint8_t DID_ReadPoolStats(uint8_t* out)
+{
+    const Pool_t* pools[3] = { &udsFramePool, &udsReqPool, &udsRspPool };
+
+    for (uint32_t i = 0; i < 3u; i++) {
+        uint32_t ex = (pools[i]->exhausted > 0xFFFFu) ? 0xFFFFu : pools[i]->exhausted;
+        out[4u * i]      = (uint8_t)pools[i]->used;
+        out[4u * i + 1u] = (uint8_t)pools[i]->hwm;
+        out[4u * i + 2u] = (uint8_t)(ex >> 8);
+        out[4u * i + 3u] = (uint8_t)ex;
+    }
+    return 12;
+}
+
+/* heap_4 여유 / 최소 여유 / 최대 연속 블록 (B), malloc 실패, 스택 오버플로 누적 (16 비트 포화) */
+static uint8_t DID_ReadMemStats(uint8_t* out)
+{
+    HeapStats_t hs;
+    vPortGetHeapStats(&hs);
+    const uint32_t v[5] = { hs.xAvailableHeapSpaceInBytes, hs.xMinimumEverFreeBytesRemaining,
+                            hs.xSizeOfLargestFreeBlockInBytes, stackMon.malloc_fails, stackMon.overflows };
+
+    for (uint32_t i = 0; i < 5u; i++) {
+        uint32_t x = (v[i] > 0xFFFFu) ? 0xFFFFu : v[i];
+        out[2u * i]      = (uint8_t)(x >> 8);
+        out[2u * i + 1u] = (uint8_t)x;
+    }
+    return 10;
+}
+
+/* ===== 값 검사 ===== */
+
+/* uv < uv_clear < ov_clear < ov (히스테리시스 유지) */
+static HAL_StatusTypeDef DID_WriteSupplyThresholds(const DID_Entry_t* e, const uint8_t* in)
+{
+    uint16_t uv  = (uint16_t)((in[0] << 8) | in[1]);
+    uint16_t uvc = (uint16_t)((in[2] << 8) | in[3]);
+    uint16_t ov  = (uint16_t)((in[4] << 8) | in[5]);
+    uint16_t ovc = (uint16_t)((in[6] << 8) | in[7]);
+
+    if (!(uv < uvc && uvc < ovc && ovc < ov)) return HAL_ERROR;
+    DID_Store(e, in);
+    return HAL_OK;
+}
+
+/* 0xFF = 거버너, 그 외 OPP 고정 */
+static HAL_StatusTypeDef DID_WriteDvfsForce(const DID_Entry_t* e, const uint8_t* in)
+{
+    (void)e;
+    if (in[0] != 0xFFu && in[0] >= DVFS_OPP_COUNT) return HAL_ERROR;
+    DVFS_Force(in[0] == 0xFFu ? -1 : (int8_t)in[0]);
+    return HAL_OK;
+}
+
+/* ===== DID 표 (오름차순) ===== */
+
+#define DID_LIVE(id, fmt, len, acc, ptr, wr)  { (id), (fmt), (len), (acc), (const volatile void*)(ptr), NULL, (wr) }
+#define DID_CALC(id, len, rd)                 { (id), DID_FMT_U8, (len), DID_ACC_READ, NULL, (rd), NULL }
+
+#define RO   DID_ACC_READ
+#define RW   (DID_ACC_READ | DID_ACC_WRITE)
+#define RWS  (DID_ACC_READ | DID_ACC_WRITE | DID_ACC_SECURE)
+
+static const DID_Entry_t didEntries[] = {
+    /* 공급 전압: 필터 값, 임계값 (uv, uv_clear, ov, ov_clear), 블록/overrun */
+    DID_LIVE(0xD100u, DID_FMT_U16, 2,  RO,  &supplyMon.supply_mV, NULL),
+    DID_LIVE(0xD101u, DID_FMT_U16, 8,  RW,  &supplyMon.cfg.uv_mV, DID_WriteSupplyThresholds),
+    DID_LIVE(0xD102u, DID_FMT_U32, 8,  RO,  &supplyMon.blocks, NULL),
+    /* PMIC: shadow 레지스터 (0x05~0x09, 0x16~0x19), I2C 트랜잭션/오류, 램프 step */
+    DID_LIVE(0xD110u, DID_FMT_U8,  PMIC_SHADOW_COUNT, RO, pmicShadow.regs, NULL),
+    DID_LIVE(0xD111u, DID_FMT_U32, 8,  RO,  &pmicShadow.xfers, NULL),
+    DID_LIVE(0xD112u, DID_FMT_U8,  1,  RW,  &pmicShadow.ramp_step, NULL),
+    /* DVFS: 현재 OPP, CAN 프레임/s, OPP 별 체류 시간, 전환/실패, 고정 OPP */
+    DID_LIVE(0xD120u, DID_FMT_U8,  1,  RO,  &dvfs.cur, NULL),
+    DID_LIVE(0xD121u, DID_FMT_U32, 4,  RO,  &dvfs.can_fps, NULL),
+    DID_LIVE(0xD122u, DID_FMT_U32, 4 * DVFS_OPP_COUNT, RO, dvfs.residency_ms, NULL),
+    DID_LIVE(0xD123u, DID_FMT_U32, 8,  RO,  &dvfs.transitions, NULL),
+    DID_LIVE(0xD124u, DID_FMT_U8,  1,  RWS, &dvfs.forced, DID_WriteDvfsForce),
+    /* UDS 서버: 요청/0x78/S3 만료, 기능 주소 처리 */
+    DID_LIVE(0xD130u, DID_FMT_U32, 12, RO,  &udsServer.requests, NULL),
+    DID_LIVE(0xD131u, DID_FMT_U32, 16, RO,  &udsServer.func_requests, NULL),
+    /* DTC 메모리 / Task / 메모리 풀 / heap·스택 */
+    DID_CALC(0xD140u, 2, DID_ReadDtcCount),
+    DID_CALC(0xD150u, 7, DID_ReadTaskStats),
+    DID_CALC(0xD160u, 12, DID_ReadPoolStats),
+    DID_CALC(0xD170u, 10, DID_ReadMemStats),
+    /* ISO 14229-1 C.1 */
+    DID_LIVE(0xF186u, DID_FMT_U8,  1,  RO,  &udsServer.session, NULL),
+    DID_LIVE(0xF18Cu, DID_FMT_U8,  sizeof(didEcuSerial), RO, didEcuSerial, NULL),
+    DID_LIVE(0xF190u, DID_FMT_U8,  sizeof(didVin), RWS, didVin, NULL),
+    /* 0x2A periodic DID (F2xx, 7B 이하): 공급 전압/UV·OV 상태, PMIC fault/VOUT 레지스터, OPP */
+    DID_LIVE(0xF200u, DID_FMT_U16, 2,  RO,  &supplyMon.supply_mV, NULL),
+    DID_LIVE(0xF201u, DID_FMT_U8,  2,  RO,  &supplyMon.uv_active, NULL),
+    DID_LIVE(0xF210u, DID_FMT_U8,  PMIC_STATUS_COUNT, RO, &pmicShadow.regs[0], NULL),
+    DID_LIVE(0xF211u, DID_FMT_U8,  PMIC_SHADOW_COUNT - PMIC_STATUS_COUNT, RO, &pmicShadow.regs[PMIC_STATUS_COUNT], NULL),
+    DID_LIVE(0xF220u, DID_FMT_U8,  1,  RO,  &dvfs.cur, NULL),
+};
+
+const DID_Table_t didTable = { didEntries, sizeof(didEntries) / sizeof(didEntries[0]) };
+
+/* ===== 엔진 ===== */
+
+HAL_StatusTypeDef DID_CheckTable(const DID_Table_t* t)
+{
+    for (uint16_t i = 0; i < t->n; i++) {
+        const DID_Entry_t* e = &t->e[i];
+        if (i != 0u && e->did <= t->e[i - 1u].did) return HAL_ERROR;
+        if (e->fmt != DID_FMT_U8 && e->fmt != DID_FMT_U16 && e->fmt != DID_FMT_U32) return HAL_ERROR;
+        if (e->len == 0u || e->len > DID_MAX_DATA || (e->len % e->fmt) != 0u) return HAL_ERROR;
+        if (e->live == NULL && (e->read == NULL || (e->access & DID_ACC_WRITE))) return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+const DID_Entry_t* DID_Find(const DID_Table_t* t, uint16_t did)
+{
+    uint16_t lo = 0, hi = t->n;
+
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)((lo + hi) >> 1);
+        uint16_t d = t->e[mid].did;
+        if (d == did) return &t->e[mid];
+        if (d < did) lo = (uint16_t)(mid + 1u);
+        else         hi = mid;
+    }
+    return NULL;
+}
+
+uint8_t DID_ReadData(const DID_Entry_t* e, uint8_t* out)
+{
+    if (e->live == NULL) return e->read(out);
+
+    switch (e->fmt) {
+    case DID_FMT_U16: {
+        const volatile uint16_t* p = (const volatile uint16_t*)e->live;
+        for (uint32_t i = 0; i < e->len / 2u; i++) {
+            uint16_t v = p[i];
+            out[2u * i] = (uint8_t)(v >> 8); out[2u * i + 1u] = (uint8_t)v;
+        }
+        break;
+    }
+    case DID_FMT_U32: {
+        const volatile uint32_t* p = (const volatile uint32_t*)e->live;
+        for (uint32_t i = 0; i < e->len / 4u; i++) {
+            uint32_t v = p[i];
+            out[4u * i] = (uint8_t)(v >> 24); out[4u * i + 1u] = (uint8_t)(v >> 16);
+            out[4u * i + 2u] = (uint8_t)(v >> 8); out[4u * i + 3u] = (uint8_t)v;
+        }
+        break;
+    }
+    default: {
+        const volatile uint8_t* p = (const volatile uint8_t*)e->live;
+        for (uint32_t i = 0; i < e->len; i++) out[i] = p[i];
+        break;
+    }
+    }
+    return e->len;
+}
+
+/* 여러 원소를 다른 Task 가 한 번에 보도록 kernel lock 안에서 기록 */
+void DID_Store(const DID_Entry_t* e, const uint8_t* in)
+{
+    volatile uint8_t* p = (volatile uint8_t*)(uintptr_t)e->live;
+
+    osKernelLock();
+    for (uint32_t i = 0; i < e->len; i += e->fmt) {
+        if (e->fmt == DID_FMT_U16) {
+            *(volatile uint16_t*)&p[i] = (uint16_t)((in[i] << 8) | in[i + 1u]);
+        } else if (e->fmt == DID_FMT_U32) {
+            *(volatile uint32_t*)&p[i] = ((uint32_t)in[i] << 24) | ((uint32_t)in[i + 1u] << 16)
+                                       | ((uint32_t)in[i + 2u] << 8) | in[i + 3u];
+        } else {
+            p[i] = in[i];
+        }
+    }
+    osKernelUnlock();
+}
+
+uint8_t DID_ReadRequest(const DID_Table_t* t, const uint8_t* req, uint16_t len,
+                        uint8_t* rsp, uint16_t max, uint16_t* rspLen)
+{
+    uint16_t pos = 0;
+    uint8_t found = 0;
+
+    if (len < 2u || (len & 1u) != 0u || len / 2u > DID_MAX_PER_REQ) return UDS_NRC_INCORRECT_LENGTH;
+
+    for (uint16_t i = 0; i < len; i += 2u) {
+        const DID_Entry_t* e = DID_Find(t, (uint16_t)((req[i] << 8) | req[i + 1u]));
+        if (e == NULL || !(e->access & DID_ACC_READ)) continue;     // 미지원 DID 는 응답에서 빠짐
+        if (pos + 2u + e->len > max) return UDS_NRC_RESPONSE_TOO_LONG;
+        rsp[pos++] = req[i];
+        rsp[pos++] = req[i + 1u];
+        pos = (uint16_t)(pos + DID_ReadData(e, &rsp[pos]));
+        found++;
+    }
+    if (found == 0u) return UDS_NRC_REQUEST_OUT_OF_RANGE;
+    *rspLen = pos;
+    return 0;
+}
+
+uint8_t DID_WriteRequest(const DID_Table_t* t, const uint8_t* req, uint16_t len,
+                         uint8_t session, uint8_t unlocked)
+{
+    if (len < 3u) return UDS_NRC_INCORRECT_LENGTH;
+
+    const DID_Entry_t* e = DID_Find(t, (uint16_t)((req[0] << 8) | req[1]));
+    // 쓰기 불가 DID / default 세션: ISO 14229-1 11.7 (DID 단위 세션 제한은 0x31)
+    if (e == NULL || !(e->access & DID_ACC_WRITE) || session == UDS_SESSION_DEFAULT) return UDS_NRC_REQUEST_OUT_OF_RANGE;
+    if (len != 2u + e->len) return UDS_NRC_INCORRECT_LENGTH;
+    if ((e->access & DID_ACC_SECURE) && !unlocked) return UDS_NRC_SECURITY_ACCESS_DENIED;
+
+    HAL_StatusTypeDef st = HAL_OK;
+    if (e->write != NULL) st = e->write(e, &req[2]);
+    else                  DID_Store(e, &req[2]);
+    if (st == HAL_ERROR) return UDS_NRC_REQUEST_OUT_OF_RANGE;
+    if (st != HAL_OK)    return UDS_NRC_GENERAL_PROGRAMMING_FAIL;
+    return 0;
+}
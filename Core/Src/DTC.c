@@ -8,6 +8,8 @@
 
 
 #include "DTC.h"
+#include "BusRec.h"
+#include <string.h>
 
 /* ===== 내부 헬퍼 ===== */
 static HAL_StatusTypeDef CAN_SendUDS(DTC_Ctx_t* ctx,
@@ -20,7 +22,9 @@ static HAL_StatusTypeDef CAN_SendUDS(DTC_Ctx_t* ctx,
     txh.IDE   = CAN_ID_STD;
     txh.RTR   = CAN_RTR_DATA;
     txh.DLC   = len;                 // 단일프레임 전제(<=8)
-    return HAL_CAN_AddTxMessage(ctx->hcan, &txh, (uint8_t*)data, &mbox);
+    HAL_StatusTypeDef st = HAL_CAN_AddTxMessage(ctx->hcan, &txh, (uint8_t*)data, &mbox);
+    if (st == HAL_OK) BUSREC(BusRec_BusOf(ctx->hcan), BUSREC_OP_TX, canid, data, len);
+    return st;
 }
 
 static HAL_StatusTypeDef CAN_RecvUDS(DTC_Ctx_t* ctx,
@@ -33,6 +37,8 @@ static HAL_StatusTypeDef CAN_RecvUDS(DTC_Ctx_t* ctx,
         CAN_RxHeaderTypeDef rxh;
         if (HAL_CAN_GetRxFifoFillLevel(ctx->hcan, CAN_RX_FIFO0) > 0) {
             if (HAL_CAN_GetRxMessage(ctx->hcan, CAN_RX_FIFO0, &rxh, out) == HAL_OK) {
+                BUSREC(BusRec_BusOf(ctx->hcan), BUSREC_OP_RX,
+                       (rxh.IDE == CAN_ID_STD) ? rxh.StdId : (rxh.ExtId | BUSREC_CAN_EXT), out, rxh.DLC);
                 if (rxh.IDE == CAN_ID_STD && rxh.StdId == expected_canid) {
                     *outlen = rxh.DLC;
                     return HAL_OK;
@@ -107,6 +113,14 @@ HAL_StatusTypeDef DTC_UDS_ReadByStatusMask(DTC_Ctx_t* ctx,
     st = CAN_RecvUDS(ctx, UDS_RES_CANID, resp, &rlen, 50);
     if (st != HAL_OK) return st;
 
+    return DTC_UDS_ParseReadByStatusMask(resp, rlen, outList, inoutCount);
+}
+
+/* 0x59/0x02 응답 파싱 (송수신과 분리: 벤치/상위 계층에서 재사용) */
+HAL_StatusTypeDef DTC_UDS_ParseReadByStatusMask(const uint8_t* resp, uint8_t rlen,
+                                                DTC_Record_t* outList,
+                                                uint8_t* inoutCount)
+{
     if (!(rlen >= 3 && resp[0] == (UDS_SVC_READ_DTC_INFO | 0x40) && resp[1] == UDS_RDI_REPORT_DTC_BY_STATUS_MASK))
         return HAL_ERROR;
 
@@ -127,57 +141,248 @@ HAL_StatusTypeDef DTC_UDS_ReadByStatusMask(DTC_Ctx_t* ctx,
     return HAL_OK;
 }
 
-/* ===== EEPROM: 25LC256 단일 레코드 저장/로드 =====
-   - WREN -> WRITE -> WIP 폴링 (Status Register)
-   - p.6: Status Register(WIP/WEL) 및 명령/타이밍 개요
+/* ===== DTC Status 갱신 (ISO 14229-1 D.2 statusOfDTC) =====
+   - confirm 임계값 1: 첫 실패 판정에서 pending/confirmed 동시 설정
 */
-#define EE_INS_WREN   0x06u
-#define EE_INS_WRDI   0x04u
-#define EE_INS_RDSR   0x05u
-#define EE_INS_WRITE  0x02u
-#define EE_INS_READ   0x03u
+void DTC_UpdateStatus(DTC_Record_t* r, bool failed)
+{
+    uint8_t st = r->status;
 
-static HAL_StatusTypeDef EE_ReadStatus(SPI_HandleTypeDef* h, uint8_t* sr)
+    st &= (uint8_t)~(DTC_ST_TNCSLC | DTC_ST_TNCTOC);
+    if (failed) {
+        st |= (uint8_t)(DTC_ST_TF | DTC_ST_TFTOC | DTC_ST_PDTC | DTC_ST_CDTC | DTC_ST_TFSLC);
+    } else {
+        st &= (uint8_t)~DTC_ST_TF;
+    }
+    r->status = st;
+}
+
+void DTC_StartOperationCycle(DTC_Record_t* r)
 {
-    uint8_t tx[2] = { EE_INS_RDSR, 0xFF }, rx[2] = {0};
-    HAL_StatusTypeDef st = HAL_SPI_TransmitReceive(h, tx, rx, 2, HAL_MAX_DELAY);
-    if (st != HAL_OK) return st;
-    *sr = rx[1]; // 두 번째 바이트가 STATUS
-    return HAL_OK;
+    uint8_t st = r->status;
+
+    /* 직전 사이클에서 실패가 없었으면 pending 해제 */
+    if ((st & DTC_ST_TFTOC) == 0) st &= (uint8_t)~DTC_ST_PDTC;
+    st &= (uint8_t)~DTC_ST_TFTOC;
+    st |= DTC_ST_TNCTOC;
+    r->status = st;
 }
 
-static HAL_StatusTypeDef EE_WaitWriteComplete(SPI_HandleTypeDef* h)
+/* ===== CRC-32 (IEEE 802.3, reflected 0xEDB88320) =====
+   nibble 테이블(64B): 바이트 테이블(1KB) 대비 Flash 절약, 비트 단위 대비 ~4배 빠름
+*/
+uint32_t DTC_CalcCRC32(const void* data, uint32_t len)
 {
-    uint8_t sr;
-    uint32_t t0 = HAL_GetTick();
-    do {
-        if (EE_ReadStatus(h, &sr) != HAL_OK) return HAL_ERROR;
-        if ((sr & 0x01u) == 0) return HAL_OK; // WIP=0 (p.6)
-    } while ((HAL_GetTick() - t0) < 10);      // 보수적 10ms
-    return HAL_TIMEOUT;
+    static const uint32_t tbl[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ tbl[crc & 0x0Fu];
+        crc = (crc >> 4) ^ tbl[crc & 0x0Fu];
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/* ===== CRC-16/CCITT-FALSE (0x1021, init 0xFFFF) =====
+   압축 테이블 page 검사용. 테이블 없이 바이트당 shift/xor 몇 번 (nibble 테이블보다 빠르고 Flash 0B)
+*/
+uint16_t DTC_CalcCRC16(const void* data, uint32_t len)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint16_t crc = 0xFFFFu;
+
+    while (len--) {
+        uint8_t x = (uint8_t)((crc >> 8) ^ *p++);
+        x ^= (uint8_t)(x >> 4);
+        crc = (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+    }
+    return crc;
+}
+
+/* ===== EEPROM 레코드 직렬화 (little-endian, 12B) =====
+   ARM 에서 memcpy(struct) 와 동일한 바이트 배치를 명시적으로 고정
+*/
+void DTC_SerializeEntry(const DTC_Entry_t* e, uint8_t out[DTC_ENTRY_SIZE])
+{
+    out[0]  = e->rec.dtc[0];
+    out[1]  = e->rec.dtc[1];
+    out[2]  = e->rec.dtc[2];
+    out[3]  = e->rec.status;
+    out[4]  = (uint8_t)(e->timestamp_ms);
+    out[5]  = (uint8_t)(e->timestamp_ms >> 8);
+    out[6]  = (uint8_t)(e->timestamp_ms >> 16);
+    out[7]  = (uint8_t)(e->timestamp_ms >> 24);
+    out[8]  = (uint8_t)(e->crc32);
+    out[9]  = (uint8_t)(e->crc32 >> 8);
+    out[10] = (uint8_t)(e->crc32 >> 16);
+    out[11] = (uint8_t)(e->crc32 >> 24);
+}
+
+void DTC_DeserializeEntry(const uint8_t in[DTC_ENTRY_SIZE], DTC_Entry_t* e)
+{
+    e->rec.dtc[0] = in[0];
+    e->rec.dtc[1] = in[1];
+    e->rec.dtc[2] = in[2];
+    e->rec.status = in[3];
+    e->timestamp_ms = (uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) | ((uint32_t)in[7] << 24);
+    e->crc32        = (uint32_t)in[8] | ((uint32_t)in[9] << 8) | ((uint32_t)in[10] << 16) | ((uint32_t)in[11] << 24);
+}
+
+/* ===== 압축 DTC 테이블 (DTC.h 의 page 형식 참조) =====
+   - timestamp 는 직전 record 와의 차이 (zigzag varint): 같은 운전 사이클의 DTC 는 대부분 1~2B
+   - page 마다 base_ts 를 두어 page 단위로 독립 디코드 (한 page 가 깨져도 위치 판별 가능)
+   - 첫 발생 시각은 마지막 발생과의 차이 (varint): 한 번만 발생한 DTC 는 생략 (첫 = 마지막)
+*/
+#define PK_PAYLOAD_END  (DTC_PK_PAGE_SIZE - DTC_PK_CRC_SIZE)
+
+static uint32_t PK_ZigZag(int32_t d)    { return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31); }
+static int32_t  PK_UnZigZag(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1u); }
+
+static uint32_t PK_VarintLen(uint32_t v)
+{
+    uint32_t n = 1;
+    while (v >= 0x80u) { v >>= 7; n++; }
+    return n;
+}
+
+static uint32_t PK_PutVarint(uint8_t* p, uint32_t v)
+{
+    uint32_t n = 0;
+    while (v >= 0x80u) { p[n++] = (uint8_t)(v | 0x80u); v >>= 7; }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool PK_GetVarint(const uint8_t* pg, uint32_t* off, uint32_t* v)
+{
+    uint32_t x = 0;
+    for (uint32_t shift = 0; shift < 35u; shift += 7u) {
+        if (*off >= PK_PAYLOAD_END) return false;
+        uint8_t b = pg[(*off)++];
+        x |= (uint32_t)(b & 0x7Fu) << shift;
+        if (!(b & 0x80u)) { *v = x; return true; }
+    }
+    return false;
 }
 
-HAL_StatusTypeDef DTC_SaveToEEPROM(DTC_Ctx_t* ctx, const DTC_Entry_t* e)
+static void PK_Put32(uint8_t* p, uint32_t v)
 {
-    uint8_t cmd[3 + sizeof(DTC_Entry_t)] = { EE_INS_WRITE, 0x00, 0x00 }; // 주소 0 고정 예시
-    memcpy(&cmd[3], e, sizeof(DTC_Entry_t));
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t PK_Get32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
 
-    uint8_t wren = EE_INS_WREN;
-    if (HAL_SPI_Transmit(ctx->hspi, &wren, 1, HAL_MAX_DELAY) != HAL_OK) return HAL_ERROR;
-    if (HAL_SPI_Transmit(ctx->hspi, cmd, 3 + sizeof(DTC_Entry_t), HAL_MAX_DELAY) != HAL_OK) return HAL_ERROR;
-    return EE_WaitWriteComplete(ctx->hspi); // p.6 WIP 폴링
+static uint8_t* PK_OpenPage(uint8_t* out, uint16_t idx, uint32_t gen, uint32_t base)
+{
+    uint8_t* pg = &out[idx * DTC_PK_PAGE_SIZE];
+
+    memset(pg, 0xFF, DTC_PK_PAGE_SIZE);
+    pg[0] = DTC_PK_VERSION;
+    pg[1] = (uint8_t)idx;
+    pg[2] = 0;                      // npages: 마지막에 채움
+    pg[3] = 0;
+    PK_Put32(&pg[4], gen);
+    PK_Put32(&pg[8], base);
+    return pg;
 }
 
-HAL_StatusTypeDef DTC_LoadFromEEPROM(DTC_Ctx_t* ctx, DTC_Entry_t* e)
+HAL_StatusTypeDef DTC_PackTable(const DTC_Entry_t* list, uint16_t n, uint32_t gen, uint8_t* out, uint16_t* inoutLen)
 {
-    uint8_t cmd[3] = { EE_INS_READ, 0x00, 0x00 };
-    uint8_t rx[sizeof(DTC_Entry_t)] = {0};
+    uint16_t cap = *inoutLen;
+    uint16_t npages = 0;
+    uint8_t* pg = NULL;
+    uint32_t off = 0, prev = 0;
+
+    for (uint16_t i = 0; i < n || npages == 0u; i++) {
+        const DTC_Entry_t* e = (i < n) ? &list[i] : NULL;
+        uint32_t ts = e ? e->timestamp_ms : 0u;
+        uint32_t z = PK_ZigZag((int32_t)(ts - prev));
+        uint32_t age = e ? ts - e->first_ms : 0u;
+        uint32_t need = DTC_PK_REC_MIN + ((e && e->occurrence > 1u) ? PK_VarintLen(age) : 0u);
+
+        if (pg == NULL || off + need + PK_VarintLen(z) > PK_PAYLOAD_END) {
+            if ((uint32_t)(npages + 1u) * DTC_PK_PAGE_SIZE > cap || npages >= 0xFFu) return HAL_ERROR;
+            pg = PK_OpenPage(out, npages++, gen, ts);
+            off = DTC_PK_HDR_SIZE;
+        }
+        if (e == NULL) break;       // 빈 테이블: header 만 있는 page 1개
 
-    if (HAL_SPI_Transmit(ctx->hspi, cmd, 3, HAL_MAX_DELAY) != HAL_OK) return HAL_ERROR;
-    if (HAL_SPI_Receive(ctx->hspi, rx, sizeof(rx), HAL_MAX_DELAY) != HAL_OK) return HAL_ERROR;
+        pg[off++] = e->rec.dtc[0];
+        pg[off++] = e->rec.dtc[1];
+        pg[off++] = e->rec.dtc[2];
+        pg[off++] = e->rec.status;
+        pg[off++] = e->occurrence;
+        if (pg[3] != 0u) off += PK_PutVarint(&pg[off], z);
+        if (e->occurrence > 1u) off += PK_PutVarint(&pg[off], age);
+        pg[3]++;
+        prev = ts;
+    }
 
-    memcpy(e, rx, sizeof(DTC_Entry_t));
-    /* CRC 검증 필요 시 상위에서 DTC_CalcCRC32 호출 */
+    for (uint16_t p = 0; p < npages; p++) {
+        pg = &out[p * DTC_PK_PAGE_SIZE];
+        pg[2] = (uint8_t)npages;
+        uint16_t crc = DTC_CalcCRC16(pg, PK_PAYLOAD_END);
+        pg[PK_PAYLOAD_END]      = (uint8_t)crc;
+        pg[PK_PAYLOAD_END + 1u] = (uint8_t)(crc >> 8);
+    }
+    *inoutLen = (uint16_t)(npages * DTC_PK_PAGE_SIZE);
     return HAL_OK;
 }
 
+HAL_StatusTypeDef DTC_UnpackTable(const uint8_t* in, uint16_t len, DTC_Entry_t* list, uint16_t* inoutCount, uint32_t* gen)
+{
+    uint16_t cap = *inoutCount, n = 0;
+
+    if (len < DTC_PK_PAGE_SIZE || in[0] != DTC_PK_VERSION) return HAL_ERROR;
+    uint8_t npages = in[2];
+    uint32_t g = PK_Get32(&in[4]);
+    if (npages == 0u || (uint32_t)npages * DTC_PK_PAGE_SIZE > len) return HAL_ERROR;
+
+    for (uint8_t p = 0; p < npages; p++) {
+        const uint8_t* pg = &in[p * DTC_PK_PAGE_SIZE];
+        uint16_t crc = (uint16_t)(pg[PK_PAYLOAD_END] | (pg[PK_PAYLOAD_END + 1u] << 8));
+
+        if (pg[0] != DTC_PK_VERSION || pg[1] != p || pg[2] != npages || PK_Get32(&pg[4]) != g) return HAL_ERROR;
+        if (crc != DTC_CalcCRC16(pg, PK_PAYLOAD_END)) return HAL_ERROR;
+
+        uint32_t ts = PK_Get32(&pg[8]);
+        uint32_t off = DTC_PK_HDR_SIZE;
+        for (uint8_t r = 0; r < pg[3]; r++) {
+            const uint8_t* rec = &pg[off];
+            uint32_t z, age;
+
+            if (off + DTC_PK_REC_MIN > PK_PAYLOAD_END) return HAL_ERROR;
+            off += DTC_PK_REC_MIN;
+            if (r != 0u) {
+                if (!PK_GetVarint(pg, &off, &z)) return HAL_ERROR;
+                ts += (uint32_t)PK_UnZigZag(z);
+            }
+            age = 0;
+            if (rec[4] > 1u && !PK_GetVarint(pg, &off, &age)) return HAL_ERROR;
+            if (n < cap) {
+                DTC_Entry_t* e = &list[n++];
+                e->rec.dtc[0] = rec[0];
+                e->rec.dtc[1] = rec[1];
+                e->rec.dtc[2] = rec[2];
+                e->rec.status = rec[3];
+                e->occurrence = rec[4];
+                e->timestamp_ms = ts;
+                e->first_ms = ts - age;
+                e->crc32 = 0;
+            }
+        }
+    }
+    if (gen) *gen = g;
+    *inoutCount = n;
+    return HAL_OK;
+}
@@ -0,0 +1,357 @@
+/*
+ * DTCMem.c
+ *
+ *  DTC 메모리: EEPROM index + A/B bank 기반 부팅 mount + RAM 테이블 (DTCMem.h 참조)
+ */
+
+#include "DTCMem.h"
+#include "BusMgr.h"
+#include <string.h>
+
+DTCMem_t dtcMem;
+
+/* mount/scan/상세 로드/Flush 공용 버퍼 (UDSTask 전용). scan 은 두 bank 를 한 번에 */
+static uint8_t     ioBuf[2u * DTCMEM_BANK_SIZE];
+static uint8_t     idxImage[DTCMEM_INDEX_SIZE];
+static DTC_Entry_t entries[DTCMEM_SLOTS];
+
+static void DTCMem_Put32(uint8_t* p, uint32_t v)
+{
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t DTCMem_Get32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void DTCMem_Init(DTCMem_t* m, int8_t busDev)
+{
+    memset(m, 0, sizeof(*m));
+    m->dev = busDev;
+    m->lock = osMutexNew(NULL);
+}
+
+/* ===== 직렬화 ===== */
+
+HAL_StatusTypeDef DTCMem_EncodeBank(const DTCMem_t* m, uint32_t gen, uint8_t* out, uint16_t* inoutLen)
+{
+    uint16_t n = 0;
+
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        const DTCMem_Slot_t* s = &m->slot[i];
+        if (!s->used) continue;
+        DTC_Entry_t* e = &entries[n++];
+        memset(e, 0, sizeof(*e));
+        memcpy(e->rec.dtc, s->dtc, 3);
+        e->rec.status = s->status;
+        e->occurrence = s->occurrence;
+        e->first_ms = s->first_ms;
+        e->timestamp_ms = s->last_ms;
+    }
+    return DTC_PackTable(entries, n, gen, out, inoutLen);
+}
+
+void DTCMem_EncodeIndex(const DTCMem_t* m, uint8_t bank, uint32_t gen, uint8_t npages,
+                        uint8_t out[DTCMEM_INDEX_SIZE])
+{
+    uint32_t bitmap = 0;
+    uint8_t count = 0, summary = 0;
+
+    memset(out, 0xFF, DTCMEM_INDEX_SIZE);
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        const DTCMem_Slot_t* s = &m->slot[i];
+        if (!s->used) continue;
+        bitmap |= 1u << i;
+        count++;
+        summary |= s->status;
+        memcpy(&out[16u + 4u * i], s->dtc, 3);
+        out[16u + 4u * i + 3u] = s->status;
+    }
+    out[0] = DTCMEM_IDX_VERSION;
+    out[1] = bank;
+    DTCMem_Put32(&out[2], gen);
+    DTCMem_Put32(&out[6], bitmap);
+    out[10] = count;
+    out[11] = summary;
+    out[12] = npages;
+    uint16_t crc = DTC_CalcCRC16(out, DTCMEM_INDEX_SIZE - 2u);
+    out[DTCMEM_INDEX_SIZE - 2u] = (uint8_t)(crc >> 8);
+    out[DTCMEM_INDEX_SIZE - 1u] = (uint8_t)crc;
+}
+
+/* index → slot 요약 + 커밋된 bank. 버전/CRC/bank/bitmap-count 중 하나라도 어긋나면 HAL_ERROR */
+static HAL_StatusTypeDef DTCMem_DecodeIndex(const uint8_t* in, DTCMem_Slot_t* slots, DTCMem_t* m)
+{
+    if (in[0] != DTCMEM_IDX_VERSION) return HAL_ERROR;
+    uint16_t crc = (uint16_t)((in[DTCMEM_INDEX_SIZE - 2u] << 8) | in[DTCMEM_INDEX_SIZE - 1u]);
+    if (crc != DTC_CalcCRC16(in, DTCMEM_INDEX_SIZE - 2u)) return HAL_ERROR;
+    if (in[1] > 1u || in[12] == 0u || in[12] > DTC_PK_MAX_PAGES) return HAL_ERROR;
+
+    uint32_t bitmap = DTCMem_Get32(&in[6]);
+    uint8_t count = 0, summary = 0;
+    if ((bitmap >> DTCMEM_SLOTS) != 0u) return HAL_ERROR;
+
+    memset(slots, 0, DTCMEM_SLOTS * sizeof(*slots));
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        if (!((bitmap >> i) & 1u)) continue;
+        slots[i].used = 1;
+        memcpy(slots[i].dtc, &in[16u + 4u * i], 3);
+        slots[i].status = in[16u + 4u * i + 3u];
+        count++;
+        summary |= slots[i].status;
+    }
+    if (count != in[10] || summary != in[11]) return HAL_ERROR;
+    m->bank = in[1];
+    m->gen = DTCMem_Get32(&in[2]);
+    m->npages = in[12];
+    return HAL_OK;
+}
+
+/* ===== mount ===== */
+
+/* 두 bank 를 한 번에 읽어 유효한 최신 gen 으로 재구성, index 는 다음 Flush 에서 재작성 */
+static HAL_StatusTypeDef DTCMem_Scan(DTCMem_t* m)
+{
+    DTCMem_Slot_t tmp[DTCMEM_SLOTS];
+    uint32_t gen[2] = { 0, 0 };
+    uint8_t valid[2] = { 0, 0 };
+    uint16_t n = 0;
+
+    m->mount_reads++;
+    m->mount_bytes += sizeof(ioBuf);
+    HAL_StatusTypeDef st = BusMgr_Read(m->dev, DTCMEM_BANK_A, ioBuf, sizeof(ioBuf));
+    if (st != HAL_OK) { m->errors++; return st; }
+
+    for (uint8_t b = 0; b < 2u; b++) {
+        uint16_t none = 0;      // 검사만
+        valid[b] = DTC_UnpackTable(&ioBuf[b * DTCMEM_BANK_SIZE], DTCMEM_BANK_SIZE, NULL, &none, &gen[b]) == HAL_OK;
+    }
+    // 둘 다 유효하면 gen 이 앞선 쪽 (wrap 고려). 둘 다 무효면 빈 테이블, 다음 기록은 A
+    uint8_t bank = (valid[1] && (!valid[0] || (int32_t)(gen[1] - gen[0]) > 0)) ? 1u : 0u;
+
+    memset(tmp, 0, sizeof(tmp));
+    if (valid[bank]) {
+        n = DTCMEM_SLOTS;
+        (void)DTC_UnpackTable(&ioBuf[bank * DTCMEM_BANK_SIZE], DTCMEM_BANK_SIZE, entries, &n, NULL);
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        tmp[i].used = 1;
+        memcpy(tmp[i].dtc, entries[i].rec.dtc, 3);
+        tmp[i].status = entries[i].rec.status;
+        tmp[i].occurrence = entries[i].occurrence;
+        tmp[i].first_ms = entries[i].first_ms;
+        tmp[i].last_ms = entries[i].timestamp_ms;
+    }
+
+    osMutexAcquire(m->lock, osWaitForever);
+    memcpy(m->slot, tmp, sizeof(tmp));
+    m->bank = valid[bank] ? bank : 1u;
+    m->gen = valid[bank] ? gen[bank] : 0u;
+    m->npages = valid[bank] ? ioBuf[bank * DTCMEM_BANK_SIZE + 2u] : 0u;
+    m->details = 1;
+    m->idx_dirty = 1;
+    m->path = DTCMEM_PATH_SCAN;
+    m->ready = 1;
+    osMutexRelease(m->lock);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef DTCMem_Mount(DTCMem_t* m)
+{
+    DTCMem_Slot_t tmp[DTCMEM_SLOTS];
+
+    m->mount_reads = 1;
+    m->mount_bytes = DTCMEM_INDEX_SIZE;
+    HAL_StatusTypeDef st = BusMgr_Read(m->dev, DTCMEM_INDEX_ADDR, idxImage, DTCMEM_INDEX_SIZE);
+    if (st == HAL_OK) {
+        osMutexAcquire(m->lock, osWaitForever);
+        if (DTCMem_DecodeIndex(idxImage, tmp, m) == HAL_OK) {
+            memcpy(m->slot, tmp, sizeof(tmp));
+            m->path = DTCMEM_PATH_INDEX;
+            m->ready = 1;
+        }
+        osMutexRelease(m->lock);
+        if (m->ready) return HAL_OK;
+    }
+    return DTCMem_Scan(m);
+}
+
+/* index mount 이후: 커밋된 bank 를 한 번의 burst → 발생 횟수/시각 병합.
+ * bank 가 index 와 다르면 (gen/CRC/DTC 불일치) RAM(index) 내용으로 다시 커밋 */
+HAL_StatusTypeDef DTCMem_LoadDetails(DTCMem_t* m)
+{
+    uint32_t gen = 0;
+    uint16_t n = DTCMEM_SLOTS;
+
+    if (!m->ready) return HAL_BUSY;
+    if (m->details) return HAL_OK;
+
+    uint16_t len = (uint16_t)(m->npages * DTC_PK_PAGE_SIZE);
+    HAL_StatusTypeDef st = BusMgr_Read(m->dev, DTCMEM_BANK_ADDR(m->bank), ioBuf, len);
+    if (st != HAL_OK) { m->errors++; return st; }
+    if (DTC_UnpackTable(ioBuf, len, entries, &n, &gen) != HAL_OK || gen != m->gen) n = 0;
+
+    osMutexAcquire(m->lock, osWaitForever);
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        DTCMem_Slot_t* s = &m->slot[i];
+        const DTC_Entry_t* stored = NULL;
+        if (!s->used) continue;
+        for (uint16_t k = 0; k < n && stored == NULL; k++) {
+            if (memcmp(entries[k].rec.dtc, s->dtc, 3) == 0) stored = &entries[k];
+        }
+        if (stored != NULL) {
+            uint32_t occ = (uint32_t)stored->occurrence + s->occurrence;
+            s->occurrence = (uint8_t)((occ > 255u) ? 255u : occ);
+            s->first_ms = stored->first_ms;
+            if (s->last_ms == 0u) s->last_ms = stored->timestamp_ms;
+        } else {
+            m->mismatches++;
+            m->dirty |= 1u << i;
+        }
+    }
+    m->details = 1;
+    osMutexRelease(m->lock);
+    return HAL_OK;
+}
+
+bool DTCMem_Ready(const DTCMem_t* m)
+{
+    return m->ready != 0u;
+}
+
+/* ===== RAM 테이블 ===== */
+
+HAL_StatusTypeDef DTCMem_Report(DTCMem_t* m, const uint8_t dtc3[3], bool failed)
+{
+    DTCMem_Slot_t* s = NULL;
+    DTCMem_Slot_t* freeSlot = NULL;
+
+    if (!m->ready) return HAL_BUSY;
+
+    osMutexAcquire(m->lock, osWaitForever);
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        if (m->slot[i].used && memcmp(m->slot[i].dtc, dtc3, 3) == 0) { s = &m->slot[i]; break; }
+        if (!m->slot[i].used && freeSlot == NULL) freeSlot = &m->slot[i];
+    }
+    if (s == NULL) {
+        // 저장된 적 없는 DTC 의 통과 결과는 기록할 것이 없음
+        if (!failed) { osMutexRelease(m->lock); return HAL_OK; }
+        if (freeSlot == NULL) { m->full++; osMutexRelease(m->lock); return HAL_ERROR; }
+        s = freeSlot;
+        memset(s, 0, sizeof(*s));
+        s->used = 1;
+        memcpy(s->dtc, dtc3, 3);
+        s->status = DTC_ST_TNCSLC | DTC_ST_TNCTOC;
+    }
+
+    DTC_Record_t r = { .dtc = { s->dtc[0], s->dtc[1], s->dtc[2] }, .status = s->status };
+    DTC_UpdateStatus(&r, failed);
+    if (failed && !(s->status & DTC_ST_TF)) {
+        uint32_t now = osKernelGetTickCount();
+        if (s->occurrence < 255u) s->occurrence++;
+        if (s->first_ms == 0u) s->first_ms = now;
+        s->last_ms = now;
+        m->dirty |= 1u << (uint32_t)(s - m->slot);
+    }
+    if (r.status != s->status) {
+        s->status = r.status;
+        m->dirty |= 1u << (uint32_t)(s - m->slot);
+    }
+    osMutexRelease(m->lock);
+    return HAL_OK;
+}
+
+void DTCMem_Clear(DTCMem_t* m)
+{
+    osMutexAcquire(m->lock, osWaitForever);
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        if (!m->slot[i].used) continue;
+        memset(&m->slot[i], 0, sizeof(m->slot[i]));
+        m->dirty |= 1u << i;
+    }
+    osMutexRelease(m->lock);
+}
+
+uint16_t DTCMem_CountByMask(DTCMem_t* m, uint8_t mask)
+{
+    return DTCMem_ReadByMask(m, mask, NULL, 0);
+}
+
+uint16_t DTCMem_ReadByMask(DTCMem_t* m, uint8_t mask, DTC_Record_t* out, uint16_t max)
+{
+    uint16_t n = 0;
+
+    mask &= DTCMEM_STATUS_AVAIL;
+    osMutexAcquire(m->lock, osWaitForever);
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        const DTCMem_Slot_t* s = &m->slot[i];
+        if (!s->used || (s->status & mask) == 0u) continue;
+        if (n < max) {
+            memcpy(out[n].dtc, s->dtc, 3);
+            out[n].status = s->status & DTCMEM_STATUS_AVAIL;
+        }
+        n++;
+    }
+    osMutexRelease(m->lock);
+    return n;
+}
+
+/* ===== EEPROM 기록 ===== */
+
+bool DTCMem_Pending(DTCMem_t* m)
+{
+    return m->ready && (m->dirty != 0u || m->idx_dirty);
+}
+
+HAL_StatusTypeDef DTCMem_Flush(DTCMem_t* m)
+{
+    uint16_t len = DTCMEM_BANK_SIZE;
+    HAL_StatusTypeDef st = HAL_OK;
+
+    if (!m->details) {
+        st = DTCMem_LoadDetails(m);
+        if (st != HAL_OK) return st;
+    }
+
+    /* 테이블 스냅샷 → lock 해제 후 기록 (그 사이 Report 는 다음 Flush 로).
+     * 커밋된 bank 는 건드리지 않고 반대편에 gen+1, index 가 새 bank 를 가리키는 순간이 커밋.
+     * 테이블 변경 없이 index 만 무효였으면 (scan 직후) 유효한 bank 를 그대로 가리키는 index 만 기록 */
+    osMutexAcquire(m->lock, osWaitForever);
+    uint32_t mask = m->dirty;
+    if (mask == 0u && !m->idx_dirty) { osMutexRelease(m->lock); return HAL_OK; }
+    uint8_t bank = m->bank;
+    uint32_t gen = m->gen;
+    if (mask == 0u && m->npages != 0u) {
+        len = 0;
+    } else {
+        bank ^= 1u;
+        gen++;
+        if (DTCMem_EncodeBank(m, gen, ioBuf, &len) != HAL_OK) st = HAL_ERROR;
+    }
+    uint8_t npages = (len != 0u) ? (uint8_t)(len / DTC_PK_PAGE_SIZE) : m->npages;
+    DTCMem_EncodeIndex(m, bank, gen, npages, idxImage);
+    m->dirty = 0u;
+    m->idx_dirty = 0;
+    osMutexRelease(m->lock);
+
+    if (st == HAL_OK && len != 0u) st = BusMgr_Write(m->dev, DTCMEM_BANK_ADDR(bank), ioBuf, len);
+    if (st == HAL_OK) {
+        m->page_writes += len / DTC_PK_PAGE_SIZE;
+        st = BusMgr_Write(m->dev, DTCMEM_INDEX_ADDR, idxImage, DTCMEM_INDEX_SIZE);
+    }
+    if (st == HAL_OK) {
+        m->bank = bank;
+        m->gen = gen;
+        m->npages = npages;
+        m->index_writes++;
+    } else {
+        // index 가 깨졌을 수 있음 → 다음 부팅은 scan (이전 bank 는 유효), 실행 중에는 같은 bank 로 재시도
+        osMutexAcquire(m->lock, osWaitForever);
+        m->dirty |= mask;
+        m->idx_dirty = 1;
+        m->errors++;
+        osMutexRelease(m->lock);
+    }
+    return st;
+}
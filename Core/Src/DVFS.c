@@ -0,0 +1,194 @@
+/*
+ * DVFS.c
+ *
+ *  동작점 거버너 (DVFS.h 참조)
+ */
+
+#include "DVFS.h"
+#include "PMIC.h"
+#include "SupplyMon.h"
+#include "Trace.h"
+
+#define DVFS_PLL_M     8u
+
+/* F413 (2.7~3.6V) FLASH: 0WS ≤25MHz, 1WS ≤50MHz, 2WS ≤75MHz */
+const DVFS_Opp_t DVFS_OppTable[DVFS_OPP_COUNT] = {
+    [DVFS_OPP_LOW]  = { "low",  16000000u, 0,   0, 0, RCC_HCLK_DIV1, FLASH_LATENCY_0,  900 },
+    [DVFS_OPP_MID]  = { "mid",  32000000u, 1, 128, 8, RCC_HCLK_DIV2, FLASH_LATENCY_1, 1000 },
+    [DVFS_OPP_HIGH] = { "high", 64000000u, 1, 128, 4, RCC_HCLK_DIV4, FLASH_LATENCY_2, 1100 },
+};
+
+DVFS_State_t dvfs;
+
+void DVFS_Init(void)
+{
+    dvfs = (DVFS_State_t){ 0 };
+    dvfs.cur = DVFS_OPP_LOW;        // SystemClock_Config 와 동일
+    dvfs.forced = -1;
+    dvfs.vcore_pending = 1;         // 부팅 시 Buck A 값은 PMIC 기본값 → 첫 주기에 맞춤
+
+    /* 코어 레일은 read-back 검증 + 램프 */
+    PMIC_ShadowConfig(&pmicShadow, 1, DVFS_VRAMP_STEP_LSB);
+}
+
+void DVFS_SetDemand(uint8_t src, uint8_t active)
+{
+    if (active) dvfs.demand |= src;
+    else        dvfs.demand &= (uint8_t)~src;
+}
+
+void DVFS_NotifyCanFrame(void)
+{
+    dvfs.can_frames++;
+}
+
+void DVFS_Force(int8_t opp)
+{
+    dvfs.forced = (opp >= 0 && opp < DVFS_OPP_COUNT) ? opp : -1;
+}
+
+/* 정책: 올림은 즉시, 내림은 DOWN_HOLD 동안 요구가 낮게 유지된 경우만 */
+uint8_t DVFS_Decide(DVFS_State_t* s, uint32_t canFps, uint32_t elapsedMs)
+{
+    uint8_t want = DVFS_OPP_LOW;
+
+    if (s->forced >= 0) return (uint8_t)s->forced;
+
+    if (canFps >= DVFS_CAN_MID_FPS) want = DVFS_OPP_MID;
+    if (canFps >= DVFS_CAN_HIGH_FPS || s->demand != 0u) want = DVFS_OPP_HIGH;
+
+    if (want >= s->cur) {
+        s->down_hold_ms = 0;
+        return want;
+    }
+    s->down_hold_ms += elapsedMs;
+    if (s->down_hold_ms >= DVFS_DOWN_HOLD_MS) {
+        s->down_hold_ms = 0;
+        return want;
+    }
+    return s->cur;
+}
+
+/* Buck A 를 목표까지 램프 (step 사이 1 tick 대기) */
+static HAL_StatusTypeDef DVFS_SetVcore(uint16_t mV)
+{
+    uint16_t v[PMIC_VOUT_COUNT] = { mV, 0, 0, 0 };
+
+    if (PMIC_BuckSetTargets(&pmicShadow, v, 0x01u) != HAL_OK) return HAL_ERROR;
+    while (PMIC_BuckPending(&pmicShadow) & 0x01u) {
+        osDelay(1);
+        if (PMIC_BuckStep(&pmicShadow) != HAL_OK) return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+/* SYSCLK 전환. HAL 은 SYSCLK 로 사용 중인 PLL 을 재설정하지 않으므로 HSI 경유 */
+static HAL_StatusTypeDef DVFS_SetClock(const DVFS_Opp_t* from, const DVFS_Opp_t* to)
+{
+    RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+    RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+                                | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+
+    if (from->use_pll) {
+        RCC_ClkInitStruct.SYSCLKSource   = RCC_SYSCLKSOURCE_HSI;
+        RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+        RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+        if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, from->flash_latency) != HAL_OK) return HAL_ERROR;
+    }
+
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    if (to->use_pll) {
+        RCC_OscInitStruct.PLL.PLLState  = RCC_PLL_ON;
+        RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+        RCC_OscInitStruct.PLL.PLLM      = DVFS_PLL_M;
+        RCC_OscInitStruct.PLL.PLLN      = to->pll_n;
+        RCC_OscInitStruct.PLL.PLLP      = to->pll_p;
+        RCC_OscInitStruct.PLL.PLLQ      = 8;
+        RCC_OscInitStruct.PLL.PLLR      = 2;
+        if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) return HAL_ERROR;
+        RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    } else {
+        RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+        if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) return HAL_ERROR;
+        RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+    }
+    RCC_ClkInitStruct.APB1CLKDivider = to->apb_div;
+    RCC_ClkInitStruct.APB2CLKDivider = to->apb_div;
+    if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, to->flash_latency) != HAL_OK) return HAL_ERROR;
+
+    SupplyMon_OnClockChange();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef DVFS_Apply(uint8_t target)
+{
+    const DVFS_Opp_t* from = &DVFS_OppTable[dvfs.cur];
+    const DVFS_Opp_t* to;
+    HAL_StatusTypeDef st = HAL_OK;
+    uint32_t t0 = osKernelGetTickCount();
+
+    if (target >= DVFS_OPP_COUNT) return HAL_ERROR;
+    to = &DVFS_OppTable[target];
+    if (target == dvfs.cur && !dvfs.vcore_pending) return HAL_OK;
+
+    osMutexAcquire(CommMutexHandle, osWaitForever);   // I2C1 (PMIC) 공유
+
+    if (target == dvfs.cur) {
+        /* 지난 하강에서 못 내린 전압 재시도 */
+        st = DVFS_SetVcore(to->vcore_mV);
+        if (st == HAL_OK) dvfs.vcore_pending = 0;
+    } else if (to->sysclk_hz > from->sysclk_hz) {
+        /* 올림: 전압 먼저. 실패하면 클럭 유지 */
+        st = DVFS_SetVcore(to->vcore_mV);
+        if (st == HAL_OK) st = DVFS_SetClock(from, to);
+        if (st == HAL_OK) { dvfs.cur = target; dvfs.vcore_pending = 0; }
+    } else {
+        /* 내림: 클럭 먼저. 전압 실패는 안전 측(높은 전압)이므로 재시도만 */
+        st = DVFS_SetClock(from, to);
+        if (st == HAL_OK) {
+            dvfs.cur = target;
+            dvfs.vcore_pending = (DVFS_SetVcore(to->vcore_mV) != HAL_OK);
+            if (dvfs.vcore_pending) st = HAL_ERROR;
+        }
+    }
+
+    osMutexRelease(CommMutexHandle);
+
+    if (st != HAL_OK) {
+        dvfs.failures++;
+    } else if (from != to) {
+        dvfs.transitions++;
+        dvfs.last_switch_ms = osKernelGetTickCount() - t0;
+        if (dvfs.last_switch_ms > dvfs.max_switch_ms) dvfs.max_switch_ms = dvfs.last_switch_ms;
+        TRACE(TRACE_EV_DVFS_SWITCH, (uint16_t)(((uint16_t)(from - DVFS_OppTable) << 8) | target));
+    }
+    return st;
+}
+
+void StartDvfsTask(void *argument)
+{
+    uint32_t last = osKernelGetTickCount();
+
+    for (;;)
+    {
+        osDelay(DVFS_PERIOD_MS);
+
+        uint32_t now = osKernelGetTickCount();
+        uint32_t elapsed = now - last;
+        last = now;
+        dvfs.residency_ms[dvfs.cur] += elapsed;
+
+        /* 평가 주기 내 CAN 프레임 수 → 프레임/s */
+        __disable_irq();
+        uint32_t frames = dvfs.can_frames;
+        dvfs.can_frames = 0;
+        __enable_irq();
+        int32_t fps = (elapsed != 0u) ? (int32_t)(frames * 1000u / elapsed) : 0;
+        dvfs.can_fps = (uint32_t)((int32_t)dvfs.can_fps + ((fps - (int32_t)dvfs.can_fps) >> DVFS_CAN_EMA_SHIFT));
+
+        (void)DVFS_Apply(DVFS_Decide(&dvfs, dvfs.can_fps, elapsed));
+    }
+}
@@ -0,0 +1,228 @@
+/*
+ * EECache.c
+ *
+ *  25LC256 write-back 캐시 (EECache.h 참조)
+ */
+
+#include "EECache.h"
+#include "BusMgr.h"
+#include <string.h>
+
+EECache_t eeCache;
+
+static uint64_t EECache_Mask(uint32_t off, uint32_t n)
+{
+    return ((n >= 64u) ? ~0ull : ((1ull << n) - 1u)) << off;
+}
+
+void EECache_Init(EECache_t* c, int8_t busDev)
+{
+    memset(c, 0, sizeof(*c));
+    c->dev = busDev;
+    c->lock = osMutexNew(NULL);
+}
+
+/* page line 찾기/할당. 호출자가 lock 보유 */
+static EECache_Line_t* EECache_Line(EECache_t* c, uint16_t page, uint8_t alloc)
+{
+    EECache_Line_t* victim = NULL;
+
+    for (uint32_t i = 0; i < EECACHE_LINES; i++) {
+        if (c->line[i].used && c->line[i].page == page) return &c->line[i];
+    }
+    if (!alloc) return NULL;
+
+    /* 빈 line → 가장 오래된 clean line */
+    for (uint32_t i = 0; i < EECACHE_LINES; i++) {
+        EECache_Line_t* l = &c->line[i];
+        if (!l->used) { victim = l; break; }
+        if (l->dirty == 0u && !l->busy && (victim == NULL || (int32_t)(l->lru - victim->lru) < 0)) victim = l;
+    }
+    if (victim == NULL) return NULL;
+
+    memset(victim, 0, sizeof(*victim));
+    victim->used = 1;
+    victim->page = page;
+    return victim;
+}
+
+HAL_StatusTypeDef EECache_Write(EECache_t* c, uint16_t addr, const uint8_t* data, uint16_t len)
+{
+    uint8_t kick = 0;
+
+    if ((uint32_t)addr + len > EEPROM_SIZE_BYTES) return HAL_ERROR;
+
+    osMutexAcquire(c->lock, osWaitForever);
+    c->writes++;
+    while (len > 0u) {
+        uint16_t off = (uint16_t)(addr % EEPROM_PAGE_SIZE);
+        uint16_t n = (uint16_t)(EEPROM_PAGE_SIZE - off);
+        if (n > len) n = len;
+
+        EECache_Line_t* l = EECache_Line(c, (uint16_t)(addr / EEPROM_PAGE_SIZE), 1);
+        if (l == NULL) {
+            c->full++;
+            osMutexRelease(c->lock);
+            EECache_RequestFlush(c);
+            return HAL_BUSY;
+        }
+        if (l->dirty == 0u) {
+            l->deadline = osKernelGetTickCount() + EECACHE_FLUSH_DELAY_MS;
+            kick = 1;
+        } else {
+            c->coalesced++;
+        }
+        memcpy(&l->data[off], data, n);
+        l->valid |= EECache_Mask(off, n);
+        l->dirty |= EECache_Mask(off, n);
+        l->lru = ++c->lru_clock;
+
+        addr = (uint16_t)(addr + n);
+        data += n;
+        len = (uint16_t)(len - n);
+    }
+    osMutexRelease(c->lock);
+
+    if (kick && c->thread != NULL) osThreadFlagsSet(c->thread, EECACHE_FLAG_KICK);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef EECache_Peek(EECache_t* c, uint16_t addr, uint8_t* buf, uint16_t len)
+{
+    HAL_StatusTypeDef st = HAL_OK;
+
+    osMutexAcquire(c->lock, osWaitForever);
+    while (len > 0u && st == HAL_OK) {
+        uint16_t off = (uint16_t)(addr % EEPROM_PAGE_SIZE);
+        uint16_t n = (uint16_t)(EEPROM_PAGE_SIZE - off);
+        if (n > len) n = len;
+
+        EECache_Line_t* l = EECache_Line(c, (uint16_t)(addr / EEPROM_PAGE_SIZE), 0);
+        if (l == NULL || (l->valid & EECache_Mask(off, n)) != EECache_Mask(off, n)) {
+            st = HAL_ERROR;
+        } else {
+            memcpy(buf, &l->data[off], n);
+            l->lru = ++c->lru_clock;
+        }
+        addr = (uint16_t)(addr + n);
+        buf += n;
+        len = (uint16_t)(len - n);
+    }
+    if (st == HAL_OK) c->peek_hits++;
+    else              c->peek_misses++;
+    osMutexRelease(c->lock);
+    return st;
+}
+
+HAL_StatusTypeDef EECache_Read(EECache_t* c, uint16_t addr, uint8_t* buf, uint16_t len)
+{
+    HAL_StatusTypeDef st = BusMgr_Read(c->dev, addr, buf, len);
+    if (st != HAL_OK) return st;
+
+    /* 아직 기록되지 않은(또는 더 최신인) 캐시 값 우선 */
+    osMutexAcquire(c->lock, osWaitForever);
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t a = (uint16_t)(addr + i);
+        EECache_Line_t* l = EECache_Line(c, (uint16_t)(a / EEPROM_PAGE_SIZE), 0);
+        if (l != NULL && (l->valid >> (a % EEPROM_PAGE_SIZE)) & 1u) buf[i] = l->data[a % EEPROM_PAGE_SIZE];
+    }
+    osMutexRelease(c->lock);
+    return HAL_OK;
+}
+
+void EECache_RequestFlush(EECache_t* c)
+{
+    if (c->thread == NULL) return;
+    osThreadFlagsSet(c->thread, EECACHE_FLAG_FORCE);
+}
+
+uint32_t EECache_DirtyLines(EECache_t* c)
+{
+    uint32_t n = 0;
+    osMutexAcquire(c->lock, osWaitForever);
+    for (uint32_t i = 0; i < EECACHE_LINES; i++) {
+        if (c->line[i].dirty != 0u || c->line[i].busy) n++;
+    }
+    osMutexRelease(c->lock);
+    return n;
+}
+
+/* ===== flush ===== */
+
+/* line 하나: dirty 스냅샷 → lock 해제 → 연속 dirty 구간마다 page write */
+static HAL_StatusTypeDef EECache_FlushLine(EECache_t* c, EECache_Line_t* l)
+{
+    uint8_t  snap[EEPROM_PAGE_SIZE];
+    uint64_t mask = l->dirty;
+    uint16_t base = (uint16_t)(l->page * EEPROM_PAGE_SIZE);
+    HAL_StatusTypeDef st = HAL_OK;
+
+    memcpy(snap, l->data, sizeof(snap));
+    l->dirty = 0u;
+    l->busy = 1;
+    osMutexRelease(c->lock);
+
+    for (uint32_t i = 0; i < EEPROM_PAGE_SIZE && st == HAL_OK; ) {
+        if (!((mask >> i) & 1u)) { i++; continue; }
+        uint32_t j = i;
+        while (j < EEPROM_PAGE_SIZE && ((mask >> j) & 1u)) j++;
+        st = BusMgr_Write(c->dev, (uint16_t)(base + i), &snap[i], (uint16_t)(j - i));
+        c->dev_writes++;
+        i = j;
+    }
+
+    osMutexAcquire(c->lock, osWaitForever);
+    l->busy = 0;
+    if (st != HAL_OK) {
+        c->flush_errors++;
+        if (l->dirty == 0u) l->deadline = osKernelGetTickCount() + EECACHE_FLUSH_DELAY_MS;
+        l->dirty |= mask;       // line 내용이 최신이므로 다시 기록하면 된다
+    }
+    return st;
+}
+
+/* 기한이 지난(force 면 전부) line 기록. 반환: 다음 기한까지 남은 tick (없으면 osWaitForever) */
+static uint32_t EECache_FlushDue(EECache_t* c, uint8_t force)
+{
+    uint32_t wait = osWaitForever;
+
+    osMutexAcquire(c->lock, osWaitForever);
+    for (uint8_t again = 1; again; ) {
+        again = 0;
+        uint32_t now = osKernelGetTickCount();
+        for (uint32_t i = 0; i < EECACHE_LINES; i++) {
+            EECache_Line_t* l = &c->line[i];
+            if (!l->used || l->busy || l->dirty == 0u) continue;
+            if (force || (int32_t)(now - l->deadline) >= 0) {
+                // lock 을 잠시 놓으므로 처음부터 다시 훑음. 실패 시 이번 회차는 중단 (기한 뒤 재시도)
+                again = (EECache_FlushLine(c, l) == HAL_OK);
+                break;
+            }
+        }
+    }
+    uint32_t now = osKernelGetTickCount();
+    for (uint32_t i = 0; i < EECACHE_LINES; i++) {
+        EECache_Line_t* l = &c->line[i];
+        if (!l->used || l->dirty == 0u) continue;
+        uint32_t left = (uint32_t)(l->deadline - now);
+        if ((int32_t)left <= 0) left = 1;
+        if (wait == osWaitForever || left < wait) wait = left;
+    }
+    osMutexRelease(c->lock);
+    return wait;
+}
+
+void StartEECacheTask(void *argument)
+{
+    EECache_t* c = &eeCache;
+    uint32_t wait = osWaitForever;
+
+    c->thread = osThreadGetId();
+    for (;;)
+    {
+        uint32_t f = osThreadFlagsWait(EECACHE_FLAG_KICK | EECACHE_FLAG_FORCE, osFlagsWaitAny, wait);
+        uint8_t force = ((f & osFlagsError) == 0u) && (f & EECACHE_FLAG_FORCE);
+        if (force) c->forced++;
+        wait = EECache_FlushDue(c, force);
+    }
+}
@@ -6,6 +6,7 @@
  */
 
 #include "EEPROM.h"
+#include "BusRec.h"
 
 /* ========================================
  * Write Enable (Datasheet p.6)
@@ -67,6 +68,8 @@ HAL_StatusTypeDef EEPROM_WriteData(SPI_HandleTypeDef *hspi, uint16_t addr, uint8
     ret = HAL_SPI_Transmit(hspi, data, len, HAL_MAX_DELAY);
     if (ret != HAL_OK) return ret;
 
+    BUSREC(BusRec_BusOf(hspi), BUSREC_OP_WR, BUSREC_SPI_ID(BUSDEV_EEPROM, addr), data, len);
+
     /* 쓰기 완료 대기 */
     return EEPROM_WaitForWrite(hspi);
 }
@@ -87,6 +90,8 @@ HAL_StatusTypeDef EEPROM_ReadData(SPI_HandleTypeDef *hspi, uint16_t addr, uint8_
     if (ret != HAL_OK) return ret;
 
     /* 데이터 수신 */
-    return HAL_SPI_Receive(hspi, data, len, HAL_MAX_DELAY);
+    ret = HAL_SPI_Receive(hspi, data, len, HAL_MAX_DELAY);
+    if (ret == HAL_OK) BUSREC(BusRec_BusOf(hspi), BUSREC_OP_RD, BUSREC_SPI_ID(BUSDEV_EEPROM, addr), data, len);
+    return ret;
 }
 
@@ -0,0 +1,276 @@
+/*
+ * FlashLog.c
+ *
+ *  SPI NOR flash 로그 저장소 (FlashLog.h 참조)
+ */
+
+#include "FlashLog.h"
+#include "DTC.h"
+#include "BusMgr.h"
+#include <string.h>
+
+FlashLog_t flashLog;
+SpiFlash_t spiFlash;
+
+/* 마운트 시 head sector 통째 읽기 / append 조립용 (LogTask 전용) */
+static uint8_t scanBuf[SPIFLASH_SECTOR_SIZE];
+static uint8_t recBuf[FLASHLOG_MAX_PAYLOAD + FLASHLOG_REC_OVERHEAD];
+static uint8_t iterBuf[FLASHLOG_MAX_PAYLOAD + FLASHLOG_REC_OVERHEAD];
+
+static void     put32(uint8_t* p, uint32_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24); }
+static uint32_t get32(const uint8_t* p)       { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static uint32_t FlashLog_RecSize(uint16_t len)
+{
+    return (FLASHLOG_REC_OVERHEAD + len + 3u) & ~3u;
+}
+
+static uint32_t FlashLog_SectorAddr(const FlashLog_t* log, uint32_t sector)
+{
+    return log->base + sector * SPIFLASH_SECTOR_SIZE;
+}
+
+typedef struct {
+    uint32_t seq;
+    uint32_t first_rec;
+    uint32_t erase_count;
+} FlashLog_SectorHdr_t;
+
+/* 머리 읽기: 유효하면 1 */
+static int FlashLog_ReadSectorHdr(FlashLog_t* log, uint32_t sector, FlashLog_SectorHdr_t* h, HAL_StatusTypeDef* st)
+{
+    uint8_t raw[FLASHLOG_SECTOR_HDR];
+
+    *st = SpiFlash_Read(log->fl, FlashLog_SectorAddr(log, sector), raw, sizeof(raw));
+    if (*st != HAL_OK) return 0;
+    if (get32(&raw[0]) != FLASHLOG_SECTOR_MAGIC) return 0;
+    if (get32(&raw[16]) != DTC_CalcCRC32(raw, 16)) return 0;
+    h->seq = get32(&raw[4]);
+    h->first_rec = get32(&raw[8]);
+    h->erase_count = get32(&raw[12]);
+    return 1;
+}
+
+/* sector 소거 후 머리 기록 → head 로 전환 */
+static HAL_StatusTypeDef FlashLog_OpenSector(FlashLog_t* log, uint32_t sector, uint32_t seq)
+{
+    FlashLog_SectorHdr_t old;
+    uint8_t raw[FLASHLOG_SECTOR_HDR];
+    HAL_StatusTypeDef st;
+    uint32_t erases = 0;
+
+    if (FlashLog_ReadSectorHdr(log, sector, &old, &st)) erases = old.erase_count;
+    if (st != HAL_OK) return st;
+
+    st = SpiFlash_EraseSector(log->fl, FlashLog_SectorAddr(log, sector));
+    if (st != HAL_OK) return st;
+
+    put32(&raw[0], FLASHLOG_SECTOR_MAGIC);
+    put32(&raw[4], seq);
+    put32(&raw[8], log->next_rec);
+    put32(&raw[12], erases + 1u);
+    put32(&raw[16], DTC_CalcCRC32(raw, 16));
+    st = SpiFlash_Program(log->fl, FlashLog_SectorAddr(log, sector), raw, sizeof(raw));
+    if (st != HAL_OK) return st;
+
+    log->head = sector;
+    log->head_seq = seq;
+    log->head_off = FLASHLOG_SECTOR_HDR;
+    return HAL_OK;
+}
+
+/* 머리가 남아 있는 sector 를 모두 소거 (이미 소거된 sector 는 건너뜀) 후 sector 0 부터 시작 */
+HAL_StatusTypeDef FlashLog_Format(FlashLog_t* log)
+{
+    FlashLog_SectorHdr_t h;
+    HAL_StatusTypeDef st;
+
+    for (uint32_t i = 1; i < log->sectors; i++) {
+        if (FlashLog_ReadSectorHdr(log, i, &h, &st)) st = SpiFlash_EraseSector(log->fl, FlashLog_SectorAddr(log, i));
+        if (st != HAL_OK) return st;
+    }
+    log->tail = 0;
+    log->next_rec = 1;
+    log->mounted = 0;
+    st = FlashLog_OpenSector(log, 0, 1);
+    log->mounted = (st == HAL_OK);
+    return st;
+}
+
+/* record 가 완전한지 (머리 + CRC). 머리부터 깨졌으면 *torn_hdr = 1 */
+static int FlashLog_CheckRec(const uint8_t* p, uint32_t room, uint16_t* len, uint8_t* torn_hdr)
+{
+    uint16_t l;
+
+    *torn_hdr = 0;
+    if (room < FLASHLOG_REC_OVERHEAD || p[0] != FLASHLOG_REC_MAGIC) { *torn_hdr = 1; return 0; }
+    l = (uint16_t)(p[2] | (p[3] << 8));
+    if (l > FLASHLOG_MAX_PAYLOAD || FlashLog_RecSize(l) > room) { *torn_hdr = 1; return 0; }
+    *len = l;
+    return get32(&p[8u + l]) == DTC_CalcCRC32(&p[1], 7u + l);
+}
+
+HAL_StatusTypeDef FlashLog_Mount(FlashLog_t* log, SpiFlash_t* fl, uint32_t base, uint32_t sectors)
+{
+    FlashLog_SectorHdr_t h, head = { 0 }, tail = { 0 };
+    HAL_StatusTypeDef st;
+    int found = 0;
+
+    memset(log, 0, sizeof(*log));
+    log->fl = fl;
+    log->base = base;
+    log->sectors = sectors;
+    if (sectors < 2u || base % SPIFLASH_SECTOR_SIZE || base + sectors * SPIFLASH_SECTOR_SIZE > fl->size) return HAL_ERROR;
+
+    /* 1) sector 머리: 최대 seq = head, 최소 seq = tail */
+    for (uint32_t i = 0; i < sectors; i++) {
+        if (!FlashLog_ReadSectorHdr(log, i, &h, &st)) {
+            if (st != HAL_OK) return st;
+            continue;
+        }
+        if (!found || (int32_t)(h.seq - head.seq) > 0) { head = h; log->head = i; }
+        if (!found || (int32_t)(h.seq - tail.seq) < 0) { tail = h; log->tail = i; }
+        found = 1;
+    }
+    if (!found) return FlashLog_Format(log);
+
+    log->head_seq = head.seq;
+    log->next_rec = head.first_rec;
+
+    /* 2) head sector 스캔: 기록 끝 위치와 마지막 record seq */
+    st = SpiFlash_Read(fl, FlashLog_SectorAddr(log, log->head), scanBuf, SPIFLASH_SECTOR_SIZE);
+    if (st != HAL_OK) return st;
+
+    uint32_t off = FLASHLOG_SECTOR_HDR;
+    while (off + FLASHLOG_REC_OVERHEAD <= SPIFLASH_SECTOR_SIZE && scanBuf[off] != 0xFFu) {
+        uint16_t len = 0;
+        uint8_t tornHdr;
+        if (FlashLog_CheckRec(&scanBuf[off], SPIFLASH_SECTOR_SIZE - off, &len, &tornHdr)) {
+            log->next_rec = get32(&scanBuf[off + 4u]) + 1u;
+        } else {
+            log->torn++;
+            if (tornHdr) { off = SPIFLASH_SECTOR_SIZE; break; }   // 이후 위치를 알 수 없음 → sector 닫음
+        }
+        off += FlashLog_RecSize(len);
+    }
+    log->head_off = off;
+    log->mounted = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef FlashLog_Append(FlashLog_t* log, uint8_t type, const void* data, uint16_t len)
+{
+    uint32_t size = FlashLog_RecSize(len);
+    HAL_StatusTypeDef st;
+
+    if (!log->mounted || len > FLASHLOG_MAX_PAYLOAD || (data == NULL && len != 0u)) return HAL_ERROR;
+
+    if (log->head_off + size > SPIFLASH_SECTOR_SIZE) {
+        uint32_t next = (log->head + 1u) % log->sectors;
+        if (next == log->tail) {
+            log->tail = (log->tail + 1u) % log->sectors;     // 가장 오래된 sector 를 버림
+            log->dropped_sectors++;
+        }
+        st = FlashLog_OpenSector(log, next, log->head_seq + 1u);
+        if (st != HAL_OK) return st;
+    }
+
+    memset(recBuf, 0xFF, size);
+    recBuf[0] = FLASHLOG_REC_MAGIC;
+    recBuf[1] = type;
+    recBuf[2] = (uint8_t)len;
+    recBuf[3] = (uint8_t)(len >> 8);
+    put32(&recBuf[4], log->next_rec);
+    if (len != 0u) memcpy(&recBuf[8], data, len);
+    put32(&recBuf[8u + len], DTC_CalcCRC32(&recBuf[1], 7u + len));
+
+    st = SpiFlash_Program(log->fl, FlashLog_SectorAddr(log, log->head) + log->head_off, recBuf,
+                          FLASHLOG_REC_OVERHEAD + len);
+    log->head_off += size;      // 실패해도 부분 기록 가능성 → 그 자리는 다시 쓰지 않음
+    if (st != HAL_OK) return st;
+
+    log->next_rec++;
+    log->appended++;
+    return HAL_OK;
+}
+
+void FlashLog_IterBegin(const FlashLog_t* log, FlashLog_Iter_t* it)
+{
+    it->sector = log->tail;
+    it->off = FLASHLOG_SECTOR_HDR;
+    it->visited = 0;
+}
+
+HAL_StatusTypeDef FlashLog_IterNext(FlashLog_t* log, FlashLog_Iter_t* it, uint8_t* type, uint32_t* seq,
+                                    uint8_t* buf, uint16_t bufLen, uint16_t* len)
+{
+    FlashLog_SectorHdr_t h;
+    HAL_StatusTypeDef st;
+
+    while (it->visited < log->sectors) {
+        uint32_t end = (it->sector == log->head) ? log->head_off : SPIFLASH_SECTOR_SIZE;
+
+        if (it->off == FLASHLOG_SECTOR_HDR && !FlashLog_ReadSectorHdr(log, it->sector, &h, &st)) {
+            if (st != HAL_OK) return st;
+            end = 0;            // 머리가 없는 sector (소거 직후 전원 차단 등)
+        }
+
+        while (it->off + FLASHLOG_REC_OVERHEAD <= end) {
+            uint8_t* p = iterBuf;
+            uint32_t room = end - it->off;
+            uint32_t n = (room < sizeof(iterBuf)) ? room : sizeof(iterBuf);
+            uint16_t l = 0;
+            uint8_t tornHdr;
+
+            st = SpiFlash_Read(log->fl, FlashLog_SectorAddr(log, it->sector) + it->off, p, n);
+            if (st != HAL_OK) return st;
+            if (p[0] == 0xFFu) break;
+
+            int ok = FlashLog_CheckRec(p, room, &l, &tornHdr);
+            if (tornHdr) break;
+            it->off += FlashLog_RecSize(l);
+            if (!ok) { log->torn++; continue; }
+
+            *type = p[1];
+            *seq = get32(&p[4]);
+            *len = l;
+            memcpy(buf, &p[8], (l < bufLen) ? l : bufLen);
+            return HAL_OK;
+        }
+
+        if (it->sector == log->head) break;
+        it->sector = (it->sector + 1u) % log->sectors;
+        it->off = FLASHLOG_SECTOR_HDR;
+        it->visited++;
+    }
+    return HAL_ERROR;
+}
+
+/* ===== LogTask ===== */
+void FlashLog_Post(uint8_t type, const void* data, uint8_t len)
+{
+    FlashLog_Msg_t m;
+
+    if (LogQueueHandle == NULL || len > FLASHLOG_MSG_DATA) return;
+    m.type = type;
+    m.len = len;
+    memcpy(m.data, data, len);
+    if (osMessageQueuePut(LogQueueHandle, &m, 0, 0) != osOK) flashLog.queue_drops++;
+}
+
+void StartLogTask(void *argument)
+{
+    FlashLog_Msg_t m;
+    int8_t dev = BusMgr_Find("flash0");
+
+    /* flash 가 없거나 마운트 실패 시 큐만 비운다 (DTC 는 EEPROM 경로가 유지) */
+    if (SpiFlash_Init(&spiFlash, dev) == HAL_OK) {
+        (void)FlashLog_Mount(&flashLog, &spiFlash, FLASHLOG_BASE, FLASHLOG_SECTORS);
+    }
+
+    for (;;)
+    {
+        if (osMessageQueueGet(LogQueueHandle, &m, NULL, osWaitForever) != osOK) continue;
+        if (flashLog.mounted) (void)FlashLog_Append(&flashLog, m.type, m.data, m.len);
+    }
+}
@@ -0,0 +1,242 @@
+/*
+ * IsoTp.c
+ *
+ *  ISO 15765-2 분할/재조립 (IsoTp.h 참조)
+ */
+
+#include "IsoTp.h"
+#include <string.h>
+
+/* ===== DLC ===== */
+
+static const uint8_t isoTpDlcLen[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+
+uint8_t IsoTp_DlcToLen(uint8_t dlc)
+{
+    return isoTpDlcLen[dlc & 0x0Fu];
+}
+
+uint8_t IsoTp_LenToDlc(uint8_t len)
+{
+    uint8_t dlc = 0;
+    while (dlc < 15u && isoTpDlcLen[dlc] < len) dlc++;
+    return dlc;
+}
+
+uint8_t IsoTp_PadLen(uint8_t len)
+{
+    return (len <= ISOTP_FRAME_LEN) ? ISOTP_FRAME_LEN : isoTpDlcLen[IsoTp_LenToDlc(len)];
+}
+
+static uint8_t IsoTp_TxDl(const IsoTp_Link_t* l)
+{
+    return (l->tx_dl == 0u) ? ISOTP_FRAME_LEN : l->tx_dl;
+}
+
+/* ===== 프레임 판별 ===== */
+
+uint8_t IsoTp_SingleData(const uint8_t* frame, uint8_t len, const uint8_t** data)
+{
+    if (len < 2u || (frame[0] & 0xF0u) != ISOTP_PCI_SF) return 0;
+    if (len <= ISOTP_FRAME_LEN) {
+        uint8_t n = frame[0] & 0x0Fu;
+        if (n == 0u || n > len - 1u) return 0;
+        *data = &frame[1];
+        return n;
+    }
+    // CAN FD: escape SF (8B 를 넘는 프레임은 항상 escape)
+    if (frame[0] != 0u || frame[1] == 0u || frame[1] > len - 2u) return 0;
+    *data = &frame[2];
+    return frame[1];
+}
+
+uint8_t IsoTp_FrameType(const uint8_t* frame, uint8_t len)
+{
+    const uint8_t* d;
+
+    if (len == 0u) return 0xFFu;
+    uint8_t type = frame[0] & 0xF0u;
+
+    switch (type) {
+    case ISOTP_PCI_SF:
+        return (IsoTp_SingleData(frame, len, &d) != 0u) ? type : 0xFFu;
+    case ISOTP_PCI_FF: {
+        if (len < ISOTP_FRAME_LEN) return 0xFFu;
+        uint16_t ffdl = (uint16_t)(((frame[0] & 0x0Fu) << 8) | frame[1]);
+        if (ffdl == 0u) return type;            // escape FF (32 비트 길이): 수신 시 OVFLW
+        // 같은 프레임 길이의 SF 로 보낼 수 있는 길이의 FF 는 무효
+        return (ffdl > ((len == ISOTP_FRAME_LEN) ? ISOTP_SF_MAX : len - 2u)) ? type : 0xFFu;
+    }
+    case ISOTP_PCI_CF:
+        return type;
+    case ISOTP_PCI_FC:
+        return (len >= 3u) ? type : 0xFFu;
+    default:
+        return 0xFFu;
+    }
+}
+
+/* ===== 송신 ===== */
+
+/* 메일박스가 빌 때까지 1 tick 간격 재시도 (N_As) */
+static HAL_StatusTypeDef IsoTp_SendFrame(IsoTp_Link_t* l, const uint8_t* frame, uint8_t len)
+{
+    for (uint32_t ms = 0; ms < ISOTP_N_AS_MS; ms++) {
+        if (l->send(frame, len) == HAL_OK) return HAL_OK;
+        osDelay(1);
+    }
+    l->timeouts++;
+    return HAL_TIMEOUT;
+}
+
+/* from 이후를 패딩 → 프레임 길이 */
+static uint8_t IsoTp_Pad(uint8_t* frame, uint32_t from)
+{
+    uint8_t len = IsoTp_PadLen((uint8_t)from);
+    for (uint32_t i = from; i < len; i++) frame[i] = ISOTP_PAD_BYTE;
+    return len;
+}
+
+static HAL_StatusTypeDef IsoTp_SendFlowControl(IsoTp_Link_t* l, uint8_t fs)
+{
+    uint8_t fc[ISOTP_FRAME_LEN];
+
+    fc[0] = (uint8_t)(ISOTP_PCI_FC | fs);
+    fc[1] = 0;                  // BS: 블록 제한 없음
+    fc[2] = 0;                  // STmin 0
+    return IsoTp_SendFrame(l, fc, IsoTp_Pad(fc, 3));
+}
+
+/* ===== 수신 ===== */
+
+HAL_StatusTypeDef IsoTp_Receive(IsoTp_Link_t* l, const uint8_t* first, uint8_t flen, uint8_t* buf, uint16_t max, uint16_t* len)
+{
+    uint8_t type = IsoTp_FrameType(first, flen);
+    const uint8_t* d;
+
+    if (type == ISOTP_PCI_SF) {
+        uint8_t n = IsoTp_SingleData(first, flen, &d);
+        if (n > max) return HAL_ERROR;
+        memcpy(buf, d, n);
+        *len = n;
+        l->rx_msgs++;
+        return HAL_OK;
+    }
+    if (type != ISOTP_PCI_FF) return HAL_ERROR;
+
+    uint16_t total = (uint16_t)(((first[0] & 0x0Fu) << 8) | first[1]);
+    if (total == 0u || total > max) {
+        l->overflows++;
+        (void)IsoTp_SendFlowControl(l, ISOTP_FC_OVFLW);
+        return HAL_ERROR;
+    }
+    if (IsoTp_SendFlowControl(l, ISOTP_FC_CTS) != HAL_OK) return HAL_TIMEOUT;
+
+    // RX_DL = FF 프레임 길이: CF 데이터는 RX_DL - 1 (마지막 CF 만 짧을 수 있음)
+    uint16_t pos = (uint16_t)(flen - 2u);
+    uint8_t cf_data = (uint8_t)(flen - 1u);
+    uint8_t sn = 1;
+    memcpy(buf, &first[2], pos);
+    while (pos < total) {
+        uint8_t f[ISOTP_FRAME_MAX];
+        uint8_t flen2;
+        if (l->recv(f, &flen2, ISOTP_N_CR_MS) != HAL_OK) {
+            l->timeouts++;
+            return HAL_TIMEOUT;
+        }
+        uint8_t t = IsoTp_FrameType(f, flen2);
+        if (t == ISOTP_PCI_SF || t == ISOTP_PCI_FF) {
+            // 새 요청: 진행 중인 재조립은 버리고 새 요청을 처리
+            memcpy(l->held, f, flen2);
+            l->held_len = flen2;
+            l->held_valid = 1;
+            return HAL_ERROR;
+        }
+        if (t != ISOTP_PCI_CF) continue;
+        uint16_t n = (uint16_t)(total - pos);
+        if (n > cf_data) n = cf_data;
+        if ((f[0] & 0x0Fu) != sn || flen2 < 1u + n) {
+            l->seq_errors++;
+            return HAL_ERROR;
+        }
+        memcpy(&buf[pos], &f[1], n);
+        pos = (uint16_t)(pos + n);
+        sn = (uint8_t)((sn + 1u) & 0x0Fu);
+    }
+    *len = total;
+    l->rx_msgs++;
+    return HAL_OK;
+}
+
+uint16_t IsoTp_FirstFrame(const IsoTp_Link_t* l, const uint8_t* buf, uint16_t len, uint8_t* frame, uint8_t* flen)
+{
+    uint8_t dl = IsoTp_TxDl(l);
+
+    if (len <= ISOTP_SF_MAX) {
+        frame[0] = (uint8_t)len;
+        memcpy(&frame[1], buf, len);
+        *flen = IsoTp_Pad(frame, 1u + len);
+        return len;
+    }
+    if (len <= dl - 2u) {
+        // CAN FD escape SF
+        frame[0] = 0;
+        frame[1] = (uint8_t)len;
+        memcpy(&frame[2], buf, len);
+        *flen = IsoTp_Pad(frame, 2u + len);
+        return len;
+    }
+    frame[0] = (uint8_t)(ISOTP_PCI_FF | ((len >> 8) & 0x0Fu));
+    frame[1] = (uint8_t)len;
+    memcpy(&frame[2], buf, dl - 2u);
+    *flen = dl;
+    return (uint16_t)(dl - 2u);
+}
+
+/* STmin → tick 수 (100~900us 는 1 tick, 예약 값은 최대 127ms 로 취급) */
+static uint32_t IsoTp_StMinMs(uint8_t st)
+{
+    if (st <= 0x7Fu) return st;
+    if (st >= 0xF1u && st <= 0xF9u) return 1u;
+    return 0x7Fu;
+}
+
+HAL_StatusTypeDef IsoTp_SendRest(IsoTp_Link_t* l, const uint8_t* buf, uint16_t len, uint16_t pos)
+{
+    uint8_t frame[ISOTP_FRAME_MAX];
+    uint8_t flen;
+    uint8_t cf_data = (uint8_t)(IsoTp_TxDl(l) - 1u);
+    uint8_t sn = 1;
+
+    while (pos < len) {
+        uint32_t wft = 0;
+        for (;;) {
+            if (l->recv(frame, &flen, ISOTP_N_BS_MS) != HAL_OK) {
+                l->timeouts++;
+                return HAL_TIMEOUT;
+            }
+            if (IsoTp_FrameType(frame, flen) != ISOTP_PCI_FC) continue;   // 반이중: 송신 중 다른 프레임은 무시
+            uint8_t fs = frame[0] & 0x0Fu;
+            if (fs == ISOTP_FC_CTS) break;
+            if (fs == ISOTP_FC_WAIT && ++wft <= ISOTP_WFT_MAX) continue;
+            if (fs == ISOTP_FC_OVFLW) l->overflows++;
+            return HAL_ERROR;
+        }
+
+        uint8_t  bs = frame[1];
+        uint32_t st = IsoTp_StMinMs(frame[2]);
+        for (uint32_t blk = 0; pos < len && (bs == 0u || blk < bs); blk++) {
+            // tick 경계에서 깨어날 수 있으므로 +1 tick 으로 STmin 이상 보장
+            if (blk != 0u && st != 0u) osDelay(st + 1u);
+            uint16_t n = (uint16_t)(len - pos);
+            if (n > cf_data) n = cf_data;
+            frame[0] = (uint8_t)(ISOTP_PCI_CF | sn);
+            memcpy(&frame[1], &buf[pos], n);
+            if (IsoTp_SendFrame(l, frame, IsoTp_Pad(frame, 1u + n)) != HAL_OK) return HAL_TIMEOUT;
+            pos = (uint16_t)(pos + n);
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+        }
+    }
+    l->tx_msgs++;
+    return HAL_OK;
+}
@@ -0,0 +1,260 @@
+/*
+ * Mpu.c
+ *
+ *  MPU 로 Task 간 메모리 격리 (Mpu.h 참조)
+ */
+
+#include "Mpu.h"
+#include "DTCMem.h"
+#include "EECache.h"
+#include "Task.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+#define MPU_PENDING    0x4D505550u   // "MPUP": DTC 보고 대기
+#define MPU_IDLE       0x4D505549u   // "MPUI": 기록 유효, 보고 완료
+
+#define MPU_AP_RW      0x3u          // 읽기/쓰기
+#define MPU_AP_RO      0x6u          // 읽기 전용 (privileged 포함)
+
+/* 리셋을 넘어 유지 (.noinit). StackMon 기록과 같은 방식 */
+typedef struct {
+    uint32_t magic;
+    uint32_t faults;
+    uint32_t addr;
+    char     task[16];
+} Mpu_Crash_t;
+
+#ifdef HOST_BUILD
+static Mpu_Crash_t mpuCrash;
+#else
+static Mpu_Crash_t mpuCrash __attribute__((section(".noinit")));
+#endif
+
+Mpu_State_t mpuState;
+
+static Mpu_Region_t mpuLayout[MPU_SWITCH_REGIONS];
+static Mpu_Domain_t mpuDomain[MPU_DOM_COUNT];
+
+/* ===== 배치 / 인코딩 ===== */
+
+// 호스트도 non-PIE 라 정적 변수 주소가 32 bit 안에 있음
+static void Mpu_FillLayout(void)
+{
+    mpuLayout[0] = (Mpu_Region_t){ "dtcMem",  MPU_RGN_DTCMEM,  (uint32_t)(uintptr_t)&dtcMem,  MPU_DTCMEM_SIZE,  sizeof(dtcMem) };
+    mpuLayout[1] = (Mpu_Region_t){ "eeCache", MPU_RGN_EECACHE, (uint32_t)(uintptr_t)&eeCache, MPU_EECACHE_SIZE, sizeof(eeCache) };
+    mpuLayout[2] = (Mpu_Region_t){ "pipeBuf", MPU_RGN_PIPE,    (uint32_t)(uintptr_t)&pipeBuf, MPU_PIPE_SIZE,    sizeof(pipeBuf) };
+}
+
+const Mpu_Region_t* Mpu_Layout(uint32_t* count)
+{
+    Mpu_FillLayout();
+    if (count != NULL) *count = MPU_SWITCH_REGIONS;
+    return mpuLayout;
+}
+
+HAL_StatusTypeDef Mpu_CheckRegion(const Mpu_Region_t* r)
+{
+    if (r->region >= 8u) return HAL_ERROR;
+    if (r->size < 32u || (r->size & (r->size - 1u)) != 0u) return HAL_ERROR;
+    if ((r->base & (r->size - 1u)) != 0u) return HAL_ERROR;
+    // 남는 공간에 이웃 변수가 들어오면 그 변수까지 읽기 전용이 됨
+    if (r->obj_size != r->size) return HAL_ERROR;
+    return HAL_OK;
+}
+
+// SRAM 일반 메모리 (TEX=1 C=1 B=1: 기본 맵과 같은 WBWA), 실행 금지
+static uint32_t Mpu_Rasr(const Mpu_Region_t* r, uint32_t ap, uint8_t srd)
+{
+    uint32_t log2 = 31u - (uint32_t)__builtin_clz(r->size);
+    return (1u << MPU_RASR_XN_Pos) | (ap << MPU_RASR_AP_Pos) | (1u << MPU_RASR_TEX_Pos)
+         | (1u << MPU_RASR_C_Pos) | (1u << MPU_RASR_B_Pos) | ((uint32_t)srd << MPU_RASR_SRD_Pos)
+         | ((log2 - 1u) << MPU_RASR_SIZE_Pos) | MPU_RASR_ENABLE_Msk;
+}
+
+static void Mpu_Build(Mpu_DomainId_t dom, uint8_t storage, uint8_t slice)
+{
+    Mpu_Domain_t* d = &mpuDomain[dom];
+    for (uint32_t i = 0; i < MPU_SWITCH_REGIONS; i++) {
+        const Mpu_Region_t* r = &mpuLayout[i];
+        uint32_t ap = MPU_AP_RO;
+        uint8_t srd = 0;
+        if (dom == MPU_DOM_BOOT) ap = MPU_AP_RW;
+        else if (r->region == MPU_RGN_PIPE) srd = (slice != MPU_SLICE_NONE) ? (uint8_t)(1u << slice) : 0u;
+        else if (storage) ap = MPU_AP_RW;
+        d->regs[2u * i]      = r->base | MPU_RBAR_VALID_Msk | r->region;
+        d->regs[2u * i + 1u] = Mpu_Rasr(r, ap, srd);
+    }
+}
+
+// RBAR(VALID + region 번호) 가 region 을 고르므로 RBAR/RASR, A1, A2 에 연속 6 word store
+static void Mpu_Load(const Mpu_Domain_t* d)
+{
+    volatile uint32_t* dst = &MPU->RBAR;
+    dst[0] = d->regs[0];
+    dst[1] = d->regs[1];
+    dst[2] = d->regs[2];
+    dst[3] = d->regs[3];
+    dst[4] = d->regs[4];
+    dst[5] = d->regs[5];
+}
+
+/* ===== 초기화 / 전환 ===== */
+
+void Mpu_Init(void)
+{
+    if (mpuCrash.magic != MPU_PENDING && mpuCrash.magic != MPU_IDLE) {
+        memset(&mpuCrash, 0, sizeof(mpuCrash));
+        mpuCrash.magic = MPU_IDLE;
+    }
+    mpuCrash.task[sizeof(mpuCrash.task) - 1u] = '\0';
+    memset(&mpuState, 0, sizeof(mpuState));
+    mpuState.faults = mpuCrash.faults;
+    mpuState.fault_addr = mpuCrash.addr;
+    memcpy(mpuState.fault_task, mpuCrash.task, sizeof(mpuState.fault_task));
+
+    Mpu_FillLayout();
+    mpuState.layout_ok = 1u;
+    for (uint32_t i = 0; i < MPU_SWITCH_REGIONS; i++) {
+        if (Mpu_CheckRegion(&mpuLayout[i]) != HAL_OK) mpuState.layout_ok = 0u;
+    }
+    Mpu_Build(MPU_DOM_BOOT,    1u, MPU_SLICE_NONE);
+    Mpu_Build(MPU_DOM_DEFAULT, 0u, MPU_SLICE_NONE);
+    Mpu_Build(MPU_DOM_STORAGE, 1u, MPU_SLICE_NONE);
+    Mpu_Build(MPU_DOM_I2C,     1u, MPU_SLICE_I2C);
+    Mpu_Build(MPU_DOM_SPI,     1u, MPU_SLICE_SPI);
+    // 배치가 틀리면 켜지 않음 (보호 없이 동작하는 쪽이 이웃 변수를 잠그는 것보다 안전)
+    if (!mpuState.layout_ok) return;
+
+#ifndef HOST_BUILD
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;      // HardFault 대신 MemManage 로 (주소 확인 가능)
+#endif
+    Mpu_Load(&mpuDomain[MPU_DOM_BOOT]);
+    MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+    __DSB();
+    __ISB();
+    mpuState.enabled = 1u;
+}
+
+const Mpu_Domain_t* Mpu_Domain(Mpu_DomainId_t dom)
+{
+    return (dom < MPU_DOM_COUNT) ? &mpuDomain[dom] : NULL;
+}
+
+void Mpu_Attach(osThreadId_t thread, Mpu_DomainId_t dom)
+{
+    if (thread == NULL || dom >= MPU_DOM_COUNT) return;
+    vTaskSetApplicationTaskTag((TaskHandle_t)thread, (TaskHookFunction_t)(uintptr_t)&mpuDomain[dom]);
+}
+
+// PendSV 의 예외 복귀가 새 설정을 반영하므로 barrier 없음
+void Mpu_SwitchIn(void* tag)
+{
+    if (!mpuState.enabled) return;
+    Mpu_Load((tag != NULL) ? (const Mpu_Domain_t*)tag : &mpuDomain[MPU_DOM_DEFAULT]);
+}
+
+void Mpu_SetEnabled(uint8_t on)
+{
+    if (on && !mpuState.layout_ok) return;
+    taskENTER_CRITICAL();
+    if (on) {
+        void* tag = (void*)(uintptr_t)xTaskGetApplicationTaskTag(NULL);
+        Mpu_Load((tag != NULL) ? (const Mpu_Domain_t*)tag : &mpuDomain[MPU_DOM_DEFAULT]);
+        MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+    } else {
+        MPU->CTRL = 0u;
+    }
+    mpuState.enabled = on ? 1u : 0u;
+    __DSB();
+    __ISB();
+    taskEXIT_CRITICAL();
+}
+
+/* ===== 위반 기록 / DTC 보고 ===== */
+
+// MemManage 안: 커널 호출 없이 기록만 하고 리셋
+void Mpu_Fault(uint32_t addr)
+{
+    if (mpuCrash.magic != MPU_PENDING) {
+        const char* name = (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) ? "main" : pcTaskGetName(NULL);
+        mpuCrash.faults++;
+        mpuCrash.addr = addr;
+        strncpy(mpuCrash.task, name, sizeof(mpuCrash.task) - 1u);
+        mpuCrash.task[sizeof(mpuCrash.task) - 1u] = '\0';
+        mpuCrash.magic = MPU_PENDING;
+    }
+#ifndef HOST_BUILD
+    NVIC_SystemReset();
+#endif
+}
+
+void Mpu_Service(void)
+{
+    if (mpuCrash.magic != MPU_PENDING || !DTCMem_Ready(&dtcMem)) return;
+
+    const uint8_t dtc3[3] = { (uint8_t)(MPU_DTC_VIOLATION >> 16), (uint8_t)(MPU_DTC_VIOLATION >> 8), (uint8_t)MPU_DTC_VIOLATION };
+    if (DTCMem_Report(&dtcMem, dtc3, true) == HAL_OK) {
+        mpuState.faults = mpuCrash.faults;
+        mpuState.fault_addr = mpuCrash.addr;
+        memcpy(mpuState.fault_task, mpuCrash.task, sizeof(mpuState.fault_task));
+        mpuCrash.magic = MPU_IDLE;
+    }
+}
+
+/* ===== 전환 비용 벤치 ===== */
+
+#define MPU_BENCH_FLAG   (1u << 0)
+
+static osThreadId_t benchSelf, benchPeer;
+
+static void Mpu_BenchPeer(void* argument)
+{
+    (void)argument;
+    for (;;) {
+        (void)osThreadFlagsWait(MPU_BENCH_FLAG, osFlagsWaitAny, osWaitForever);
+        (void)osThreadFlagsSet(benchSelf, MPU_BENCH_FLAG);
+    }
+}
+
+// 왕복 1 회 = 전환 2 회 (→ peer 즉시 선점, peer 가 다시 대기하며 → 호출 Task)
+static void Mpu_BenchPingPong(void* ctx, uint32_t iters)
+{
+    (void)ctx;
+    while (iters--) {
+        (void)osThreadFlagsSet(benchPeer, MPU_BENCH_FLAG);
+        (void)osThreadFlagsWait(MPU_BENCH_FLAG, osFlagsWaitAny, osWaitForever);
+    }
+}
+
+void Mpu_RunSwitchBench(const Bench_Config_t* cfg)
+{
+    const osThreadAttr_t peerAttr = {
+        .name = "MpuBench", .stack_size = 128u * 4u, .priority = (osPriority_t)osPriorityRealtime1,
+    };
+    const Bench_Case_t off = { "ctxsw_mpu_off", Mpu_BenchPingPong, NULL, 2u };
+    const Bench_Case_t on  = { "ctxsw_mpu_on",  Mpu_BenchPingPong, NULL, 2u };
+
+    benchSelf = osThreadGetId();
+    osPriority_t prio = osThreadGetPriority(benchSelf);
+    (void)osThreadSetPriority(benchSelf, osPriorityRealtime);
+    benchPeer = osThreadNew(Mpu_BenchPeer, NULL, &peerAttr);
+    if (benchPeer != NULL) {
+        // 저장 서비스 구성: region 값만 다를 뿐 전환마다 같은 6 word store
+        Mpu_Attach(benchPeer, MPU_DOM_STORAGE);
+        uint8_t was = mpuState.enabled;
+        Bench_CounterInit();
+
+        Mpu_SetEnabled(0u);
+        Bench_RunCase(cfg, &off, NULL);
+        if (mpuState.layout_ok) {
+            Mpu_SetEnabled(1u);
+            Bench_RunCase(cfg, &on, NULL);
+        }
+        Mpu_SetEnabled(was);
+        (void)osThreadTerminate(benchPeer);
+    }
+    (void)osThreadSetPriority(benchSelf, prio);
+}
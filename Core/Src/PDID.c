@@ -0,0 +1,177 @@
+/*
+ * PDID.c
+ *
+ *  0x2A periodic DID 스케줄러 (PDID.h 참조)
+ */
+
+#include "PDID.h"
+#include "UDS_CAN.h"
+
+PDID_Sched_t pdidSched;
+
+static void PDID_TimerCb(void *argument)
+{
+    PDID_Tick((PDID_Sched_t*)argument);
+}
+
+void PDID_Init(PDID_Sched_t* s, const DID_Table_t* table, HAL_StatusTypeDef (*send)(const uint8_t* frame))
+{
+    s->table = table;
+    s->send = send;
+    if (s->timer == NULL) s->timer = osTimerNew(PDID_TimerCb, osTimerPeriodic, s, NULL);
+}
+
+/* 주기 응답 가능: 읽기 가능, live 원본 (ISR 에서 읽음), 프레임 1 개에 들어감 */
+static const DID_Entry_t* PDID_Lookup(const PDID_Sched_t* s, uint8_t pdid)
+{
+    const DID_Entry_t* e = DID_Find(s->table, (uint16_t)(PDID_DID_BASE | pdid));
+
+    if (e == NULL || !(e->access & DID_ACC_READ) || e->live == NULL || e->len > PDID_DATA_MAX) return NULL;
+    return e;
+}
+
+static PDID_Slot_t* PDID_FindSlot(PDID_Sched_t* s, uint8_t pdid)
+{
+    for (uint32_t i = 0; i < PDID_MAX; i++) {
+        if (s->slot[i].e != NULL && s->slot[i].pdid == pdid) return &s->slot[i];
+    }
+    return NULL;
+}
+
+/* 대기열에 남은 index 가 있는 slot 은 재사용하지 않음 (대기열 길이 <= PDID_MAX 유지) */
+static PDID_Slot_t* PDID_FreeSlot(PDID_Sched_t* s)
+{
+    for (uint32_t i = 0; i < PDID_MAX; i++) {
+        if (s->slot[i].e == NULL && !s->slot[i].queued) return &s->slot[i];
+    }
+    return NULL;
+}
+
+static uint16_t PDID_PeriodTicks(uint8_t mode)
+{
+    if (mode == PDID_MODE_SLOW)   return PDID_RATE_SLOW_MS / PDID_TICK_MS;
+    if (mode == PDID_MODE_MEDIUM) return PDID_RATE_MEDIUM_MS / PDID_TICK_MS;
+    return PDID_RATE_FAST_MS / PDID_TICK_MS;
+}
+
+/* 대기열 → 메일박스 (인터럽트 금지 상태에서 호출). 데이터는 송신 직전 값 */
+static void PDID_Pump(PDID_Sched_t* s)
+{
+    uint8_t frame[ISOTP_FRAME_LEN];
+
+    while (s->q_head != s->q_tail) {
+        PDID_Slot_t* sl = &s->slot[s->q[s->q_head]];
+        if (sl->e != NULL) {
+            frame[0] = sl->pdid;
+            uint8_t n = DID_ReadData(sl->e, &frame[1]);
+            for (uint32_t i = 1u + n; i < ISOTP_FRAME_LEN; i++) frame[i] = ISOTP_PAD_BYTE;
+            if (s->send(frame) != HAL_OK) return;       // 다음 TX 완료에서 이어서
+            s->sent++;
+        }
+        sl->queued = 0;                                 // 해제된 slot 은 버림
+        s->q_head = (uint16_t)((s->q_head + 1u) % (PDID_MAX + 1u));
+    }
+}
+
+void PDID_Tick(PDID_Sched_t* s)
+{
+    s->ticks++;
+    __disable_irq();
+    for (uint32_t i = 0; i < PDID_MAX; i++) {
+        PDID_Slot_t* sl = &s->slot[i];
+        if (sl->e == NULL || --sl->countdown != 0u) continue;
+        sl->countdown = sl->period;
+        if (sl->queued) {
+            s->late++;
+            continue;
+        }
+        sl->queued = 1;
+        s->q[s->q_tail] = (uint8_t)i;
+        s->q_tail = (uint16_t)((s->q_tail + 1u) % (PDID_MAX + 1u));
+    }
+    PDID_Pump(s);
+    __enable_irq();
+}
+
+void PDID_TxDoneFromISR(PDID_Sched_t* s)
+{
+    if (s->send != NULL) PDID_Pump(s);
+}
+
+static void PDID_Release(PDID_Sched_t* s, PDID_Slot_t* sl)
+{
+    sl->e = NULL;
+    sl->mode = 0;
+    s->used--;
+}
+
+static void PDID_UpdateTimer(PDID_Sched_t* s)
+{
+    if (s->used == 0u) {
+        (void)osTimerStop(s->timer);
+        for (uint32_t i = 0; i < 3u; i++) s->phase[i] = 0;
+    } else if (!osTimerIsRunning(s->timer)) {
+        (void)osTimerStart(s->timer, PDID_TICK_MS);
+    }
+}
+
+void PDID_StopAll(PDID_Sched_t* s)
+{
+    if (s->used == 0u) return;
+    __disable_irq();
+    for (uint32_t i = 0; i < PDID_MAX; i++) {
+        if (s->slot[i].e != NULL) PDID_Release(s, &s->slot[i]);
+    }
+    __enable_irq();
+    PDID_UpdateTimer(s);
+}
+
+uint8_t PDID_Request(PDID_Sched_t* s, const uint8_t* req, uint16_t len)
+{
+    uint8_t mode = req[0];
+
+    if (mode == PDID_MODE_STOP) {
+        // pDID 가 없으면 전부, 예약되지 않은 pDID 는 무시
+        if (len == 1u) {
+            PDID_StopAll(s);
+            return 0;
+        }
+        __disable_irq();
+        for (uint16_t i = 1; i < len; i++) {
+            PDID_Slot_t* sl = PDID_FindSlot(s, req[i]);
+            if (sl != NULL) PDID_Release(s, sl);
+        }
+        __enable_irq();
+        PDID_UpdateTimer(s);
+        return 0;
+    }
+    if (mode < PDID_MODE_SLOW || mode > PDID_MODE_FAST) return UDS_NRC_REQUEST_OUT_OF_RANGE;
+    if (len < 2u) return UDS_NRC_INCORRECT_LENGTH;
+
+    // 전부 검사한 뒤 적용 (일부만 예약되지 않도록). 요청 안의 중복은 넉넉하게 셈
+    uint16_t need = 0;
+    for (uint16_t i = 1; i < len; i++) {
+        if (PDID_Lookup(s, req[i]) == NULL) return UDS_NRC_REQUEST_OUT_OF_RANGE;
+        if (PDID_FindSlot(s, req[i]) == NULL) need++;
+    }
+    if (s->used + need > PDID_MAX) return UDS_NRC_REQUEST_OUT_OF_RANGE;
+
+    uint16_t period = PDID_PeriodTicks(mode);
+    for (uint16_t i = 1; i < len; i++) {
+        __disable_irq();
+        PDID_Slot_t* sl = PDID_FindSlot(s, req[i]);
+        if (sl == NULL && (sl = PDID_FreeSlot(s)) != NULL) s->used++;
+        if (sl != NULL) {
+            sl->e = PDID_Lookup(s, req[i]);
+            sl->pdid = req[i];
+            sl->mode = mode;
+            sl->period = period;
+            // 같은 주기 DID 의 첫 만기를 tick 마다 하나씩 (1 ~ period)
+            sl->countdown = (uint16_t)(1u + s->phase[mode - 1u] % period);
+            s->phase[mode - 1u]++;
+        }
+        __enable_irq();
+    }
+    PDID_UpdateTimer(s);
+    return 0;
+}
@@ -6,29 +6,57 @@
  */
 
 #include "PMIC.h"
+#include "BusRec.h"
 #include <string.h>
 
+PMIC_Shadow_t pmicShadow;
+
+/* 연속 레지스터 burst 읽기 (레지스터 포인터 auto-increment) */
+HAL_StatusTypeDef PMIC_ReadRange(I2C_HandleTypeDef *hi2c, uint8_t firstReg, uint8_t *data, uint16_t count)
+{
+    HAL_StatusTypeDef st = HAL_I2C_Mem_Read(hi2c,
+                                            I2C_SLAVE_ADDRESS,
+                                            firstReg,
+                                            I2C_MEMADD_SIZE_8BIT,
+                                            data,
+                                            count,
+                                            PMIC_I2C_TIMEOUT_MS);
+    if (st == HAL_OK) BUSREC(BusRec_BusOf(hi2c), BUSREC_OP_RD, BUSREC_I2C_ID(I2C_SLAVE_ADDRESS, firstReg), data, count);
+    return st;
+}
+
+/* 연속 레지스터 burst 쓰기 */
+HAL_StatusTypeDef PMIC_WriteRange(I2C_HandleTypeDef *hi2c, uint8_t firstReg, const uint8_t *data, uint16_t count)
+{
+    HAL_StatusTypeDef st = HAL_I2C_Mem_Write(hi2c,
+                                             I2C_SLAVE_ADDRESS,
+                                             firstReg,
+                                             I2C_MEMADD_SIZE_8BIT,
+                                             (uint8_t *)data,
+                                             count,
+                                             PMIC_I2C_TIMEOUT_MS);
+    if (st == HAL_OK) BUSREC(BusRec_BusOf(hi2c), BUSREC_OP_WR, BUSREC_I2C_ID(I2C_SLAVE_ADDRESS, firstReg), data, count);
+    return st;
+}
+
 /* 단일 Fault 레지스터 읽기 */
 HAL_StatusTypeDef PMIC_ReadFaultRegister(I2C_HandleTypeDef *hi2c,
                                          PMIC_Register_t reg,
                                          uint8_t *data)
 {
-    return HAL_I2C_Mem_Read(hi2c,
-    						MP5475_I2C_ADDR_7bit,
-                            reg,
-                            I2C_MEMADD_SIZE_8BIT,
-                            data,
-                            1,
-                            HAL_MAX_DELAY);
+    return PMIC_ReadRange(hi2c, (uint8_t)reg, data, 1);
 }
 
-/* Fault 전체 읽기 */
+/* Fault 전체 읽기: 0x07~0x09 를 burst 1회로 */
 HAL_StatusTypeDef PMIC_ReadAllFaults(I2C_HandleTypeDef *hi2c,
                                      PMIC_Faults_t *faults)
 {
-    if (PMIC_ReadFaultRegister(hi2c, PMIC_REG_UV_OV, &faults->uv_ov) != HAL_OK) return HAL_ERROR;
-    if (PMIC_ReadFaultRegister(hi2c, PMIC_REG_OC_WAR, &faults->oc_warn) != HAL_OK) return HAL_ERROR;
-    if (PMIC_ReadFaultRegister(hi2c, PMIC_REG_SYSTEM, &faults->system) != HAL_OK) return HAL_ERROR;
+    uint8_t raw[3];
+
+    if (PMIC_ReadRange(hi2c, PMIC_REG_UV_OV, raw, sizeof(raw)) != HAL_OK) return HAL_ERROR;
+    faults->uv_ov   = raw[0];
+    faults->oc_warn = raw[1];
+    faults->system  = raw[2];
     return HAL_OK;
 }
 
@@ -37,22 +65,229 @@ HAL_StatusTypeDef PMIC_ReadAllFaults(I2C_HandleTypeDef *hi2c,
  * @param buckReg   BUCKx VOUT 레지스터 (0x16~0x19)
  * @param voltage_mV 출력 전압 (mV 단위, 예: 1200.0f → 1.2V)
  * @return HAL_OK / HAL_ERROR
+ *  pmicShadow 와 같은 버스면 shadow 경유 (같은 값이면 생략, verify/ramp 설정 적용)
  */
 HAL_StatusTypeDef PMIC_SetBuckVoltage(I2C_HandleTypeDef *hi2c, PMIC_Register_t buckReg, float voltage_mV)
 {
     if (buckReg < PMIC_REG_BUCKA_VOUT || buckReg > PMIC_REG_BUCKD_VOUT)
         return HAL_ERROR;
+    if (voltage_mV < 0.0f || voltage_mV > (float)PMIC_VOUT_MAX_mV)
+        return HAL_ERROR;
+
+    if (pmicShadow.hi2c == hi2c) {
+        uint16_t mV[PMIC_VOUT_COUNT] = { 0 };
+        uint8_t  n = (uint8_t)(buckReg - PMIC_REG_BUCKA_VOUT);
+        mV[n] = (uint16_t)voltage_mV;
+        if (PMIC_BuckSetTargets(&pmicShadow, mV, (uint8_t)(1u << n)) != HAL_OK) return HAL_ERROR;
+        while (PMIC_BuckPending(&pmicShadow) & (1u << n)) {
+            if (PMIC_BuckStep(&pmicShadow) != HAL_OK) return HAL_ERROR;
+        }
+        return HAL_OK;
+    }
 
     // 1 LSB = 10 mV
     uint8_t regValue = (uint8_t)(voltage_mV / 10.0f);
 
-    return HAL_I2C_Mem_Write(hi2c,
-                             I2C_SLAVE_ADDRESS,
-                             (uint16_t)buckReg,
-                             I2C_MEMADD_SIZE_8BIT,
-                             &regValue,
-                             1,
-                             HAL_MAX_DELAY);
+    return PMIC_WriteRange(hi2c, (uint8_t)buckReg, &regValue, 1);
+}
+
+/* ===== Shadow 레지스터 맵 ===== */
+int PMIC_ShadowIndex(uint8_t reg)
+{
+    if (reg >= PMIC_STATUS_FIRST && reg < PMIC_STATUS_FIRST + PMIC_STATUS_COUNT)
+        return (int)(reg - PMIC_STATUS_FIRST);
+    if (reg >= PMIC_VOUT_FIRST && reg < PMIC_VOUT_FIRST + PMIC_VOUT_COUNT)
+        return (int)(PMIC_STATUS_COUNT + (reg - PMIC_VOUT_FIRST));
+    return -1;
+}
+
+void PMIC_ShadowInit(PMIC_Shadow_t *sh, I2C_HandleTypeDef *hi2c)
+{
+    memset(sh, 0, sizeof(*sh));
+    sh->hi2c = hi2c;
+}
+
+/* burst 로 읽은 값을 shadow 에 반영. 로컬 수정(dirty) 항목은 덮어쓰지 않는다 */
+void PMIC_ShadowApply(PMIC_Shadow_t *sh, uint8_t firstReg, const uint8_t *data, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        int idx = PMIC_ShadowIndex((uint8_t)(firstReg + i));
+        if (idx < 0) continue;
+
+        uint16_t bit = (uint16_t)(1u << idx);
+        if (sh->dirty & bit) continue;
+        if (!(sh->valid & bit) || sh->regs[idx] != data[i]) sh->changed |= bit;
+        sh->regs[idx] = data[i];
+        sh->valid |= bit;
+    }
+}
+
+HAL_StatusTypeDef PMIC_ShadowRefresh(PMIC_Shadow_t *sh, uint8_t groups)
+{
+    uint8_t buf[PMIC_STATUS_COUNT];
+    HAL_StatusTypeDef st = HAL_OK;
+
+    if (groups & PMIC_GRP_STATUS) {
+        sh->xfers++;
+        if (PMIC_ReadRange(sh->hi2c, PMIC_STATUS_FIRST, buf, PMIC_STATUS_COUNT) == HAL_OK)
+            PMIC_ShadowApply(sh, PMIC_STATUS_FIRST, buf, PMIC_STATUS_COUNT);
+        else { sh->errors++; st = HAL_ERROR; }
+    }
+    if (groups & PMIC_GRP_VOUT) {
+        sh->xfers++;
+        if (PMIC_ReadRange(sh->hi2c, PMIC_VOUT_FIRST, buf, PMIC_VOUT_COUNT) == HAL_OK)
+            PMIC_ShadowApply(sh, PMIC_VOUT_FIRST, buf, PMIC_VOUT_COUNT);
+        else { sh->errors++; st = HAL_ERROR; }
+    }
+    return st;
+}
+
+HAL_StatusTypeDef PMIC_ShadowGet(const PMIC_Shadow_t *sh, uint8_t reg, uint8_t *value)
+{
+    int idx = PMIC_ShadowIndex(reg);
+    if (idx < 0 || !(sh->valid & (1u << idx))) return HAL_ERROR;
+    *value = sh->regs[idx];
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef PMIC_ShadowSet(PMIC_Shadow_t *sh, uint8_t reg, uint8_t value)
+{
+    int idx = PMIC_ShadowIndex(reg);
+    if (idx < 0) return HAL_ERROR;
+
+    /* 칩과 같은 값이 확실하면 쓰기 생략 */
+    uint16_t bit = (uint16_t)(1u << idx);
+    if ((sh->valid & bit) && !(sh->dirty & bit) && sh->regs[idx] == value) {
+        sh->suppressed++;
+        return HAL_OK;
+    }
+    sh->regs[idx] = value;
+    sh->valid |= (uint16_t)(1u << idx);
+    sh->dirty |= (uint16_t)(1u << idx);
+    return HAL_OK;
+}
+
+/* dirty 사이 간격이 이 이하이면 (값을 아는) 중간 레지스터를 같이 써서 burst 1회로 합친다
+ * (1 트랜잭션 오버헤드 ≈ START+주소+레지스터+STOP 3바이트 > 중간 2바이트) */
+#define PMIC_FLUSH_GAP_MAX     2u
+
+/* dirty 항목을 연속 구간 단위 burst 로 기록 */
+HAL_StatusTypeDef PMIC_ShadowFlush(PMIC_Shadow_t *sh)
+{
+    HAL_StatusTypeDef st = HAL_OK;
+    uint32_t idx = 0;
+
+    while (idx < PMIC_SHADOW_COUNT) {
+        if (!(sh->dirty & (1u << idx))) { idx++; continue; }
+
+        /* 같은 구간(status/vout) 안에서 연속된 dirty 항목 (+ 짧은 valid 간격) */
+        uint32_t end = idx + 1u;
+        uint32_t limit = (idx < PMIC_STATUS_COUNT) ? PMIC_STATUS_COUNT : PMIC_SHADOW_COUNT;
+        for (uint32_t j = end; j < limit; j++) {
+            if (sh->dirty & (1u << j)) { end = j + 1u; continue; }
+            if (!(sh->valid & (1u << j)) || (j - end) >= PMIC_FLUSH_GAP_MAX) break;
+        }
+
+        uint8_t reg = (idx < PMIC_STATUS_COUNT) ? (uint8_t)(PMIC_STATUS_FIRST + idx)
+                                                : (uint8_t)(PMIC_VOUT_FIRST + (idx - PMIC_STATUS_COUNT));
+        uint16_t len = (uint16_t)(end - idx);
+        uint8_t  rb[PMIC_STATUS_COUNT];
+
+        HAL_StatusTypeDef wr = PMIC_WriteRange(sh->hi2c, reg, &sh->regs[idx], len);
+        sh->xfers++;
+        if (wr == HAL_OK && sh->verify) {
+            wr = PMIC_ReadRange(sh->hi2c, reg, rb, len);
+            sh->xfers++;
+        }
+
+        if (wr != HAL_OK) {
+            sh->errors++;
+            st = HAL_ERROR;     // dirty 유지 → 다음 Flush 에서 재시도
+        } else if (sh->verify && memcmp(rb, &sh->regs[idx], len) != 0) {
+            /* 칩 값이 다름: 해당 항목은 무효화 (다음 Refresh 로 실제 값 확인) */
+            sh->verify_fails++;
+            for (uint32_t i = idx; i < end; i++) {
+                sh->dirty &= (uint16_t)~(1u << i);
+                sh->valid &= (uint16_t)~(1u << i);
+            }
+            st = HAL_ERROR;
+        } else {
+            for (uint32_t i = idx; i < end; i++) sh->dirty &= (uint16_t)~(1u << i);
+        }
+        idx = end;
+    }
+    return st;
+}
+
+void PMIC_ShadowConfig(PMIC_Shadow_t *sh, uint8_t verify, uint8_t rampStepLsb)
+{
+    sh->verify = verify;
+    sh->ramp_step = rampStepLsb;
+}
+
+/* ===== Buck 전압 (batch + ramp) ===== */
+#define PMIC_VOUT_VALID_MASK   ((uint16_t)(((1u << PMIC_VOUT_COUNT) - 1u) << PMIC_STATUS_COUNT))
+
+HAL_StatusTypeDef PMIC_BuckSetTargets(PMIC_Shadow_t *sh, const uint16_t mV[PMIC_VOUT_COUNT], uint8_t mask)
+{
+    /* 현재 값을 모르면 (부팅 직후/verify 실패) 먼저 VOUT 구간 burst 읽기 */
+    if ((sh->valid & PMIC_VOUT_VALID_MASK) != PMIC_VOUT_VALID_MASK) {
+        if (PMIC_ShadowRefresh(sh, PMIC_GRP_VOUT) != HAL_OK) return HAL_ERROR;
+    }
+
+    for (uint32_t n = 0; n < PMIC_VOUT_COUNT; n++) {
+        if (!(mask & (1u << n))) continue;
+        if (mV[n] > PMIC_VOUT_MAX_mV) return HAL_ERROR;
+        sh->target[n] = (uint8_t)(mV[n] / PMIC_VOUT_LSB_mV);
+        sh->target_set |= (uint8_t)(1u << n);
+        if (!(PMIC_BuckPending(sh) & (1u << n))) sh->suppressed++;   // 이미 그 전압
+    }
+    return PMIC_BuckStep(sh);
+}
+
+/* 모든 buck 을 목표 방향으로 ramp_step 만큼 이동 → 바뀐 buck 들을 burst 1회로 기록 */
+HAL_StatusTypeDef PMIC_BuckStep(PMIC_Shadow_t *sh)
+{
+    for (uint32_t n = 0; n < PMIC_VOUT_COUNT; n++) {
+        uint8_t  reg = (uint8_t)(PMIC_VOUT_FIRST + n);
+        uint8_t  cur = sh->regs[PMIC_STATUS_COUNT + n];
+        uint8_t  tgt = sh->target[n];
+        uint8_t  next = tgt;
+
+        if (!(sh->target_set & (1u << n)) || cur == tgt) continue;   // 목표 없는 buck 은 그대로
+        if (sh->ramp_step != 0u) {
+            if (tgt > cur && (uint8_t)(tgt - cur) > sh->ramp_step) next = (uint8_t)(cur + sh->ramp_step);
+            if (cur > tgt && (uint8_t)(cur - tgt) > sh->ramp_step) next = (uint8_t)(cur - sh->ramp_step);
+        }
+        (void)PMIC_ShadowSet(sh, reg, next);
+    }
+    return PMIC_ShadowFlush(sh);
+}
+
+uint8_t PMIC_BuckPending(const PMIC_Shadow_t *sh)
+{
+    uint8_t m = 0;
+    for (uint32_t n = 0; n < PMIC_VOUT_COUNT; n++) {
+        uint16_t bit = (uint16_t)(1u << (PMIC_STATUS_COUNT + n));
+        if (!(sh->target_set & (1u << n))) continue;
+        if (!(sh->valid & bit) || (sh->dirty & bit) || sh->regs[PMIC_STATUS_COUNT + n] != sh->target[n])
+            m |= (uint8_t)(1u << n);
+    }
+    return m;
+}
+
+uint16_t PMIC_ShadowTakeChanged(PMIC_Shadow_t *sh)
+{
+    uint16_t c = sh->changed;
+    sh->changed = 0;
+    return c;
+}
+
+void PMIC_ShadowFaults(const PMIC_Shadow_t *sh, PMIC_Faults_t *faults)
+{
+    faults->uv_ov   = sh->regs[PMIC_REG_UV_OV - PMIC_STATUS_FIRST];
+    faults->oc_warn = sh->regs[PMIC_REG_OC_WAR - PMIC_STATUS_FIRST];
+    faults->system  = sh->regs[PMIC_REG_SYSTEM - PMIC_STATUS_FIRST];
 }
 
 
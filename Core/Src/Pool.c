@@ -0,0 +1,46 @@
+/*
+ * Pool.c
+ *
+ *  고정 크기 블록 메모리 풀 (Pool.h 참조)
+ */
+
+#include "Pool.h"
+#include <string.h>
+
+HAL_StatusTypeDef Pool_Init(Pool_t* p, const char* name, void* mem, uint16_t size, uint16_t count)
+{
+    memset(p, 0, sizeof(*p));
+    // osMemoryPool 은 블록 크기를 그대로 간격으로 씀: 빈 목록 포인터가 정렬되도록 4B 단위로
+    size = (uint16_t)((size + 3u) & ~3u);
+    p->size = size;
+    p->count = count;
+
+    const osMemoryPoolAttr_t attr = {
+        .name = name,
+        .cb_mem = &p->cb, .cb_size = sizeof(p->cb),
+        .mp_mem = mem, .mp_size = POOL_MEM_SIZE(count, size),
+    };
+    p->id = osMemoryPoolNew(count, size, &attr);
+    return (p->id != NULL) ? HAL_OK : HAL_ERROR;
+}
+
+void* Pool_Alloc(Pool_t* p, uint32_t timeout_ms)
+{
+    void* b = osMemoryPoolAlloc(p->id, timeout_ms);
+
+    if (b == NULL) {
+        __atomic_fetch_add(&p->exhausted, 1u, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    __atomic_fetch_add(&p->allocs, 1u, __ATOMIC_RELAXED);
+    uint32_t used = __atomic_add_fetch(&p->used, 1u, __ATOMIC_RELAXED);
+    uint32_t hwm = __atomic_load_n(&p->hwm, __ATOMIC_RELAXED);
+    while (used > hwm && !__atomic_compare_exchange_n(&p->hwm, &hwm, used, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { }
+    return b;
+}
+
+void Pool_Free(Pool_t* p, void* block)
+{
+    if (block == NULL) return;
+    if (osMemoryPoolFree(p->id, block) == osOK) __atomic_fetch_sub(&p->used, 1u, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,95 @@
+/*
+ * Ring.c
+ *
+ *  SPSC lock-free 링 버퍼 (Ring.h 참조)
+ */
+
+#include "Ring.h"
+#include <string.h>
+
+HAL_StatusTypeDef Ring_Init(Ring_t* r, void* buf, uint16_t elem, uint32_t count)
+{
+    if (buf == NULL || elem == 0u || count == 0u || (count & (count - 1u)) != 0u) return HAL_ERROR;
+    memset(r, 0, sizeof(*r));
+    r->buf = (uint8_t*)buf;
+    r->mask = count - 1u;
+    r->elem = elem;
+    return HAL_OK;
+}
+
+void Ring_SetNotify(Ring_t* r, osThreadId_t thread, uint32_t flags)
+{
+    r->notify_flags = flags;
+    __atomic_store_n(&r->notify, thread, __ATOMIC_RELEASE);
+}
+
+uint32_t Ring_Push(Ring_t* r, const void* items, uint32_t n)
+{
+    uint32_t head = __atomic_load_n(&r->head, __ATOMIC_RELAXED);     // 생산자만 씀
+    uint32_t cap = r->mask + 1u;
+
+    // 사본으로 자리가 모자랄 때만 소비자 인덱스를 다시 읽음
+    if (cap - (head - r->tail_seen) < n) r->tail_seen = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    uint32_t room = cap - (head - r->tail_seen);
+    if (n > room) {
+        r->dropped += n - room;
+        n = room;
+    }
+    if (n == 0u) return 0;
+
+    uint32_t idx = head & r->mask;
+    uint32_t first = (n < cap - idx) ? n : cap - idx;
+    memcpy(&r->buf[idx * r->elem], items, first * r->elem);
+    memcpy(r->buf, (const uint8_t*)items + first * r->elem, (n - first) * r->elem);
+    __atomic_store_n(&r->head, head + n, __ATOMIC_RELEASE);
+
+    osThreadId_t t = __atomic_load_n(&r->notify, __ATOMIC_ACQUIRE);
+    if (t != NULL) {
+        // head 저장 → tail 확인 (Ring_Wait 와 짝): 소비자가 빈 링을 보고 잠들면 여기서 반드시 깨움
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&r->tail, __ATOMIC_RELAXED) == head) (void)osThreadFlagsSet(t, r->notify_flags);
+    }
+    return n;
+}
+
+uint32_t Ring_Pop(Ring_t* r, void* items, uint32_t n)
+{
+    uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);     // 소비자만 씀
+    uint32_t cap = r->mask + 1u;
+
+    if (r->head_seen - tail < n) r->head_seen = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    uint32_t avail = r->head_seen - tail;
+    if (n > avail) n = avail;
+    if (n == 0u) return 0;
+
+    uint32_t idx = tail & r->mask;
+    uint32_t first = (n < cap - idx) ? n : cap - idx;
+    memcpy(items, &r->buf[idx * r->elem], first * r->elem);
+    memcpy((uint8_t*)items + first * r->elem, r->buf, (n - first) * r->elem);
+    __atomic_store_n(&r->tail, tail + n, __ATOMIC_RELEASE);
+    return n;
+}
+
+HAL_StatusTypeDef Ring_Wait(Ring_t* r, uint32_t timeout_ms)
+{
+    uint32_t start = osKernelGetTickCount();
+
+    for (;;) {
+        // tail 저장 → head 확인 (Ring_Push 와 짝). 남은 flag 로 깨어나도 다시 확인
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) != __atomic_load_n(&r->tail, __ATOMIC_RELAXED)) return HAL_OK;
+
+        uint32_t left = osWaitForever;
+        if (timeout_ms != osWaitForever) {
+            uint32_t spent = osKernelGetTickCount() - start;
+            if (spent >= timeout_ms) return HAL_TIMEOUT;
+            left = timeout_ms - spent;
+        }
+        (void)osThreadFlagsWait(r->notify_flags, osFlagsWaitAny, left);
+    }
+}
+
+uint32_t Ring_Count(const Ring_t* r)
+{
+    return __atomic_load_n(&r->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,124 @@
+/*
+ * SpiFlash.c
+ *
+ *  SPI NOR flash 드라이버 (SpiFlash.h 참조)
+ */
+
+#include "SpiFlash.h"
+#include "BusMgr.h"
+#include "BusRec.h"
+
+static void SpiFlash_Addr(uint8_t* hdr, uint8_t cmd, uint32_t addr)
+{
+    hdr[0] = cmd;
+    hdr[1] = (uint8_t)(addr >> 16);
+    hdr[2] = (uint8_t)(addr >> 8);
+    hdr[3] = (uint8_t)addr;
+}
+
+HAL_StatusTypeDef SpiFlash_ReadStatus(SpiFlash_t* f, uint8_t* sr)
+{
+    uint8_t cmd = SPIFLASH_CMD_RDSR1;
+    return BusMgr_SpiCommand(f->dev, &cmd, 1, sr, 1, 1);
+}
+
+static HAL_StatusTypeDef SpiFlash_WriteEnable(SpiFlash_t* f)
+{
+    uint8_t cmd = SPIFLASH_CMD_WREN;
+    return BusMgr_SpiCommand(f->dev, &cmd, 1, NULL, 0, 0);
+}
+
+/* BUSY 해제 대기: spin 회 만큼은 연속 폴링, 이후 1 tick 씩 양보 */
+static HAL_StatusTypeDef SpiFlash_WaitReady(SpiFlash_t* f, uint32_t spin, uint32_t timeoutMs)
+{
+    uint32_t start = osKernelGetTickCount();
+    uint8_t sr = 0;
+
+    for (uint32_t n = 0; ; n++) {
+        HAL_StatusTypeDef st = SpiFlash_ReadStatus(f, &sr);
+        if (st != HAL_OK) return st;
+        f->busy_polls++;
+        if (!(sr & SPIFLASH_SR_BUSY)) return HAL_OK;
+        if ((osKernelGetTickCount() - start) > timeoutMs) return HAL_TIMEOUT;
+        if (n >= spin) osDelay(1);
+    }
+}
+
+HAL_StatusTypeDef SpiFlash_Init(SpiFlash_t* f, int8_t busDev)
+{
+    uint8_t cmd = SPIFLASH_CMD_JEDEC_ID;
+    uint8_t id[3] = { 0 };
+
+    f->dev = busDev;
+    f->size = 0;
+    f->pages = f->erases = f->busy_polls = 0;
+
+    if (BusMgr_SpiCommand(busDev, &cmd, 1, id, 3, 1) != HAL_OK) return HAL_ERROR;
+    f->jedec = ((uint32_t)id[0] << 16) | ((uint32_t)id[1] << 8) | id[2];
+    if (id[0] != SPIFLASH_MFR_WINBOND || id[2] < 0x10u || id[2] > 0x19u) return HAL_ERROR;
+
+    f->size = 1ul << id[2];     // 0x15 → 2MB
+    return HAL_OK;
+}
+
+/* DMA 1회 길이는 uint16 → 32KB 단위로 나눔 */
+HAL_StatusTypeDef SpiFlash_Read(SpiFlash_t* f, uint32_t addr, uint8_t* buf, uint32_t len)
+{
+    if (addr + len > f->size) return HAL_ERROR;
+
+    while (len > 0u) {
+        uint16_t n = (len > 0x8000u) ? 0x8000u : (uint16_t)len;
+        if (BusMgr_Read(f->dev, addr, buf, n) != HAL_OK) return HAL_ERROR;
+        addr += n;
+        buf += n;
+        len -= n;
+    }
+    return HAL_OK;
+}
+
+/* page 경계에서 분할. 소거되지 않은 영역 여부는 호출자(FlashLog) 책임 */
+HAL_StatusTypeDef SpiFlash_Program(SpiFlash_t* f, uint32_t addr, const uint8_t* buf, uint32_t len)
+{
+    if (addr + len > f->size) return HAL_ERROR;
+
+    while (len > 0u) {
+        uint32_t n = SPIFLASH_PAGE_SIZE - (addr % SPIFLASH_PAGE_SIZE);
+        uint8_t hdr[4];
+        HAL_StatusTypeDef st;
+
+        if (n > len) n = len;
+        SpiFlash_Addr(hdr, SPIFLASH_CMD_PP, addr);
+
+        st = SpiFlash_WriteEnable(f);
+        if (st == HAL_OK) st = BusMgr_SpiCommand(f->dev, hdr, sizeof(hdr), (uint8_t*)buf, (uint16_t)n, 0);
+        if (st == HAL_OK) st = SpiFlash_WaitReady(f, SPIFLASH_PP_SPIN_MAX, SPIFLASH_PP_TIMEOUT_MS);
+        if (st != HAL_OK) return st;
+        BUSREC(BusMgr_Device(f->dev)->bus, BUSREC_OP_WR, BUSREC_SPI_ID(BUSDEV_SPI_FLASH, addr), buf, n);
+
+        f->pages++;
+        addr += n;
+        buf += n;
+        len -= n;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef SpiFlash_EraseSector(SpiFlash_t* f, uint32_t addr)
+{
+    uint8_t hdr[4];
+    HAL_StatusTypeDef st;
+
+    if (addr >= f->size) return HAL_ERROR;
+    SpiFlash_Addr(hdr, SPIFLASH_CMD_SE_4K, addr & ~(SPIFLASH_SECTOR_SIZE - 1u));
+
+    st = SpiFlash_WriteEnable(f);
+    if (st == HAL_OK) st = BusMgr_SpiCommand(f->dev, hdr, sizeof(hdr), NULL, 0, 0);
+    if (st == HAL_OK) st = SpiFlash_WaitReady(f, 0, SPIFLASH_SE_TIMEOUT_MS);
+    if (st == HAL_OK) {
+        f->erases++;
+        // 소거: 데이터 없이 범위만
+        BUSREC(BusMgr_Device(f->dev)->bus, BUSREC_OP_WR, BUSREC_SPI_ID(BUSDEV_SPI_FLASH, addr & ~(SPIFLASH_SECTOR_SIZE - 1u)),
+               NULL, SPIFLASH_SECTOR_SIZE);
+    }
+    return st;
+}
@@ -0,0 +1,161 @@
+/*
+ * StackMon.c
+ *
+ *  스택 / heap 사용량 감시 (StackMon.h 참조)
+ */
+
+#include "StackMon.h"
+#include "DTCMem.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define STACKMON_PENDING   0x53544B50u   // "STKP": DTC 보고 대기
+#define STACKMON_IDLE      0x53544B49u   // "STKI": 기록 유효, 보고 완료
+
+/* 리셋을 넘어 유지 (.noinit, startup 이 지우지 않음). 전원 투입 직후엔 쓰레기 → magic 으로 판별 */
+typedef struct {
+    uint32_t magic;
+    uint32_t overflows;
+    char     task[STACKMON_NAME_LEN];
+} StackMon_Crash_t;
+
+#ifdef HOST_BUILD
+static StackMon_Crash_t stackCrash;      // 호스트: 프로세스 1 회 = 부팅 1 회
+#else
+static StackMon_Crash_t stackCrash __attribute__((section(".noinit")));
+
+extern uint8_t  _estack;                 // 링커 스크립트
+extern uint32_t _Min_Stack_Size;
+extern uint32_t __sbrk_refused;          // sysmem.c
+uint32_t        __sbrk_used(void);
+static uint32_t* mspBottom;
+#endif
+
+StackMon_t stackMon;
+
+void StackMon_Init(void)
+{
+    if (stackCrash.magic != STACKMON_PENDING && stackCrash.magic != STACKMON_IDLE) {
+        memset(&stackCrash, 0, sizeof(stackCrash));
+        stackCrash.magic = STACKMON_IDLE;
+    }
+    stackCrash.task[STACKMON_NAME_LEN - 1u] = '\0';
+    memset(&stackMon, 0, sizeof(stackMon));
+    stackMon.overflows = stackCrash.overflows;
+    memcpy(stackMon.task, stackCrash.task, STACKMON_NAME_LEN);
+
+#ifndef HOST_BUILD
+    // 예약 영역 바닥 ~ 현재 SP 아래 64B 를 채움 (main 의 프레임 위쪽은 측정에서 빠짐)
+    mspBottom = (uint32_t*)((uint32_t)&_estack - (uint32_t)&_Min_Stack_Size);
+    uint32_t* top = (uint32_t*)((__get_MSP() - 64u) & ~3u);
+    for (uint32_t* p = mspBottom; p < top; p++) *p = STACKMON_FILL;
+    stackMon.msp_size = (uint32_t)&_Min_Stack_Size;
+#endif
+}
+
+uint32_t StackMon_MspPeak(void)
+{
+#ifdef HOST_BUILD
+    return 0;
+#else
+    const uint32_t* p = mspBottom;
+    const uint32_t* end = (const uint32_t*)&_estack;
+    while (p < end && *p == STACKMON_FILL) p++;
+    return (uint32_t)((uint32_t)end - (uint32_t)p);
+#endif
+}
+
+/* ===== FreeRTOS 훅 ===== */
+
+// PendSV 안에서 (넘친 Task 가 아직 current): 커널 호출 없이 기록만 하고 리셋
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char* pcTaskName)
+{
+    (void)xTask;
+    if (stackCrash.magic == STACKMON_PENDING) return;     // 호스트: 보고 전 같은 검출 반복
+    stackCrash.overflows++;
+    strncpy(stackCrash.task, pcTaskName, STACKMON_NAME_LEN - 1u);
+    stackCrash.task[STACKMON_NAME_LEN - 1u] = '\0';
+    stackCrash.magic = STACKMON_PENDING;
+#ifndef HOST_BUILD
+    // 손상된 스택으로 계속 돌지 않음. watchdog 리셋과 달리 원인이 남는다
+    NVIC_SystemReset();
+#endif
+}
+
+void vApplicationMallocFailedHook(void)
+{
+    stackMon.malloc_fails++;
+}
+
+/* ===== DTC 보고 ===== */
+
+static HAL_StatusTypeDef StackMon_Report(uint32_t dtc)
+{
+    const uint8_t dtc3[3] = { (uint8_t)(dtc >> 16), (uint8_t)(dtc >> 8), (uint8_t)dtc };
+    return DTCMem_Report(&dtcMem, dtc3, true);
+}
+
+void StackMon_Service(void)
+{
+    if (!DTCMem_Ready(&dtcMem)) return;
+
+    if (stackCrash.magic == STACKMON_PENDING && StackMon_Report(STACKMON_DTC_STACK) == HAL_OK) {
+        stackMon.overflows = stackCrash.overflows;
+        memcpy(stackMon.task, stackCrash.task, STACKMON_NAME_LEN);
+        stackCrash.magic = STACKMON_IDLE;
+    }
+    if (stackMon.malloc_fails != 0u && !stackMon.heap_reported && StackMon_Report(STACKMON_DTC_HEAP) == HAL_OK) {
+        stackMon.heap_reported = 1u;
+    }
+}
+
+/* ===== 덤프 ===== */
+
+static void StackMon_Name(char* out, const char* name)
+{
+    uint32_t i = 0;
+    for (; name != NULL && name[i] != '\0' && i < STACKMON_NAME_LEN - 1u; i++) {
+        out[i] = (name[i] == ' ') ? '_' : name[i];
+    }
+    if (i == 0u) out[i++] = '-';
+    out[i] = '\0';
+}
+
+void StackMon_Dump(StackMon_WriteFn write)
+{
+    char line[128], name[STACKMON_NAME_LEN];
+    osThreadId_t ids[STACKMON_MAX_TASKS];
+    uint32_t n = osThreadEnumerate(ids, STACKMON_MAX_TASKS);
+
+    for (uint32_t i = 0; i < n; i++) {
+        StackMon_Name(name, osThreadGetName(ids[i]));
+        snprintf(line, sizeof(line), "STACK v=1 task=%s free_min=%lu\n",
+                 name, (unsigned long)osThreadGetStackSpace(ids[i]));
+        write(line);
+    }
+
+    HeapStats_t hs;
+    vPortGetHeapStats(&hs);
+    snprintf(line, sizeof(line), "HEAP v=1 size=%lu free=%lu free_min=%lu largest=%lu blocks=%lu allocs=%lu frees=%lu fails=%lu\n",
+             (unsigned long)configTOTAL_HEAP_SIZE, (unsigned long)hs.xAvailableHeapSpaceInBytes,
+             (unsigned long)hs.xMinimumEverFreeBytesRemaining, (unsigned long)hs.xSizeOfLargestFreeBlockInBytes,
+             (unsigned long)hs.xNumberOfFreeBlocks, (unsigned long)hs.xNumberOfSuccessfulAllocations,
+             (unsigned long)hs.xNumberOfSuccessfulFrees, (unsigned long)stackMon.malloc_fails);
+    write(line);
+
+#ifdef HOST_BUILD
+    snprintf(line, sizeof(line), "MSP v=1 size=0 peak=0 sbrk=0 sbrk_refused=0\n");
+#else
+    snprintf(line, sizeof(line), "MSP v=1 size=%lu peak=%lu sbrk=%lu sbrk_refused=%lu\n",
+             (unsigned long)stackMon.msp_size, (unsigned long)StackMon_MspPeak(),
+             (unsigned long)__sbrk_used(), (unsigned long)__sbrk_refused);
+#endif
+    write(line);
+
+    StackMon_Name(name, stackMon.overflows ? stackMon.task : NULL);
+    snprintf(line, sizeof(line), "OVF v=1 count=%lu task=%s\nE\n", (unsigned long)stackMon.overflows, name);
+    write(line);
+}
@@ -0,0 +1,152 @@
+/*
+ * SupplyMon.c
+ *
+ *  ADC1 공급 전압 감시 (SupplyMon.h 참조)
+ */
+
+#include "SupplyMon.h"
+#include "Trace.h"
+#include "EECache.h"
+
+#define SUPPLYMON_FLAG_HALF   (1u << 0)
+#define SUPPLYMON_FLAG_FULL   (1u << 1)
+
+/* 12V 계통, 1:11 분압 (110k/10k) */
+const SupplyMon_Config_t SupplyMon_DefaultConfig = {
+    .uv_mV = 9000,  .uv_clear_mV = 9500,
+    .ov_mV = 16000, .ov_clear_mV = 15500,
+    .debounce_blocks = 2,
+    .iir_shift = 1,
+    .div_num = 11, .div_den = 1,
+};
+
+SupplyMon_t supplyMon;
+
+/* DMA 순환 버퍼: [0..BLOCK) = 앞 반, [BLOCK..2*BLOCK) = 뒤 반 */
+static uint16_t adcDmaBuf[2 * SUPPLYMON_BLOCK] __attribute__((aligned(4)));
+static osThreadId_t supplyMonThread;
+
+void SupplyMon_Init(SupplyMon_t* m, const SupplyMon_Config_t* cfg)
+{
+    *m = (SupplyMon_t){ 0 };
+    m->cfg = *cfg;
+    m->dtc_uv.dtc[0] = (uint8_t)(SUPPLYMON_DTC_UV >> 8);
+    m->dtc_uv.dtc[1] = (uint8_t)(SUPPLYMON_DTC_UV & 0xFF);
+    m->dtc_uv.status = DTC_ST_TNCSLC | DTC_ST_TNCTOC;
+    m->dtc_ov.dtc[0] = (uint8_t)(SUPPLYMON_DTC_OV >> 8);
+    m->dtc_ov.dtc[1] = (uint8_t)(SUPPLYMON_DTC_OV & 0xFF);
+    m->dtc_ov.status = DTC_ST_TNCSLC | DTC_ST_TNCTOC;
+}
+
+uint16_t SupplyMon_CountsToSupply_mV(const SupplyMon_t* m, int32_t counts_q4)
+{
+    if (counts_q4 <= 0) return 0;
+    uint64_t num = (uint64_t)counts_q4 * SUPPLYMON_ADC_VREF_mV * m->cfg.div_num;
+    uint64_t den = (uint64_t)SUPPLYMON_ADC_FULL * 16u * m->cfg.div_den;
+    uint64_t mv = num / den;
+    return (mv > 0xFFFFu) ? 0xFFFFu : (uint16_t)mv;
+}
+
+/* 임계값 교차 판정 (히스테리시스 + 디바운스) */
+static uint8_t SupplyMon_Check(uint8_t* active, uint8_t* cnt, int beyond, int recovered,
+                               uint8_t debounce, uint8_t evSet, uint8_t evClr)
+{
+    if (!*active) {
+        *cnt = beyond ? (uint8_t)(*cnt + 1u) : 0u;
+        if (*cnt >= debounce) { *active = 1; *cnt = 0; return evSet; }
+    } else if (recovered) {
+        *active = 0; *cnt = 0;
+        return evClr;
+    }
+    return 0;
+}
+
+uint8_t SupplyMon_ProcessBlock(SupplyMon_t* m, const uint16_t* samples, uint32_t n)
+{
+    uint32_t sum = 0;
+    uint8_t ev = 0;
+
+    if (n == 0u) return 0;
+
+    /* 1) 블록 평균 (Q4) */
+    for (uint32_t i = 0; i < n; i++) sum += samples[i];
+    int32_t x_q4 = (int32_t)(((uint64_t)sum << 4) / n);
+
+    /* 2) 1차 IIR */
+    if (!m->primed) { m->y_q4 = x_q4; m->primed = 1; }
+    else            { m->y_q4 += (x_q4 - m->y_q4) >> m->cfg.iir_shift; }
+
+    uint16_t mv = SupplyMon_CountsToSupply_mV(m, m->y_q4);
+    m->supply_mV = mv;
+    m->blocks++;
+
+    /* 3) 임계값 */
+    ev |= SupplyMon_Check(&m->uv_active, &m->uv_cnt, mv < m->cfg.uv_mV, mv >= m->cfg.uv_clear_mV,
+                          m->cfg.debounce_blocks, SUPPLYMON_EV_UV_SET, SUPPLYMON_EV_UV_CLR);
+    ev |= SupplyMon_Check(&m->ov_active, &m->ov_cnt, mv > m->cfg.ov_mV, mv <= m->cfg.ov_clear_mV,
+                          m->cfg.debounce_blocks, SUPPLYMON_EV_OV_SET, SUPPLYMON_EV_OV_CLR);
+
+    /* 4) DTC 상태 (블록마다 테스트 결과 1회) */
+    DTC_UpdateStatus(&m->dtc_uv, m->uv_active != 0);
+    DTC_UpdateStatus(&m->dtc_ov, m->ov_active != 0);
+    return ev;
+}
+
+uint16_t SupplyMon_ActiveDtc(const SupplyMon_t* m)
+{
+    if (m->uv_active) return SUPPLYMON_DTC_UV;
+    if (m->ov_active) return SUPPLYMON_DTC_OV;
+    return 0;
+}
+
+/* ===== DMA 반/완료 인터럽트 → 태스크 통지 ===== */
+/* APB1 분주 ≠ 1 이면 타이머 클럭 = 2 x PCLK1 (RM0430 6.2) */
+void SupplyMon_OnClockChange(void)
+{
+    RCC_ClkInitTypeDef clk;
+    uint32_t latency;
+    uint32_t timclk = HAL_RCC_GetPCLK1Freq();
+
+    HAL_RCC_GetClockConfig(&clk, &latency);
+    if (clk.APB1CLKDivider != RCC_HCLK_DIV1) timclk *= 2u;
+    __HAL_TIM_SET_AUTORELOAD(&htim2, timclk / SUPPLYMON_FS_HZ - 1u);
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    if (hadc == &hadc1 && supplyMonThread != NULL) (void)osThreadFlagsSet(supplyMonThread, SUPPLYMON_FLAG_HALF);
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    if (hadc == &hadc1 && supplyMonThread != NULL) (void)osThreadFlagsSet(supplyMonThread, SUPPLYMON_FLAG_FULL);
+}
+
+void StartSupplyMonTask(void *argument)
+{
+    SupplyMon_Init(&supplyMon, &SupplyMon_DefaultConfig);
+    supplyMonThread = osThreadGetId();
+
+    if (HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adcDmaBuf, 2u * SUPPLYMON_BLOCK) != HAL_OK ||
+        HAL_TIM_Base_Start(&htim2) != HAL_OK) {
+        osThreadExit();
+    }
+
+    for (;;)
+    {
+        uint32_t f = osThreadFlagsWait(SUPPLYMON_FLAG_HALF | SUPPLYMON_FLAG_FULL, osFlagsWaitAny, osWaitForever);
+        if (f & osFlagsError) continue;
+
+        /* 두 플래그가 동시에 보이면 앞 블록 하나는 이미 덮어쓰인 상태 */
+        if ((f & SUPPLYMON_FLAG_HALF) && (f & SUPPLYMON_FLAG_FULL)) supplyMon.overruns++;
+
+        const uint16_t* blk = (f & SUPPLYMON_FLAG_FULL) ? &adcDmaBuf[SUPPLYMON_BLOCK] : &adcDmaBuf[0];
+        uint8_t ev = SupplyMon_ProcessBlock(&supplyMon, blk, SUPPLYMON_BLOCK);
+        if (ev & (SUPPLYMON_EV_UV_SET | SUPPLYMON_EV_OV_SET)) {
+            TRACE(TRACE_EV_SUPPLY_FAULT, supplyMon.supply_mV);
+        }
+        if (ev & SUPPLYMON_EV_UV_SET) {
+            EECache_RequestFlush(&eeCache);     // 공급 붕괴 전에 캐시 기록
+        }
+    }
+}
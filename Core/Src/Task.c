@@ -3,21 +3,63 @@
  */
 
 #include "Task.h"
-#include "eeprom.h"
-#include "pmic.h"
-#include "uds_can.h"
+#include "EEPROM.h"
+#include "PMIC.h"
+#include "UDS_CAN.h"
+#include "SupplyMon.h"
+#include "Trace.h"
+#include "BusRec.h"
+#include "DVFS.h"
+#include "BusMgr.h"
+#include "FlashLog.h"
+#include "EECache.h"
+#include "DTCMem.h"
+#include "PDID.h"
+#include "StackMon.h"
 
-// 내부 파이프라인 버퍼
-static uint8_t rxFaultBuf[3];   // PMIC Fault raw
-static uint8_t dtcBuf[2];       // EEPROM 저장용 (DTC 코드 2B)
-static uint8_t eepromReadBuf[2];// CAN/USART 송신용
+#include <string.h>
+
+#ifdef DIAG_BENCH
+#include "Bench.h"
+#endif
+
+/* 벤치 결과 (BENCH ... 라인) / trace 덤프는 UART4 로 출력 */
+static void WriteUart(const char *line)
+{
+    (void)HAL_UART_Transmit(&huart4, (uint8_t *)line, (uint16_t)strlen(line), HAL_MAX_DELAY);
+}
+
+// UART4 수신 링 (생산자: RX 완료 ISR, 소비자: UARTTask)
+Ring_t uartRxRing;
+static uint8_t uartRxBuf[UART_RX_RING_LEN];
+static uint8_t uartRxByte;
+
+// 내부 파이프라인 버퍼 (Task.h, MPU slice)
+Task_PipeBuf_t pipeBuf;
+static uint16_t lastLoggedDtc;  // flash 이력에 마지막으로 남긴 DTC (0 = 없음)
+static uint16_t memDtc;         // DTC 메모리에 마지막으로 반영한 DTC (0 = 없음)
+static uint8_t  lastLowSupply;  // 직전 회차 저전압 여부 (강제 flush 에지 검출)
 
 // 실행 단계 (0:I2C → 1:SPI → 2:CAN → 3:UART)
 static volatile uint8_t currentStep = 0;
 
+// 파이프라인 회차 (trace arg 로 단계 간 상관)
+static volatile uint16_t pipeSeq = 0;
+
 void StartDefaultTask(void *argument)
 {
+#ifdef DIAG_BENCH
+    // -DDIAG_BENCH 빌드: 부팅 시 1회 진단 경로 벤치 실행
+    const Bench_Config_t cfg = { .iters = 200, .repeats = 5, .write = WriteUart };
+    osMutexAcquire(CommMutexHandle, osWaitForever);
+    Bench_RunDiagSuite(&cfg);
+    Mpu_RunSwitchBench(&cfg);
+    osMutexRelease(CommMutexHandle);
+#endif
     for (;;) {
+        // 이전 부팅의 스택 오버플로 / heap 고갈 / MPU 위반 → DTC (DTC 메모리 mount 후 1 회)
+        StackMon_Service();
+        Mpu_Service();
         osDelay(1);
     }
 }
@@ -32,32 +74,71 @@ void StartI2CTask(void *argument)
 
         if (currentStep == 0)
         {
-            // 1) PMIC Fault 읽기 (I2C + DMA)
+            // 1) PMIC 상태 구간 0x05~0x09 읽기 (I2C + DMA, auto-increment burst)
+            pipeSeq++;
+            TRACE(TRACE_EV_I2C_READ_START, pipeSeq);
             (void)HAL_I2C_Mem_Read_DMA(&hi2c1,
                                        I2C_SLAVE_ADDRESS,
-                                       PMIC_REG_UV_OV,
+                                       PMIC_STATUS_FIRST,
                                        I2C_MEMADD_SIZE_8BIT,
-                                       rxFaultBuf,
-                                       sizeof(rxFaultBuf));
+                                       pipeBuf.i2c.rxStatus,
+                                       sizeof(pipeBuf.i2c.rxStatus));
 
             // NOTE: 간단 대기(예시). 실제로는 I2C DMA 콜백에서 완료 동기화 권장.
             osDelay(5);
 
             // 2) Fault 판정
-            faults.uv_ov   = rxFaultBuf[0];
-            faults.oc_warn = rxFaultBuf[1];
-            faults.system  = rxFaultBuf[2];
+            PMIC_ShadowApply(&pmicShadow, PMIC_STATUS_FIRST, pipeBuf.i2c.rxStatus, sizeof(pipeBuf.i2c.rxStatus));
+            PMIC_ShadowFaults(&pmicShadow, &faults);
 
+            // PMIC Fault 우선, 없으면 ADC 공급 전압 감시 결과 (P0562/P0563)
+            uint16_t dtcCode = 0;
             if (PMIC_HasVoltageFault(&faults) || PMIC_HasCurrentFault(&faults)) {
-                // 예시 DTC 코드 (2바이트)
-                const uint16_t dtcCode = 0xC123;
-                dtcBuf[0] = (uint8_t)(dtcCode >> 8);
-                dtcBuf[1] = (uint8_t)(dtcCode & 0xFF);
+                dtcCode = 0xC123;   // 예시 DTC 코드 (2바이트)
+            } else {
+                dtcCode = SupplyMon_ActiveDtc(&supplyMon);
+            }
+
+            // DTC 변화(발생/해제)만 flash 이력에 남김: code(2) status(1) tick_ms(4)
+            if (dtcCode != lastLoggedDtc) {
+                uint16_t code = (dtcCode != 0) ? dtcCode : lastLoggedDtc;
+                uint32_t now = osKernelGetTickCount();
+                uint8_t rec[7] = { (uint8_t)(code >> 8), (uint8_t)code, (uint8_t)(dtcCode != 0),
+                                   (uint8_t)now, (uint8_t)(now >> 8), (uint8_t)(now >> 16), (uint8_t)(now >> 24) };
+                FlashLog_Post(FLASHLOG_REC_DTC, rec, sizeof(rec));
+                lastLoggedDtc = dtcCode;
+            }
 
-                // 3) EEPROM에 기록 (SPI)
-                (void)EEPROM_WriteData(&hspi1, 0x0000, dtcBuf, 2);
+            // DTC 메모리: RAM 상태만 갱신 (EEPROM 기록은 UDSTask). mount 전이면 다음 회차에 반영
+            if (dtcCode != memDtc && DTCMem_Ready(&dtcMem)) {
+                if (memDtc != 0) {
+                    const uint8_t prev[3] = { (uint8_t)(memDtc >> 8), (uint8_t)memDtc, 0x00 };
+                    (void)DTCMem_Report(&dtcMem, prev, false);
+                }
+                if (dtcCode != 0) {
+                    const uint8_t cur[3] = { (uint8_t)(dtcCode >> 8), (uint8_t)dtcCode, 0x00 };
+                    (void)DTCMem_Report(&dtcMem, cur, true);
+                }
+                memDtc = dtcCode;
             }
 
+            if (dtcCode != 0) {
+                pipeBuf.i2c.dtc[0] = (uint8_t)(dtcCode >> 8);
+                pipeBuf.i2c.dtc[1] = (uint8_t)(dtcCode & 0xFF);
+                TRACE(TRACE_EV_FAULT_DECIDED, pipeSeq);
+
+                // 3) EEPROM에 기록: write-back 캐시 (실제 쓰기는 EECacheTask)
+                (void)EECache_Write(&eeCache, 0x0000, pipeBuf.i2c.dtc, 2);
+                TRACE(TRACE_EV_EE_WRITE_DONE, pipeSeq);
+            }
+
+            // PMIC UV 경고 / 공급 저전압: 전원이 무너지기 전에 캐시 기록을 바로 내보냄
+            // (진입 시 1 회 + 저전압 중 새로 쓴 DTC 마다)
+            uint8_t lowSupply = ((faults.uv_ov & (PMIC_UV_A_Msk | PMIC_UV_B_Msk | PMIC_UV_C_Msk | PMIC_UV_D_Msk)) != 0u)
+                                || supplyMon.uv_active;
+            if (lowSupply && (!lastLowSupply || dtcCode != 0)) EECache_RequestFlush(&eeCache);
+            lastLowSupply = lowSupply;
+
             // 다음 단계로
             currentStep = 1;
         }
@@ -76,7 +157,11 @@ void StartSPITask(void *argument)
         if (currentStep == 1)
         {
             // EEPROM에서 DTC 2바이트 읽기 (SPI)
-            (void)EEPROM_ReadData(&hspi1, 0x0000, eepromReadBuf, 2);
+            // 캐시에 있으면 버스 접근 없이
+            if (EECache_Peek(&eeCache, 0x0000, pipeBuf.spi.eepromRead, 2) != HAL_OK) {
+                (void)EEPROM_ReadData(&hspi1, 0x0000, pipeBuf.spi.eepromRead, 2);
+            }
+            TRACE(TRACE_EV_EE_READ_DONE, pipeSeq);
 
             currentStep = 2; // 다음: CAN
         }
@@ -96,7 +181,10 @@ void StartCANTask(void *argument)
         {
             // CAN으로 2바이트 DTC 전송 (UDS 상위 계층은 uds_can 쪽에서 구성)
             // 여기서는 HAL CAN 기본 송신만 수행
-            (void)HAL_CAN_AddTxMessage(&hcan1, &TxHeader, eepromReadBuf, &TxMailbox);
+            if (HAL_CAN_AddTxMessage(&hcan1, &TxHeader, pipeBuf.spi.eepromRead, &TxMailbox) == HAL_OK) {
+                TRACE(TRACE_EV_CAN_TX_QUEUED, pipeSeq);
+                BUSREC(BUSREC_BUS_CAN1, BUSREC_OP_TX, TxHeader.StdId, pipeBuf.spi.eepromRead, TxHeader.DLC);
+            }
 
             currentStep = 3; // 다음: UART
         }
@@ -108,14 +196,31 @@ void StartCANTask(void *argument)
 
 void StartUARTTask(void *argument)
 {
+    uint8_t cmd[8];
+
+    (void)Ring_Init(&uartRxRing, uartRxBuf, 1u, UART_RX_RING_LEN);
+    (void)HAL_UART_Receive_IT(&huart4, &uartRxByte, 1u);
+
     for (;;)
     {
+        // RX ISR 의 재시작이 실패했으면 (HAL_BUSY: 송신 중 잠금 구간) 여기서 다시
+        if (huart4.RxState == HAL_UART_STATE_READY) (void)HAL_UART_Receive_IT(&huart4, &uartRxByte, 1u);
+
+        // 수신 명령은 파이프라인 잠금 밖에서 (UART4 송신은 이 Task 만 사용)
+        uint32_t n = Ring_Pop(&uartRxRing, cmd, sizeof(cmd));
+        for (uint32_t i = 0; i < n; i++) {
+            if (cmd[i] == UART_CMD_TRACE) Trace_Dump(WriteUart);
+            else if (cmd[i] == UART_CMD_STACK) StackMon_Dump(WriteUart);
+            else if (cmd[i] == UART_CMD_BUSREC) BusRec_Dump(WriteUart);
+        }
+
         osMutexAcquire(CommMutexHandle, osWaitForever);
 
         if (currentStep == 3)
         {
             // HAL UART로 2바이트 원시 DTC 전송 (문자열 포맷 X)
-            (void)HAL_UART_Transmit(&huart4, eepromReadBuf, 2u, HAL_MAX_DELAY);
+            (void)HAL_UART_Transmit(&huart4, pipeBuf.spi.eepromRead, 2u, HAL_MAX_DELAY);
+            TRACE(TRACE_EV_UART_TX_DONE, pipeSeq);
 
             currentStep = 0; // 파이프라인 한 바퀴 완료 → 다시 I2C
         }
@@ -124,3 +229,46 @@ void StartUARTTask(void *argument)
         osDelay(1);
     }
 }
+
+/* ===== ISR 측 trace / DVFS 부하 훅 ===== */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != &huart4) return;
+    (void)Ring_Push(&uartRxRing, &uartRxByte, 1);      // 가득 차면 dropped
+    (void)HAL_UART_Receive_IT(&huart4, &uartRxByte, 1u);   // HAL_BUSY 면 UARTTask 가 재시작
+}
+
+/* overrun / framing 오류: HAL 이 수신을 끝냈으면 다시 시작 (잃은 바이트는 명령 1 개) */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != &huart4) return;
+    (void)HAL_UART_Receive_IT(&huart4, &uartRxByte, 1u);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c == &hi2c1) TRACE(TRACE_EV_I2C_READ_DONE, pipeSeq);
+    BUSREC_I2C(hi2c, BUSREC_OP_RD);          // 파이프라인 + BusMgr 의 DMA 읽기
+    BusMgr_XferDoneFromISR(hi2c, 0);
+}
+
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == &hcan1) TRACE(TRACE_EV_CAN_TX_DONE, pipeSeq);
+    DVFS_NotifyCanFrame();
+    if (hcan == &hcan1) PDID_TxDoneFromISR(&pdidSched);
+}
+
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == &hcan1) TRACE(TRACE_EV_CAN_TX_DONE, pipeSeq);
+    DVFS_NotifyCanFrame();
+    if (hcan == &hcan1) PDID_TxDoneFromISR(&pdidSched);
+}
+
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == &hcan1) TRACE(TRACE_EV_CAN_TX_DONE, pipeSeq);
+    DVFS_NotifyCanFrame();
+    if (hcan == &hcan1) PDID_TxDoneFromISR(&pdidSched);
+}
@@ -0,0 +1,60 @@
+/*
+ * Trace.c
+ *
+ *  Fault→Bus 지연 trace 버퍼 (Trace.h 참조)
+ */
+
+#include "Trace.h"
+#include "stm32f4xx_hal.h"
+
+#include <stdio.h>
+
+static Trace_Entry_t     s_buf[TRACE_BUF_SIZE];
+static volatile uint32_t s_head;     // 다음 예약 인덱스 (단조 증가)
+
+void Trace_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    for (uint32_t i = 0; i < TRACE_BUF_SIZE; i++) s_buf[i].seq = 0;
+    s_head = 0;
+}
+
+void Trace_Log(uint16_t event, uint16_t arg)
+{
+    /* Cortex-M4: LDREX/STREX 루프 → 인터럽트/태스크 간 경쟁에도 슬롯 중복 없음 */
+    uint32_t idx = __atomic_fetch_add(&s_head, 1u, __ATOMIC_RELAXED);
+    Trace_Entry_t* e = &s_buf[idx & (TRACE_BUF_SIZE - 1u)];
+
+    e->seq   = 0;               // 기록 중 표시
+    e->ts    = DWT->CYCCNT;
+    e->event = event;
+    e->arg   = arg;
+    __atomic_store_n(&e->seq, idx + 1u, __ATOMIC_RELEASE);
+}
+
+uint32_t Trace_Count(void)
+{
+    return __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+}
+
+void Trace_Dump(Trace_WriteFn write)
+{
+    char line[64];
+    uint32_t head = Trace_Count();
+    uint32_t n = (head > TRACE_BUF_SIZE) ? TRACE_BUF_SIZE : head;
+    uint32_t first = head - n;
+
+    snprintf(line, sizeof(line), "TRACE v=%u hz=%lu n=%lu dropped=%lu\n",
+             (unsigned)TRACE_FORMAT_VERSION, (unsigned long)SystemCoreClock,
+             (unsigned long)n, (unsigned long)first);
+    write(line);
+
+    for (uint32_t i = first; i < head; i++) {
+        const Trace_Entry_t* e = &s_buf[i & (TRACE_BUF_SIZE - 1u)];
+        if (__atomic_load_n(&e->seq, __ATOMIC_ACQUIRE) != i + 1u) continue;   // 기록 중/덮어씀
+        snprintf(line, sizeof(line), "E %lu %02X %u\n",
+                 (unsigned long)e->ts, (unsigned)e->event, (unsigned)e->arg);
+        write(line);
+    }
+}
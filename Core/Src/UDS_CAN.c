@@ -7,3 +7,683 @@
 
 
 #include "UDS_CAN.h"
+#include "DTC.h"
+#include "DTCMem.h"
+#include "DID.h"
+#include "PDID.h"
+#include "DVFS.h"
+#include "BusRec.h"
+#include "FreeRTOS.h"
+#include "timers.h"
+#include <string.h>
+
+extern CAN_HandleTypeDef hcan1;
+
+UDS_Server_t udsServer = { .session = UDS_SESSION_DEFAULT, .seed_state = 0x2545F491u };
+
+/* ISR → UDSTask 수신 프레임 (커널 큐 대신 SPSC 링: ISR 에서 커널 호출은 빈 링에 넣을 때만).
+ * 링에는 프레임 풀 블록 포인터만: ISR 이 블록에 바로 채우고 UDSTask 는 복사 없이 읽음 */
+Ring_t udsRxRing;
+static UDS_RxFrame_t* udsRxBuf[UDS_RX_RING_LEN];
+
+/* 수신 프레임 / 요청 재조립 / 응답 버퍼 풀 (블록 배열은 4B 정렬) */
+Pool_t udsFramePool, udsReqPool, udsRspPool;
+static uint32_t udsFrameMem[POOL_MEM_SIZE(UDS_RX_RING_LEN, sizeof(UDS_RxFrame_t)) / 4u];
+static uint32_t udsReqMem[POOL_MEM_SIZE(UDS_REQ_BUFS, UDS_REQ_MAX_LEN) / 4u];
+static uint32_t udsRspMem[POOL_MEM_SIZE(UDS_RSP_BUFS, ISOTP_MAX_LEN) / 4u];
+
+static osTimerId_t udsP2Timer;
+static osTimerId_t udsS3Timer;
+static uint32_t    udsLastRxTick;     // UDS_LinkRecv 가 마지막으로 꺼낸 프레임 (재조립 중 들어온 요청의 P2 기준)
+
+/* Task.c(StartCANTask) 에서 사용하는 DTC 송신 헤더/메일박스 */
+CAN_TxHeaderTypeDef TxHeader = {
+    .StdId = UDS_RES_CANID,
+    .ExtId = 0,
+    .IDE   = CAN_ID_STD,
+    .RTR   = CAN_RTR_DATA,
+    .DLC   = 2,                 // DTC 코드 2B
+    .TransmitGlobalTime = DISABLE,
+};
+uint32_t TxMailbox;
+
+/* UDS 응답 (CAN1 classic): 8B 패딩 */
+static CAN_TxHeaderTypeDef udsTxHeader = {
+    .StdId = UDS_RES_CANID,
+    .ExtId = 0,
+    .IDE   = CAN_ID_STD,
+    .RTR   = CAN_RTR_DATA,
+    .DLC   = 8,
+    .TransmitGlobalTime = DISABLE,
+};
+static uint32_t udsTxMailbox;
+
+/* 0x2A 주기 응답: pDID + 데이터, 8B 패딩 */
+static CAN_TxHeaderTypeDef udsPeriodicHeader = {
+    .StdId = UDS_PERIODIC_CANID,
+    .ExtId = 0,
+    .IDE   = CAN_ID_STD,
+    .RTR   = CAN_RTR_DATA,
+    .DLC   = 8,
+    .TransmitGlobalTime = DISABLE,
+};
+
+
+/* CAN FD 포트 (NULL = CAN1 classic) */
+static const UDS_FdPort_t* udsFd;
+
+/* ===== 송신 ===== */
+
+/* 프레임 1 개. 메일박스가 없으면 HAL_ERROR (대기하지 않음) */
+static HAL_StatusTypeDef UDS_LinkSend(const uint8_t* frame, uint8_t len)
+{
+    HAL_StatusTypeDef st;
+
+    if (udsFd != NULL) {
+        st = udsFd->send(UDS_RES_CANID, frame, len);
+        if (st == HAL_OK) BUSREC(BUSREC_BUS_CAN1, BUSREC_OP_TX, UDS_RES_CANID | BUSREC_CAN_FD, frame, len);
+        return st;
+    }
+    // classic: IsoTp_PadLen 으로 항상 8B
+    st = HAL_CAN_AddTxMessage(&hcan1, &udsTxHeader, (uint8_t*)frame, &udsTxMailbox);
+    if (st == HAL_OK) BUSREC(BUSREC_BUS_CAN1, BUSREC_OP_TX, UDS_RES_CANID, frame, udsTxHeader.DLC);
+    return st;
+}
+
+/* ISO-TP 진행 중 테스터 프레임 (FC/CF). 기능 주소 프레임은 이 채널이 아니므로 버림 */
+static HAL_StatusTypeDef UDS_LinkRecv(uint8_t* frame, uint8_t* len, uint32_t timeout_ms)
+{
+    UDS_RxFrame_t* rx;
+    uint32_t start = osKernelGetTickCount();
+
+    for (;;) {
+        uint32_t spent = osKernelGetTickCount() - start;
+        if (spent > timeout_ms) return HAL_TIMEOUT;
+        if (Ring_Wait(&udsRxRing, timeout_ms - spent) != HAL_OK) return HAL_TIMEOUT;
+        if (Ring_Pop(&udsRxRing, &rx, 1) == 0u) continue;
+        uint8_t functional = rx->functional;
+        if (!functional) {
+            memcpy(frame, rx->data, rx->len);
+            *len = rx->len;
+            udsLastRxTick = rx->rx_tick;
+        }
+        Pool_Free(&udsFramePool, rx);
+        if (!functional) return HAL_OK;
+    }
+}
+
+static IsoTp_Link_t udsLink = { .send = UDS_LinkSend, .recv = UDS_LinkRecv };
+
+/* 주기 응답 1 개 (타이머 Task / TX 완료 ISR). 메일박스 1 개는 요청 응답용으로 남김 */
+static HAL_StatusTypeDef UDS_PeriodicSend(const uint8_t* frame)
+{
+    uint32_t mailbox;
+    HAL_StatusTypeDef st;
+
+    if (udsFd != NULL) {
+        st = udsFd->send(UDS_PERIODIC_CANID, frame, ISOTP_FRAME_LEN);
+        if (st == HAL_OK) BUSREC(BUSREC_BUS_CAN1, BUSREC_OP_TX, UDS_PERIODIC_CANID | BUSREC_CAN_FD, frame, ISOTP_FRAME_LEN);
+        return st;
+    }
+    if (HAL_CAN_GetTxMailboxesFreeLevel(&hcan1) < 2u) return HAL_BUSY;
+    st = HAL_CAN_AddTxMessage(&hcan1, &udsPeriodicHeader, (uint8_t*)frame, &mailbox);
+    if (st == HAL_OK) BUSREC(BUSREC_BUS_CAN1, BUSREC_OP_TX, UDS_PERIODIC_CANID, frame, udsPeriodicHeader.DLC);
+    return st;
+}
+
+/* single frame 1 개 (0x78 등). 메일박스가 없으면 HAL_ERROR */
+static HAL_StatusTypeDef UDS_Transmit(const uint8_t* rsp, uint8_t len)
+{
+    uint8_t frame[ISOTP_FRAME_MAX];
+    uint8_t flen;
+
+    (void)IsoTp_FirstFrame(&udsLink, rsp, len, frame, &flen);
+    return UDS_LinkSend(frame, flen);
+}
+
+static uint8_t UDS_Negative(uint8_t sid, uint8_t nrc, uint8_t* rsp)
+{
+    rsp[0] = UDS_SID_NEGATIVE_RESPONSE;
+    rsp[1] = sid;
+    rsp[2] = nrc;
+    return 3;
+}
+
+/* ===== 타이머 (타이머 Task 문맥) ===== */
+
+/* P2(또는 P2*) 안에 최종 응답이 없음 → 0x78, 다음 만료는 P2* 기준 */
+static void UDS_P2Expired(void *argument)
+{
+    uint8_t rsp[3];
+    uint32_t next = 0;
+
+    (void)argument;
+    osKernelLock();             // UDSTask 의 최종 응답과 순서가 뒤바뀌지 않도록
+    if (udsServer.busy) {
+        if (UDS_Transmit(rsp, UDS_Negative(udsServer.sid, UDS_NRC_RESPONSE_PENDING, rsp)) == HAL_OK) {
+            udsServer.pending = 1;
+            udsServer.pending_sent++;
+            next = UDS_P2X_SERVER_MS - UDS_P2_MARGIN_MS;
+        } else {
+            next = 1u;          // 메일박스 없음: 다음 tick 재시도
+        }
+    }
+    osKernelUnlock();
+    if (next != 0u) (void)osTimerStart(udsP2Timer, next);
+}
+
+/* S3: 진단 세션 유지 요청이 끊김 → default 세션 (처리 중이면 처리 끝에 다시 시작됨) */
+static void UDS_S3Expired(void *argument)
+{
+    (void)argument;
+    if (udsServer.busy || udsServer.session == UDS_SESSION_DEFAULT) return;
+    udsServer.session = UDS_SESSION_DEFAULT;
+    udsServer.sa_unlocked = 0;
+    udsServer.sa_seed_sent = 0;
+    udsServer.s3_timeouts++;
+    DVFS_SetDemand(DVFS_DEMAND_DIAG, 0);
+    PDID_StopAll(&pdidSched);
+}
+
+void UDS_Init(void)
+{
+    (void)Ring_Init(&udsRxRing, udsRxBuf, sizeof(UDS_RxFrame_t*), UDS_RX_RING_LEN);
+    (void)Pool_Init(&udsFramePool, "udsFrame", udsFrameMem, sizeof(UDS_RxFrame_t), UDS_RX_RING_LEN);
+    (void)Pool_Init(&udsReqPool, "udsReq", udsReqMem, UDS_REQ_MAX_LEN, UDS_REQ_BUFS);
+    (void)Pool_Init(&udsRspPool, "udsRsp", udsRspMem, ISOTP_MAX_LEN, UDS_RSP_BUFS);
+    udsP2Timer = osTimerNew(UDS_P2Expired, osTimerOnce, NULL, NULL);
+    udsS3Timer = osTimerNew(UDS_S3Expired, osTimerOnce, NULL, NULL);
+    PDID_Init(&pdidSched, &didTable, UDS_PeriodicSend);
+}
+
+void UDS_SetFdPort(const UDS_FdPort_t* port)
+{
+    udsFd = port;
+    udsLink.tx_dl = (port != NULL) ? port->tx_dl : 0u;
+}
+
+/* ===== 수신 ===== */
+
+/* 요청 프레임 1 개 (ISR 문맥, 풀 블록 소유권을 넘겨받음): 기능 주소 사전 판별 → udsRxRing.
+ * P2 는 수신 시점부터. 서버가 쉬고 있고 링이 비어 있으면 이 프레임이 다음 요청:
+ * UDSTask 가 EEPROM 기록 중이어도 0x78 이 나가도록 여기서 타이머 시작 (그 외는 UDS_Serve 가 남은 시간으로) */
+static void UDS_RxFrame(UDS_RxFrame_t* rx, BaseType_t* woken)
+{
+    const uint8_t* sf;
+
+    rx->rx_tick = xTaskGetTickCountFromISR();
+    rx->p2_armed = 0;
+    UDS_RxAction_t act = UDS_PreParse(rx->data, rx->len, rx->functional);
+    if (act == UDS_RX_DROP) {
+        udsServer.func_dropped++;
+        Pool_Free(&udsFramePool, rx);
+        return;
+    }
+    if (act == UDS_RX_KEEPALIVE) {
+        // 응답 없음: default 세션이면 할 일 없음
+        udsServer.func_keepalive++;
+        if (udsServer.session != UDS_SESSION_DEFAULT && udsS3Timer != NULL) {
+            (void)xTimerResetFromISR((TimerHandle_t)udsS3Timer, woken);
+        }
+        Pool_Free(&udsFramePool, rx);
+        return;
+    }
+
+    // 넣은 뒤의 블록은 UDSTask 소유: SID 는 미리 꺼내 둠
+    uint8_t single = (IsoTp_SingleData(rx->data, rx->len, &sf) != 0u);
+    uint8_t sid = single ? sf[0] : 0u;
+    uint8_t next = single && udsP2Timer != NULL && !udsServer.serving && !udsServer.busy && Ring_Count(&udsRxRing) == 0u;
+    rx->p2_armed = next;
+    if (Ring_Push(&udsRxRing, &rx, 1) == 0u) {            // 가득 참: dropped
+        Pool_Free(&udsFramePool, rx);
+        return;
+    }
+    if (next) {
+        udsServer.sid = sid;
+        udsServer.pending = 0;
+        udsServer.busy = 1;
+        (void)xTimerChangePeriodFromISR((TimerHandle_t)udsP2Timer,
+                                        pdMS_TO_TICKS(UDS_P2_SERVER_MS - UDS_P2_MARGIN_MS), woken);
+    }
+}
+
+/* 0x7E0/0x7DF 데이터 프레임만 큐로 (하드웨어 필터와 같은 조건을 한 번 더 확인) */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+    CAN_RxHeaderTypeDef rxHeader;
+    uint8_t data[ISOTP_FRAME_LEN];
+    BaseType_t woken = pdFALSE;
+
+    while (HAL_CAN_GetRxFifoFillLevel(hcan, CAN_RX_FIFO0) > 0u) {
+        if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rxHeader, data) != HAL_OK) break;
+        BUSREC(BusRec_BusOf(hcan), BUSREC_OP_RX,
+               (rxHeader.IDE == CAN_ID_STD) ? rxHeader.StdId : (rxHeader.ExtId | BUSREC_CAN_EXT), data, rxHeader.DLC);
+        DVFS_NotifyCanFrame();
+        if (rxHeader.IDE != CAN_ID_STD || rxHeader.RTR != CAN_RTR_DATA) continue;
+        if (rxHeader.StdId != UDS_REQ_CANID && rxHeader.StdId != UDS_FUNC_REQ_CANID) continue;
+        UDS_RxFrame_t* rx = Pool_Alloc(&udsFramePool, 0);
+        if (rx == NULL) continue;                           // 풀 고갈: exhausted
+        for (uint32_t i = 0; i < ISOTP_FRAME_LEN; i++) rx->data[i] = (i < rxHeader.DLC) ? data[i] : 0u;
+        rx->len = ISOTP_FRAME_LEN;
+        rx->functional = (rxHeader.StdId == UDS_FUNC_REQ_CANID);
+        UDS_RxFrame(rx, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+void UDS_FdRxFromISR(uint32_t stdId, const uint8_t* data, uint8_t len)
+{
+    BaseType_t woken = pdFALSE;
+
+    BUSREC(BUSREC_BUS_CAN1, BUSREC_OP_RX, stdId | BUSREC_CAN_FD, data, len);
+    DVFS_NotifyCanFrame();
+    if (stdId != UDS_REQ_CANID && stdId != UDS_FUNC_REQ_CANID) return;
+    if (len > ISOTP_FRAME_MAX) return;
+    UDS_RxFrame_t* rx = Pool_Alloc(&udsFramePool, 0);
+    if (rx == NULL) return;
+    memcpy(rx->data, data, len);
+    rx->len = len;
+    rx->functional = (stdId == UDS_FUNC_REQ_CANID);
+    UDS_RxFrame(rx, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/* ===== 서비스 ===== */
+
+static void UDS_EnterSession(uint8_t session)
+{
+    // 세션 전환 시 보안은 항상 잠김, 주기 응답 정지 (ISO 14229-1 9.2)
+    udsServer.session = session;
+    udsServer.sa_unlocked = 0;
+    udsServer.sa_seed_sent = 0;
+    PDID_StopAll(&pdidSched);
+    DVFS_SetDemand(DVFS_DEMAND_DIAG, session != UDS_SESSION_DEFAULT);
+    if (session == UDS_SESSION_DEFAULT) (void)osTimerStop(udsS3Timer);
+}
+
+/* 0x10: 50 sub P2(ms) P2*(10ms). programming 세션은 부트로더 (Bootloader/) 에서만:
+ * 앱 → 부트로더 전환이 없으므로 조건 불충족 */
+static uint16_t UDS_SessionControl(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len != 2u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    uint8_t sub = req[1] & 0x7Fu;
+    if (sub == UDS_SESSION_PROGRAMMING) return UDS_Negative(req[0], UDS_NRC_CONDITIONS_NOT_CORRECT, rsp);
+
+    UDS_EnterSession(sub);
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    rsp[1] = sub;
+    rsp[2] = (uint8_t)(UDS_P2_SERVER_MS >> 8);
+    rsp[3] = (uint8_t)UDS_P2_SERVER_MS;
+    rsp[4] = (uint8_t)((UDS_P2X_SERVER_MS / 10u) >> 8);
+    rsp[5] = (uint8_t)(UDS_P2X_SERVER_MS / 10u);
+    return 6;
+}
+
+uint32_t UDS_SecurityKey(uint32_t seed)
+{
+    return ((seed << 7) | (seed >> 25)) ^ UDS_SA_KEY_MASK;
+}
+
+/* xorshift32 + 수신 tick: 0 이 아닌 seed */
+static uint32_t UDS_NextSeed(void)
+{
+    uint32_t x = udsServer.seed_state ^ osKernelGetTickCount();
+    do {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    } while (x == 0u);
+    udsServer.seed_state = x;
+    return x;
+}
+
+/* 0x27: level 1 (01 requestSeed / 02 sendKey), default 세션에서는 불가 */
+static uint16_t UDS_SecurityAccess(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len < 2u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    if (udsServer.session == UDS_SESSION_DEFAULT) return UDS_Negative(req[0], UDS_NRC_SERVICE_NOT_IN_SESSION, rsp);
+
+    uint8_t sub = req[1] & 0x7Fu;
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    rsp[1] = sub;
+
+    if (sub == UDS_SA_LEVEL) {
+        if (len != 2u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+        if (udsServer.sa_delay_until != 0u && (int32_t)(osKernelGetTickCount() - udsServer.sa_delay_until) < 0) {
+            return UDS_Negative(req[0], UDS_NRC_TIME_DELAY_NOT_EXPIRED, rsp);
+        }
+        udsServer.sa_delay_until = 0;
+        // 이미 해제된 레벨: seed 0
+        uint32_t seed = (udsServer.sa_unlocked == UDS_SA_LEVEL) ? 0u : UDS_NextSeed();
+        udsServer.sa_seed = seed;
+        udsServer.sa_seed_sent = (seed != 0u);
+        rsp[2] = (uint8_t)(seed >> 24); rsp[3] = (uint8_t)(seed >> 16);
+        rsp[4] = (uint8_t)(seed >> 8);  rsp[5] = (uint8_t)seed;
+        return 6;
+    }
+    if (sub == UDS_SA_LEVEL + 1u) {
+        if (len != 6u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+        if (!udsServer.sa_seed_sent) return UDS_Negative(req[0], UDS_NRC_REQUEST_SEQUENCE_ERROR, rsp);
+        udsServer.sa_seed_sent = 0;     // seed 는 key 1 회에만 유효
+
+        uint32_t key = ((uint32_t)req[2] << 24) | ((uint32_t)req[3] << 16) | ((uint32_t)req[4] << 8) | req[5];
+        if (key != UDS_SecurityKey(udsServer.sa_seed)) {
+            if (++udsServer.sa_attempts >= UDS_SA_MAX_ATTEMPTS) {
+                udsServer.sa_attempts = 0;
+                udsServer.sa_delay_until = osKernelGetTickCount() + UDS_SA_DELAY_MS;
+                if (udsServer.sa_delay_until == 0u) udsServer.sa_delay_until = 1u;
+                return UDS_Negative(req[0], UDS_NRC_EXCEEDED_ATTEMPTS, rsp);
+            }
+            return UDS_Negative(req[0], UDS_NRC_INVALID_KEY, rsp);
+        }
+        udsServer.sa_attempts = 0;
+        udsServer.sa_unlocked = UDS_SA_LEVEL;
+        return 2;
+    }
+    return UDS_Negative(req[0], UDS_NRC_SUBFUNC_NOT_SUPPORTED, rsp);
+}
+
+/* 0x3E 00: 세션 유지 (S3 재시작은 요청 공통 처리) */
+static uint16_t UDS_TesterPresent(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len != 2u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    rsp[1] = 0x00;
+    return 2;
+}
+
+/* 0x19: 01 개수 / 02 목록 (DTC 메모리 전체, 길이에 따라 멀티 프레임) */
+static uint16_t UDS_ReadDtcInfo(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    DTC_Record_t rec[DTCMEM_SLOTS];
+
+    if (len != 3u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    if (!DTCMem_Ready(&dtcMem)) return UDS_Negative(req[0], UDS_NRC_CONDITIONS_NOT_CORRECT, rsp);
+
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    rsp[1] = req[1];
+    rsp[2] = DTCMEM_STATUS_AVAIL;
+    if (req[1] == UDS_RDI_REPORT_NUM_BY_STATUS_MASK) {
+        uint16_t n = DTCMem_CountByMask(&dtcMem, req[2]);
+        rsp[3] = UDS_DTC_FORMAT_ISO14229_1;
+        rsp[4] = (uint8_t)(n >> 8);
+        rsp[5] = (uint8_t)n;
+        return 6;
+    }
+
+    // 59 02 avail + 4B/DTC (slot 24 개 → 최대 99B)
+    uint16_t n = DTCMem_ReadByMask(&dtcMem, req[2], rec, DTCMEM_SLOTS);
+    if (3u + 4u * (uint32_t)n > ISOTP_MAX_LEN) return UDS_Negative(req[0], UDS_NRC_RESPONSE_TOO_LONG, rsp);
+    for (uint16_t i = 0; i < n; i++) {
+        uint8_t* p = &rsp[3u + 4u * i];
+        p[0] = rec[i].dtc[0]; p[1] = rec[i].dtc[1]; p[2] = rec[i].dtc[2]; p[3] = rec[i].status;
+    }
+    return (uint16_t)(3u + 4u * n);
+}
+
+/* 0x14: 전체 그룹(FFFFFF)만. EEPROM 반영 후 긍정 응답 (P2 를 넘기면 타이머가 0x78) */
+static uint16_t UDS_ClearDiagInfo(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len != 4u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    if (req[1] != 0xFFu || req[2] != 0xFFu || req[3] != 0xFFu) {
+        return UDS_Negative(req[0], UDS_NRC_REQUEST_OUT_OF_RANGE, rsp);
+    }
+    if (!DTCMem_Ready(&dtcMem)) return UDS_Negative(req[0], UDS_NRC_CONDITIONS_NOT_CORRECT, rsp);
+
+    DTCMem_Clear(&dtcMem);
+    if (DTCMem_Flush(&dtcMem) != HAL_OK) return UDS_Negative(req[0], UDS_NRC_GENERAL_PROGRAMMING_FAIL, rsp);
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    return 1;
+}
+
+/* 0x22: DID 여러 개 → 응답 하나 (길이에 따라 멀티 프레임) */
+static uint16_t UDS_ReadDataById(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    uint16_t n = 0;
+    uint8_t nrc = DID_ReadRequest(&didTable, &req[1], (uint16_t)(len - 1u), &rsp[1], ISOTP_MAX_LEN - 1u, &n);
+
+    if (nrc != 0u) return UDS_Negative(req[0], nrc, rsp);
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    return (uint16_t)(n + 1u);
+}
+
+/* 0x2E: 6E DID */
+static uint16_t UDS_WriteDataById(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    uint8_t nrc = DID_WriteRequest(&didTable, &req[1], (uint16_t)(len - 1u),
+                                   udsServer.session, udsServer.sa_unlocked != 0u);
+
+    if (nrc != 0u) return UDS_Negative(req[0], nrc, rsp);
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    rsp[1] = req[1];
+    rsp[2] = req[2];
+    return 3;
+}
+
+/* 0x2A: 6A (주기 응답은 PDID 스케줄러가 UDS_PERIODIC_CANID 로 보냄) */
+static uint16_t UDS_ReadDataByPeriodicId(const uint8_t* req, uint16_t len, uint8_t* rsp)
+{
+    if (len < 2u) return UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    if (udsServer.session == UDS_SESSION_DEFAULT) return UDS_Negative(req[0], UDS_NRC_SERVICE_NOT_IN_SESSION, rsp);
+
+    uint8_t nrc = PDID_Request(&pdidSched, &req[1], (uint16_t)(len - 1u));
+    if (nrc != 0u) return UDS_Negative(req[0], nrc, rsp);
+    rsp[0] = (uint8_t)(req[0] + UDS_POSITIVE_OFFSET);
+    return 1;
+}
+
+/* ===== 서비스 표 ===== */
+
+#define UDS_SVCF_SUB       0x01u    // 서브펑션 있음 (지원 여부는 subs 로 먼저 확인)
+#define UDS_SVCF_SPRMIB    0x02u    // 서브펑션 bit 7 = suppressPosRspMsgIndicationBit
+
+typedef struct {
+    uint8_t  sid;
+    uint8_t  flags;                 // UDS_SVCF_*
+    uint32_t subs;                  // 지원 서브펑션 bit (SPRMIB 제외 값 < 32)
+    uint16_t (*handler)(const uint8_t* req, uint16_t len, uint8_t* rsp);
+} UDS_Service_t;
+
+#define UDS_SUB(x)  (1uL << (x))
+
+static const UDS_Service_t udsServices[] = {
+    { UDS_SVC_SESSION_CONTROL, UDS_SVCF_SUB | UDS_SVCF_SPRMIB,
+      UDS_SUB(UDS_SESSION_DEFAULT) | UDS_SUB(UDS_SESSION_PROGRAMMING) | UDS_SUB(UDS_SESSION_EXTENDED), UDS_SessionControl },
+    { UDS_SVC_SECURITY_ACCESS, UDS_SVCF_SUB | UDS_SVCF_SPRMIB,
+      UDS_SUB(UDS_SA_LEVEL) | UDS_SUB(UDS_SA_LEVEL + 1u),                                              UDS_SecurityAccess },
+    { UDS_SVC_TESTER_PRESENT,  UDS_SVCF_SUB | UDS_SVCF_SPRMIB, UDS_SUB(0x00u),                         UDS_TesterPresent },
+    // 0x19 응답에는 데이터가 있으므로 SPRMIB 없음 (bit 7 이 켜진 서브펑션은 미지원)
+    { UDS_SVC_READ_DTC_INFO,   UDS_SVCF_SUB,
+      UDS_SUB(UDS_RDI_REPORT_NUM_BY_STATUS_MASK) | UDS_SUB(UDS_RDI_REPORT_DTC_BY_STATUS_MASK),         UDS_ReadDtcInfo },
+    { UDS_SVC_CLEAR_DIAG_INFO, 0u,                             0u,                                     UDS_ClearDiagInfo },
+    { UDS_SVC_READ_DID,        0u,                             0u,                                     UDS_ReadDataById },
+    { UDS_SVC_READ_PERIODIC_DID, 0u,                           0u,                                     UDS_ReadDataByPeriodicId },
+    { UDS_SVC_WRITE_DID,       0u,                             0u,                                     UDS_WriteDataById },
+};
+
+static const UDS_Service_t* UDS_FindService(uint8_t sid)
+{
+    for (uint32_t i = 0; i < sizeof(udsServices) / sizeof(udsServices[0]); i++) {
+        if (udsServices[i].sid == sid) return &udsServices[i];
+    }
+    return NULL;
+}
+
+static uint8_t UDS_SubSupported(const UDS_Service_t* s, uint8_t sub)
+{
+    if (s->flags & UDS_SVCF_SPRMIB) sub &= (uint8_t)~UDS_SPRMIB;
+    return (sub < 32u) && (s->subs & UDS_SUB(sub)) != 0u;
+}
+
+/* 기능 주소: 응답하지 않을 요청은 큐에 넣기 전에 끝냄 (ISO 14229-1 7.5, ISO 15765-2 기능 주소는 SF 만) */
+UDS_RxAction_t UDS_PreParse(const uint8_t* frame, uint8_t len, uint8_t functional)
+{
+    const uint8_t* req;
+
+    if (!functional) return UDS_RX_QUEUE;
+    uint8_t n = IsoTp_SingleData(frame, len, &req);
+    if (n == 0u) return UDS_RX_DROP;
+
+    const UDS_Service_t* s = UDS_FindService(req[0]);
+    if (s == NULL) return UDS_RX_DROP;                                  // 0x11 생략
+    if ((s->flags & UDS_SVCF_SUB) && n >= 2u && !UDS_SubSupported(s, req[1])) return UDS_RX_DROP;   // 0x12 생략
+    if (req[0] == UDS_SVC_TESTER_PRESENT && n == 2u && req[1] == UDS_SPRMIB) return UDS_RX_KEEPALIVE;
+    return UDS_RX_QUEUE;
+}
+
+uint16_t UDS_HandleRequest(const uint8_t* req, uint16_t len, uint8_t functional, uint8_t* rsp, uint8_t* suppressed)
+{
+    uint16_t n;
+
+    *suppressed = 0;
+    if (len == 0u) return 0;
+
+    const UDS_Service_t* s = UDS_FindService(req[0]);
+    if (s == NULL)                                          n = UDS_Negative(req[0], UDS_NRC_SERVICE_NOT_SUPPORTED, rsp);
+    else if ((s->flags & UDS_SVCF_SUB) && len < 2u)         n = UDS_Negative(req[0], UDS_NRC_INCORRECT_LENGTH, rsp);
+    else if ((s->flags & UDS_SVCF_SUB) && !UDS_SubSupported(s, req[1])) n = UDS_Negative(req[0], UDS_NRC_SUBFUNC_NOT_SUPPORTED, rsp);
+    else                                                    n = s->handler(req, len, rsp);
+
+    if (rsp[0] != UDS_SID_NEGATIVE_RESPONSE) {
+        *suppressed = (s->flags & UDS_SVCF_SPRMIB) && (req[1] & UDS_SPRMIB);
+    } else if (functional) {
+        uint8_t nrc = rsp[2];
+        *suppressed = (nrc == UDS_NRC_SERVICE_NOT_SUPPORTED || nrc == UDS_NRC_SUBFUNC_NOT_SUPPORTED ||
+                       nrc == UDS_NRC_REQUEST_OUT_OF_RANGE || nrc == UDS_NRC_SUBFUNC_NOT_IN_SESSION ||
+                       nrc == UDS_NRC_SERVICE_NOT_IN_SESSION);
+    }
+    return n;
+}
+
+/* 최종 응답: P2 타이머 정지 → (kernel lock 안에서) 첫 프레임 송신 + busy 해제.
+ * 생략 가능한 응답도 0x78 을 이미 보냈으면 보냄 (lock 안에서 판단: 타이머 만료와 경합하지 않도록)
+ * 멀티 프레임: FF 이후 FC/CF 는 lock 밖에서 (busy 해제 → 0x78 과 섞이지 않음)
+ * 메일박스 공유(파이프라인 CAN Task): 빈 메일박스가 생길 때까지 1 tick 간격 재시도 */
+static void UDS_SendFinal(const uint8_t* rsp, uint16_t len, uint8_t suppressed)
+{
+    uint8_t frame[ISOTP_FRAME_MAX];
+    uint8_t flen;
+    uint16_t sent = 0;
+
+    (void)osTimerStop(udsP2Timer);
+    for (uint32_t retry = 0; retry < 10u; retry++) {
+        HAL_StatusTypeDef st = HAL_OK;
+        osKernelLock();
+        if (suppressed && !udsServer.pending && len != 0u) {
+            len = 0;
+            udsServer.suppressed++;
+        }
+        if (len != 0u) {
+            sent = IsoTp_FirstFrame(&udsLink, rsp, len, frame, &flen);
+            st = UDS_LinkSend(frame, flen);
+        }
+        if (st == HAL_OK) udsServer.busy = 0;
+        osKernelUnlock();
+        if (st == HAL_OK) {
+            if (sent < len) (void)IsoTp_SendRest(&udsLink, rsp, len, sent);
+            return;
+        }
+        osDelay(1);
+    }
+    udsServer.busy = 0;
+}
+
+/* P2 시작 (UDSTask): 수신 tick 부터 남은 시간. 이미 지났으면 다음 tick 에 0x78 */
+static void UDS_ArmP2(uint8_t sid, uint32_t rxTick)
+{
+    uint32_t spent = osKernelGetTickCount() - rxTick;
+    uint32_t limit = UDS_P2_SERVER_MS - UDS_P2_MARGIN_MS;
+
+    udsServer.sid = sid;
+    udsServer.pending = 0;
+    udsServer.busy = 1;
+    (void)osTimerStart(udsP2Timer, (spent < limit) ? (limit - spent) : 1u);
+}
+
+/* 요청 1 개: 첫 프레임 (SF/FF) → 재조립 → 처리 → 응답. 요청/응답 버퍼는 요청마다 풀에서.
+ * block: 첫 프레임의 수신 풀 블록 (재조립 중 들어온 요청은 NULL), 첫 프레임을 읽은 뒤 해제 */
+static void UDS_Serve(const UDS_RxFrame_t* first, UDS_RxFrame_t* block)
+{
+    uint16_t len;
+    uint8_t suppressed;
+    uint8_t functional = first->functional;
+    uint8_t armed = first->p2_armed;             // 블록은 첫 프레임을 읽은 뒤 해제
+    uint32_t rxTick = first->rx_tick;
+    uint8_t type = IsoTp_FrameType(first->data, first->len);
+    uint8_t* req = NULL;
+    uint8_t* rsp = NULL;
+    HAL_StatusTypeDef st = HAL_ERROR;
+
+    // 요청은 SF/FF 로 시작 (단독 CF/FC 는 무시)
+    if (type == ISOTP_PCI_SF || type == ISOTP_PCI_FF) {
+        req = Pool_Alloc(&udsReqPool, 0);
+        if (req != NULL) st = IsoTp_Receive(&udsLink, first->data, first->len, req, UDS_REQ_MAX_LEN, &len);
+    }
+    Pool_Free(&udsFramePool, block);
+    if (st == HAL_OK) rsp = Pool_Alloc(&udsRspPool, 0);
+
+    if (rsp != NULL) {
+        // 멀티 프레임 요청: P2 는 마지막 CF 수신부터
+        if (type == ISOTP_PCI_FF)   UDS_ArmP2(req[0], udsLastRxTick);
+        else if (!armed)            UDS_ArmP2(req[0], rxTick);
+        uint16_t n = UDS_HandleRequest(req, len, functional, rsp, &suppressed);
+        udsServer.requests++;
+        if (functional) udsServer.func_requests++;
+        // 진단 세션 유지: 응답을 보내기 전에 S3 재시작 (만료 콜백과 경합하지 않도록)
+        if (udsServer.session != UDS_SESSION_DEFAULT) (void)osTimerStart(udsS3Timer, UDS_S3_SERVER_MS);
+        UDS_SendFinal(rsp, n, suppressed);
+    } else if (armed) {
+        // 수신 콜백이 시작한 P2: 응답할 요청이 아님
+        (void)osTimerStop(udsP2Timer);
+        udsServer.busy = 0;
+    }
+    Pool_Free(&udsRspPool, rsp);
+    Pool_Free(&udsReqPool, req);
+}
+
+void StartUDSTask(void *argument)
+{
+    UDS_RxFrame_t held;
+    UDS_RxFrame_t* rx;
+
+    (void)argument;
+    Ring_SetNotify(&udsRxRing, osThreadGetId(), UDS_FLAG_RX);
+
+    // index 1 회 읽기(무효 시 slot 영역 scan) → 그 즉시 요청 처리 가능
+    while (DTCMem_Mount(&dtcMem) != HAL_OK) {
+        osDelay(UDS_IDLE_MS);
+    }
+
+    for (;;)
+    {
+        // slot 상세 로드 전에는 쌓인 요청만 비우고 바로 로드
+        uint32_t wait = dtcMem.details ? UDS_IDLE_MS : 0u;
+
+        if (udsLink.held_valid) {
+            // 재조립 중 들어온 새 요청
+            memcpy(held.data, udsLink.held, udsLink.held_len);
+            held.len = udsLink.held_len;
+            held.functional = 0;
+            held.p2_armed = 0;
+            held.rx_tick = udsLastRxTick;
+            udsLink.held_valid = 0;
+            udsServer.serving = 1;
+            UDS_Serve(&held, NULL);
+            udsServer.serving = 0;
+            continue;
+        }
+        if (Ring_Wait(&udsRxRing, wait) == HAL_OK) {
+            // pop 전에 표시: 꺼낸 뒤 들어온 요청을 콜백이 "다음 요청" 으로 착각하지 않도록
+            udsServer.serving = 1;
+            if (Ring_Pop(&udsRxRing, &rx, 1) != 0u) {
+                UDS_Serve(rx, rx);
+                udsServer.serving = 0;
+                continue;
+            }
+            udsServer.serving = 0;
+        }
+
+        if (!dtcMem.details)                (void)DTCMem_LoadDetails(&dtcMem);
+        else if (DTCMem_Pending(&dtcMem))   (void)DTCMem_Flush(&dtcMem);
+    }
+}
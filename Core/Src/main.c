@@ -2,6 +2,8 @@
 
 #include "main.h"
 #include "cmsis_os.h"
+#include "Trace.h"
+#include "BusRec.h"
 
 /* =========================
  * FreeRTOS Event Flags
@@ -16,6 +18,8 @@
  * (stm32f4xx_it.c 에서 extern 으로 참조)
  * ========================= */
 ADC_HandleTypeDef   hadc1;
+DMA_HandleTypeDef   hdma_adc1;
+TIM_HandleTypeDef   htim2;
 CAN_HandleTypeDef   hcan1;
 
 I2C_HandleTypeDef   hi2c1;
@@ -39,8 +43,8 @@ UART_HandleTypeDef  huart4;
  * (필요 시 tasks.c 에서 extern 로 참조)
  * ========================= */
 osEventFlagsId_t    CommEventFlagHandle;
-osMutexId_t         CommMutexHandleHandle;
-osMessageQueueId_t  CanQueueHandle;
+osMutexId_t         CommMutexHandle;
+osMessageQueueId_t  LogQueueHandle;
 
 /* =========================
  * RTOS Thread Handles
@@ -50,6 +54,22 @@ osThreadId_t I2CTaskHandle;
 osThreadId_t SPITaskHandle;
 osThreadId_t CANTaskHandle;
 osThreadId_t UARTTaskHandle;
+osThreadId_t SupplyMonTaskHandle;
+osThreadId_t DvfsTaskHandle;
+osThreadId_t LogTaskHandle;
+osThreadId_t EECacheTaskHandle;
+osThreadId_t UDSTaskHandle;
+
+/* =========================
+ * Bus Devices (BusMgr 레지스트리, 등록 순서 = 디바이스 id)
+ * ========================= */
+static const BusDev_t boardDevices[] = {
+  { "pmic0",   BUSDEV_PMIC,      BUS_I2C1, I2C_SLAVE_ADDRESS, NULL,               0            },
+  { "pmic1",   BUSDEV_PMIC,      BUS_I2C2, I2C_SLAVE_ADDRESS, NULL,               0            },
+  { "eeprom0", BUSDEV_EEPROM,    BUS_SPI1, 0,                 NULL,               0            },   // 보드 레벨 CS
+  { "eeprom1", BUSDEV_EEPROM,    BUS_SPI2, 0,                 EE2_CS_GPIO_Port,   EE2_CS_Pin   },
+  { "flash0",  BUSDEV_SPI_FLASH, BUS_SPI2, 0,                 FLASH_CS_GPIO_Port, FLASH_CS_Pin },
+};
 
 /* =========================
  * Function Prototypes
@@ -58,6 +78,7 @@ void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_DMA_Init(void);
 static void MX_ADC1_Init(void);
+static void MX_TIM2_Init(void);
 static void MX_CAN1_Init(void);
 static void MX_I2C1_Init(void);
 static void MX_I2C2_Init(void);
@@ -76,6 +97,7 @@ int main(void)
   MX_GPIO_Init();
   MX_DMA_Init();
   MX_ADC1_Init();
+  MX_TIM2_Init();
   MX_CAN1_Init();
   MX_I2C1_Init();
   MX_I2C2_Init();
@@ -83,40 +105,100 @@ int main(void)
   MX_SPI2_Init();
   MX_UART4_Init();
 
+  // === Fault→Bus 지연 trace (DWT CYCCNT) ===
+  Trace_Init();
+
+  // === CAN/I2C/SPI 트래픽 기록 (UART4 'B' 로 덤프, 호스트에서 재생) ===
+  BusRec_Init();
+
+  // === 스택/heap 감시: 이전 부팅의 오버플로 기록 확인 + MSP 예약 영역 채우기 ===
+  StackMon_Init();
+
+  // === MPU: region 배치 검사 + Task 별 설정 계산, 스케줄러 시작 전까지는 전부 RW ===
+  Mpu_Init();
+
+  // === PMIC 레지스터 캐시 (I2CTask, DvfsTask 공유) + DVFS 초기 상태 ===
+  PMIC_ShadowInit(&pmicShadow, &hi2c1);
+  DVFS_Init();
+
   // === RTOS 커널 초기화 ===
   osKernelInitialize();
 
   // === 커널 객체 생성 ===
   CommEventFlagHandle     = osEventFlagsNew(NULL);
-  CommMutexHandleHandle   = osMutexNew(NULL);
-  CanQueueHandle          = osMessageQueueNew(8, 8, NULL);
+  CommMutexHandle         = osMutexNew(NULL);
+  LogQueueHandle          = osMessageQueueNew(FLASHLOG_QUEUE_DEPTH, sizeof(FlashLog_Msg_t), NULL);
+
+  // === 버스 관리자: I2C1/SPI1 은 파이프라인 Task 와 CommMutex 공유, I2C2/SPI2 는 독립 ===
+  BusMgr_Init();
+  BusMgr_ShareLock(BUS_I2C1, CommMutexHandle);
+  BusMgr_ShareLock(BUS_SPI1, CommMutexHandle);
+  for (uint32_t i = 0; i < sizeof(boardDevices) / sizeof(boardDevices[0]); i++) {
+    if (BusMgr_Register(&boardDevices[i]) < 0) { Error_Handler(); }
+  }
+  EECache_Init(&eeCache, BusMgr_Find("eeprom0"));
+  DTCMem_Init(&dtcMem, BusMgr_Find("eeprom0"));
+  UDS_Init();
+  if (DID_CheckTable(&didTable) != HAL_OK) { Error_Handler(); }
 
   // === Task 생성 (엔트리 함수는 tasks.c 에 구현) ===
   const osThreadAttr_t defaultTask_attributes = {
-    .name = "defaultTask", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityNormal,
+    .name = "defaultTask", .stack_size = TASK_STACK_DEFAULT, .priority = (osPriority_t)osPriorityNormal,
   };
   defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
 
   const osThreadAttr_t I2CTask_attributes = {
-    .name = "I2CTask", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityNormal,
+    .name = "I2CTask", .stack_size = TASK_STACK_I2C, .priority = (osPriority_t)osPriorityNormal,
   };
   I2CTaskHandle = osThreadNew(StartI2CTask, NULL, &I2CTask_attributes);
 
   const osThreadAttr_t SPITask_attributes = {
-    .name = "SPITask", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityNormal,
+    .name = "SPITask", .stack_size = TASK_STACK_SPI, .priority = (osPriority_t)osPriorityNormal,
   };
   SPITaskHandle = osThreadNew(StartSPITask, NULL, &SPITask_attributes);
 
   const osThreadAttr_t CANTask_attributes = {
-    .name = "CANTask", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityNormal,
+    .name = "CANTask", .stack_size = TASK_STACK_CAN, .priority = (osPriority_t)osPriorityNormal,
   };
   CANTaskHandle = osThreadNew(StartCANTask, NULL, &CANTask_attributes);
 
   const osThreadAttr_t UARTTask_attributes = {
-    .name = "UARTTask", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityNormal,
+    .name = "UARTTask", .stack_size = TASK_STACK_UART, .priority = (osPriority_t)osPriorityNormal,
   };
   UARTTaskHandle = osThreadNew(StartUARTTask, NULL, &UARTTask_attributes);
 
+  const osThreadAttr_t SupplyMonTask_attributes = {
+    .name = "SupplyMonTask", .stack_size = TASK_STACK_SUPPLYMON, .priority = (osPriority_t)osPriorityAboveNormal,
+  };
+  SupplyMonTaskHandle = osThreadNew(StartSupplyMonTask, NULL, &SupplyMonTask_attributes);
+
+  const osThreadAttr_t DvfsTask_attributes = {
+    .name = "DvfsTask", .stack_size = TASK_STACK_DVFS, .priority = (osPriority_t)osPriorityBelowNormal,
+  };
+  DvfsTaskHandle = osThreadNew(StartDvfsTask, NULL, &DvfsTask_attributes);
+
+  const osThreadAttr_t LogTask_attributes = {
+    .name = "LogTask", .stack_size = TASK_STACK_LOG, .priority = (osPriority_t)osPriorityLow,
+  };
+  LogTaskHandle = osThreadNew(StartLogTask, NULL, &LogTask_attributes);
+
+  const osThreadAttr_t EECacheTask_attributes = {
+    .name = "EECacheTask", .stack_size = TASK_STACK_EECACHE, .priority = (osPriority_t)osPriorityAboveNormal,
+  };
+  EECacheTaskHandle = osThreadNew(StartEECacheTask, NULL, &EECacheTask_attributes);
+
+  const osThreadAttr_t UDSTask_attributes = {
+    .name = "UDSTask", .stack_size = TASK_STACK_UDS, .priority = (osPriority_t)osPriorityAboveNormal,
+  };
+  UDSTaskHandle = osThreadNew(StartUDSTask, NULL, &UDSTask_attributes);
+
+  // === MPU domain: dtcMem/eeCache 쓰기 = 저장 서비스 3 개 + I2C/SPI 파이프라인 (자기 slice 포함). 나머지는 읽기 전용 ===
+  Mpu_Attach(defaultTaskHandle, MPU_DOM_STORAGE);
+  Mpu_Attach(I2CTaskHandle, MPU_DOM_I2C);
+  Mpu_Attach(SPITaskHandle, MPU_DOM_SPI);
+  Mpu_Attach(EECacheTaskHandle, MPU_DOM_STORAGE);
+  Mpu_Attach(UDSTaskHandle, MPU_DOM_STORAGE);
+
   // === RTOS 시작 ===
   osKernelStart();
 
@@ -160,7 +242,7 @@ static void MX_GPIO_Init(void)
   __HAL_RCC_GPIOB_CLK_ENABLE();
   __HAL_RCC_GPIOG_CLK_ENABLE();
 
-  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_2, GPIO_PIN_SET);
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_2|EE2_CS_Pin|FLASH_CS_Pin, GPIO_PIN_SET);
 
   GPIO_InitStruct.Pin = GPIO_PIN_0|GPIO_PIN_1;
   GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
@@ -173,6 +255,12 @@ static void MX_GPIO_Init(void)
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_MEDIUM;
   HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+  GPIO_InitStruct.Pin = EE2_CS_Pin|FLASH_CS_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init(EE2_CS_GPIO_Port, &GPIO_InitStruct);
 }
 
 static void MX_DMA_Init(void)
@@ -202,9 +290,13 @@ static void MX_DMA_Init(void)
   HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 5, 0);
   HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
 
-  // 필요 시만 0 우선순위 사용 (타이밍 중요 DMA) — FreeRTOS API 호출 금지 ISR
-  HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 0, 0);
+  // SPI1 TX (BusMgr EEPROM 쓰기): 완료 콜백이 Task 에 thread flag
+  HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 5, 0);
   HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
+
+  // ADC1 순환 DMA (공급 전압 감시, 반/완료 인터럽트에서 태스크 통지)
+  HAL_NVIC_SetPriority(DMA2_Stream4_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream4_IRQn);
 }
 
 static void MX_ADC1_Init(void)
@@ -217,20 +309,43 @@ static void MX_ADC1_Init(void)
   hadc1.Init.ScanConvMode          = DISABLE;
   hadc1.Init.ContinuousConvMode    = DISABLE;
   hadc1.Init.DiscontinuousConvMode = DISABLE;
-  hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;
-  hadc1.Init.ExternalTrigConv      = ADC_SOFTWARE_START;
+  // TIM2 TRGO 로 변환 시작 → DMA 순환 모드 (샘플당 CPU 개입 없음)
+  hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;
+  hadc1.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T2_TRGO;
   hadc1.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
   hadc1.Init.NbrOfConversion       = 1;
-  hadc1.Init.DMAContinuousRequests = DISABLE;
-  hadc1.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;
+  hadc1.Init.DMAContinuousRequests = ENABLE;
+  hadc1.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
   if (HAL_ADC_Init(&hadc1) != HAL_OK) { Error_Handler(); }
 
   sConfig.Channel      = ADC_CHANNEL_2;
   sConfig.Rank         = 1;
-  sConfig.SamplingTime = ADC_SAMPLETIME_3CYCLES;
+  sConfig.SamplingTime = ADC_SAMPLETIME_84CYCLES;   // 분압 저항(고임피던스) 소스
   if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK) { Error_Handler(); }
 }
 
+/* ADC1 트리거: 16MHz / (0+1) / (1249+1) = 12.8kHz */
+static void MX_TIM2_Init(void)
+{
+  TIM_ClockConfigTypeDef  sClockSourceConfig = {0};
+  TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+  htim2.Instance = TIM2;
+  htim2.Init.Prescaler         = 0;
+  htim2.Init.CounterMode       = TIM_COUNTERMODE_UP;
+  htim2.Init.Period            = 1249;
+  htim2.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_Base_Init(&htim2) != HAL_OK) { Error_Handler(); }
+
+  sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+  if (HAL_TIM_ConfigClockSource(&htim2, &sClockSourceConfig) != HAL_OK) { Error_Handler(); }
+
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+  sMasterConfig.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+  if (HAL_TIMEx_MasterConfigSynchronization(&htim2, &sMasterConfig) != HAL_OK) { Error_Handler(); }
+}
+
 static void MX_CAN1_Init(void)
 {
   hcan1.Instance = CAN1;
@@ -247,6 +362,29 @@ static void MX_CAN1_Init(void)
   hcan1.Init.TransmitFifoPriority= DISABLE;
   if (HAL_CAN_Init(&hcan1) != HAL_OK) { Error_Handler(); }
 
+  // UDS 물리 요청(0x7E0) → FIFO0: bank 0, 32-bit ID/mask (StdId 11 비트 + IDE/RTR = 표준 데이터 프레임)
+  CAN_FilterTypeDef sFilterConfig = {0};
+  sFilterConfig.FilterBank           = 0;
+  sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
+  sFilterConfig.FilterScale          = CAN_FILTERSCALE_32BIT;
+  sFilterConfig.FilterIdHigh         = UDS_REQ_CANID << 5;
+  sFilterConfig.FilterIdLow          = 0x0000;
+  sFilterConfig.FilterMaskIdHigh     = 0x7FFu << 5;
+  sFilterConfig.FilterMaskIdLow      = 0x0006;
+  sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+  sFilterConfig.FilterActivation     = ENABLE;
+  sFilterConfig.SlaveStartFilterBank = 14;
+  if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+  // UDS 기능 요청(0x7DF) → FIFO0: bank 1, 같은 마스크
+  sFilterConfig.FilterBank           = 1;
+  sFilterConfig.FilterIdHigh         = UDS_FUNC_REQ_CANID << 5;
+  if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+  // CAN Task 송신이 버스에 나가도록 시작 + TX 완료 인터럽트 (trace 훅) + UDS 요청 수신
+  if (HAL_CAN_Start(&hcan1) != HAL_OK) { Error_Handler(); }
+  if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_TX_MAILBOX_EMPTY | CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK) { Error_Handler(); }
+
   // CAN IRQ 활성화 (stm32f4xx_it.c 에서 HAL_CAN_IRQHandler 사용)
   HAL_NVIC_SetPriority(CAN1_TX_IRQn, 5, 0);
   HAL_NVIC_EnableIRQ(CAN1_TX_IRQn);
@@ -257,7 +395,7 @@ static void MX_CAN1_Init(void)
 static void MX_I2C1_Init(void)
 {
   hi2c1.Instance             = I2C1;
-  hi2c1.Init.ClockSpeed      = 100000;
+  hi2c1.Init.ClockSpeed      = 400000;   // Fast-mode (MP5475 지원, PCLK1 16MHz ≥ 4MHz)
   hi2c1.Init.DutyCycle       = I2C_DUTYCYCLE_2;
   hi2c1.Init.OwnAddress1     = 0;
   hi2c1.Init.AddressingMode  = I2C_ADDRESSINGMODE_7BIT;
@@ -276,7 +414,7 @@ static void MX_I2C1_Init(void)
 static void MX_I2C2_Init(void)
 {
   hi2c2.Instance             = I2C2;
-  hi2c2.Init.ClockSpeed      = 100000;
+  hi2c2.Init.ClockSpeed      = 400000;   // 두 번째 MP5475: Fast-mode
   hi2c2.Init.DutyCycle       = I2C_DUTYCYCLE_2;
   hi2c2.Init.OwnAddress1     = 0;
   hi2c2.Init.AddressingMode  = I2C_ADDRESSINGMODE_7BIT;
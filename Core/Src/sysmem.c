@@ -30,6 +30,12 @@
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/**
+ * Number of _sbrk() requests refused because they would reach the MSP reservation
+ * (reported by StackMon_Dump, newlib malloc returns NULL instead of overwriting the stack)
+ */
+uint32_t __sbrk_refused = 0;
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -69,6 +75,7 @@ void *_sbrk(ptrdiff_t incr)
   /* Protect heap from growing into the reserved MSP stack */
   if (__sbrk_heap_end + incr > max_heap)
   {
+    __sbrk_refused++;
     errno = ENOMEM;
     return (void *)-1;
   }
@@ -78,3 +85,12 @@ void *_sbrk(ptrdiff_t incr)
 
   return (void *)prev_heap_end;
 }
+
+/**
+ * @brief Bytes handed to the newlib heap so far (0 if malloc was never used)
+ */
+uint32_t __sbrk_used(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+  return (__sbrk_heap_end == NULL) ? 0U : (uint32_t)(__sbrk_heap_end - &_end);
+}
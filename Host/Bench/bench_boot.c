@@ -0,0 +1,132 @@
+/*
+ * bench_boot.c  (Host build)
+ *
+ *  CAN 부트로더 다운로드 처리량 (호스트 부트 보드 + 내장 flash 모델 + uds_client 테스터).
+ *    boot_overlap    : 0x36 블록을 FlashTask 에 넘기고 바로 응답 (기록과 다음 블록 수신이 겹침)
+ *    boot_sequential : 0x36 마다 기록 완료 후 응답 (bootState.overlap = 0)
+ *    boot_hs         : 압축 전송 (DFI 0x10), FlashTask 가 풀면서 기록 (해제 CPU 시간 포함)
+ *    boot_hs_seq     : 압축 + 0x36 마다 기록 완료 후 응답
+ *  이미지: 실제 앱 바이너리 (Debug/RTOS_DTC_Comento.bin) 를 -k 크기까지 반복, -r 이면 무작위 (압축 안 됨).
+ *  단계별 시간(세션/지우기/전송/종료)과 실효 KB/s (원래 이미지 / 전송 시간), 버스 점유율을 낸다.
+ *  내려받은 내용과 부트 정보(CRC)를 매번 확인한다.
+ *  가상 시간 기준이므로 결정적. BENCH v=1 형식 (unit=us, 다운로드 전체 소요 시간).
+ *    usage: bench_boot [-k image_KB] [-r]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_boot_board.h"
+#include "host_sim.h"
+
+#define IMG_MAX_KB   1024u
+
+static uint32_t    s_size = 0;
+static uint8_t    *s_img;
+static UdsClient_t s_uds;
+static int         s_rc;
+
+static void prvFail(const char *what)
+{
+    printf("FAIL bench_boot: %s\n", what);
+    s_rc = 1;
+    vTaskEndScheduler();
+}
+
+static void prvRun(const char *name, uint8_t overlap, uint8_t compress)
+{
+    UdsClient_Report_t rep;
+    HostCAN_Stats_t c0, c1;
+    uint32_t waits = flashProg.buf_waits;
+
+    bootState.overlap = overlap;
+    s_uds.compress = compress;
+    HostCAN_GetStats(CAN1, &c0);
+    int rc = UdsClient_Download(&s_uds, FLASHPROG_APP_START, s_img, s_size, &rep);
+    HostCAN_GetStats(CAN1, &c1);
+    if (rc != UDSC_OK) {
+        printf("%s: rc=%d sid=0x%02X nrc=0x%02X\n", name, rc, rep.failed_sid, s_uds.last_nrc);
+        prvFail("download");
+        return;
+    }
+    if (memcmp(HostFlash_Ptr(FLASHPROG_APP_START), s_img, s_size) != 0) prvFail("flash contents");
+    if (!FlashProg_AppValid(1)) prvFail("boot info");
+
+    unsigned long kbs = (unsigned long)((uint64_t)s_size * 1000000u / 1024u / rep.t_transfer_us);
+    unsigned long load = (unsigned long)((c1.busy_us - c0.busy_us) * 1000u / rep.t_total_us);
+    printf("BENCH v=1 name=%s unit=us ops=%lu min=%lu.00 med=%lu.00 bytes=%lu sent=%lu dfi=0x%02X kb_s=%lu"
+           " session_us=%lu erase_us=%lu transfer_us=%lu exit_us=%lu bus_permille=%lu buf_waits=%lu\n",
+           name, (unsigned long)rep.blocks, (unsigned long)rep.t_total_us, (unsigned long)rep.t_total_us,
+           (unsigned long)s_size, (unsigned long)rep.sent, rep.dfi, kbs, (unsigned long)rep.t_session_us,
+           (unsigned long)rep.t_erase_us, (unsigned long)rep.t_transfer_us, (unsigned long)rep.t_exit_us,
+           load, (unsigned long)(flashProg.buf_waits - waits));
+}
+
+static void prvTester(void *arg)
+{
+    (void)arg;
+
+    HostBootBoard_TesterInit(&s_uds);
+    prvRun("boot_overlap", 1, 0);
+    if (s_rc == 0) prvRun("boot_sequential", 0, 0);
+    if (s_rc == 0) prvRun("boot_hs", 1, 1);
+    if (s_rc == 0) prvRun("boot_hs_seq", 0, 1);
+    vTaskEndScheduler();
+}
+
+/* 앱 바이너리를 size 까지 반복 (창 2KB 밖의 반복은 압축에 도움이 안 되므로 원본과 비율이 같음) */
+static int prvImage(int random)
+{
+    FILE *fp = random ? NULL : fopen(FW_IMAGE, "rb");
+    uint32_t n = 0;
+
+    if (fp != NULL) {
+        s_img = malloc(IMG_MAX_KB * 1024u);
+        if (s_img != NULL) n = (uint32_t)fread(s_img, 1, IMG_MAX_KB * 1024u, fp);
+        fclose(fp);
+        if (n == 0u) return -1;
+        if (s_size == 0u) s_size = n;                            /* 기본: 바이너리 그대로 */
+        for (uint32_t i = n; i < s_size; i++) s_img[i] = s_img[i % n];
+        printf("image        : %s, %lu bytes\n", FW_IMAGE, (unsigned long)s_size);
+        return 0;
+    }
+    if (s_size == 0u) s_size = 256u * 1024u;
+    s_img = malloc(s_size);
+    if (s_img == NULL) return -1;
+    srand(43);
+    for (uint32_t i = 0; i < s_size; i++) s_img[i] = (uint8_t)rand();
+    printf("image        : random, %lu bytes\n", (unsigned long)s_size);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int random = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-k") && i + 1 < argc) s_size = (uint32_t)strtoul(argv[++i], NULL, 0) * 1024u;
+        else if (!strcmp(argv[i], "-r")) random = 1;
+        else {
+            fprintf(stderr, "usage: %s [-k image_KB] [-r]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_size > IMG_MAX_KB * 1024u) s_size = 256u * 1024u;
+    if (prvImage(random) != 0) return 1;
+
+    HostBootBoard_Init();
+    HostBootBoard_CreateTasks();
+    const osThreadAttr_t tester_attr = {
+        .name = "Tester", .stack_size = 512 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    osThreadNew(prvTester, NULL, &tester_attr);
+    HostBootBoard_Run(0);
+
+    free(s_img);
+    if (s_rc == 0) printf("PASS boot\n");
+    return s_rc;
+}
@@ -0,0 +1,205 @@
+/*
+ * bench_bus.c  (Host build)
+ *
+ *  BusMgr 로 두 작업자(각자 EEPROM 1개 + PMIC 1개)를 동시에 돌려
+ *  디바이스를 버스 1개에 몰았을 때와 2개에 나눴을 때의 처리 시간을 비교한다.
+ *    one : EEPROM 2개 SPI2 (CS PB12/PB13), PMIC 2개 I2C1 (0x60/0x61)
+ *    two : EEPROM SPI1 + SPI2,            PMIC I2C1 + I2C2
+ *  가상 시간 기준이므로 결정적. BENCH v=1 형식 (unit=us, 단계 전체 소요 시간).
+ *    usage: bench_bus [-n rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "BusMgr.h"
+#include "host_board.h"
+#include "host_sim.h"
+
+#define EE_READ_LEN     4096u     /* 저장소 읽기 1회 */
+#define EE_WRITE_LEN    256u      /* 저장소 쓰기 1회 (4 page) */
+#define PMIC_POLLS      16u       /* 라운드당 상태 burst 읽기 횟수 */
+#define EEB_CS_PIN      GPIO_PIN_13
+
+typedef enum { PH_READ = 0, PH_WRITE, PH_MONITOR, PH_COUNT } Phase_t;
+static const char *const s_phaseName[PH_COUNT] = { "storage_read", "storage_write", "pmic_monitor" };
+
+typedef struct {
+    osThreadId_t thread;
+    int8_t       ee, pmic;
+    M25LC256_t  *model;
+    uint16_t     base;          /* EEPROM 내 작업 영역 */
+    uint32_t     bytes;
+    int          fail;
+} Worker_t;
+
+static M25LC256_t   s_eeB;      /* one: SPI2 두 번째 EEPROM */
+static MMP5475_t    s_pmicB;    /* one: I2C1 두 번째 PMIC (0x61) */
+static Worker_t     s_w[2];
+static osThreadId_t s_ctrl;
+static volatile Phase_t s_phase;
+static uint32_t     s_rounds = 8u;
+static uint64_t     s_elapsed[2][PH_COUNT];
+static int          s_rc;
+
+static uint8_t prvPattern(uint32_t addr, uint32_t salt) { return (uint8_t)(addr * 7u + salt); }
+
+static void prvWorker(void *argument)
+{
+    Worker_t *w = (Worker_t *)argument;
+    static uint8_t buf[2][EE_READ_LEN];
+    uint8_t *b = buf[w - s_w];
+
+    for (;;) {
+        osThreadFlagsWait(1u, osFlagsWaitAny, osWaitForever);
+        for (uint32_t r = 0; r < s_rounds && !w->fail; r++) {
+            if (s_phase == PH_READ) {
+                if (BusMgr_Read(w->ee, w->base, b, EE_READ_LEN) != HAL_OK) { w->fail = 1; break; }
+                for (uint32_t i = 0; i < EE_READ_LEN; i++) {
+                    if (b[i] != w->model->mem[w->base + i]) { w->fail = 2; break; }
+                }
+                w->bytes += EE_READ_LEN;
+            } else if (s_phase == PH_WRITE) {
+                uint16_t a = (uint16_t)(w->base + (r % 16u) * EE_WRITE_LEN);
+                for (uint32_t i = 0; i < EE_WRITE_LEN; i++) b[i] = prvPattern(a + i, r);
+                if (BusMgr_Write(w->ee, a, b, EE_WRITE_LEN) != HAL_OK) { w->fail = 3; break; }
+                if (memcmp(&w->model->mem[a], b, EE_WRITE_LEN) != 0) { w->fail = 4; break; }
+                w->bytes += EE_WRITE_LEN;
+            } else {
+                for (uint32_t k = 0; k < PMIC_POLLS; k++) {
+                    if (BusMgr_Read(w->pmic, 0x05u, b, 5u) != HAL_OK) { w->fail = 5; break; }
+                    w->bytes += 5u;
+                }
+            }
+        }
+        osThreadFlagsSet(s_ctrl, 1u << (w - s_w));
+    }
+}
+
+/* 두 작업자를 동시에 출발시키고 둘 다 끝날 때까지의 가상 시간 */
+static uint64_t prvRunPhase(Phase_t ph)
+{
+    uint64_t t0 = HostSim_NowUs();
+
+    s_phase = ph;
+    for (uint32_t i = 0; i < 2u; i++) { s_w[i].bytes = 0; osThreadFlagsSet(s_w[i].thread, 1u); }
+    osThreadFlagsWait(3u, osFlagsWaitAll, osWaitForever);
+    return HostSim_NowUs() - t0;
+}
+
+static void prvReport(const char *cfg, Phase_t ph, uint64_t us)
+{
+    uint32_t bytes = s_w[0].bytes + s_w[1].bytes;
+    unsigned long kbs = (us != 0u) ? (unsigned long)((uint64_t)bytes * 1000000u / 1024u / us) : 0ul;
+    BusId_t buses[2] = {
+        BusMgr_Device(ph == PH_MONITOR ? s_w[0].pmic : s_w[0].ee)->bus,
+        BusMgr_Device(ph == PH_MONITOR ? s_w[1].pmic : s_w[1].ee)->bus,
+    };
+    uint32_t contended = busTable[buses[0]].contended + ((buses[1] != buses[0]) ? busTable[buses[1]].contended : 0u);
+
+    printf("BENCH v=1 name=bus_%s_%s unit=us ops=%lu min=%lu.00 med=%lu.00 bytes=%lu kb_s=%lu contended=%lu\n",
+           s_phaseName[ph], cfg, (unsigned long)s_rounds, (unsigned long)us, (unsigned long)us,
+           (unsigned long)bytes, kbs, (unsigned long)contended);
+}
+
+static void prvConfigure(int two)
+{
+    if (two) {
+        s_w[0] = (Worker_t){ .thread = s_w[0].thread, .ee = BusMgr_Find("ee.spi1"),  .pmic = BusMgr_Find("pmic.i2c1"),
+                             .model = &g_eeprom,  .base = 0x1000u };
+        s_w[1] = (Worker_t){ .thread = s_w[1].thread, .ee = BusMgr_Find("ee.spi2a"), .pmic = BusMgr_Find("pmic.i2c2"),
+                             .model = &g_eeprom2, .base = 0x1000u };
+    } else {
+        s_w[0] = (Worker_t){ .thread = s_w[0].thread, .ee = BusMgr_Find("ee.spi2a"), .pmic = BusMgr_Find("pmic.i2c1"),
+                             .model = &g_eeprom2, .base = 0x1000u };
+        s_w[1] = (Worker_t){ .thread = s_w[1].thread, .ee = BusMgr_Find("ee.spi2b"), .pmic = BusMgr_Find("pmic.i2c1b"),
+                             .model = &s_eeB,     .base = 0x1000u };
+    }
+    for (uint32_t i = 0; i < BUS_COUNT; i++) busTable[i].contended = 0;
+}
+
+static void prvController(void *argument)
+{
+    static const char *const cfgName[2] = { "one", "two" };
+    (void)argument;
+
+    s_ctrl = osThreadGetId();
+    for (int cfg = 0; cfg < 2; cfg++) {
+        prvConfigure(cfg);
+        for (Phase_t ph = PH_READ; ph < PH_COUNT; ph++) {
+            for (uint32_t i = 0; i < BUS_COUNT; i++) busTable[i].contended = 0;
+            s_elapsed[cfg][ph] = prvRunPhase(ph);
+            if (s_w[0].fail || s_w[1].fail) {
+                printf("FAIL bus_%s_%s: worker error %d/%d\n", s_phaseName[ph], cfgName[cfg], s_w[0].fail, s_w[1].fail);
+                s_rc = 1;
+                vTaskEndScheduler();
+            }
+            prvReport(cfgName[cfg], ph, s_elapsed[cfg][ph]);
+        }
+    }
+    for (Phase_t ph = PH_READ; ph < PH_COUNT; ph++) {
+        uint64_t one = s_elapsed[0][ph], two = s_elapsed[1][ph];
+        printf("speedup %-14s: one=%lu us two=%lu us x%.2f\n", s_phaseName[ph],
+               (unsigned long)one, (unsigned long)two, two ? (double)one / (double)two : 0.0);
+    }
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    static const BusDev_t devs[] = {
+        { "ee.spi1",    BUSDEV_EEPROM, BUS_SPI1, 0,                        NULL,             0           },
+        { "ee.spi2a",   BUSDEV_EEPROM, BUS_SPI2, 0,                        EE2_CS_GPIO_Port, EE2_CS_Pin  },
+        { "ee.spi2b",   BUSDEV_EEPROM, BUS_SPI2, 0,                        GPIOB,            EEB_CS_PIN  },
+        { "pmic.i2c1",  BUSDEV_PMIC,   BUS_I2C1, I2C_SLAVE_ADDRESS,        NULL,             0           },
+        { "pmic.i2c1b", BUSDEV_PMIC,   BUS_I2C1, (uint16_t)(0x61u << 1),   NULL,             0           },
+        { "pmic.i2c2",  BUSDEV_PMIC,   BUS_I2C2, I2C_SLAVE_ADDRESS,        NULL,             0           },
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) s_rounds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-n rounds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_rounds == 0u) s_rounds = 1u;
+
+    HostBoard_Init();
+    HAL_GPIO_WritePin(GPIOB, EEB_CS_PIN, GPIO_PIN_SET);
+    M25LC256_Init(&s_eeB);
+    if (M25LC256_Attach(&s_eeB, SPI2, GPIOB, EEB_CS_PIN) != 0) return 1;
+    MMP5475_Init(&s_pmicB);
+    s_pmicB.addr7 = 0x61u;
+    if (MMP5475_Attach(&s_pmicB, I2C1) != 0) return 1;
+
+    /* 읽기 검증용 내용 */
+    for (uint32_t a = 0; a < M25LC256_SIZE; a++) {
+        g_eeprom.mem[a]  = prvPattern(a, 0x11u);
+        g_eeprom2.mem[a] = prvPattern(a, 0x22u);
+        s_eeB.mem[a]     = prvPattern(a, 0x33u);
+    }
+
+    osKernelInitialize();
+    BusMgr_Init();
+    for (uint32_t i = 0; i < sizeof(devs) / sizeof(devs[0]); i++) {
+        if (BusMgr_Register(&devs[i]) < 0) return 1;
+    }
+
+    const osThreadAttr_t worker_attributes = {
+      .name = "BusWorker", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityNormal,
+    };
+    const osThreadAttr_t ctrl_attributes = {
+      .name = "BusBench", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    s_w[0].thread = osThreadNew(prvWorker, &s_w[0], &worker_attributes);
+    s_w[1].thread = osThreadNew(prvWorker, &s_w[1], &worker_attributes);
+    osThreadNew(prvController, NULL, &ctrl_attributes);
+
+    HostBoard_Run(0u);
+    return s_rc;
+}
@@ -0,0 +1,36 @@
+/*
+ * bench_diag.c  (Host build)
+ *
+ *  Core/Src/Bench.c 진단 벤치 스위트를 호스트에서 실행.
+ *    usage: bench_diag [-n iters] [-r repeats] [--quick]
+ *  출력은 Bench.h 의 BENCH v=1 형식 (stdout).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Bench.h"
+
+static void prvWrite(const char *line)
+{
+    fputs(line, stdout);
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Config_t cfg = { .iters = 20000u, .repeats = 9u, .write = prvWrite };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc)      cfg.iters = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) cfg.repeats = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--quick"))            { cfg.iters = 100u; cfg.repeats = 3u; }
+        else {
+            fprintf(stderr, "usage: %s [-n iters] [-r repeats] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Bench_RunDiagSuite(&cfg);
+    return 0;
+}
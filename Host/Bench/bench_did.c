@@ -0,0 +1,165 @@
+/*
+ * bench_did.c  (Host build)
+ *
+ *  DID 엔진 비용: 합성 표 50 / 500 개 (DID 오름차순, live 원본 = uint32 배열, 폭 1/2/4 혼합)
+ *    lookup   : DID_Find 이진 탐색 (DID 당 ns). 비교용으로 같은 표의 선형 탐색
+ *    assemble : DID_ReadRequest, 요청 1 개에 DID 8 개 → 응답 조립 (요청당 ns)
+ *  실제 표(didTable)에 대해서도 같은 요청 조립 비용을 잰다.
+ *    usage: bench_did [-n iters] [-r repeats] [--quick]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Bench.h"
+#include "DID.h"
+#include "UDS_CAN.h"
+#include "test_check.h"
+
+#define MAX_DIDS     500u
+#define PROBES       64u       // lookup 1 iteration 당 DID 수
+#define REQ_DIDS     8u
+
+typedef struct {
+    DID_Table_t t;
+    uint16_t    probe[PROBES];
+    uint8_t     req[2u * REQ_DIDS];
+} Case_t;
+
+static DID_Entry_t s_entries[MAX_DIDS];
+static uint32_t    s_live[MAX_DIDS][2];
+static uint8_t     s_rsp[ISOTP_MAX_LEN];
+static volatile uintptr_t s_sink;
+
+static void prvWrite(const char *line)
+{
+    fputs(line, stdout);
+}
+
+/* DID 간격 1~8 (비연속), 폭 순환 */
+static void prvMakeTable(Case_t *c, uint16_t n)
+{
+    static const uint8_t fmt[3] = { DID_FMT_U8, DID_FMT_U16, DID_FMT_U32 };
+    uint32_t lfsr = 0xACE1u;
+    uint16_t did = 0x0100u;
+
+    for (uint16_t i = 0; i < n; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        did = (uint16_t)(did + 1u + (lfsr & 7u));
+        s_live[i][0] = lfsr * 2654435761u;
+        s_live[i][1] = ~s_live[i][0];
+        s_entries[i] = (DID_Entry_t){ .did = did, .fmt = fmt[i % 3u], .len = (uint8_t)(2u * fmt[i % 3u]),
+                                      .access = DID_ACC_READ, .live = s_live[i] };
+    }
+    c->t.e = s_entries;
+    c->t.n = n;
+    for (uint32_t i = 0; i < PROBES; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        c->probe[i] = s_entries[lfsr % n].did;
+    }
+    for (uint32_t i = 0; i < REQ_DIDS; i++) {
+        c->req[2u * i] = (uint8_t)(c->probe[i] >> 8);
+        c->req[2u * i + 1u] = (uint8_t)c->probe[i];
+    }
+}
+
+static const DID_Entry_t *prvLinearFind(const DID_Table_t *t, uint16_t did)
+{
+    for (uint16_t i = 0; i < t->n; i++) {
+        if (t->e[i].did == did) return &t->e[i];
+    }
+    return NULL;
+}
+
+/* ===== 측정 대상 ===== */
+static void Bench_Lookup(void *ctx, uint32_t iters)
+{
+    const Case_t *c = ctx;
+    while (iters--) {
+        for (uint32_t i = 0; i < PROBES; i++) s_sink += (uintptr_t)DID_Find(&c->t, c->probe[i]);
+    }
+}
+
+static void Bench_LookupLinear(void *ctx, uint32_t iters)
+{
+    const Case_t *c = ctx;
+    while (iters--) {
+        for (uint32_t i = 0; i < PROBES; i++) s_sink += (uintptr_t)prvLinearFind(&c->t, c->probe[i]);
+    }
+}
+
+static void Bench_Assemble(void *ctx, uint32_t iters)
+{
+    const Case_t *c = ctx;
+    uint16_t n = 0;
+    while (iters--) {
+        (void)DID_ReadRequest(&c->t, c->req, sizeof(c->req), s_rsp, sizeof(s_rsp), &n);
+        s_sink += n;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Config_t cfg = { .iters = 20000u, .repeats = 9u, .write = prvWrite };
+    static Case_t c50, c500, cReal;
+    uint16_t n = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc)      cfg.iters = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) cfg.repeats = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--quick"))            { cfg.iters = 100u; cfg.repeats = 3u; }
+        else {
+            fprintf(stderr, "usage: %s [-n iters] [-r repeats] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    /* 500 개 표의 앞 50 개 = 50 개 표 (같은 원본) */
+    prvMakeTable(&c500, MAX_DIDS);
+    CHECK(DID_CheckTable(&c500.t) == HAL_OK);
+    c50 = c500;
+    c50.t.n = 50u;
+    for (uint32_t i = 0; i < PROBES; i++) c50.probe[i] = s_entries[(i * 37u) % 50u].did;
+    for (uint32_t i = 0; i < REQ_DIDS; i++) {
+        c50.req[2u * i] = (uint8_t)(c50.probe[i] >> 8);
+        c50.req[2u * i + 1u] = (uint8_t)c50.probe[i];
+    }
+
+    /* 이진 탐색 = 선형 탐색, 조립 결과 확인 */
+    for (uint32_t i = 0; i < PROBES; i++) {
+        CHECK(DID_Find(&c500.t, c500.probe[i]) == prvLinearFind(&c500.t, c500.probe[i]));
+        CHECK(DID_Find(&c50.t, c50.probe[i]) == prvLinearFind(&c50.t, c50.probe[i]));
+    }
+    CHECK(DID_Find(&c500.t, 0x00FFu) == NULL && DID_Find(&c500.t, 0xFFFFu) == NULL);
+    CHECK(DID_ReadRequest(&c500.t, c500.req, sizeof(c500.req), s_rsp, sizeof(s_rsp), &n) == 0u);
+    const DID_Entry_t *e0 = DID_Find(&c500.t, c500.probe[0]);
+    CHECK(s_rsp[0] == c500.req[0] && s_rsp[1] == c500.req[1]);
+    if (e0->fmt == DID_FMT_U32) CHECK(s_rsp[2] == (uint8_t)(s_live[e0 - s_entries][0] >> 24));
+    if (e0->fmt == DID_FMT_U8)  CHECK(s_rsp[2] == (uint8_t)s_live[e0 - s_entries][0]);
+
+    /* 실제 표: 진단 툴이 흔히 묶어 읽는 DID 들 */
+    cReal.t = didTable;
+    static const uint16_t realDids[REQ_DIDS] = { 0xD100u, 0xD110u, 0xD120u, 0xD121u, 0xD130u, 0xD131u, 0xF186u, 0xF190u };
+    for (uint32_t i = 0; i < REQ_DIDS; i++) {
+        cReal.probe[i] = realDids[i];
+        cReal.req[2u * i] = (uint8_t)(realDids[i] >> 8);
+        cReal.req[2u * i + 1u] = (uint8_t)realDids[i];
+    }
+    for (uint32_t i = REQ_DIDS; i < PROBES; i++) cReal.probe[i] = realDids[i % REQ_DIDS];
+    CHECK(DID_ReadRequest(&cReal.t, cReal.req, sizeof(cReal.req), s_rsp, sizeof(s_rsp), &n) == 0u);
+    printf("real request : %u DIDs → %u B response\n", REQ_DIDS, n);
+
+    const Bench_Case_t cases[] = {
+        { "did_lookup_50",          Bench_Lookup,       &c50,   PROBES },
+        { "did_lookup_500",         Bench_Lookup,       &c500,  PROBES },
+        { "did_lookup_linear_50",   Bench_LookupLinear, &c50,   PROBES },
+        { "did_lookup_linear_500",  Bench_LookupLinear, &c500,  PROBES },
+        { "did_assemble8_50",       Bench_Assemble,     &c50,   1u },
+        { "did_assemble8_500",      Bench_Assemble,     &c500,  1u },
+        { "did_assemble8_real",     Bench_Assemble,     &cReal, 1u },
+    };
+    Bench_CounterInit();
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) Bench_RunCase(&cfg, &cases[i], NULL);
+    return 0;
+}
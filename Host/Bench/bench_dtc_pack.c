@@ -0,0 +1,234 @@
+/*
+ * bench_dtc_pack.c  (Host build)
+ *
+ *  DTC 테이블 EEPROM 형식 비교: 기존 DTC_Entry_t 직렬화(12B, record 마다 CRC-32)
+ *  vs 압축 테이블(DTC_PackTable: delta timestamp, page 당 CRC-16, DTCMem bank 형식).
+ *    bytes/DTC  : page(64B) 경계를 넘지 않게 배치했을 때 실제 점유 바이트
+ *    read       : 25LC256 (SPI1, 보드 레벨 CS) 에서 전체 테이블 로드 (가상 시간, SPI 바이트)
+ *    decode     : 읽은 이미지를 DTC_Entry_t 배열로 복원 (CRC 검사 포함, Bench_RunCase, DTC 당 ns)
+ *  압축 형식의 round trip / 손상 page / 알 수 없는 버전 / 세대가 섞인 이미지 거부도 확인한다.
+ *    usage: bench_dtc_pack [-n dtcs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Bench.h"
+#include "DTC.h"
+#include "host_sim.h"
+#include "model_25lc256.h"
+#include "test_check.h"
+
+#define MAX_DTCS        80u
+#define PACK_BASE       0x0100u                               /* DTCMem bank A 위치 */
+#define STRUCT_BASE     0x0400u                               /* 기존 형식 이미지 위치 */
+#define STRUCT_PER_PAGE (DTC_PK_PAGE_SIZE / DTC_ENTRY_SIZE)   /* 5: page 경계를 넘는 record 없음 */
+
+static SPI_HandleTypeDef s_hspi;
+static M25LC256_t        s_ee;
+static DTC_Entry_t       s_list[MAX_DTCS], s_out[MAX_DTCS];
+static uint16_t          s_n = 40u;
+
+static uint8_t  s_structImg[((MAX_DTCS + STRUCT_PER_PAGE - 1u) / STRUCT_PER_PAGE) * DTC_PK_PAGE_SIZE];
+static uint16_t s_structLen;
+static uint8_t  s_packImg[DTC_PK_MAX_BYTES];
+static uint16_t s_packLen;
+
+static void prvWrite(const char *line)
+{
+    fputs(line, stdout);
+}
+
+/* 운전 사이클마다 몇 개씩 발생하는 DTC: 사이클 안에서는 수십~수천 ms, 사이클 사이는 수 시간 */
+static void prvMakeTable(void)
+{
+    uint32_t lfsr = 0xACE1u, ts = 3600000u;
+
+    for (uint16_t i = 0; i < s_n; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+        ts += (i % 8u == 7u) ? 4u * 3600000u : (lfsr & 0x0FFFu);
+        s_list[i] = (DTC_Entry_t){ .rec = { { (uint8_t)(0xC0u | (i >> 4)), (uint8_t)(lfsr >> 8), (uint8_t)i },
+                                            (uint8_t)(DTC_ST_TF | DTC_ST_CDTC | ((lfsr & 1u) ? DTC_ST_PDTC : 0u)) },
+                                   .timestamp_ms = ts,
+                                   .first_ms = (i % 4u == 3u) ? ts - 60000u * (lfsr & 0x7u) : ts,   /* 대부분 1 회 발생 */
+                                   .occurrence = (uint8_t)((i % 4u == 3u) ? 1u + (lfsr & 0x7u) : 1u) };
+    }
+    /* 정렬되지 않은 시각(시계 보정 등)도 표현 가능해야 함 */
+    if (s_n > 3u) s_list[3].timestamp_ms = s_list[2].timestamp_ms - 1500u;
+}
+
+static void prvMakeStructImage(void)
+{
+    memset(s_structImg, 0xFF, sizeof(s_structImg));
+    for (uint16_t i = 0; i < s_n; i++) {
+        DTC_Entry_t e = s_list[i];
+        e.crc32 = DTC_CalcCRC32(&e.rec, sizeof(e.rec));
+        DTC_SerializeEntry(&e, &s_structImg[(i / STRUCT_PER_PAGE) * DTC_PK_PAGE_SIZE + (i % STRUCT_PER_PAGE) * DTC_ENTRY_SIZE]);
+    }
+    s_structLen = (uint16_t)(((s_n + STRUCT_PER_PAGE - 1u) / STRUCT_PER_PAGE) * DTC_PK_PAGE_SIZE);
+}
+
+static uint16_t prvStructDecode(const uint8_t *img, DTC_Entry_t *out)
+{
+    uint16_t ok = 0;
+    for (uint16_t i = 0; i < s_n; i++) {
+        DTC_DeserializeEntry(&img[(i / STRUCT_PER_PAGE) * DTC_PK_PAGE_SIZE + (i % STRUCT_PER_PAGE) * DTC_ENTRY_SIZE], &out[i]);
+        ok += (DTC_CalcCRC32(&out[i].rec, sizeof(out[i].rec)) == out[i].crc32);
+    }
+    return ok;
+}
+
+static void prvEeRead(uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    uint8_t cmd[3] = { 0x03u, (uint8_t)(addr >> 8), (uint8_t)addr };
+    HAL_SPI_Transmit(&s_hspi, cmd, 3, HAL_MAX_DELAY);
+    HAL_SPI_Receive(&s_hspi, buf, len, HAL_MAX_DELAY);
+}
+
+static void prvEeWritePages(uint16_t addr, const uint8_t *img, uint16_t len)
+{
+    for (uint16_t off = 0; off < len; off += DTC_PK_PAGE_SIZE) {
+        uint8_t cmd[3 + DTC_PK_PAGE_SIZE] = { 0x02u, (uint8_t)((addr + off) >> 8), (uint8_t)(addr + off) };
+        uint8_t wren = 0x06u;
+        memcpy(&cmd[3], &img[off], DTC_PK_PAGE_SIZE);
+        HAL_SPI_Transmit(&s_hspi, &wren, 1, HAL_MAX_DELAY);
+        HAL_SPI_Transmit(&s_hspi, cmd, sizeof(cmd), HAL_MAX_DELAY);
+        HostSim_Advance(6000u);                     /* Twc */
+    }
+}
+
+/* ===== 디코드 비용 (Bench_RunCase) ===== */
+static void Bench_DecodeStruct(void *ctx, uint32_t iters)
+{
+    (void)ctx;
+    while (iters--) (void)prvStructDecode(s_structImg, s_out);
+}
+
+static void Bench_DecodePacked(void *ctx, uint32_t iters)
+{
+    (void)ctx;
+    while (iters--) {
+        uint16_t n = MAX_DTCS;
+        (void)DTC_UnpackTable(s_packImg, s_packLen, s_out, &n, NULL);
+    }
+}
+
+/* full: 압축 형식만 담는 첫 발생 시각 / 발생 횟수까지 비교 */
+static int prvSameList(const DTC_Entry_t *a, const DTC_Entry_t *b, uint16_t n, int full)
+{
+    for (uint16_t i = 0; i < n; i++) {
+        if (memcmp(&a[i].rec, &b[i].rec, sizeof(a[i].rec)) != 0 || a[i].timestamp_ms != b[i].timestamp_ms) return 0;
+        if (full && (a[i].first_ms != b[i].first_ms || a[i].occurrence != b[i].occurrence)) return 0;
+    }
+    return 1;
+}
+
+static void prvReportRead(const char *name, uint64_t us, uint32_t bytes, uint16_t imgLen)
+{
+    printf("BENCH v=1 name=%s unit=us ops=1 min=%lu.00 med=%lu.00 spi_bytes=%lu image=%u bytes_per_dtc=%.2f\n",
+           name, (unsigned long)us, (unsigned long)us, (unsigned long)bytes, imgLen, (double)imgLen / s_n);
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Config_t cfg = { .iters = 2000u, .repeats = 9u, .write = prvWrite };
+    HostSPI_Stats_t sp;
+    uint64_t t0;
+    uint16_t n;
+    uint32_t gen;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) s_n = (uint16_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-n dtcs]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_n == 0u || s_n > MAX_DTCS) s_n = 40u;
+
+    HAL_Init();
+    s_hspi.Instance = SPI1;
+    s_hspi.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+    CHECK(HAL_SPI_Init(&s_hspi) == HAL_OK);
+    M25LC256_Init(&s_ee);
+    CHECK(M25LC256_Attach(&s_ee, SPI1, NULL, 0) == 0);
+
+    prvMakeTable();
+    prvMakeStructImage();
+    s_packLen = sizeof(s_packImg);
+    CHECK(DTC_PackTable(s_list, s_n, 7u, s_packImg, &s_packLen) == HAL_OK);
+
+    /* round trip (메모리 / EEPROM) */
+    n = MAX_DTCS;
+    CHECK(DTC_UnpackTable(s_packImg, s_packLen, s_out, &n, &gen) == HAL_OK && n == s_n && gen == 7u);
+    CHECK(prvSameList(s_list, s_out, n, 1));
+    prvEeWritePages(PACK_BASE, s_packImg, s_packLen);
+    prvEeWritePages(STRUCT_BASE, s_structImg, s_structLen);
+
+    /* 전체 테이블 로드: 기존 형식 = 한 번의 READ + record 별 CRC-32 */
+    static uint8_t img[sizeof(s_structImg)];
+    t0 = HostSim_NowUs();
+    HostSPI_ResetStats(SPI1);
+    prvEeRead(STRUCT_BASE, img, s_structLen);
+    CHECK(prvStructDecode(img, s_out) == s_n && prvSameList(s_list, s_out, s_n, 0));
+    HostSPI_GetStats(SPI1, &sp);
+    prvReportRead("dtc_table_read_struct", HostSim_NowUs() - t0, sp.bytes, s_structLen);
+
+    /* 압축 형식 = page 수를 아는 상태 (DTCMem index) 에서 한 번의 READ + page 별 CRC-16 */
+    t0 = HostSim_NowUs();
+    HostSPI_ResetStats(SPI1);
+    memset(s_out, 0, sizeof(s_out));
+    prvEeRead(PACK_BASE, img, s_packLen);
+    n = MAX_DTCS;
+    CHECK(DTC_UnpackTable(img, s_packLen, s_out, &n, NULL) == HAL_OK && n == s_n && prvSameList(s_list, s_out, n, 1));
+    HostSPI_GetStats(SPI1, &sp);
+    prvReportRead("dtc_table_read_packed", HostSim_NowUs() - t0, sp.bytes, s_packLen);
+
+    /* 디코드 비용 (DTC 당) */
+    const Bench_Case_t cases[] = {
+        { "dtc_table_decode_struct", Bench_DecodeStruct, NULL, s_n },
+        { "dtc_table_decode_packed", Bench_DecodePacked, NULL, s_n },
+    };
+    Bench_CounterInit();
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) Bench_RunCase(&cfg, &cases[i], NULL);
+
+    printf("dtcs         : %u\n", s_n);
+    printf("bytes/DTC    : struct %.2f (%u per page), packed %.2f (%u pages)\n",
+           (double)s_structLen / s_n, (unsigned)STRUCT_PER_PAGE, (double)s_packLen / s_n,
+           (unsigned)(s_packLen / DTC_PK_PAGE_SIZE));
+
+    /* 손상 검출: page 마다 1 바이트 반전 / 다른 세대 page 가 섞임 / 알 수 없는 버전 / 지워진 영역 */
+    static uint8_t bad[DTC_PK_MAX_BYTES];
+    for (uint16_t p = 0; p < s_packLen / DTC_PK_PAGE_SIZE; p++) {
+        memcpy(bad, s_packImg, s_packLen);
+        bad[p * DTC_PK_PAGE_SIZE + 13u] ^= 0x10u;
+        n = MAX_DTCS;
+        CHECK(DTC_UnpackTable(bad, s_packLen, s_out, &n, NULL) == HAL_ERROR);
+    }
+    if (s_packLen > DTC_PK_PAGE_SIZE) {
+        uint16_t len = sizeof(bad);
+        CHECK(DTC_PackTable(s_list, s_n, 8u, bad, &len) == HAL_OK && len == s_packLen);
+        memcpy(&bad[DTC_PK_PAGE_SIZE], &s_packImg[DTC_PK_PAGE_SIZE], DTC_PK_PAGE_SIZE);   /* page 1 만 이전 세대 */
+        n = MAX_DTCS;
+        CHECK(DTC_UnpackTable(bad, s_packLen, s_out, &n, NULL) == HAL_ERROR);
+    }
+    memset(bad, 0xFF, sizeof(bad));
+    n = MAX_DTCS;
+    CHECK(DTC_UnpackTable(bad, sizeof(bad), s_out, &n, NULL) == HAL_ERROR);
+
+    /* 빈 테이블 / 출력 배열보다 큰 테이블 */
+    uint16_t len = sizeof(bad);
+    CHECK(DTC_PackTable(s_list, 0u, 1u, bad, &len) == HAL_OK && len == DTC_PK_PAGE_SIZE);
+    n = MAX_DTCS;
+    CHECK(DTC_UnpackTable(bad, len, s_out, &n, NULL) == HAL_OK && n == 0u);
+    n = 3u;
+    CHECK(DTC_UnpackTable(s_packImg, s_packLen, s_out, &n, NULL) == HAL_OK && n == 3u && prvSameList(s_list, s_out, 3u, 1));
+    s_packImg[0] = (uint8_t)(DTC_PK_VERSION + 1u);
+    n = MAX_DTCS;
+    CHECK(DTC_UnpackTable(s_packImg, s_packLen, s_out, &n, NULL) == HAL_ERROR);
+
+    CHECK(s_packLen < s_structLen);
+    printf("PASS dtc_pack\n");
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * bench_eecache.c  (Host build)
+ *
+ *  EEPROM write-back 캐시(EECache) vs 바로 쓰기(BusMgr_Write).
+ *  생산자 3 개가 DTC 상태/카운터/freeze frame 을 주기적으로 갱신하는 부하에서
+ *    - 생산자가 본 쓰기 지연 (min/med/p99/max)
+ *    - 실제 EEPROM WRITE 명령 수 (절감량)
+ *    - 강제 flush(UV 경고) 요청부터 dirty line 0 까지의 시간
+ *  을 보고하고, 끝난 뒤 EEPROM 내용이 마지막으로 쓴 값과 같은지 확인한다.
+ *  가상 시간 기준이므로 결정적 (RAM 복사는 0 us 로 계산됨). BENCH v=1 형식 (unit=us).
+ *    usage: bench_eecache [-t ms]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "EECache.h"
+#include "host_board.h"
+#include "host_sim.h"
+
+#define MAX_SAMPLES   4096u
+
+typedef struct {
+    const char  *name;
+    uint16_t     base;          /* 첫 record 주소 */
+    uint16_t     len;           /* record 크기 */
+    uint16_t     count;         /* 순환하는 record 수 */
+    uint16_t     stride;        /* record 간격 */
+    uint32_t     period_ms;
+} Producer_t;
+
+static const Producer_t s_prod[] = {
+    { "status",   0x0080u,  4u, 1u,  0u,   2u },    /* 같은 4B 를 2ms 마다 */
+    { "counters", 0x00C0u,  8u, 8u,  8u,   5u },    /* page 1 개 안의 8B record 8 개 */
+    { "freeze",   0x0140u, 16u, 16u, 16u, 10u },    /* 4 page 에 걸친 16B record 16 개 */
+};
+#define NPROD  (sizeof(s_prod) / sizeof(s_prod[0]))
+
+static osThreadId_t      s_thr[NPROD], s_ctrl;
+static volatile uint8_t  s_mode;          /* 0 = 바로 쓰기, 1 = 캐시 */
+static volatile uint8_t  s_stop;
+static int8_t            s_dev;
+static uint32_t          s_run_ms = 2000u;
+static uint32_t          s_lat[MAX_SAMPLES], s_nlat;
+static uint32_t          s_ops, s_busy;
+static uint8_t           s_shadow[M25LC256_SIZE];
+static int               s_rc;
+
+static void prvProducer(void *argument)
+{
+    const Producer_t *p = &s_prod[(uintptr_t)argument];
+    uint8_t rec[16];
+    uint32_t n = 0;
+
+    for (;;) {
+        osThreadFlagsWait(1u, osFlagsWaitAny, osWaitForever);
+        while (!s_stop) {
+            uint16_t addr = (uint16_t)(p->base + (n % p->count) * p->stride);
+            for (uint32_t i = 0; i < p->len; i++) rec[i] = (uint8_t)(n + i + p->base);
+            n++;
+
+            uint64_t t0 = HostSim_NowUs();
+            HAL_StatusTypeDef st = s_mode ? EECache_Write(&eeCache, addr, rec, p->len)
+                                          : BusMgr_Write(s_dev, addr, rec, p->len);
+            uint32_t us = (uint32_t)(HostSim_NowUs() - t0);
+
+            if (st == HAL_OK) memcpy(&s_shadow[addr], rec, p->len);
+            else              s_busy++;
+            if (s_nlat < MAX_SAMPLES) s_lat[s_nlat++] = us;
+            s_ops++;
+            osDelay(p->period_ms);
+        }
+        osThreadFlagsSet(s_ctrl, 1u << ((uintptr_t)argument));
+    }
+}
+
+static int prvCmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t prvRun(uint8_t mode, const char *name)
+{
+    uint32_t writes0 = g_eeprom.stats.writes;
+
+    s_mode = mode;
+    s_stop = 0;
+    s_nlat = s_ops = s_busy = 0;
+    for (uint32_t i = 0; i < NPROD; i++) osThreadFlagsSet(s_thr[i], 1u);
+    osDelay(s_run_ms);
+    s_stop = 1;
+    osThreadFlagsWait((1u << NPROD) - 1u, osFlagsWaitAll, osWaitForever);
+
+    qsort(s_lat, s_nlat, sizeof(s_lat[0]), prvCmp);
+    uint32_t writes = g_eeprom.stats.writes - writes0;
+    printf("BENCH v=1 name=%s unit=us ops=%lu min=%lu.00 med=%lu.00 p99=%lu.00 max=%lu.00 ee_writes=%lu busy=%lu\n",
+           name, (unsigned long)s_ops, (unsigned long)s_lat[0], (unsigned long)s_lat[s_nlat / 2u],
+           (unsigned long)s_lat[(s_nlat * 99u) / 100u], (unsigned long)s_lat[s_nlat - 1u],
+           (unsigned long)writes, (unsigned long)s_busy);
+    return writes;
+}
+
+static void prvController(void *argument)
+{
+    (void)argument;
+    s_ctrl = osThreadGetId();
+
+    uint32_t through = prvRun(0u, "eecache_write_through");
+    uint32_t back = prvRun(1u, "eecache_write_back");
+
+    /* UV 경고 → 강제 flush → dirty line 0 */
+    uint64_t t0 = HostSim_NowUs();
+    uint32_t dirty0 = EECache_DirtyLines(&eeCache);
+    EECache_RequestFlush(&eeCache);
+    while (EECache_DirtyLines(&eeCache) != 0u) osDelay(1);
+    printf("BENCH v=1 name=eecache_forced_flush unit=us ops=1 min=%lu.00 med=%lu.00 dirty_lines=%lu\n",
+           (unsigned long)(HostSim_NowUs() - t0), (unsigned long)(HostSim_NowUs() - t0), (unsigned long)dirty0);
+
+    printf("eeprom writes: through=%lu back=%lu (coalesced=%lu, dev_writes=%lu) saved %.1f %%\n",
+           (unsigned long)through, (unsigned long)back, (unsigned long)eeCache.coalesced,
+           (unsigned long)eeCache.dev_writes, through ? 100.0 * (1.0 - (double)eeCache.dev_writes / through) : 0.0);
+
+    if (memcmp(g_eeprom.mem, s_shadow, sizeof(s_shadow)) != 0) {
+        printf("FAIL eecache: EEPROM differs from last written values\n");
+        s_rc = 1;
+    } else if (eeCache.dev_writes >= through || eeCache.flush_errors != 0u) {
+        printf("FAIL eecache: no write reduction (dev_writes=%lu errors=%lu)\n",
+               (unsigned long)eeCache.dev_writes, (unsigned long)eeCache.flush_errors);
+        s_rc = 1;
+    }
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    static const BusDev_t dev = { "eeprom0", BUSDEV_EEPROM, BUS_SPI1, 0, NULL, 0 };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc) s_run_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-t ms]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_run_ms < 50u) s_run_ms = 50u;
+
+    HostBoard_Init();
+    memcpy(s_shadow, g_eeprom.mem, sizeof(s_shadow));
+
+    osKernelInitialize();
+    BusMgr_Init();
+    s_dev = BusMgr_Register(&dev);
+    if (s_dev < 0) return 1;
+    EECache_Init(&eeCache, s_dev);
+
+    const osThreadAttr_t cache_attributes = {
+      .name = "EECacheTask", .stack_size = 192 * 4, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    const osThreadAttr_t prod_attributes = {
+      .name = "Producer", .stack_size = 192 * 4, .priority = (osPriority_t)osPriorityNormal,
+    };
+    const osThreadAttr_t ctrl_attributes = {
+      .name = "EECacheBench", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityHigh,
+    };
+    osThreadNew(StartEECacheTask, NULL, &cache_attributes);
+    for (uintptr_t i = 0; i < NPROD; i++) s_thr[i] = osThreadNew(prvProducer, (void *)i, &prod_attributes);
+    osThreadNew(prvController, NULL, &ctrl_attributes);
+
+    HostBoard_Run(0u);
+    return s_rc;
+}
@@ -0,0 +1,140 @@
+/*
+ * bench_flash.c  (Host build)
+ *
+ *  SPI NOR flash 로그 저장소(FlashLog) 처리량과 전원 차단 후 복구 시간.
+ *    flash_append   : 32B payload record N 개 append (sector 소거 포함)
+ *    eeprom_append  : 같은 크기 기록을 25LC256 (SPI2, BusMgr_Write) 에 순차 기록
+ *    flash_mount    : append 중 전원 차단 → 재투입 후 FlashLog_Mount (sector 머리 + head sector 만 읽음)
+ *    flash_scan     : 같은 이미지를 처음부터 끝까지 순회 (전체 스캔 복구였다면 걸렸을 시간)
+ *  가상 시간 기준이므로 결정적. BENCH v=1 형식 (unit=us, 단계 전체 소요 시간).
+ *    usage: bench_flash [-n records]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "FlashLog.h"
+#include "host_board.h"
+#include "host_sim.h"
+
+#define PAYLOAD_LEN   32u
+#define CUT_BYTES     77u       /* 전원 차단 지점: 다음 record 중간 */
+
+static FlashLog_t s_log;
+static SpiFlash_t s_fl;
+static uint32_t   s_records = 2000u;
+static uint32_t   s_ok;        /* HAL_OK 로 끝난 append 수 */
+static int        s_rc;
+
+static void prvReport(const char *name, uint32_t ops, uint64_t us, uint32_t bytes, const char *extra)
+{
+    unsigned long kbs = (us != 0u) ? (unsigned long)((uint64_t)bytes * 1000000u / 1024u / us) : 0ul;
+    unsigned long rps = (us != 0u) ? (unsigned long)((uint64_t)ops * 1000000u / us) : 0ul;
+    printf("BENCH v=1 name=%s unit=us ops=%lu min=%lu.00 med=%lu.00 bytes=%lu kb_s=%lu rec_s=%lu%s\n",
+           name, (unsigned long)ops, (unsigned long)us, (unsigned long)us, (unsigned long)bytes, kbs, rps, extra);
+}
+
+static void prvFail(const char *what)
+{
+    printf("FAIL bench_flash: %s\n", what);
+    s_rc = 1;
+    vTaskEndScheduler();
+}
+
+static void prvController(void *argument)
+{
+    uint8_t p[PAYLOAD_LEN];
+    char extra[96];
+    uint64_t t0, us;
+    (void)argument;
+
+    if (SpiFlash_Init(&s_fl, BusMgr_Find("flash0")) != HAL_OK) prvFail("flash0 JEDEC id");
+    if (FlashLog_Mount(&s_log, &s_fl, FLASHLOG_BASE, FLASHLOG_SECTORS) != HAL_OK) prvFail("mount");
+
+    /* 1) flash append */
+    t0 = HostSim_NowUs();
+    for (uint32_t i = 0; i < s_records; i++) {
+        memset(p, (int)i, sizeof(p));
+        if (FlashLog_Append(&s_log, FLASHLOG_REC_TRACE, p, sizeof(p)) != HAL_OK) prvFail("append");
+        s_ok++;
+    }
+    us = HostSim_NowUs() - t0;
+    snprintf(extra, sizeof(extra), " erases=%lu pages=%lu", (unsigned long)s_fl.erases, (unsigned long)s_fl.pages);
+    prvReport("flash_append", s_records, us, s_records * PAYLOAD_LEN, extra);
+
+    /* 2) 같은 기록을 25LC256 에 (32KB 안에서 순환) */
+    int8_t ee = BusMgr_Find("eeprom1");
+    t0 = HostSim_NowUs();
+    for (uint32_t i = 0; i < s_records; i++) {
+        memset(p, (int)i, sizeof(p));
+        if (BusMgr_Write(ee, (i * PAYLOAD_LEN) % M25LC256_SIZE, p, sizeof(p)) != HAL_OK) prvFail("eeprom write");
+    }
+    us = HostSim_NowUs() - t0;
+    prvReport("eeprom_append", s_records, us, s_records * PAYLOAD_LEN, "");
+
+    /* 3) append 중 전원 차단 → 재투입 → 마운트 */
+    W25Q_ArmPowerCut(&g_flash, CUT_BYTES);
+    for (uint32_t i = 0; i < 64u && !g_flash.dead; i++) {
+        if (FlashLog_Append(&s_log, FLASHLOG_REC_TRACE, p, sizeof(p)) == HAL_OK) s_ok++;
+    }
+    if (!g_flash.dead) prvFail("power cut not reached");
+    W25Q_PowerOn(&g_flash);
+
+    t0 = HostSim_NowUs();
+    if (FlashLog_Mount(&s_log, &s_fl, FLASHLOG_BASE, FLASHLOG_SECTORS) != HAL_OK) prvFail("remount");
+    us = HostSim_NowUs() - t0;
+    snprintf(extra, sizeof(extra), " torn=%lu next_rec=%lu head=%lu",
+             (unsigned long)s_log.torn, (unsigned long)s_log.next_rec, (unsigned long)s_log.head);
+    prvReport("flash_mount", 1u, us, FLASHLOG_SECTORS * FLASHLOG_SECTOR_HDR + SPIFLASH_SECTOR_SIZE, extra);
+
+    /* 4) 비교: 전체 순회 */
+    FlashLog_Iter_t it;
+    uint8_t type, buf[FLASHLOG_MAX_PAYLOAD];
+    uint32_t seq, n = 0;
+    uint16_t len;
+    t0 = HostSim_NowUs();
+    FlashLog_IterBegin(&s_log, &it);
+    while (FlashLog_IterNext(&s_log, &it, &type, &seq, buf, sizeof(buf), &len) == HAL_OK) n++;
+    us = HostSim_NowUs() - t0;
+    prvReport("flash_scan", n, us, n * PAYLOAD_LEN, "");
+
+    /* 영역이 한 바퀴 돌지 않았다면 완료된 append 는 모두 남아 있어야 함 */
+    if (s_records < 20000u && n != s_ok) prvFail("records lost after power cut");
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    static const BusDev_t devs[] = {
+        { "flash0",  BUSDEV_SPI_FLASH, BUS_SPI2, 0, FLASH_CS_GPIO_Port, FLASH_CS_Pin },
+        { "eeprom1", BUSDEV_EEPROM,    BUS_SPI2, 0, EE2_CS_GPIO_Port,   EE2_CS_Pin   },
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) s_records = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-n records]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_records == 0u) s_records = 1u;
+
+    HostBoard_Init();
+    osKernelInitialize();
+    BusMgr_Init();
+    for (uint32_t i = 0; i < sizeof(devs) / sizeof(devs[0]); i++) {
+        if (BusMgr_Register(&devs[i]) < 0) return 1;
+    }
+
+    const osThreadAttr_t ctrl_attributes = {
+      .name = "FlashBench", .stack_size = 512 * 4, .priority = (osPriority_t)osPriorityNormal,
+    };
+    osThreadNew(prvController, NULL, &ctrl_attributes);
+
+    HostBoard_Run(0u);
+    return s_rc;
+}
@@ -0,0 +1,232 @@
+/*
+ * bench_pdid.c  (Host build)
+ *
+ *  0x2A periodic DID 100 개: fast 10 / medium 30 / slow 60 (합성 표 F200~F263, 데이터 1~7B)
+ *  1) 스케줄러 비용 (Bench_RunCase): 기준 tick 1 회 = 만기 검사 100 slot + 만기 프레임 구성/송신
+ *     (송신은 항상 성공하는 stub) → tick 당 ns, 초당 tick 수로 CPU 점유율 환산 (host 기준)
+ *  2) 보드 Task 구성 시뮬레이션: extended 세션 → 2A 요청 (SF, pDID 5 개씩) → 3E 80 으로 세션 유지,
+ *     테스터 노드가 UDS_PERIODIC_CANID 프레임의 pDID 별 간격을 기록
+ *     → 주기별 달성 주기 / 지터 (간격 - 공칭), 건너뛴 주기, 버스 점유율, tick 대비 프레임 수
+ *    usage: bench_pdid [-t seconds] [-n iters]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Bench.h"
+#include "host_board.h"
+#include "host_sim.h"
+#include "test_check.h"
+
+#define N_DIDS       100u
+#define N_FAST       10u
+#define N_MEDIUM     30u
+#define PER_REQ      5u         /* SF: 2A mode + pDID 5 개 */
+#define START_US     5000u      /* mount 이후 */
+#define GAP_US       3000u
+#define KEEPALIVE_MS 2000u
+#define WARMUP_MS    1100u      /* 첫 slow 주기 이후부터 간격 집계 */
+
+static DID_Entry_t s_entries[N_DIDS];
+static uint32_t    s_live[N_DIDS][2];
+static DID_Table_t s_table = { s_entries, N_DIDS };
+static uint32_t    s_seconds = 10u;
+
+static void prvWrite(const char *line)
+{
+    fputs(line, stdout);
+}
+
+static uint8_t prvMode(uint32_t i)
+{
+    if (i < N_FAST)            return PDID_MODE_FAST;
+    if (i < N_FAST + N_MEDIUM) return PDID_MODE_MEDIUM;
+    return PDID_MODE_SLOW;
+}
+
+static uint32_t prvNominalUs(uint8_t mode)
+{
+    if (mode == PDID_MODE_FAST)   return PDID_RATE_FAST_MS * 1000u;
+    if (mode == PDID_MODE_MEDIUM) return PDID_RATE_MEDIUM_MS * 1000u;
+    return PDID_RATE_SLOW_MS * 1000u;
+}
+
+static void prvMakeTable(void)
+{
+    for (uint32_t i = 0; i < N_DIDS; i++) {
+        s_live[i][0] = 0x01020304u * (i + 1u);
+        s_live[i][1] = ~s_live[i][0];
+        s_entries[i] = (DID_Entry_t){ .did = (uint16_t)(PDID_DID_BASE + i), .fmt = DID_FMT_U8,
+                                      .len = (uint8_t)(1u + i % PDID_DATA_MAX), .access = DID_ACC_READ,
+                                      .live = s_live[i] };
+    }
+}
+
+/* ===== 1) tick 비용 ===== */
+static PDID_Sched_t s_bench;
+static volatile uint32_t s_sink;
+
+static HAL_StatusTypeDef prvStubSend(const uint8_t *frame)
+{
+    s_sink += frame[1];
+    return HAL_OK;
+}
+
+static void Bench_Tick(void *ctx, uint32_t iters)
+{
+    PDID_Sched_t *s = ctx;
+    while (iters--) PDID_Tick(s);
+}
+
+/* ===== 2) 시뮬레이션 ===== */
+typedef struct {
+    uint32_t count;
+    uint64_t last_us;
+    uint32_t gaps;
+    double   sum_gap, sum_sq_jit;
+    double   max_jit;
+} PdidRx_t;
+
+static PdidRx_t s_rx[N_DIDS];
+static uint32_t s_other;
+static uint32_t s_step;
+
+static void prvNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != UDS_PERIODIC_CANID) return;
+    if (f->data[0] >= N_DIDS || memcmp(&f->data[1], s_live[f->data[0]], s_entries[f->data[0]].len) != 0) {
+        s_other++;
+        return;
+    }
+    PdidRx_t *r = &s_rx[f->data[0]];
+    if (r->count != 0u && f->t_us >= WARMUP_MS * 1000ull) {
+        double gap = (double)(f->t_us - r->last_us);
+        double jit = gap - (double)prvNominalUs(prvMode(f->data[0]));
+        r->gaps++;
+        r->sum_gap += gap;
+        r->sum_sq_jit += jit * jit;
+        if (fabs(jit) > r->max_jit) r->max_jit = fabs(jit);
+    }
+    r->last_us = f->t_us;
+    r->count++;
+}
+
+/* 10 03 → 2A 요청 (pDID 5 개씩, rate 별 개수는 5 의 배수) */
+static void prvSetupEvt(void *arg)
+{
+    uint8_t frame[8] = { 0x02, 0x10, 0x03, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+
+    (void)arg;
+    if (s_step != 0u) {
+        uint32_t first = (s_step - 1u) * PER_REQ;
+        frame[0] = 2u + PER_REQ;
+        frame[1] = 0x2A;
+        frame[2] = prvMode(first);
+        for (uint32_t n = 0; n < PER_REQ; n++) frame[3u + n] = (uint8_t)(first + n);
+    }
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, frame, 8);
+    if (++s_step <= N_DIDS / PER_REQ) HostSim_Schedule(GAP_US, prvSetupEvt, NULL);
+}
+
+static void prvKeepAliveEvt(void *arg)
+{
+    static const uint8_t tp[8] = { 0x02, 0x3E, 0x80, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+    (void)arg;
+    (void)HostCAN_Inject(CAN1, UDS_FUNC_REQ_CANID, tp, 8);
+    HostSim_Schedule(KEEPALIVE_MS * 1000u, prvKeepAliveEvt, NULL);
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Config_t cfg = { .iters = 200u, .repeats = 9u, .write = prvWrite };
+    Bench_Result_t res;
+    uint8_t req[1u + N_DIDS];
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)      s_seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) cfg.iters = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-t seconds] [-n iters]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_seconds < 2u) s_seconds = 2u;
+
+    prvMakeTable();
+    CHECK(DID_CheckTable(&s_table) == HAL_OK);
+
+    /* 1) 표준 구성의 100 개 예약 → tick 비용 */
+    PDID_Init(&s_bench, &s_table, prvStubSend);
+    for (uint32_t i = 0; i < N_DIDS; ) {
+        uint32_t n = 0;
+        req[0] = prvMode(i);
+        while (i < N_DIDS && prvMode(i) == req[0]) req[1u + n++] = (uint8_t)i++;
+        CHECK(PDID_Request(&s_bench, req, (uint16_t)(1u + n)) == 0u);
+    }
+    CHECK(s_bench.used == N_DIDS);
+    req[0] = PDID_MODE_FAST; req[1] = 0xF0;                      /* 표에 없는 pDID */
+    CHECK(PDID_Request(&s_bench, req, 2) == UDS_NRC_REQUEST_OUT_OF_RANGE);
+
+    uint32_t perSec = 1000u / PDID_TICK_MS;
+    uint32_t framesPerSec = N_FAST * (1000u / PDID_RATE_FAST_MS) + (N_DIDS - N_FAST - N_MEDIUM) * (1000u / PDID_RATE_SLOW_MS)
+                          + N_MEDIUM * (1000u / PDID_RATE_MEDIUM_MS);
+    uint32_t sent0 = s_bench.sent;
+    for (uint32_t i = 0; i < perSec; i++) PDID_Tick(&s_bench);
+    CHECK(s_bench.sent - sent0 == framesPerSec && s_bench.late == 0u);
+
+    const Bench_Case_t tickCase = { "pdid_tick_100", Bench_Tick, &s_bench, 1u };
+    Bench_CounterInit();
+    Bench_RunCase(&cfg, &tickCase, &res);
+    double tickNs = res.med_x100 / 100.0;
+    printf("scheduler    : %lu ticks/s, %lu frames/s, %.0f %s/tick → CPU %.4f%% (host), task wakeups/s %lu (프레임당 wakeup 이면 %lu)\n",
+           (unsigned long)perSec, (unsigned long)framesPerSec, tickNs, Bench_Unit(),
+           tickNs * perSec / 1e7, (unsigned long)perSec, (unsigned long)framesPerSec);
+
+    /* 2) 보드 시뮬레이션: UDS 스케줄러가 합성 표를 사용 */
+    HostBoard_Init();
+    HostCAN_AddNode(CAN1, prvNode, NULL);
+    HostBoard_CreateTasks();
+    PDID_Init(&pdidSched, &s_table, pdidSched.send);
+    HostSim_Schedule(START_US, prvSetupEvt, NULL);
+    HostSim_Schedule(KEEPALIVE_MS * 1000u, prvKeepAliveEvt, NULL);
+    HostBoard_Run(s_seconds * 1000u);
+
+    HostCAN_Stats_t cs;
+    HostCAN_GetStats(CAN1, &cs);
+    static const char *names[3] = { "slow", "medium", "fast" };
+    uint32_t total = 0;
+    for (uint8_t mode = PDID_MODE_SLOW; mode <= PDID_MODE_FAST; mode++) {
+        uint32_t gaps = 0, ids = 0;
+        double sumGap = 0, sumSq = 0, maxJit = 0;
+        for (uint32_t i = 0; i < N_DIDS; i++) {
+            if (prvMode(i) != mode) continue;
+            ids++;
+            gaps += s_rx[i].gaps;
+            sumGap += s_rx[i].sum_gap;
+            sumSq += s_rx[i].sum_sq_jit;
+            if (s_rx[i].max_jit > maxJit) maxJit = s_rx[i].max_jit;
+        }
+        CHECK(gaps != 0u);
+        double meanUs = sumGap / gaps;
+        printf("rate %-6s  : %3lu DIDs, nominal %5lu us, mean %8.1f us, jitter rms %6.1f us max %6.1f us\n",
+               names[mode - 1u], (unsigned long)ids, (unsigned long)prvNominalUs(mode), meanUs,
+               sqrt(sumSq / gaps), maxJit);
+        /* 평균 주기는 공칭과 같아야 함 (tick 기반), 지터는 한 tick 미만 */
+        CHECK(fabs(meanUs - prvNominalUs(mode)) < prvNominalUs(mode) / 100u + 50u);
+        CHECK(maxJit < PDID_TICK_MS * 1000u);
+    }
+    for (uint32_t i = 0; i < N_DIDS; i++) total += s_rx[i].count;
+    printf("bus          : %lu periodic frames in %lu s (%lu ticks, late %lu), bus load %.1f%%, no-mailbox %lu\n",
+           (unsigned long)total, (unsigned long)s_seconds, (unsigned long)pdidSched.ticks,
+           (unsigned long)pdidSched.late, 100.0 * cs.busy_us / (s_seconds * 1e6), (unsigned long)cs.tx_no_mailbox);
+    CHECK(s_other == 0u && pdidSched.used == N_DIDS && pdidSched.late == 0u);
+    CHECK(udsServer.session == UDS_SESSION_EXTENDED);
+    printf("PASS pdid\n");
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * bench_pmic.c  (Host build)
+ *
+ *  PMIC 전체 상태 갱신(0x05~0x09 + 0x16~0x19, 9 레지스터) 1회당 I2C 버스 시간.
+ *  가상 시간 기준이므로 결정적이며, 같은 BENCH v=1 형식으로 출력 (unit=us, min=med).
+ *    usage: bench_pmic [-n refreshes]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PMIC.h"
+#include "host_sim.h"
+#include "model_mp5475.h"
+
+static I2C_HandleTypeDef s_hi2c;
+static MMP5475_t         s_pmic;
+
+/* 레지스터 1개씩 (기존 PMIC_ReadFaultRegister 방식) */
+static int prvRefreshLegacy(PMIC_Shadow_t *sh)
+{
+    static const uint8_t regs[PMIC_SHADOW_COUNT] = {
+        0x05, 0x06, 0x07, 0x08, 0x09, 0x16, 0x17, 0x18, 0x19,
+    };
+    for (uint32_t i = 0; i < PMIC_SHADOW_COUNT; i++) {
+        uint8_t v;
+        if (PMIC_ReadFaultRegister(sh->hi2c, (PMIC_Register_t)regs[i], &v) != HAL_OK) return -1;
+        PMIC_ShadowApply(sh, regs[i], &v, 1);
+        sh->xfers++;
+    }
+    return 0;
+}
+
+static int prvRefreshBurst(PMIC_Shadow_t *sh)
+{
+    return (PMIC_ShadowRefresh(sh, PMIC_GRP_ALL) == HAL_OK) ? 0 : -1;
+}
+
+static int prvRun(const char *name, uint32_t hz, int (*fn)(PMIC_Shadow_t *), uint32_t n)
+{
+    PMIC_Shadow_t sh;
+    HostI2C_Stats_t st;
+
+    s_hi2c.Init.ClockSpeed = hz;
+    PMIC_ShadowInit(&sh, &s_hi2c);
+    HostI2C_ResetStats(I2C1);
+
+    for (uint32_t i = 0; i < n; i++) {
+        /* 매 회 fault 비트를 바꿔 shadow 반영을 확인 */
+        MMP5475_SetReg(&s_pmic, PMIC_REG_UV_OV, (uint8_t)i);
+        if (fn(&sh) != 0) { printf("FAIL %s: I2C error\n", name); return -1; }
+        for (uint8_t r = 0; r < 0x20u; r++) {
+            uint8_t v;
+            if (PMIC_ShadowIndex(r) >= 0 && (PMIC_ShadowGet(&sh, r, &v) != HAL_OK || v != MMP5475_GetReg(&s_pmic, r))) {
+                printf("FAIL %s: shadow 0x%02X mismatch\n", name, r);
+                return -1;
+            }
+        }
+    }
+
+    HostI2C_GetStats(I2C1, &st);
+    unsigned long us_x100 = (unsigned long)(st.busy_us * 100u / n);
+    printf("BENCH v=1 name=%s unit=us ops=%lu min=%lu.%02lu med=%lu.%02lu xfers=%lu starts=%lu\n",
+           name, (unsigned long)n, us_x100 / 100u, us_x100 % 100u, us_x100 / 100u, us_x100 % 100u,
+           (unsigned long)(sh.xfers / n), (unsigned long)(st.transactions / n));
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 100u;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) n = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-n refreshes]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n == 0u) n = 1u;
+
+    HAL_Init();
+    s_hi2c.Instance = I2C1;
+    s_hi2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+    if (HAL_I2C_Init(&s_hi2c) != HAL_OK) return 1;
+    MMP5475_Init(&s_pmic);
+    if (MMP5475_Attach(&s_pmic, I2C1) != 0) return 1;
+
+    int rc = 0;
+    rc |= prvRun("pmic_refresh_single_100k", 100000u, prvRefreshLegacy, n);
+    rc |= prvRun("pmic_refresh_burst_100k",  100000u, prvRefreshBurst,  n);
+    rc |= prvRun("pmic_refresh_single_400k", 400000u, prvRefreshLegacy, n);
+    rc |= prvRun("pmic_refresh_burst_400k",  400000u, prvRefreshBurst,  n);
+    return (rc != 0) ? 1 : 0;
+}
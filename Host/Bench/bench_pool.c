@@ -0,0 +1,180 @@
+/*
+ * bench_pool.c  (Host build)
+ *
+ *  고정 블록 풀 (Core/Src/Pool.c) vs FreeRTOS heap_4 (pvPortMalloc/vPortFree)
+ *    - 같은 무작위 작업열: 크기 등급 3 개 (UDS 프레임 / 요청 / 응답) 의 슬롯을 골라
+ *      비어 있으면 할당, 차 있으면 해제. 슬롯 수 = 풀 블록 수 (풀은 고갈이 생기지 않는 구성)
+ *    - heap 은 타깃과 같은 configTOTAL_HEAP_SIZE (15 KB): 큰 응답 버퍼가 단편화로 실패할 수 있음
+ *    - 출력: BENCH 줄 (op 당 min/med ns) + op 하나씩 잰 최악값 / 실패 수 / heap 최소 여유
+ *    usage: bench_pool [-n iters] [-r repeats] [-s ops] [--quick]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Bench.h"
+#include "Pool.h"
+#include "UDS_CAN.h"
+#include "FreeRTOS.h"
+#include "test_check.h"
+
+#define CLASSES      3u
+#define MAX_SLOTS    16u
+#define MAX_OPS      4096u
+
+typedef struct {
+    const char *name;
+    uint16_t    size;
+    uint16_t    slots;           // 동시에 살아 있을 수 있는 블록 수
+} Class_t;
+
+/* 크기 = 실제 UDS 버퍼 (UDS_RxFrame_t / ISO-TP 요청 / 응답). 슬롯 수는 heap 15 KB 에 들어가는 구성 */
+static const Class_t s_class[CLASSES] = {
+    { "frame", sizeof(UDS_RxFrame_t), 16u },
+    { "req",   512u,                  2u },
+    { "rsp",   ISOTP_MAX_LEN,         2u },
+};
+
+typedef struct {
+    uint8_t cls, slot;
+} Op_t;
+
+typedef struct {
+    int      use_pool;
+    uint32_t failed;             // NULL 을 받은 할당
+    uint32_t worst;              // op 하나의 최대 비용 (ns)
+} Ctx_t;
+
+static Pool_t   s_pool[CLASSES];
+static uint32_t s_mem0[POOL_MEM_SIZE(16u, (sizeof(UDS_RxFrame_t) + 3u) & ~3u) / 4u];
+static uint32_t s_mem1[POOL_MEM_SIZE(2u, 512u) / 4u];
+static uint32_t s_mem2[POOL_MEM_SIZE(2u, (ISOTP_MAX_LEN + 3u) & ~3u) / 4u];
+static void    *s_live[CLASSES][MAX_SLOTS];
+static Op_t     s_ops[MAX_OPS];
+static uint32_t s_nops = 1024u;
+
+static void prvWrite(const char *line)
+{
+    fputs(line, stdout);
+}
+
+static uint32_t prvRand(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+/* 프레임 등급이 대부분 (CAN 수신), 요청/응답은 가끔 */
+static void prvMakeOps(void)
+{
+    uint32_t rnd = 47u;
+    for (uint32_t i = 0; i < s_nops; i++) {
+        uint32_t r = prvRand(&rnd) % 16u;
+        uint8_t cls = (r < 12u) ? 0u : (r < 14u) ? 1u : 2u;
+        s_ops[i] = (Op_t){ cls, (uint8_t)(prvRand(&rnd) % s_class[cls].slots) };
+    }
+}
+
+static void prvOp(Ctx_t *c, const Op_t *op)
+{
+    void **slot = &s_live[op->cls][op->slot];
+
+    if (*slot != NULL) {
+        if (c->use_pool) Pool_Free(&s_pool[op->cls], *slot);
+        else             vPortFree(*slot);
+        *slot = NULL;
+        return;
+    }
+    *slot = c->use_pool ? Pool_Alloc(&s_pool[op->cls], 0) : pvPortMalloc(s_class[op->cls].size);
+    if (*slot == NULL) c->failed++;
+    else               ((uint8_t *)*slot)[0] = op->slot;      // 블록을 실제로 건드림
+}
+
+/* 작업열 끝에서 남은 블록을 모두 해제: 매 iteration 같은 상태에서 시작 */
+static void prvDrain(Ctx_t *c)
+{
+    for (uint32_t k = 0; k < CLASSES; k++) {
+        for (uint32_t s = 0; s < s_class[k].slots; s++) {
+            if (s_live[k][s] == NULL) continue;
+            if (c->use_pool) Pool_Free(&s_pool[k], s_live[k][s]);
+            else             vPortFree(s_live[k][s]);
+            s_live[k][s] = NULL;
+        }
+    }
+}
+
+/* ===== 측정 대상 ===== */
+static void Bench_Workload(void *ctx, uint32_t iters)
+{
+    Ctx_t *c = ctx;
+    while (iters--) {
+        for (uint32_t i = 0; i < s_nops; i++) prvOp(c, &s_ops[i]);
+        prvDrain(c);
+    }
+}
+
+/* op 하나씩 시간을 재서 최악값 (시계 읽기 비용 포함) */
+static void prvWorst(Ctx_t *c, uint32_t iters)
+{
+    while (iters--) {
+        for (uint32_t i = 0; i < s_nops; i++) {
+            uint32_t t0 = Bench_Now();
+            prvOp(c, &s_ops[i]);
+            uint32_t dt = Bench_Now() - t0;
+            if (dt > c->worst) c->worst = dt;
+        }
+        prvDrain(c);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Config_t cfg = { .iters = 200u, .repeats = 9u, .write = prvWrite };
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc)      cfg.iters = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) cfg.repeats = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) s_nops = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--quick"))            { cfg.iters = 5u; cfg.repeats = 3u; }
+        else {
+            fprintf(stderr, "usage: %s [-n iters] [-r repeats] [-s ops] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_nops == 0u || s_nops > MAX_OPS) s_nops = MAX_OPS;
+
+    /* 스케줄러 없이: 풀 할당은 timeout 0, heap 은 vTaskSuspendAll 만 씀 */
+    CHECK(osKernelInitialize() == osOK);
+    CHECK(Pool_Init(&s_pool[0], "bench_frame", s_mem0, s_class[0].size, s_class[0].slots) == HAL_OK);
+    CHECK(Pool_Init(&s_pool[1], "bench_req", s_mem1, s_class[1].size, s_class[1].slots) == HAL_OK);
+    CHECK(Pool_Init(&s_pool[2], "bench_rsp", s_mem2, s_class[2].size, s_class[2].slots) == HAL_OK);
+    prvMakeOps();
+    Bench_CounterInit();
+
+    static Ctx_t pool = { .use_pool = 1 }, heap = { .use_pool = 0 };
+    const Bench_Case_t cases[2] = {
+        { "pool_alloc_free", Bench_Workload, &pool, s_nops },
+        { "heap4_alloc_free", Bench_Workload, &heap, s_nops },
+    };
+    vPortFree(pvPortMalloc(1u));             // heap_4 는 첫 할당에서 초기화
+    size_t free0 = xPortGetFreeHeapSize();
+    for (uint32_t i = 0; i < 2u; i++) Bench_RunCase(&cfg, &cases[i], NULL);
+    prvWorst(&pool, cfg.iters);
+    prvWorst(&heap, cfg.iters);
+
+    for (uint32_t k = 0; k < CLASSES; k++) {
+        printf("pool %-5s size=%4u blocks=%2u hwm=%2lu exhausted=%lu\n", s_class[k].name,
+               (unsigned)s_pool[k].size, (unsigned)s_pool[k].count,
+               (unsigned long)s_pool[k].hwm, (unsigned long)s_pool[k].exhausted);
+    }
+    printf("worst op: pool %lu ns, heap_4 %lu ns\n", (unsigned long)pool.worst, (unsigned long)heap.worst);
+    printf("failed allocs: pool %lu, heap_4 %lu (heap free %lu B, min ever %lu B)\n",
+           (unsigned long)pool.failed, (unsigned long)heap.failed,
+           (unsigned long)free0, (unsigned long)xPortGetMinimumEverFreeHeapSize());
+
+    CHECK(pool.failed == 0u);
+    for (uint32_t k = 0; k < CLASSES; k++) CHECK(s_pool[k].used == 0u && s_pool[k].exhausted == 0u);
+    CHECK(xPortGetFreeHeapSize() == free0);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * bench_uds_func.c  (Host build)
+ *
+ *  기능 주소(0x7DF) 요청 1 개당 처리 비용: 테스터가 모든 ECU 에 뿌리는 전형적인 요청 묶음
+ *    3E 80 x4 (세션 유지), 10 81 (응답 생략), 31 01 FF 00 / 85 82 (미지원 SID), 3E 00
+ *  legacy  : 기존 경로 = 모든 프레임을 큐로 넘겨 UDSTask 에서 처리, 응답(NRC 포함) 프레임 구성
+ *  preparse: UDS_PreParse 로 수신 콜백에서 판별 → 남은 요청만 처리, 생략 응답은 프레임 구성 안 함
+ *  (Bench_RunCase, 요청당 ns. 큐 전달/Task 전환 비용은 포함하지 않음 → wakeups 로 따로 표시)
+ *
+ *  이어서 보드 Task 구성으로 같은 묶음을 버스에 보내 응답/생략/Task 전달 횟수를 확인한다.
+ *    usage: bench_uds_func [-r rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Bench.h"
+#include "host_board.h"
+#include "host_sim.h"
+#include "test_check.h"
+
+#define MIX_LEN      8u
+#define START_US     5000u      /* mount 이후 */
+#define GAP_US       2000u
+#define MAX_ROUNDS   200u
+
+static const uint8_t s_mix[MIX_LEN][8] = {
+    { 0x02, 0x3E, 0x80 },
+    { 0x02, 0x10, 0x81 },
+    { 0x02, 0x3E, 0x80 },
+    { 0x04, 0x31, 0x01, 0xFF, 0x00 },
+    { 0x02, 0x3E, 0x80 },
+    { 0x02, 0x85, 0x82 },
+    { 0x02, 0x3E, 0x80 },
+    { 0x02, 0x3E, 0x00 },
+};
+
+static uint32_t s_rounds = 50u;
+static volatile uint32_t s_sink;
+
+static void prvWrite(const char *line)
+{
+    fputs(line, stdout);
+}
+
+/* UDS_Transmit 과 같은 첫 프레임 구성 (classic 링크, 8B 패딩) */
+static const IsoTp_Link_t s_link;
+
+static void prvEncode(const uint8_t *rsp, uint16_t len, uint8_t *frame)
+{
+    uint8_t flen;
+    (void)IsoTp_FirstFrame(&s_link, rsp, len, frame, &flen);
+}
+
+/* ===== 요청당 비용 (Bench_RunCase) ===== */
+static void Bench_Legacy(void *ctx, uint32_t iters)
+{
+    uint8_t rsp[ISOTP_MAX_LEN], frame[8] = { 0 }, sup;
+
+    (void)ctx;
+    while (iters--) {
+        for (uint32_t i = 0; i < MIX_LEN; i++) {
+            uint16_t n = UDS_HandleRequest(&s_mix[i][1], s_mix[i][0], 0, rsp, &sup);
+            if (n != 0u) prvEncode(rsp, n, frame);
+            s_sink += frame[1];
+        }
+    }
+}
+
+static void Bench_Func(void *ctx, uint32_t iters)
+{
+    uint8_t rsp[ISOTP_MAX_LEN], frame[8] = { 0 }, sup;
+
+    (void)ctx;
+    while (iters--) {
+        for (uint32_t i = 0; i < MIX_LEN; i++) {
+            if (UDS_PreParse(s_mix[i], 8, 1) != UDS_RX_QUEUE) continue;
+            uint16_t n = UDS_HandleRequest(&s_mix[i][1], s_mix[i][0], 1, rsp, &sup);
+            if (n != 0u && !sup) prvEncode(rsp, n, frame);
+            s_sink += frame[1];
+        }
+    }
+}
+
+/* ===== 버스 (보드 Task 구성) ===== */
+static uint32_t s_sent, s_rsp, s_rsp_other;
+static uint8_t  s_last[8];
+
+static void prvSendEvt(void *arg)
+{
+    (void)arg;
+    (void)HostCAN_Inject(CAN1, UDS_FUNC_REQ_CANID, s_mix[s_sent % MIX_LEN], 8);
+    if (++s_sent < s_rounds * MIX_LEN) HostSim_Schedule(GAP_US, prvSendEvt, NULL);
+}
+
+/* 물리 주소 확인용: 3E 80 (생략) → 31 01 FF 00 (0x11 응답) */
+static void prvPhysEvt(void *arg)
+{
+    static const uint8_t tp[8]  = { 0x02, 0x3E, 0x80 };
+    static const uint8_t rc[8] = { 0x04, 0x31, 0x01, 0xFF, 0x00 };
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, arg != NULL ? rc : tp, 8);
+}
+
+/* 기능 주소로 extended 세션 진입 (응답 생략) */
+static void prvSessionEvt(void *arg)
+{
+    static const uint8_t ext[8] = { 0x02, 0x10, 0x83 };
+    (void)arg;
+    (void)HostCAN_Inject(CAN1, UDS_FUNC_REQ_CANID, ext, 8);
+}
+
+static void prvNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != UDS_RES_CANID || f->dlc != 8u) return;      /* 파이프라인 DTC 프레임(DLC 2) 제외 */
+    if (f->data[1] == 0x7Eu && f->data[2] == 0x00u) s_rsp++;
+    else s_rsp_other++;
+    memcpy(s_last, f->data, 8);
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Config_t cfg = { .iters = 20000u, .repeats = 9u, .write = prvWrite };
+    uint32_t queued = 0, keepalive = 0, dropped = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-r") && i + 1 < argc) s_rounds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-r rounds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (s_rounds == 0u || s_rounds > MAX_ROUNDS) s_rounds = 50u;
+
+    for (uint32_t i = 0; i < MIX_LEN; i++) {
+        UDS_RxAction_t act = UDS_PreParse(s_mix[i], 8, 1);
+        queued    += (act == UDS_RX_QUEUE);
+        keepalive += (act == UDS_RX_KEEPALIVE);
+        dropped   += (act == UDS_RX_DROP);
+    }
+    CHECK(queued == 2u && keepalive == 4u && dropped == 2u);
+    CHECK(UDS_PreParse(s_mix[3], 8, 0) == UDS_RX_QUEUE);             /* 물리 주소는 그대로 */
+
+    const Bench_Case_t cases[] = {
+        { "uds_func_req_legacy", Bench_Legacy, NULL, MIX_LEN },
+        { "uds_func_req_preparse", Bench_Func, NULL, MIX_LEN },
+    };
+    Bench_CounterInit();
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) Bench_RunCase(&cfg, &cases[i], NULL);
+    printf("wakeups/req  : legacy %u/%u, preparse %lu/%u (UDSTask 로 넘어가는 요청)\n",
+           MIX_LEN, MIX_LEN, (unsigned long)queued, MIX_LEN);
+
+    /* 버스: 세션 진입 → 묶음 반복 → 물리 주소 확인 */
+    HostBoard_Init();
+    HostCAN_AddNode(CAN1, prvNode, NULL);
+    HostSim_Schedule(START_US, prvSessionEvt, NULL);
+    HostSim_Schedule(START_US + GAP_US, prvSendEvt, NULL);
+    uint32_t endUs = START_US + GAP_US * (s_rounds * MIX_LEN + 1u);
+    HostSim_Schedule(endUs + GAP_US, prvPhysEvt, NULL);
+    HostSim_Schedule(endUs + 2u * GAP_US, prvPhysEvt, (void *)1);
+    HostBoard_CreateTasks();
+    HostBoard_Run((endUs + 4u * GAP_US) / 1000u + 1u);
+
+    printf("bus          : sent=%lu requests=%lu (func %lu) keepalive=%lu dropped=%lu suppressed=%lu\n",
+           (unsigned long)(s_sent + 3u), (unsigned long)udsServer.requests, (unsigned long)udsServer.func_requests,
+           (unsigned long)udsServer.func_keepalive, (unsigned long)udsServer.func_dropped,
+           (unsigned long)udsServer.suppressed);
+    printf("responses    : 7E 00 %lu, other %lu\n", (unsigned long)s_rsp, (unsigned long)s_rsp_other);
+
+    /* 3E 00 만 응답, 나머지는 콜백에서 끝나거나(3E 80, 미지원 SID) 응답 생략(10 8x) */
+    CHECK(s_sent == s_rounds * MIX_LEN);
+    CHECK(udsServer.func_keepalive == 4u * s_rounds);
+    CHECK(udsServer.func_dropped == 2u * s_rounds);
+    CHECK(udsServer.func_requests == 2u * s_rounds + 1u);
+    CHECK(udsServer.requests == udsServer.func_requests + 2u);
+    CHECK(s_rsp == s_rounds);
+    /* 물리 3E 80 은 생략, 물리 미지원 SID 는 NRC 0x11 */
+    static const uint8_t nrc[8] = { 0x03, 0x7F, 0x31, UDS_NRC_SERVICE_NOT_SUPPORTED, UDS_PAD_BYTE, UDS_PAD_BYTE, UDS_PAD_BYTE, UDS_PAD_BYTE };
+    CHECK(s_rsp_other == 1u && memcmp(s_last, nrc, 8) == 0);
+    CHECK(udsServer.suppressed == s_rounds + 2u);
+    CHECK(udsServer.session == UDS_SESSION_DEFAULT);              /* 묶음의 10 81 */
+    printf("PASS uds_func\n");
+    return 0;
+}
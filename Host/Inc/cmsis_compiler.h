@@ -0,0 +1,59 @@
+/*
+ * cmsis_compiler.h  (Host build)
+ *
+ *  Linux 호스트 빌드용 CMSIS compiler 대체 헤더.
+ *  Cortex-M intrinsic(IPSR/PRIMASK/BASEPRI, 배리어)을 호스트 포트의
+ *  가상 인터럽트 상태로 매핑한다.
+ */
+
+#ifndef HOST_CMSIS_COMPILER_H_
+#define HOST_CMSIS_COMPILER_H_
+
+#include <stdint.h>
+
+#ifndef   __ASM
+  #define __ASM                 __asm
+#endif
+#ifndef   __INLINE
+  #define __INLINE              inline
+#endif
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE       static inline
+#endif
+#ifndef   __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE  __attribute__((always_inline)) static inline
+#endif
+#ifndef   __NO_RETURN
+  #define __NO_RETURN           __attribute__((__noreturn__))
+#endif
+#ifndef   __USED
+  #define __USED                __attribute__((used))
+#endif
+#ifndef   __WEAK
+  #define __WEAK                __attribute__((weak))
+#endif
+#ifndef   __PACKED
+  #define __PACKED              __attribute__((packed, aligned(1)))
+#endif
+#ifndef   __ALIGNED
+  #define __ALIGNED(x)          __attribute__((aligned(x)))
+#endif
+
+/* 호스트 포트(Host/Port/port.c)가 제공하는 가상 인터럽트 상태 */
+uint32_t ulPortHostGetIPSR(void);
+uint32_t ulPortHostGetPRIMASK(void);
+void     vPortHostSetPRIMASK(uint32_t primask);
+
+__STATIC_INLINE uint32_t __get_IPSR(void)    { return ulPortHostGetIPSR(); }
+__STATIC_INLINE uint32_t __get_PRIMASK(void) { return ulPortHostGetPRIMASK(); }
+__STATIC_INLINE uint32_t __get_BASEPRI(void) { return 0U; }
+__STATIC_INLINE void     __disable_irq(void) { vPortHostSetPRIMASK(1U); }
+__STATIC_INLINE void     __enable_irq(void)  { vPortHostSetPRIMASK(0U); }
+
+#define __NOP()   __asm volatile ("" ::: "memory")
+#define __DSB()   __sync_synchronize()
+#define __DMB()   __sync_synchronize()
+#define __ISB()   __asm volatile ("" ::: "memory")
+#define __WFI()   __asm volatile ("" ::: "memory")
+
+#endif /* HOST_CMSIS_COMPILER_H_ */
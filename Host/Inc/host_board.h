@@ -0,0 +1,56 @@
+/*
+ * host_board.h  (Host build)
+ *
+ *  main.c 의 보드 구성(HAL 핸들, MX_*_Init 설정, RTOS 객체, Task 생성)을 호스트에서 재현.
+ *  main.c 자체는 SystemClock/RCC 등 타깃 전용 코드를 포함하므로 호스트에서 빌드하지 않는다.
+ */
+
+#ifndef HOST_BOARD_H_
+#define HOST_BOARD_H_
+
+#include "main.h"
+#include "cmsis_os.h"
+
+#include "model_25lc256.h"
+#include "model_mp5475.h"
+#include "model_w25q.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* main.c 와 동일한 핸들 */
+extern ADC_HandleTypeDef   hadc1;
+extern TIM_HandleTypeDef   htim2;
+extern CAN_HandleTypeDef   hcan1;
+extern I2C_HandleTypeDef   hi2c1, hi2c2;
+extern SPI_HandleTypeDef   hspi1, hspi2;
+extern UART_HandleTypeDef  huart4;
+
+extern osEventFlagsId_t    CommEventFlagHandle;
+extern osMessageQueueId_t  LogQueueHandle;
+
+/* 보드에 실장된 디바이스 모델 */
+extern M25LC256_t g_eeprom;     /* SPI1, 보드 레벨 CS */
+extern MMP5475_t  g_pmic;       /* I2C1 */
+extern M25LC256_t g_eeprom2;    /* SPI2, CS = EE2_CS (PB12) */
+extern MMP5475_t  g_pmic2;      /* I2C2 */
+extern W25Q_t     g_flash;      /* SPI2, CS = FLASH_CS (PB14), RAM 전용 */
+
+/* HAL_Init + MX_*_Init 재현 + 디바이스 모델 연결 */
+void HostBoard_Init(void);
+/* osKernelInitialize + 커널 객체/Task 생성 (main.c 와 동일 속성) */
+void HostBoard_CreateTasks(void);
+/* 주어진 가상 시간(ms) 동안 스케줄러 실행. 한 프로세스에서 1회만 호출 가능 */
+void HostBoard_Run(uint32_t ms);
+/* ADC1 CH2 에 보이는 12V 계통 전압 (기본 12000mV). 실행 중 변경 가능 */
+void HostBoard_SetSupply_mV(uint32_t mV);
+/* UDS 를 CAN1 버스의 외부 CAN FD 컨트롤러 모델로 (HostBoard_CreateTasks 전).
+ * tx_dl: ISO-TP TX_DL (12~64), data_bps: 데이터 구간 bit rate (0 = BRS 없음) */
+void HostBoard_UseCanFd(uint8_t tx_dl, uint32_t data_bps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_BOARD_H_ */
@@ -0,0 +1,39 @@
+/*
+ * host_boot_board.h  (Host build)
+ *
+ *  Bootloader/Src/boot_main.c 의 보드 구성(CAN1, BootQueue, Boot/Flash Task)을 호스트에서 재현.
+ *  리셋은 기록만 한다 (Boot_Reset → bootState.resets, 마지막 flag).
+ *  host_board.c 와 한 실행 파일에 같이 링크하지 않는다 (hcan1 / Error_Handler 중복).
+ */
+
+#ifndef HOST_BOOT_BOARD_H_
+#define HOST_BOOT_BOARD_H_
+
+#include "Boot.h"
+#include "FlashProg.h"
+#include "uds_client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern CAN_HandleTypeDef   hcan1;
+
+/* HAL_Init + CAN1 (boot_main.c 와 같은 필터) */
+void     HostBootBoard_Init(void);
+/* osKernelInitialize + BootQueue + FlashProg/Boot 초기화 + Task 생성 (boot_main.c 와 같은 속성) */
+void     HostBootBoard_CreateTasks(void);
+/* 주어진 가상 시간(ms) 동안 스케줄러 실행. 한 프로세스에서 1회만 호출 가능 */
+void     HostBootBoard_Run(uint32_t ms);
+/* 마지막 Boot_Reset flag (리셋이 없었으면 BOOT_FLAG_NONE) */
+uint32_t HostBootBoard_LastReset(void);
+
+/* 시뮬레이션 테스터 링크 (CAN1 0x7E0 송신 / 0x7E8 수신). 테스터 Task 안에서 호출.
+ * 송신은 테스터 TX 버퍼 2 개 (주입 프레임이 버스에 나가면 반환) → 버스를 쉬지 않고 채움 */
+void     HostBootBoard_TesterInit(UdsClient_t *c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_BOOT_BOARD_H_ */
@@ -0,0 +1,78 @@
+/*
+ * host_replay.h  (Host build)
+ *
+ *  BusRec 기록 재생 (Core/Inc/BusRec.h 덤프 형식)
+ *  - 입력: UART4 'B' 덤프 (앞뒤에 파이프라인 원시 바이트가 섞여도 "BUSREC v=" 부터 읽음)
+ *  - CAN 수신   → 기록된 시각에 수신이 끝나도록 HostCAN_Inject / HostCAN_InjectFd
+ *  - I2C 읽기   → PMIC 모델 레지스터 sample-and-hold: 직전 관측 직후에 새 값 반영
+ *                 (첫 관측은 시작 시 설정, 펌웨어가 쓴 레지스터는 건드리지 않음)
+ *  - SPI 읽기   → EEPROM / flash 모델 초기 내용 (기록 안에서 먼저 쓰거나 소거한 주소는 제외)
+ *  - 비교: 재생 실행의 BusRec 출력 (CAN 송신, I2C/SPI 쓰기) 을 버스별로 기록과 순서대로 대조
+ *  open-loop 재생: 펌웨어 응답에 따라 자극을 바꾸지 않는다. 기록 시각 원점 = CYCCNT 활성화 (부팅 직후).
+ */
+
+#ifndef HOST_REPLAY_H_
+#define HOST_REPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "BusRec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_REPLAY_CMP_SLACK_US   10000u   /* 비교 구간: 기록 마지막 시각 + 여유 */
+
+typedef struct
+{
+    uint64_t t_us;                      /* 기록 원점 기준 시각 */
+    uint32_t id;
+    uint16_t len;                       /* 실제 전송 길이 */
+    uint8_t  bus;
+    uint8_t  op;                        /* BusRec_Op_t */
+    uint8_t  n;                         /* 보관된 데이터 (BUSREC_MAX_DATA 까지) */
+    uint8_t  data[BUSREC_MAX_DATA];
+} HostReplay_Rec_t;
+
+typedef struct
+{
+    HostReplay_Rec_t *rec;              /* 덤프 순서 */
+    uint32_t n;
+    uint32_t cap;
+    uint32_t dropped;                   /* 기록 중 덮어쓴 항목 (0 이 아니면 앞부분 유실) */
+} HostReplay_Log_t;
+
+typedef struct
+{
+    uint32_t records;
+    uint32_t can_rx;                    /* 주입할 CAN 프레임 */
+    uint32_t reg_updates;               /* 실행 중 바꿀 PMIC 레지스터 */
+    uint32_t seeded;                    /* 시작 시 설정한 레지스터 + 메모리 바이트 */
+    uint32_t skipped;                   /* 재생할 수 없는 입력 (확장 ID, 모델 없는 디바이스) */
+} HostReplay_Stats_t;
+
+/* 덤프 텍스트 → 레코드. 0 = 성공 */
+int      HostReplay_Parse(const char *text, size_t len, HostReplay_Log_t *log);
+void     HostReplay_Free(HostReplay_Log_t *log);
+
+/* 재생할 기록 (덤프 파일). HostBoard_Init 전후 무관 */
+int      HostReplay_Load(const char *path);
+/* HostBoard_Init 뒤, HostBoard_Run 전: 모델 초기 내용 설정 + 자극 예약 */
+int      HostReplay_Start(void);
+/* 마지막 기록 시각 + margin (HostBoard_Run 인자) */
+uint32_t HostReplay_DurationMs(uint32_t margin_ms);
+void     HostReplay_GetStats(HostReplay_Stats_t *out);
+/* HostBoard_Run 뒤: 이번 실행의 BusRec 기록과 대조.
+ *   REPLAY v=1 records= can_rx= reg_updates= seeded= skipped=
+ *   CMP bus= rec= out= match= first_diff= dt_mean_us= dt_max_us=    (출력이 있는 버스마다)
+ *   E
+ * 반환: 기록의 출력을 모두 재현하지 못한 버스 수 */
+uint32_t HostReplay_Compare(void (*write)(const char *line));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_REPLAY_H_ */
@@ -0,0 +1,210 @@
+/*
+ * host_sim.h  (Host build)
+ *
+ *  호스트 시뮬레이션 제어 API.
+ *  - 가상 시간(us): HAL 호출/버스 전송이 시간을 소모하고, 경과 시 tick/디바이스 이벤트를
+ *    "인터럽트" 문맥에서 디스패치한다. 실제 벽시계와 무관하게 결정적으로 동작.
+ *  - 버스 모델 연결: I2C/SPI 디바이스 모델, CAN 노드, UART 리스너.
+ *  애플리케이션(Core/Src)은 이 헤더를 쓰지 않는다. 테스트/벤치/모델 전용.
+ */
+
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== 가상 시간 / 이벤트 ===== */
+typedef void (*HostSim_EventFn)(void *arg);
+
+uint64_t HostSim_NowUs(void);
+/* CPU/버스 시간 소모. 경과한 tick 과 이벤트는 인터럽트 허용 시 즉시 디스패치 */
+void     HostSim_Advance(uint32_t us);
+/* 다음 tick 또는 이벤트 시각까지 진행 (idle 태스크에서 사용) */
+void     HostSim_AdvanceToNextEvent(void);
+/* delay_us 뒤 ISR 문맥에서 fn(arg) 실행 */
+int      HostSim_Schedule(uint32_t delay_us, HostSim_EventFn fn, void *arg);
+/* 아직 실행되지 않은 fn(arg) 이벤트 제거 (전송 중단 등). 반환: 제거한 수 */
+uint32_t HostSim_Cancel(HostSim_EventFn fn, void *arg);
+/* osKernelStart() 가 반환할 가상 시각(ms, 0=무한) */
+void     HostSim_SetDuration(uint32_t ms);
+/* 보류 중인 인터럽트 처리 (포트 내부용) */
+void     HostSim_Dispatch(void);
+
+/* ===== GPIO ===== */
+typedef void (*HostGPIO_ListenerFn)(void *ctx, GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+int  HostGPIO_AddListener(GPIO_TypeDef *port, uint16_t pinMask, HostGPIO_ListenerFn fn, void *ctx);
+void HostGPIO_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+/* ===== I2C =====
+ * 바이트 레벨이 아닌 트랜잭션 레벨 모델: START..STOP(또는 Sr) 구간 1회 = 콜백 1회.
+ * 반환 0=ACK, 음수=NAK */
+typedef struct
+{
+    uint8_t  addr7;
+    void    *ctx;
+    int    (*write)(void *ctx, const uint8_t *data, uint16_t len);
+    int    (*read)(void *ctx, uint8_t *data, uint16_t len);
+} HostI2C_Device_t;
+
+typedef struct
+{
+    uint32_t transactions;   /* START 횟수 (Sr 포함) */
+    uint32_t bytes;          /* 주소 바이트 제외 데이터 바이트 */
+    uint32_t naks;
+    uint64_t busy_us;        /* 버스 점유 시간 합계 */
+} HostI2C_Stats_t;
+
+int  HostI2C_Attach(I2C_TypeDef *bus, const HostI2C_Device_t *dev);
+void HostI2C_GetStats(I2C_TypeDef *bus, HostI2C_Stats_t *out);
+void HostI2C_ResetStats(I2C_TypeDef *bus);
+/* 1 = 이후 DMA 전송이 끝나지 않음 (slave 가 SCL 을 잡고 있는 상태). HAL_I2C_DeInit 으로만 풀림 */
+void HostI2C_SetStall(I2C_TypeDef *bus, int stall);
+
+/* ===== SPI =====
+ * transfer 는 HAL_SPI_* 호출 1회(세그먼트)마다 불린다.
+ * csPort==NULL 이면 CS 를 보드 레벨에서 처리하는 것으로 보고 항상 선택 상태. */
+typedef struct
+{
+    void *ctx;
+    void (*select)(void *ctx, int active);
+    void (*transfer)(void *ctx, const uint8_t *tx, uint8_t *rx, uint16_t len);
+} HostSPI_Device_t;
+
+typedef struct
+{
+    uint32_t calls;
+    uint32_t bytes;
+    uint64_t busy_us;
+} HostSPI_Stats_t;
+
+int  HostSPI_Attach(SPI_TypeDef *bus, const HostSPI_Device_t *dev, GPIO_TypeDef *csPort, uint16_t csPin);
+void HostSPI_GetStats(SPI_TypeDef *bus, HostSPI_Stats_t *out);
+void HostSPI_ResetStats(SPI_TypeDef *bus);
+/* 1 = 이후 DMA 전송이 끝나지 않음 (DMA 요청 유실). HAL_SPI_Abort 로만 풀림 */
+void HostSPI_SetStall(SPI_TypeDef *bus, int stall);
+
+/* ===== CAN =====
+ * classic 프레임은 DUT bxCAN (HAL_CAN_*) 이 송수신.
+ * CAN FD 프레임은 같은 버스의 외부 FD 컨트롤러 모델 (HostCAN_FdAttach) 만 송수신 (bxCAN 은 받지 않음). */
+typedef struct
+{
+    uint32_t id;       /* 11-bit StdId 또는 29-bit ExtId */
+    uint8_t  ide;      /* 0=STD, 1=EXT */
+    uint8_t  dlc;      /* 데이터 바이트 수 (FD 는 DLC 에 대응하는 길이: 0~8, 12, 16, 20, 24, 32, 48, 64) */
+    uint8_t  fd;       /* 1 = FD 프레임 (FDF) */
+    uint8_t  brs;      /* 1 = 데이터 구간 bit rate 전환 */
+    uint8_t  data[64];
+    uint64_t t_us;     /* 버스에서 전송이 끝난 시각 */
+} HostCAN_Frame_t;
+
+/* DUT 가 보낸 프레임이 버스에서 전송 완료되면 ISR 문맥에서 호출 */
+typedef void (*HostCAN_NodeFn)(void *ctx, const HostCAN_Frame_t *frame);
+
+typedef struct
+{
+    uint32_t tx_frames;      /* DUT -> 버스 */
+    uint32_t rx_frames;      /* 버스 -> DUT FIFO */
+    uint32_t rx_overruns;
+    uint32_t tx_no_mailbox;  /* 메일박스 없음으로 거절된 AddTxMessage */
+    uint64_t busy_us;
+} HostCAN_Stats_t;
+
+int      HostCAN_AddNode(CAN_TypeDef *bus, HostCAN_NodeFn fn, void *ctx);
+/* 외부 노드 -> DUT 프레임 주입 (버스 중재 후 FIFO0 로 수신) */
+int      HostCAN_Inject(CAN_TypeDef *bus, uint32_t stdId, const uint8_t *data, uint8_t dlc);
+uint32_t HostCAN_BitTimeNs(CAN_TypeDef *bus);
+/* 프레임 1 개의 버스 점유 시간 (현재 bit timing, FD 는 HostCAN_FdAttach 의 데이터 bit rate) */
+uint32_t HostCAN_FrameTimeUs(CAN_TypeDef *bus, const HostCAN_Frame_t *f);
+void     HostCAN_GetStats(CAN_TypeDef *bus, HostCAN_Stats_t *out);
+/* 주입한 프레임이 버스에서 전송 완료되면 ISR 문맥에서 호출 (테스터 송신 흐름 제어용, 1 개) */
+int      HostCAN_SetInjectDone(CAN_TypeDef *bus, HostCAN_NodeFn fn, void *ctx);
+
+/* 외부 CAN FD 컨트롤러 (SPI 연결 가정, 예: MCP2518FD) 를 버스에 연결.
+ * rx: 외부 노드의 FD 프레임 수신 시 ISR 문맥에서 호출. data_bps: 데이터 구간 bit rate (0 = BRS 없음, 중재 속도 그대로)
+ * 중재 구간은 bxCAN 과 같은 nominal bit rate */
+int      HostCAN_FdAttach(CAN_TypeDef *bus, HostCAN_NodeFn rx, void *ctx, uint32_t data_bps);
+/* DUT → 버스 FD 프레임 (len = 유효 DLC 길이). TX 버퍼 3 개가 모두 전송 대기 중이면 -1.
+ * SPI 로 TX 버퍼에 쓰는 시간 (10MHz) 만큼 호출자 시간 소모 */
+int      HostCAN_FdSend(CAN_TypeDef *bus, uint32_t stdId, const uint8_t *data, uint8_t len);
+/* 외부 노드 → FD 컨트롤러 프레임 주입 (BRS 는 HostCAN_FdAttach 설정) */
+int      HostCAN_InjectFd(CAN_TypeDef *bus, uint32_t stdId, const uint8_t *data, uint8_t len);
+
+/* ===== 내장 FLASH (host_flash.c) =====
+ * STM32F413 1.5MB 단일 bank, 섹터 4x16K / 1x64K / 11x128K. 처음엔 전부 지워진 상태(0xFF).
+ * program 은 1→0 만 (지워지지 않은 비트는 AND), lock 상태 program/erase 는 WRPERR.
+ * word program / sector erase 는 datasheet typ 시간만큼 CPU 정지 (단일 bank: 실행 중 fetch 도 멈춤) */
+#define HOST_FLASH_BASE       0x08000000u
+#define HOST_FLASH_SIZE       (1536u * 1024u)
+
+typedef struct
+{
+    uint32_t programs;       /* word/halfword/byte 단위 program 횟수 */
+    uint32_t erases;         /* 섹터 */
+    uint32_t errors;
+    uint64_t busy_us;
+} HostFlash_Stats_t;
+
+/* addr 의 flash 내용 (범위 밖이면 NULL). 펌웨어의 flash 읽기는 이 포인터로 */
+const uint8_t *HostFlash_Ptr(uint32_t addr);
+/* 테스트 준비: 시간/lock 과 무관하게 내용 설정 */
+void HostFlash_Load(uint32_t addr, const void *data, uint32_t len);
+/* addr 를 덮는 word program 1 회를 실패(PGPERR)로. 0 = 해제 */
+void HostFlash_FailProgramAt(uint32_t addr);
+void HostFlash_GetStats(HostFlash_Stats_t *out);
+
+/* ===== UART ===== */
+typedef void (*HostUART_TxFn)(void *ctx, const uint8_t *data, uint16_t len);
+int  HostUART_SetTxListener(USART_TypeDef *uart, HostUART_TxFn fn, void *ctx);
+/* 외부 -> DUT 수신 바이트 주입 */
+int  HostUART_Inject(USART_TypeDef *uart, const uint8_t *data, uint16_t len);
+/* 수신 오류 (HAL_UART_ERROR_ORE 등): HAL 처럼 진행 중인 Receive_IT 를 끝내고 ErrorCallback (ISR 문맥에서 호출) */
+int  HostUART_InjectError(USART_TypeDef *uart, uint32_t error);
+
+/* ===== ADC =====
+ * TIM TRGO 트리거 + 순환 DMA 모델. 샘플 값은 소스 콜백이 샘플링 시각(ns) 기준으로 생성.
+ * 블록(반 버퍼) 단위로 채우고 Half/Cplt 콜백을 ISR 문맥에서 호출 */
+typedef uint16_t (*HostADC_SourceFn)(void *ctx, uint32_t channel, uint64_t t_ns);
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t half_irqs;
+    uint32_t full_irqs;
+} HostADC_Stats_t;
+
+int  HostADC_SetSource(ADC_TypeDef *adc, HostADC_SourceFn fn, void *ctx);
+void HostADC_GetStats(ADC_TypeDef *adc, HostADC_Stats_t *out);
+/* TIM 업데이트(=TRGO) 주기 ns. 미시작이면 0 */
+uint64_t HostTIM_PeriodNs(TIM_TypeDef *tim);
+
+/* ===== 클럭 (RCC 모델, host_rcc.c) ===== */
+uint32_t HostSim_PCLK1(void);
+uint32_t HostSim_PCLK2(void);
+/* APB1 타이머 클럭: APB1 분주가 1 이 아니면 PCLK1 x2 */
+uint32_t HostSim_TIMCLK1(void);
+/* CPU 가 cycles 만큼 실행한 시간 소모 (현재 SystemCoreClock 기준) */
+void     HostSim_CpuCycles(uint32_t cycles);
+
+/* SYSCLK 전환 직후(ISR 아님) 호출. 테스트에서 전압/클럭 순서 검증용 */
+typedef void (*HostRCC_ListenerFn)(void *ctx, uint32_t sysclk_hz);
+
+typedef struct
+{
+    uint32_t switches;        /* SYSCLK 변경 횟수 */
+    uint32_t pll_locks;
+    uint32_t latency_errors;  /* HCLK 에 비해 FLASH latency 부족으로 거부 */
+} HostRCC_Stats_t;
+
+void HostRCC_SetListener(HostRCC_ListenerFn fn, void *ctx);
+void HostRCC_GetStats(HostRCC_Stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_SIM_H_ */
@@ -0,0 +1,64 @@
+/*
+ * model_25lc256.h  (Host build)
+ *
+ *  Microchip 25LC256 SPI EEPROM 동작 모델.
+ *  - 32KB, 64B page (page 경계에서 주소 wrap), WEL/WIP, 쓰기 사이클 5ms
+ *  - CS 미배선(보드 레벨 CS)일 때는 opcode 기준으로 명령 경계를 추정:
+ *    WREN/WRDI/RDSR 은 세그먼트 끝에서, READ/WRITE 는 데이터가 실린 첫 세그먼트 끝에서 종료
+ *  - 전원 차단 주입: 쓰기 사이클에서 지정한 바이트 수만 반영, 다음 바이트는 값이 깨진 채 칩 무응답
+ */
+
+#ifndef MODEL_25LC256_H_
+#define MODEL_25LC256_H_
+
+#include <stdint.h>
+
+#include "host_sim.h"
+
+#define M25LC256_SIZE         32768u
+#define M25LC256_PAGE_SIZE    64u
+#define M25LC256_TWC_US       5000u    /* Twc (max) */
+
+typedef struct
+{
+    uint32_t writes;          /* 완료된 WRITE 명령 수 */
+    uint32_t bytes_written;
+    uint32_t reads;
+    uint32_t bytes_read;
+    uint32_t rdsr_polls;
+    uint32_t rejected;        /* WEL=0 또는 WIP 중 무시된 명령 */
+} M25LC256_Stats_t;
+
+typedef struct
+{
+    uint8_t  mem[M25LC256_SIZE];
+    uint8_t  status;          /* bit0 WIP, bit1 WEL, bit2~3 BP */
+    uint64_t wip_until_us;
+
+    /* 진행 중 명령 */
+    uint8_t  opcode;
+    uint8_t  phase;           /* 0=opcode 대기, 1=주소, 2=데이터 */
+    uint8_t  addr_bytes;
+    uint16_t addr;
+    uint8_t  data_seen;       /* 현재 세그먼트에 데이터 바이트가 있었음 */
+    uint16_t page_base;
+    uint8_t  page_buf[M25LC256_PAGE_SIZE];
+    uint8_t  page_dirty[M25LC256_PAGE_SIZE];
+    uint16_t wr_count;
+    uint16_t wr_start;        /* 첫 데이터 바이트의 page 내 위치 */
+
+    int      explicit_cs;     /* CS 가 GPIO 로 배선되었으면 1 */
+    int      dead;            /* 전원 차단 후 무응답 (MISO 0xFF) */
+    int32_t  cut_budget;      /* <0: 비활성. 남은 커밋 가능 바이트 */
+    M25LC256_Stats_t stats;
+} M25LC256_t;
+
+void M25LC256_Init(M25LC256_t *m);
+/* SPI 버스에 연결. csPort==NULL 이면 보드 레벨 CS (암묵적 명령 경계) */
+int  M25LC256_Attach(M25LC256_t *m, SPI_TypeDef *bus, GPIO_TypeDef *csPort, uint16_t csPin);
+/* 쓰기 사이클에서 n 바이트를 더 반영한 뒤 전원 차단 (n<0: 해제) */
+void M25LC256_ArmPowerCut(M25LC256_t *m, int32_t n);
+/* 전원 재투입: 메모리 내용은 유지, 진행 중 명령/WIP/WEL 초기화 */
+void M25LC256_PowerOn(M25LC256_t *m);
+
+#endif /* MODEL_25LC256_H_ */
@@ -0,0 +1,45 @@
+/*
+ * model_mp5475.h  (Host build)
+ *
+ *  MPS MP5475 PMIC I2C 모델 (7-bit 주소 0x60).
+ *  - 256 x 8bit 레지스터 맵, 레지스터 포인터 auto-increment
+ *  - Fault 레지스터(0x07~0x09) 주입/해제
+ */
+
+#ifndef MODEL_MP5475_H_
+#define MODEL_MP5475_H_
+
+#include <stdint.h>
+
+#include "host_sim.h"
+
+#define MMP5475_ADDR7    0x60u
+
+typedef struct
+{
+    uint32_t write_xfers;     /* 주소 phase 포함 쓰기 트랜잭션 */
+    uint32_t read_xfers;
+    uint32_t reg_writes;      /* 실제로 기록된 레지스터 바이트 */
+    uint32_t reg_reads;
+    uint32_t reg_write_count[256];
+} MMP5475_Stats_t;
+
+typedef struct
+{
+    uint8_t  addr7;
+    uint8_t  regs[256];
+    uint8_t  ptr;
+    int      nak;             /* 1 이면 모든 트랜잭션 NAK (버스 장애 주입) */
+    int      drop_writes;     /* 1 이면 ACK 후 데이터 무시 (쓰기 유실 주입) */
+    MMP5475_Stats_t stats;
+} MMP5475_t;
+
+void MMP5475_Init(MMP5475_t *m);
+int  MMP5475_Attach(MMP5475_t *m, I2C_TypeDef *bus);
+
+void    MMP5475_SetReg(MMP5475_t *m, uint8_t reg, uint8_t value);
+uint8_t MMP5475_GetReg(const MMP5475_t *m, uint8_t reg);
+void    MMP5475_InjectFault(MMP5475_t *m, uint8_t reg, uint8_t mask);
+void    MMP5475_ClearFault(MMP5475_t *m, uint8_t reg, uint8_t mask);
+
+#endif /* MODEL_MP5475_H_ */
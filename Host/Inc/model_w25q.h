@@ -0,0 +1,73 @@
+/*
+ * model_w25q.h  (Host build)
+ *
+ *  Winbond W25Q16JV SPI NOR flash 동작 모델.
+ *  - 2MB, 256B page (page 내 주소 wrap), 4KB sector erase, WEL/BUSY
+ *  - 프로그램은 1→0 만 가능 (기존 값 AND). 0→1 을 요구한 비트는 위반으로 집계
+ *  - tPP/tSE 동안 BUSY: RDSR 외 명령은 무시
+ *  - CS 는 반드시 GPIO 로 배선 (page program 은 CS 해제 시점에 커밋)
+ *  - 파일 백업(선택): 커밋/소거를 파일에 즉시 반영, W25Q_PowerOn() 시 파일에서 다시 읽음
+ *  - 전원 차단 주입: 지정한 프로그램 바이트 수 뒤에 커밋을 끊고 칩을 응답 없음 상태로
+ */
+
+#ifndef MODEL_W25Q_H_
+#define MODEL_W25Q_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "host_sim.h"
+
+#define W25Q_SIZE          (2u * 1024u * 1024u)
+#define W25Q_PAGE_SIZE     256u
+#define W25Q_SECTOR_SIZE   4096u
+#define W25Q_TPP_US        700u      /* page program (typ) */
+#define W25Q_TSE_US        45000u    /* 4KB sector erase (typ) */
+
+typedef struct
+{
+    uint32_t page_programs;
+    uint32_t bytes_programmed;
+    uint32_t sector_erases;
+    uint32_t bytes_read;
+    uint32_t rdsr_polls;
+    uint32_t rejected;            /* WEL=0 또는 BUSY 중 무시된 명령 */
+    uint32_t program_violations;  /* 소거되지 않은 비트에 1 을 쓰려 한 바이트 수 */
+    uint32_t max_erase_count;     /* sector 별 소거 횟수 최대값 */
+} W25Q_Stats_t;
+
+typedef struct
+{
+    uint8_t  mem[W25Q_SIZE];
+    uint16_t erase_count[W25Q_SIZE / W25Q_SECTOR_SIZE];
+    uint8_t  status;              /* bit0 BUSY, bit1 WEL */
+    uint64_t busy_until_us;
+
+    /* 진행 중 명령 */
+    uint8_t  opcode;
+    uint8_t  phase;               /* 0=opcode 대기, 1=주소, 2=데이터, 3=무시 */
+    uint8_t  addr_bytes;
+    uint32_t addr;
+    uint32_t page_base;
+    uint8_t  page_buf[W25Q_PAGE_SIZE];
+    uint8_t  page_dirty[W25Q_PAGE_SIZE];
+    uint16_t wr_count;
+
+    FILE    *backing;             /* NULL = RAM 전용 */
+    int      dead;                /* 전원 차단 후 무응답 */
+    int32_t  cut_budget;          /* <0: 비활성. 남은 프로그램 가능 바이트 */
+    W25Q_Stats_t stats;
+} W25Q_t;
+
+void W25Q_Init(W25Q_t *m);
+/* 파일 백업 연결: 없으면 0xFF 로 채워 생성, 있으면 내용을 읽음. 실패 시 -1 */
+int  W25Q_OpenBacking(W25Q_t *m, const char *path);
+void W25Q_CloseBacking(W25Q_t *m);
+int  W25Q_Attach(W25Q_t *m, SPI_TypeDef *bus, GPIO_TypeDef *csPort, uint16_t csPin);
+
+/* n 바이트를 더 프로그램한 뒤 전원 차단 (n<0: 해제) */
+void W25Q_ArmPowerCut(W25Q_t *m, int32_t n);
+/* 전원 재투입: 진행 중 명령/BUSY/WEL 초기화, 파일 백업이면 파일에서 다시 읽음 */
+void W25Q_PowerOn(W25Q_t *m);
+
+#endif /* MODEL_W25Q_H_ */
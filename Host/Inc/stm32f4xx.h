@@ -0,0 +1,186 @@
+/*
+ * stm32f4xx.h  (Host build)
+ *
+ *  Linux 호스트 빌드용 CMSIS device 헤더 대체.
+ *  레지스터 맵 대신 페리페럴 인스턴스 구분용 구조체만 제공하며,
+ *  실제 동작은 Host/Src 의 가짜 HAL 과 디바이스 모델이 담당한다.
+ */
+
+#ifndef HOST_STM32F4XX_H_
+#define HOST_STM32F4XX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+
+#define __NVIC_PRIO_BITS          4U
+
+/* ===== Interrupt Number (main.c / stm32f4xx_it.c 에서 쓰는 것 위주) ===== */
+typedef enum
+{
+  NonMaskableInt_IRQn   = -14,
+  MemoryManagement_IRQn = -12,
+  BusFault_IRQn         = -11,
+  UsageFault_IRQn       = -10,
+  SVCall_IRQn           = -5,
+  DebugMonitor_IRQn     = -4,
+  PendSV_IRQn           = -2,
+  SysTick_IRQn          = -1,
+  DMA1_Stream0_IRQn     = 11,
+  DMA1_Stream2_IRQn     = 13,
+  DMA1_Stream3_IRQn     = 14,
+  DMA1_Stream4_IRQn     = 15,
+  DMA1_Stream6_IRQn     = 17,
+  ADC_IRQn              = 18,
+  CAN1_TX_IRQn          = 19,
+  CAN1_RX0_IRQn         = 20,
+  CAN1_RX1_IRQn         = 21,
+  CAN1_SCE_IRQn         = 22,
+  TIM2_IRQn             = 28,
+  TIM3_IRQn             = 29,
+  I2C1_EV_IRQn          = 31,
+  I2C1_ER_IRQn          = 32,
+  I2C2_EV_IRQn          = 33,
+  I2C2_ER_IRQn          = 34,
+  SPI1_IRQn             = 35,
+  SPI2_IRQn             = 36,
+  DMA1_Stream7_IRQn     = 47,
+  UART4_IRQn            = 52,
+  DMA2_Stream0_IRQn     = 56,
+  DMA2_Stream3_IRQn     = 59,
+  DMA2_Stream4_IRQn     = 60,
+} IRQn_Type;
+
+/* ===== Peripheral 인스턴스 (레지스터 대신 식별용 태그) ===== */
+typedef struct
+{
+  volatile uint32_t IDR;   /* 외부(모델)에서 구동하는 입력 레벨 */
+  volatile uint32_t ODR;   /* HAL_GPIO_WritePin 출력 래치 */
+  uint32_t          id;
+} GPIO_TypeDef;
+
+typedef struct { uint32_t id; } I2C_TypeDef;
+typedef struct { uint32_t id; } SPI_TypeDef;
+typedef struct { uint32_t id; } CAN_TypeDef;
+typedef struct { uint32_t id; } USART_TypeDef;
+typedef struct { uint32_t id; } ADC_TypeDef;
+typedef struct { uint32_t id; } DMA_Stream_TypeDef;
+typedef struct { uint32_t id; } TIM_TypeDef;
+
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t LOAD;
+  volatile uint32_t VAL;
+  volatile uint32_t CALIB;
+} SysTick_Type;
+
+/* DWT/CoreDebug: CYCCNT 는 가상 시간 * SystemCoreClock 로 읽을 때마다 갱신 */
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk        (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk    (1UL << 24)
+
+DWT_Type *HostSim_DWT(void);
+
+/* MPU: 레지스터는 메모리로만 존재 (강제 없음). HostMPU_CanWrite 가 RBAR/RASR 3 쌍을 해석 */
+typedef struct
+{
+  volatile uint32_t TYPE;
+  volatile uint32_t CTRL;
+  volatile uint32_t RNR;
+  volatile uint32_t RBAR;
+  volatile uint32_t RASR;
+  volatile uint32_t RBAR_A1;
+  volatile uint32_t RASR_A1;
+  volatile uint32_t RBAR_A2;
+  volatile uint32_t RASR_A2;
+  volatile uint32_t RBAR_A3;
+  volatile uint32_t RASR_A3;
+} MPU_Type;
+
+#define MPU_CTRL_PRIVDEFENA_Msk       (1UL << 2)
+#define MPU_CTRL_ENABLE_Msk           (1UL << 0)
+#define MPU_RBAR_ADDR_Msk             (0x7FFFFFFUL << 5)
+#define MPU_RBAR_VALID_Msk            (1UL << 4)
+#define MPU_RBAR_REGION_Msk           (0xFUL)
+#define MPU_RASR_XN_Pos               28U
+#define MPU_RASR_AP_Pos               24U
+#define MPU_RASR_AP_Msk               (0x7UL << MPU_RASR_AP_Pos)
+#define MPU_RASR_TEX_Pos              19U
+#define MPU_RASR_S_Pos                18U
+#define MPU_RASR_C_Pos                17U
+#define MPU_RASR_B_Pos                16U
+#define MPU_RASR_SRD_Pos              8U
+#define MPU_RASR_SRD_Msk              (0xFFUL << MPU_RASR_SRD_Pos)
+#define MPU_RASR_SIZE_Pos             1U
+#define MPU_RASR_SIZE_Msk             (0x1FUL << MPU_RASR_SIZE_Pos)
+#define MPU_RASR_ENABLE_Msk           (1UL)
+
+/* privileged 쓰기가 현재 MPU 설정에서 허용되는지 (region 번호가 큰 쪽 우선, subregion 비활성 = 기본 맵) */
+int HostMPU_CanWrite(const volatile void *addr);
+
+extern GPIO_TypeDef  HostPeriph_GPIOA, HostPeriph_GPIOB, HostPeriph_GPIOC, HostPeriph_GPIOD,
+                     HostPeriph_GPIOE, HostPeriph_GPIOF, HostPeriph_GPIOG, HostPeriph_GPIOH;
+extern I2C_TypeDef   HostPeriph_I2C1, HostPeriph_I2C2, HostPeriph_I2C3;
+extern SPI_TypeDef   HostPeriph_SPI1, HostPeriph_SPI2, HostPeriph_SPI3;
+extern CAN_TypeDef   HostPeriph_CAN1, HostPeriph_CAN2;
+extern USART_TypeDef HostPeriph_USART1, HostPeriph_USART2, HostPeriph_USART3, HostPeriph_UART4;
+extern ADC_TypeDef   HostPeriph_ADC1;
+extern TIM_TypeDef   HostPeriph_TIM2, HostPeriph_TIM3;
+extern SysTick_Type  HostPeriph_SysTick;
+extern CoreDebug_Type HostPeriph_CoreDebug;
+extern MPU_Type       HostPeriph_MPU;
+
+#define GPIOA     (&HostPeriph_GPIOA)
+#define GPIOB     (&HostPeriph_GPIOB)
+#define GPIOC     (&HostPeriph_GPIOC)
+#define GPIOD     (&HostPeriph_GPIOD)
+#define GPIOE     (&HostPeriph_GPIOE)
+#define GPIOF     (&HostPeriph_GPIOF)
+#define GPIOG     (&HostPeriph_GPIOG)
+#define GPIOH     (&HostPeriph_GPIOH)
+#define I2C1      (&HostPeriph_I2C1)
+#define I2C2      (&HostPeriph_I2C2)
+#define I2C3      (&HostPeriph_I2C3)
+#define SPI1      (&HostPeriph_SPI1)
+#define SPI2      (&HostPeriph_SPI2)
+#define SPI3      (&HostPeriph_SPI3)
+#define CAN1      (&HostPeriph_CAN1)
+#define CAN2      (&HostPeriph_CAN2)
+#define USART1    (&HostPeriph_USART1)
+#define USART2    (&HostPeriph_USART2)
+#define USART3    (&HostPeriph_USART3)
+#define UART4     (&HostPeriph_UART4)
+#define ADC1      (&HostPeriph_ADC1)
+#define TIM2      (&HostPeriph_TIM2)
+#define TIM3      (&HostPeriph_TIM3)
+#define SysTick   (&HostPeriph_SysTick)
+#define CoreDebug (&HostPeriph_CoreDebug)
+#define DWT       (HostSim_DWT())
+#define MPU       (&HostPeriph_MPU)
+
+extern uint32_t SystemCoreClock;
+
+/* NVIC: 호스트에서는 우선순위 설정만 받아들이고 무시 */
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+__STATIC_INLINE void NVIC_EnableIRQ(IRQn_Type IRQn)  { (void)IRQn; }
+__STATIC_INLINE void NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32F4XX_H_ */
@@ -0,0 +1,711 @@
+/*
+ * stm32f4xx_hal.h  (Host build)
+ *
+ *  Linux 호스트 빌드용 가짜 HAL.
+ *  Core/Src 의 애플리케이션 코드가 쓰는 HAL 타입/상수/API 를 실제 HAL 과
+ *  같은 이름과 인코딩으로 제공하고, 동작은 Host/Src/host_*.c 가
+ *  소프트웨어 디바이스 모델(25LC256, MP5475, CAN 버스)과 가상 시간으로 흉내낸다.
+ */
+
+#ifndef HOST_STM32F4XX_HAL_H_
+#define HOST_STM32F4XX_HAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "stm32f4xx.h"
+
+/* ===== 공통 ===== */
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum { RESET = 0U, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0U, ENABLE = !DISABLE } FunctionalState;
+
+#define HAL_MAX_DELAY      0xFFFFFFFFU
+#define UNUSED(X)          (void)(X)
+
+#ifndef __weak
+#define __weak             __attribute__((weak))
+#endif
+
+HAL_StatusTypeDef HAL_Init(void);
+uint32_t          HAL_GetTick(void);
+void              HAL_IncTick(void);
+void              HAL_Delay(uint32_t Delay);
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/* ===== RCC / FLASH (HSI + 주 PLL 만) ===== */
+#define RCC_OSCILLATORTYPE_NONE      0x00000000U
+#define RCC_OSCILLATORTYPE_HSI       0x00000002U
+#define RCC_HSI_OFF                  0x00000000U
+#define RCC_HSI_ON                   0x00000001U
+#define RCC_HSICALIBRATION_DEFAULT   0x10U
+
+#define RCC_PLL_NONE                 0x00000000U
+#define RCC_PLL_OFF                  0x00000001U
+#define RCC_PLL_ON                   0x00000002U
+#define RCC_PLLSOURCE_HSI            0x00000000U
+#define RCC_PLLP_DIV2                0x00000002U
+#define RCC_PLLP_DIV4                0x00000004U
+#define RCC_PLLP_DIV6                0x00000006U
+#define RCC_PLLP_DIV8                0x00000008U
+
+#define RCC_CLOCKTYPE_SYSCLK         0x00000001U
+#define RCC_CLOCKTYPE_HCLK           0x00000002U
+#define RCC_CLOCKTYPE_PCLK1          0x00000004U
+#define RCC_CLOCKTYPE_PCLK2          0x00000008U
+
+#define RCC_SYSCLKSOURCE_HSI         0x00000000U
+#define RCC_SYSCLKSOURCE_PLLCLK      0x00000002U
+#define RCC_SYSCLK_DIV1              0x00000000U
+#define RCC_HCLK_DIV1                0x00000000U
+#define RCC_HCLK_DIV2                0x00001000U
+#define RCC_HCLK_DIV4                0x00001400U
+#define RCC_HCLK_DIV8                0x00001800U
+#define RCC_HCLK_DIV16               0x00001C00U
+
+#define FLASH_LATENCY_0              0x00000000U
+#define FLASH_LATENCY_1              0x00000001U
+#define FLASH_LATENCY_2              0x00000002U
+#define FLASH_LATENCY_3              0x00000003U
+
+typedef struct
+{
+  uint32_t PLLState;
+  uint32_t PLLSource;
+  uint32_t PLLM;
+  uint32_t PLLN;
+  uint32_t PLLP;
+  uint32_t PLLQ;
+  uint32_t PLLR;
+} RCC_PLLInitTypeDef;
+
+typedef struct
+{
+  uint32_t OscillatorType;
+  uint32_t HSEState;
+  uint32_t LSEState;
+  uint32_t HSIState;
+  uint32_t HSICalibrationValue;
+  uint32_t LSIState;
+  RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct
+{
+  uint32_t ClockType;
+  uint32_t SYSCLKSource;
+  uint32_t AHBCLKDivider;
+  uint32_t APB1CLKDivider;
+  uint32_t APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+void              HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t *pFLatency);
+uint32_t          HAL_RCC_GetSysClockFreq(void);
+uint32_t          HAL_RCC_GetHCLKFreq(void);
+uint32_t          HAL_RCC_GetPCLK1Freq(void);
+uint32_t          HAL_RCC_GetPCLK2Freq(void);
+
+/* ===== GPIO ===== */
+#define GPIO_PIN_0         ((uint16_t)0x0001)
+#define GPIO_PIN_1         ((uint16_t)0x0002)
+#define GPIO_PIN_2         ((uint16_t)0x0004)
+#define GPIO_PIN_3         ((uint16_t)0x0008)
+#define GPIO_PIN_4         ((uint16_t)0x0010)
+#define GPIO_PIN_5         ((uint16_t)0x0020)
+#define GPIO_PIN_6         ((uint16_t)0x0040)
+#define GPIO_PIN_7         ((uint16_t)0x0080)
+#define GPIO_PIN_8         ((uint16_t)0x0100)
+#define GPIO_PIN_9         ((uint16_t)0x0200)
+#define GPIO_PIN_10        ((uint16_t)0x0400)
+#define GPIO_PIN_11        ((uint16_t)0x0800)
+#define GPIO_PIN_12        ((uint16_t)0x1000)
+#define GPIO_PIN_13        ((uint16_t)0x2000)
+#define GPIO_PIN_14        ((uint16_t)0x4000)
+#define GPIO_PIN_15        ((uint16_t)0x8000)
+#define GPIO_PIN_All       ((uint16_t)0xFFFF)
+
+#define GPIO_MODE_INPUT      0x00000000U
+#define GPIO_MODE_OUTPUT_PP  0x00000001U
+#define GPIO_MODE_OUTPUT_OD  0x00000011U
+#define GPIO_MODE_AF_PP      0x00000002U
+#define GPIO_MODE_AF_OD      0x00000012U
+#define GPIO_MODE_ANALOG     0x00000003U
+#define GPIO_NOPULL          0x00000000U
+#define GPIO_PULLUP          0x00000001U
+#define GPIO_PULLDOWN        0x00000002U
+#define GPIO_SPEED_FREQ_LOW        0x00000000U
+#define GPIO_SPEED_FREQ_MEDIUM     0x00000001U
+#define GPIO_SPEED_FREQ_HIGH       0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH  0x00000003U
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+typedef struct
+{
+  uint32_t Pin;
+  uint32_t Mode;
+  uint32_t Pull;
+  uint32_t Speed;
+  uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+void          HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void          HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void          HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+/* ===== DMA ===== */
+typedef enum
+{
+  HAL_DMA_STATE_RESET = 0x00U,
+  HAL_DMA_STATE_READY = 0x01U,
+  HAL_DMA_STATE_BUSY  = 0x02U
+} HAL_DMA_StateTypeDef;
+
+typedef struct
+{
+  uint32_t Channel;
+  uint32_t Direction;
+  uint32_t PeriphInc;
+  uint32_t MemInc;
+  uint32_t PeriphDataAlignment;
+  uint32_t MemDataAlignment;
+  uint32_t Mode;
+  uint32_t Priority;
+  uint32_t FIFOMode;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+  DMA_Stream_TypeDef   *Instance;
+  DMA_InitTypeDef       Init;
+  HAL_DMA_StateTypeDef  State;
+  void                 *Parent;
+  uint32_t              ErrorCode;
+} DMA_HandleTypeDef;
+
+/* ===== I2C ===== */
+#define I2C_DUTYCYCLE_2              0x00000000U
+#define I2C_DUTYCYCLE_16_9           0x00004000U
+#define I2C_ADDRESSINGMODE_7BIT      0x00004000U
+#define I2C_ADDRESSINGMODE_10BIT     0x0000C000U
+#define I2C_DUALADDRESS_DISABLE      0x00000000U
+#define I2C_GENERALCALL_DISABLE      0x00000000U
+#define I2C_NOSTRETCH_DISABLE        0x00000000U
+#define I2C_MEMADD_SIZE_8BIT         0x00000001U
+#define I2C_MEMADD_SIZE_16BIT        0x00000010U
+
+#define HAL_I2C_ERROR_NONE           0x00000000U
+#define HAL_I2C_ERROR_BERR           0x00000001U
+#define HAL_I2C_ERROR_ARLO           0x00000002U
+#define HAL_I2C_ERROR_AF             0x00000004U
+#define HAL_I2C_ERROR_OVR            0x00000008U
+#define HAL_I2C_ERROR_DMA            0x00000010U
+#define HAL_I2C_ERROR_TIMEOUT        0x00000020U
+
+typedef enum
+{
+  HAL_I2C_STATE_RESET   = 0x00U,
+  HAL_I2C_STATE_READY   = 0x20U,
+  HAL_I2C_STATE_BUSY    = 0x24U,
+  HAL_I2C_STATE_BUSY_TX = 0x21U,
+  HAL_I2C_STATE_BUSY_RX = 0x22U,
+  HAL_I2C_STATE_ERROR   = 0xE0U
+} HAL_I2C_StateTypeDef;
+
+typedef struct
+{
+  uint32_t ClockSpeed;
+  uint32_t DutyCycle;
+  uint32_t OwnAddress1;
+  uint32_t AddressingMode;
+  uint32_t DualAddressMode;
+  uint32_t OwnAddress2;
+  uint32_t GeneralCallMode;
+  uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct __I2C_HandleTypeDef
+{
+  I2C_TypeDef                *Instance;
+  I2C_InitTypeDef             Init;
+  uint8_t                    *pBuffPtr;
+  uint16_t                    XferSize;
+  volatile uint16_t           XferCount;
+  DMA_HandleTypeDef          *hdmatx;
+  DMA_HandleTypeDef          *hdmarx;
+  volatile HAL_I2C_StateTypeDef State;
+  volatile uint32_t           ErrorCode;
+  volatile uint32_t           Devaddress;
+  volatile uint32_t           Memaddress;
+  volatile uint32_t           MemaddSize;
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout);
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c);
+uint32_t          HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+/* ===== SPI ===== */
+#define SPI_MODE_SLAVE               0x00000000U
+#define SPI_MODE_MASTER              0x00000104U
+#define SPI_DIRECTION_2LINES         0x00000000U
+#define SPI_DATASIZE_8BIT            0x00000000U
+#define SPI_POLARITY_LOW             0x00000000U
+#define SPI_POLARITY_HIGH            0x00000002U
+#define SPI_PHASE_1EDGE              0x00000000U
+#define SPI_PHASE_2EDGE              0x00000001U
+#define SPI_NSS_SOFT                 0x00000200U
+#define SPI_BAUDRATEPRESCALER_2      0x00000000U
+#define SPI_BAUDRATEPRESCALER_4      0x00000008U
+#define SPI_BAUDRATEPRESCALER_8      0x00000010U
+#define SPI_BAUDRATEPRESCALER_16     0x00000018U
+#define SPI_BAUDRATEPRESCALER_32     0x00000020U
+#define SPI_BAUDRATEPRESCALER_64     0x00000028U
+#define SPI_BAUDRATEPRESCALER_128    0x00000030U
+#define SPI_BAUDRATEPRESCALER_256    0x00000038U
+#define SPI_FIRSTBIT_MSB             0x00000000U
+#define SPI_TIMODE_DISABLE           0x00000000U
+#define SPI_CRCCALCULATION_DISABLE   0x00000000U
+
+#define HAL_SPI_ERROR_NONE           0x00000000U
+#define HAL_SPI_ERROR_MODF           0x00000001U
+#define HAL_SPI_ERROR_DMA            0x00000010U
+#define HAL_SPI_ERROR_ABORT          0x00000040U
+
+typedef enum
+{
+  HAL_SPI_STATE_RESET      = 0x00U,
+  HAL_SPI_STATE_READY      = 0x01U,
+  HAL_SPI_STATE_BUSY       = 0x02U,
+  HAL_SPI_STATE_BUSY_TX    = 0x03U,
+  HAL_SPI_STATE_BUSY_RX    = 0x04U,
+  HAL_SPI_STATE_BUSY_TX_RX = 0x05U,
+  HAL_SPI_STATE_ERROR      = 0x06U
+} HAL_SPI_StateTypeDef;
+
+typedef struct
+{
+  uint32_t Mode;
+  uint32_t Direction;
+  uint32_t DataSize;
+  uint32_t CLKPolarity;
+  uint32_t CLKPhase;
+  uint32_t NSS;
+  uint32_t BaudRatePrescaler;
+  uint32_t FirstBit;
+  uint32_t TIMode;
+  uint32_t CRCCalculation;
+  uint32_t CRCPolynomial;
+} SPI_InitTypeDef;
+
+typedef struct __SPI_HandleTypeDef
+{
+  SPI_TypeDef                *Instance;
+  SPI_InitTypeDef             Init;
+  uint8_t                    *pTxBuffPtr;
+  uint16_t                    TxXferSize;
+  uint8_t                    *pRxBuffPtr;
+  uint16_t                    RxXferSize;
+  DMA_HandleTypeDef          *hdmatx;
+  DMA_HandleTypeDef          *hdmarx;
+  volatile HAL_SPI_StateTypeDef State;
+  volatile uint32_t           ErrorCode;
+} SPI_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_DeInit(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi);
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *hspi);
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/* ===== CAN (bxCAN) ===== */
+#define CAN_MODE_NORMAL              0x00000000U
+#define CAN_MODE_LOOPBACK            0x40000000U
+#define CAN_MODE_SILENT              0x80000000U
+#define CAN_SJW_1TQ                  0x00000000U
+#define CAN_SJW_2TQ                  0x01000000U
+#define CAN_BS1_1TQ                  0x00000000U
+#define CAN_BS1_2TQ                  0x00010000U
+#define CAN_BS1_3TQ                  0x00020000U
+#define CAN_BS1_4TQ                  0x00030000U
+#define CAN_BS1_13TQ                 0x000C0000U
+#define CAN_BS1_16TQ                 0x000F0000U
+#define CAN_BS2_1TQ                  0x00000000U
+#define CAN_BS2_2TQ                  0x00100000U
+#define CAN_BS2_3TQ                  0x00200000U
+#define CAN_BS2_8TQ                  0x00700000U
+
+#define CAN_ID_STD                   0x00000000U
+#define CAN_ID_EXT                   0x00000004U
+#define CAN_RTR_DATA                 0x00000000U
+#define CAN_RTR_REMOTE               0x00000002U
+#define CAN_RX_FIFO0                 0x00000000U
+#define CAN_RX_FIFO1                 0x00000001U
+#define CAN_TX_MAILBOX0              0x00000001U
+#define CAN_TX_MAILBOX1              0x00000002U
+#define CAN_TX_MAILBOX2              0x00000004U
+
+#define CAN_IT_TX_MAILBOX_EMPTY      0x00000001U
+#define CAN_IT_RX_FIFO0_MSG_PENDING  0x00000002U
+#define CAN_IT_RX_FIFO0_FULL         0x00000004U
+#define CAN_IT_RX_FIFO0_OVERRUN      0x00000008U
+#define CAN_IT_RX_FIFO1_MSG_PENDING  0x00000010U
+
+#define CAN_FILTERMODE_IDMASK        0x00000000U
+#define CAN_FILTERMODE_IDLIST        0x00000001U
+#define CAN_FILTERSCALE_16BIT        0x00000000U
+#define CAN_FILTERSCALE_32BIT        0x00000001U
+#define CAN_FILTER_FIFO0             0x00000000U
+#define CAN_FILTER_FIFO1             0x00000001U
+
+#define HAL_CAN_ERROR_NONE           0x00000000U
+#define HAL_CAN_ERROR_RX_FOV0        0x00000200U
+#define HAL_CAN_ERROR_NOT_INITIALIZED 0x00040000U
+#define HAL_CAN_ERROR_NOT_READY      0x00080000U
+#define HAL_CAN_ERROR_NOT_STARTED    0x00100000U
+#define HAL_CAN_ERROR_PARAM          0x00200000U
+
+typedef enum
+{
+  HAL_CAN_STATE_RESET         = 0x00U,
+  HAL_CAN_STATE_READY         = 0x01U,
+  HAL_CAN_STATE_LISTENING     = 0x02U,
+  HAL_CAN_STATE_SLEEP_PENDING = 0x03U,
+  HAL_CAN_STATE_SLEEP_ACTIVE  = 0x04U,
+  HAL_CAN_STATE_ERROR         = 0x05U
+} HAL_CAN_StateTypeDef;
+
+typedef struct
+{
+  uint32_t        Prescaler;
+  uint32_t        Mode;
+  uint32_t        SyncJumpWidth;
+  uint32_t        TimeSeg1;
+  uint32_t        TimeSeg2;
+  FunctionalState TimeTriggeredMode;
+  FunctionalState AutoBusOff;
+  FunctionalState AutoWakeUp;
+  FunctionalState AutoRetransmission;
+  FunctionalState ReceiveFifoLocked;
+  FunctionalState TransmitFifoPriority;
+} CAN_InitTypeDef;
+
+typedef struct
+{
+  uint32_t FilterIdHigh;
+  uint32_t FilterIdLow;
+  uint32_t FilterMaskIdHigh;
+  uint32_t FilterMaskIdLow;
+  uint32_t FilterFIFOAssignment;
+  uint32_t FilterBank;
+  uint32_t FilterMode;
+  uint32_t FilterScale;
+  uint32_t FilterActivation;
+  uint32_t SlaveStartFilterBank;
+} CAN_FilterTypeDef;
+
+typedef struct
+{
+  uint32_t        StdId;
+  uint32_t        ExtId;
+  uint32_t        IDE;
+  uint32_t        RTR;
+  uint32_t        DLC;
+  FunctionalState TransmitGlobalTime;
+} CAN_TxHeaderTypeDef;
+
+typedef struct
+{
+  uint32_t StdId;
+  uint32_t ExtId;
+  uint32_t IDE;
+  uint32_t RTR;
+  uint32_t DLC;
+  uint32_t Timestamp;
+  uint32_t FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+typedef struct __CAN_HandleTypeDef
+{
+  CAN_TypeDef                 *Instance;
+  CAN_InitTypeDef              Init;
+  volatile HAL_CAN_StateTypeDef State;
+  volatile uint32_t            ErrorCode;
+} CAN_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_DeInit(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs);
+HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan, uint32_t InactiveITs);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox);
+uint32_t          HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan);
+uint32_t          HAL_CAN_IsTxMessagePending(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[]);
+uint32_t          HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo);
+HAL_CAN_StateTypeDef HAL_CAN_GetState(CAN_HandleTypeDef *hcan);
+uint32_t          HAL_CAN_GetError(CAN_HandleTypeDef *hcan);
+
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan);
+
+/* ===== UART ===== */
+#define UART_WORDLENGTH_8B           0x00000000U
+#define UART_STOPBITS_1              0x00000000U
+#define UART_PARITY_NONE             0x00000000U
+#define UART_MODE_TX_RX              0x0000000CU
+#define UART_HWCONTROL_NONE          0x00000000U
+#define UART_OVERSAMPLING_16         0x00000000U
+
+typedef enum
+{
+  HAL_UART_STATE_RESET   = 0x00U,
+  HAL_UART_STATE_READY   = 0x20U,
+  HAL_UART_STATE_BUSY_TX = 0x21U,
+  HAL_UART_STATE_BUSY_RX = 0x22U
+} HAL_UART_StateTypeDef;
+
+typedef struct
+{
+  uint32_t BaudRate;
+  uint32_t WordLength;
+  uint32_t StopBits;
+  uint32_t Parity;
+  uint32_t Mode;
+  uint32_t HwFlowCtl;
+  uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct __UART_HandleTypeDef
+{
+  USART_TypeDef                *Instance;
+  UART_InitTypeDef              Init;
+  uint8_t                      *pTxBuffPtr;
+  uint16_t                      TxXferSize;
+  uint8_t                      *pRxBuffPtr;
+  uint16_t                      RxXferSize;
+  volatile uint16_t             RxXferCount;
+  DMA_HandleTypeDef            *hdmatx;
+  DMA_HandleTypeDef            *hdmarx;
+  volatile HAL_UART_StateTypeDef gState;
+  volatile HAL_UART_StateTypeDef RxState;
+  volatile uint32_t             ErrorCode;
+} UART_HandleTypeDef;
+
+#define HAL_UART_ERROR_NONE          0x00000000U
+#define HAL_UART_ERROR_PE            0x00000001U
+#define HAL_UART_ERROR_NE            0x00000002U
+#define HAL_UART_ERROR_FE            0x00000004U
+#define HAL_UART_ERROR_ORE           0x00000008U
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+/* ===== TIM (ADC 트리거용 TRGO 만) ===== */
+#define TIM_COUNTERMODE_UP               0x00000000U
+#define TIM_CLOCKDIVISION_DIV1           0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE   0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_ENABLE    0x00000080U
+#define TIM_CLOCKSOURCE_INTERNAL         0x00001000U
+#define TIM_TRGO_RESET                   0x00000000U
+#define TIM_TRGO_UPDATE                  0x00000020U
+#define TIM_MASTERSLAVEMODE_DISABLE      0x00000000U
+
+typedef enum
+{
+  HAL_TIM_STATE_RESET = 0x00U,
+  HAL_TIM_STATE_READY = 0x01U,
+  HAL_TIM_STATE_BUSY  = 0x02U
+} HAL_TIM_StateTypeDef;
+
+typedef struct
+{
+  uint32_t Prescaler;
+  uint32_t CounterMode;
+  uint32_t Period;
+  uint32_t ClockDivision;
+  uint32_t RepetitionCounter;
+  uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+  uint32_t ClockSource;
+  uint32_t ClockPolarity;
+  uint32_t ClockPrescaler;
+  uint32_t ClockFilter;
+} TIM_ClockConfigTypeDef;
+
+typedef struct
+{
+  uint32_t MasterOutputTrigger;
+  uint32_t MasterSlaveMode;
+} TIM_MasterConfigTypeDef;
+
+typedef struct __TIM_HandleTypeDef
+{
+  TIM_TypeDef                   *Instance;
+  TIM_Base_InitTypeDef           Init;
+  volatile HAL_TIM_StateTypeDef  State;
+} TIM_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig);
+
+/* ARR 변경 (호스트 모델은 Init.Period 를 ARR 로 사용) */
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__)  ((__HANDLE__)->Init.Period = (__AUTORELOAD__))
+
+/* ===== ADC ===== */
+#define ADC_CLOCK_SYNC_PCLK_DIV2     0x00000000U
+#define ADC_CLOCK_SYNC_PCLK_DIV4     0x00010000U
+#define ADC_RESOLUTION_12B           0x00000000U
+#define ADC_DATAALIGN_RIGHT          0x00000000U
+#define ADC_EXTERNALTRIGCONVEDGE_NONE    0x00000000U
+#define ADC_EXTERNALTRIGCONVEDGE_RISING  0x10000000U
+#define ADC_EXTERNALTRIGCONV_T2_TRGO 0x06000000U
+#define ADC_SOFTWARE_START           0x0F000001U
+#define ADC_EOC_SEQ_CONV             0x00000000U
+#define ADC_EOC_SINGLE_CONV          0x00000001U
+#define ADC_CHANNEL_2                0x00000002U
+#define ADC_SAMPLETIME_3CYCLES       0x00000000U
+#define ADC_SAMPLETIME_84CYCLES      0x00000004U
+
+#define HAL_ADC_STATE_RESET          0x00000000U
+#define HAL_ADC_STATE_READY          0x00000001U
+#define HAL_ADC_STATE_REG_BUSY       0x00000100U
+
+typedef struct
+{
+  uint32_t        ClockPrescaler;
+  uint32_t        Resolution;
+  uint32_t        DataAlign;
+  FunctionalState ScanConvMode;
+  uint32_t        EOCSelection;
+  FunctionalState ContinuousConvMode;
+  uint32_t        NbrOfConversion;
+  FunctionalState DiscontinuousConvMode;
+  uint32_t        NbrOfDiscConversion;
+  uint32_t        ExternalTrigConv;
+  uint32_t        ExternalTrigConvEdge;
+  FunctionalState DMAContinuousRequests;
+} ADC_InitTypeDef;
+
+typedef struct
+{
+  uint32_t Channel;
+  uint32_t Rank;
+  uint32_t SamplingTime;
+  uint32_t Offset;
+} ADC_ChannelConfTypeDef;
+
+typedef struct __ADC_HandleTypeDef
+{
+  ADC_TypeDef          *Instance;
+  ADC_InitTypeDef       Init;
+  DMA_HandleTypeDef    *DMA_Handle;
+  volatile uint32_t     State;
+  volatile uint32_t     ErrorCode;
+} ADC_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc);
+
+/* ===== FLASH (내장 flash 프로그래밍, host_flash.c) ===== */
+#define FLASH_TYPEERASE_SECTORS      0x00000000U
+#define FLASH_VOLTAGE_RANGE_3        0x00000002U
+#define FLASH_BANK_1                 0x00000001U
+
+#define FLASH_TYPEPROGRAM_BYTE       0x00000000U
+#define FLASH_TYPEPROGRAM_HALFWORD   0x00000001U
+#define FLASH_TYPEPROGRAM_WORD       0x00000002U
+#define FLASH_TYPEPROGRAM_DOUBLEWORD 0x00000003U
+
+#define FLASH_SECTOR_0               0U
+#define FLASH_SECTOR_3               3U
+#define FLASH_SECTOR_4               4U
+#define FLASH_SECTOR_5               5U
+#define FLASH_SECTOR_15              15U
+
+#define HAL_FLASH_ERROR_NONE         0x00000000U
+#define HAL_FLASH_ERROR_PGS          0x00000002U
+#define HAL_FLASH_ERROR_PGP          0x00000004U
+#define HAL_FLASH_ERROR_WRP          0x00000010U
+
+typedef struct
+{
+  uint32_t TypeErase;
+  uint32_t Banks;
+  uint32_t Sector;
+  uint32_t NbSectors;
+  uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+uint32_t          HAL_FLASH_GetError(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32F4XX_HAL_H_ */
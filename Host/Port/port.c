@@ -0,0 +1,272 @@
+/*
+ * port.c  (Host build, FreeRTOS V10.3.1)
+ *
+ *  Linux 호스트용 FreeRTOS 포트.
+ *  - 태스크 1개 = pthread 1개. 전역 뮤텍스/조건변수로 "실행권"을 넘겨서
+ *    언제나 한 스레드만 커널/애플리케이션 코드를 실행한다 (단일 코어와 동일).
+ *  - PendSV: 인터럽트 마스크/크리티컬 섹션/ISR 중에는 yield 를 보류했다가 해제 시 수행.
+ *  - SysTick: host_sim.c 가 가상 시간 1ms 경계마다 vPortHostTickISR() 호출.
+ *  - idle 태스크가 가상 시간을 다음 이벤트까지 진행시킨다 (vApplicationIdleHook).
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_sim.h"
+#include "port_host.h"
+
+typedef struct
+{
+    pthread_t      tid;
+    TaskFunction_t pxCode;
+    void          *pvParameters;
+} HostThread_t;
+
+static pthread_mutex_t xLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  xCond = PTHREAD_COND_INITIALIZER;
+static HostThread_t   *pxRunning = NULL;     /* 실행권을 가진 스레드 */
+static int             xSchedulerStarted = 0;
+static int             xSchedulerDone = 0;
+
+static __thread HostThread_t *pxSelf = NULL; /* NULL: 태스크가 아닌 호스트 main 스레드 */
+
+static volatile UBaseType_t uxCriticalNesting = 0;
+static volatile uint32_t    ulInterruptMask = 0;
+static volatile uint32_t    ulIsrNesting = 0;
+static volatile BaseType_t  xPortYieldPending = pdFALSE;
+
+/* TCB 첫 멤버(pxTopOfStack)가 가리키는 슬롯에 HostThread_t 포인터를 둔다 */
+static HostThread_t *prvThreadOf(TaskHandle_t xTask)
+{
+    StackType_t *pxTop = *(StackType_t **)xTask;
+    return *(HostThread_t **)pxTop;
+}
+
+static void prvWaitForTurn(HostThread_t *pxThread)
+{
+    while (pxRunning != pxThread) {
+        pthread_cond_wait(&xCond, &xLock);
+    }
+}
+
+static void *prvThreadEntry(void *pvArg)
+{
+    HostThread_t *pxThread = (HostThread_t *)pvArg;
+
+    pthread_mutex_lock(&xLock);
+    prvWaitForTurn(pxThread);
+    pthread_mutex_unlock(&xLock);
+
+    pxSelf = pxThread;
+    pxThread->pxCode(pxThread->pvParameters);
+
+    /* 태스크 함수는 반환하면 안 되지만, 호스트에서는 삭제로 정리 */
+    vTaskDelete(NULL);
+    return NULL;
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    HostThread_t *pxThread = (HostThread_t *)calloc(1, sizeof(HostThread_t));
+    HostThread_t **ppxSlot = (HostThread_t **)(((uintptr_t)pxTopOfStack - sizeof(HostThread_t *))
+                                               & ~(uintptr_t)portBYTE_ALIGNMENT_MASK);
+
+    configASSERT(pxThread != NULL);
+    pxThread->pxCode = pxCode;
+    pxThread->pvParameters = pvParameters;
+    *ppxSlot = pxThread;
+
+    if (pthread_create(&pxThread->tid, NULL, prvThreadEntry, pxThread) != 0) {
+        vPortHostAssert(__FILE__, __LINE__);
+    }
+    pthread_detach(pxThread->tid);
+
+    return (StackType_t *)ppxSlot;
+}
+
+/* vTaskSwitchContext() 가 고른 태스크로 실행권을 넘기고, 다시 돌아올 때까지 대기 */
+static void prvSwitchToCurrentTask(void)
+{
+    HostThread_t *pxNext = prvThreadOf(xTaskGetCurrentTaskHandle());
+    HostThread_t *pxMe = pxSelf;
+
+    if (pxNext == pxMe) return;
+
+    pthread_mutex_lock(&xLock);
+    pxRunning = pxNext;
+    pthread_cond_broadcast(&xCond);
+    prvWaitForTurn(pxMe);
+    pthread_mutex_unlock(&xLock);
+}
+
+void vPortYield(void)
+{
+    /* PendSV 는 가장 낮은 우선순위: 마스크/크리티컬/ISR 이 끝날 때까지 보류 */
+    if ((ulIsrNesting != 0U) || (uxCriticalNesting != 0U) || (ulInterruptMask != 0U) || (pxSelf == NULL)) {
+        xPortYieldPending = pdTRUE;
+        return;
+    }
+    xPortYieldPending = pdFALSE;
+    vTaskSwitchContext();
+    prvSwitchToCurrentTask();
+}
+
+static void prvInterruptsUnmasked(void)
+{
+    if (ulIsrNesting != 0U) return;
+    HostSim_Dispatch();
+    if (xPortYieldPending != pdFALSE) vPortYield();
+}
+
+void vPortHostDisableInterrupts(void)
+{
+    ulInterruptMask = 1U;
+}
+
+void vPortHostEnableInterrupts(void)
+{
+    ulInterruptMask = 0U;
+    prvInterruptsUnmasked();
+}
+
+uint32_t ulPortHostSetInterruptMask(void)
+{
+    uint32_t ulPrev = ulInterruptMask;
+    ulInterruptMask = 1U;
+    return ulPrev;
+}
+
+void vPortHostClearInterruptMask(uint32_t ulNewMask)
+{
+    ulInterruptMask = ulNewMask;
+    if (ulNewMask == 0U) prvInterruptsUnmasked();
+}
+
+void vPortEnterCritical(void)
+{
+    portDISABLE_INTERRUPTS();
+    uxCriticalNesting++;
+}
+
+void vPortExitCritical(void)
+{
+    configASSERT(uxCriticalNesting);
+    uxCriticalNesting--;
+    if (uxCriticalNesting == 0U) {
+        portENABLE_INTERRUPTS();
+    }
+}
+
+BaseType_t xPortIsInsideInterrupt(void)
+{
+    return (ulIsrNesting != 0U) ? pdTRUE : pdFALSE;
+}
+
+/* cmsis_compiler.h (host) 의 intrinsic 대체 */
+uint32_t ulPortHostGetIPSR(void)    { return (ulIsrNesting != 0U) ? 16U : 0U; }
+uint32_t ulPortHostGetPRIMASK(void) { return ulInterruptMask; }
+
+void vPortHostSetPRIMASK(uint32_t primask)
+{
+    if (primask != 0U) vPortHostDisableInterrupts();
+    else               vPortHostEnableInterrupts();
+}
+
+/* ===== host_sim.c 인터페이스 ===== */
+int xPortHostCanInterrupt(void)
+{
+    return (ulIsrNesting == 0U) && (uxCriticalNesting == 0U) && (ulInterruptMask == 0U);
+}
+
+void vPortHostEnterISR(void)
+{
+    ulIsrNesting++;
+}
+
+void vPortHostExitISR(void)
+{
+    ulIsrNesting--;
+    if ((ulIsrNesting == 0U) && (xPortYieldPending != pdFALSE)) {
+        vPortYield();
+    }
+}
+
+void vPortHostTickISR(void)
+{
+    if (!xSchedulerStarted || xSchedulerDone) return;
+    if (xTaskIncrementTick() != pdFALSE) {
+        xPortYieldPending = pdTRUE;
+    }
+}
+
+void xPortSysTickHandler(void)
+{
+    vPortHostTickISR();
+}
+
+int xPortHostSchedulerRunning(void)
+{
+    return xSchedulerStarted && !xSchedulerDone;
+}
+
+void vPortHostEndScheduler(void)
+{
+    if (pxSelf == NULL || !xSchedulerStarted) return;
+
+    pthread_mutex_lock(&xLock);
+    xSchedulerDone = 1;
+    pxRunning = NULL;
+    pthread_cond_broadcast(&xCond);
+    for (;;) {
+        /* 이 태스크는 다시 스케줄되지 않는다 */
+        pthread_cond_wait(&xCond, &xLock);
+    }
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    TaskHandle_t  xFirst = xTaskGetCurrentTaskHandle();
+    HostThread_t *pxFirst = prvThreadOf(xFirst);
+
+    /* cmsis_os2.c 는 커널 객체 포인터를 uint32_t 로 캐스팅한다 (recursive mutex 비트 등).
+       호스트는 -no-pie 로 링크해 heap_4 의 ucHeap 이 하위 4GB 에 놓이도록 한다 */
+    configASSERT(((uint64_t)(uintptr_t)xFirst >> 32) == 0U);
+
+    /* 첫 태스크는 인터럽트 허용 상태로 시작 (ARM: SVC 복귀 시 BASEPRI=0) */
+    uxCriticalNesting = 0U;
+    ulInterruptMask = 0U;
+    xSchedulerStarted = 1;
+
+    pthread_mutex_lock(&xLock);
+    pxRunning = pxFirst;
+    pthread_cond_broadcast(&xCond);
+    while (!xSchedulerDone) {
+        pthread_cond_wait(&xCond, &xLock);
+    }
+    pthread_mutex_unlock(&xLock);
+
+    /* pdFALSE: vTaskStartScheduler() 가 반환 → osKernelStart() 반환 */
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+    vPortHostEndScheduler();
+}
+
+/* idle 태스크: 실행할 태스크가 없으면 가상 시간을 다음 tick/이벤트까지 진행 */
+void vApplicationIdleHook(void)
+{
+    HostSim_AdvanceToNextEvent();
+}
+
+void vPortHostAssert(const char *pcFile, int iLine)
+{
+    fprintf(stderr, "configASSERT failed: %s:%d\n", pcFile, iLine);
+    fflush(stderr);
+    abort();
+}
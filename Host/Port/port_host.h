@@ -0,0 +1,24 @@
+/*
+ * port_host.h  (Host build)
+ *
+ *  호스트 FreeRTOS 포트와 가상 시간(host_sim.c) 사이의 내부 인터페이스.
+ */
+
+#ifndef PORT_HOST_H_
+#define PORT_HOST_H_
+
+#include <stdint.h>
+
+/* 인터럽트 디스패치 가능 여부 (마스크/크리티컬/ISR 중이 아닐 때) */
+int  xPortHostCanInterrupt(void);
+void vPortHostEnterISR(void);
+void vPortHostExitISR(void);
+
+/* 1ms tick ISR 본체 (스케줄러 시작 전에는 무시) */
+void vPortHostTickISR(void);
+
+int  xPortHostSchedulerRunning(void);
+/* 시뮬레이션 종료: 태스크 문맥이면 반환하지 않고, osKernelStart() 가 반환한다 */
+void vPortHostEndScheduler(void);
+
+#endif /* PORT_HOST_H_ */
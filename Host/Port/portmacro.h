@@ -0,0 +1,97 @@
+/*
+ * portmacro.h  (Host build, FreeRTOS V10.3.1)
+ *
+ *  Linux 호스트용 FreeRTOS 포트.
+ *  각 태스크는 pthread 하나로 실행되지만 한 번에 하나만 돌도록 "실행권"을 넘겨주는
+ *  방식이라 단일 코어 MCU 와 같은 순서로 커널 코드가 실행된다.
+ *  SysTick/PendSV/BASEPRI 는 host_sim.c 의 가상 시간과 가상 인터럽트 마스크로 대체.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Type definitions. */
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  uint32_t
+#define portBASE_TYPE   long
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+    typedef uint16_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+    typedef uint32_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+    #define portTICK_TYPE_IS_ATOMIC 1
+#endif
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH        ( -1 )
+#define portTICK_PERIOD_MS      ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT      8
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+#define portYIELD()                                 vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )    if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
+
+/* Critical section management. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern uint32_t ulPortHostSetInterruptMask( void );
+extern void vPortHostClearInterruptMask( uint32_t ulNewMask );
+extern void vPortHostDisableInterrupts( void );
+extern void vPortHostEnableInterrupts( void );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()       ulPortHostSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    vPortHostClearInterruptMask(x)
+#define portDISABLE_INTERRUPTS()                vPortHostDisableInterrupts()
+#define portENABLE_INTERRUPTS()                 vPortHostEnableInterrupts()
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+
+/* Task function macros */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portINLINE  __inline
+#ifndef portFORCE_INLINE
+    #define portFORCE_INLINE inline __attribute__(( always_inline))
+#endif
+
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* 호스트 전용 설정 재정의
+ * - idle 태스크가 가상 시간을 진행시켜야 하므로 idle hook 사용을 강제한다.
+ *   (vApplicationIdleHook 은 port.c 가 제공)
+ * - configASSERT 는 무한루프 대신 파일/라인을 출력하고 abort. */
+#undef  configUSE_IDLE_HOOK
+#define configUSE_IDLE_HOOK     1
+
+extern void vPortHostAssert( const char *pcFile, int iLine );
+#undef  configASSERT
+#define configASSERT( x ) if( ( x ) == 0 ) { vPortHostAssert( __FILE__, __LINE__ ); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
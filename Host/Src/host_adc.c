@@ -0,0 +1,253 @@
+/*
+ * host_adc.c  (Host build)
+ *
+ *  가짜 HAL ADC + TIM (TRGO 트리거 주기만 모델링).
+ *  - 샘플 주기 = (PSC+1)*(ARR+1) / TIMCLK1 (APB1 분주 ≠ 1 이면 PCLK1 x2)
+ *  - 순환 DMA: 반 버퍼가 찰 때마다 이벤트 1회로 블록을 채우고 Half/Cplt 콜백
+ *  - 소프트웨어 트리거 단발 변환은 모델링하지 않음 (펌웨어 미사용)
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+static void prvTimChanged(TIM_TypeDef *inst, int running);
+
+/* ===== TIM ===== */
+typedef struct
+{
+    TIM_TypeDef       *inst;
+    TIM_HandleTypeDef *htim;
+    int                running;
+    uint32_t           trgo;
+} HostTIM_t;
+
+static HostTIM_t s_tims[2] = { { .inst = &HostPeriph_TIM2 }, { .inst = &HostPeriph_TIM3 } };
+
+static HostTIM_t *prvTim(TIM_TypeDef *inst)
+{
+    for (uint32_t i = 0; i < 2u; i++) {
+        if (s_tims[i].inst == inst) return &s_tims[i];
+    }
+    return NULL;
+}
+
+uint64_t HostTIM_PeriodNs(TIM_TypeDef *tim)
+{
+    HostTIM_t *t = prvTim(tim);
+    if (t == NULL || t->htim == NULL || !t->running) return 0u;
+    uint64_t ticks = (uint64_t)(t->htim->Init.Prescaler + 1u) * (t->htim->Init.Period + 1u);
+    return ticks * 1000000000ull / HostSim_TIMCLK1();
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+    HostTIM_t *t = (htim != NULL) ? prvTim(htim->Instance) : NULL;
+    if (t == NULL) return HAL_ERROR;
+    t->htim = htim;
+    htim->State = HAL_TIM_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig)
+{
+    if (htim == NULL || sClockSourceConfig == NULL) return HAL_ERROR;
+    return (sClockSourceConfig->ClockSource == TIM_CLOCKSOURCE_INTERNAL) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig)
+{
+    HostTIM_t *t = (htim != NULL) ? prvTim(htim->Instance) : NULL;
+    if (t == NULL || sMasterConfig == NULL) return HAL_ERROR;
+    t->trgo = sMasterConfig->MasterOutputTrigger;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim)
+{
+    HostTIM_t *t = (htim != NULL) ? prvTim(htim->Instance) : NULL;
+    if (t == NULL || htim->State != HAL_TIM_STATE_READY) return HAL_ERROR;
+    t->running = 1;
+    htim->State = HAL_TIM_STATE_BUSY;
+    prvTimChanged(htim->Instance, 1);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim)
+{
+    HostTIM_t *t = (htim != NULL) ? prvTim(htim->Instance) : NULL;
+    if (t == NULL) return HAL_ERROR;
+    t->running = 0;
+    htim->State = HAL_TIM_STATE_READY;
+    prvTimChanged(htim->Instance, 0);
+    return HAL_OK;
+}
+
+/* ===== ADC ===== */
+typedef struct
+{
+    ADC_TypeDef       *inst;
+    ADC_HandleTypeDef *hadc;
+    uint32_t           channel;       /* Rank 1 채널 */
+    HostADC_SourceFn   src;
+    void              *src_ctx;
+
+    uint16_t          *buf;
+    uint32_t           len;
+    uint32_t           pos;            /* 다음에 채울 인덱스 */
+    uint64_t           next_ns;        /* 다음 샘플 시각 */
+    uint32_t           gen;            /* Start/Stop 세대 (오래된 이벤트 무시) */
+    int                armed;          /* 블록 이벤트 예약됨 */
+    HostADC_Stats_t    stats;
+} HostADC_t;
+
+static HostADC_t s_adcs[1] = { { .inst = &HostPeriph_ADC1 } };
+
+static HostADC_t *prvAdc(ADC_TypeDef *inst)
+{
+    return (inst == &HostPeriph_ADC1) ? &s_adcs[0] : NULL;
+}
+
+int HostADC_SetSource(ADC_TypeDef *adc, HostADC_SourceFn fn, void *ctx)
+{
+    HostADC_t *a = prvAdc(adc);
+    if (a == NULL) return -1;
+    a->src = fn;
+    a->src_ctx = ctx;
+    return 0;
+}
+
+void HostADC_GetStats(ADC_TypeDef *adc, HostADC_Stats_t *out)
+{
+    HostADC_t *a = prvAdc(adc);
+    if (a != NULL && out != NULL) *out = a->stats;
+}
+
+static uint64_t prvPeriodNs(HostADC_t *a)
+{
+    if (a->hadc->Init.ExternalTrigConv == ADC_EXTERNALTRIGCONV_T2_TRGO) return HostTIM_PeriodNs(TIM2);
+    return 0u;
+}
+
+static void prvScheduleBlock(HostADC_t *a);
+
+/* DMA 가 시작되어 있고 트리거 타이머가 돌고 있으면 다음 TRGO 부터 변환 시작 */
+static void prvArm(HostADC_t *a)
+{
+    uint64_t per;
+    if (a->hadc == NULL || a->buf == NULL || a->armed) return;
+    per = prvPeriodNs(a);
+    if (per == 0u) return;
+    a->next_ns = HostSim_NowUs() * 1000u + per;
+    prvScheduleBlock(a);
+}
+
+/* 반 버퍼 분량 샘플을 채우고 DMA HT/TC 인터럽트 */
+static void prvBlockDone(void *arg)
+{
+    HostADC_t *a = (HostADC_t *)arg;
+    uint64_t per = prvPeriodNs(a);
+    uint32_t half = a->len / 2u;
+
+    if (a->hadc == NULL || a->buf == NULL || per == 0u) { a->armed = 0; return; }
+
+    for (uint32_t i = 0; i < half; i++) {
+        uint16_t v = (a->src != NULL) ? a->src(a->src_ctx, a->channel, a->next_ns) : 0u;
+        a->buf[a->pos++] = (uint16_t)(v & 0x0FFFu);
+        a->next_ns += per;
+    }
+    a->stats.samples += half;
+
+    if (a->pos >= a->len) {
+        a->pos = 0u;
+        a->stats.full_irqs++;
+        HAL_ADC_ConvCpltCallback(a->hadc);
+    } else {
+        a->stats.half_irqs++;
+        HAL_ADC_ConvHalfCpltCallback(a->hadc);
+    }
+    prvScheduleBlock(a);
+}
+
+static void prvBlockEvent(void *arg)
+{
+    HostADC_t *a = &s_adcs[0];
+    if ((uint32_t)(uintptr_t)arg != a->gen) return;    /* Stop 이후 이벤트 */
+    prvBlockDone(a);
+}
+
+static void prvScheduleBlock(HostADC_t *a)
+{
+    uint64_t per = prvPeriodNs(a);
+    if (per == 0u || a->buf == NULL) { a->armed = 0; return; }
+
+    a->armed = 1;
+    /* 블록 마지막 샘플의 변환 완료 시각 */
+    uint64_t done_ns = a->next_ns + per * (a->len / 2u - 1u);
+    uint64_t now_ns = HostSim_NowUs() * 1000u;
+    uint64_t delay_us = (done_ns > now_ns) ? (done_ns - now_ns + 999u) / 1000u : 0u;
+    HostSim_Schedule((uint32_t)delay_us, prvBlockEvent, (void *)(uintptr_t)a->gen);
+}
+
+static void prvTimChanged(TIM_TypeDef *inst, int running)
+{
+    HostADC_t *a = &s_adcs[0];
+    if (a->hadc == NULL || a->hadc->Init.ExternalTrigConv != ADC_EXTERNALTRIGCONV_T2_TRGO || inst != TIM2) return;
+    if (running) {
+        prvArm(a);
+    } else {
+        a->gen++;          /* 트리거 정지: 예약된 블록 취소 */
+        a->armed = 0;
+    }
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc)
+{
+    HostADC_t *a = (hadc != NULL) ? prvAdc(hadc->Instance) : NULL;
+    if (a == NULL) return HAL_ERROR;
+    a->hadc = hadc;
+    hadc->State = HAL_ADC_STATE_READY;
+    hadc->ErrorCode = 0U;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig)
+{
+    HostADC_t *a = (hadc != NULL) ? prvAdc(hadc->Instance) : NULL;
+    if (a == NULL || sConfig == NULL) return HAL_ERROR;
+    if (sConfig->Rank == 1u) a->channel = sConfig->Channel;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length)
+{
+    HostADC_t *a = (hadc != NULL) ? prvAdc(hadc->Instance) : NULL;
+    if (a == NULL || pData == NULL || Length < 2u || (Length & 1u)) return HAL_ERROR;
+    if (hadc->State & HAL_ADC_STATE_REG_BUSY) return HAL_BUSY;
+
+    /* DMA 는 half-word 단위로 버퍼에 기록 (실제 HAL 과 동일하게 uint32_t* 로 받음) */
+    a->buf = (uint16_t *)(void *)pData;
+    a->len = Length;
+    a->pos = 0u;
+    a->gen++;
+    hadc->State |= HAL_ADC_STATE_REG_BUSY;
+
+    a->armed = 0;
+    prvArm(a);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc)
+{
+    HostADC_t *a = (hadc != NULL) ? prvAdc(hadc->Instance) : NULL;
+    if (a == NULL) return HAL_ERROR;
+    a->gen++;
+    a->armed = 0;
+    a->buf = NULL;
+    hadc->State &= ~HAL_ADC_STATE_REG_BUSY;
+    return HAL_OK;
+}
+
+__weak void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)     { UNUSED(hadc); }
+__weak void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc) { UNUSED(hadc); }
+__weak void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)        { UNUSED(hadc); }
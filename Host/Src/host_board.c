@@ -0,0 +1,376 @@
+/*
+ * host_board.c  (Host build)
+ *
+ *  main.c 의 핸들/MX_*_Init/RTOS 객체 구성을 그대로 옮긴 호스트 보드.
+ *  설정값을 바꿀 때는 main.c 와 함께 맞춘다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "Trace.h"
+#include "BusRec.h"
+
+/* ===== HAL Handle Definitions (main.c 와 동일) ===== */
+ADC_HandleTypeDef   hadc1;
+DMA_HandleTypeDef   hdma_adc1;
+TIM_HandleTypeDef   htim2;
+CAN_HandleTypeDef   hcan1;
+
+I2C_HandleTypeDef   hi2c1;
+I2C_HandleTypeDef   hi2c2;
+DMA_HandleTypeDef   hdma_i2c1_rx;
+DMA_HandleTypeDef   hdma_i2c1_tx;
+DMA_HandleTypeDef   hdma_i2c2_rx;
+DMA_HandleTypeDef   hdma_i2c2_tx;
+
+SPI_HandleTypeDef   hspi1;
+SPI_HandleTypeDef   hspi2;
+DMA_HandleTypeDef   hdma_spi1_rx;
+DMA_HandleTypeDef   hdma_spi1_tx;
+DMA_HandleTypeDef   hdma_spi2_rx;
+DMA_HandleTypeDef   hdma_spi2_tx;
+
+UART_HandleTypeDef  huart4;
+
+/* ===== RTOS Kernel Objects ===== */
+osEventFlagsId_t    CommEventFlagHandle;
+osMutexId_t         CommMutexHandle;
+osMessageQueueId_t  LogQueueHandle;
+
+osThreadId_t defaultTaskHandle;
+osThreadId_t I2CTaskHandle;
+osThreadId_t SPITaskHandle;
+osThreadId_t CANTaskHandle;
+osThreadId_t UARTTaskHandle;
+osThreadId_t SupplyMonTaskHandle;
+osThreadId_t DvfsTaskHandle;
+osThreadId_t LogTaskHandle;
+osThreadId_t EECacheTaskHandle;
+osThreadId_t UDSTaskHandle;
+
+/* ===== 디바이스 모델 ===== */
+M25LC256_t g_eeprom;
+MMP5475_t  g_pmic;
+M25LC256_t g_eeprom2;
+MMP5475_t  g_pmic2;
+W25Q_t     g_flash;
+
+/* main.c 와 동일한 BusMgr 레지스트리 */
+static const BusDev_t boardDevices[] = {
+    { "pmic0",   BUSDEV_PMIC,      BUS_I2C1, I2C_SLAVE_ADDRESS, NULL,               0            },
+    { "pmic1",   BUSDEV_PMIC,      BUS_I2C2, I2C_SLAVE_ADDRESS, NULL,               0            },
+    { "eeprom0", BUSDEV_EEPROM,    BUS_SPI1, 0,                 NULL,               0            },
+    { "eeprom1", BUSDEV_EEPROM,    BUS_SPI2, 0,                 EE2_CS_GPIO_Port,   EE2_CS_Pin   },
+    { "flash0",  BUSDEV_SPI_FLASH, BUS_SPI2, 0,                 FLASH_CS_GPIO_Port, FLASH_CS_Pin },
+};
+
+/* ADC1 CH2 입력: 12V 계통 1:11 분압. 테스트는 HostADC_SetSource() 로 교체 */
+static volatile uint32_t s_supply_mV = 12000u;
+
+static uint16_t prvSupplySource(void *ctx, uint32_t channel, uint64_t t_ns)
+{
+    (void)ctx; (void)channel; (void)t_ns;
+    uint32_t adc_mV = s_supply_mV / 11u;
+    uint32_t counts = adc_mV * SUPPLYMON_ADC_FULL / SUPPLYMON_ADC_VREF_mV;
+    return (uint16_t)((counts > SUPPLYMON_ADC_FULL) ? SUPPLYMON_ADC_FULL : counts);
+}
+
+void HostBoard_SetSupply_mV(uint32_t mV)
+{
+    s_supply_mV = mV;
+}
+
+/* 외부 CAN FD 컨트롤러 ↔ UDS 서버 */
+static UDS_FdPort_t s_fdPort;
+
+static HAL_StatusTypeDef prvFdSend(uint32_t stdId, const uint8_t *data, uint8_t len)
+{
+    return (HostCAN_FdSend(CAN1, stdId, data, len) == 0) ? HAL_OK : HAL_BUSY;
+}
+
+static void prvFdRx(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    UDS_FdRxFromISR(f->id, f->data, f->dlc);
+}
+
+void HostBoard_UseCanFd(uint8_t tx_dl, uint32_t data_bps)
+{
+    s_fdPort.send = prvFdSend;
+    s_fdPort.tx_dl = tx_dl;
+    if (HostCAN_FdAttach(CAN1, prvFdRx, NULL, data_bps) != 0) { Error_Handler(); }
+    UDS_SetFdPort(&s_fdPort);
+}
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler() @ %llu us\n", (unsigned long long)HostSim_NowUs());
+    abort();
+}
+
+static void MX_GPIO_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_2|EE2_CS_Pin|FLASH_CS_Pin, GPIO_PIN_SET);
+
+    GPIO_InitStruct.Pin = GPIO_PIN_0|GPIO_PIN_1;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_MEDIUM;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = GPIO_PIN_2;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = EE2_CS_Pin|FLASH_CS_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    HAL_GPIO_Init(EE2_CS_GPIO_Port, &GPIO_InitStruct);
+}
+
+static void MX_ADC1_Init(void)
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+
+    hadc1.Instance = ADC1;
+    hadc1.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV2;
+    hadc1.Init.Resolution            = ADC_RESOLUTION_12B;
+    hadc1.Init.ScanConvMode          = DISABLE;
+    hadc1.Init.ContinuousConvMode    = DISABLE;
+    hadc1.Init.DiscontinuousConvMode = DISABLE;
+    hadc1.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    hadc1.Init.ExternalTrigConv      = ADC_EXTERNALTRIGCONV_T2_TRGO;
+    hadc1.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
+    hadc1.Init.NbrOfConversion       = 1;
+    hadc1.Init.DMAContinuousRequests = ENABLE;
+    hadc1.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
+    if (HAL_ADC_Init(&hadc1) != HAL_OK) { Error_Handler(); }
+
+    sConfig.Channel      = ADC_CHANNEL_2;
+    sConfig.Rank         = 1;
+    sConfig.SamplingTime = ADC_SAMPLETIME_84CYCLES;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK) { Error_Handler(); }
+}
+
+static void MX_TIM2_Init(void)
+{
+    TIM_ClockConfigTypeDef  sClockSourceConfig = {0};
+    TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+    htim2.Instance = TIM2;
+    htim2.Init.Prescaler         = 0;
+    htim2.Init.CounterMode       = TIM_COUNTERMODE_UP;
+    htim2.Init.Period            = 1249;
+    htim2.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&htim2) != HAL_OK) { Error_Handler(); }
+
+    sClockSourceConfig.ClockSource = TIM_CLOCKSOURCE_INTERNAL;
+    if (HAL_TIM_ConfigClockSource(&htim2, &sClockSourceConfig) != HAL_OK) { Error_Handler(); }
+
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    sMasterConfig.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(&htim2, &sMasterConfig) != HAL_OK) { Error_Handler(); }
+}
+
+static void MX_CAN1_Init(void)
+{
+    hcan1.Instance = CAN1;
+    hcan1.Init.Prescaler           = 16;
+    hcan1.Init.Mode                = CAN_MODE_NORMAL;
+    hcan1.Init.SyncJumpWidth       = CAN_SJW_1TQ;
+    hcan1.Init.TimeSeg1            = CAN_BS1_1TQ;
+    hcan1.Init.TimeSeg2            = CAN_BS2_1TQ;
+    hcan1.Init.TimeTriggeredMode   = DISABLE;
+    hcan1.Init.AutoBusOff          = DISABLE;
+    hcan1.Init.AutoWakeUp          = DISABLE;
+    hcan1.Init.AutoRetransmission  = DISABLE;
+    hcan1.Init.ReceiveFifoLocked   = DISABLE;
+    hcan1.Init.TransmitFifoPriority= DISABLE;
+    if (HAL_CAN_Init(&hcan1) != HAL_OK) { Error_Handler(); }
+
+    CAN_FilterTypeDef sFilterConfig = {0};
+    sFilterConfig.FilterBank           = 0;
+    sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
+    sFilterConfig.FilterScale          = CAN_FILTERSCALE_32BIT;
+    sFilterConfig.FilterIdHigh         = UDS_REQ_CANID << 5;
+    sFilterConfig.FilterIdLow          = 0x0000;
+    sFilterConfig.FilterMaskIdHigh     = 0x7FFu << 5;
+    sFilterConfig.FilterMaskIdLow      = 0x0006;
+    sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+    sFilterConfig.FilterActivation     = ENABLE;
+    sFilterConfig.SlaveStartFilterBank = 14;
+    if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+    // UDS 기능 요청(0x7DF) → FIFO0: bank 1, 같은 마스크
+    sFilterConfig.FilterBank           = 1;
+    sFilterConfig.FilterIdHigh         = UDS_FUNC_REQ_CANID << 5;
+    if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+    if (HAL_CAN_Start(&hcan1) != HAL_OK) { Error_Handler(); }
+    if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_TX_MAILBOX_EMPTY | CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK) { Error_Handler(); }
+}
+
+static void prvI2CInit(I2C_HandleTypeDef *h, I2C_TypeDef *inst, uint32_t hz)
+{
+    h->Instance             = inst;
+    h->Init.ClockSpeed      = hz;
+    h->Init.DutyCycle       = I2C_DUTYCYCLE_2;
+    h->Init.OwnAddress1     = 0;
+    h->Init.AddressingMode  = I2C_ADDRESSINGMODE_7BIT;
+    h->Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+    h->Init.OwnAddress2     = 0;
+    h->Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+    h->Init.NoStretchMode   = I2C_NOSTRETCH_DISABLE;
+    if (HAL_I2C_Init(h) != HAL_OK) { Error_Handler(); }
+}
+
+static void prvSPIInit(SPI_HandleTypeDef *h, SPI_TypeDef *inst)
+{
+    h->Instance               = inst;
+    h->Init.Mode              = SPI_MODE_MASTER;
+    h->Init.Direction         = SPI_DIRECTION_2LINES;
+    h->Init.DataSize          = SPI_DATASIZE_8BIT;
+    h->Init.CLKPolarity       = SPI_POLARITY_LOW;
+    h->Init.CLKPhase          = SPI_PHASE_1EDGE;
+    h->Init.NSS               = SPI_NSS_SOFT;
+    h->Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+    h->Init.FirstBit          = SPI_FIRSTBIT_MSB;
+    h->Init.TIMode            = SPI_TIMODE_DISABLE;
+    h->Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+    h->Init.CRCPolynomial     = 10;
+    if (HAL_SPI_Init(h) != HAL_OK) { Error_Handler(); }
+}
+
+static void MX_UART4_Init(void)
+{
+    huart4.Instance        = UART4;
+    huart4.Init.BaudRate   = 115200;
+    huart4.Init.WordLength = UART_WORDLENGTH_8B;
+    huart4.Init.StopBits   = UART_STOPBITS_1;
+    huart4.Init.Parity     = UART_PARITY_NONE;
+    huart4.Init.Mode       = UART_MODE_TX_RX;
+    huart4.Init.HwFlowCtl  = UART_HWCONTROL_NONE;
+    huart4.Init.OverSampling = UART_OVERSAMPLING_16;
+    if (HAL_UART_Init(&huart4) != HAL_OK) { Error_Handler(); }
+}
+
+void HostBoard_Init(void)
+{
+    HAL_Init();
+
+    MX_GPIO_Init();
+    MX_ADC1_Init();
+    MX_TIM2_Init();
+    MX_CAN1_Init();
+    prvI2CInit(&hi2c1, I2C1, 400000);   /* MP5475: Fast-mode */
+    prvI2CInit(&hi2c2, I2C2, 400000);   /* 두 번째 MP5475 */
+    prvSPIInit(&hspi1, SPI1);
+    prvSPIInit(&hspi2, SPI2);
+    MX_UART4_Init();
+
+    Trace_Init();
+    BusRec_Init();
+    StackMon_Init();
+    Mpu_Init();
+    PMIC_ShadowInit(&pmicShadow, &hi2c1);
+    DVFS_Init();
+
+    M25LC256_Init(&g_eeprom);
+    if (M25LC256_Attach(&g_eeprom, SPI1, NULL, 0) != 0) { Error_Handler(); }
+    MMP5475_Init(&g_pmic);
+    if (MMP5475_Attach(&g_pmic, I2C1) != 0) { Error_Handler(); }
+    M25LC256_Init(&g_eeprom2);
+    if (M25LC256_Attach(&g_eeprom2, SPI2, EE2_CS_GPIO_Port, EE2_CS_Pin) != 0) { Error_Handler(); }
+    MMP5475_Init(&g_pmic2);
+    if (MMP5475_Attach(&g_pmic2, I2C2) != 0) { Error_Handler(); }
+    W25Q_Init(&g_flash);
+    if (W25Q_Attach(&g_flash, SPI2, FLASH_CS_GPIO_Port, FLASH_CS_Pin) != 0) { Error_Handler(); }
+    if (HostADC_SetSource(ADC1, prvSupplySource, NULL) != 0) { Error_Handler(); }
+}
+
+void HostBoard_CreateTasks(void)
+{
+    osKernelInitialize();
+
+    CommEventFlagHandle     = osEventFlagsNew(NULL);
+    CommMutexHandle         = osMutexNew(NULL);
+    LogQueueHandle          = osMessageQueueNew(FLASHLOG_QUEUE_DEPTH, sizeof(FlashLog_Msg_t), NULL);
+
+    BusMgr_Init();
+    BusMgr_ShareLock(BUS_I2C1, CommMutexHandle);
+    BusMgr_ShareLock(BUS_SPI1, CommMutexHandle);
+    for (uint32_t i = 0; i < sizeof(boardDevices) / sizeof(boardDevices[0]); i++) {
+        if (BusMgr_Register(&boardDevices[i]) < 0) { Error_Handler(); }
+    }
+    EECache_Init(&eeCache, BusMgr_Find("eeprom0"));
+    DTCMem_Init(&dtcMem, BusMgr_Find("eeprom0"));
+    UDS_Init();
+    if (DID_CheckTable(&didTable) != HAL_OK) { Error_Handler(); }
+
+    const osThreadAttr_t defaultTask_attributes = {
+      .name = "defaultTask", .stack_size = TASK_STACK_DEFAULT, .priority = (osPriority_t)osPriorityNormal,
+    };
+    defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
+
+    const osThreadAttr_t I2CTask_attributes = {
+      .name = "I2CTask", .stack_size = TASK_STACK_I2C, .priority = (osPriority_t)osPriorityNormal,
+    };
+    I2CTaskHandle = osThreadNew(StartI2CTask, NULL, &I2CTask_attributes);
+
+    const osThreadAttr_t SPITask_attributes = {
+      .name = "SPITask", .stack_size = TASK_STACK_SPI, .priority = (osPriority_t)osPriorityNormal,
+    };
+    SPITaskHandle = osThreadNew(StartSPITask, NULL, &SPITask_attributes);
+
+    const osThreadAttr_t CANTask_attributes = {
+      .name = "CANTask", .stack_size = TASK_STACK_CAN, .priority = (osPriority_t)osPriorityNormal,
+    };
+    CANTaskHandle = osThreadNew(StartCANTask, NULL, &CANTask_attributes);
+
+    const osThreadAttr_t UARTTask_attributes = {
+      .name = "UARTTask", .stack_size = TASK_STACK_UART, .priority = (osPriority_t)osPriorityNormal,
+    };
+    UARTTaskHandle = osThreadNew(StartUARTTask, NULL, &UARTTask_attributes);
+
+    const osThreadAttr_t SupplyMonTask_attributes = {
+      .name = "SupplyMonTask", .stack_size = TASK_STACK_SUPPLYMON, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    SupplyMonTaskHandle = osThreadNew(StartSupplyMonTask, NULL, &SupplyMonTask_attributes);
+
+    const osThreadAttr_t DvfsTask_attributes = {
+      .name = "DvfsTask", .stack_size = TASK_STACK_DVFS, .priority = (osPriority_t)osPriorityBelowNormal,
+    };
+    DvfsTaskHandle = osThreadNew(StartDvfsTask, NULL, &DvfsTask_attributes);
+
+    const osThreadAttr_t LogTask_attributes = {
+      .name = "LogTask", .stack_size = TASK_STACK_LOG, .priority = (osPriority_t)osPriorityLow,
+    };
+    LogTaskHandle = osThreadNew(StartLogTask, NULL, &LogTask_attributes);
+
+    const osThreadAttr_t EECacheTask_attributes = {
+      .name = "EECacheTask", .stack_size = TASK_STACK_EECACHE, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    EECacheTaskHandle = osThreadNew(StartEECacheTask, NULL, &EECacheTask_attributes);
+
+    const osThreadAttr_t UDSTask_attributes = {
+      .name = "UDSTask", .stack_size = TASK_STACK_UDS, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    UDSTaskHandle = osThreadNew(StartUDSTask, NULL, &UDSTask_attributes);
+
+    Mpu_Attach(defaultTaskHandle, MPU_DOM_STORAGE);
+    Mpu_Attach(I2CTaskHandle, MPU_DOM_I2C);
+    Mpu_Attach(SPITaskHandle, MPU_DOM_SPI);
+    Mpu_Attach(EECacheTaskHandle, MPU_DOM_STORAGE);
+    Mpu_Attach(UDSTaskHandle, MPU_DOM_STORAGE);
+}
+
+void HostBoard_Run(uint32_t ms)
+{
+    HostSim_SetDuration(ms);
+    osKernelStart();
+}
@@ -0,0 +1,185 @@
+/*
+ * host_boot_board.c  (Host build)
+ *
+ *  boot_main.c 의 CAN1/RTOS 구성을 그대로 옮긴 호스트 부트로더 보드 + 테스터 링크.
+ *  설정값을 바꿀 때는 boot_main.c 와 함께 맞춘다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_boot_board.h"
+#include "host_sim.h"
+#include "IsoTp.h"
+
+#define TESTER_RX_RING   64u
+#define TESTER_TX_SLOTS  2u
+
+/* ===== HAL Handle / RTOS Kernel Objects (boot_main.c 와 동일) ===== */
+CAN_HandleTypeDef   hcan1;
+osMessageQueueId_t  BootQueueHandle;
+
+osThreadId_t BootTaskHandle;
+osThreadId_t FlashTaskHandle;
+
+static uint32_t s_last_reset = BOOT_FLAG_NONE;
+
+void Boot_Reset(uint32_t flag)
+{
+    s_last_reset = flag;
+    bootState.resets++;
+}
+
+uint32_t HostBootBoard_LastReset(void)
+{
+    return s_last_reset;
+}
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler() @ %llu us\n", (unsigned long long)HostSim_NowUs());
+    abort();
+}
+
+static void MX_CAN1_Init(void)
+{
+    hcan1.Instance = CAN1;
+    hcan1.Init.Prescaler           = 16;
+    hcan1.Init.Mode                = CAN_MODE_NORMAL;
+    hcan1.Init.SyncJumpWidth       = CAN_SJW_1TQ;
+    hcan1.Init.TimeSeg1            = CAN_BS1_1TQ;
+    hcan1.Init.TimeSeg2            = CAN_BS2_1TQ;
+    hcan1.Init.TimeTriggeredMode   = DISABLE;
+    hcan1.Init.AutoBusOff          = DISABLE;
+    hcan1.Init.AutoWakeUp          = DISABLE;
+    hcan1.Init.AutoRetransmission  = DISABLE;
+    hcan1.Init.ReceiveFifoLocked   = DISABLE;
+    hcan1.Init.TransmitFifoPriority= DISABLE;
+    if (HAL_CAN_Init(&hcan1) != HAL_OK) { Error_Handler(); }
+
+    CAN_FilterTypeDef sFilterConfig = {0};
+    sFilterConfig.FilterBank           = 0;
+    sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
+    sFilterConfig.FilterScale          = CAN_FILTERSCALE_32BIT;
+    sFilterConfig.FilterIdHigh         = BOOT_REQ_CANID << 5;
+    sFilterConfig.FilterIdLow          = 0x0000;
+    sFilterConfig.FilterMaskIdHigh     = 0x7FFu << 5;
+    sFilterConfig.FilterMaskIdLow      = 0x0006;
+    sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO0;
+    sFilterConfig.FilterActivation     = ENABLE;
+    sFilterConfig.SlaveStartFilterBank = 14;
+    if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+    sFilterConfig.FilterBank           = 1;
+    sFilterConfig.FilterIdHigh         = BOOT_FUNC_CANID << 5;
+    if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig) != HAL_OK) { Error_Handler(); }
+
+    if (HAL_CAN_Start(&hcan1) != HAL_OK) { Error_Handler(); }
+    if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK) { Error_Handler(); }
+}
+
+void HostBootBoard_Init(void)
+{
+    HAL_Init();
+    MX_CAN1_Init();
+}
+
+void HostBootBoard_CreateTasks(void)
+{
+    osKernelInitialize();
+
+    BootQueueHandle = osMessageQueueNew(BOOT_RX_DEPTH, sizeof(Boot_RxFrame_t), NULL);
+    FlashProg_Init(&flashProg);
+    Boot_Init(!FlashProg_AppValid(1));
+
+    const osThreadAttr_t BootTask_attributes = {
+      .name = "BootTask", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    BootTaskHandle = osThreadNew(StartBootTask, NULL, &BootTask_attributes);
+
+    const osThreadAttr_t FlashTask_attributes = {
+      .name = "FlashTask", .stack_size = 192 * 4, .priority = (osPriority_t)osPriorityBelowNormal,
+    };
+    FlashTaskHandle = osThreadNew(StartFlashTask, &flashProg, &FlashTask_attributes);
+}
+
+void HostBootBoard_Run(uint32_t ms)
+{
+    HostSim_SetDuration(ms);
+    osKernelStart();
+}
+
+/* ===== 테스터 링크 ===== */
+static osThreadId_t      s_tester;
+static osSemaphoreId_t   s_tx_slots;
+static uint8_t           s_rx[TESTER_RX_RING][8];
+static volatile uint32_t s_rx_head, s_rx_tail;
+
+static void prvTesterNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != BOOT_RES_CANID || f->dlc != 8u) return;
+    memcpy(s_rx[s_rx_head % TESTER_RX_RING], f->data, 8);
+    s_rx_head++;
+    osThreadFlagsSet(s_tester, 1u);
+}
+
+static void prvTesterTxDone(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx; (void)f;
+    (void)osSemaphoreRelease(s_tx_slots);
+}
+
+static int prvTesterSend(void *ctx, const uint8_t *frame)
+{
+    (void)ctx;
+    if (osSemaphoreAcquire(s_tx_slots, ISOTP_N_AS_MS) != osOK) return -1;
+    if (HostCAN_Inject(CAN1, BOOT_REQ_CANID, frame, 8) != 0) {
+        (void)osSemaphoreRelease(s_tx_slots);
+        return -1;
+    }
+    return 0;
+}
+
+static int prvTesterRecv(void *ctx, uint8_t *frame, uint32_t timeout_ms)
+{
+    (void)ctx;
+    uint32_t start = osKernelGetTickCount();
+    while (s_rx_tail == s_rx_head) {
+        uint32_t spent = osKernelGetTickCount() - start;
+        if (spent >= timeout_ms) return -1;
+        (void)osThreadFlagsWait(1u, osFlagsWaitAny, timeout_ms - spent);
+    }
+    memcpy(frame, s_rx[s_rx_tail % TESTER_RX_RING], 8);
+    s_rx_tail++;
+    return 0;
+}
+
+static void prvTesterDelay(void *ctx, uint32_t us)
+{
+    (void)ctx;
+    osDelay((us + 999u) / 1000u);
+}
+
+static uint64_t prvTesterNow(void *ctx)
+{
+    (void)ctx;
+    return HostSim_NowUs();
+}
+
+void HostBootBoard_TesterInit(UdsClient_t *c)
+{
+    s_tester = osThreadGetId();
+    s_tx_slots = osSemaphoreNew(TESTER_TX_SLOTS, TESTER_TX_SLOTS, NULL);
+    s_rx_tail = s_rx_head;
+    if (HostCAN_AddNode(CAN1, prvTesterNode, NULL) != 0) { Error_Handler(); }
+    if (HostCAN_SetInjectDone(CAN1, prvTesterTxDone, NULL) != 0) { Error_Handler(); }
+
+    memset(c, 0, sizeof(*c));
+    UdsClient_Init(c);
+    c->send = prvTesterSend;
+    c->recv = prvTesterRecv;
+    c->delay_us = prvTesterDelay;
+    c->now_us = prvTesterNow;
+}
@@ -0,0 +1,445 @@
+/*
+ * host_can.c  (Host build)
+ *
+ *  가짜 HAL bxCAN + 단일 CAN 버스 모델.
+ *  - 비트 시간: Prescaler * (1 + BS1 + BS2) / PCLK1 (MX_CAN1_Init 설정 그대로 반영)
+ *  - 프레임 길이: 표준 ID 데이터 프레임 47bit + 8*DLC + 최악 스터핑 비트
+ *  - TX 메일박스 3개, RX FIFO0 3단. 버스는 한 번에 한 프레임 (DUT/외부 노드 공유)
+ *  - 필터를 설정하지 않으면 모든 프레임을 수신 (호스트 단순화)
+ *  - CAN FD (ISO 11898-1:2015): 중재/ACK/EOF 구간은 nominal, ESI~CRC 는 데이터 bit rate (BRS).
+ *    외부 FD 컨트롤러는 TX 버퍼 3 개, FD 프레임만 송수신 (classic 프레임은 bxCAN)
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+#define HOST_CAN_MAX_NODES   8u
+#define HOST_CAN_FIFO_DEPTH  3u
+#define HOST_CAN_TX_QUEUE    16u
+#define HOST_CAN_REG_US      1u
+#define HOST_CANFD_TX_BUFS   3u
+#define HOST_CANFD_SPI_HZ    10000000u
+#define HOST_CANFD_SPI_HDR   8u         /* SPI 명령/주소 2B + TX 객체 헤더 (ID, DLC/플래그) */
+
+typedef struct
+{
+    HostCAN_Frame_t f;
+    int             fromDut;
+    uint32_t        mailbox;    /* DUT 프레임: CAN_TX_MAILBOXx (FD 컨트롤러 프레임은 0) */
+} HostCAN_Pending_t;
+
+typedef struct
+{
+    CAN_TypeDef       *inst;
+    CAN_HandleTypeDef *hcan;           /* HAL_CAN_Init 으로 연결된 DUT 핸들 */
+    uint32_t           active_its;
+    uint32_t           mailbox_busy;   /* 비트마스크 */
+
+    HostCAN_Frame_t    fifo0[HOST_CAN_FIFO_DEPTH];
+    uint32_t           fifo0_head, fifo0_count;
+
+    HostCAN_Pending_t  queue[HOST_CAN_TX_QUEUE];   /* 버스 중재 대기 */
+    uint32_t           qcount;
+    int                bus_busy;
+
+    struct { HostCAN_NodeFn fn; void *ctx; } nodes[HOST_CAN_MAX_NODES];
+    uint32_t           nnode;
+    struct { HostCAN_NodeFn fn; void *ctx; } inject_done;
+
+    struct { HostCAN_NodeFn fn; void *ctx; } fd_rx;
+    uint32_t           fd_data_bps;    /* 0 = BRS 없음 */
+    uint32_t           fd_tx_busy;     /* 사용 중인 FD TX 버퍼 수 */
+
+    HostCAN_Stats_t    stats;
+} HostCAN_Bus_t;
+
+static HostCAN_Bus_t s_buses[2] = { { .inst = &HostPeriph_CAN1 }, { .inst = &HostPeriph_CAN2 } };
+
+static HostCAN_Bus_t *prvBus(CAN_TypeDef *inst)
+{
+    for (uint32_t i = 0; i < 2u; i++) {
+        if (s_buses[i].inst == inst) return &s_buses[i];
+    }
+    return NULL;
+}
+
+uint32_t HostCAN_BitTimeNs(CAN_TypeDef *bus)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    uint32_t presc = 16u, bs1 = 1u, bs2 = 1u;
+
+    if (b != NULL && b->hcan != NULL) {
+        presc = b->hcan->Init.Prescaler;
+        bs1   = ((b->hcan->Init.TimeSeg1 >> 16) & 0xFu) + 1u;
+        bs2   = ((b->hcan->Init.TimeSeg2 >> 20) & 0x7u) + 1u;
+    }
+    return (uint32_t)((uint64_t)presc * (1u + bs1 + bs2) * 1000000000ull / HostSim_PCLK1());
+}
+
+static uint32_t prvFrameUs(HostCAN_Bus_t *b, const HostCAN_Frame_t *f)
+{
+    uint32_t nominal = HostCAN_BitTimeNs(b->inst);
+    uint32_t dlc = f->dlc;
+
+    if (!f->fd) {
+        uint32_t body = 34u + 8u * dlc;           /* 스터핑 대상 구간 */
+        uint32_t bits = 47u + 8u * dlc + (body - 1u) / 4u;
+        uint64_t ns = (uint64_t)bits * nominal;
+        return (uint32_t)((ns + 999u) / 1000u);
+    }
+    /* nominal: SOF~BRS 17bit + 스터핑 4 + CRC delim/ACK/EOF/IFS 13.
+     * 데이터: ESI + DLC 5bit + 데이터 (동적 스터핑) + stuff count 4 + CRC 17/21 (고정 스터핑 1/4) */
+    uint32_t crc = (dlc <= 16u) ? 17u : 21u;
+    uint32_t dyn = 5u + 8u * dlc;
+    uint32_t data_bits = dyn + (dyn - 1u) / 4u + 4u + crc + (4u + crc + 3u) / 4u;
+    uint32_t data_ns = (f->brs && b->fd_data_bps != 0u) ? (uint32_t)(1000000000ull / b->fd_data_bps) : nominal;
+    uint64_t ns = (uint64_t)34u * nominal + (uint64_t)data_bits * data_ns;
+    return (uint32_t)((ns + 999u) / 1000u);
+}
+
+uint32_t HostCAN_FrameTimeUs(CAN_TypeDef *bus, const HostCAN_Frame_t *f)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    return (b == NULL) ? 0u : prvFrameUs(b, f);
+}
+
+static void prvStartNext(HostCAN_Bus_t *b);
+
+static void prvFrameDone(void *arg)
+{
+    HostCAN_Bus_t *b = (HostCAN_Bus_t *)arg;
+    HostCAN_Pending_t p = b->queue[0];
+
+    memmove(&b->queue[0], &b->queue[1], (b->qcount - 1u) * sizeof(b->queue[0]));
+    b->qcount--;
+    b->bus_busy = 0;
+    p.f.t_us = HostSim_NowUs();
+
+    if (p.fromDut) {
+        b->stats.tx_frames++;
+        b->mailbox_busy &= ~p.mailbox;
+        if (p.f.fd) b->fd_tx_busy--;
+        for (uint32_t i = 0; i < b->nnode; i++) {
+            b->nodes[i].fn(b->nodes[i].ctx, &p.f);
+        }
+        if (b->hcan != NULL && (b->active_its & CAN_IT_TX_MAILBOX_EMPTY)) {
+            if (p.mailbox == CAN_TX_MAILBOX0)      HAL_CAN_TxMailbox0CompleteCallback(b->hcan);
+            else if (p.mailbox == CAN_TX_MAILBOX1) HAL_CAN_TxMailbox1CompleteCallback(b->hcan);
+            else                                   HAL_CAN_TxMailbox2CompleteCallback(b->hcan);
+        }
+    } else {
+        if (b->inject_done.fn != NULL) b->inject_done.fn(b->inject_done.ctx, &p.f);
+        if (p.f.fd) {
+            if (b->fd_rx.fn != NULL) {
+                b->stats.rx_frames++;
+                b->fd_rx.fn(b->fd_rx.ctx, &p.f);
+            }
+        } else if (b->hcan != NULL && b->hcan->State == HAL_CAN_STATE_LISTENING) {
+            if (b->fifo0_count >= HOST_CAN_FIFO_DEPTH) {
+                b->stats.rx_overruns++;
+                b->hcan->ErrorCode |= HAL_CAN_ERROR_RX_FOV0;
+            } else {
+                b->fifo0[(b->fifo0_head + b->fifo0_count) % HOST_CAN_FIFO_DEPTH] = p.f;
+                b->fifo0_count++;
+                b->stats.rx_frames++;
+                if (b->active_its & CAN_IT_RX_FIFO0_MSG_PENDING) {
+                    HAL_CAN_RxFifo0MsgPendingCallback(b->hcan);
+                }
+            }
+        }
+    }
+
+    prvStartNext(b);
+}
+
+/* 중재: 대기 중 가장 낮은 ID 가 먼저 버스를 얻는다 */
+static void prvStartNext(HostCAN_Bus_t *b)
+{
+    uint32_t best = 0;
+
+    if (b->bus_busy || b->qcount == 0u) return;
+    for (uint32_t i = 1; i < b->qcount; i++) {
+        if (b->queue[i].f.id < b->queue[best].f.id) best = i;
+    }
+    if (best != 0u) {
+        HostCAN_Pending_t tmp = b->queue[0];
+        b->queue[0] = b->queue[best];
+        b->queue[best] = tmp;
+    }
+
+    uint32_t us = prvFrameUs(b, &b->queue[0].f);
+    b->bus_busy = 1;
+    b->stats.busy_us += us;
+    HostSim_Schedule(us, prvFrameDone, b);
+}
+
+static int prvEnqueue(HostCAN_Bus_t *b, const HostCAN_Pending_t *p)
+{
+    if (b->qcount >= HOST_CAN_TX_QUEUE) return -1;
+    b->queue[b->qcount++] = *p;
+    prvStartNext(b);
+    return 0;
+}
+
+int HostCAN_AddNode(CAN_TypeDef *bus, HostCAN_NodeFn fn, void *ctx)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    if (b == NULL || fn == NULL || b->nnode >= HOST_CAN_MAX_NODES) return -1;
+    b->nodes[b->nnode].fn = fn;
+    b->nodes[b->nnode].ctx = ctx;
+    b->nnode++;
+    return 0;
+}
+
+int HostCAN_SetInjectDone(CAN_TypeDef *bus, HostCAN_NodeFn fn, void *ctx)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    if (b == NULL) return -1;
+    b->inject_done.fn = fn;
+    b->inject_done.ctx = ctx;
+    return 0;
+}
+
+int HostCAN_Inject(CAN_TypeDef *bus, uint32_t stdId, const uint8_t *data, uint8_t dlc)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    HostCAN_Pending_t p;
+
+    if (b == NULL || dlc > 8u) return -1;
+    memset(&p, 0, sizeof(p));
+    p.f.id = stdId & 0x7FFu;
+    p.f.dlc = dlc;
+    if (data != NULL) memcpy(p.f.data, data, dlc);
+    return prvEnqueue(b, &p);
+}
+
+/* CAN FD 데이터 길이 (DLC 9~15 에 대응하는 길이만) */
+static int prvFdLenValid(uint8_t len)
+{
+    return len <= 8u || len == 12u || len == 16u || len == 20u || len == 24u || len == 32u || len == 48u || len == 64u;
+}
+
+int HostCAN_FdAttach(CAN_TypeDef *bus, HostCAN_NodeFn rx, void *ctx, uint32_t data_bps)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    if (b == NULL) return -1;
+    b->fd_rx.fn = rx;
+    b->fd_rx.ctx = ctx;
+    b->fd_data_bps = data_bps;
+    return 0;
+}
+
+int HostCAN_FdSend(CAN_TypeDef *bus, uint32_t stdId, const uint8_t *data, uint8_t len)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    HostCAN_Pending_t p;
+
+    if (b == NULL || !prvFdLenValid(len)) return -1;
+    HostSim_Advance(HOST_CAN_REG_US);
+    if (b->fd_tx_busy >= HOST_CANFD_TX_BUFS) {
+        b->stats.tx_no_mailbox++;
+        return -1;
+    }
+    HostSim_Advance((uint32_t)(((uint64_t)(HOST_CANFD_SPI_HDR + len) * 8u * 1000000u + HOST_CANFD_SPI_HZ - 1u) / HOST_CANFD_SPI_HZ));
+
+    memset(&p, 0, sizeof(p));
+    p.fromDut = 1;
+    p.f.id = stdId & 0x7FFu;
+    p.f.dlc = len;
+    p.f.fd = 1;
+    p.f.brs = (b->fd_data_bps != 0u);
+    if (data != NULL) memcpy(p.f.data, data, len);
+    if (prvEnqueue(b, &p) != 0) return -1;
+    b->fd_tx_busy++;
+    return 0;
+}
+
+int HostCAN_InjectFd(CAN_TypeDef *bus, uint32_t stdId, const uint8_t *data, uint8_t len)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    HostCAN_Pending_t p;
+
+    if (b == NULL || !prvFdLenValid(len)) return -1;
+    memset(&p, 0, sizeof(p));
+    p.f.id = stdId & 0x7FFu;
+    p.f.dlc = len;
+    p.f.fd = 1;
+    p.f.brs = (b->fd_data_bps != 0u);
+    if (data != NULL) memcpy(p.f.data, data, len);
+    return prvEnqueue(b, &p);
+}
+
+void HostCAN_GetStats(CAN_TypeDef *bus, HostCAN_Stats_t *out)
+{
+    HostCAN_Bus_t *b = prvBus(bus);
+    if (b != NULL && out != NULL) *out = b->stats;
+}
+
+/* ===== HAL API ===== */
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef *hcan)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    if (b == NULL) return HAL_ERROR;
+    b->hcan = hcan;
+    hcan->ErrorCode = HAL_CAN_ERROR_NONE;
+    hcan->State = HAL_CAN_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_DeInit(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == NULL) return HAL_ERROR;
+    hcan->State = HAL_CAN_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig)
+{
+    (void)sFilterConfig;
+    if (hcan == NULL) return HAL_ERROR;
+    return (hcan->State == HAL_CAN_STATE_READY || hcan->State == HAL_CAN_STATE_LISTENING) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == NULL) return HAL_ERROR;
+    if (hcan->State != HAL_CAN_STATE_READY) {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_READY;
+        return HAL_ERROR;
+    }
+    hcan->State = HAL_CAN_STATE_LISTENING;
+    hcan->ErrorCode = HAL_CAN_ERROR_NONE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == NULL || hcan->State != HAL_CAN_STATE_LISTENING) return HAL_ERROR;
+    hcan->State = HAL_CAN_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    if (b == NULL) return HAL_ERROR;
+    b->active_its |= ActiveITs;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan, uint32_t InactiveITs)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    if (b == NULL) return HAL_ERROR;
+    b->active_its &= ~InactiveITs;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    HostCAN_Pending_t p;
+    uint32_t mb;
+
+    if (b == NULL || pHeader == NULL || pTxMailbox == NULL) return HAL_ERROR;
+    HostSim_Advance(HOST_CAN_REG_US);
+
+    if (hcan->State != HAL_CAN_STATE_READY && hcan->State != HAL_CAN_STATE_LISTENING) {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_INITIALIZED;
+        return HAL_ERROR;
+    }
+    if (pHeader->DLC > 8u) {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return HAL_ERROR;
+    }
+    if      (!(b->mailbox_busy & CAN_TX_MAILBOX0)) mb = CAN_TX_MAILBOX0;
+    else if (!(b->mailbox_busy & CAN_TX_MAILBOX1)) mb = CAN_TX_MAILBOX1;
+    else if (!(b->mailbox_busy & CAN_TX_MAILBOX2)) mb = CAN_TX_MAILBOX2;
+    else {
+        b->stats.tx_no_mailbox++;
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return HAL_ERROR;
+    }
+
+    memset(&p, 0, sizeof(p));
+    p.fromDut = 1;
+    p.mailbox = mb;
+    p.f.ide = (pHeader->IDE == CAN_ID_EXT) ? 1u : 0u;
+    p.f.id  = p.f.ide ? pHeader->ExtId : pHeader->StdId;
+    p.f.dlc = (uint8_t)pHeader->DLC;
+    if (aData != NULL) memcpy(p.f.data, aData, p.f.dlc);
+
+    /* 버스 오프 상태 전이는 모델링하지 않음. 리스닝 전이면 버스에 나가지 않는다 */
+    if (hcan->State != HAL_CAN_STATE_LISTENING) return HAL_ERROR;
+    if (prvEnqueue(b, &p) != 0) return HAL_ERROR;
+
+    b->mailbox_busy |= mb;
+    *pTxMailbox = mb;
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    uint32_t n = 0;
+    if (b == NULL) return 0;
+    HostSim_Advance(HOST_CAN_REG_US);
+    for (uint32_t mb = CAN_TX_MAILBOX0; mb <= CAN_TX_MAILBOX2; mb <<= 1) {
+        if (!(b->mailbox_busy & mb)) n++;
+    }
+    return n;
+}
+
+uint32_t HAL_CAN_IsTxMessagePending(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    if (b == NULL) return 0;
+    HostSim_Advance(HOST_CAN_REG_US);
+    return (b->mailbox_busy & TxMailboxes) ? 1u : 0u;
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[])
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    HostCAN_Frame_t *f;
+
+    if (b == NULL || RxFifo != CAN_RX_FIFO0 || pHeader == NULL || aData == NULL) return HAL_ERROR;
+    HostSim_Advance(HOST_CAN_REG_US);
+    if (hcan->State != HAL_CAN_STATE_LISTENING && hcan->State != HAL_CAN_STATE_READY) return HAL_ERROR;
+    if (b->fifo0_count == 0u) {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return HAL_ERROR;
+    }
+
+    f = &b->fifo0[b->fifo0_head];
+    memset(pHeader, 0, sizeof(*pHeader));
+    pHeader->IDE   = f->ide ? CAN_ID_EXT : CAN_ID_STD;
+    pHeader->StdId = f->ide ? 0u : f->id;
+    pHeader->ExtId = f->ide ? f->id : 0u;
+    pHeader->RTR   = CAN_RTR_DATA;
+    pHeader->DLC   = f->dlc;
+    pHeader->Timestamp = (uint32_t)(f->t_us & 0xFFFFu);
+    memcpy(aData, f->data, f->dlc);
+
+    b->fifo0_head = (b->fifo0_head + 1u) % HOST_CAN_FIFO_DEPTH;
+    b->fifo0_count--;
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo)
+{
+    HostCAN_Bus_t *b = (hcan != NULL) ? prvBus(hcan->Instance) : NULL;
+    if (b == NULL || RxFifo != CAN_RX_FIFO0) return 0;
+    HostSim_Advance(HOST_CAN_REG_US);
+    return b->fifo0_count;
+}
+
+HAL_CAN_StateTypeDef HAL_CAN_GetState(CAN_HandleTypeDef *hcan) { return hcan->State; }
+uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan)            { return hcan->ErrorCode; }
+
+__weak void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan) { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan) { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan) { UNUSED(hcan); }
+__weak void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)  { UNUSED(hcan); }
+__weak void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)              { UNUSED(hcan); }
@@ -0,0 +1,143 @@
+/*
+ * host_flash.c  (Host build)
+ *
+ *  가짜 HAL FLASH + STM32F413 내장 flash 모델 (host_sim.h 참조).
+ *  - 시간 (datasheet typ, x32 병렬, 2.7~3.6V): word program 16us,
+ *    섹터 erase 16KB 250ms / 64KB 550ms / 128KB 1000ms. byte/halfword 도 1 회 16us 로 취급
+ *  - 호출한 문맥에서 그 시간만큼 가상 시간을 소모 (완료 대기 = CPU 정지).
+ *    소모 중 경과한 인터럽트는 인터럽트 허용 시 디스패치 (프로그래밍 사이사이 CAN 수신 등)
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+#define HOST_FLASH_SECTORS     16u
+#define HOST_FLASH_PROG_US     16u
+
+static uint8_t           s_mem[HOST_FLASH_SIZE];
+static int               s_init;
+static int               s_unlocked;
+static uint32_t          s_error;
+static uint32_t          s_fail_addr;
+static HostFlash_Stats_t s_stats;
+
+static void prvInit(void)
+{
+    if (!s_init) {
+        memset(s_mem, 0xFF, sizeof(s_mem));
+        s_init = 1;
+    }
+}
+
+/* 섹터 → (offset, 크기, erase 시간) */
+static void prvSector(uint32_t sector, uint32_t *off, uint32_t *size, uint32_t *us)
+{
+    if (sector < 4u) {
+        *off = sector * 16u * 1024u;
+        *size = 16u * 1024u;
+        *us = 250000u;
+    } else if (sector == 4u) {
+        *off = 64u * 1024u;
+        *size = 64u * 1024u;
+        *us = 550000u;
+    } else {
+        *off = (sector - 4u) * 128u * 1024u;
+        *size = 128u * 1024u;
+        *us = 1000000u;
+    }
+}
+
+const uint8_t *HostFlash_Ptr(uint32_t addr)
+{
+    prvInit();
+    if (addr < HOST_FLASH_BASE || addr - HOST_FLASH_BASE >= HOST_FLASH_SIZE) return NULL;
+    return &s_mem[addr - HOST_FLASH_BASE];
+}
+
+void HostFlash_Load(uint32_t addr, const void *data, uint32_t len)
+{
+    prvInit();
+    if (addr < HOST_FLASH_BASE || addr - HOST_FLASH_BASE + len > HOST_FLASH_SIZE) return;
+    memcpy(&s_mem[addr - HOST_FLASH_BASE], data, len);
+}
+
+void HostFlash_FailProgramAt(uint32_t addr)
+{
+    s_fail_addr = addr;
+}
+
+void HostFlash_GetStats(HostFlash_Stats_t *out)
+{
+    if (out != NULL) *out = s_stats;
+}
+
+/* ===== HAL ===== */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    prvInit();
+    s_unlocked = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    s_unlocked = 0;
+    return HAL_OK;
+}
+
+uint32_t HAL_FLASH_GetError(void)
+{
+    return s_error;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    static const uint32_t width[4] = { 1u, 2u, 4u, 8u };
+    uint32_t n = (TypeProgram < 4u) ? width[TypeProgram] : 0u;
+
+    prvInit();
+    s_error = HAL_FLASH_ERROR_NONE;
+    if (!s_unlocked) {
+        s_error = HAL_FLASH_ERROR_WRP;
+    } else if (n == 0u || (Address & (n - 1u)) != 0u || HostFlash_Ptr(Address) == NULL ||
+               Address - HOST_FLASH_BASE + n > HOST_FLASH_SIZE) {
+        s_error = HAL_FLASH_ERROR_PGS;
+    } else if (s_fail_addr != 0u && s_fail_addr >= Address && s_fail_addr < Address + n) {
+        s_fail_addr = 0;
+        s_error = HAL_FLASH_ERROR_PGP;
+    }
+    s_stats.busy_us += HOST_FLASH_PROG_US;
+    HostSim_Advance(HOST_FLASH_PROG_US);
+    if (s_error != HAL_FLASH_ERROR_NONE) {
+        s_stats.errors++;
+        return HAL_ERROR;
+    }
+
+    uint8_t *p = &s_mem[Address - HOST_FLASH_BASE];
+    for (uint32_t i = 0; i < n; i++) p[i] &= (uint8_t)(Data >> (8u * i));      // little-endian
+    s_stats.programs++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+    prvInit();
+    *SectorError = 0xFFFFFFFFU;
+    s_error = HAL_FLASH_ERROR_NONE;
+    for (uint32_t s = pEraseInit->Sector; s < pEraseInit->Sector + pEraseInit->NbSectors; s++) {
+        if (!s_unlocked || s >= HOST_FLASH_SECTORS) {
+            s_error = s_unlocked ? HAL_FLASH_ERROR_PGS : HAL_FLASH_ERROR_WRP;
+            s_stats.errors++;
+            *SectorError = s;
+            return HAL_ERROR;
+        }
+        uint32_t off, size, us;
+        prvSector(s, &off, &size, &us);
+        s_stats.busy_us += us;
+        HostSim_Advance(us);
+        memset(&s_mem[off], 0xFF, size);
+        s_stats.erases++;
+    }
+    return HAL_OK;
+}
@@ -0,0 +1,174 @@
+/*
+ * host_hal.c  (Host build)
+ *
+ *  가짜 HAL 공통부: 페리페럴 인스턴스, tick, GPIO, NVIC.
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+/* ===== Peripheral 인스턴스 ===== */
+GPIO_TypeDef  HostPeriph_GPIOA = { .id = 0 }, HostPeriph_GPIOB = { .id = 1 },
+              HostPeriph_GPIOC = { .id = 2 }, HostPeriph_GPIOD = { .id = 3 },
+              HostPeriph_GPIOE = { .id = 4 }, HostPeriph_GPIOF = { .id = 5 },
+              HostPeriph_GPIOG = { .id = 6 }, HostPeriph_GPIOH = { .id = 7 };
+I2C_TypeDef   HostPeriph_I2C1 = { 1 }, HostPeriph_I2C2 = { 2 }, HostPeriph_I2C3 = { 3 };
+SPI_TypeDef   HostPeriph_SPI1 = { 1 }, HostPeriph_SPI2 = { 2 }, HostPeriph_SPI3 = { 3 };
+CAN_TypeDef   HostPeriph_CAN1 = { 1 }, HostPeriph_CAN2 = { 2 };
+USART_TypeDef HostPeriph_USART1 = { 1 }, HostPeriph_USART2 = { 2 },
+              HostPeriph_USART3 = { 3 }, HostPeriph_UART4 = { 4 };
+ADC_TypeDef   HostPeriph_ADC1 = { 1 };
+TIM_TypeDef   HostPeriph_TIM2 = { 2 }, HostPeriph_TIM3 = { 3 };
+SysTick_Type  HostPeriph_SysTick;
+CoreDebug_Type HostPeriph_CoreDebug;
+MPU_Type       HostPeriph_MPU = { .TYPE = 8u << 8 };     /* DREGION = 8 */
+static DWT_Type s_dwt;
+
+/* SystemClock_Config(): HSI 16MHz, AHB/APB1/APB2 DIV1 (런타임 변경은 host_rcc.c) */
+uint32_t SystemCoreClock = 16000000U;
+
+/* CYCCNT 는 마지막 읽기 이후 경과 시간 * 현재 클럭만큼 누적 (클럭 변경 구간 보존) */
+static uint64_t s_dwt_last_us;
+
+DWT_Type *HostSim_DWT(void)
+{
+    uint64_t now = HostSim_NowUs();
+    if ((s_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) && (HostPeriph_CoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk)) {
+        s_dwt.CYCCNT += (uint32_t)((now - s_dwt_last_us) * (SystemCoreClock / 1000000u));
+    }
+    s_dwt_last_us = now;
+    return &s_dwt;
+}
+
+/* ===== MPU: Mpu.c 가 쓰는 3 쌍 (RBAR VALID + region 번호) 만 해석 ===== */
+int HostMPU_CanWrite(const volatile void *addr)
+{
+    const volatile uint32_t *pair = &HostPeriph_MPU.RBAR;
+    uint32_t a = (uint32_t)(uintptr_t)addr;
+    int best = -1, writable = 1;
+
+    if (!(HostPeriph_MPU.CTRL & MPU_CTRL_ENABLE_Msk)) return 1;
+    for (uint32_t i = 0; i < 3u; i++) {
+        uint32_t rbar = pair[2u * i], rasr = pair[2u * i + 1u];
+        uint32_t size = 1u << (((rasr & MPU_RASR_SIZE_Msk) >> MPU_RASR_SIZE_Pos) + 1u);
+        uint32_t base = rbar & MPU_RBAR_ADDR_Msk & ~(size - 1u);
+        int region = (int)(rbar & MPU_RBAR_REGION_Msk);
+
+        if (!(rbar & MPU_RBAR_VALID_Msk) || !(rasr & MPU_RASR_ENABLE_Msk)) continue;
+        if (a < base || a - base >= size || region < best) continue;
+        if (size >= 256u && ((rasr >> MPU_RASR_SRD_Pos) >> ((a - base) / (size / 8u)) & 1u)) continue;
+        uint32_t ap = (rasr & MPU_RASR_AP_Msk) >> MPU_RASR_AP_Pos;
+        best = region;
+        writable = (ap == 1u || ap == 2u || ap == 3u);
+    }
+    return writable;      /* 해당 region 없음: PRIVDEFENA 기본 맵 */
+}
+
+void HostSim_CpuCycles(uint32_t cycles)
+{
+    uint64_t us = ((uint64_t)cycles * 1000000u + SystemCoreClock - 1u) / SystemCoreClock;
+    HostSim_Advance((uint32_t)us);
+}
+
+/* ===== Core ===== */
+HAL_StatusTypeDef HAL_Init(void)
+{
+    HostPeriph_SysTick.LOAD = (SystemCoreClock / 1000U) - 1U;
+    return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(HostSim_NowUs() / 1000u);
+}
+
+void HAL_IncTick(void)
+{
+    /* tick 은 가상 시간에서 파생 */
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    /* 실제 HAL 과 같이 최소 1 tick 대기를 보장 */
+    uint32_t wait = (Delay < HAL_MAX_DELAY) ? Delay + 1U : Delay;
+    uint32_t tickstart = HAL_GetTick();
+    while ((HAL_GetTick() - tickstart) < wait) {
+        HostSim_Advance(1000u - (uint32_t)(HostSim_NowUs() % 1000u));
+    }
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void)IRQn; (void)PreemptPriority; (void)SubPriority;
+}
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)  { (void)IRQn; }
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+/* ===== GPIO ===== */
+#define HOST_GPIO_MAX_LISTENERS  16u
+
+typedef struct
+{
+    GPIO_TypeDef        *port;
+    uint16_t             mask;
+    HostGPIO_ListenerFn  fn;
+    void                *ctx;
+} HostGPIO_Listener_t;
+
+static HostGPIO_Listener_t s_gpio_listeners[HOST_GPIO_MAX_LISTENERS];
+
+int HostGPIO_AddListener(GPIO_TypeDef *port, uint16_t pinMask, HostGPIO_ListenerFn fn, void *ctx)
+{
+    for (uint32_t i = 0; i < HOST_GPIO_MAX_LISTENERS; i++) {
+        if (s_gpio_listeners[i].fn == NULL) {
+            s_gpio_listeners[i] = (HostGPIO_Listener_t){ port, pinMask, fn, ctx };
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void HostGPIO_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    if (state == GPIO_PIN_SET) port->IDR |= pin;
+    else                       port->IDR &= ~(uint32_t)pin;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx; (void)GPIO_Init;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->IDR | GPIOx->ODR) & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    uint32_t before = GPIOx->ODR;
+
+    if (PinState != GPIO_PIN_RESET) GPIOx->ODR |= GPIO_Pin;
+    else                             GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+
+    uint32_t changed = (before ^ GPIOx->ODR) & 0xFFFFu;
+    if (changed == 0u) return;
+
+    for (uint32_t i = 0; i < HOST_GPIO_MAX_LISTENERS; i++) {
+        HostGPIO_Listener_t *l = &s_gpio_listeners[i];
+        if (l->fn == NULL || l->port != GPIOx) continue;
+        uint16_t hit = (uint16_t)(changed & l->mask);
+        for (uint16_t bit = 1; hit != 0u; bit <<= 1) {
+            if (hit & bit) {
+                l->fn(l->ctx, GPIOx, bit, (GPIOx->ODR & bit) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+                hit &= (uint16_t)~bit;
+            }
+        }
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    HAL_GPIO_WritePin(GPIOx, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
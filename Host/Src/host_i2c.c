@@ -0,0 +1,266 @@
+/*
+ * host_i2c.c  (Host build)
+ *
+ *  가짜 HAL I2C: 트랜잭션 레벨 버스 모델.
+ *  버스 시간 = 비트 수 / ClockSpeed. 1바이트 = 8bit + ACK, START/Sr/STOP 는 각 1bit 로 근사.
+ *  DMA 전송은 버스 시간 뒤 이벤트로 완료되며 HAL_I2C_Mem*CpltCallback 을 ISR 문맥에서 호출.
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+#define HOST_I2C_MAX_DEVICES   8u
+#define HOST_I2C_MAX_XFER     64u
+
+typedef struct
+{
+    I2C_TypeDef      *bus;
+    HostI2C_Device_t  devs[HOST_I2C_MAX_DEVICES];
+    uint32_t          ndev;
+    HostI2C_Stats_t   stats;
+    int               stall;
+} HostI2C_Bus_t;
+
+static HostI2C_Bus_t s_buses[3] = {
+    { .bus = &HostPeriph_I2C1 }, { .bus = &HostPeriph_I2C2 }, { .bus = &HostPeriph_I2C3 },
+};
+
+static void prvDmaComplete(void *arg);
+
+static HostI2C_Bus_t *prvBus(I2C_TypeDef *inst)
+{
+    for (uint32_t i = 0; i < 3u; i++) {
+        if (s_buses[i].bus == inst) return &s_buses[i];
+    }
+    return NULL;
+}
+
+static HostI2C_Device_t *prvFind(HostI2C_Bus_t *b, uint16_t devAddress8)
+{
+    uint8_t addr7 = (uint8_t)((devAddress8 >> 1) & 0x7Fu);
+    for (uint32_t i = 0; i < b->ndev; i++) {
+        if (b->devs[i].addr7 == addr7) return &b->devs[i];
+    }
+    return NULL;
+}
+
+int HostI2C_Attach(I2C_TypeDef *bus, const HostI2C_Device_t *dev)
+{
+    HostI2C_Bus_t *b = prvBus(bus);
+    if (b == NULL || b->ndev >= HOST_I2C_MAX_DEVICES) return -1;
+    b->devs[b->ndev++] = *dev;
+    return 0;
+}
+
+void HostI2C_GetStats(I2C_TypeDef *bus, HostI2C_Stats_t *out)
+{
+    HostI2C_Bus_t *b = prvBus(bus);
+    if (b != NULL && out != NULL) *out = b->stats;
+}
+
+void HostI2C_ResetStats(I2C_TypeDef *bus)
+{
+    HostI2C_Bus_t *b = prvBus(bus);
+    if (b != NULL) memset(&b->stats, 0, sizeof(b->stats));
+}
+
+void HostI2C_SetStall(I2C_TypeDef *bus, int stall)
+{
+    HostI2C_Bus_t *b = prvBus(bus);
+    if (b != NULL) b->stall = stall;
+}
+
+static uint32_t prvBitsToUs(I2C_HandleTypeDef *hi2c, uint32_t bits)
+{
+    uint32_t hz = (hi2c->Init.ClockSpeed != 0u) ? hi2c->Init.ClockSpeed : 100000u;
+    return (uint32_t)(((uint64_t)bits * 1000000u + hz - 1u) / hz);
+}
+
+/* ===== 트랜잭션 실행 (버스 시간은 호출자가 소모) =====
+ * memAddSize==0 : 레지스터 주소 없이 write(pData) 또는 read(pData)
+ * 반환: 소모 비트 수, *nak 에 NAK 여부 */
+static uint32_t prvRunMem(I2C_HandleTypeDef *hi2c, uint16_t devAddress, uint16_t memAddress,
+                          uint16_t memAddSize, uint8_t *pData, uint16_t size, int isRead, int *nak)
+{
+    HostI2C_Bus_t *b = prvBus(hi2c->Instance);
+    HostI2C_Device_t *d = (b != NULL) ? prvFind(b, devAddress) : NULL;
+    uint8_t abytes = (memAddSize == I2C_MEMADD_SIZE_16BIT) ? 2u : (memAddSize == I2C_MEMADD_SIZE_8BIT ? 1u : 0u);
+    uint8_t frame[HOST_I2C_MAX_XFER + 2u];
+    uint32_t bits;
+
+    *nak = 0;
+    if (b == NULL) { *nak = 1; return 0; }
+
+    b->stats.transactions++;
+    if (d == NULL) {
+        /* 주소 바이트에서 NAK 후 STOP */
+        b->stats.naks++;
+        *nak = 1;
+        return 1u + 9u + 1u;
+    }
+
+    if (abytes == 2u) { frame[0] = (uint8_t)(memAddress >> 8); frame[1] = (uint8_t)memAddress; }
+    else if (abytes == 1u) { frame[0] = (uint8_t)memAddress; }
+
+    if (isRead) {
+        bits = 1u + 9u + 1u + 9u + 9u * size + 1u;      /* S addr+R data.. P */
+        if (abytes) {
+            bits += 9u + 9u * abytes;                    /* S addr+W mem Sr */
+            b->stats.transactions++;
+            if (d->write(d->ctx, frame, abytes) < 0) { b->stats.naks++; *nak = 1; return 1u + 9u + 9u + 1u; }
+        }
+        if (d->read(d->ctx, pData, size) < 0) { b->stats.naks++; *nak = 1; }
+    } else {
+        if (size > HOST_I2C_MAX_XFER) size = HOST_I2C_MAX_XFER;
+        memcpy(&frame[abytes], pData, size);
+        bits = 1u + 9u + 9u * (abytes + size) + 1u;
+        if (d->write(d->ctx, frame, (uint16_t)(abytes + size)) < 0) { b->stats.naks++; *nak = 1; }
+    }
+    b->stats.bytes += size + abytes;
+    return bits;
+}
+
+static HAL_StatusTypeDef prvBlocking(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                     uint16_t MemAddSize, uint8_t *pData, uint16_t Size, int isRead)
+{
+    HostI2C_Bus_t *b;
+    int nak;
+    uint32_t us;
+
+    if (hi2c == NULL || pData == NULL || Size == 0u) return HAL_ERROR;
+    if (hi2c->State != HAL_I2C_STATE_READY) return HAL_BUSY;
+
+    hi2c->State = isRead ? HAL_I2C_STATE_BUSY_RX : HAL_I2C_STATE_BUSY_TX;
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+
+    us = prvBitsToUs(hi2c, prvRunMem(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, isRead, &nak));
+    b = prvBus(hi2c->Instance);
+    if (b != NULL) b->stats.busy_us += us;
+    HostSim_Advance(us);
+
+    hi2c->State = HAL_I2C_STATE_READY;
+    if (nak) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c == NULL || prvBus(hi2c->Instance) == NULL) return HAL_ERROR;
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c == NULL) return HAL_ERROR;
+    (void)HostSim_Cancel(prvDmaComplete, hi2c);     /* MspDeInit 의 HAL_DMA_DeInit: 진행 중 전송 중단 */
+    hi2c->State = HAL_I2C_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    return prvBlocking(hi2c, DevAddress, 0u, 0u, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    return prvBlocking(hi2c, DevAddress, 0u, 0u, pData, Size, 1);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    return prvBlocking(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    return prvBlocking(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 1);
+}
+
+/* ===== DMA: 버스 시간 뒤 완료 이벤트에서 실제 데이터 이동 ===== */
+static void prvDmaComplete(void *arg)
+{
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef *)arg;
+    int isRead = (hi2c->State == HAL_I2C_STATE_BUSY_RX);
+    int nak;
+
+    (void)prvRunMem(hi2c, (uint16_t)hi2c->Devaddress, (uint16_t)hi2c->Memaddress,
+                    (uint16_t)hi2c->MemaddSize, hi2c->pBuffPtr, hi2c->XferSize, isRead, &nak);
+    hi2c->XferCount = 0u;
+    hi2c->State = HAL_I2C_STATE_READY;
+
+    if (nak) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        HAL_I2C_ErrorCallback(hi2c);
+    } else if (isRead) {
+        HAL_I2C_MemRxCpltCallback(hi2c);
+    } else {
+        HAL_I2C_MemTxCpltCallback(hi2c);
+    }
+}
+
+static HAL_StatusTypeDef prvStartDma(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                     uint16_t MemAddSize, uint8_t *pData, uint16_t Size, int isRead)
+{
+    HostI2C_Bus_t *b;
+    uint8_t abytes = (MemAddSize == I2C_MEMADD_SIZE_16BIT) ? 2u : 1u;
+    uint32_t bits, us;
+
+    if (hi2c == NULL || pData == NULL || Size == 0u) return HAL_ERROR;
+    if (hi2c->State != HAL_I2C_STATE_READY) return HAL_BUSY;
+
+    hi2c->State      = isRead ? HAL_I2C_STATE_BUSY_RX : HAL_I2C_STATE_BUSY_TX;
+    hi2c->ErrorCode  = HAL_I2C_ERROR_NONE;
+    hi2c->Devaddress = DevAddress;
+    hi2c->Memaddress = MemAddress;
+    hi2c->MemaddSize = MemAddSize;
+    hi2c->pBuffPtr   = pData;
+    hi2c->XferSize   = Size;
+    hi2c->XferCount  = Size;
+
+    bits = isRead ? (1u + 9u + 9u * abytes + 1u + 9u + 9u * Size + 1u)
+                  : (1u + 9u + 9u * (abytes + Size) + 1u);
+    us = prvBitsToUs(hi2c, bits);
+    b = prvBus(hi2c->Instance);
+    if (b != NULL) b->stats.busy_us += us;
+
+    if (b == NULL || !b->stall) HostSim_Schedule(us, prvDmaComplete, hi2c);
+    HostSim_Advance(1u);    /* 레지스터 설정 비용 */
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+    return prvStartDma(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+    return prvStartDma(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 1);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+    HostI2C_Bus_t *b = (hi2c != NULL) ? prvBus(hi2c->Instance) : NULL;
+    (void)Trials; (void)Timeout;
+    if (b == NULL) return HAL_ERROR;
+    HostSim_Advance(prvBitsToUs(hi2c, 1u + 9u + 1u));
+    return (prvFind(b, DevAddress) != NULL) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c) { return hi2c->State; }
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c)           { return hi2c->ErrorCode; }
+
+__weak void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) { UNUSED(hi2c); }
+__weak void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) { UNUSED(hi2c); }
+__weak void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)     { UNUSED(hi2c); }
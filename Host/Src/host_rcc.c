@@ -0,0 +1,150 @@
+/*
+ * host_rcc.c  (Host build)
+ *
+ *  가짜 HAL RCC: HSI 16MHz + 주 PLL, AHB/APB 분주, FLASH latency.
+ *  - 실제 HAL 과 같이 SYSCLK 로 사용 중인 PLL 은 재설정 불가 (HAL_ERROR)
+ *  - PLL lock 시간만큼 가상 시간 소모
+ *  - HCLK 에 비해 latency 가 부족하면 거부 (타깃에서는 hard fault 성 오동작)
+ */
+
+#include "host_sim.h"
+
+#define HOST_HSI_HZ         16000000u
+#define HOST_PLL_LOCK_US    100u
+
+static struct
+{
+    int      pll_on;
+    uint32_t pll_hz;
+    uint32_t sysclk_src;
+    uint32_t ahb_div, apb1_div, apb2_div;     /* RCC_*_DIVx 값 */
+    uint32_t latency;
+    HostRCC_ListenerFn listener;
+    void    *listener_ctx;
+    HostRCC_Stats_t stats;
+} s_rcc = { .sysclk_src = RCC_SYSCLKSOURCE_HSI };
+
+static uint32_t prvApbShift(uint32_t div)
+{
+    /* RCC_HCLK_DIV1/2/4/8/16 → 0..4 */
+    return (div & 0x1000u) ? (((div >> 10) & 0x3u) + 1u) : 0u;
+}
+
+static uint32_t prvSysclk(void)
+{
+    return (s_rcc.sysclk_src == RCC_SYSCLKSOURCE_PLLCLK) ? s_rcc.pll_hz : HOST_HSI_HZ;
+}
+
+/* F413 (2.7~3.6V): 0WS ≤25MHz, 1WS ≤50, 2WS ≤75, 3WS ≤100 */
+static uint32_t prvMinLatency(uint32_t hclk)
+{
+    if (hclk <= 25000000u) return FLASH_LATENCY_0;
+    if (hclk <= 50000000u) return FLASH_LATENCY_1;
+    if (hclk <= 75000000u) return FLASH_LATENCY_2;
+    return FLASH_LATENCY_3;
+}
+
+uint32_t HostSim_PCLK1(void) { return SystemCoreClock >> prvApbShift(s_rcc.apb1_div); }
+uint32_t HostSim_PCLK2(void) { return SystemCoreClock >> prvApbShift(s_rcc.apb2_div); }
+
+uint32_t HostSim_TIMCLK1(void)
+{
+    uint32_t p = HostSim_PCLK1();
+    return (s_rcc.apb1_div == RCC_HCLK_DIV1) ? p : 2u * p;
+}
+
+void HostRCC_SetListener(HostRCC_ListenerFn fn, void *ctx)
+{
+    s_rcc.listener = fn;
+    s_rcc.listener_ctx = ctx;
+}
+
+void HostRCC_GetStats(HostRCC_Stats_t *out)
+{
+    if (out != NULL) *out = s_rcc.stats;
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    RCC_PLLInitTypeDef *pll;
+
+    if (RCC_OscInitStruct == NULL) return HAL_ERROR;
+    if ((RCC_OscInitStruct->OscillatorType & RCC_OSCILLATORTYPE_HSI) && RCC_OscInitStruct->HSIState != RCC_HSI_ON) {
+        /* HSI 가 SYSCLK/PLL 소스인 보드: 끌 수 없음 */
+        return HAL_ERROR;
+    }
+
+    pll = &RCC_OscInitStruct->PLL;
+    if (pll->PLLState == RCC_PLL_NONE) return HAL_OK;
+    if (s_rcc.sysclk_src == RCC_SYSCLKSOURCE_PLLCLK) return HAL_ERROR;   /* 사용 중인 PLL */
+
+    if (pll->PLLState == RCC_PLL_OFF) {
+        s_rcc.pll_on = 0;
+        return HAL_OK;
+    }
+
+    /* VCO 입력 0.95~2.1MHz, VCO 출력 100~432MHz, P ∈ {2,4,6,8} */
+    if (pll->PLLSource != RCC_PLLSOURCE_HSI || pll->PLLM < 2u || pll->PLLM > 63u) return HAL_ERROR;
+    uint32_t vin = HOST_HSI_HZ / pll->PLLM;
+    uint64_t vco = (uint64_t)vin * pll->PLLN;
+    if (vin < 950000u || vin > 2100000u || vco < 100000000ull || vco > 432000000ull) return HAL_ERROR;
+    if (pll->PLLP != 2u && pll->PLLP != 4u && pll->PLLP != 6u && pll->PLLP != 8u) return HAL_ERROR;
+    if (pll->PLLQ < 2u || pll->PLLQ > 15u || pll->PLLR < 2u || pll->PLLR > 7u) return HAL_ERROR;
+
+    s_rcc.pll_hz = (uint32_t)(vco / pll->PLLP);
+    s_rcc.pll_on = 1;
+    s_rcc.stats.pll_locks++;
+    HostSim_Advance(HOST_PLL_LOCK_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    uint32_t src, ahb, hclk, old;
+
+    if (RCC_ClkInitStruct == NULL) return HAL_ERROR;
+
+    src = (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_SYSCLK) ? RCC_ClkInitStruct->SYSCLKSource : s_rcc.sysclk_src;
+    ahb = (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_HCLK) ? RCC_ClkInitStruct->AHBCLKDivider : s_rcc.ahb_div;
+    if (src == RCC_SYSCLKSOURCE_PLLCLK && !s_rcc.pll_on) return HAL_ERROR;
+    if (ahb != RCC_SYSCLK_DIV1) return HAL_ERROR;          /* AHB 분주는 모델링하지 않음 */
+
+    hclk = (src == RCC_SYSCLKSOURCE_PLLCLK) ? s_rcc.pll_hz : HOST_HSI_HZ;
+    if (FLatency < prvMinLatency(hclk)) {
+        s_rcc.stats.latency_errors++;
+        return HAL_ERROR;
+    }
+
+    (void)HostSim_DWT();            /* 이전 클럭 구간 CYCCNT 누적 */
+    old = SystemCoreClock;
+    s_rcc.latency = FLatency;
+    s_rcc.sysclk_src = src;
+    s_rcc.ahb_div = ahb;
+    if (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_PCLK1) s_rcc.apb1_div = RCC_ClkInitStruct->APB1CLKDivider;
+    if (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_PCLK2) s_rcc.apb2_div = RCC_ClkInitStruct->APB2CLKDivider;
+    SystemCoreClock = prvSysclk();
+
+    /* HAL_InitTick(): SysTick 1ms 재설정 (FreeRTOS tick 도 같은 SysTick) */
+    HostPeriph_SysTick.LOAD = (SystemCoreClock / 1000U) - 1U;
+
+    if (SystemCoreClock != old) {
+        s_rcc.stats.switches++;
+        if (s_rcc.listener != NULL) s_rcc.listener(s_rcc.listener_ctx, SystemCoreClock);
+    }
+    return HAL_OK;
+}
+
+void HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t *pFLatency)
+{
+    RCC_ClkInitStruct->ClockType      = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    RCC_ClkInitStruct->SYSCLKSource   = s_rcc.sysclk_src;
+    RCC_ClkInitStruct->AHBCLKDivider  = s_rcc.ahb_div;
+    RCC_ClkInitStruct->APB1CLKDivider = s_rcc.apb1_div;
+    RCC_ClkInitStruct->APB2CLKDivider = s_rcc.apb2_div;
+    *pFLatency = s_rcc.latency;
+}
+
+uint32_t HAL_RCC_GetSysClockFreq(void) { return prvSysclk(); }
+uint32_t HAL_RCC_GetHCLKFreq(void)     { return SystemCoreClock; }
+uint32_t HAL_RCC_GetPCLK1Freq(void)    { return HostSim_PCLK1(); }
+uint32_t HAL_RCC_GetPCLK2Freq(void)    { return HostSim_PCLK2(); }
@@ -0,0 +1,486 @@
+/*
+ * host_replay.c  (Host build)
+ *
+ *  BusRec 기록 재생 (host_replay.h 참조)
+ *  자극은 시각순 이벤트 표 하나로 만들고, 이벤트 큐에는 다음 시각 1 개만 걸어 둔다 (HOST_SIM_MAX_EVENTS).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_replay.h"
+#include "host_board.h"
+#include "host_sim.h"
+
+/* ===== 덤프 파싱 ===== */
+
+static const char *prvFind(const char *hay, size_t n, const char *needle)
+{
+    size_t k = strlen(needle);
+    for (size_t i = 0; i + k <= n; i++) {
+        if (memcmp(&hay[i], needle, k) == 0) return &hay[i];
+    }
+    return NULL;
+}
+
+static int prvHex(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static int prvPush(HostReplay_Log_t *log, const HostReplay_Rec_t *r)
+{
+    if (log->n == log->cap) {
+        uint32_t cap = (log->cap == 0u) ? 256u : log->cap * 2u;
+        HostReplay_Rec_t *p = realloc(log->rec, cap * sizeof(*p));
+        if (p == NULL) return -1;
+        log->rec = p;
+        log->cap = cap;
+    }
+    log->rec[log->n++] = *r;
+    return 0;
+}
+
+/* B <cyc> <mhz> <bus> <op> <id> <len> <hex|->
+ * 시각: 첫 레코드는 cyc / mhz, 이후는 직전 레코드와의 부호 있는 cycle 차 / 그 레코드의 mhz
+ * (선점으로 이웃과 순서가 약간 뒤바뀐 항목, DVFS 전환, CYCCNT wrap 모두 처리) */
+static int prvParseLine(char *line, HostReplay_Rec_t *r, uint32_t *cyc, uint32_t *mhz)
+{
+    char *p = line + 2;
+    unsigned long v[6];
+    const int base[6] = { 10, 10, 10, 10, 16, 10 };
+
+    for (uint32_t i = 0; i < 6u; i++) {
+        char *e;
+        v[i] = strtoul(p, &e, base[i]);
+        if (e == p || *e != ' ') return -1;
+        p = e + 1;
+    }
+    if (v[1] == 0u || v[3] == BUSREC_OP_CONT || v[3] > BUSREC_OP_WR) return -1;
+
+    memset(r, 0, sizeof(*r));
+    *cyc   = (uint32_t)v[0];
+    *mhz   = (uint32_t)v[1];
+    r->bus = (uint8_t)v[2];
+    r->op  = (uint8_t)v[3];
+    r->id  = (uint32_t)v[4];
+    r->len = (uint16_t)v[5];
+    if (strncmp(p, "-", 1) == 0) return 0;
+    while (r->n < BUSREC_MAX_DATA) {
+        int hi = prvHex(p[0]), lo = (hi < 0) ? -1 : prvHex(p[1]);
+        if (hi < 0 || lo < 0) break;
+        r->data[r->n++] = (uint8_t)((hi << 4) | lo);
+        p += 2;
+    }
+    return 0;
+}
+
+int HostReplay_Parse(const char *text, size_t len, HostReplay_Log_t *log)
+{
+    const char *start = prvFind(text, len, "BUSREC v=");
+    unsigned ver = 0;
+    unsigned long n = 0, dropped = 0;
+    int done = 0;
+
+    memset(log, 0, sizeof(*log));
+    if (start == NULL) return -1;
+
+    size_t rest = len - (size_t)(start - text);
+    char *buf = malloc(rest + 1u);
+    if (buf == NULL) return -1;
+    memcpy(buf, start, rest);
+    buf[rest] = '\0';
+
+    char *save = NULL;
+    char *line = strtok_r(buf, "\r\n", &save);
+    if (line == NULL || sscanf(line, "BUSREC v=%u n=%lu dropped=%lu", &ver, &n, &dropped) != 3 ||
+        ver != BUSREC_FORMAT_VERSION) {
+        free(buf);
+        return -1;
+    }
+    log->dropped = (uint32_t)dropped;
+
+    int64_t  t_ns = 0;
+    uint32_t prev = 0;
+    while ((line = strtok_r(NULL, "\r\n", &save)) != NULL) {
+        HostReplay_Rec_t r;
+        uint32_t cyc, mhz;
+
+        if (strcmp(line, "E") == 0) { done = 1; break; }
+        if (line[0] != 'B' || line[1] != ' ' || prvParseLine(line, &r, &cyc, &mhz) != 0) continue;
+        if (log->n == 0u) t_ns = (int64_t)cyc * 1000 / mhz;
+        else              t_ns += (int64_t)(int32_t)(cyc - prev) * 1000 / mhz;
+        prev = cyc;
+        r.t_us = (t_ns > 0) ? (uint64_t)t_ns / 1000u : 0u;
+        if (prvPush(log, &r) != 0) break;
+    }
+    free(buf);
+    if (!done) {
+        HostReplay_Free(log);
+        return -1;
+    }
+    return 0;
+}
+
+void HostReplay_Free(HostReplay_Log_t *log)
+{
+    free(log->rec);
+    memset(log, 0, sizeof(*log));
+}
+
+/* ===== 재생 ===== */
+
+typedef enum { EV_CAN = 0, EV_CANFD, EV_REG } prvEvKind_t;
+
+typedef struct
+{
+    uint64_t t_us;
+    uint32_t seq;
+    uint8_t  kind;
+    uint8_t  reg;
+    uint8_t  val;
+    MMP5475_t *pmic;
+    const HostReplay_Rec_t *rec;
+} prvEvent_t;
+
+/* PMIC 레지스터 관측 상태 (g_pmic, g_pmic2) */
+typedef struct
+{
+    uint8_t  written[256];              /* 기록 안에서 펌웨어가 쓴 레지스터 */
+    uint8_t  seen[256];
+    uint8_t  last_v[256];
+    uint64_t last_t[256];
+} prvRegState_t;
+
+static HostReplay_Log_t   s_cap;
+static HostReplay_Stats_t s_stats;
+static prvEvent_t        *s_ev;
+static uint32_t           s_nev, s_evcap, s_next;
+static prvRegState_t      s_regs[2];
+
+int HostReplay_Load(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) return -1;
+    fseek(fp, 0, SEEK_END);
+    long n = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *text = malloc((size_t)n + 1u);
+    int rc = -1;
+    if (text != NULL && n >= 0 && fread(text, 1, (size_t)n, fp) == (size_t)n) {
+        HostReplay_Free(&s_cap);
+        rc = HostReplay_Parse(text, (size_t)n, &s_cap);
+    }
+    free(text);
+    fclose(fp);
+    return rc;
+}
+
+static MMP5475_t *prvPmic(uint8_t bus, uint32_t id, uint32_t *idx)
+{
+    MMP5475_t *m = (bus == BUS_I2C1) ? &g_pmic : (bus == BUS_I2C2) ? &g_pmic2 : NULL;
+    if (m == NULL || ((id >> 9) & 0x7Fu) != m->addr7) return NULL;
+    *idx = (bus == BUS_I2C1) ? 0u : 1u;
+    return m;
+}
+
+/* SPI 디바이스 메모리 (보드 배선: SPI1 EEPROM, SPI2 EEPROM2 + flash) */
+static uint8_t *prvMem(uint8_t bus, uint32_t id, uint32_t *size, uint32_t *idx)
+{
+    uint32_t type = id >> 24;
+    if (bus == BUS_SPI1 && type == BUSDEV_EEPROM)    { *size = M25LC256_SIZE; *idx = 0u; return g_eeprom.mem; }
+    if (bus == BUS_SPI2 && type == BUSDEV_EEPROM)    { *size = M25LC256_SIZE; *idx = 1u; return g_eeprom2.mem; }
+    if (bus == BUS_SPI2 && type == BUSDEV_SPI_FLASH) { *size = W25Q_SIZE;     *idx = 2u; return g_flash.mem; }
+    return NULL;
+}
+
+static int prvAddEvent(const prvEvent_t *ev)
+{
+    if (s_nev == s_evcap) {
+        uint32_t cap = (s_evcap == 0u) ? 256u : s_evcap * 2u;
+        prvEvent_t *p = realloc(s_ev, cap * sizeof(*p));
+        if (p == NULL) return -1;
+        s_ev = p;
+        s_evcap = cap;
+    }
+    s_ev[s_nev] = *ev;
+    s_ev[s_nev].seq = s_nev;
+    s_nev++;
+    return 0;
+}
+
+static int prvEvCmp(const void *a, const void *b)
+{
+    const prvEvent_t *x = a, *y = b;
+    if (x->t_us != y->t_us) return (x->t_us < y->t_us) ? -1 : 1;
+    return (x->seq < y->seq) ? -1 : (x->seq > y->seq);
+}
+
+static const HostReplay_Rec_t *s_sortBase;
+
+static int prvRecCmp(const void *a, const void *b)
+{
+    uint32_t i = *(const uint32_t *)a, j = *(const uint32_t *)b;
+    if (s_sortBase[i].t_us != s_sortBase[j].t_us) return (s_sortBase[i].t_us < s_sortBase[j].t_us) ? -1 : 1;
+    return (i < j) ? -1 : (i > j);
+}
+
+static void prvCanEvent(const HostReplay_Rec_t *r)
+{
+    HostCAN_Frame_t f;
+    prvEvent_t ev;
+    int fd = (r->id & BUSREC_CAN_FD) != 0u;
+
+    if ((r->id & BUSREC_CAN_EXT) != 0u || (!fd && r->len > 8u) || r->n < r->len) {
+        s_stats.skipped++;
+        return;
+    }
+    memset(&f, 0, sizeof(f));
+    f.id  = r->id & 0x7FFu;
+    f.dlc = (uint8_t)r->len;
+    f.fd  = (uint8_t)fd;
+    f.brs = (uint8_t)fd;
+    uint32_t us = HostCAN_FrameTimeUs(CAN1, &f);
+
+    memset(&ev, 0, sizeof(ev));
+    ev.t_us = (r->t_us > us) ? r->t_us - us : 0u;       /* 수신 ISR 시각 = 프레임 끝 */
+    ev.kind = fd ? EV_CANFD : EV_CAN;
+    ev.rec  = r;
+    if (prvAddEvent(&ev) == 0) s_stats.can_rx++;
+}
+
+/* sample-and-hold: 이 관측값은 직전 관측 직후부터 유효했다고 본다 */
+static void prvRegRead(const HostReplay_Rec_t *r)
+{
+    uint32_t idx;
+    MMP5475_t *m = prvPmic(r->bus, r->id, &idx);
+    prvRegState_t *st = &s_regs[idx];
+
+    if (m == NULL) { s_stats.skipped++; return; }
+    for (uint32_t k = 0; k < r->n; k++) {
+        uint8_t reg = (uint8_t)(r->id + k);
+        uint8_t v = r->data[k];
+        if (st->written[reg]) continue;
+        if (!st->seen[reg]) {
+            if (MMP5475_GetReg(m, reg) != v) {
+                MMP5475_SetReg(m, reg, v);
+                s_stats.seeded++;
+            }
+            st->seen[reg] = 1;
+        } else if (v != st->last_v[reg]) {
+            prvEvent_t ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.t_us = st->last_t[reg] + 1u;
+            ev.kind = EV_REG;
+            ev.pmic = m;
+            ev.reg  = reg;
+            ev.val  = v;
+            if (prvAddEvent(&ev) == 0) s_stats.reg_updates++;
+        }
+        st->last_v[reg] = v;
+        st->last_t[reg] = r->t_us;
+    }
+}
+
+static void prvApply(const prvEvent_t *ev)
+{
+    const HostReplay_Rec_t *r = ev->rec;
+    switch (ev->kind) {
+    case EV_CAN:   (void)HostCAN_Inject(CAN1, r->id & 0x7FFu, r->data, (uint8_t)r->len); break;
+    case EV_CANFD: (void)HostCAN_InjectFd(CAN1, r->id & 0x7FFu, r->data, (uint8_t)r->len); break;
+    default:       MMP5475_SetReg(ev->pmic, ev->reg, ev->val); break;
+    }
+}
+
+static void prvFire(void *arg)
+{
+    uint64_t now = HostSim_NowUs();
+    (void)arg;
+    while (s_next < s_nev && s_ev[s_next].t_us <= now) prvApply(&s_ev[s_next++]);
+    if (s_next < s_nev) (void)HostSim_Schedule((uint32_t)(s_ev[s_next].t_us - now), prvFire, NULL);
+}
+
+int HostReplay_Start(void)
+{
+    uint8_t *done[3] = { NULL, NULL, NULL };
+    uint32_t *order;
+    int rc = 0;
+
+    if (s_cap.n == 0u) return -1;
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(s_regs, 0, sizeof(s_regs));
+    s_nev = 0;
+    s_next = 0;
+    s_stats.records = s_cap.n;
+
+    /* 펌웨어가 쓴 PMIC 레지스터는 기록 전체에서 제외 (모델이 쓰기 결과를 그대로 보여 줌) */
+    for (uint32_t i = 0; i < s_cap.n; i++) {
+        const HostReplay_Rec_t *r = &s_cap.rec[i];
+        uint32_t idx;
+        if (r->op != BUSREC_OP_WR || prvPmic(r->bus, r->id, &idx) == NULL) continue;
+        for (uint32_t k = 0; k < r->len; k++) s_regs[idx].written[(uint8_t)(r->id + k)] = 1;
+    }
+
+    order = malloc(s_cap.n * sizeof(*order));
+    done[0] = calloc(M25LC256_SIZE / 8u, 1);
+    done[1] = calloc(M25LC256_SIZE / 8u, 1);
+    done[2] = calloc(W25Q_SIZE / 8u, 1);
+    if (order == NULL || done[0] == NULL || done[1] == NULL || done[2] == NULL) {
+        rc = -1;
+        goto out;
+    }
+    for (uint32_t i = 0; i < s_cap.n; i++) order[i] = i;
+    s_sortBase = s_cap.rec;
+    qsort(order, s_cap.n, sizeof(*order), prvRecCmp);
+
+    for (uint32_t i = 0; i < s_cap.n; i++) {
+        const HostReplay_Rec_t *r = &s_cap.rec[order[i]];
+        uint32_t size, idx;
+        uint8_t *mem;
+
+        if (r->bus == BUSREC_BUS_CAN1) {
+            if (r->op == BUSREC_OP_RX) prvCanEvent(r);
+            continue;
+        }
+        if (r->bus == BUS_I2C1 || r->bus == BUS_I2C2) {
+            if (r->op == BUSREC_OP_RD) prvRegRead(r);
+            continue;
+        }
+        if ((mem = prvMem(r->bus, r->id, &size, &idx)) == NULL) {
+            s_stats.skipped++;
+            continue;
+        }
+        /* 쓰기/소거 전 읽기만 초기 내용. 같은 주소는 처음 관측값 */
+        uint32_t addr = r->id & 0xFFFFFFu;
+        uint32_t n = (r->op == BUSREC_OP_WR) ? r->len : r->n;
+        for (uint32_t k = 0; k < n && addr + k < size; k++) {
+            uint32_t a = addr + k;
+            if (done[idx][a >> 3] & (1u << (a & 7u))) continue;
+            done[idx][a >> 3] |= (uint8_t)(1u << (a & 7u));
+            if (r->op == BUSREC_OP_RD && mem[a] != r->data[k]) {
+                mem[a] = r->data[k];
+                s_stats.seeded++;
+            }
+        }
+    }
+
+    qsort(s_ev, s_nev, sizeof(*s_ev), prvEvCmp);
+    if (s_nev != 0u) {
+        uint64_t now = HostSim_NowUs();
+        (void)HostSim_Schedule((s_ev[0].t_us > now) ? (uint32_t)(s_ev[0].t_us - now) : 0u, prvFire, NULL);
+    }
+out:
+    free(order);
+    for (uint32_t i = 0; i < 3u; i++) free(done[i]);
+    return rc;
+}
+
+static uint64_t prvEndUs(const HostReplay_Log_t *log)
+{
+    uint64_t t = 0;
+    for (uint32_t i = 0; i < log->n; i++) {
+        if (log->rec[i].t_us > t) t = log->rec[i].t_us;
+    }
+    return t;
+}
+
+uint32_t HostReplay_DurationMs(uint32_t margin_ms)
+{
+    return (uint32_t)((prvEndUs(&s_cap) + 999u) / 1000u) + margin_ms;
+}
+
+void HostReplay_GetStats(HostReplay_Stats_t *out)
+{
+    *out = s_stats;
+}
+
+/* ===== 비교 ===== */
+
+static char  *s_live;
+static size_t s_liveLen, s_liveCap;
+
+static void prvCollect(const char *line)
+{
+    size_t n = strlen(line);
+    if (s_liveLen + n + 1u > s_liveCap) {
+        size_t cap = (s_liveCap == 0u) ? 65536u : s_liveCap * 2u;
+        while (cap < s_liveLen + n + 1u) cap *= 2u;
+        char *p = realloc(s_live, cap);
+        if (p == NULL) return;
+        s_live = p;
+        s_liveCap = cap;
+    }
+    memcpy(&s_live[s_liveLen], line, n + 1u);
+    s_liveLen += n;
+}
+
+static int prvIsOutput(const HostReplay_Rec_t *r, uint8_t bus)
+{
+    return r->bus == bus && (r->op == BUSREC_OP_TX || r->op == BUSREC_OP_WR);
+}
+
+static int prvSame(const HostReplay_Rec_t *a, const HostReplay_Rec_t *b)
+{
+    return a->op == b->op && a->id == b->id && a->len == b->len && a->n == b->n && memcmp(a->data, b->data, a->n) == 0;
+}
+
+uint32_t HostReplay_Compare(void (*write)(const char *line))
+{
+    HostReplay_Log_t live;
+    char line[160];
+    uint32_t bad = 0;
+
+    s_liveLen = 0;
+    BusRec_Dump(prvCollect);
+    if (s_live == NULL || HostReplay_Parse(s_live, s_liveLen, &live) != 0) return BUSREC_BUS_CAN1 + 1u;
+
+    snprintf(line, sizeof(line), "REPLAY v=1 records=%lu can_rx=%lu reg_updates=%lu seeded=%lu skipped=%lu\n",
+             (unsigned long)s_stats.records, (unsigned long)s_stats.can_rx, (unsigned long)s_stats.reg_updates,
+             (unsigned long)s_stats.seeded, (unsigned long)s_stats.skipped);
+    write(line);
+
+    uint64_t t_end = prvEndUs(&s_cap) + HOST_REPLAY_CMP_SLACK_US;
+    for (uint8_t bus = 0; bus <= BUSREC_BUS_CAN1; bus++) {
+        uint32_t rec = 0, out = 0, match = 0, i = 0, j = 0, diverged = 0;
+        uint64_t dt_sum = 0, dt_max = 0;
+
+        /* 순서대로 짝지음: 처음 어긋난 곳에서 멈춤 */
+        for (;;) {
+            while (i < s_cap.n && !prvIsOutput(&s_cap.rec[i], bus)) i++;
+            while (j < live.n && !(prvIsOutput(&live.rec[j], bus) && live.rec[j].t_us <= t_end)) j++;
+            if (i < s_cap.n) rec++;
+            if (j < live.n) out++;
+            if (i >= s_cap.n || j >= live.n) {
+                for (i++; i < s_cap.n; i++) rec += (uint32_t)prvIsOutput(&s_cap.rec[i], bus);
+                for (j++; j < live.n; j++) out += (uint32_t)(prvIsOutput(&live.rec[j], bus) && live.rec[j].t_us <= t_end);
+                break;
+            }
+            if (!diverged && prvSame(&s_cap.rec[i], &live.rec[j])) {
+                uint64_t dt = (live.rec[j].t_us > s_cap.rec[i].t_us) ? live.rec[j].t_us - s_cap.rec[i].t_us
+                                                                     : s_cap.rec[i].t_us - live.rec[j].t_us;
+                match++;
+                dt_sum += dt;
+                if (dt > dt_max) dt_max = dt;
+            } else {
+                diverged = 1;
+            }
+            i++;
+            j++;
+        }
+        if (rec == 0u && out == 0u) continue;
+        if (match < rec) bad++;
+
+        snprintf(line, sizeof(line), "CMP bus=%u rec=%lu out=%lu match=%lu first_diff=%ld dt_mean_us=%lu dt_max_us=%lu\n",
+                 (unsigned)bus, (unsigned long)rec, (unsigned long)out, (unsigned long)match,
+                 (match < rec) ? (long)match : -1L, (unsigned long)(match ? dt_sum / match : 0u),
+                 (unsigned long)dt_max);
+        write(line);
+    }
+    write("E\n");
+    HostReplay_Free(&live);
+    return bad;
+}
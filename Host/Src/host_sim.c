@@ -0,0 +1,136 @@
+/*
+ * host_sim.c  (Host build)
+ *
+ *  가상 시간과 "인터럽트" 이벤트 큐.
+ *  HAL 호출/버스 전송이 HostSim_Advance() 로 시간을 소모하면, 그 사이에 도래한
+ *  1ms tick 과 디바이스 이벤트(DMA 완료, CAN 수신 등)를 시간 순서대로 ISR 문맥에서 실행한다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_sim.h"
+#include "port_host.h"
+
+#define HOST_SIM_MAX_EVENTS   256u
+#define HOST_SIM_TICK_US      1000u
+
+typedef struct
+{
+    uint64_t        t_us;
+    uint32_t        seq;
+    HostSim_EventFn fn;
+    void           *arg;
+    uint8_t         used;
+} HostSim_Event_t;
+
+static uint64_t        s_now_us;
+static uint64_t        s_next_tick_us = HOST_SIM_TICK_US;
+static uint64_t        s_deadline_us;
+static uint32_t        s_seq;
+static HostSim_Event_t s_events[HOST_SIM_MAX_EVENTS];
+
+uint64_t HostSim_NowUs(void)
+{
+    return s_now_us;
+}
+
+void HostSim_SetDuration(uint32_t ms)
+{
+    s_deadline_us = (ms == 0u) ? 0u : (s_now_us + (uint64_t)ms * 1000u);
+}
+
+int HostSim_Schedule(uint32_t delay_us, HostSim_EventFn fn, void *arg)
+{
+    for (uint32_t i = 0; i < HOST_SIM_MAX_EVENTS; i++) {
+        if (!s_events[i].used) {
+            s_events[i].t_us = s_now_us + delay_us;
+            s_events[i].seq  = s_seq++;
+            s_events[i].fn   = fn;
+            s_events[i].arg  = arg;
+            s_events[i].used = 1;
+            return 0;
+        }
+    }
+    fprintf(stderr, "HostSim: event queue full\n");
+    abort();
+}
+
+uint32_t HostSim_Cancel(HostSim_EventFn fn, void *arg)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < HOST_SIM_MAX_EVENTS; i++) {
+        if (s_events[i].used && s_events[i].fn == fn && s_events[i].arg == arg) {
+            s_events[i].used = 0;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* 가장 이른 이벤트 (동시각이면 먼저 등록된 것) */
+static HostSim_Event_t *prvEarliestEvent(void)
+{
+    HostSim_Event_t *best = NULL;
+    for (uint32_t i = 0; i < HOST_SIM_MAX_EVENTS; i++) {
+        HostSim_Event_t *e = &s_events[i];
+        if (!e->used) continue;
+        if (best == NULL || e->t_us < best->t_us ||
+            (e->t_us == best->t_us && (int32_t)(e->seq - best->seq) < 0)) {
+            best = e;
+        }
+    }
+    return best;
+}
+
+void HostSim_Dispatch(void)
+{
+    if (!xPortHostCanInterrupt()) return;   /* 마스크 해제 시 다시 호출됨 */
+
+    uint64_t end = s_now_us;
+
+    vPortHostEnterISR();
+    for (;;) {
+        HostSim_Event_t *e = prvEarliestEvent();
+        int tick_due  = (s_next_tick_us <= end);
+        int event_due = (e != NULL && e->t_us <= end);
+
+        if (tick_due && (!event_due || s_next_tick_us <= e->t_us)) {
+            s_now_us = s_next_tick_us;
+            s_next_tick_us += HOST_SIM_TICK_US;
+            vPortHostTickISR();
+        } else if (event_due) {
+            HostSim_EventFn fn = e->fn;
+            void *arg = e->arg;
+            s_now_us = e->t_us;   /* 핸들러는 이벤트 발생 시각 기준으로 동작 */
+            e->used = 0;
+            fn(arg);
+        } else {
+            break;
+        }
+        /* ISR 안에서 소모한 시간 반영 */
+        if (s_now_us > end) end = s_now_us;
+    }
+    s_now_us = end;
+    vPortHostExitISR();
+
+    if (s_deadline_us != 0u && s_now_us >= s_deadline_us && xPortHostSchedulerRunning()) {
+        vPortHostEndScheduler();
+    }
+}
+
+void HostSim_Advance(uint32_t us)
+{
+    s_now_us += us;
+    HostSim_Dispatch();
+}
+
+void HostSim_AdvanceToNextEvent(void)
+{
+    uint64_t next = s_next_tick_us;
+    HostSim_Event_t *e = prvEarliestEvent();
+
+    if (e != NULL && e->t_us < next) next = e->t_us;
+    if (next > s_now_us) s_now_us = next;
+    HostSim_Dispatch();
+}
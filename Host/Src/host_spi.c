@@ -0,0 +1,251 @@
+/*
+ * host_spi.c  (Host build)
+ *
+ *  가짜 HAL SPI: 선택된(CS 활성 또는 CS 미배선) 디바이스 모델에 바이트를 전달.
+ *  버스 시간 = 8bit * BaudRatePrescaler / PCLK (SPI1: APB2, SPI2/3: APB1).
+ *  HAL_SPI_* 호출 1회가 디바이스 입장에서 하나의 세그먼트가 된다.
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+#define HOST_SPI_MAX_DEVICES   4u
+#define HOST_SPI_CALL_US       1u     /* HAL 호출 오버헤드 */
+
+typedef struct
+{
+    HostSPI_Device_t  dev;
+    GPIO_TypeDef     *csPort;
+    uint16_t          csPin;
+    int               selected;
+} HostSPI_Slot_t;
+
+typedef struct
+{
+    SPI_TypeDef      *bus;
+    HostSPI_Slot_t    slots[HOST_SPI_MAX_DEVICES];
+    uint32_t          nslot;
+    HostSPI_Stats_t   stats;
+    int               stall;
+} HostSPI_Bus_t;
+
+static HostSPI_Bus_t s_buses[3] = {
+    { .bus = &HostPeriph_SPI1 }, { .bus = &HostPeriph_SPI2 }, { .bus = &HostPeriph_SPI3 },
+};
+
+static HostSPI_Bus_t *prvBus(SPI_TypeDef *inst)
+{
+    for (uint32_t i = 0; i < 3u; i++) {
+        if (s_buses[i].bus == inst) return &s_buses[i];
+    }
+    return NULL;
+}
+
+static void prvCsChanged(void *ctx, GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    HostSPI_Bus_t *b = (HostSPI_Bus_t *)ctx;
+    for (uint32_t i = 0; i < b->nslot; i++) {
+        HostSPI_Slot_t *s = &b->slots[i];
+        if (s->csPort == port && s->csPin == pin) {
+            int active = (state == GPIO_PIN_RESET);   /* CS active-low */
+            if (active != s->selected) {
+                s->selected = active;
+                if (s->dev.select != NULL) s->dev.select(s->dev.ctx, active);
+            }
+        }
+    }
+}
+
+int HostSPI_Attach(SPI_TypeDef *bus, const HostSPI_Device_t *dev, GPIO_TypeDef *csPort, uint16_t csPin)
+{
+    HostSPI_Bus_t *b = prvBus(bus);
+    if (b == NULL || b->nslot >= HOST_SPI_MAX_DEVICES) return -1;
+
+    HostSPI_Slot_t *s = &b->slots[b->nslot++];
+    s->dev = *dev;
+    s->csPort = csPort;
+    s->csPin = csPin;
+    if (csPort == NULL) {
+        s->selected = 1;     /* 보드 레벨 CS: 항상 선택 */
+    } else {
+        s->selected = ((csPort->ODR & csPin) == 0u);
+        if (HostGPIO_AddListener(csPort, csPin, prvCsChanged, b) != 0) return -1;
+    }
+    return 0;
+}
+
+void HostSPI_GetStats(SPI_TypeDef *bus, HostSPI_Stats_t *out)
+{
+    HostSPI_Bus_t *b = prvBus(bus);
+    if (b != NULL && out != NULL) *out = b->stats;
+}
+
+void HostSPI_ResetStats(SPI_TypeDef *bus)
+{
+    HostSPI_Bus_t *b = prvBus(bus);
+    if (b != NULL) memset(&b->stats, 0, sizeof(b->stats));
+}
+
+void HostSPI_SetStall(SPI_TypeDef *bus, int stall)
+{
+    HostSPI_Bus_t *b = prvBus(bus);
+    if (b != NULL) b->stall = stall;
+}
+
+static uint32_t prvXferUs(SPI_HandleTypeDef *hspi, uint32_t bytes)
+{
+    uint32_t pclk = (hspi->Instance == SPI1) ? HostSim_PCLK2() : HostSim_PCLK1();
+    uint32_t div = 2u << ((hspi->Init.BaudRatePrescaler >> 3) & 0x7u);
+    uint64_t ns = (uint64_t)bytes * 8u * div * 1000000000ull / pclk;
+    return (uint32_t)((ns + 999u) / 1000u);
+}
+
+/* 선택된 디바이스들에게 세그먼트 전달. MISO 는 마지막으로 응답한 디바이스 값 (없으면 0xFF).
+   수신 전용이면 0xFF 더미를 송신. 보드 레벨 CS 모델은 세그먼트 경계로 명령 끝을 추정하므로
+   HAL 호출 1회는 길이와 무관하게 한 번에 전달한다 */
+static void prvShift(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    HostSPI_Bus_t *b = prvBus(hspi->Instance);
+    static uint8_t dummy[0xFFFFu];
+    static int dummyInit;
+
+    if (rx != NULL) memset(rx, 0xFF, len);
+    if (b == NULL) return;
+
+    if (!dummyInit) {
+        memset(dummy, 0xFF, sizeof(dummy));
+        dummyInit = 1;
+    }
+    for (uint32_t i = 0; i < b->nslot; i++) {
+        HostSPI_Slot_t *s = &b->slots[i];
+        if (s->selected && s->dev.transfer != NULL) {
+            s->dev.transfer(s->dev.ctx, (tx != NULL) ? tx : dummy, rx, len);
+        }
+    }
+
+    b->stats.calls++;
+    b->stats.bytes += len;
+}
+
+static HAL_StatusTypeDef prvBlocking(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    HostSPI_Bus_t *b;
+    uint32_t us;
+
+    if (hspi == NULL || len == 0u) return HAL_ERROR;
+    if (hspi->State != HAL_SPI_STATE_READY) return HAL_BUSY;
+
+    hspi->State = HAL_SPI_STATE_BUSY;
+    prvShift(hspi, tx, rx, len);
+    us = prvXferUs(hspi, len);
+    b = prvBus(hspi->Instance);
+    if (b != NULL) b->stats.busy_us += us;
+    hspi->State = HAL_SPI_STATE_READY;
+
+    HostSim_Advance(us + HOST_SPI_CALL_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == NULL || prvBus(hspi->Instance) == NULL) return HAL_ERROR;
+    hspi->State = HAL_SPI_STATE_READY;
+    hspi->ErrorCode = HAL_SPI_ERROR_NONE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_DeInit(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == NULL) return HAL_ERROR;
+    hspi->State = HAL_SPI_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    if (pData == NULL) return HAL_ERROR;
+    return prvBlocking(hspi, pData, NULL, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    if (pData == NULL) return HAL_ERROR;
+    return prvBlocking(hspi, NULL, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    if (pTxData == NULL || pRxData == NULL) return HAL_ERROR;
+    return prvBlocking(hspi, pTxData, pRxData, Size);
+}
+
+/* ===== DMA ===== */
+static void prvDmaComplete(void *arg)
+{
+    SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef *)arg;
+    HAL_SPI_StateTypeDef st = hspi->State;
+
+    hspi->State = HAL_SPI_STATE_READY;
+    if (st == HAL_SPI_STATE_BUSY_TX)      HAL_SPI_TxCpltCallback(hspi);
+    else if (st == HAL_SPI_STATE_BUSY_RX) HAL_SPI_RxCpltCallback(hspi);
+    else                                  HAL_SPI_TxRxCpltCallback(hspi);
+}
+
+static HAL_StatusTypeDef prvStartDma(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx,
+                                     uint16_t len, HAL_SPI_StateTypeDef busy)
+{
+    HostSPI_Bus_t *b;
+    uint32_t us;
+
+    if (hspi == NULL || len == 0u) return HAL_ERROR;
+    if (hspi->State != HAL_SPI_STATE_READY) return HAL_BUSY;
+
+    /* 데이터는 시작 시점에 모델과 교환하고 완료 통지만 버스 시간 뒤로 미룬다.
+       CS 는 완료 콜백 이후에 해제된다는 전제 (실제 드라이버와 동일) */
+    prvShift(hspi, tx, rx, len);
+    us = prvXferUs(hspi, len);
+    b = prvBus(hspi->Instance);
+    if (b != NULL) b->stats.busy_us += us;
+
+    hspi->State = busy;
+    if (b == NULL || !b->stall) HostSim_Schedule(us, prvDmaComplete, hspi);
+    HostSim_Advance(HOST_SPI_CALL_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    return prvStartDma(hspi, pData, NULL, Size, HAL_SPI_STATE_BUSY_TX);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+    return prvStartDma(hspi, NULL, pData, Size, HAL_SPI_STATE_BUSY_RX);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size)
+{
+    return prvStartDma(hspi, pTxData, pRxData, Size, HAL_SPI_STATE_BUSY_TX_RX);
+}
+
+/* blocking abort: 완료 이벤트를 버리고 READY (콜백 없음) */
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == NULL) return HAL_ERROR;
+    (void)HostSim_Cancel(prvDmaComplete, hspi);
+    if (hspi->State != HAL_SPI_STATE_READY) hspi->ErrorCode |= HAL_SPI_ERROR_ABORT;
+    hspi->State = HAL_SPI_STATE_READY;
+    HostSim_Advance(HOST_SPI_CALL_US);
+    return HAL_OK;
+}
+
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *hspi) { return hspi->State; }
+
+__weak void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)   { UNUSED(hspi); }
+__weak void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)   { UNUSED(hspi); }
+__weak void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) { UNUSED(hspi); }
+__weak void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)    { UNUSED(hspi); }
@@ -0,0 +1,190 @@
+/*
+ * host_uart.c  (Host build)
+ *
+ *  가짜 HAL UART: 송신 바이트를 리스너로 전달하고 10bit/byte 로 전송 시간을 소모.
+ *  수신은 HostUART_Inject() 로 넣은 바이트를 내부 버퍼에서 꺼낸다.
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+#define HOST_UART_RX_BUF   256u
+
+typedef struct
+{
+    USART_TypeDef      *inst;
+    UART_HandleTypeDef *huart;
+    HostUART_TxFn       txFn;
+    void               *txCtx;
+    uint8_t             rx[HOST_UART_RX_BUF];
+    uint32_t            rx_head, rx_count;
+} HostUART_Port_t;
+
+static HostUART_Port_t s_ports[4] = {
+    { .inst = &HostPeriph_USART1 }, { .inst = &HostPeriph_USART2 },
+    { .inst = &HostPeriph_USART3 }, { .inst = &HostPeriph_UART4 },
+};
+
+static HostUART_Port_t *prvPort(USART_TypeDef *inst)
+{
+    for (uint32_t i = 0; i < 4u; i++) {
+        if (s_ports[i].inst == inst) return &s_ports[i];
+    }
+    return NULL;
+}
+
+static uint32_t prvBytesUs(UART_HandleTypeDef *huart, uint32_t n)
+{
+    uint32_t baud = (huart->Init.BaudRate != 0u) ? huart->Init.BaudRate : 115200u;
+    return (uint32_t)(((uint64_t)n * 10u * 1000000u + baud - 1u) / baud);
+}
+
+int HostUART_SetTxListener(USART_TypeDef *uart, HostUART_TxFn fn, void *ctx)
+{
+    HostUART_Port_t *p = prvPort(uart);
+    if (p == NULL) return -1;
+    p->txFn = fn;
+    p->txCtx = ctx;
+    return 0;
+}
+
+static void prvRxIrq(void *arg);
+
+int HostUART_Inject(USART_TypeDef *uart, const uint8_t *data, uint16_t len)
+{
+    HostUART_Port_t *p = prvPort(uart);
+    if (p == NULL) return -1;
+    for (uint16_t i = 0; i < len; i++) {
+        if (p->rx_count >= HOST_UART_RX_BUF) return -1;
+        p->rx[(p->rx_head + p->rx_count) % HOST_UART_RX_BUF] = data[i];
+        p->rx_count++;
+    }
+    if (p->huart != NULL && p->huart->RxState == HAL_UART_STATE_BUSY_RX) {
+        HostSim_Schedule(prvBytesUs(p->huart, len), prvRxIrq, p);
+    }
+    return 0;
+}
+
+int HostUART_InjectError(USART_TypeDef *uart, uint32_t error)
+{
+    HostUART_Port_t *p = prvPort(uart);
+    if (p == NULL || p->huart == NULL) return -1;
+    p->huart->ErrorCode |= error;
+    p->huart->RxState = HAL_UART_STATE_READY;
+    HAL_UART_ErrorCallback(p->huart);
+    return 0;
+}
+
+static int prvPop(HostUART_Port_t *p, uint8_t *out)
+{
+    if (p->rx_count == 0u) return 0;
+    *out = p->rx[p->rx_head];
+    p->rx_head = (p->rx_head + 1u) % HOST_UART_RX_BUF;
+    p->rx_count--;
+    return 1;
+}
+
+/* Receive_IT: 요청 길이만큼 모이면 RxCplt */
+static void prvRxIrq(void *arg)
+{
+    HostUART_Port_t *p = (HostUART_Port_t *)arg;
+    UART_HandleTypeDef *h = p->huart;
+
+    if (h == NULL || h->RxState != HAL_UART_STATE_BUSY_RX) return;
+    while (h->RxXferCount > 0u && prvPop(p, &h->pRxBuffPtr[h->RxXferSize - h->RxXferCount])) {
+        h->RxXferCount--;
+    }
+    if (h->RxXferCount == 0u) {
+        h->RxState = HAL_UART_STATE_READY;
+        HAL_UART_RxCpltCallback(h);
+    }
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    HostUART_Port_t *p = (huart != NULL) ? prvPort(huart->Instance) : NULL;
+    if (p == NULL) return HAL_ERROR;
+    p->huart = huart;
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+    huart->ErrorCode = 0u;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    HostUART_Port_t *p = (huart != NULL) ? prvPort(huart->Instance) : NULL;
+    (void)Timeout;
+
+    if (p == NULL || pData == NULL || Size == 0u) return HAL_ERROR;
+    if (huart->gState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    HostSim_Advance(prvBytesUs(huart, Size));
+    if (p->txFn != NULL) p->txFn(p->txCtx, pData, Size);
+    huart->gState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    HostUART_Port_t *p = (huart != NULL) ? prvPort(huart->Instance) : NULL;
+    uint32_t tickstart = HAL_GetTick();
+
+    if (p == NULL || pData == NULL || Size == 0u) return HAL_ERROR;
+    for (uint16_t i = 0; i < Size; i++) {
+        while (!prvPop(p, &pData[i])) {
+            if (Timeout != HAL_MAX_DELAY && (HAL_GetTick() - tickstart) >= Timeout) return HAL_TIMEOUT;
+            HostSim_Advance(prvBytesUs(huart, 1u));
+        }
+    }
+    return HAL_OK;
+}
+
+static void prvTxDone(void *arg)
+{
+    HostUART_Port_t *p = (HostUART_Port_t *)arg;
+    UART_HandleTypeDef *h = p->huart;
+
+    if (p->txFn != NULL) p->txFn(p->txCtx, h->pTxBuffPtr, h->TxXferSize);
+    h->gState = HAL_UART_STATE_READY;
+    HAL_UART_TxCpltCallback(h);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    HostUART_Port_t *p = (huart != NULL) ? prvPort(huart->Instance) : NULL;
+
+    if (p == NULL || pData == NULL || Size == 0u) return HAL_ERROR;
+    if (huart->gState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    huart->pTxBuffPtr = pData;
+    huart->TxXferSize = Size;
+    HostSim_Schedule(prvBytesUs(huart, Size), prvTxDone, p);
+    HostSim_Advance(1u);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    HostUART_Port_t *p = (huart != NULL) ? prvPort(huart->Instance) : NULL;
+
+    if (p == NULL || pData == NULL || Size == 0u) return HAL_ERROR;
+    if (huart->RxState != HAL_UART_STATE_READY) return HAL_BUSY;
+
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->RxXferCount = Size;
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    if (p->rx_count > 0u) {
+        HostSim_Schedule(prvBytesUs(huart, 1u), prvRxIrq, p);
+    }
+    return HAL_OK;
+}
+
+__weak void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) { UNUSED(huart); }
+__weak void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) { UNUSED(huart); }
+__weak void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)  { UNUSED(huart); }
@@ -0,0 +1,207 @@
+/*
+ * model_25lc256.c  (Host build)
+ *
+ *  25LC256 SPI EEPROM 모델. 명령 해석은 Datasheet p.6~7 기준.
+ */
+
+#include <string.h>
+
+#include "model_25lc256.h"
+
+#define OP_WRSR   0x01u
+#define OP_WRITE  0x02u
+#define OP_READ   0x03u
+#define OP_WRDI   0x04u
+#define OP_RDSR   0x05u
+#define OP_WREN   0x06u
+
+#define SR_WIP    0x01u
+#define SR_WEL    0x02u
+
+static void prvUpdateWip(M25LC256_t *m)
+{
+    if ((m->status & SR_WIP) && HostSim_NowUs() >= m->wip_until_us) {
+        m->status &= (uint8_t)~(SR_WIP | SR_WEL);
+    }
+}
+
+void M25LC256_Init(M25LC256_t *m)
+{
+    memset(m, 0, sizeof(*m));
+    memset(m->mem, 0xFF, sizeof(m->mem));
+    m->cut_budget = -1;
+}
+
+void M25LC256_ArmPowerCut(M25LC256_t *m, int32_t n)
+{
+    m->cut_budget = n;
+}
+
+void M25LC256_PowerOn(M25LC256_t *m)
+{
+    m->dead = 0;
+    m->status &= (uint8_t)~(SR_WIP | SR_WEL);
+    m->opcode = 0u;
+    m->phase = 0u;
+    m->data_seen = 0u;
+    m->cut_budget = -1;
+}
+
+/* CS 해제(명령 종료): WRITE 였다면 page 버퍼를 커밋하고 쓰기 사이클 시작 */
+static void prvEndCommand(M25LC256_t *m)
+{
+    if (m->opcode == OP_WRITE && m->phase == 2u && m->wr_count > 0u) {
+        /* 시작 주소부터 page 내 순서대로 반영. 전원 차단 시 그 바이트는 중간 값으로 남음 */
+        uint32_t start = m->wr_start;
+        for (uint32_t k = 0; k < M25LC256_PAGE_SIZE && !m->dead; k++) {
+            uint32_t i = (start + k) & (M25LC256_PAGE_SIZE - 1u);
+            if (!m->page_dirty[i]) continue;
+            if (m->cut_budget == 0) {
+                m->mem[m->page_base + i] = (uint8_t)(m->mem[m->page_base + i] ^ m->page_buf[i] ^ 0x5Au);
+                m->dead = 1;
+                break;
+            }
+            if (m->cut_budget > 0) m->cut_budget--;
+            m->mem[m->page_base + i] = m->page_buf[i];
+        }
+        m->stats.writes++;
+        m->stats.bytes_written += m->wr_count;
+        m->status |= SR_WIP;
+        m->wip_until_us = HostSim_NowUs() + M25LC256_TWC_US;
+    } else if (m->opcode == OP_READ && m->phase == 2u) {
+        m->stats.reads++;
+    }
+    m->opcode = 0u;
+    m->phase = 0u;
+    m->data_seen = 0u;
+}
+
+static void prvSelect(void *ctx, int active)
+{
+    M25LC256_t *m = (M25LC256_t *)ctx;
+    if (m->dead) return;
+    prvUpdateWip(m);
+    if (!active) prvEndCommand(m);
+}
+
+static uint8_t prvByte(M25LC256_t *m, uint8_t in)
+{
+    uint8_t out = 0xFFu;
+
+    switch (m->phase) {
+    case 0u:
+        m->opcode = in;
+        switch (in) {
+        case OP_WREN:
+            if (!(m->status & SR_WIP)) m->status |= SR_WEL;
+            else m->stats.rejected++;
+            break;
+        case OP_WRDI:
+            m->status &= (uint8_t)~SR_WEL;
+            break;
+        case OP_RDSR:
+            m->stats.rdsr_polls++;
+            m->phase = 2u;
+            break;
+        case OP_READ:
+        case OP_WRITE:
+            if (m->status & SR_WIP) {       /* 쓰기 사이클 중에는 RDSR 만 응답 */
+                m->stats.rejected++;
+                m->opcode = 0xFFu;
+                m->phase = 3u;
+            } else if (in == OP_WRITE && !(m->status & SR_WEL)) {
+                m->stats.rejected++;
+                m->opcode = 0xFFu;
+                m->phase = 3u;
+            } else {
+                m->phase = 1u;
+                m->addr_bytes = 0u;
+                m->addr = 0u;
+            }
+            break;
+        case OP_WRSR:
+            m->phase = 2u;
+            break;
+        default:
+            m->phase = 3u;
+            break;
+        }
+        break;
+
+    case 1u:
+        m->addr = (uint16_t)((m->addr << 8) | in);
+        if (++m->addr_bytes == 2u) {
+            m->addr &= (uint16_t)(M25LC256_SIZE - 1u);
+            m->phase = 2u;
+            if (m->opcode == OP_WRITE) {
+                m->page_base = (uint16_t)(m->addr & ~(M25LC256_PAGE_SIZE - 1u));
+                memset(m->page_dirty, 0, sizeof(m->page_dirty));
+                m->wr_count = 0u;
+                m->wr_start = (uint16_t)(m->addr & (M25LC256_PAGE_SIZE - 1u));
+            }
+        }
+        break;
+
+    case 2u:
+        m->data_seen = 1u;
+        if (m->opcode == OP_RDSR) {
+            prvUpdateWip(m);
+            out = m->status;
+        } else if (m->opcode == OP_READ) {
+            out = m->mem[m->addr];
+            m->addr = (uint16_t)((m->addr + 1u) & (M25LC256_SIZE - 1u));
+            m->stats.bytes_read++;
+        } else if (m->opcode == OP_WRITE) {
+            uint32_t off = m->addr & (M25LC256_PAGE_SIZE - 1u);
+            m->page_buf[off] = in;
+            m->page_dirty[off] = 1u;
+            m->wr_count++;
+            m->addr = (uint16_t)(m->page_base + ((off + 1u) & (M25LC256_PAGE_SIZE - 1u)));
+        } else if (m->opcode == OP_WRSR) {
+            if (m->status & SR_WEL) {
+                m->status = (uint8_t)((m->status & 0x03u) | (in & 0x8Cu));
+            }
+            m->phase = 3u;
+        }
+        break;
+
+    default:
+        break;
+    }
+    return out;
+}
+
+static void prvTransfer(void *ctx, const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    M25LC256_t *m = (M25LC256_t *)ctx;
+
+    if (m->dead) return;
+    prvUpdateWip(m);
+    m->data_seen = 0u;
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t o = prvByte(m, tx[i]);
+        if (rx != NULL) rx[i] = o;
+    }
+
+    if (m->explicit_cs) return;
+
+    /* 보드 레벨 CS: 세그먼트 경계로 명령 종료를 추정 */
+    switch (m->opcode) {
+    case OP_WREN: case OP_WRDI: case OP_RDSR: case OP_WRSR:
+        prvEndCommand(m);
+        break;
+    case OP_READ: case OP_WRITE:
+        if (m->phase == 2u && m->data_seen) prvEndCommand(m);
+        break;
+    default:
+        prvEndCommand(m);
+        break;
+    }
+}
+
+int M25LC256_Attach(M25LC256_t *m, SPI_TypeDef *bus, GPIO_TypeDef *csPort, uint16_t csPin)
+{
+    HostSPI_Device_t dev = { .ctx = m, .select = prvSelect, .transfer = prvTransfer };
+    m->explicit_cs = (csPort != NULL);
+    return HostSPI_Attach(bus, &dev, csPort, csPin);
+}
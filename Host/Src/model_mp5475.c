@@ -0,0 +1,61 @@
+/*
+ * model_mp5475.c  (Host build)
+ *
+ *  MP5475 I2C 레지스터 모델. 쓰기 첫 바이트가 레지스터 포인터,
+ *  이후 바이트/읽기는 포인터를 1씩 증가시키며 접근 (Datasheet p.40 I2C Read/Write).
+ */
+
+#include <string.h>
+
+#include "model_mp5475.h"
+
+void MMP5475_Init(MMP5475_t *m)
+{
+    memset(m, 0, sizeof(*m));
+    m->addr7 = MMP5475_ADDR7;
+    /* 기본 VOUT_COMMAND: 1.0V (10mV/LSB) */
+    for (uint32_t r = 0x16u; r <= 0x19u; r++) m->regs[r] = 100u;
+}
+
+static int prvWrite(void *ctx, const uint8_t *data, uint16_t len)
+{
+    MMP5475_t *m = (MMP5475_t *)ctx;
+
+    if (m->nak) return -1;
+    m->stats.write_xfers++;
+    if (len == 0u) return 0;
+
+    m->ptr = data[0];
+    for (uint16_t i = 1; i < len; i++) {
+        if (!m->drop_writes) m->regs[m->ptr] = data[i];
+        m->stats.reg_writes++;
+        m->stats.reg_write_count[m->ptr]++;
+        m->ptr++;
+    }
+    return 0;
+}
+
+static int prvRead(void *ctx, uint8_t *data, uint16_t len)
+{
+    MMP5475_t *m = (MMP5475_t *)ctx;
+
+    if (m->nak) return -1;
+    m->stats.read_xfers++;
+    for (uint16_t i = 0; i < len; i++) {
+        data[i] = m->regs[m->ptr++];
+        m->stats.reg_reads++;
+    }
+    return 0;
+}
+
+int MMP5475_Attach(MMP5475_t *m, I2C_TypeDef *bus)
+{
+    HostI2C_Device_t dev = { .addr7 = m->addr7, .ctx = m, .write = prvWrite, .read = prvRead };
+    return HostI2C_Attach(bus, &dev);
+}
+
+void MMP5475_SetReg(MMP5475_t *m, uint8_t reg, uint8_t value) { m->regs[reg] = value; }
+uint8_t MMP5475_GetReg(const MMP5475_t *m, uint8_t reg)        { return m->regs[reg]; }
+
+void MMP5475_InjectFault(MMP5475_t *m, uint8_t reg, uint8_t mask) { m->regs[reg] |= mask; }
+void MMP5475_ClearFault(MMP5475_t *m, uint8_t reg, uint8_t mask)  { m->regs[reg] &= (uint8_t)~mask; }
@@ -0,0 +1,254 @@
+/*
+ * model_w25q.c  (Host build)
+ *
+ *  W25Q16JV SPI NOR flash 모델. 명령 해석은 Datasheet 8.2 (Instruction Set) 기준.
+ */
+
+#include <string.h>
+
+#include "model_w25q.h"
+
+#define OP_PP      0x02u
+#define OP_READ    0x03u
+#define OP_WRDI    0x04u
+#define OP_RDSR1   0x05u
+#define OP_WREN    0x06u
+#define OP_SE_4K   0x20u
+#define OP_JEDEC   0x9Fu
+
+#define SR_BUSY    0x01u
+#define SR_WEL     0x02u
+
+static const uint8_t s_jedec[3] = { 0xEFu, 0x40u, 0x15u };
+
+static void prvUpdateBusy(W25Q_t *m)
+{
+    if ((m->status & SR_BUSY) && HostSim_NowUs() >= m->busy_until_us) {
+        m->status &= (uint8_t)~(SR_BUSY | SR_WEL);
+    }
+}
+
+static void prvStartBusy(W25Q_t *m, uint32_t us)
+{
+    m->status |= SR_BUSY;
+    m->busy_until_us = HostSim_NowUs() + us;
+}
+
+/* 파일 백업에 [addr, addr+len) 반영 */
+static void prvFlush(W25Q_t *m, uint32_t addr, uint32_t len)
+{
+    if (m->backing == NULL) return;
+    if (fseek(m->backing, (long)addr, SEEK_SET) == 0) {
+        (void)fwrite(&m->mem[addr], 1, len, m->backing);
+        fflush(m->backing);
+    }
+}
+
+void W25Q_Init(W25Q_t *m)
+{
+    memset(m, 0, sizeof(*m));
+    memset(m->mem, 0xFF, sizeof(m->mem));
+    m->cut_budget = -1;
+}
+
+int W25Q_OpenBacking(W25Q_t *m, const char *path)
+{
+    FILE *f = fopen(path, "r+b");
+
+    W25Q_CloseBacking(m);
+    if (f == NULL) {
+        f = fopen(path, "w+b");
+        if (f == NULL) return -1;
+        memset(m->mem, 0xFF, sizeof(m->mem));
+        if (fwrite(m->mem, 1, sizeof(m->mem), f) != sizeof(m->mem)) { fclose(f); return -1; }
+        fflush(f);
+    } else if (fread(m->mem, 1, sizeof(m->mem), f) != sizeof(m->mem)) {
+        fclose(f);
+        return -1;
+    }
+    m->backing = f;
+    return 0;
+}
+
+void W25Q_CloseBacking(W25Q_t *m)
+{
+    if (m->backing != NULL) fclose(m->backing);
+    m->backing = NULL;
+}
+
+void W25Q_ArmPowerCut(W25Q_t *m, int32_t n)
+{
+    m->cut_budget = n;
+}
+
+void W25Q_PowerOn(W25Q_t *m)
+{
+    m->dead = 0;
+    m->status = 0u;
+    m->opcode = 0u;
+    m->phase = 0u;
+    m->cut_budget = -1;
+    if (m->backing != NULL && fseek(m->backing, 0, SEEK_SET) == 0) {
+        (void)fread(m->mem, 1, sizeof(m->mem), m->backing);
+    }
+}
+
+/* page 버퍼 커밋: 주소 순서대로 기록하다가 전원 차단 예산이 끝나면 중단 */
+static void prvCommitPage(W25Q_t *m)
+{
+    uint32_t lo = W25Q_PAGE_SIZE, hi = 0u;
+
+    for (uint32_t i = 0; i < W25Q_PAGE_SIZE; i++) {
+        if (!m->page_dirty[i]) continue;
+        if (m->cut_budget == 0) { m->dead = 1; break; }
+        if (m->cut_budget > 0) m->cut_budget--;
+
+        uint8_t *cell = &m->mem[m->page_base + i];
+        if ((*cell & m->page_buf[i]) != m->page_buf[i]) m->stats.program_violations++;
+        *cell &= m->page_buf[i];
+        m->stats.bytes_programmed++;
+        if (i < lo) lo = i;
+        hi = i + 1u;
+    }
+    if (hi > lo) prvFlush(m, m->page_base + lo, hi - lo);
+    m->stats.page_programs++;
+    if (!m->dead) prvStartBusy(m, W25Q_TPP_US);
+}
+
+static void prvEraseSector(W25Q_t *m, uint32_t addr)
+{
+    uint32_t base = addr & ~(W25Q_SECTOR_SIZE - 1u);
+    uint32_t idx = base / W25Q_SECTOR_SIZE;
+
+    memset(&m->mem[base], 0xFF, W25Q_SECTOR_SIZE);
+    prvFlush(m, base, W25Q_SECTOR_SIZE);
+    m->stats.sector_erases++;
+    if (++m->erase_count[idx] > m->stats.max_erase_count) m->stats.max_erase_count = m->erase_count[idx];
+    prvStartBusy(m, W25Q_TSE_US);
+}
+
+/* CS 해제: PP/SE 는 이 시점에 실행. WEL 은 동작 완료(BUSY 해제) 때 함께 내려감 */
+static void prvEndCommand(W25Q_t *m)
+{
+    if (m->opcode == OP_PP && m->phase == 2u && m->wr_count > 0u) {
+        prvCommitPage(m);
+    } else if (m->opcode == OP_SE_4K && m->phase == 2u) {
+        prvEraseSector(m, m->addr);
+    }
+    m->opcode = 0u;
+    m->phase = 0u;
+}
+
+static void prvSelect(void *ctx, int active)
+{
+    W25Q_t *m = (W25Q_t *)ctx;
+    if (m->dead) return;
+    prvUpdateBusy(m);
+    if (!active) prvEndCommand(m);
+}
+
+static uint8_t prvByte(W25Q_t *m, uint8_t in)
+{
+    uint8_t out = 0xFFu;
+
+    switch (m->phase) {
+    case 0u:
+        m->opcode = in;
+        if ((m->status & SR_BUSY) && in != OP_RDSR1) {      /* BUSY 중에는 RDSR 만 응답 */
+            m->stats.rejected++;
+            m->phase = 3u;
+            break;
+        }
+        switch (in) {
+        case OP_WREN:
+            m->status |= SR_WEL;
+            m->phase = 3u;
+            break;
+        case OP_WRDI:
+            m->status &= (uint8_t)~SR_WEL;
+            m->phase = 3u;
+            break;
+        case OP_RDSR1:
+            m->stats.rdsr_polls++;
+            m->phase = 2u;
+            break;
+        case OP_JEDEC:
+            m->addr = 0u;
+            m->phase = 2u;
+            break;
+        case OP_PP:
+        case OP_SE_4K:
+            if (!(m->status & SR_WEL)) {
+                m->stats.rejected++;
+                m->phase = 3u;
+                break;
+            }
+            /* fallthrough */
+        case OP_READ:
+            m->phase = 1u;
+            m->addr_bytes = 0u;
+            m->addr = 0u;
+            break;
+        default:
+            m->phase = 3u;
+            break;
+        }
+        break;
+
+    case 1u:
+        m->addr = (m->addr << 8) | in;
+        if (++m->addr_bytes == 3u) {
+            m->addr &= W25Q_SIZE - 1u;
+            m->phase = 2u;
+            if (m->opcode == OP_PP) {
+                m->page_base = m->addr & ~(W25Q_PAGE_SIZE - 1u);
+                memset(m->page_dirty, 0, sizeof(m->page_dirty));
+                m->wr_count = 0u;
+            }
+        }
+        break;
+
+    case 2u:
+        if (m->opcode == OP_RDSR1) {
+            prvUpdateBusy(m);
+            out = m->status;
+        } else if (m->opcode == OP_JEDEC) {
+            out = (m->addr < 3u) ? s_jedec[m->addr] : 0xFFu;
+            m->addr++;
+        } else if (m->opcode == OP_READ) {
+            out = m->mem[m->addr];
+            m->addr = (m->addr + 1u) & (W25Q_SIZE - 1u);
+            m->stats.bytes_read++;
+        } else if (m->opcode == OP_PP) {
+            uint32_t off = m->addr & (W25Q_PAGE_SIZE - 1u);
+            m->page_buf[off] = in;
+            m->page_dirty[off] = 1u;
+            m->wr_count++;
+            m->addr = m->page_base + ((off + 1u) & (W25Q_PAGE_SIZE - 1u));
+        }
+        break;
+
+    default:
+        break;
+    }
+    return out;
+}
+
+static void prvTransfer(void *ctx, const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    W25Q_t *m = (W25Q_t *)ctx;
+
+    if (m->dead) return;                 /* MISO 풀업: 0xFF */
+    prvUpdateBusy(m);
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t o = prvByte(m, tx[i]);
+        if (rx != NULL) rx[i] = o;
+    }
+}
+
+int W25Q_Attach(W25Q_t *m, SPI_TypeDef *bus, GPIO_TypeDef *csPort, uint16_t csPin)
+{
+    HostSPI_Device_t dev = { .ctx = m, .select = prvSelect, .transfer = prvTransfer };
+    if (csPort == NULL) return -1;
+    return HostSPI_Attach(bus, &dev, csPort, csPin);
+}
@@ -0,0 +1,294 @@
+/*
+ * test_boot.c  (Host build)
+ *
+ *  CAN 부트로더 (Bootloader/Src/Boot.c + FlashProg.c, 호스트 부트 보드 + 내장 flash 모델).
+ *  테스터는 Host/Tools/uds_client.c (uds_flash 와 같은 클라이언트).
+ *    download: default 세션 0x34 → 0x7F, 0x34 없이 0x36 → 0x24, 안 지운 영역 0x34 → 0x70,
+ *              틀린 BSC → 0x73, 같은 BSC 재전송 → 긍정 응답 (기록 안 함), CRC 불일치 → 0x72 + 앱 무효,
+ *              기록 실패 (PGPERR) → 0x72, 정상 다운로드 (마지막 블록 비정렬) → 내용/패딩/부트 정보
+ *              압축 (DFI 0x10): 미지원 DFI → 0x31, 압축 다운로드 → 내용/CRC, 원래 크기보다 긴 스트림 → 0x72,
+ *              덜 보낸 스트림 → 0x37 에서 0x24
+ *    window:   유효한 앱 + 요청 없음 → 부팅 창 뒤 Boot_Reset(JUMP)
+ *    stay:     유효한 앱 + 창 안에 요청 → 부트로더에 남음
+ *    debug:    부트 정보 없이 벡터 테이블만 맞는 앱 (디버거로 올림) → window 와 같음.
+ *              다운로드가 지운 부트 정보 (dirty) 는 벡터 테이블이 맞아도 앱 무효 (download 에서 확인)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_boot_board.h"
+#include "host_sim.h"
+#include "hs_encode.h"
+#include "test_check.h"
+
+#define IMG_SIZE    (8u * 1024u + 3u)     /* 블록 8 개 + 3B */
+
+static int         s_rc;
+static UdsClient_t s_uds;
+static uint8_t     s_img[IMG_SIZE];
+static uint8_t     s_packed[HS_ENCODE_BOUND(IMG_SIZE)];
+
+static int prvReq(const uint8_t *req, uint32_t len, uint8_t *rsp)
+{
+    return UdsClient_Request(&s_uds, req, len, rsp, 64);
+}
+
+/* 부정 응답 NRC (긍정/오류면 0) */
+static uint8_t prvNrc(const uint8_t *req, uint32_t len)
+{
+    uint8_t rsp[64];
+    return (prvReq(req, len, rsp) == UDSC_ERR_NRC) ? s_uds.last_nrc : 0u;
+}
+
+static void prvPut32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16); p[2] = (uint8_t)(v >> 8); p[3] = (uint8_t)v;
+}
+
+static int prvErase(uint32_t addr, uint32_t size)
+{
+    uint8_t req[13] = { 0x31, 0x01, 0xFF, 0x00, 0x44 }, rsp[64];
+    prvPut32(&req[5], addr);
+    prvPut32(&req[9], size);
+    return prvReq(req, sizeof(req), rsp);
+}
+
+static uint8_t prvRequestDownloadFmt(uint8_t dfi, uint32_t addr, uint32_t size)
+{
+    uint8_t req[11] = { 0x34, dfi, 0x44 }, rsp[64];
+    prvPut32(&req[3], addr);
+    prvPut32(&req[7], size);
+    int n = prvReq(req, sizeof(req), rsp);
+    if (n == UDSC_ERR_NRC) return s_uds.last_nrc;
+    return (n == 4 && rsp[1] == 0x20 && rsp[2] == 0x04 && rsp[3] == 0x02) ? 0u : 0xFFu;
+}
+
+static uint8_t prvRequestDownload(uint32_t addr, uint32_t size)
+{
+    return prvRequestDownloadFmt(BOOT_DFI_RAW, addr, size);
+}
+
+/* 36 bsc + src[0..n) → NRC (0 = 긍정, 응답 BSC 확인) */
+static uint8_t prvTransferFrom(uint8_t bsc, const uint8_t *src, uint32_t n)
+{
+    static uint8_t req[2u + FLASHPROG_BLOCK_MAX];
+    uint8_t rsp[64];
+    req[0] = 0x36;
+    req[1] = bsc;
+    memcpy(&req[2], src, n);
+    int rc = prvReq(req, 2u + n, rsp);
+    if (rc == UDSC_ERR_NRC) return s_uds.last_nrc;
+    return (rc == 2 && rsp[1] == bsc) ? 0u : 0xFFu;
+}
+
+static uint8_t prvTransfer(uint8_t bsc, uint32_t pos, uint32_t n)
+{
+    return prvTransferFrom(bsc, &s_img[pos], n);
+}
+
+/* src 를 블록 크기 blk 로 나눠 전송 → 첫 NRC (0 = 모두 긍정) */
+static uint8_t prvTransferAll(const uint8_t *src, uint32_t len, uint32_t blk)
+{
+    uint8_t bsc = 1, nrc = 0;
+    for (uint32_t pos = 0; pos < len && nrc == 0u; pos += blk, bsc++) {
+        nrc = prvTransferFrom(bsc, &src[pos], (len - pos > blk) ? blk : len - pos);
+    }
+    return nrc;
+}
+
+static uint8_t prvExit(uint32_t crc)
+{
+    uint8_t req[5] = { 0x37 };
+    prvPut32(&req[1], crc);
+    return prvNrc(req, sizeof(req));
+}
+
+/* 앱 벡터 테이블: 초기 SP (RAM 끝), reset 벡터 (thumb) */
+static void prvPutVectors(uint8_t *img)
+{
+    static const uint32_t vec[2] = { 0x2004FF00u, FLASHPROG_APP_START + 0x1F5u };
+    memcpy(img, vec, sizeof(vec));
+}
+
+static void prvDownloadTester(void *arg)
+{
+    uint8_t rsp[64];
+    (void)arg;
+
+    HostBootBoard_TesterInit(&s_uds);
+    for (uint32_t i = 0; i < IMG_SIZE; i++) s_img[i] = (uint8_t)(i * 7u + (i >> 8));
+    prvPutVectors(s_img);
+
+    /* 세션/순서 */
+    CHECK_END(prvRequestDownload(FLASHPROG_APP_START, IMG_SIZE) == BOOT_NRC_SERVICE_NOT_IN_SESSION);
+    CHECK_END(prvReq((const uint8_t[]){ 0x10, 0x02 }, 2, rsp) == 6 && rsp[1] == 0x02);
+    CHECK_END(prvNrc((const uint8_t[]){ 0x36, 0x01, 0x00, 0x00, 0x00, 0x00 }, 6) == BOOT_NRC_REQUEST_SEQUENCE_ERROR);
+    CHECK_END(prvNrc((const uint8_t[]){ 0x37 }, 1) == BOOT_NRC_REQUEST_SEQUENCE_ERROR);
+    CHECK_END(prvRequestDownload(FLASHPROG_APP_START + 2u, IMG_SIZE) == BOOT_NRC_REQUEST_OUT_OF_RANGE);
+    CHECK_END(prvRequestDownload(FLASHPROG_BOOT_START, 1024) == BOOT_NRC_REQUEST_OUT_OF_RANGE);
+
+    /* 지우기: 0x78 뒤 최종 응답, 지운 sector 밖은 0x70 */
+    uint32_t pending = s_uds.pending;
+    CHECK_END(prvErase(FLASHPROG_APP_START, IMG_SIZE) == 5);
+    CHECK_END(s_uds.pending - pending == 2u);                       /* sector 3 (정보) + 4 */
+    CHECK_END(HostFlash_Ptr(FLASHPROG_DIRTY_ADDR)[0] == 0x00u);
+    CHECK_END(prvRequestDownload(0x08040000u, 1024) == BOOT_NRC_UPLOAD_DOWNLOAD_REJECTED);
+
+    /* BSC: 틀린 순서 0x73, 같은 BSC 재전송은 기록 없이 긍정 */
+    CHECK_END(prvRequestDownload(FLASHPROG_APP_START, IMG_SIZE) == 0u);
+    CHECK_END(prvRequestDownload(FLASHPROG_APP_START, IMG_SIZE) == BOOT_NRC_CONDITIONS_NOT_CORRECT);
+    CHECK_END(prvTransfer(2, 0, 1024) == BOOT_NRC_WRONG_BLOCK_SEQUENCE);
+    CHECK_END(prvTransfer(1, 0, 1024) == 0u);
+    CHECK_END(prvTransfer(1, 0, 1024) == 0u);
+    CHECK_END(bootState.repeats == 1u && bootState.done == 1024u);
+    CHECK_END(prvTransfer(2, 1024, 6) == BOOT_NRC_REQUEST_OUT_OF_RANGE);        /* 마지막이 아닌 비정렬 블록 */
+    CHECK_END(prvTransfer(3, 1024, 1024) == BOOT_NRC_WRONG_BLOCK_SEQUENCE);
+
+    /* 나머지 → CRC 불일치 0x72, 앱 무효 */
+    uint8_t bsc = 2;
+    for (uint32_t pos = 1024; pos < IMG_SIZE; pos += 1024u, bsc++) {
+        uint32_t n = (IMG_SIZE - pos > 1024u) ? 1024u : IMG_SIZE - pos;
+        CHECK_END(prvTransfer(bsc, pos, n) == 0u);
+    }
+    CHECK_END(prvTransfer(bsc, 0, 4) == BOOT_NRC_TRANSFER_SUSPENDED);           /* 크기 초과 */
+    CHECK_END(prvExit(UdsClient_Crc32(0, s_img, IMG_SIZE) ^ 1u) == BOOT_NRC_PROGRAMMING_FAILURE);
+    CHECK_END(!FlashProg_AppValid(0));
+    CHECK_END(memcmp(HostFlash_Ptr(FLASHPROG_APP_START), s_img, IMG_SIZE) == 0);   /* 기록 자체는 됨 */
+
+    /* 기록 실패: 블록 중간 word 1 개 PGPERR → 0x36 또는 0x37 에서 0x72 */
+    UdsClient_Report_t rep;
+    HostFlash_FailProgramAt(FLASHPROG_APP_START + 2048u + 8u);
+    CHECK_END(UdsClient_Download(&s_uds, FLASHPROG_APP_START, s_img, IMG_SIZE, &rep) == UDSC_ERR_NRC);
+    CHECK_END(s_uds.last_nrc == BOOT_NRC_PROGRAMMING_FAILURE);
+    CHECK_END(rep.failed_sid == 0x36u || rep.failed_sid == 0x37u);
+    CHECK_END(flashProg.err_addr == FLASHPROG_APP_START + 2048u + 8u);
+    CHECK_END(!FlashProg_AppValid(0));
+    HostFlash_FailProgramAt(0);
+
+    /* 정상 다운로드 */
+    uint32_t resets = bootState.resets;
+    CHECK_END(UdsClient_Download(&s_uds, FLASHPROG_APP_START, s_img, IMG_SIZE, &rep) == UDSC_OK);
+    CHECK_END(rep.blocks == 9u && rep.block_len == FLASHPROG_BLOCK_MAX && rep.failed_sid == 0u);
+    CHECK_END(memcmp(HostFlash_Ptr(FLASHPROG_APP_START), s_img, IMG_SIZE) == 0);
+    CHECK_END(HostFlash_Ptr(FLASHPROG_APP_START + IMG_SIZE)[0] == 0xFFu);      /* 마지막 word 패딩 */
+    CHECK_END(FlashProg_AppValid(1));
+    CHECK_END(flashProg.crc == rep.crc);
+    osDelay(10);
+    CHECK_END(bootState.resets == resets + 1u && HostBootBoard_LastReset() == BOOT_FLAG_NONE);
+
+    /* 압축 (DFI 0x10) */
+    uint32_t crc = UdsClient_Crc32(0, s_img, IMG_SIZE);
+    uint32_t plen = HsEncode(s_img, IMG_SIZE, s_packed, sizeof(s_packed));
+    CHECK_END(plen != 0u && plen < IMG_SIZE);
+    CHECK_END(prvReq((const uint8_t[]){ 0x10, 0x02 }, 2, rsp) == 6);
+    CHECK_END(prvErase(FLASHPROG_APP_START, IMG_SIZE) == 5);
+    CHECK_END(prvRequestDownloadFmt(0x20, FLASHPROG_APP_START, IMG_SIZE) == BOOT_NRC_REQUEST_OUT_OF_RANGE);
+    CHECK_END(prvRequestDownloadFmt(0x11, FLASHPROG_APP_START, IMG_SIZE) == BOOT_NRC_REQUEST_OUT_OF_RANGE);
+
+    /* 원래 크기보다 긴 스트림: 다 푼 뒤 남는 입력 → 0x72 */
+    CHECK_END(prvRequestDownloadFmt(BOOT_DFI_HEATSHRINK, FLASHPROG_APP_START, IMG_SIZE - 100u) == 0u);
+    uint8_t nrc = prvTransferAll(s_packed, plen, 1000u);
+    if (nrc == 0u) nrc = prvExit(crc);
+    CHECK_END(nrc == BOOT_NRC_PROGRAMMING_FAILURE);
+    CHECK_END(flashProg.err_addr == FLASHPROG_APP_START + IMG_SIZE - 100u);
+
+    /* 덜 보낸 스트림 → 0x24, 나머지를 보내면 완료 (블록 경계는 스트림 아무 데나: 333B) */
+    CHECK_END(prvErase(FLASHPROG_APP_START, IMG_SIZE) == 5);
+    CHECK_END(prvRequestDownloadFmt(BOOT_DFI_HEATSHRINK, FLASHPROG_APP_START, IMG_SIZE) == 0u);
+    uint8_t zbsc = 1;
+    uint32_t zpos = 0;
+    for (; zpos + 333u < plen; zpos += 333u, zbsc++) CHECK_END(prvTransferFrom(zbsc, &s_packed[zpos], 333u) == 0u);
+    CHECK_END(prvExit(crc) == BOOT_NRC_REQUEST_SEQUENCE_ERROR);
+    CHECK_END(prvTransferFrom(zbsc, &s_packed[zpos], plen - zpos) == 0u);
+    CHECK_END(prvExit(crc) == 0u);
+    CHECK_END(memcmp(HostFlash_Ptr(FLASHPROG_APP_START), s_img, IMG_SIZE) == 0);
+    CHECK_END(FlashProg_AppValid(1) && flashProg.out == IMG_SIZE);
+
+    /* 클라이언트 압축 다운로드 */
+    s_uds.compress = 1;
+    CHECK_END(UdsClient_Download(&s_uds, FLASHPROG_APP_START, s_img, IMG_SIZE, &rep) == UDSC_OK);
+    CHECK_END(rep.dfi == BOOT_DFI_HEATSHRINK && rep.sent == plen && rep.crc == crc);
+    CHECK_END(memcmp(HostFlash_Ptr(FLASHPROG_APP_START), s_img, IMG_SIZE) == 0);
+    CHECK_END(FlashProg_AppValid(1));
+    s_uds.compress = 0;
+
+    printf("download: requests=%lu frames tx=%lu rx=%lu pending=%lu blocks=%lu repeats=%lu buf_waits=%lu\n",
+           (unsigned long)s_uds.requests, (unsigned long)s_uds.frames_tx, (unsigned long)s_uds.frames_rx,
+           (unsigned long)s_uds.pending, (unsigned long)bootState.blocks, (unsigned long)bootState.repeats,
+           (unsigned long)flashProg.buf_waits);
+    vTaskEndScheduler();
+}
+
+/* 유효한 앱 + 부트 정보를 flash 에 직접 (이전 다운로드 결과). info 0 = 디버거로 올린 앱 */
+static void prvLoadApp(int info_block)
+{
+    FlashProg_Info_t info;
+    for (uint32_t i = 0; i < IMG_SIZE; i++) s_img[i] = (uint8_t)(i ^ 0x5Au);
+    prvPutVectors(s_img);
+    HostFlash_Load(FLASHPROG_APP_START, s_img, IMG_SIZE);
+    if (!info_block) return;
+    info.magic = FLASHPROG_INFO_MAGIC;
+    info.start = FLASHPROG_APP_START;
+    info.size = IMG_SIZE;
+    info.crc = UdsClient_Crc32(0, s_img, IMG_SIZE);
+    info.magic_inv = ~FLASHPROG_INFO_MAGIC;
+    HostFlash_Load(FLASHPROG_INFO_ADDR, &info, sizeof(info));
+}
+
+static void prvWindowTester(void *arg)
+{
+    uint8_t rsp[64];
+    int stay = (arg != NULL);
+
+    HostBootBoard_TesterInit(&s_uds);
+    if (stay) {
+        osDelay(BOOT_WINDOW_MS / 2u);
+        CHECK_END(prvReq((const uint8_t[]){ 0x3E, 0x00 }, 2, rsp) == 2);
+    }
+    osDelay(BOOT_WINDOW_MS * 4u);
+    if (stay) {
+        CHECK_END(bootState.resets == 0u && bootState.stay);
+    } else {
+        CHECK_END(bootState.resets == 1u && HostBootBoard_LastReset() == BOOT_FLAG_JUMP);
+        CHECK_END(prvReq((const uint8_t[]){ 0x3E, 0x00 }, 2, rsp) == 2);   /* 호스트: 리셋 뒤에도 남아 응답 */
+    }
+    printf("%s: resets=%lu requests=%lu\n", stay ? "stay" : "window",
+           (unsigned long)bootState.resets, (unsigned long)bootState.requests);
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = (argc > 1) ? argv[1] : "download";
+    osThreadFunc_t fn = prvDownloadTester;
+    void *arg = NULL;
+
+    if (strcmp(mode, "window") == 0 || strcmp(mode, "stay") == 0 || strcmp(mode, "debug") == 0) {
+        prvLoadApp(strcmp(mode, "debug") != 0);
+        fn = prvWindowTester;
+        arg = (strcmp(mode, "stay") == 0) ? (void *)1 : NULL;
+    } else if (strcmp(mode, "download") != 0) {
+        printf("usage: %s [download|window|stay|debug]\n", argv[0]);
+        return 2;
+    }
+
+    HostBootBoard_Init();
+    HostBootBoard_CreateTasks();
+    if (bootState.stay != (fn == prvDownloadTester)) {
+        printf("FAIL boot %s: stay=%u\n", mode, bootState.stay);
+        return 1;
+    }
+
+    const osThreadAttr_t tester_attr = {
+        .name = "Tester", .stack_size = 512 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    osThreadNew(fn, arg, &tester_attr);
+
+    HostBootBoard_Run(0);
+    if (s_rc == 0) printf("PASS boot %s\n", mode);
+    return s_rc;
+}
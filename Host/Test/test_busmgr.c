@@ -0,0 +1,89 @@
+/*
+ * test_busmgr.c  (Host build)
+ *
+ *  BusMgr DMA 완료 타임아웃 (Core/Src/BusMgr.c)
+ *  - SPI2 flash 읽기 / I2C1 PMIC 읽기 중 DMA 가 끝나지 않으면 (HostSPI/I2C_SetStall)
+ *    HAL_TIMEOUT + 핸들 READY + CS 해제 → 늦은 DMA 가 호출자 버퍼에 쓰지 않고, 다음 전송은 정상
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "BusMgr.h"
+#include "PMIC.h"
+#include "test_check.h"
+
+static int s_rc;
+
+static void prvSpiTimeout(int8_t dev)
+{
+    uint8_t buf[64], ref[64];
+
+    CHECK_RC(BusMgr_Read(dev, 0x100u, ref, sizeof(ref)) == HAL_OK);
+
+    HostSPI_SetStall(SPI2, 1);
+    uint32_t t0 = osKernelGetTickCount();
+    CHECK_RC(BusMgr_Read(dev, 0x100u, buf, sizeof(buf)) == HAL_TIMEOUT);
+    CHECK_RC(osKernelGetTickCount() - t0 >= BUSMGR_TIMEOUT_MS);
+    CHECK_RC(hspi2.State == HAL_SPI_STATE_READY);
+    CHECK_RC((FLASH_CS_GPIO_Port->ODR & FLASH_CS_Pin) != 0u);    // CS 해제
+    HostSPI_SetStall(SPI2, 0);
+
+    memset(buf, 0, sizeof(buf));
+    CHECK_RC(BusMgr_Read(dev, 0x100u, buf, sizeof(buf)) == HAL_OK);
+    CHECK_RC(memcmp(buf, ref, sizeof(buf)) == 0);
+    if (s_rc == 0) printf("PASS busmgr spi timeout\n");
+}
+
+static void prvI2cTimeout(int8_t dev)
+{
+    uint8_t buf[2] = { 0xA5u, 0xA5u }, ref[2];
+
+    CHECK_RC(BusMgr_Read(dev, PMIC_REG_BUCKA_VOUT, ref, sizeof(ref)) == HAL_OK);
+
+    HostI2C_SetStall(I2C1, 1);
+    CHECK_RC(BusMgr_Read(dev, PMIC_REG_BUCKA_VOUT, buf, sizeof(buf)) == HAL_TIMEOUT);
+    CHECK_RC(hi2c1.State == HAL_I2C_STATE_READY);
+    HostI2C_SetStall(I2C1, 0);
+
+    osDelay(BUSMGR_TIMEOUT_MS);                 // 중단된 전송은 나중에도 버퍼를 건드리지 않음
+    CHECK_RC(buf[0] == 0xA5u && buf[1] == 0xA5u);
+    CHECK_RC(BusMgr_Read(dev, PMIC_REG_BUCKA_VOUT, buf, sizeof(buf)) == HAL_OK);
+    CHECK_RC(memcmp(buf, ref, sizeof(buf)) == 0);
+    if (s_rc == 0) printf("PASS busmgr i2c timeout\n");
+}
+
+static void prvTestTask(void *argument)
+{
+    (void)argument;
+    prvSpiTimeout(BusMgr_Find("flash0"));
+    prvI2cTimeout(BusMgr_Find("pmic0"));
+    CHECK_RC(busTable[BUS_SPI2].errors == 1u && busTable[BUS_I2C1].errors == 1u);
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    static const BusDev_t devs[] = {
+        { "pmic0",  BUSDEV_PMIC,      BUS_I2C1, I2C_SLAVE_ADDRESS, NULL,               0            },
+        { "flash0", BUSDEV_SPI_FLASH, BUS_SPI2, 0,                 FLASH_CS_GPIO_Port, FLASH_CS_Pin },
+    };
+
+    HostBoard_Init();
+    for (uint32_t i = 0; i < 64u; i++) g_flash.mem[0x100u + i] = (uint8_t)(i * 7u);
+
+    osKernelInitialize();
+    BusMgr_Init();
+    for (uint32_t i = 0; i < sizeof(devs) / sizeof(devs[0]); i++) {
+        if (BusMgr_Register(&devs[i]) < 0) return 1;
+    }
+
+    const osThreadAttr_t test_attributes = {
+      .name = "BusMgrTest", .stack_size = 512 * 4, .priority = (osPriority_t)osPriorityNormal,
+    };
+    osThreadNew(prvTestTask, NULL, &test_attributes);
+    HostBoard_Run(0u);
+    return s_rc;
+}
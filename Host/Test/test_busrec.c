@@ -0,0 +1,196 @@
+/*
+ * test_busrec.c  (Host build)
+ *
+ *  버스 트래픽 기록/재생 (Core/Src/BusRec.c, Host/Src/host_replay.c, 전체 보드 Task 구성)
+ *    record <file>: EEPROM 초기 내용 + PMIC UV fault 발생/해제 + UDS 요청 2 개 → UART4 'B' 덤프를 파일로
+ *    replay <file>: 외부 자극 없이 기록만 재생
+ *                   → 버스별 출력 (CAN 송신, EEPROM/PMIC 쓰기) 이 기록과 같은 순서/내용, DTC C123 이력, UDS 응답
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_board.h"
+#include "host_replay.h"
+#include "host_sim.h"
+#include "test_check.h"
+
+#define DUMP_AT_US        350000u
+#define DUMP_TIMEOUT_MS   20000u
+#define DUMP_LAG_US       7000u      /* UARTTask 는 파이프라인 차례 (CommMutex, 6ms 주기) 를 기다린 뒤 명령 처리 */
+
+static int s_rc;
+
+/* ===== UART4 캡처 (파이프라인 원시 DTC 2B 와 덤프 텍스트가 섞임) ===== */
+static char    *s_uart;
+static uint32_t s_uart_len, s_uart_cap;
+static volatile int s_dump_done;
+
+static void prvOnUart(void *ctx, const uint8_t *data, uint16_t len)
+{
+    (void)ctx;
+    if (s_uart_len + len > s_uart_cap) {
+        s_uart_cap = (s_uart_cap == 0u) ? 65536u : s_uart_cap * 2u;
+        s_uart = realloc(s_uart, s_uart_cap);
+        if (s_uart == NULL) abort();
+    }
+    memcpy(&s_uart[s_uart_len], data, len);
+    s_uart_len += len;
+}
+
+/* ===== CAN: UDS 응답 (pipeline 프레임은 2B, UDS 는 8B 로 구분) ===== */
+static uint32_t s_rsp_3e, s_rsp_19;
+
+static void prvOnCan(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != UDS_RES_CANID || f->dlc != 8u) return;
+    if (f->data[1] == 0x7Eu) s_rsp_3e++;
+    if (f->data[1] == 0x59u && f->data[2] == 0x01u) s_rsp_19++;
+}
+
+/* ===== 기록 자극 ===== */
+static void prvFaultOn(void *arg)  { (void)arg; MMP5475_InjectFault(&g_pmic, PMIC_REG_UV_OV, PMIC_UV_A_Msk); }
+static void prvFaultOff(void *arg) { (void)arg; MMP5475_ClearFault(&g_pmic, PMIC_REG_UV_OV, PMIC_UV_A_Msk); }
+
+static void prvTesterPresent(void *arg)
+{
+    static const uint8_t req[8] = { 0x02, 0x3E, 0x00 };
+    (void)arg;
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, req, sizeof(req));
+}
+
+static void prvReadDtcCount(void *arg)
+{
+    static const uint8_t req[8] = { 0x03, 0x19, 0x01, 0xFF };
+    (void)arg;
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, req, sizeof(req));
+}
+
+static void prvDumpCmd(void *arg)
+{
+    static const uint8_t cmd[1] = { UART_CMD_BUSREC };
+    (void)arg;
+    (void)HostUART_Inject(UART4, cmd, sizeof(cmd));
+}
+
+/* 덤프 끝 ("\nE\n") 까지 기다린 뒤 종료 */
+static void prvWaitDump(void *argument)
+{
+    (void)argument;
+    for (uint32_t t = 0; t < DUMP_TIMEOUT_MS && !s_dump_done; t += 10u) {
+        osDelay(10);
+        for (uint32_t i = 0; i + 3u <= s_uart_len && !s_dump_done; i++) {
+            if (memcmp(&s_uart[i], "BUSREC v=", 9) != 0) continue;
+            for (uint32_t j = i; j + 3u <= s_uart_len; j++) {
+                if (memcmp(&s_uart[j], "\nE\n", 3) == 0) { s_dump_done = 1; break; }
+            }
+        }
+    }
+    vTaskEndScheduler();
+}
+
+static int prvHasDtc(uint32_t dtc)
+{
+    DTC_Record_t rec[DTCMEM_SLOTS];
+    uint16_t n = DTCMem_ReadByMask(&dtcMem, DTC_ST_TFSLC, rec, DTCMEM_SLOTS);
+    for (uint16_t i = 0; i < n && i < DTCMEM_SLOTS; i++) {
+        if (rec[i].dtc[0] == (uint8_t)(dtc >> 16) && rec[i].dtc[1] == (uint8_t)(dtc >> 8) && rec[i].dtc[2] == (uint8_t)dtc) return 1;
+    }
+    return 0;
+}
+
+static void prvPrint(const char *line)
+{
+    fputs(line, stdout);
+}
+
+static int prvRecord(const char *path)
+{
+    HostReplay_Log_t log;
+
+    HostBoard_Init();
+    g_eeprom.mem[0] = 0x12u;            // 부팅 직후 파이프라인이 읽는 값 (재생은 기록에서 복원)
+    g_eeprom.mem[1] = 0x34u;
+    HostUART_SetTxListener(UART4, prvOnUart, NULL);
+    HostCAN_AddNode(CAN1, prvOnCan, NULL);
+    HostBoard_CreateTasks();
+    const osThreadAttr_t tester_attributes = {
+      .name = "Tester", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    (void)osThreadNew(prvWaitDump, NULL, &tester_attributes);
+    HostSim_Schedule(100000u, prvFaultOn, NULL);
+    HostSim_Schedule(200000u, prvFaultOff, NULL);
+    HostSim_Schedule(250000u, prvTesterPresent, NULL);
+    HostSim_Schedule(300000u, prvReadDtcCount, NULL);
+    HostSim_Schedule(DUMP_AT_US, prvDumpCmd, NULL);
+
+    HostBoard_Run(0u);
+
+    CHECK_RC(s_dump_done);
+    CHECK_RC(s_rsp_3e == 1u && s_rsp_19 == 1u);
+    CHECK_RC(prvHasDtc(0xC12300u));
+    CHECK_RC(HostReplay_Parse(s_uart, s_uart_len, &log) == 0);
+    if (s_rc != 0) return s_rc;
+
+    uint32_t can_rx = 0, can_tx = 0, i2c_rd = 0, spi = 0;
+    for (uint32_t i = 0; i < log.n; i++) {
+        const HostReplay_Rec_t *r = &log.rec[i];
+        if (r->bus == BUSREC_BUS_CAN1) { can_rx += (r->op == BUSREC_OP_RX); can_tx += (r->op == BUSREC_OP_TX); }
+        else if (r->bus == BUS_I2C1)   i2c_rd += (r->op == BUSREC_OP_RD);
+        else                           spi++;
+        CHECK_RC(r->t_us <= DUMP_AT_US + DUMP_LAG_US);
+        CHECK_RC(i == 0u || r->t_us + 1000u >= log.rec[i - 1u].t_us);     // 선점으로 뒤바뀌어도 짧게
+    }
+    CHECK_RC(log.dropped == 0u);
+    CHECK_RC(can_rx == 2u);
+    CHECK_RC(can_tx > 2u && i2c_rd > 0u && spi > 0u);
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) { perror(path); return 1; }
+    fwrite(s_uart, 1, s_uart_len, fp);
+    fclose(fp);
+
+    printf("recorded %lu records (can rx=%lu tx=%lu, i2c rd=%lu, spi=%lu) dump=%lu B\n", (unsigned long)log.n,
+           (unsigned long)can_rx, (unsigned long)can_tx, (unsigned long)i2c_rd, (unsigned long)spi,
+           (unsigned long)s_uart_len);
+    HostReplay_Free(&log);
+    if (s_rc == 0) printf("PASS busrec record\n");
+    return s_rc;
+}
+
+static int prvReplay(const char *path)
+{
+    HostReplay_Stats_t st;
+
+    HostBoard_Init();
+    HostCAN_AddNode(CAN1, prvOnCan, NULL);
+    if (HostReplay_Load(path) != 0) {
+        printf("FAIL cannot load %s\n", path);
+        return 1;
+    }
+    HostBoard_CreateTasks();
+    CHECK_RC(HostReplay_Start() == 0);
+    HostReplay_GetStats(&st);
+    CHECK_RC(st.can_rx == 2u && st.reg_updates >= 2u && st.seeded >= 2u && st.skipped == 0u);
+
+    HostBoard_Run(HostReplay_DurationMs(50u));
+
+    CHECK_RC(HostReplay_Compare(prvPrint) == 0u);
+    CHECK_RC(s_rsp_3e == 1u && s_rsp_19 == 1u);
+    CHECK_RC(prvHasDtc(0xC12300u));
+    if (s_rc == 0) printf("PASS busrec replay\n");
+    return s_rc;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "record") == 0) return prvRecord(argv[2]);
+    if (argc == 3 && strcmp(argv[1], "replay") == 0) return prvReplay(argv[2]);
+    fprintf(stderr, "usage: %s record|replay <file>\n", argv[0]);
+    return 2;
+}
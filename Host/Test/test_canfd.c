@@ -0,0 +1,285 @@
+/*
+ * test_canfd.c  (Host build)
+ *
+ *  같은 UDS 시나리오를 classic CAN 과 CAN FD (외부 컨트롤러 모델) 로 (전체 보드 Task 구성).
+ *  테스터 Task 가 ISO-TP 를 따로 구현 (TX_DL 8 / 64) 해 요청/응답을 주고받는다.
+ *    - DLC ↔ 길이 표, 패딩 길이
+ *    - 0x10 / 0x22 (SF, classic 은 FF+CF 인 20B 응답이 FD 는 escape SF), DID 16 개 (33B 요청)
+ *    - 멀티 프레임 요청 (DID 40 개 → 0x13): FD 는 FF 64B + CF, DUT FC 는 8B
+ *    - 기능 주소 0x22 (SF)
+ *    - 0x19 02: DTC 메모리를 slot 24 개까지 채운 뒤 전체 목록 (99B, DTC 메모리 원본과 비교)
+ *    - 프레임 길이: FF / 중간 CF = RX_DL, 마지막 CF 와 SF 는 다음 유효 DLC 길이까지 패딩
+ *  0x19 02 응답 (DTC 24 개, 99B: classic FF + CF 14 개, FD FF + CF 1 개) 을 여러 번 읽어
+ *  요청 → 마지막 CF 시간과 프레임 수를 낸다.
+ *    usage: test_canfd classic | fd | fd_brs   (fd: TX_DL 64 + 333k, fd_brs: + 데이터 2Mbit/s)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "DTCMem.h"
+#include "test_check.h"
+
+#define RX_RING     32u
+#define WAIT_MS     (ISOTP_N_BS_MS + 500u)
+#define FD_DATA_BPS 2000000u
+#define BIG_LEN     (3u + 4u * DTCMEM_SLOTS)  /* 59 02 avail + DTC 24 개 → 99B */
+#define BIG_ROUNDS  8u
+
+static int          s_rc;
+static osThreadId_t s_tester;
+static uint8_t      s_dl = 8;                 /* 테스터 TX_DL = DUT TX_DL */
+static const char  *s_mode;
+
+/* ===== 테스터 노드 ===== */
+static HostCAN_Frame_t   s_rx[RX_RING];
+static volatile uint32_t s_rx_head, s_rx_tail;
+static uint32_t          s_frames;            /* 마지막 요청의 응답 프레임 수 */
+
+static void prvNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != UDS_RES_CANID) return;
+    if (s_dl > 8u ? !f->fd : (f->fd || f->dlc != 8u)) return;   /* 파이프라인 DTC 프레임 (classic DLC 2) 제외 */
+    s_rx[s_rx_head % RX_RING] = *f;
+    s_rx_head++;
+    osThreadFlagsSet(s_tester, 1u);
+}
+
+static int prvNext(HostCAN_Frame_t *f)
+{
+    while (s_rx_tail == s_rx_head) {
+        if (osThreadFlagsWait(1u, osFlagsWaitAny, WAIT_MS) == (uint32_t)osErrorTimeout) return 0;
+    }
+    *f = s_rx[s_rx_tail % RX_RING];
+    s_rx_tail++;
+    return 1;
+}
+
+/* 데이터 + 패딩 → 프레임 길이 (classic 은 항상 8) */
+static uint8_t prvPad(uint8_t *frame, uint8_t used)
+{
+    uint8_t len = IsoTp_PadLen(used);
+    memset(&frame[used], 0xAA, (size_t)(len - used));
+    return len;
+}
+
+static void prvSend(uint32_t id, const uint8_t *frame, uint8_t len)
+{
+    if (s_dl > 8u) (void)HostCAN_InjectFd(CAN1, id, frame, len);
+    else           (void)HostCAN_Inject(CAN1, id, frame, len);
+}
+
+/* 요청 (SF / escape SF / FF+CF) → 최종 응답 재조립 (0x78 건너뜀). 반환: 응답 길이, 실패 0.
+ * *t_us = 요청 첫 프레임 주입 → 응답 마지막 프레임 */
+static uint16_t prvRequestOn(uint32_t id, const uint8_t *req, uint16_t len, uint8_t *rsp, uint64_t *t_us)
+{
+    uint8_t frame[64];
+    HostCAN_Frame_t f;
+    uint64_t t0 = HostSim_NowUs();
+
+    s_rx_tail = s_rx_head;
+    s_frames = 0;
+    osThreadFlagsClear(1u);
+    if (len <= 7u) {
+        frame[0] = (uint8_t)len;
+        memcpy(&frame[1], req, len);
+        prvSend(id, frame, prvPad(frame, (uint8_t)(1u + len)));
+    } else if (len <= s_dl - 2u) {
+        frame[0] = 0;
+        frame[1] = (uint8_t)len;
+        memcpy(&frame[2], req, len);
+        prvSend(id, frame, prvPad(frame, (uint8_t)(2u + len)));
+    } else {
+        uint16_t pos = (uint16_t)(s_dl - 2u);
+        uint8_t sn = 1;
+        frame[0] = (uint8_t)(0x10u | (len >> 8));
+        frame[1] = (uint8_t)len;
+        memcpy(&frame[2], req, pos);
+        prvSend(id, frame, s_dl);
+        /* DUT FC: CTS, BS=0, 8B */
+        if (!prvNext(&f) || f.data[0] != 0x30u || f.data[1] != 0u || f.dlc != 8u) return 0;
+        while (pos < len) {
+            uint16_t n = (uint16_t)((len - pos) > s_dl - 1u ? s_dl - 1u : (len - pos));
+            frame[0] = (uint8_t)(0x20u | sn);
+            memcpy(&frame[1], &req[pos], n);
+            prvSend(id, frame, prvPad(frame, (uint8_t)(1u + n)));
+            pos = (uint16_t)(pos + n);
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+        }
+    }
+
+    for (;;) {
+        if (!prvNext(&f)) return 0;
+        s_frames++;
+        uint8_t type = f.data[0] & 0xF0u;
+        if (type == 0x00u) {
+            const uint8_t *d = &f.data[1];
+            uint8_t n = f.data[0];
+            if (n == 0u) {                                           /* escape SF */
+                n = f.data[1];
+                d = &f.data[2];
+                if (f.dlc <= 8u || n <= 7u) return 0;
+            }
+            if (f.dlc != IsoTp_PadLen((uint8_t)(d - f.data + n))) return 0;
+            if (d[0] == UDS_SID_NEGATIVE_RESPONSE && d[2] == UDS_NRC_RESPONSE_PENDING) continue;
+            memcpy(rsp, d, n);
+            if (t_us != NULL) *t_us = f.t_us - t0;
+            return n;
+        }
+        if (type != 0x10u || f.dlc != s_dl) return 0;
+
+        /* RX_DL = FF 길이: 중간 CF 는 RX_DL, 마지막 CF 는 패딩 길이 */
+        uint16_t total = (uint16_t)(((f.data[0] & 0x0Fu) << 8) | f.data[1]);
+        uint16_t pos = (uint16_t)(s_dl - 2u);
+        uint8_t sn = 1;
+        memcpy(rsp, &f.data[2], pos);
+        const uint8_t fc[8] = { 0x30, 0x00, 0x00, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+        prvSend(UDS_REQ_CANID, fc, 8);
+        while (pos < total) {
+            if (!prvNext(&f) || f.data[0] != (0x20u | sn)) return 0;
+            s_frames++;
+            uint16_t n = (uint16_t)((total - pos) > s_dl - 1u ? s_dl - 1u : (total - pos));
+            if (f.dlc != ((pos + n < total) ? s_dl : IsoTp_PadLen((uint8_t)(1u + n)))) return 0;
+            memcpy(&rsp[pos], &f.data[1], n);
+            pos = (uint16_t)(pos + n);
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+        }
+        if (t_us != NULL) *t_us = f.t_us - t0;
+        return total;
+    }
+}
+
+static uint16_t prvRequest(const uint8_t *req, uint16_t len, uint8_t *rsp)
+{
+    return prvRequestOn(UDS_REQ_CANID, req, len, rsp, NULL);
+}
+
+static int prvIsNrc(const uint8_t *rsp, uint16_t n, uint8_t sid, uint8_t nrc)
+{
+    return n == 3u && rsp[0] == UDS_SID_NEGATIVE_RESPONSE && rsp[1] == sid && rsp[2] == nrc;
+}
+
+static void prvTester(void *argument)
+{
+    static uint8_t rsp[ISOTP_MAX_LEN], req[128];
+    uint16_t n;
+    (void)argument;
+
+    static const uint8_t sess3[2] = { 0x10, 0x03 };
+    n = prvRequest(sess3, 2, rsp);
+    CHECK_END(n == 6u && rsp[0] == 0x50u && rsp[1] == 0x03u && s_frames == 1u);
+
+    /* VIN 20B: classic FF + CF 2 개, FD escape SF 1 개 (24B 프레임) */
+    static const uint8_t vin[3] = { 0x22, 0xF1, 0x90 };
+    n = prvRequest(vin, 3, rsp);
+    CHECK_END(n == 20u && rsp[0] == 0x62u && memcmp(&rsp[3], "KNACOMENTO0000001", 17) == 0);
+    CHECK_END(s_frames == (s_dl > 8u ? 1u : 3u));
+
+    /* DID 16 개 (33B 요청: classic FF+CF, FD escape SF) */
+    static const uint16_t dids[16] = { 0xD100, 0xD101, 0xD102, 0xD110, 0xD111, 0xD112, 0xD120, 0xD121,
+                                       0xD122, 0xD123, 0xD124, 0xD130, 0xD131, 0xD140, 0xF18C, 0xF190 };
+    req[0] = 0x22;
+    for (uint32_t i = 0; i < 16u; i++) { req[1u + 2u * i] = (uint8_t)(dids[i] >> 8); req[2u + 2u * i] = (uint8_t)dids[i]; }
+    n = prvRequest(req, 33, rsp);
+    CHECK_END(n > 62u && rsp[0] == 0x62u && rsp[1] == 0xD1u && rsp[2] == 0x00u);
+
+    /* DID 40 개 (81B 요청: FD 도 FF + CF) → DUT 가 재조립 후 0x13 */
+    req[0] = 0x22;
+    for (uint32_t i = 0; i < 40u; i++) { req[1u + 2u * i] = 0xF1; req[2u + 2u * i] = 0x90; }
+    n = prvRequest(req, 81, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x22, UDS_NRC_INCORRECT_LENGTH));
+
+    /* 기능 주소 (SF 만) */
+    static const uint8_t sessRd[3] = { 0x22, 0xF1, 0x86 };
+    n = prvRequestOn(UDS_FUNC_REQ_CANID, sessRd, 3, rsp, NULL);
+    CHECK_END(n == 4u && rsp[0] == 0x62u && rsp[3] == UDS_SESSION_EXTENDED);
+
+    /* DTC 메모리 채우기 (mount 후, 빈 slot 이 없을 때까지) → 0x19 01 개수 */
+    while (!DTCMem_Ready(&dtcMem)) osDelay(10);
+    for (uint32_t i = 0; i < 0x100u; i++) {
+        const uint8_t dtc[3] = { 0xC1, 0x40, (uint8_t)i };
+        if (DTCMem_Report(&dtcMem, dtc, true) != HAL_OK) break;
+    }
+    static const uint8_t cnt[3] = { 0x19, 0x01, 0xFF };
+    n = prvRequest(cnt, 3, rsp);
+    CHECK_END(n == 6u && rsp[0] == 0x59u && rsp[4] == 0u && rsp[5] == DTCMEM_SLOTS);
+
+    /* 59 02: DTC 24 개 (slot 순서, 상태는 avail mask) */
+    static const uint8_t list[3] = { 0x19, 0x02, 0xFF };
+    static DTC_Record_t recs[DTCMEM_SLOTS];
+    uint64_t t_sum = 0, t_min = UINT64_MAX, t_max = 0;
+    for (uint32_t r = 0; r < BIG_ROUNDS; r++) {
+        uint64_t t = 0;
+        memset(rsp, 0, sizeof(rsp));
+        n = prvRequestOn(UDS_REQ_CANID, list, 3, rsp, &t);
+        CHECK_END(n == BIG_LEN && rsp[0] == 0x59u && rsp[1] == 0x02u && rsp[2] == DTCMEM_STATUS_AVAIL);
+        CHECK_END(DTCMem_ReadByMask(&dtcMem, 0xFF, recs, DTCMEM_SLOTS) == DTCMEM_SLOTS);
+        for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+            CHECK_END(memcmp(&rsp[3u + 4u * i], recs[i].dtc, 3) == 0 && rsp[6u + 4u * i] == recs[i].status);
+        }
+        /* FF + CF: classic 6 + 7x14, FD 62 + 63x1 */
+        CHECK_END(s_frames == 1u + (BIG_LEN - (s_dl - 2u) + (s_dl - 2u)) / (s_dl - 1u));
+        t_sum += t;
+        if (t < t_min) t_min = t;
+        if (t > t_max) t_max = t;
+    }
+
+    HostCAN_Stats_t cs;
+    HostCAN_GetStats(CAN1, &cs);
+    unsigned long avg = (unsigned long)(t_sum / BIG_ROUNDS);
+    printf("canfd %-7s tx_dl=%2u rsp=%uB frames=%lu  %lu us per 59 02 response (min %lu, max %lu)  %lu B/s\n",
+           s_mode, (unsigned)s_dl, (unsigned)BIG_LEN, (unsigned long)s_frames, avg,
+           (unsigned long)t_min, (unsigned long)t_max,
+           (unsigned long)((uint64_t)BIG_LEN * 1000000u / (avg ? avg : 1u)));
+    printf("  bus: tx %lu frames, rx %lu frames, busy %llu us, no-buffer %lu\n",
+           (unsigned long)cs.tx_frames, (unsigned long)cs.rx_frames, (unsigned long long)cs.busy_us,
+           (unsigned long)cs.tx_no_mailbox);
+
+    if (s_rc == 0) printf("PASS canfd %s\n", s_mode);
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t data_bps = 0;
+
+    s_mode = (argc > 1) ? argv[1] : "classic";
+    if (!strcmp(s_mode, "fd"))               s_dl = 64;
+    else if (!strcmp(s_mode, "fd_brs"))      s_dl = 64, data_bps = FD_DATA_BPS;
+    else if (strcmp(s_mode, "classic") != 0) {
+        fprintf(stderr, "usage: %s classic|fd|fd_brs\n", argv[0]);
+        return 2;
+    }
+
+    /* DLC ↔ 길이, 패딩 길이 */
+    static const uint8_t lens[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+    for (uint8_t dlc = 0; dlc < 16u; dlc++) {
+        if (IsoTp_DlcToLen(dlc) != lens[dlc] || IsoTp_LenToDlc(lens[dlc]) != dlc) {
+            printf("FAIL dlc %u\n", dlc);
+            return 1;
+        }
+    }
+    if (IsoTp_LenToDlc(9) != 9u || IsoTp_LenToDlc(33) != 14u || IsoTp_LenToDlc(63) != 15u ||
+        IsoTp_PadLen(3) != 8u || IsoTp_PadLen(9) != 12u || IsoTp_PadLen(22) != 24u || IsoTp_PadLen(64) != 64u) {
+        printf("FAIL dlc rounding\n");
+        return 1;
+    }
+
+    HostBoard_Init();
+    HostCAN_AddNode(CAN1, prvNode, NULL);
+    if (s_dl > 8u) HostBoard_UseCanFd(s_dl, data_bps);
+    HostBoard_CreateTasks();
+    const osThreadAttr_t tester_attributes = {
+      .name = "Tester", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    s_tester = osThreadNew(prvTester, NULL, &tester_attributes);
+
+    HostBoard_Run(0u);
+    return s_rc;
+}
@@ -0,0 +1,22 @@
+/*
+ * test_check.h  (Host build)
+ *
+ *  테스트/벤치 공통 검사 매크로. 실패하면 "FAIL 파일:줄: 조건" 을 출력한다.
+ *  - CHECK     : main 등 int 를 반환하는 함수에서 바로 return 1
+ *  - CHECK_END : Task 안 (보드 시나리오). s_rc = 1 + 스케줄러 종료
+ *  - CHECK_RC  : s_rc = 1 만 (나머지 검사를 계속 진행)
+ *  CHECK_END / CHECK_RC 는 파일마다 static int s_rc 가 있어야 한다.
+ */
+
+#ifndef TEST_CHECK_H_
+#define TEST_CHECK_H_
+
+#include <stdio.h>
+
+#define CHECK_FAIL(s)   printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, s)
+
+#define CHECK(c)        do { if (!(c)) { CHECK_FAIL(#c); return 1; } } while (0)
+#define CHECK_END(c)    do { if (!(c)) { CHECK_FAIL(#c); s_rc = 1; vTaskEndScheduler(); } } while (0)
+#define CHECK_RC(c)     do { if (!(c)) { CHECK_FAIL(#c); s_rc = 1; } } while (0)
+
+#endif /* TEST_CHECK_H_ */
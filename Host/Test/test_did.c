@@ -0,0 +1,392 @@
+/*
+ * test_did.c  (Host build)
+ *
+ *  0x22 / 0x2E DID 엔진 + ISO-TP 멀티 프레임 (전체 보드 Task 구성).
+ *  테스터 Task 가 ISO-TP 를 따로 구현해 요청/응답을 주고받는다 (DUT 의 IsoTp.c 와 독립).
+ *    - 표: 오름차순/형식 검사, 순서가 틀린 표 거부
+ *    - 읽기: SF 응답, 여러 DID → FF + CF (테스터 FC: BS/STmin 준수 확인), 미지원 DID 생략/0x31,
+ *            요청 자체가 멀티 프레임 (DID 17 개 → 0x13, DID 16 개 → 305B 응답)
+ *    - 쓰기: default 세션 0x31, 보안 잠김 0x33, 값 검사 0x31, 기록 후 다시 읽기
+ *    - 기능 주소 0x22: 지원 DID 는 응답, 미지원은 응답 없음
+ *    - 메모리 풀 DID (D160): 사용 중 / 최대 동시 사용 / 고갈 횟수
+ *    - 0x2A: 길이/모드/미지원 pDID NRC, 주기 프레임 간격, 주기 변경/일부 정지, 세션 전환 시 정지
+ *            송신 대기열에 PDID_MAX 개가 모두 쌓여도 (메일박스 없음이 계속) 비어 보이지 않음
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "test_check.h"
+
+#define RX_RING     64u
+#define WAIT_MS     (ISOTP_N_BS_MS + 500u)
+
+static int          s_rc;
+static osThreadId_t s_tester;
+
+/* 0x2A 대기열 가득 참: 별도 스케줄러 + 합성 표 (F200 ~ F200 + PDID_MAX - 1) */
+static PDID_Sched_t s_pdFull;
+static DID_Entry_t  s_pdEntries[PDID_MAX];
+static uint8_t      s_pdLive[PDID_MAX];
+static DID_Table_t  s_pdTable = { s_pdEntries, PDID_MAX };
+static int          s_pdBusy;
+static uint32_t     s_pdFrames;
+
+static HAL_StatusTypeDef prvPdSend(const uint8_t *frame)
+{
+    (void)frame;
+    if (s_pdBusy) return HAL_BUSY;
+    s_pdFrames++;
+    return HAL_OK;
+}
+
+/* ===== 테스터 노드 ===== */
+static HostCAN_Frame_t   s_rx[RX_RING];
+static volatile uint32_t s_rx_head, s_rx_tail;
+static uint64_t          s_min_cf_gap_us;
+
+/* 0x2A 주기 프레임: pDID 별 수 / 간격 */
+typedef struct {
+    uint32_t count;
+    uint64_t last_us, min_gap_us, max_gap_us;
+    uint8_t  data[7];
+} PeriodicRx_t;
+static PeriodicRx_t s_per[256];
+
+static void prvNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id == UDS_PERIODIC_CANID) {
+        PeriodicRx_t *p = &s_per[f->data[0]];
+        uint64_t gap = f->t_us - p->last_us;
+        if (p->count != 0u && gap < p->min_gap_us) p->min_gap_us = gap;
+        if (p->count != 0u && gap > p->max_gap_us) p->max_gap_us = gap;
+        p->last_us = f->t_us;
+        p->count++;
+        memcpy(p->data, &f->data[1], 7);
+        return;
+    }
+    if (f->id != UDS_RES_CANID || f->dlc != 8u) return;      /* 파이프라인 DTC 프레임(DLC 2) 제외 */
+    s_rx[s_rx_head % RX_RING] = *f;
+    s_rx_head++;
+    osThreadFlagsSet(s_tester, 1u);
+}
+
+static int prvNext(HostCAN_Frame_t *f)
+{
+    while (s_rx_tail == s_rx_head) {
+        if (osThreadFlagsWait(1u, osFlagsWaitAny, WAIT_MS) == (uint32_t)osErrorTimeout) return 0;
+    }
+    *f = s_rx[s_rx_tail % RX_RING];
+    s_rx_tail++;
+    return 1;
+}
+
+static void prvSend(uint32_t id, const uint8_t *frame)
+{
+    (void)HostCAN_Inject(CAN1, id, frame, 8);
+}
+
+static void prvSendFc(uint8_t bs, uint8_t stmin)
+{
+    const uint8_t fc[8] = { 0x30, bs, stmin, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+    prvSend(UDS_REQ_CANID, fc);
+}
+
+/* 요청 (SF 또는 FF+CF) → 최종 응답 재조립 (0x78 건너뜀). 반환: 응답 길이, 실패 0 */
+static uint16_t prvRequestOn(uint32_t id, const uint8_t *req, uint16_t len, uint8_t *rsp, uint8_t bs, uint8_t stmin)
+{
+    uint8_t frame[8];
+    HostCAN_Frame_t f;
+
+    s_rx_tail = s_rx_head;
+    osThreadFlagsClear(1u);
+    if (len <= 7u) {
+        memset(frame, 0xAA, 8);
+        frame[0] = (uint8_t)len;
+        memcpy(&frame[1], req, len);
+        prvSend(id, frame);
+    } else {
+        uint16_t pos = 6;
+        uint8_t sn = 1;
+        frame[0] = (uint8_t)(0x10u | (len >> 8));
+        frame[1] = (uint8_t)len;
+        memcpy(&frame[2], req, 6);
+        prvSend(id, frame);
+        if (!prvNext(&f) || f.data[0] != 0x30u || f.data[1] != 0u) return 0;    /* DUT FC: CTS, BS=0 */
+        while (pos < len) {
+            uint16_t n = (uint16_t)((len - pos) > 7u ? 7u : (len - pos));
+            memset(frame, 0xAA, 8);
+            frame[0] = (uint8_t)(0x20u | sn);
+            memcpy(&frame[1], &req[pos], n);
+            prvSend(id, frame);
+            pos = (uint16_t)(pos + n);
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+        }
+    }
+
+    for (;;) {
+        if (!prvNext(&f)) return 0;
+        uint8_t type = f.data[0] & 0xF0u;
+        if (type == 0x00u) {
+            if (f.data[1] == UDS_SID_NEGATIVE_RESPONSE && f.data[3] == UDS_NRC_RESPONSE_PENDING) continue;
+            memcpy(rsp, &f.data[1], f.data[0]);
+            return f.data[0];
+        }
+        if (type != 0x10u) return 0;
+
+        uint16_t total = (uint16_t)(((f.data[0] & 0x0Fu) << 8) | f.data[1]);
+        uint16_t pos = 6;
+        uint8_t sn = 1;
+        uint32_t blk = 0;
+        uint64_t t_prev = 0;
+        memcpy(rsp, &f.data[2], 6);
+        prvSendFc(bs, stmin);
+        while (pos < total) {
+            if (!prvNext(&f) || f.data[0] != (0x20u | sn)) return 0;
+            if (blk != 0u && f.t_us - t_prev < s_min_cf_gap_us) s_min_cf_gap_us = f.t_us - t_prev;
+            t_prev = f.t_us;
+            uint16_t n = (uint16_t)((total - pos) > 7u ? 7u : (total - pos));
+            memcpy(&rsp[pos], &f.data[1], n);
+            pos = (uint16_t)(pos + n);
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+            if (bs != 0u && ++blk % bs == 0u && pos < total) {
+                prvSendFc(bs, stmin);
+                blk = 0;
+            } else if (bs == 0u) {
+                blk++;
+            }
+        }
+        return total;
+    }
+}
+
+static uint16_t prvRequest(const uint8_t *req, uint16_t len, uint8_t *rsp)
+{
+    return prvRequestOn(UDS_REQ_CANID, req, len, rsp, 0, 0);
+}
+
+static int prvIsNrc(const uint8_t *rsp, uint16_t n, uint8_t sid, uint8_t nrc)
+{
+    return n == 3u && rsp[0] == UDS_SID_NEGATIVE_RESPONSE && rsp[1] == sid && rsp[2] == nrc;
+}
+
+static void prvUnlock(void)
+{
+    static const uint8_t sess3[2] = { 0x10, 0x03 };
+    static const uint8_t seedReq[2] = { 0x27, 0x01 };
+    uint8_t rsp[16];
+
+    (void)prvRequest(sess3, 2, rsp);
+    (void)prvRequest(seedReq, 2, rsp);
+    uint32_t key = UDS_SecurityKey(((uint32_t)rsp[2] << 24) | ((uint32_t)rsp[3] << 16) | ((uint32_t)rsp[4] << 8) | rsp[5]);
+    const uint8_t keyReq[6] = { 0x27, 0x02, (uint8_t)(key >> 24), (uint8_t)(key >> 16), (uint8_t)(key >> 8), (uint8_t)key };
+    (void)prvRequest(keyReq, 6, rsp);
+}
+
+static void prvTester(void *argument)
+{
+    static uint8_t rsp[ISOTP_MAX_LEN], req[64];
+    uint16_t n;
+    (void)argument;
+
+    osDelay(5);
+
+    /* SF 응답 */
+    static const uint8_t rdSess[3] = { 0x22, 0xF1, 0x86 };
+    n = prvRequest(rdSess, 3, rsp);
+    CHECK_END(n == 4u && rsp[0] == 0x62 && rsp[1] == 0xF1 && rsp[2] == 0x86 && rsp[3] == UDS_SESSION_DEFAULT);
+
+    /* live 값 (big-endian) */
+    static const uint8_t rdSupply[3] = { 0x22, 0xD1, 0x00 };
+    n = prvRequest(rdSupply, 3, rsp);
+    CHECK_END(n == 5u && (uint16_t)((rsp[3] << 8) | rsp[4]) == supplyMon.supply_mV);
+
+    /* 여러 DID → FF + CF, 테스터 FC BS=2 STmin=2ms */
+    static const uint8_t rdMulti[7] = { 0x22, 0xF1, 0x90, 0xD1, 0x20, 0xF1, 0x86 };
+    s_min_cf_gap_us = UINT64_MAX;
+    n = prvRequestOn(UDS_REQ_CANID, rdMulti, 7, rsp, 2, 2);
+    CHECK_END(n == 1u + 19u + 3u + 3u);
+    CHECK_END(rsp[0] == 0x62 && rsp[1] == 0xF1 && rsp[2] == 0x90 && memcmp(&rsp[3], "KNACOMENTO0000001", 17) == 0);
+    CHECK_END(rsp[20] == 0xD1 && rsp[21] == 0x20 && rsp[22] == dvfs.cur);
+    CHECK_END(rsp[23] == 0xF1 && rsp[24] == 0x86 && rsp[25] == UDS_SESSION_DEFAULT);
+    CHECK_END(s_min_cf_gap_us >= 2000u);
+    printf("multi read     : %u B, min CF gap %lu us (STmin 2 ms)\n", n, (unsigned long)s_min_cf_gap_us);
+
+    /* 미지원 DID: 전부 → 0x31, 일부 → 생략 */
+    static const uint8_t rdUnk[3] = { 0x22, 0x12, 0x34 };
+    n = prvRequest(rdUnk, 3, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x22, UDS_NRC_REQUEST_OUT_OF_RANGE));
+    static const uint8_t rdMix[5] = { 0x22, 0x12, 0x34, 0xF1, 0x86 };
+    n = prvRequest(rdMix, 5, rsp);
+    CHECK_END(n == 4u && rsp[1] == 0xF1 && rsp[2] == 0x86);
+
+    /* 멀티 프레임 요청: DID 17 개 → 0x13, 16 개 → 305B 응답 */
+    req[0] = 0x22;
+    for (uint32_t i = 0; i < DID_MAX_PER_REQ + 1u; i++) { req[1u + 2u * i] = 0xF1; req[2u + 2u * i] = 0x90; }
+    n = prvRequest(req, (uint16_t)(1u + 2u * (DID_MAX_PER_REQ + 1u)), rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x22, UDS_NRC_INCORRECT_LENGTH));
+    uint64_t t0 = HostSim_NowUs();
+    n = prvRequest(req, (uint16_t)(1u + 2u * DID_MAX_PER_REQ), rsp);
+    uint64_t big_us = HostSim_NowUs() - t0;
+    CHECK_END(n == 1u + DID_MAX_PER_REQ * 19u);
+    CHECK_END(memcmp(&rsp[n - 17u], "KNACOMENTO0000001", 17) == 0);
+    printf("big read       : %u B in %lu us (%lu CF)\n", n, (unsigned long)big_us, (unsigned long)((n - ISOTP_FF_DATA + ISOTP_CF_DATA - 1u) / ISOTP_CF_DATA));
+
+    /* 쓰기: default 세션 → 0x31, 보안 잠김 → 0x33 */
+    static const char vin2[17] = "KNATESTVIN0000042";
+    req[0] = 0x2E; req[1] = 0xF1; req[2] = 0x90;
+    memcpy(&req[3], vin2, 17);
+    n = prvRequest(req, 20, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2E, UDS_NRC_REQUEST_OUT_OF_RANGE));
+    static const uint8_t sess3[2] = { 0x10, 0x03 };
+    (void)prvRequest(sess3, 2, rsp);
+    n = prvRequest(req, 20, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2E, UDS_NRC_SECURITY_ACCESS_DENIED));
+    prvUnlock();
+    n = prvRequest(req, 20, rsp);
+    CHECK_END(n == 3u && rsp[0] == 0x6E && rsp[1] == 0xF1 && rsp[2] == 0x90);
+    static const uint8_t rdVin[3] = { 0x22, 0xF1, 0x90 };
+    n = prvRequest(rdVin, 3, rsp);
+    CHECK_END(n == 20u && memcmp(&rsp[3], vin2, 17) == 0);
+    n = prvRequest(req, 19, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2E, UDS_NRC_INCORRECT_LENGTH));
+
+    /* 공급 전압 임계값: 히스테리시스 순서 검사 */
+    static const uint8_t thrBad[11] = { 0x2E, 0xD1, 0x01, 0x27, 0x10, 0x26, 0xAC, 0x3E, 0x80, 0x3C, 0x8C };
+    n = prvRequest(thrBad, 11, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2E, UDS_NRC_REQUEST_OUT_OF_RANGE));
+    static const uint8_t thrOk[11] = { 0x2E, 0xD1, 0x01, 0x26, 0xAC, 0x27, 0x10, 0x3E, 0x80, 0x3C, 0x8C };
+    n = prvRequest(thrOk, 11, rsp);
+    CHECK_END(n == 3u && rsp[0] == 0x6E);
+    CHECK_END(supplyMon.cfg.uv_mV == 9900u && supplyMon.cfg.uv_clear_mV == 10000u
+          && supplyMon.cfg.ov_mV == 16000u && supplyMon.cfg.ov_clear_mV == 15500u);
+
+    /* DVFS 고정: 범위 밖 0x31, 0xFF = 거버너 */
+    static const uint8_t dvBad[4] = { 0x2E, 0xD1, 0x24, DVFS_OPP_COUNT };
+    n = prvRequest(dvBad, 4, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2E, UDS_NRC_REQUEST_OUT_OF_RANGE));
+    static const uint8_t dvGov[4] = { 0x2E, 0xD1, 0x24, 0xFF };
+    n = prvRequest(dvGov, 4, rsp);
+    CHECK_END(n == 3u && dvfs.forced == -1);
+
+    /* 기능 주소: 지원 DID 는 응답, 미지원 DID 는 응답 없음 (다음 응답이 3E 00 의 것) */
+    n = prvRequestOn(UDS_FUNC_REQ_CANID, rdSess, 3, rsp, 0, 0);
+    CHECK_END(n == 4u && rsp[0] == 0x62 && rsp[3] == UDS_SESSION_EXTENDED);
+    uint8_t frame[8] = { 0x03, 0x22, 0x12, 0x34, 0xAA, 0xAA, 0xAA, 0xAA };
+    s_rx_tail = s_rx_head;
+    prvSend(UDS_FUNC_REQ_CANID, frame);
+    osDelay(20);
+    static const uint8_t tp[2] = { 0x3E, 0x00 };
+    n = prvRequest(tp, 2, rsp);
+    CHECK_END(n == 2u && rsp[0] == 0x7E);
+
+    /* 메모리 풀 (D160): 처리 중인 요청이 요청/응답 버퍼를 1 개씩 쥠, 지금까지 고갈 없음 */
+    static const uint8_t rdPool[3] = { 0x22, 0xD1, 0x60 };
+    n = prvRequest(rdPool, 3, rsp);
+    CHECK_END(n == 15u && rsp[4] >= 1u && rsp[7] == 1u && rsp[8] == 1u && rsp[11] == 1u && rsp[12] == 1u);
+    CHECK_END(rsp[5] == 0u && rsp[6] == 0u && rsp[9] == 0u && rsp[10] == 0u && rsp[13] == 0u && rsp[14] == 0u);
+
+    /* 0x2A: 길이 / 모드 / 미지원 pDID (하나라도 있으면 아무것도 예약 안 함) */
+    static const uint8_t pdNoId[2] = { 0x2A, PDID_MODE_FAST };
+    n = prvRequest(pdNoId, 2, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2A, UDS_NRC_INCORRECT_LENGTH));
+    static const uint8_t pdMode[3] = { 0x2A, 0x05, 0x00 };
+    n = prvRequest(pdMode, 3, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2A, UDS_NRC_REQUEST_OUT_OF_RANGE));
+    static const uint8_t pdUnk[4] = { 0x2A, PDID_MODE_FAST, 0x00, 0x55 };
+    n = prvRequest(pdUnk, 4, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2A, UDS_NRC_REQUEST_OUT_OF_RANGE) && pdidSched.used == 0u);
+
+    /* F200 (공급 전압) + F210 (PMIC fault) fast → 10 ms 간격, 그 사이 요청 응답 */
+    static const uint8_t pdFast[4] = { 0x2A, PDID_MODE_FAST, 0x00, 0x10 };
+    memset(s_per, 0, sizeof(s_per));
+    s_per[0x00].min_gap_us = s_per[0x10].min_gap_us = UINT64_MAX;
+    n = prvRequest(pdFast, 4, rsp);
+    CHECK_END(n == 1u && rsp[0] == 0x6A && pdidSched.used == 2u);
+    osDelay(100);
+    n = prvRequest(rdSess, 3, rsp);
+    CHECK_END(n == 4u && rsp[0] == 0x62);
+    osDelay(100);
+    PeriodicRx_t v = s_per[0x00], f = s_per[0x10];
+    CHECK_END(v.count >= 19u && v.count <= 21u && f.count >= 19u && f.count <= 21u);
+    CHECK_END(v.min_gap_us >= 9000u && v.max_gap_us <= 11000u);
+    CHECK_END((uint16_t)((v.data[0] << 8) | v.data[1]) == supplyMon.supply_mV);
+    CHECK_END(memcmp(f.data, pmicShadow.regs, PMIC_STATUS_COUNT) == 0);
+    printf("periodic fast  : F200 %lu frames gap %lu..%lu us, F210 %lu frames\n", (unsigned long)v.count,
+           (unsigned long)v.min_gap_us, (unsigned long)v.max_gap_us, (unsigned long)f.count);
+
+    /* F200 → slow (예약 수 그대로), F210 정지 */
+    static const uint8_t pdSlow[3] = { 0x2A, PDID_MODE_SLOW, 0x00 };
+    n = prvRequest(pdSlow, 3, rsp);
+    CHECK_END(n == 1u && pdidSched.used == 2u);
+    static const uint8_t pdStop1[3] = { 0x2A, PDID_MODE_STOP, 0x10 };
+    n = prvRequest(pdStop1, 3, rsp);
+    CHECK_END(n == 1u && pdidSched.used == 1u);
+    uint32_t c0 = s_per[0x00].count, c1 = s_per[0x10].count;
+    osDelay(1100);
+    CHECK_END(s_per[0x00].count - c0 >= 1u && s_per[0x00].count - c0 <= 2u && s_per[0x10].count == c1);
+
+    /* 세션 전환 → 전부 정지, default 세션에서는 0x7F */
+    static const uint8_t sess1[2] = { 0x10, 0x01 };
+    (void)prvRequest(sess1, 2, rsp);
+    CHECK_END(pdidSched.used == 0u);
+    c0 = s_per[0x00].count;
+    osDelay(1100);
+    CHECK_END(s_per[0x00].count == c0);
+    n = prvRequest(pdSlow, 3, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x2A, UDS_NRC_SERVICE_NOT_IN_SESSION));
+
+    /* PDID_MAX 개 slow 예약, 한 주기 동안 송신 불가 → 전부 대기열에. 송신 재개 후 한 tick 에 모두 나감 */
+    uint8_t pdAll[1u + PDID_MAX];
+    for (uint32_t i = 0; i < PDID_MAX; i++) {
+        s_pdEntries[i] = (DID_Entry_t){ .did = (uint16_t)(PDID_DID_BASE + i), .fmt = DID_FMT_U8, .len = 1,
+                                        .access = DID_ACC_READ, .live = &s_pdLive[i] };
+        pdAll[1u + i] = (uint8_t)i;
+    }
+    pdAll[0] = PDID_MODE_SLOW;
+    PDID_Init(&s_pdFull, &s_pdTable, prvPdSend);
+    s_pdBusy = 1;
+    CHECK_END(PDID_Request(&s_pdFull, pdAll, sizeof(pdAll)) == 0u && s_pdFull.used == PDID_MAX);
+    for (uint32_t t = 0; t < PDID_RATE_SLOW_MS / PDID_TICK_MS; t++) PDID_Tick(&s_pdFull);
+    CHECK_END(s_pdFrames == 0u && s_pdFull.late == 0u);
+    s_pdBusy = 0;
+    PDID_TxDoneFromISR(&s_pdFull);
+    CHECK_END(s_pdFrames == PDID_MAX);
+    PDID_StopAll(&s_pdFull);
+
+    if (s_rc == 0) printf("PASS did\n");
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    /* 표 검사: 실제 표 + 순서가 틀린 표 + 폭이 맞지 않는 길이 */
+    static uint16_t v16;
+    static const DID_Entry_t unsorted[2] = {
+        { 0x0200u, DID_FMT_U16, 2, DID_ACC_READ, &v16, NULL, NULL },
+        { 0x0100u, DID_FMT_U16, 2, DID_ACC_READ, &v16, NULL, NULL },
+    };
+    static const DID_Entry_t badLen[1] = { { 0x0100u, DID_FMT_U16, 3, DID_ACC_READ, &v16, NULL, NULL } };
+    const DID_Table_t tu = { unsorted, 2 }, tl = { badLen, 1 };
+    if (DID_CheckTable(&didTable) != HAL_OK || DID_CheckTable(&tu) != HAL_ERROR || DID_CheckTable(&tl) != HAL_ERROR) {
+        printf("FAIL DID_CheckTable\n");
+        return 1;
+    }
+
+    HostBoard_Init();
+    HostCAN_AddNode(CAN1, prvNode, NULL);
+    HostBoard_CreateTasks();
+    const osThreadAttr_t tester_attributes = {
+      .name = "Tester", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    s_tester = osThreadNew(prvTester, NULL, &tester_attributes);
+
+    HostBoard_Run(0u);
+    return s_rc;
+}
@@ -0,0 +1,187 @@
+/*
+ * test_dtc_mount.c  (Host build)
+ *
+ *  부팅 시 DTC 메모리 mount → 첫 UDS 응답까지의 시간 (25LC256 모델, 전체 보드 Task 구성).
+ *    index : 유효한 index page → 한 번의 READ(128B) 로 UDS 응답 가능
+ *    scan  : index 기록 중 전원이 끊긴 이미지 (CRC 불일치) → 두 bank scan, index 재작성
+ *  테스터는 부팅 직후 0x19 01 을 보내고, 응답마다 다음 요청을 이어서 보낸다:
+ *    19 01 FF (개수) → 19 02 08 (confirmed DTC 목록) → 14 FF FF FF (전체 삭제)
+ *
+ *  사용법: test_dtc_mount [index|scan]   (기본 index, ctest 는 둘 다)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "DTCMem.h"
+#include "test_check.h"
+
+#define RUN_MS          300u
+#define READY_POLL_US   10u
+#define NEXT_REQ_US     20000u    /* 응답 후 다음 요청까지 (scan 경로 index 재작성 확인 여유) */
+#define NSEED           5u
+
+/* slot 구멍 포함, confirmed(0x08) 는 1 개 */
+static const struct { uint8_t slot; uint8_t dtc[3]; uint8_t status; } s_seed[NSEED] = {
+    { 0, { 0xC1, 0x23, 0x00 }, 0x2F },
+    { 1, { 0x05, 0x62, 0x00 }, 0x24 },
+    { 3, { 0x05, 0x63, 0x00 }, 0x24 },
+    { 4, { 0x01, 0x23, 0x45 }, 0x24 },
+    { 6, { 0xD1, 0x00, 0x00 }, 0x24 },
+};
+
+/* ===== 테스터 노드 ===== */
+typedef struct {
+    uint8_t  req[8];
+    uint8_t  rsp[8];
+    uint64_t t_req, t_rsp;    /* 요청/응답 프레임 전송 완료 시각 */
+    uint8_t  done;
+} Exchange_t;
+
+static Exchange_t s_ex[3] = {
+    { .req = { 0x03, 0x19, 0x01, 0xFF, 0, 0, 0, 0 } },
+    { .req = { 0x03, 0x19, 0x02, 0x08, 0, 0, 0, 0 } },
+    { .req = { 0x04, 0x14, 0xFF, 0xFF, 0xFF, 0, 0, 0 } },
+};
+static uint32_t s_step;
+static uint64_t s_ready_us;
+static uint32_t s_pending;      /* 0x78 (삭제 중 EEPROM 기록이 P2 를 넘김) */
+static uint8_t  s_idx_at_req2[DTCMEM_INDEX_SIZE];
+
+/* 요청 시각 = 요청 프레임 전송 완료 (노드 콜백은 DUT 송신만 받으므로 8B 프레임 길이로 계산) */
+static uint32_t prvFrameUs(void)
+{
+    return (47u + 64u + (34u + 64u - 1u) / 4u) * HostCAN_BitTimeNs(CAN1) / 1000u;
+}
+
+static void prvSendEvt(void *arg)
+{
+    (void)arg;
+    if (s_step == 1u) memcpy(s_idx_at_req2, &g_eeprom.mem[DTCMEM_INDEX_ADDR], DTCMEM_INDEX_SIZE);
+    s_ex[s_step].t_req = HostSim_NowUs() + prvFrameUs();
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, s_ex[s_step].req, 8);
+}
+
+static void prvNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != UDS_RES_CANID || f->dlc != 8u || s_step >= 3u) return;
+    if (f->data[1] == UDS_SID_NEGATIVE_RESPONSE && f->data[3] == UDS_NRC_RESPONSE_PENDING) { s_pending++; return; }
+    Exchange_t *e = &s_ex[s_step];
+    memcpy(e->rsp, f->data, 8);
+    e->t_rsp = f->t_us;
+    e->done = 1;
+    if (++s_step < 3u) HostSim_Schedule(NEXT_REQ_US, prvSendEvt, NULL);
+}
+
+static void prvReadyEvt(void *arg)
+{
+    (void)arg;
+    if (dtcMem.ready) { s_ready_us = HostSim_NowUs(); return; }
+    HostSim_Schedule(READY_POLL_US, prvReadyEvt, NULL);
+}
+
+/* ===== EEPROM 이미지 ===== */
+static void prvSeed(int scan)
+{
+    static DTCMem_t img;
+    memset(&img, 0, sizeof(img));
+    for (uint32_t i = 0; i < NSEED; i++) {
+        DTCMem_Slot_t *s = &img.slot[s_seed[i].slot];
+        s->used = 1;
+        memcpy(s->dtc, s_seed[i].dtc, 3);
+        s->status = s_seed[i].status;
+        s->occurrence = (uint8_t)(i + 1u);
+        s->first_ms = 1000u * (i + 1u);
+        s->last_ms = s->first_ms + 500u;
+    }
+    uint16_t len = DTCMEM_BANK_SIZE;
+    (void)DTCMem_EncodeBank(&img, 7u, &g_eeprom.mem[DTCMEM_BANK_A], &len);
+    DTCMem_EncodeIndex(&img, 0u, 7u, (uint8_t)(len / DTC_PK_PAGE_SIZE), &g_eeprom.mem[DTCMEM_INDEX_ADDR]);
+    if (scan) g_eeprom.mem[DTCMEM_INDEX_ADDR + 100u] ^= 0x5Au;     // 두 번째 page 기록 중 차단
+}
+
+/* index 가 가리키는 bank 의 DTC 개수 (무효 -1) */
+static int prvBankCount(const uint8_t *idx)
+{
+    uint16_t n = 0;
+    uint32_t gen = 0;
+    uint16_t len = (uint16_t)(idx[12] * DTC_PK_PAGE_SIZE);
+    if (DTC_UnpackTable(&g_eeprom.mem[DTCMEM_BANK_ADDR(idx[1])], len, NULL, &n, &gen) != HAL_OK) return -1;
+    return (gen == ((uint32_t)idx[2] | ((uint32_t)idx[3] << 8) | ((uint32_t)idx[4] << 16) | ((uint32_t)idx[5] << 24)))
+           ? (int)idx[10] : -1;
+}
+
+static int prvIndexValid(const uint8_t *idx, uint8_t count)
+{
+    uint16_t crc = (uint16_t)((idx[DTCMEM_INDEX_SIZE - 2u] << 8) | idx[DTCMEM_INDEX_SIZE - 1u]);
+    return idx[0] == DTCMEM_IDX_VERSION && idx[10] == count
+        && crc == DTC_CalcCRC16(idx, DTCMEM_INDEX_SIZE - 2u);
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = (argc > 1) ? argv[1] : "index";
+    int scan = (strcmp(mode, "scan") == 0);
+
+    if (!scan && strcmp(mode, "index") != 0) {
+        printf("usage: %s [index|scan]\n", argv[0]);
+        return 2;
+    }
+
+    HostBoard_Init();
+    prvSeed(scan);
+    HostCAN_AddNode(CAN1, prvNode, NULL);
+    HostSim_Schedule(1u, prvSendEvt, NULL);
+    HostSim_Schedule(READY_POLL_US, prvReadyEvt, NULL);
+
+    HostBoard_CreateTasks();
+    HostBoard_Run(RUN_MS);
+
+    printf("mode            : %s\n", mode);
+    printf("mount           : path=%s reads=%lu bytes=%lu ready @ %lu us\n",
+           dtcMem.path == DTCMEM_PATH_INDEX ? "index" : dtcMem.path == DTCMEM_PATH_SCAN ? "scan" : "none",
+           (unsigned long)dtcMem.mount_reads, (unsigned long)dtcMem.mount_bytes, (unsigned long)s_ready_us);
+    printf("first response  : %lu us after boot (%lu us after request)\n",
+           (unsigned long)s_ex[0].t_rsp, (unsigned long)(s_ex[0].t_rsp - s_ex[0].t_req));
+    if (scan && dtcMem.mount_bytes != 0u) {
+        /* 같은 속도(호출 오버헤드 포함)로 32KB 전체를 훑는 경우 */
+        printf("naive 32KB scan : ~%lu us (extrapolated)\n",
+               (unsigned long)((uint64_t)s_ready_us * EEPROM_SIZE_BYTES / dtcMem.mount_bytes));
+    }
+    printf("writes          : bank pages=%lu index=%lu mismatches=%lu errors=%lu\n",
+           (unsigned long)dtcMem.page_writes, (unsigned long)dtcMem.index_writes,
+           (unsigned long)dtcMem.mismatches, (unsigned long)dtcMem.errors);
+
+    CHECK(s_step == 3u);
+    CHECK(dtcMem.errors == 0u);
+    if (scan) {
+        CHECK(dtcMem.path == DTCMEM_PATH_SCAN);
+        CHECK(dtcMem.mount_bytes == DTCMEM_INDEX_SIZE + 2u * DTCMEM_BANK_SIZE);
+        /* 두 번째 요청 전, 유휴 구간에 index 재작성 */
+        CHECK(prvIndexValid(s_idx_at_req2, NSEED));
+        CHECK(prvBankCount(s_idx_at_req2) == (int)NSEED);
+    } else {
+        CHECK(dtcMem.path == DTCMEM_PATH_INDEX);
+        CHECK(dtcMem.mount_reads == 1u && dtcMem.mount_bytes == DTCMEM_INDEX_SIZE);
+        CHECK(dtcMem.mismatches == 0u);
+        CHECK(s_ex[0].t_rsp <= 2000u);
+    }
+
+    /* 59 01 avail fmt count */
+    static const uint8_t r1[8] = { 0x06, 0x59, 0x01, DTCMEM_STATUS_AVAIL, 0x01, 0x00, NSEED, UDS_PAD_BYTE };
+    CHECK(memcmp(s_ex[0].rsp, r1, 8) == 0);
+    /* 59 02 avail + confirmed DTC 1 개 */
+    static const uint8_t r2[8] = { 0x07, 0x59, 0x02, DTCMEM_STATUS_AVAIL, 0xC1, 0x23, 0x00, 0x2F };
+    CHECK(memcmp(s_ex[1].rsp, r2, 8) == 0);
+    /* 54: EEPROM 반영 후 응답 → index 와 커밋된 bank 모두 비어 있음 */
+    CHECK(s_ex[2].rsp[0] == 0x01 && s_ex[2].rsp[1] == 0x54);
+    CHECK(prvIndexValid(&g_eeprom.mem[DTCMEM_INDEX_ADDR], 0));
+    CHECK(prvBankCount(&g_eeprom.mem[DTCMEM_INDEX_ADDR]) == 0);
+    printf("clear           : %lu us request → positive response (%lu x 0x78)\n",
+           (unsigned long)(s_ex[2].t_rsp - s_ex[2].t_req), (unsigned long)s_pending);
+    printf("PASS dtc_mount %s\n", mode);
+    return 0;
+}
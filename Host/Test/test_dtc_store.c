@@ -0,0 +1,196 @@
+/*
+ * test_dtc_store.c  (Host build)
+ *
+ *  DTC 메모리 커밋의 전원 차단 내성 (DTCMem A/B bank + index, 25LC256 모델, BusMgr eeprom0).
+ *  Flush 기록(bank page → index 2 page)의 모든 바이트 위치에서 전원을 끊고, 재부팅 mount 결과가
+ *    bank 기록 중 차단  → 직전 커밋 (index 는 이전 bank 를 가리킴)
+ *    index 기록 중 차단 → 새 커밋 (index 무효 → scan 이 완료된 새 bank 선택)
+ *  인지, 이후 커밋이 정상인지 확인한다. 부팅 mount 비용(index / scan)을 보고.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "BusMgr.h"
+#include "DTCMem.h"
+#include "test_check.h"
+
+typedef struct {
+    uint8_t       n;
+    DTCMem_Slot_t s[DTCMEM_SLOTS];
+} Table_t;
+
+static DTCMem_t s_mem;
+static int8_t   s_dev;
+static int      s_rc;
+
+static void prvDtc(uint32_t k, uint8_t out[3])
+{
+    out[0] = 0xC1u;
+    out[1] = (uint8_t)(k >> 8);
+    out[2] = (uint8_t)k;
+}
+
+/* 점유 slot 을 순서대로 (index mount 는 slot 위치 유지, scan 은 앞으로 모음) */
+static void prvTable(Table_t *t)
+{
+    memset(t, 0, sizeof(*t));
+    for (uint32_t i = 0; i < DTCMEM_SLOTS; i++) {
+        if (s_mem.slot[i].used) t->s[t->n++] = s_mem.slot[i];
+    }
+}
+
+static int prvSame(const Table_t *a, const Table_t *b)
+{
+    if (a->n != b->n) return 0;
+    for (uint32_t i = 0; i < a->n; i++) {
+        const DTCMem_Slot_t *x = &a->s[i], *y = &b->s[i];
+        if (memcmp(x->dtc, y->dtc, 3) != 0 || x->status != y->status || x->occurrence != y->occurrence
+            || x->first_ms != y->first_ms || x->last_ms != y->last_ms) return 0;
+    }
+    return 1;
+}
+
+/* 재부팅: RAM 초기화 → mount → 상세 로드 */
+static int prvBoot(void)
+{
+    if (s_mem.lock != NULL) osMutexDelete(s_mem.lock);
+    DTCMem_Init(&s_mem, s_dev);
+    CHECK(DTCMem_Mount(&s_mem) == HAL_OK);
+    CHECK(DTCMem_LoadDetails(&s_mem) == HAL_OK);
+    return 0;
+}
+
+static int prvAdd(uint32_t k)
+{
+    uint8_t dtc[3];
+    prvDtc(k, dtc);
+    osDelay(3);                         // 시각이 record 마다 다르게
+    CHECK(DTCMem_Report(&s_mem, dtc, true) == HAL_OK);
+    return 0;
+}
+
+/* prior 회 커밋 후 (prior+1) 번째 커밋을 cut 바이트에서 끊는다. 반환 bank 기록 바이트 (<0 실패) */
+static int32_t prvCutCase(uint32_t prior, int32_t cut, uint32_t *recovered)
+{
+    Table_t before, after, got;
+
+    memset(g_eeprom.mem, 0xFF, sizeof(g_eeprom.mem));
+    M25LC256_PowerOn(&g_eeprom);
+    if (prvBoot() != 0) return -1;
+    for (uint32_t k = 1; k <= prior; k++) {
+        if (prvAdd(k) != 0 || DTCMem_Flush(&s_mem) != HAL_OK) return -1;
+    }
+    prvTable(&before);
+
+    /* 중단된 커밋 */
+    if (prvAdd(prior + 1u) != 0) return -1;
+    prvTable(&after);
+    static uint8_t img[DTCMEM_BANK_SIZE];
+    uint16_t len = sizeof(img);
+    if (DTCMem_EncodeBank(&s_mem, 0u, img, &len) != HAL_OK) return -1;
+    int32_t bankBytes = (int32_t)len;
+    M25LC256_ArmPowerCut(&g_eeprom, cut);
+    HAL_StatusTypeDef st = DTCMem_Flush(&s_mem);
+    M25LC256_PowerOn(&g_eeprom);
+
+    /* 재부팅 */
+    if (prvBoot() != 0) return -1;
+    prvTable(&got);
+    if (cut >= bankBytes + (int32_t)DTCMEM_INDEX_SIZE) {
+        if (st != HAL_OK || s_mem.path != DTCMEM_PATH_INDEX || !prvSame(&got, &after)) return -1;
+    } else if (st == HAL_OK) {
+        return -1;
+    } else if (prvSame(&got, &before)) {
+        if (prior != 0u && s_mem.path != DTCMEM_PATH_INDEX) return -1;    // index 는 그대로 이전 bank
+        (*recovered)++;
+    } else if (!prvSame(&got, &after) || s_mem.path != DTCMEM_PATH_SCAN) {
+        return -1;                                           // 새 커밋은 index 가 깨졌을 때만
+    }
+
+    /* 복구 후 커밋 두 번 (양쪽 bank 모두 다시 씀) */
+    for (uint32_t k = 2; k <= 3u; k++) {
+        if (prvAdd(100u * k + prior) != 0 || DTCMem_Flush(&s_mem) != HAL_OK) return -1;
+        prvTable(&after);
+        if (prvBoot() != 0) return -1;
+        prvTable(&got);
+        if (!prvSame(&got, &after) || s_mem.path != DTCMEM_PATH_INDEX) return -1;
+    }
+    return bankBytes;
+}
+
+static int prvRun(void)
+{
+    uint32_t cases = 0, recovered = 0, expectRecovered = 0;
+
+    /* 빈 장치: scan → 빈 테이블 */
+    memset(g_eeprom.mem, 0xFF, sizeof(g_eeprom.mem));
+    CHECK(prvBoot() == 0);
+    CHECK(s_mem.path == DTCMEM_PATH_SCAN && DTCMem_CountByMask(&s_mem, 0xFF) == 0u);
+
+    /* prior 0: 첫 커밋 중단, 1: B 기록 중단 (A 유효), 2: A 기록 중단 (B 유효), 5: 여러 번 돈 뒤 */
+    static const uint32_t priors[] = { 0u, 1u, 2u, 5u };
+    for (uint32_t p = 0; p < sizeof(priors) / sizeof(priors[0]); p++) {
+        int32_t total = 1;
+        for (int32_t cut = 0; cut <= total; cut++) {
+            uint32_t before = recovered;
+            int32_t bankBytes = prvCutCase(priors[p], cut, &recovered);
+            if (bankBytes < 0) {
+                printf("FAIL power cut (prior=%lu cut=%ld)\n", (unsigned long)priors[p], (long)cut);
+                return 1;
+            }
+            total = bankBytes + (int32_t)DTCMEM_INDEX_SIZE;
+            if (cut < bankBytes) { expectRecovered++; CHECK(recovered == before + 1u); }
+            cases++;
+        }
+    }
+    printf("power cuts   : %lu cases, %lu recovered to previous commit, rest committed, 0 lost\n",
+           (unsigned long)cases, (unsigned long)recovered);
+    CHECK(recovered == expectRecovered && recovered > 0u);
+
+    /* 부팅 mount 비용: index 한 번 vs index 무효 → 두 bank scan */
+    uint64_t t0 = HostSim_NowUs();
+    CHECK(prvBoot() == 0);
+    uint64_t idx_us = HostSim_NowUs() - t0;
+    CHECK(s_mem.path == DTCMEM_PATH_INDEX && s_mem.mount_reads == 1u && s_mem.mount_bytes == DTCMEM_INDEX_SIZE);
+    printf("boot mount   : index %lu B (+ bank %u B details), %lu us\n", (unsigned long)s_mem.mount_bytes,
+           (unsigned)(s_mem.npages * DTC_PK_PAGE_SIZE), (unsigned long)idx_us);
+
+    g_eeprom.mem[DTCMEM_INDEX_ADDR + 20u] ^= 0x01u;
+    t0 = HostSim_NowUs();
+    CHECK(prvBoot() == 0);
+    uint64_t scan_us = HostSim_NowUs() - t0;
+    CHECK(s_mem.path == DTCMEM_PATH_SCAN && s_mem.mount_bytes == DTCMEM_INDEX_SIZE + 2u * DTCMEM_BANK_SIZE);
+    printf("scan mount   : %lu B, %lu us\n", (unsigned long)s_mem.mount_bytes, (unsigned long)scan_us);
+    CHECK(idx_us < scan_us);
+
+    printf("PASS dtc_store\n");
+    return 0;
+}
+
+static void prvTestTask(void *argument)
+{
+    (void)argument;
+    s_rc = prvRun();
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    static const BusDev_t ee = { "eeprom0", BUSDEV_EEPROM, BUS_SPI1, 0, NULL, 0 };
+
+    HostBoard_Init();
+    osKernelInitialize();
+    BusMgr_Init();
+    s_dev = BusMgr_Register(&ee);
+    if (s_dev < 0) return 1;
+
+    const osThreadAttr_t test_attributes = {
+      .name = "DtcStoreTest", .stack_size = 1024 * 4, .priority = (osPriority_t)osPriorityNormal,
+    };
+    osThreadNew(prvTestTask, NULL, &test_attributes);
+    HostBoard_Run(0u);
+    return s_rc;
+}
@@ -0,0 +1,218 @@
+/*
+ * test_dvfs.c  (Host build)
+ *
+ *  DVFS 거버너를 부하 트레이스로 구동하고 OPP 별 체류 시간, 전환 횟수,
+ *  진단 요청 응답 지연, 전력 지수(Σ t·f·V²)를 보고한다.
+ *  전압/주파수 순서 불변식: 모든 시점에서 Buck A ≥ 현재 SYSCLK 에 필요한 전압.
+ *
+ *  사용법: test_dvfs [governor|fixed-low|fixed-high]   (기본 governor, ctest 는 governor)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "DVFS.h"
+#include "test_check.h"
+
+#define RUN_MS          2000u
+#define SAMPLE_US       250u      /* 불변식/전력 샘플 주기 */
+#define DIAG_PERIOD_US  20000u    /* 진단 요청 간격 */
+#define DIAG_CYCLES     200000u   /* 요청당 처리량 (16MHz 에서 12.5ms) */
+#define VOUT_A_REG      PMIC_VOUT_FIRST
+
+/* ===== 부하 트레이스 ===== */
+typedef struct {
+    uint32_t start_ms, end_ms;
+    uint32_t can_fps;
+    uint8_t  diag;
+    const char *name;
+} Phase_t;
+
+static const Phase_t s_phases[] = {
+    {    0,  300,    0, 0, "idle"      },
+    {  300,  600,  400, 0, "can-400"   },
+    {  600,  900,    0, 0, "idle"      },
+    {  900, 1300,    0, 1, "diag"      },
+    { 1300, 1600, 1500, 0, "can-1500"  },
+    { 1600, 2000,    0, 0, "idle"      },
+};
+#define NPHASE  (sizeof(s_phases) / sizeof(s_phases[0]))
+
+static const Phase_t *prvPhaseAt(uint64_t us)
+{
+    uint32_t ms = (uint32_t)(us / 1000u);
+    for (uint32_t i = 0; i < NPHASE; i++) {
+        if (ms >= s_phases[i].start_ms && ms < s_phases[i].end_ms) return &s_phases[i];
+    }
+    return &s_phases[NPHASE - 1u];
+}
+
+/* CAN 수신 부하: 현재 단계의 프레임 간격으로 자기 재예약 */
+static void prvCanEvt(void *arg)
+{
+    const Phase_t *p = prvPhaseAt(HostSim_NowUs());
+    (void)arg;
+    if (p->can_fps != 0u) {
+        DVFS_NotifyCanFrame();
+        HostSim_Schedule(1000000u / p->can_fps, prvCanEvt, NULL);
+    } else {
+        HostSim_Schedule(1000u, prvCanEvt, NULL);
+    }
+}
+
+/* 진단 세션: 단계 진입/이탈 시 요구 설정, 세션 중 20ms 마다 요청 */
+static osThreadId_t s_worker;
+static uint64_t     s_req_us;
+static uint8_t      s_in_diag;
+
+static void prvDiagEvt(void *arg)
+{
+    const Phase_t *p = prvPhaseAt(HostSim_NowUs());
+    (void)arg;
+    if (p->diag != s_in_diag) {
+        s_in_diag = p->diag;
+        DVFS_SetDemand(DVFS_DEMAND_DIAG, s_in_diag);
+    }
+    if (s_in_diag) {
+        s_req_us = HostSim_NowUs();
+        osThreadFlagsSet(s_worker, 1u);
+    }
+    HostSim_Schedule(DIAG_PERIOD_US, prvDiagEvt, NULL);
+}
+
+typedef struct {
+    uint32_t n;
+    uint64_t sum_us, max_us, first_us;
+} Lat_t;
+
+static Lat_t s_lat;
+
+static void prvWorker(void *argument)
+{
+    (void)argument;
+    for (;;) {
+        osThreadFlagsWait(1u, osFlagsWaitAny, osWaitForever);
+        uint64_t t0 = s_req_us;
+        HostSim_CpuCycles(DIAG_CYCLES);
+        uint64_t d = HostSim_NowUs() - t0;
+        if (s_lat.n == 0u) s_lat.first_us = d;
+        s_lat.n++;
+        s_lat.sum_us += d;
+        if (d > s_lat.max_us) s_lat.max_us = d;
+    }
+}
+
+/* ===== 불변식 + 전력 지수 ===== */
+static uint32_t s_violations;
+static uint32_t s_checks;
+static double   s_power;       /* Σ dt[s] · f[MHz] · V[V]² */
+
+static uint16_t prvRequired_mV(uint32_t sysclk)
+{
+    for (uint32_t i = 0; i < DVFS_OPP_COUNT; i++) {
+        if (sysclk <= DVFS_OppTable[i].sysclk_hz) return DVFS_OppTable[i].vcore_mV;
+    }
+    return 0xFFFFu;
+}
+
+static uint16_t prvVcore_mV(void)
+{
+    return (uint16_t)(MMP5475_GetReg(&g_pmic, VOUT_A_REG) * PMIC_VOUT_LSB_mV);
+}
+
+static void prvCheck(uint32_t sysclk, const char *where)
+{
+    uint16_t v = prvVcore_mV();
+    s_checks++;
+    if (v < prvRequired_mV(sysclk)) {
+        if (s_violations++ < 5u) {
+            printf("violation @%lu us (%s): sysclk=%lu Hz vcore=%u mV < %u mV\n",
+                   (unsigned long)HostSim_NowUs(), where, (unsigned long)sysclk, v, prvRequired_mV(sysclk));
+        }
+    }
+}
+
+static void prvOnClock(void *ctx, uint32_t sysclk)
+{
+    (void)ctx;
+    prvCheck(sysclk, "switch");
+}
+
+static void prvSampleEvt(void *arg)
+{
+    double v = prvVcore_mV() / 1000.0;
+    (void)arg;
+    prvCheck(SystemCoreClock, "sample");
+    s_power += (SAMPLE_US / 1e6) * (SystemCoreClock / 1e6) * v * v;
+    HostSim_Schedule(SAMPLE_US, prvSampleEvt, NULL);
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = (argc > 1) ? argv[1] : "governor";
+    HostRCC_Stats_t rs;
+
+    HostBoard_Init();
+    if (strcmp(mode, "fixed-low") == 0)       DVFS_Force(DVFS_OPP_LOW);
+    else if (strcmp(mode, "fixed-high") == 0) DVFS_Force(DVFS_OPP_HIGH);
+    else if (strcmp(mode, "governor") != 0) {
+        printf("usage: %s [governor|fixed-low|fixed-high]\n", argv[0]);
+        return 2;
+    }
+
+    HostRCC_SetListener(prvOnClock, NULL);
+    HostSim_Schedule(1000u, prvCanEvt, NULL);
+    HostSim_Schedule(1000u, prvDiagEvt, NULL);
+    HostSim_Schedule(SAMPLE_US, prvSampleEvt, NULL);
+
+    HostBoard_CreateTasks();
+    const osThreadAttr_t worker_attributes = {
+      .name = "DiagWorker", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    s_worker = osThreadNew(prvWorker, NULL, &worker_attributes);
+    HostBoard_Run(RUN_MS);
+
+    HostRCC_GetStats(&rs);
+
+    /* 최대 성능 고정(64MHz, 1.1V) 대비 */
+    double ref = (RUN_MS / 1000.0) * (DVFS_OppTable[DVFS_OPP_HIGH].sysclk_hz / 1e6)
+               * (DVFS_OppTable[DVFS_OPP_HIGH].vcore_mV / 1000.0) * (DVFS_OppTable[DVFS_OPP_HIGH].vcore_mV / 1000.0);
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < DVFS_OPP_COUNT; i++) total += dvfs.residency_ms[i];
+
+    printf("mode         : %s\n", mode);
+    for (uint32_t i = 0; i < DVFS_OPP_COUNT; i++) {
+        printf("residency    : %-4s %2lu MHz %4u mV  %5lu ms  %5.1f %%\n",
+               DVFS_OppTable[i].name, (unsigned long)(DVFS_OppTable[i].sysclk_hz / 1000000u),
+               DVFS_OppTable[i].vcore_mV, (unsigned long)dvfs.residency_ms[i],
+               total ? 100.0 * dvfs.residency_ms[i] / total : 0.0);
+    }
+    printf("transitions  : %lu (failures=%lu, max switch=%lu ms, rcc switches=%lu pll locks=%lu latency errors=%lu)\n",
+           (unsigned long)dvfs.transitions, (unsigned long)dvfs.failures, (unsigned long)dvfs.max_switch_ms,
+           (unsigned long)rs.switches, (unsigned long)rs.pll_locks, (unsigned long)rs.latency_errors);
+    printf("diag latency : n=%lu first=%.2f ms avg=%.2f ms max=%.2f ms\n",
+           (unsigned long)s_lat.n, s_lat.first_us / 1000.0,
+           s_lat.n ? (double)s_lat.sum_us / s_lat.n / 1000.0 : 0.0, s_lat.max_us / 1000.0);
+    printf("power index  : %.1f (%.1f %% of fixed-high)\n", s_power, 100.0 * s_power / ref);
+    printf("invariant    : %lu checks, %lu violations\n", (unsigned long)s_checks, (unsigned long)s_violations);
+
+    CHECK(s_violations == 0u);
+    CHECK(rs.latency_errors == 0u);
+    CHECK(dvfs.failures == 0u);
+    CHECK(s_lat.n >= 15u);
+    if (strcmp(mode, "governor") == 0) {
+        CHECK(dvfs.residency_ms[DVFS_OPP_HIGH] > 0u);
+        CHECK(dvfs.residency_ms[DVFS_OPP_MID] > 0u);
+        /* 유휴 1000ms 중 하강 지연(프레임율 필터 + DOWN_HOLD)을 뺀 나머지는 LOW */
+        CHECK(dvfs.residency_ms[DVFS_OPP_LOW] * 100u >= total * 25u);
+        CHECK(dvfs.cur == DVFS_OPP_LOW);
+        /* 세션 첫 요청은 전환 대기 포함, 이후는 64MHz 처리 시간 (+ 선점 여유) */
+        CHECK(s_lat.first_us <= 20000u);
+        CHECK(s_lat.sum_us / s_lat.n <= 6000u);
+        CHECK(s_power < ref);
+    }
+    printf("PASS dvfs\n");
+    return 0;
+}
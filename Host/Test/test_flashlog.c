@@ -0,0 +1,164 @@
+/*
+ * test_flashlog.c  (Host build)
+ *
+ *  SPI NOR flash 로그 저장소 검증 (W25Q 모델, 파일 백업).
+ *  1) wrap-around: 4 sector 영역을 여러 바퀴 → 가장 최근 record 들이 순서대로 남아야 함
+ *  2) 전원 차단: record/sector 머리 곳곳의 바이트에서 끊고 재마운트
+ *     → 완료된 append 는 모두 보존, 잘린 record 는 걸러짐, 이후 append 계속 가능
+ *  모든 단계에서 소거되지 않은 비트에 1 을 쓰는 프로그램(erase-before-write 위반) 0 회.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "FlashLog.h"
+#include "test_check.h"
+
+#define IMAGE_PATH      "test_flashlog.bin"
+#define REGION_SECTORS  4u
+#define PAYLOAD_LEN     100u      /* record 112B → sector 당 36 개 */
+#define PREFILL         30u
+
+static int       s_rc;
+static FlashLog_t s_log;
+static SpiFlash_t s_fl;
+
+static void prvPayload(uint8_t *p, uint32_t n)
+{
+    for (uint32_t i = 0; i < PAYLOAD_LEN; i++) p[i] = (uint8_t)(n * 31u + i);
+}
+
+/* tail → head 순회: seq 가 first..last 로 연속이고 내용이 맞는지. 반환: record 수 */
+static uint32_t prvVerify(uint32_t *first, uint32_t *last)
+{
+    static uint8_t buf[FLASHLOG_MAX_PAYLOAD], exp[PAYLOAD_LEN];
+    FlashLog_Iter_t it;
+    uint32_t seq, n = 0, prev = 0;
+    uint16_t len;
+    uint8_t type;
+
+    FlashLog_IterBegin(&s_log, &it);
+    while (FlashLog_IterNext(&s_log, &it, &type, &seq, buf, sizeof(buf), &len) == HAL_OK) {
+        prvPayload(exp, seq);
+        CHECK_END(type == FLASHLOG_REC_TRACE && len == PAYLOAD_LEN);
+        CHECK_END(memcmp(buf, exp, PAYLOAD_LEN) == 0);
+        if (n == 0u) *first = seq;
+        else CHECK_END(seq == prev + 1u);
+        prev = seq;
+        n++;
+    }
+    *last = prev;
+    return n;
+}
+
+static HAL_StatusTypeDef prvAppend(uint32_t seq)
+{
+    uint8_t p[PAYLOAD_LEN];
+    prvPayload(p, seq);
+    return FlashLog_Append(&s_log, FLASHLOG_REC_TRACE, p, PAYLOAD_LEN);
+}
+
+static void prvWrapTest(void)
+{
+    uint32_t first = 0, last = 0, n;
+
+    CHECK_END(FlashLog_Mount(&s_log, &s_fl, 0, REGION_SECTORS) == HAL_OK);
+    CHECK_END(FlashLog_Format(&s_log) == HAL_OK);
+    for (uint32_t i = 1; i <= 400u; i++) CHECK_END(prvAppend(i) == HAL_OK);
+
+    n = prvVerify(&first, &last);
+    printf("wrap        : 400 appended, %lu kept (seq %lu..%lu), dropped sectors=%lu, max erase=%lu\n",
+           (unsigned long)n, (unsigned long)first, (unsigned long)last,
+           (unsigned long)s_log.dropped_sectors, (unsigned long)g_flash.stats.max_erase_count);
+    CHECK_END(last == 400u);
+    CHECK_END(n >= 2u * 36u && n <= REGION_SECTORS * 36u);
+    CHECK_END(s_log.dropped_sectors > 0u);
+
+    /* 재마운트해도 같은 내용 + 이어서 append */
+    CHECK_END(FlashLog_Mount(&s_log, &s_fl, 0, REGION_SECTORS) == HAL_OK);
+    CHECK_END(s_log.next_rec == 401u);
+    CHECK_END(prvAppend(401u) == HAL_OK);
+    CHECK_END(prvVerify(&first, &last) >= n && last == 401u);
+}
+
+/* PREFILL 개 기록 후 cut 바이트 뒤 전원 차단 → 재투입/마운트 → 검증 */
+static void prvCutTest(int32_t cut)
+{
+    uint32_t ok = PREFILL, first = 0, last = 0, n;
+
+    CHECK_END(FlashLog_Mount(&s_log, &s_fl, 0, REGION_SECTORS) == HAL_OK);
+    CHECK_END(FlashLog_Format(&s_log) == HAL_OK);
+    for (uint32_t i = 1; i <= PREFILL; i++) CHECK_END(prvAppend(i) == HAL_OK);
+
+    W25Q_ArmPowerCut(&g_flash, cut);
+    while (ok < 100u && prvAppend(ok + 1u) == HAL_OK) ok++;
+    CHECK_END(g_flash.dead);
+    W25Q_PowerOn(&g_flash);                     /* 파일 이미지에서 다시 읽음 */
+
+    CHECK_END(FlashLog_Mount(&s_log, &s_fl, 0, REGION_SECTORS) == HAL_OK);
+    n = prvVerify(&first, &last);
+    printf("cut @%-5ld  : ok=%lu kept=%lu torn=%lu head=%lu off=%lu\n", (long)cut, (unsigned long)ok,
+           (unsigned long)n, (unsigned long)s_log.torn, (unsigned long)s_log.head, (unsigned long)s_log.head_off);
+    CHECK_END(n == ok && first == 1u && last == ok);
+
+    /* 복구 후 append 계속 */
+    for (uint32_t i = 1; i <= 10u; i++) CHECK_END(prvAppend(ok + i) == HAL_OK);
+    CHECK_END(FlashLog_Mount(&s_log, &s_fl, 0, REGION_SECTORS) == HAL_OK);
+    CHECK_END(prvVerify(&first, &last) == ok + 10u && last == ok + 10u);
+}
+
+static void prvTestTask(void *argument)
+{
+    /* 0: record 첫 바이트, 1~11: 머리/seq, 50: payload, 108~111: CRC,
+       672~692: 다음 sector 머리 (소거 직후), 700+: 새 sector 의 첫 record */
+    static const int32_t cuts[] = { 0, 1, 3, 8, 11, 12, 50, 108, 111, 112, 113, 224,
+                                    671, 672, 676, 691, 692, 693, 750, 804 };
+    (void)argument;
+
+    if (SpiFlash_Init(&s_fl, BusMgr_Find("flash0")) != HAL_OK) {
+        printf("FAIL: flash0 JEDEC id\n");
+        s_rc = 1;
+        vTaskEndScheduler();
+    }
+    printf("flash       : jedec=%06lX size=%lu KB\n", (unsigned long)s_fl.jedec, (unsigned long)(s_fl.size / 1024u));
+
+    prvWrapTest();
+    for (uint32_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++) prvCutTest(cuts[i]);
+
+    printf("model       : pages=%lu erases=%lu rejected=%lu violations=%lu\n",
+           (unsigned long)g_flash.stats.page_programs, (unsigned long)g_flash.stats.sector_erases,
+           (unsigned long)g_flash.stats.rejected, (unsigned long)g_flash.stats.program_violations);
+    CHECK_END(g_flash.stats.program_violations == 0u);
+    printf("PASS flashlog\n");
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    static const BusDev_t flashDev = {
+        "flash0", BUSDEV_SPI_FLASH, BUS_SPI2, 0, FLASH_CS_GPIO_Port, FLASH_CS_Pin,
+    };
+
+    HostBoard_Init();
+    remove(IMAGE_PATH);
+    if (W25Q_OpenBacking(&g_flash, IMAGE_PATH) != 0) {
+        printf("FAIL: cannot create %s\n", IMAGE_PATH);
+        return 1;
+    }
+
+    osKernelInitialize();
+    BusMgr_Init();
+    if (BusMgr_Register(&flashDev) < 0) return 1;
+
+    const osThreadAttr_t test_attributes = {
+      .name = "FlashLogTest", .stack_size = 512 * 4, .priority = (osPriority_t)osPriorityNormal,
+    };
+    osThreadNew(prvTestTask, NULL, &test_attributes);
+    HostBoard_Run(0u);
+
+    W25Q_CloseBacking(&g_flash);
+    remove(IMAGE_PATH);
+    return s_rc;
+}
@@ -0,0 +1,125 @@
+/*
+ * test_hs.c  (Host build)
+ *
+ *  압축 전송 코덱: Bootloader/Src/HsDecode.c (부트로더) + Host/Tools/hs_encode.c (테스터).
+ *    - 비트스트림 고정: "aaaaa" = literal 'a' + 뒤 참조 (거리 1, 길이 4) → B0 80 01 80
+ *    - 왕복: 0 / 1 / 무작위 / 긴 반복 / 창 끝 (거리 2048) / 실제 펌웨어 이미지 (Debug/RTOS_DTC_Comento.bin)
+ *    - 어긋난 경계: 입력 조각 (1B ~ 블록 크기) 과 출력 공간 (1B ~) 을 무작위로 잘라 이어서 해제
+ *    - 다 푼 뒤 남은 비트 (마지막 바이트 패딩) 는 출력을 만들지 않음
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "HsDecode.h"
+#include "hs_encode.h"
+#include "test_check.h"
+
+#define MAX_IN   (256u * 1024u)
+
+static HsDecode_t s_hs;
+static uint8_t    s_packed[HS_ENCODE_BOUND(MAX_IN)];
+static uint8_t    s_out[MAX_IN + 64u];
+
+/* packed 를 in_max / out_max 이하 무작위 조각으로 해제 (0 = 한 번에). 반환: 출력 길이 */
+static uint32_t prvDecode(const uint8_t *packed, uint32_t plen, uint32_t in_max, uint32_t out_max)
+{
+    uint32_t pos = 0, total = 0;
+
+    HsDecode_Init(&s_hs);
+    while (pos < plen) {
+        uint32_t in_n = (in_max == 0u) ? plen - pos : 1u + (uint32_t)rand() % in_max;
+        uint16_t off = 0;
+        if (in_n > plen - pos) in_n = plen - pos;
+        for (;;) {
+            uint16_t used;
+            uint16_t room = (uint16_t)(out_max == 0u ? 0xFFFFu : 1u + (uint32_t)rand() % out_max);
+            if (room > sizeof(s_out) - total) room = (uint16_t)(sizeof(s_out) - total);
+            uint16_t n = HsDecode_Run(&s_hs, &packed[pos + off], (uint16_t)(in_n - off), &used, &s_out[total], room);
+            off = (uint16_t)(off + used);
+            total += n;
+            if (n < room) break;                      /* 입력 조각 소진 */
+            if (room == 0u) return total;
+        }
+        pos += in_n;
+    }
+    return total;
+}
+
+static int prvRoundTrip(const char *name, const uint8_t *in, uint32_t len)
+{
+    uint32_t plen = HsEncode(in, len, s_packed, sizeof(s_packed));
+    CHECK(len == 0u || plen != 0u);
+    CHECK(plen <= HS_ENCODE_BOUND(len));
+
+    static const uint32_t chunks[][2] = {
+        { 0, 0 }, { 1, 1 }, { 1, 0 }, { 0, 1 }, { 7, 5 }, { 37, 29 }, { 1024, 256 }, { 300, 3 },
+    };
+    for (uint32_t k = 0; k < sizeof(chunks) / sizeof(chunks[0]); k++) {
+        for (uint32_t rep = 0; rep < 3u; rep++) {
+            memset(s_out, 0xEE, sizeof(s_out));
+            uint32_t n = prvDecode(s_packed, plen, chunks[k][0], chunks[k][1]);
+            if (n != len || memcmp(s_out, in, len) != 0) {
+                printf("%s: in=%lu out=%lu → %lu bytes\n", name, (unsigned long)chunks[k][0],
+                       (unsigned long)chunks[k][1], (unsigned long)n);
+            }
+            CHECK(n == len);
+            CHECK(memcmp(s_out, in, len) == 0);
+        }
+    }
+    printf("%-10s %7lu → %7lu bytes (%3lu%%)\n", name, (unsigned long)len, (unsigned long)plen,
+           (unsigned long)(len ? (uint64_t)plen * 100u / len : 0u));
+    return 0;
+}
+
+static uint8_t *prvLoad(const char *path, uint32_t *len)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) return NULL;
+    uint8_t *buf = malloc(MAX_IN);
+    *len = (buf != NULL) ? (uint32_t)fread(buf, 1, MAX_IN, fp) : 0u;
+    fclose(fp);
+    return buf;
+}
+
+int main(void)
+{
+    static uint8_t buf[MAX_IN];
+
+    /* 비트스트림 고정 (heatshrink -w 11 -l 4) */
+    static const uint8_t aaaaa[4] = { 0xB0, 0x80, 0x01, 0x80 };
+    CHECK(HsEncode((const uint8_t *)"aaaaa", 5, s_packed, sizeof(s_packed)) == 4u);
+    CHECK(memcmp(s_packed, aaaaa, 4) == 0);
+    CHECK(prvDecode(aaaaa, 4, 0, 0) == 5u && memcmp(s_out, "aaaaa", 5) == 0);
+    /* 패딩 비트 7 개 (0 = 뒤 참조 태그 + 모자란 index) 는 출력 없음 */
+    static const uint8_t lit[2] = { 0xB0, 0x80 };     /* literal 'a' + 0 x7 */
+    CHECK(prvDecode(lit, 2, 0, 0) == 1u && s_out[0] == 'a');
+    CHECK(HsEncode(buf, 100, s_packed, 10) == 0u);     /* 출력 공간 부족 */
+
+    srand(44);
+    if (prvRoundTrip("empty", buf, 0)) return 1;
+    buf[0] = 0x5A;
+    if (prvRoundTrip("one", buf, 1)) return 1;
+    memset(buf, 0, 10000);
+    if (prvRoundTrip("zeros", buf, 10000)) return 1;
+    for (uint32_t i = 0; i < 5000u; i++) buf[i] = (uint8_t)rand();
+    if (prvRoundTrip("random", buf, 5000)) return 1;
+    for (uint32_t i = 0; i < 2048u; i++) buf[i] = (uint8_t)rand();
+    memcpy(&buf[2048], buf, 2048);                       /* 창 끝 거리 */
+    if (prvRoundTrip("window", buf, 4096)) return 1;
+    for (uint32_t i = 0; i < 20000u; i++) buf[i] = (uint8_t)("ldr r0, [r1, #4]\nstr r0, [r2]\nbx lr\n"[i % 35u] ^ (i / 700u));
+    if (prvRoundTrip("text", buf, 20000)) return 1;
+
+    uint32_t fw_len = 0;
+    uint8_t *fw = prvLoad(FW_IMAGE, &fw_len);
+    if (fw != NULL && fw_len != 0u) {
+        if (prvRoundTrip("firmware", fw, fw_len)) return 1;
+    } else {
+        printf("firmware   (skip: %s)\n", FW_IMAGE);
+    }
+    free(fw);
+
+    printf("PASS hs\n");
+    return 0;
+}
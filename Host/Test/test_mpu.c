@@ -0,0 +1,181 @@
+/*
+ * test_mpu.c  (Host build)
+ *
+ *  MPU Task 격리 (Core/Src/Mpu.c, 전체 보드 Task 구성)
+ *    - 배치 검사 통과 + 부팅 시 활성, Task 별 domain (task tag)
+ *    - domain 별 쓰기 권한: dtcMem / eeCache / pipeBuf slice (host_hal 이 RBAR/RASR 를 해석)
+ *    - 실제 전환: 태그 있는 probe Task 와 Tester(태그 없음) 가 매 tick 자기 domain 을 봄
+ *    - 위반: Mpu_Fault → (호스트는 리셋 없음) defaultTask 가 DTC P0604-03 보고
+ *    - 전환 비용 벤치: ctxsw_mpu_off / ctxsw_mpu_on
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "test_check.h"
+
+#define PROBE_ROUNDS   50u
+
+extern osThreadId_t defaultTaskHandle;
+extern osThreadId_t I2CTaskHandle;
+extern osThreadId_t SPITaskHandle;
+extern osThreadId_t CANTaskHandle;
+extern osThreadId_t EECacheTaskHandle;
+extern osThreadId_t UDSTaskHandle;
+
+static int s_rc;
+
+/* 쓰기 가능 여부 비트: 0 dtcMem, 1 eeCache, 2 I2C slice, 3 SPI slice, 4 다른 slice */
+static uint32_t prvAccess(void)
+{
+    return (HostMPU_CanWrite(&dtcMem) ? 1u : 0u) | (HostMPU_CanWrite(&eeCache.writes) ? 2u : 0u)
+         | (HostMPU_CanWrite(&pipeBuf.i2c) ? 4u : 0u) | (HostMPU_CanWrite(&pipeBuf.spi) ? 8u : 0u)
+         | (HostMPU_CanWrite((const uint8_t *)&pipeBuf + 7u * MPU_PIPE_SLICE) ? 16u : 0u);
+}
+
+static void *prvTag(osThreadId_t t)
+{
+    return (void *)(uintptr_t)xTaskGetApplicationTaskTag((TaskHandle_t)t);
+}
+
+/* ===== probe: SPI domain 으로 붙은 Task 가 전환될 때마다 자기 권한을 확인 ===== */
+static volatile uint32_t s_probeRounds, s_probeBad;
+
+static void prvProbe(void *argument)
+{
+    (void)argument;
+    for (;;) {
+        if (prvAccess() != (1u | 2u | 8u)) s_probeBad++;
+        s_probeRounds++;
+        osDelay(1);
+    }
+}
+
+/* ===== UART4 캡처 (벤치 출력) ===== */
+static char     s_out[2048];
+static uint32_t s_out_len;
+
+static void prvCapture(const char *line)
+{
+    size_t n = strlen(line);
+    if (s_out_len + n < sizeof(s_out)) {
+        memcpy(&s_out[s_out_len], line, n);
+        s_out_len += (uint32_t)n;
+    }
+}
+
+static int prvHasDtc(uint32_t dtc)
+{
+    DTC_Record_t rec[DTCMEM_SLOTS];
+    uint16_t n = DTCMem_ReadByMask(&dtcMem, DTC_ST_TF, rec, DTCMEM_SLOTS);
+    for (uint16_t i = 0; i < n && i < DTCMEM_SLOTS; i++) {
+        if (rec[i].dtc[0] == (uint8_t)(dtc >> 16) && rec[i].dtc[1] == (uint8_t)(dtc >> 8) && rec[i].dtc[2] == (uint8_t)dtc) return 1;
+    }
+    return 0;
+}
+
+static void prvTester(void *argument)
+{
+    (void)argument;
+
+    for (uint32_t t = 0; t < 1000u && !DTCMem_Ready(&dtcMem); t += 10u) osDelay(10);
+    CHECK_END(DTCMem_Ready(&dtcMem));
+
+    /* 배치 + 활성 */
+    CHECK_END(mpuState.layout_ok == 1u && mpuState.enabled == 1u);
+    CHECK_END(mpuState.faults == 0u);
+    CHECK_END(((uintptr_t)&dtcMem % MPU_DTCMEM_SIZE) == 0u && sizeof(dtcMem) == MPU_DTCMEM_SIZE);
+    CHECK_END(((uintptr_t)&eeCache % MPU_EECACHE_SIZE) == 0u && sizeof(eeCache) == MPU_EECACHE_SIZE);
+    CHECK_END(((uintptr_t)&pipeBuf % MPU_PIPE_SIZE) == 0u && sizeof(pipeBuf) == MPU_PIPE_SIZE);
+    CHECK_END((MPU->CTRL & (MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk)) == (MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk));
+
+    /* Task 별 domain */
+    CHECK_END(prvTag(defaultTaskHandle) == Mpu_Domain(MPU_DOM_STORAGE));
+    CHECK_END(prvTag(I2CTaskHandle) == Mpu_Domain(MPU_DOM_I2C));
+    CHECK_END(prvTag(SPITaskHandle) == Mpu_Domain(MPU_DOM_SPI));
+    CHECK_END(prvTag(EECacheTaskHandle) == Mpu_Domain(MPU_DOM_STORAGE));
+    CHECK_END(prvTag(UDSTaskHandle) == Mpu_Domain(MPU_DOM_STORAGE));
+    CHECK_END(prvTag(CANTaskHandle) == NULL);
+    CHECK_END(prvTag(NULL) == NULL);
+
+    /* domain 별 권한 (전환 경로 그대로 적용, 다음 전환에서 원래 값으로 돌아옴) */
+    static const struct { Mpu_DomainId_t dom; uint32_t access; } want[] = {
+        { MPU_DOM_BOOT,    0x1Fu },
+        { MPU_DOM_DEFAULT, 0x00u },
+        { MPU_DOM_STORAGE, 0x03u },
+        { MPU_DOM_I2C,     0x07u },
+        { MPU_DOM_SPI,     0x0Bu },
+    };
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < sizeof(want) / sizeof(want[0]); i++) {
+        Mpu_SwitchIn((void *)Mpu_Domain(want[i].dom));
+        if (prvAccess() != want[i].access) {
+            printf("domain %u access 0x%02x (want 0x%02x)\n", (unsigned)want[i].dom, (unsigned)prvAccess(),
+                   (unsigned)want[i].access);
+            s_rc = 1;
+        }
+    }
+    taskEXIT_CRITICAL();
+    CHECK_END(s_rc == 0);
+    osDelay(1);
+    CHECK_END(prvAccess() == 0u);                // Tester 는 태그 없음 → DEFAULT
+
+    /* 실제 전환: probe (SPI) 와 Tester (DEFAULT) 가 번갈아 돈다 */
+    const osThreadAttr_t probeAttr = { .name = "MpuProbe", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityHigh };
+    osThreadId_t probe = osThreadNew(prvProbe, NULL, &probeAttr);
+    CHECK_END(probe != NULL);
+    Mpu_Attach(probe, MPU_DOM_SPI);
+    uint32_t testerBad = 0;
+    for (uint32_t t = 0; t < 1000u && s_probeRounds < PROBE_ROUNDS; t++) {
+        osDelay(1);
+        if (prvAccess() != 0u) testerBad++;
+    }
+    (void)osThreadTerminate(probe);
+    CHECK_END(s_probeRounds >= PROBE_ROUNDS);
+    CHECK_END(s_probeBad == 0u);
+    CHECK_END(testerBad == 0u);
+
+    /* 위반 기록 → 다음 Service 에서 DTC (타깃은 리셋 후 부팅 시) */
+    Mpu_Fault((uint32_t)(uintptr_t)&dtcMem);
+    for (uint32_t t = 0; t < 200u && !prvHasDtc(MPU_DTC_VIOLATION); t++) osDelay(5);
+    CHECK_END(prvHasDtc(MPU_DTC_VIOLATION));
+    CHECK_END(mpuState.faults == 1u);
+    CHECK_END(mpuState.fault_addr == (uint32_t)(uintptr_t)&dtcMem);
+    CHECK_END(strcmp(mpuState.fault_task, "Tester") == 0);
+    osDelay(50);
+    CHECK_END(mpuState.faults == 1u);            // 보고는 1 회
+
+    /* 전환 비용 (호스트는 pthread 전환이라 절대값은 의미 없음, 형식/복구만 확인) */
+    const Bench_Config_t cfg = { .iters = 20, .repeats = 3, .write = prvCapture };
+    Mpu_RunSwitchBench(&cfg);
+    CHECK_END(strstr(s_out, "BENCH v=1 name=ctxsw_mpu_off ") != NULL);
+    CHECK_END(strstr(s_out, "BENCH v=1 name=ctxsw_mpu_on ") != NULL);
+    CHECK_END(mpuState.enabled == 1u);
+    CHECK_END(osThreadGetPriority(osThreadGetId()) == osPriorityRealtime);
+    osDelay(1);
+    CHECK_END(prvAccess() == 0u);
+
+    printf("probe rounds=%lu fault task=%s addr=0x%08lx\n%s", (unsigned long)s_probeRounds, mpuState.fault_task,
+           (unsigned long)mpuState.fault_addr, s_out);
+    vTaskEndScheduler();
+}
+
+int main(void)
+{
+    HostBoard_Init();
+    HostBoard_CreateTasks();
+    const osThreadAttr_t tester_attributes = {
+      .name = "Tester", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    (void)osThreadNew(prvTester, NULL, &tester_attributes);
+
+    HostBoard_Run(0u);
+
+    if (s_rc == 0) printf("PASS mpu\n");
+    return s_rc;
+}
@@ -0,0 +1,180 @@
+/*
+ * test_pmic_dvfs.c  (Host build)
+ *
+ *  PMIC shadow 캐시로 buck 전압 제어: DVFS 형태 setpoint 트레이스에서
+ *  기존 방식(매번 buck 별 단일 쓰기) 대비 I2C 트랜잭션 절감량, verify/ramp 동작 확인.
+ *  Refresh 로 VOUT 을 먼저 읽은 뒤 buck 1 개만 바꿔도 나머지 buck 은 그대로.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "PMIC.h"
+#include "host_sim.h"
+#include "model_mp5475.h"
+#include "test_check.h"
+
+#define TRACE_LEN   400u
+
+static I2C_HandleTypeDef s_hi2c;
+static MMP5475_t         s_pmic;
+
+/* 결정적 setpoint 트레이스: A=코어(900/1000/1100mV, 부하에 따라), B=메모리(1200 고정),
+ * C=IO(3.3V→ 2550 상한 내 1800 고정), D=보조(대부분 1000, 가끔 1050) */
+static void prvSetpoint(uint32_t i, uint16_t mV[PMIC_VOUT_COUNT])
+{
+    static const uint16_t core[8] = { 900, 900, 1000, 1100, 1100, 1100, 1000, 900 };
+    mV[0] = core[(i / 7u) % 8u];
+    mV[1] = 1200;
+    mV[2] = 1800;
+    mV[3] = ((i % 50u) < 5u) ? 1050 : 1000;
+}
+
+static uint32_t prvTransactions(void)
+{
+    HostI2C_Stats_t st;
+    HostI2C_GetStats(I2C1, &st);
+    return st.transactions;
+}
+
+/* 기존: setpoint 마다 buck 4개를 각각 blind write */
+static uint32_t prvRunLegacy(void)
+{
+    uint16_t mV[PMIC_VOUT_COUNT];
+    HostI2C_ResetStats(I2C1);
+    for (uint32_t i = 0; i < TRACE_LEN; i++) {
+        prvSetpoint(i, mV);
+        for (uint32_t n = 0; n < PMIC_VOUT_COUNT; n++) {
+            uint8_t code = (uint8_t)(mV[n] / PMIC_VOUT_LSB_mV);
+            (void)PMIC_WriteRange(&s_hi2c, (uint8_t)(PMIC_VOUT_FIRST + n), &code, 1);
+        }
+    }
+    return prvTransactions();
+}
+
+static int prvCheckTarget(const uint16_t mV[PMIC_VOUT_COUNT])
+{
+    for (uint32_t n = 0; n < PMIC_VOUT_COUNT; n++) {
+        if (MMP5475_GetReg(&s_pmic, (uint8_t)(PMIC_VOUT_FIRST + n)) != mV[n] / PMIC_VOUT_LSB_mV) return -1;
+    }
+    return 0;
+}
+
+/* 캐시: setpoint 마다 4개 목표를 한 번에 (바뀐 buck 만, 연속 구간 burst) */
+static int prvRunCached(uint8_t verify, uint32_t *xfersOut, PMIC_Shadow_t *sh)
+{
+    uint16_t mV[PMIC_VOUT_COUNT];
+
+    PMIC_ShadowInit(sh, &s_hi2c);
+    PMIC_ShadowConfig(sh, verify, 0);
+    HostI2C_ResetStats(I2C1);
+    for (uint32_t i = 0; i < TRACE_LEN; i++) {
+        prvSetpoint(i, mV);
+        if (PMIC_BuckSetTargets(sh, mV, PMIC_BUCK_MASK_ALL) != HAL_OK) return -1;
+        if (prvCheckTarget(mV) != 0) return -1;
+    }
+    *xfersOut = prvTransactions();
+    return 0;
+}
+
+int main(void)
+{
+    PMIC_Shadow_t sh;
+    uint32_t legacy, cached, verified;
+    uint16_t mV[PMIC_VOUT_COUNT];
+
+    HAL_Init();
+    s_hi2c.Instance = I2C1;
+    s_hi2c.Init.ClockSpeed = 400000u;
+    s_hi2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+    CHECK(HAL_I2C_Init(&s_hi2c) == HAL_OK);
+    MMP5475_Init(&s_pmic);
+    CHECK(MMP5475_Attach(&s_pmic, I2C1) == 0);
+
+    /* 1) 트랜잭션 절감 */
+    legacy = prvRunLegacy();
+    MMP5475_Init(&s_pmic);      /* 레지스터 초기화 (stats 포함) — 연결은 유지 */
+    CHECK(prvRunCached(0, &cached, &sh) == 0);
+    printf("dvfs_trace   : %u setpoints, legacy=%lu cached=%lu (saved %.1f%%), suppressed=%lu\n",
+           TRACE_LEN, (unsigned long)legacy, (unsigned long)cached,
+           100.0 * (double)(legacy - cached) / (double)legacy, (unsigned long)sh.suppressed);
+    CHECK(cached * 4u < legacy);
+
+    MMP5475_Init(&s_pmic);
+    CHECK(prvRunCached(1, &verified, &sh) == 0);
+    printf("dvfs_verify  : cached+verify=%lu (saved %.1f%%)\n",
+           (unsigned long)verified, 100.0 * (double)(legacy - verified) / (double)legacy);
+    CHECK(verified < legacy);
+    CHECK(sh.verify_fails == 0u);
+
+    /* 2) verify: NAK 와 쓰기 유실 모두 실패로 보고, 이후 복구 */
+    mV[0] = 1000; mV[1] = 1200; mV[2] = 1800; mV[3] = 1000;
+    s_pmic.nak = 1;
+    mV[0] = 1150;
+    CHECK(PMIC_BuckSetTargets(&sh, mV, PMIC_BUCK_MASK_ALL) == HAL_ERROR);
+    CHECK(PMIC_BuckPending(&sh) & 0x01u);
+    s_pmic.nak = 0;
+    s_pmic.drop_writes = 1;
+    CHECK(PMIC_BuckStep(&sh) == HAL_ERROR);
+    CHECK(sh.verify_fails == 1u);
+    s_pmic.drop_writes = 0;
+    CHECK(PMIC_BuckSetTargets(&sh, mV, PMIC_BUCK_MASK_ALL) == HAL_OK);   /* 무효화 → 재읽기 → 재기록 */
+    CHECK(PMIC_BuckPending(&sh) == 0u);
+    CHECK(prvCheckTarget(mV) == 0);
+    printf("verify       : nak/lost writes detected, errors=%lu verify_fails=%lu\n",
+           (unsigned long)sh.errors, (unsigned long)sh.verify_fails);
+
+    /* 3) ramp: 900 → 1200mV, 20mV/step, A/D 동시 → step 당 쓰기 1회 */
+    MMP5475_Init(&s_pmic);
+    PMIC_ShadowInit(&sh, &s_hi2c);
+    PMIC_ShadowConfig(&sh, 0, 2);
+    mV[0] = 900; mV[1] = 1000; mV[2] = 1000; mV[3] = 1000;
+    while (1) {
+        HAL_StatusTypeDef st = PMIC_BuckSetTargets(&sh, mV, PMIC_BUCK_MASK_ALL);
+        CHECK(st == HAL_OK);
+        if (PMIC_BuckPending(&sh) == 0u) break;
+        while (PMIC_BuckPending(&sh)) CHECK(PMIC_BuckStep(&sh) == HAL_OK);
+    }
+    memset(&s_pmic.stats, 0, sizeof(s_pmic.stats));
+    mV[0] = 1200; mV[3] = 1200;
+    uint32_t steps = 0;
+    uint8_t  prevA = MMP5475_GetReg(&s_pmic, PMIC_REG_BUCKA_VOUT);
+    CHECK(PMIC_BuckSetTargets(&sh, mV, PMIC_BUCK_MASK_ALL) == HAL_OK);
+    steps++;
+    while (PMIC_BuckPending(&sh)) {
+        uint8_t a = MMP5475_GetReg(&s_pmic, PMIC_REG_BUCKA_VOUT);
+        CHECK(a > prevA && a - prevA <= 2u);
+        prevA = a;
+        CHECK(PMIC_BuckStep(&sh) == HAL_OK);
+        steps++;
+    }
+    CHECK(prvCheckTarget(mV) == 0);
+    printf("ramp         : A 900->1200, D 1000->1200 in %lu steps, write_xfers=%lu\n",
+           (unsigned long)steps, (unsigned long)s_pmic.stats.write_xfers);
+    CHECK(steps == 15u);
+    CHECK(s_pmic.stats.write_xfers == 15u);    /* A, D 가 B/C 를 사이에 두고 burst 1회로 합쳐짐 */
+
+    /* 4) 레거시 API 도 pmicShadow 경유 시 중복 생략 */
+    MMP5475_Init(&s_pmic);
+    PMIC_ShadowInit(&pmicShadow, &s_hi2c);
+    HostI2C_ResetStats(I2C1);
+    for (int i = 0; i < 10; i++) CHECK(PMIC_SetBuckVoltage(&s_hi2c, PMIC_REG_BUCKB_VOUT, 1100.0f) == HAL_OK);
+    CHECK(MMP5475_GetReg(&s_pmic, PMIC_REG_BUCKB_VOUT) == 110u);
+    printf("legacy_api   : 10 identical calls -> %lu transactions\n", (unsigned long)prvTransactions());
+    CHECK(prvTransactions() <= 4u);    /* VOUT 읽기(2 START) + 쓰기 1 */
+    CHECK(PMIC_SetBuckVoltage(&s_hi2c, PMIC_REG_BUCKB_VOUT, 9999.0f) == HAL_ERROR);
+
+    /* 5) Refresh 가 VOUT 을 먼저 채운 상태에서 buck A 만 변경 → B/C/D 는 목표 없음 (0V 로 내리지 않음) */
+    MMP5475_Init(&s_pmic);
+    for (uint8_t r = PMIC_VOUT_FIRST; r < PMIC_VOUT_FIRST + PMIC_VOUT_COUNT; r++) MMP5475_SetReg(&s_pmic, r, 100u);
+    PMIC_ShadowInit(&sh, &s_hi2c);
+    CHECK(PMIC_ShadowRefresh(&sh, PMIC_GRP_ALL) == HAL_OK);
+    mV[0] = 1200;
+    CHECK(PMIC_BuckSetTargets(&sh, mV, 0x01u) == HAL_OK);
+    CHECK(PMIC_BuckPending(&sh) == 0u);
+    CHECK(MMP5475_GetReg(&s_pmic, PMIC_REG_BUCKA_VOUT) == 120u);
+    for (uint8_t r = PMIC_VOUT_FIRST + 1u; r < PMIC_VOUT_FIRST + PMIC_VOUT_COUNT; r++) CHECK(MMP5475_GetReg(&s_pmic, r) == 100u);
+
+    printf("PASS pmic_dvfs\n");
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * test_ring.c  (Host build)
+ *
+ *  SPSC 링 (Core/Src/Ring.c)
+ *    - 초기화: 2의 거듭제곱이 아니면 거절, 가득 차면 들어가는 만큼만 + dropped, 경계에서 나뉘는 bulk
+ *    - 스트레스: 실제 생산자 스레드 / 소비자 스레드 (pthread, 커널 없이) 로 순서/내용 확인 + ops/s
+ *        u32 x1      : 4B 항목, 1 개씩
+ *        u32 bulk    : 4B 항목, 1~64 개씩 (생산자/소비자 크기 따로 무작위)
+ *        uds_rx      : UDS_RxFrame_t 크기 항목 (값 복사), 링 8 개, 1~4 개씩
+ *        trace       : Trace_Entry_t 크기 항목, 링 256 개, 1~16 개씩
+ *    - 보드: UART4 로 'T' 수신 (RX ISR → uartRxRing → UARTTask) → trace 덤프 출력
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "Ring.h"
+#include "Trace.h"
+#include "test_check.h"
+
+#define ELEM_MAX   128u
+
+typedef struct {
+    const char *name;
+    uint16_t    elem;
+    uint32_t    count;         // 링 항목 수
+    uint32_t    bulk;          // 1 회 최대 항목 수 (1 = 하나씩)
+    uint32_t    items;         // 전체 전달 항목 수
+} Stress_t;
+
+typedef struct {
+    const Stress_t *s;
+    Ring_t          ring;
+    uint8_t        *buf;
+    uint32_t        seed;
+    uint32_t        errors;
+    uint64_t        full_spins, empty_spins;
+} Ctx_t;
+
+/* 항목 내용: 앞 4B = 순번, 나머지는 순번으로 정해지는 바이트 */
+static void prvFill(uint8_t *p, uint16_t elem, uint32_t seq)
+{
+    memcpy(p, &seq, elem < 4u ? elem : 4u);
+    for (uint16_t i = 4; i < elem; i++) p[i] = (uint8_t)(seq * 31u + i);
+}
+
+static int prvMatch(const uint8_t *p, uint16_t elem, uint32_t seq)
+{
+    uint8_t want[ELEM_MAX];
+    prvFill(want, elem, seq);
+    return memcmp(p, want, elem) == 0;
+}
+
+static uint32_t prvRand(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+static void *prvProducer(void *arg)
+{
+    Ctx_t *c = (Ctx_t *)arg;
+    uint8_t tmp[64u * ELEM_MAX];
+    uint32_t seq = 0, rnd = c->seed;
+
+    while (seq < c->s->items) {
+        uint32_t n = (c->s->bulk == 1u) ? 1u : 1u + prvRand(&rnd) % c->s->bulk;
+        if (n > c->s->items - seq) n = c->s->items - seq;
+        for (uint32_t i = 0; i < n; i++) prvFill(&tmp[i * c->s->elem], c->s->elem, seq + i);
+        uint32_t done = 0;
+        while (done < n) {
+            uint32_t k = Ring_Push(&c->ring, &tmp[done * c->s->elem], n - done);
+            if (k == 0u) { c->full_spins++; sched_yield(); }
+            done += k;
+        }
+        seq += n;
+    }
+    return NULL;
+}
+
+static void *prvConsumer(void *arg)
+{
+    Ctx_t *c = (Ctx_t *)arg;
+    uint8_t tmp[64u * ELEM_MAX];
+    uint32_t seq = 0, rnd = c->seed ^ 0x5A5Au;
+
+    while (seq < c->s->items) {
+        uint32_t want = (c->s->bulk == 1u) ? 1u : 1u + prvRand(&rnd) % c->s->bulk;
+        uint32_t n = Ring_Pop(&c->ring, tmp, want);
+        if (n == 0u) { c->empty_spins++; sched_yield(); continue; }
+        for (uint32_t i = 0; i < n; i++) {
+            if (!prvMatch(&tmp[i * c->s->elem], c->s->elem, seq + i) && c->errors++ == 0u) {
+                printf("%s: item %lu mismatch\n", c->s->name, (unsigned long)(seq + i));
+            }
+        }
+        seq += n;
+    }
+    return NULL;
+}
+
+static double prvSec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int prvStress(const Stress_t *s)
+{
+    static Ctx_t c;
+    pthread_t prod, cons;
+
+    memset(&c, 0, sizeof(c));
+    c.s = s;
+    c.seed = 46u;
+    c.buf = malloc((size_t)s->elem * s->count);
+    CHECK(c.buf != NULL);
+    CHECK(Ring_Init(&c.ring, c.buf, s->elem, s->count) == HAL_OK);
+
+    double t0 = prvSec();
+    CHECK(pthread_create(&cons, NULL, prvConsumer, &c) == 0);
+    CHECK(pthread_create(&prod, NULL, prvProducer, &c) == 0);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    double dt = prvSec() - t0;
+
+    printf("%-9s elem=%3u ring=%4lu bulk<=%-2lu items=%8lu  %6.1f Mops/s  %7.1f MB/s  full_spins=%llu empty_spins=%llu\n",
+           s->name, (unsigned)s->elem, (unsigned long)s->count, (unsigned long)s->bulk,
+           (unsigned long)s->items, s->items / dt / 1e6, (double)s->items * s->elem / dt / 1e6,
+           (unsigned long long)c.full_spins, (unsigned long long)c.empty_spins);
+    CHECK(c.errors == 0u);
+    CHECK(Ring_Count(&c.ring) == 0u);
+    free(c.buf);
+    return 0;
+}
+
+/* 단일 스레드: 경계/가득 참 */
+static int prvBasic(void)
+{
+    Ring_t r;
+    uint32_t buf[8], in[16], out[16];
+
+    CHECK(Ring_Init(&r, buf, 4, 0) == HAL_ERROR);
+    CHECK(Ring_Init(&r, buf, 4, 6) == HAL_ERROR);
+    CHECK(Ring_Init(&r, buf, 0, 8) == HAL_ERROR);
+    CHECK(Ring_Init(&r, NULL, 4, 8) == HAL_ERROR);
+    CHECK(Ring_Init(&r, buf, 4, 8) == HAL_OK);
+    CHECK(sizeof(r) >= 2u * RING_LINE);
+    CHECK((uintptr_t)&r.tail - (uintptr_t)&r.head >= RING_LINE);
+
+    for (uint32_t i = 0; i < 16u; i++) in[i] = 100u + i;
+    CHECK(Ring_Pop(&r, out, 1) == 0u);
+    CHECK(Ring_Push(&r, in, 5) == 5u);
+    CHECK(Ring_Pop(&r, out, 3) == 3u && out[0] == 100u && out[2] == 102u);
+    // 인덱스 5 에서 8 개 넣기 → 6 개만 (3+6 = 8 가득), 경계에서 나뉨
+    CHECK(Ring_Push(&r, &in[5], 8) == 6u);
+    CHECK(r.dropped == 2u && Ring_Count(&r) == 8u);
+    CHECK(Ring_Push(&r, in, 1) == 0u && r.dropped == 3u);
+    CHECK(Ring_Pop(&r, out, 16) == 8u);
+    for (uint32_t i = 0; i < 8u; i++) CHECK(out[i] == 103u + i);
+    CHECK(Ring_Count(&r) == 0u);
+
+    // 인덱스 순환 (uint32 넘침) 직전에서도 같은 동작
+    r.head = r.tail = r.tail_seen = r.head_seen = 0xFFFFFFFCu;
+    CHECK(Ring_Push(&r, in, 8) == 8u && Ring_Count(&r) == 8u);
+    CHECK(Ring_Pop(&r, out, 8) == 8u && out[0] == 100u && out[7] == 107u);
+    CHECK(r.head == 4u && r.tail == 4u);
+    return 0;
+}
+
+/* ===== 보드: UART4 'T' → trace 덤프 ===== */
+static uint8_t  s_uart[64u * 1024u];
+static uint32_t s_uart_len;
+
+static void prvOnUart(void *ctx, const uint8_t *data, uint16_t len)
+{
+    (void)ctx;
+    for (uint16_t i = 0; i < len && s_uart_len < sizeof(s_uart); i++) s_uart[s_uart_len++] = data[i];
+}
+
+static void prvInjectCmd(void *arg)
+{
+    static const uint8_t cmd[3] = { 'x', UART_CMD_TRACE, 'y' };    // 모르는 명령은 무시
+    (void)arg;
+    (void)HostUART_Inject(UART4, cmd, sizeof(cmd));
+}
+
+/* 수신 중 overrun: ErrorCallback 이 다시 시작해야 다음 명령을 받음 */
+static void prvInjectOverrun(void *arg)
+{
+    (void)arg;
+    (void)HostUART_InjectError(UART4, HAL_UART_ERROR_ORE);
+}
+
+/* RX ISR 의 재시작이 HAL_BUSY 로 실패한 상태: UARTTask 가 다시 시작해야 함 */
+static void prvLoseRearm(void *arg)
+{
+    (void)arg;
+    huart4.RxState = HAL_UART_STATE_READY;
+}
+
+static const uint8_t *prvFind(const uint8_t *hay, uint32_t n, const char *needle)
+{
+    size_t k = strlen(needle);
+    for (uint32_t i = 0; i + k <= n; i++) {
+        if (memcmp(&hay[i], needle, k) == 0) return &hay[i];
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    static const Stress_t cases[] = {
+        { "u32_x1",   4,                     1024, 1,  4000000 },
+        { "u32_bulk", 4,                     1024, 64, 20000000 },
+        { "uds_rx",   sizeof(UDS_RxFrame_t), UDS_RX_RING_LEN, 4, 1000000 },
+        { "trace",    sizeof(Trace_Entry_t), 256,  16, 4000000 },
+    };
+
+    if (prvBasic()) return 1;
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        if (prvStress(&cases[i])) return 1;
+    }
+
+    HostBoard_Init();
+    HostUART_SetTxListener(UART4, prvOnUart, NULL);
+    HostBoard_CreateTasks();
+    HostSim_Schedule(50000u, prvInjectOverrun, NULL);
+    HostSim_Schedule(100000u, prvInjectCmd, NULL);
+    HostSim_Schedule(1000000u, prvLoseRearm, NULL);
+    HostSim_Schedule(1100000u, prvInjectCmd, NULL);
+    HostBoard_Run(2000u);
+
+    const uint8_t *hdr = prvFind(s_uart, s_uart_len, "TRACE v=1 ");
+    CHECK(hdr != NULL);
+    uint32_t rest = (uint32_t)(&s_uart[s_uart_len] - hdr);
+    CHECK(prvFind(hdr, rest, "\nE ") != NULL);
+    const uint8_t *hdr2 = prvFind(hdr + 1, rest - 1u, "TRACE v=1 ");      // 재시작 뒤 두 번째 명령
+    CHECK(hdr2 != NULL);
+    CHECK(prvFind(hdr2, (uint32_t)(&s_uart[s_uart_len] - hdr2), "\nE ") != NULL);
+    CHECK(Ring_Count(&uartRxRing) == 0u && uartRxRing.dropped == 0u);
+    CHECK(udsRxRing.dropped == 0u);
+    printf("uart: %lu bytes out, trace dump at offset %lu\n",
+           (unsigned long)s_uart_len, (unsigned long)(hdr - s_uart));
+
+    printf("PASS ring\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * test_stack.c  (Host build)
+ *
+ *  스택 / heap 감시 (Core/Src/StackMon.c, 전체 보드 Task 구성)
+ *    - UART4 'S' → 덤프: 모든 Task 의 STACK 줄 + HEAP / MSP / OVF 줄
+ *    - heap 고갈: pvPortMalloc 실패 → 훅 횟수 + DTC P0604-02
+ *    - 스택 오버플로: SPITask 스택 바닥의 채움 패턴을 깨뜨림 → 전환 시 훅 → DTC P0604-01 (멈추지 않음)
+ *      호스트는 리셋 대신 기록만: 같은 실행에서 defaultTask 가 보고
+ *    - DID 0xD170: heap 여유 / 최소 여유 / 최대 블록 / malloc 실패 / 오버플로
+ *    usage: test_stack [dump.txt]   (UART 덤프 저장: Host/Tools/stack_report -r 입력)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "test_check.h"
+
+extern osThreadId_t defaultTaskHandle;
+extern osThreadId_t SPITaskHandle;
+
+static int s_rc;
+
+/* ===== UART4 캡처 ===== */
+static char     s_uart[8192];
+static uint32_t s_uart_len;
+static char     s_dump[2048];
+static uint32_t s_dump_len;
+
+static void prvOnUart(void *ctx, const uint8_t *data, uint16_t len)
+{
+    (void)ctx;
+    for (uint16_t i = 0; i < len && s_uart_len < sizeof(s_uart) - 1u; i++) s_uart[s_uart_len++] = (char)data[i];
+}
+
+static void prvInjectCmd(void *arg)
+{
+    static const uint8_t cmd[1] = { UART_CMD_STACK };
+    (void)arg;
+    (void)HostUART_Inject(UART4, cmd, sizeof(cmd));
+}
+
+static void prvCapture(const char *line)
+{
+    size_t n = strlen(line);
+    if (s_dump_len + n < sizeof(s_dump)) {
+        memcpy(&s_dump[s_dump_len], line, n);
+        s_dump_len += (uint32_t)n;
+    }
+}
+
+/* 파이프라인이 UART4 로 보내는 2B 원시 DTC 사이에서 덤프 텍스트 찾기 */
+static const char *prvFind(const char *hay, uint32_t n, const char *needle)
+{
+    size_t k = strlen(needle);
+    for (uint32_t i = 0; i + k <= n; i++) {
+        if (memcmp(&hay[i], needle, k) == 0) return &hay[i];
+    }
+    return NULL;
+}
+
+static int prvHasDtc(uint32_t dtc)
+{
+    DTC_Record_t rec[DTCMEM_SLOTS];
+    uint16_t n = DTCMem_ReadByMask(&dtcMem, DTC_ST_TF, rec, DTCMEM_SLOTS);
+    for (uint16_t i = 0; i < n && i < DTCMEM_SLOTS; i++) {
+        if (rec[i].dtc[0] == (uint8_t)(dtc >> 16) && rec[i].dtc[1] == (uint8_t)(dtc >> 8) && rec[i].dtc[2] == (uint8_t)dtc) return 1;
+    }
+    return 0;
+}
+
+static void prvTester(void *argument)
+{
+    (void)argument;
+
+    /* 덤프 (100ms 에 'S' 주입) + DTC 메모리 mount 대기 */
+    for (uint32_t t = 0; t < 1000u && !DTCMem_Ready(&dtcMem); t += 10u) osDelay(10);
+    osDelay(300);
+    CHECK_END(DTCMem_Ready(&dtcMem));
+
+    static const char *tasks[] = { "defaultTask", "I2CTask", "SPITask", "CANTask", "UARTTask", "SupplyMonTask",
+                                   "DvfsTask", "LogTask", "EECacheTask", "UDSTask", "IDLE", "Tmr_Svc" };
+    char key[48];
+    for (uint32_t i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++) {
+        snprintf(key, sizeof(key), "STACK v=1 task=%s free_min=", tasks[i]);
+        const char *p = prvFind(s_uart, s_uart_len, key);
+        CHECK_END(p != NULL);
+        CHECK_END(strtoul(p + strlen(key), NULL, 10) > 0u);
+    }
+    CHECK_END(prvFind(s_uart, s_uart_len, "HEAP v=1 size=15360 ") != NULL);
+    CHECK_END(prvFind(s_uart, s_uart_len, " fails=0\n") != NULL);
+    CHECK_END(prvFind(s_uart, s_uart_len, "OVF v=1 count=0 task=-\nE\n") != NULL);
+    CHECK_END(stackMon.overflows == 0u && stackMon.malloc_fails == 0u);
+
+    /* heap 고갈: NULL + 훅 + DTC */
+    void *big = pvPortMalloc(configTOTAL_HEAP_SIZE);
+    CHECK_END(big == NULL);
+    CHECK_END(stackMon.malloc_fails == 1u);
+
+    /* 스택 오버플로: 바닥 16B 패턴이 깨진 채로 SPITask 가 전환되면 훅 */
+    TaskStatus_t st;
+    vTaskGetInfo((TaskHandle_t)SPITaskHandle, &st, pdFALSE, eInvalid);
+    uint32_t *bottom = (uint32_t *)st.pxStackBase;
+    CHECK_END(bottom[0] == STACKMON_FILL);
+    /* 호스트는 리셋이 없다: 보고(defaultTask) 전에 패턴을 복구해야 검출이 1 회로 끝남 */
+    osThreadSuspend(defaultTaskHandle);
+    bottom[0] = 0xDEADBEEFu;
+    osDelay(10);                             // SPITask 는 매 tick 돈다 (CommMutex 차례를 기다릴 수 있음)
+    bottom[0] = STACKMON_FILL;
+    osThreadResume(defaultTaskHandle);
+    for (uint32_t t = 0; t < 200u && stackMon.overflows == 0u; t++) osDelay(1);
+
+    CHECK_END(stackMon.overflows == 1u);
+    CHECK_END(strcmp(stackMon.task, "SPITask") == 0);
+    CHECK_END(stackMon.heap_reported == 1u);
+    CHECK_END(prvHasDtc(STACKMON_DTC_STACK));
+    CHECK_END(prvHasDtc(STACKMON_DTC_HEAP));
+
+    /* 보고 뒤에도 Task 는 계속 돈다 (오버플로 후 멈추지 않음) */
+    uint32_t seen = stackMon.overflows;
+    osDelay(50);
+    CHECK_END(stackMon.overflows == seen);
+    CHECK_END(eTaskGetState((TaskHandle_t)SPITaskHandle) != eSuspended);
+
+    /* D170 */
+    static const uint8_t req[2] = { 0xD1, 0x70 };
+    uint8_t rsp[32];
+    uint16_t n = 0;
+    CHECK_END(DID_ReadRequest(&didTable, req, sizeof(req), rsp, sizeof(rsp), &n) == 0u);
+    CHECK_END(n == 12u && rsp[0] == 0xD1 && rsp[1] == 0x70);
+    uint16_t heapFree = (uint16_t)((rsp[2] << 8) | rsp[3]), heapMin = (uint16_t)((rsp[4] << 8) | rsp[5]);
+    CHECK_END(heapFree > 0u && heapMin <= heapFree && heapFree < configTOTAL_HEAP_SIZE);
+    CHECK_END(rsp[9] == 1u && rsp[11] == 1u);
+
+    StackMon_Dump(prvCapture);
+    CHECK_END(prvFind(s_dump, s_dump_len, "OVF v=1 count=1 task=SPITask\n") != NULL);
+    CHECK_END(prvFind(s_dump, s_dump_len, " fails=1\n") != NULL);
+
+    const char *hdr = prvFind(s_uart, s_uart_len, "STACK v=1 ");
+    const char *end = prvFind(hdr, s_uart_len - (uint32_t)(hdr - s_uart), "\nE\n");
+    printf("heap free=%u min=%u, overflow reported for %s\n%.*s\n", heapFree, heapMin, stackMon.task,
+           (int)(end - hdr), hdr);
+    vTaskEndScheduler();
+}
+
+int main(int argc, char **argv)
+{
+    HostBoard_Init();
+    HostUART_SetTxListener(UART4, prvOnUart, NULL);
+    HostBoard_CreateTasks();
+    const osThreadAttr_t tester_attributes = {
+      .name = "Tester", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    (void)osThreadNew(prvTester, NULL, &tester_attributes);
+    HostSim_Schedule(100000u, prvInjectCmd, NULL);
+
+    HostBoard_Run(0u);
+
+    if (s_rc == 0 && argc > 1) {
+        FILE *fp = fopen(argv[1], "w");
+        if (fp == NULL) { perror(argv[1]); return 1; }
+        fwrite(s_uart, 1, s_uart_len, fp);
+        fclose(fp);
+    }
+    if (s_rc == 0) printf("PASS stack\n");
+    return s_rc;
+}
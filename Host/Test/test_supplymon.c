@@ -0,0 +1,204 @@
+/*
+ * test_supplymon.c  (Host build)
+ *
+ *  SupplyMon 필터/임계값 판정을 합성 파형으로 검증하고 블록당 처리 시간을 측정.
+ *  마지막으로 보드 전체(TIM2 → ADC1 DMA → SupplyMonTask → 파이프라인)에서 UV DTC 전파 확인.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "SupplyMon.h"
+#include "test_check.h"
+
+#define FS_HZ        12800.0
+#define BLOCK_MS     (SUPPLYMON_BLOCK * 1000.0 / FS_HZ)
+
+typedef double (*Wave_t)(double t_s);
+
+static uint16_t prvCounts(double supply_mV)
+{
+    double c = supply_mV / 11.0 * SUPPLYMON_ADC_FULL / SUPPLYMON_ADC_VREF_mV;
+    if (c < 0.0) c = 0.0;
+    if (c > SUPPLYMON_ADC_FULL) c = SUPPLYMON_ADC_FULL;
+    return (uint16_t)(c + 0.5);
+}
+
+/* 결정적 잡음 (LCG) */
+static uint32_t s_rng = 12345u;
+static double prvNoise(double amp_mV)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return ((double)(s_rng >> 8) / 16777216.0 - 0.5) * 2.0 * amp_mV;
+}
+
+/* 파형을 블록 단위로 흘려서 첫 이벤트 시각(ms) 반환 (없으면 -1) */
+static double prvRun(SupplyMon_t *m, Wave_t w, double dur_s, uint8_t evMask, uint8_t *evAll)
+{
+    uint16_t blk[SUPPLYMON_BLOCK];
+    double first = -1.0;
+    uint32_t nblk = (uint32_t)(dur_s * FS_HZ / SUPPLYMON_BLOCK);
+
+    *evAll = 0;
+    for (uint32_t b = 0; b < nblk; b++) {
+        for (uint32_t i = 0; i < SUPPLYMON_BLOCK; i++) {
+            double t = (double)(b * SUPPLYMON_BLOCK + i) / FS_HZ;
+            blk[i] = prvCounts(w(t));
+        }
+        uint8_t ev = SupplyMon_ProcessBlock(m, blk, SUPPLYMON_BLOCK);
+        *evAll |= ev;
+        if ((ev & evMask) && first < 0.0) first = (b + 1) * BLOCK_MS;
+    }
+    return first;
+}
+
+/* ===== 합성 파형 ===== */
+static double wStepDown(double t)  { return (t < 0.100) ? 12000.0 : 8000.0; }
+static double wStepUp(double t)    { return (t < 0.100) ? 12000.0 : 17000.0; }
+static double wRamp(double t)      { return (t < 0.100) ? 12000.0 : 12000.0 - (t - 0.100) * 4000.0; } /* 4V/s */
+static double wRipple(double t)    { return 12000.0 + 1500.0 * sin(2.0 * M_PI * 100.0 * t) + prvNoise(300.0); }
+static double wSpikes(double t)
+{
+    /* 블록마다 1샘플 0V 글리치 + 40us 크랭킹 노이즈 */
+    uint32_t k = (uint32_t)(t * FS_HZ + 0.5);
+    return ((k % SUPPLYMON_BLOCK) == 17u) ? 0.0 : 12000.0 + prvNoise(500.0);
+}
+static double wDipRecover(double t)
+{
+    if (t < 0.100) return 12000.0;
+    if (t < 0.300) return 8500.0;
+    return 12000.0;
+}
+static double wShortDip(double t)  { return (t >= 0.100 && t < 0.104) ? 6000.0 : 12000.0; } /* 4ms */
+
+static int prvPureTests(void)
+{
+    SupplyMon_t m;
+    uint8_t ev;
+    double lat;
+
+    /* 1) 12V → 8V 계단: 디바운스 2블록 + IIR 수렴 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    lat = prvRun(&m, wStepDown, 0.3, SUPPLYMON_EV_UV_SET, &ev);
+    CHECK(lat > 0.0);
+    lat -= 100.0;
+    printf("step_uv      : detect %.1f ms after step, supply=%u mV\n", lat, m.supply_mV);
+    CHECK(lat <= 25.0);
+    CHECK(SupplyMon_ActiveDtc(&m) == SUPPLYMON_DTC_UV);
+    CHECK(m.dtc_uv.status & DTC_ST_CDTC);
+    CHECK(!(m.dtc_ov.status & DTC_ST_TF));
+
+    /* 2) 12V → 17V 계단 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    lat = prvRun(&m, wStepUp, 0.3, SUPPLYMON_EV_OV_SET, &ev) - 100.0;
+    printf("step_ov      : detect %.1f ms after step\n", lat);
+    CHECK(lat > 0.0 && lat <= 25.0);
+    CHECK(SupplyMon_ActiveDtc(&m) == SUPPLYMON_DTC_OV);
+
+    /* 3) 4V/s 하강 램프: 9V 교차(t=850ms) 이후 지연 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    lat = prvRun(&m, wRamp, 1.2, SUPPLYMON_EV_UV_SET, &ev) - 850.0;
+    printf("ramp_uv      : detect %.1f ms after 9V crossing\n", lat);
+    CHECK(lat > 0.0 && lat <= 30.0);
+
+    /* 4) 리플(±1.5V 100Hz) + 잡음: 오검출 없음 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    (void)prvRun(&m, wRipple, 2.0, 0xFF, &ev);
+    printf("ripple       : events=0x%02X supply=%u mV\n", ev, m.supply_mV);
+    CHECK(ev == 0u);
+
+    /* 5) 단일 샘플 글리치: 블록 평균으로 흡수 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    (void)prvRun(&m, wSpikes, 2.0, 0xFF, &ev);
+    printf("spikes       : events=0x%02X supply=%u mV\n", ev, m.supply_mV);
+    CHECK(ev == 0u);
+
+    /* 6) 4ms 순간 강하: 디바운스로 무시 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    (void)prvRun(&m, wShortDip, 0.5, 0xFF, &ev);
+    printf("short_dip    : events=0x%02X\n", ev);
+    CHECK(ev == 0u);
+
+    /* 7) 강하 후 회복: 해제 이벤트, TF 해제, CDTC 유지 */
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    (void)prvRun(&m, wDipRecover, 0.5, 0xFF, &ev);
+    printf("dip_recover  : events=0x%02X status=0x%02X\n", ev, m.dtc_uv.status);
+    CHECK(ev == (SUPPLYMON_EV_UV_SET | SUPPLYMON_EV_UV_CLR));
+    CHECK(SupplyMon_ActiveDtc(&m) == 0u);
+    CHECK(!(m.dtc_uv.status & DTC_ST_TF));
+    CHECK(m.dtc_uv.status & DTC_ST_CDTC);
+    return 0;
+}
+
+/* 블록 처리 CPU 시간 (호스트 ns, 상대 비교용) */
+static void prvCost(void)
+{
+    SupplyMon_t m;
+    uint16_t blk[SUPPLYMON_BLOCK];
+    struct timespec a, b;
+    const uint32_t n = 200000u;
+    volatile uint8_t sink = 0;
+
+    for (uint32_t i = 0; i < SUPPLYMON_BLOCK; i++) blk[i] = prvCounts(12000.0 + prvNoise(200.0));
+    SupplyMon_Init(&m, &SupplyMon_DefaultConfig);
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    for (uint32_t i = 0; i < n; i++) sink ^= SupplyMon_ProcessBlock(&m, blk, SUPPLYMON_BLOCK);
+    clock_gettime(CLOCK_MONOTONIC, &b);
+    double ns = ((double)(b.tv_sec - a.tv_sec) * 1e9 + (double)(b.tv_nsec - a.tv_nsec)) / n;
+    printf("cost         : %.1f ns/block (%u samples, %.2f ns/sample)\n", ns, SUPPLYMON_BLOCK, ns / SUPPLYMON_BLOCK);
+    (void)sink;
+}
+
+/* ===== 보드 통합: 60ms 에 8V 로 강하 → P0562 가 EEPROM/CAN 으로 ===== */
+static uint32_t s_can_hits;
+
+static void prvOnCan(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id == UDS_RES_CANID && f->dlc == 2u && f->data[0] == 0x05u && f->data[1] == 0x62u) s_can_hits++;
+}
+
+static void prvDrop(void *arg)
+{
+    (void)arg;
+    HostBoard_SetSupply_mV(8000u);
+}
+
+static int prvBoardTest(void)
+{
+    HostADC_Stats_t st;
+
+    HostBoard_Init();
+    HostCAN_AddNode(CAN1, prvOnCan, NULL);
+    HostSim_Schedule(60000u, prvDrop, NULL);
+
+    HostBoard_CreateTasks();
+    HostBoard_Run(200u);
+
+    HostADC_GetStats(ADC1, &st);
+    printf("board        : samples=%lu half=%lu full=%lu overruns=%lu supply=%u mV can=%lu\n",
+           (unsigned long)st.samples, (unsigned long)st.half_irqs, (unsigned long)st.full_irqs,
+           (unsigned long)supplyMon.overruns, supplyMon.supply_mV, (unsigned long)s_can_hits);
+
+    /* 200ms * 12.8kHz = 2560 샘플 (반 버퍼 단위) */
+    CHECK(st.samples >= 2496u && st.samples <= 2560u);
+    CHECK(st.half_irqs > 0u && st.full_irqs > 0u);
+    CHECK(supplyMon.overruns == 0u);
+    CHECK(SupplyMon_ActiveDtc(&supplyMon) == SUPPLYMON_DTC_UV);
+    CHECK(g_eeprom.mem[0] == 0x05u && g_eeprom.mem[1] == 0x62u);
+    CHECK(s_can_hits > 0u);
+    return 0;
+}
+
+int main(void)
+{
+    if (prvPureTests() != 0) return 1;
+    prvCost();
+    if (prvBoardTest() != 0) return 1;
+    printf("PASS supplymon\n");
+    return 0;
+}
@@ -0,0 +1,353 @@
+/*
+ * test_uds_timing.c  (Host build)
+ *
+ *  UDS 세션/보안/TesterPresent 와 P2, P2*, S3 타이밍 (전체 보드 Task 구성 + 부하).
+ *  부하: 외부 노드 0x100 프레임 1ms 주기 (0x7E8 보다 중재 우선, 버스 ~40 %)
+ *        + UDSTask 보다 높은 우선순위의 CPU 부하 Task (20ms 마다 128k cycle)
+ *  테스터 Task 가 요청 → 응답을 차례로 주고받으며 요청 완료 → 첫 응답 시간을 모은다.
+ *    - 모든 첫 응답(최종 또는 0x78) ≤ P2server, 0x78 이후 최종 응답 ≤ P2*server
+ *    - 0x14 (DTC 5 개 삭제, 다른 writer 가 EEPROM 을 쥔 동안 → 커밋 > P2) 는 0x78 후 최종 응답
+ *      처리 중 도착한 3E 00 은 0x14 의 0x78 SID 를 바꾸지 않고, 자기 수신부터 P2 안에 응답
+ *    - 10 02 (programming): 부트로더 전환이 없으므로 NRC 0x22
+ *    - 보안: 잘못된 key 0x35, seed 없는 key 0x24, 3 회 실패 0x36 → 지연 중 0x37
+ *    - S3: 요청이 끊기면 default 세션 복귀 (보안 잠금, DVFS 진단 요구 해제)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_board.h"
+#include "host_sim.h"
+#include "BusMgr.h"
+#include "DTCMem.h"
+#include "test_check.h"
+
+#define BG_PERIOD_US     1000u
+#define LOAD_PERIOD_MS   20u
+#define LOAD_CYCLES      128000u   /* 16MHz 에서 8ms */
+#define ROUNDS           120u
+#define ROUND_GAP_MS     25u
+#define MAX_SAMPLES      256u
+#define EE_BUSY_ADDR     0x2000u   /* DTC 영역 밖 */
+#define EE_BUSY_PAGES    5u        /* 다른 writer 가 EEPROM 을 ~35ms 점유 (page 당 Twc + WIP 폴링) */
+
+static int          s_rc;
+static osThreadId_t s_tester;
+
+/* ===== 버스/부하 ===== */
+static void prvBgEvt(void *arg)
+{
+    static const uint8_t d[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    (void)arg;
+    (void)HostCAN_Inject(CAN1, 0x100u, d, 8);
+    HostSim_Schedule(BG_PERIOD_US, prvBgEvt, NULL);
+}
+
+static void prvLoadTask(void *argument)
+{
+    (void)argument;
+    for (;;) {
+        HostSim_CpuCycles(LOAD_CYCLES);
+        osDelay(LOAD_PERIOD_MS);
+    }
+}
+
+/* ===== 테스터 노드 ===== */
+#define RX_RING  8u
+static HostCAN_Frame_t  s_rx[RX_RING];
+static volatile uint32_t s_rx_head, s_rx_tail;
+
+static void prvNode(void *ctx, const HostCAN_Frame_t *f)
+{
+    (void)ctx;
+    if (f->id != UDS_RES_CANID || f->dlc != 8u) return;      /* 파이프라인 DTC 프레임(DLC 2) 제외 */
+    s_rx[s_rx_head % RX_RING] = *f;
+    s_rx_head++;
+    osThreadFlagsSet(s_tester, 1u);
+}
+
+static uint32_t prvFrameUs(void)
+{
+    return (47u + 64u + (34u + 64u - 1u) / 4u) * HostCAN_BitTimeNs(CAN1) / 1000u;
+}
+
+typedef struct {
+    const char *name;
+    uint32_t n;
+    uint32_t us[MAX_SAMPLES];
+} Dist_t;
+
+static Dist_t s_dist[4] = { { "session" }, { "security" }, { "tester_present" }, { "read_dtc" } };
+static uint32_t s_max_first_us, s_max_final_us, s_pending;
+
+static Dist_t *prvDist(uint8_t sid)
+{
+    switch (sid) {
+    case UDS_SVC_SESSION_CONTROL: return &s_dist[0];
+    case UDS_SVC_SECURITY_ACCESS: return &s_dist[1];
+    case UDS_SVC_TESTER_PRESENT:  return &s_dist[2];
+    case UDS_SVC_READ_DTC_INFO:   return &s_dist[3];
+    default:                      return NULL;
+    }
+}
+
+/* 다음 응답 프레임. 시간 초과 0 */
+static int prvRecv(HostCAN_Frame_t *f)
+{
+    while (s_rx_tail == s_rx_head) {
+        if (osThreadFlagsWait(1u, osFlagsWaitAny, UDS_P2X_SERVER_MS + 1000u) == (uint32_t)osErrorTimeout) return 0;
+    }
+    *f = s_rx[s_rx_tail % RX_RING];
+    s_rx_tail++;
+    return 1;
+}
+
+static int prvIsPending(const HostCAN_Frame_t *f)
+{
+    return f->data[0] == 3u && f->data[1] == UDS_SID_NEGATIVE_RESPONSE && f->data[3] == UDS_NRC_RESPONSE_PENDING;
+}
+
+/* 요청 1 개 → 최종 응답 (0x78 은 건너뜀, SID 는 이 요청이어야 함). 반환: 응답 길이 (PCI), 시간 초과 0 */
+static uint8_t prvExchange(const uint8_t *req, uint8_t len, uint8_t *rsp, uint32_t *pendings)
+{
+    uint8_t frame[8] = { len, 0, 0, 0, 0, 0, 0, 0 };
+    uint64_t t_prev;
+    uint8_t first = 1;
+
+    memcpy(&frame[1], req, len);
+    s_rx_tail = s_rx_head;
+    osThreadFlagsClear(1u);
+    t_prev = HostSim_NowUs() + prvFrameUs();
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, frame, 8);
+    if (pendings) *pendings = 0;
+
+    for (;;) {
+        HostCAN_Frame_t f;
+        if (!prvRecv(&f)) return 0;
+        uint32_t dt = (uint32_t)(f.t_us - t_prev);
+        if (first) {
+            Dist_t *d = prvDist(req[0]);
+            if (d != NULL && d->n < MAX_SAMPLES) d->us[d->n++] = dt;
+            if (dt > s_max_first_us) s_max_first_us = dt;
+            first = 0;
+        } else if (dt > s_max_final_us) {
+            s_max_final_us = dt;
+        }
+        t_prev = f.t_us;
+        if (prvIsPending(&f)) {
+            CHECK_END(f.data[2] == req[0]);
+            s_pending++;
+            if (pendings) (*pendings)++;
+            continue;
+        }
+        memcpy(rsp, &f.data[1], 7);
+        return f.data[0];
+    }
+}
+
+/* 처리 중인 요청 뒤에 쌓이는 요청 (ISR 문맥) */
+static uint64_t s_queued_us;
+
+static void prvInjectQueued(void *arg)
+{
+    static const uint8_t frame[8] = { 0x02, 0x3E, 0x00 };
+    (void)arg;
+    s_queued_us = HostSim_NowUs() + prvFrameUs();
+    (void)HostCAN_Inject(CAN1, UDS_REQ_CANID, frame, 8);
+}
+
+/* 0x14 직전: 다른 writer (write-back 등) 가 EEPROM 을 쥐고 있어 삭제 커밋이 기다림 */
+static void prvEeWriter(void *argument)
+{
+    static uint8_t buf[EE_BUSY_PAGES * 64u];
+    (void)argument;
+    memset(buf, 0x5A, sizeof(buf));
+    (void)BusMgr_Write(BusMgr_Find("eeprom0"), EE_BUSY_ADDR, buf, sizeof(buf));
+    osThreadExit();
+}
+
+static int prvIsNrc(const uint8_t *rsp, uint8_t n, uint8_t sid, uint8_t nrc)
+{
+    return n == 3u && rsp[0] == UDS_SID_NEGATIVE_RESPONSE && rsp[1] == sid && rsp[2] == nrc;
+}
+
+static uint32_t prvSeed(const uint8_t *rsp)
+{
+    return ((uint32_t)rsp[2] << 24) | ((uint32_t)rsp[3] << 16) | ((uint32_t)rsp[4] << 8) | rsp[5];
+}
+
+static uint8_t prvSendKey(uint32_t key, uint8_t *rsp)
+{
+    const uint8_t req[6] = { 0x27, 0x02, (uint8_t)(key >> 24), (uint8_t)(key >> 16), (uint8_t)(key >> 8), (uint8_t)key };
+    return prvExchange(req, 6, rsp, NULL);
+}
+
+static int prvCmpU32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void prvReport(void)
+{
+    for (uint32_t i = 0; i < 4u; i++) {
+        Dist_t *d = &s_dist[i];
+        if (d->n == 0u) continue;
+        qsort(d->us, d->n, sizeof(d->us[0]), prvCmpU32);
+        printf("%-15s: n=%3lu min=%5lu p50=%5lu p90=%5lu p99=%5lu max=%5lu us\n", d->name, (unsigned long)d->n,
+               (unsigned long)d->us[0], (unsigned long)d->us[d->n / 2u], (unsigned long)d->us[d->n * 9u / 10u],
+               (unsigned long)d->us[d->n * 99u / 100u], (unsigned long)d->us[d->n - 1u]);
+    }
+}
+
+static void prvTester(void *argument)
+{
+    uint8_t rsp[7], n;
+    uint32_t pend;
+    (void)argument;
+
+    osDelay(5);
+
+    /* 세션 */
+    static const uint8_t sess3[2] = { 0x10, 0x03 };
+    n = prvExchange(sess3, 2, rsp, NULL);
+    static const uint8_t sessRsp[6] = { 0x50, 0x03, 0x00, 0x32, 0x01, 0xF4 };
+    CHECK_END(n == 6u && memcmp(rsp, sessRsp, 6) == 0);
+    CHECK_END(dvfs.demand & DVFS_DEMAND_DIAG);
+
+    /* 보안: 잘못된 key → seed 없는 key → 정상 */
+    static const uint8_t seedReq[2] = { 0x27, 0x01 };
+    n = prvExchange(seedReq, 2, rsp, NULL);
+    CHECK_END(n == 6u && rsp[0] == 0x67 && prvSeed(rsp) != 0u);
+    n = prvSendKey(UDS_SecurityKey(prvSeed(rsp)) ^ 1u, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x27, UDS_NRC_INVALID_KEY));
+    n = prvSendKey(0x12345678u, rsp);
+    CHECK_END(prvIsNrc(rsp, n, 0x27, UDS_NRC_REQUEST_SEQUENCE_ERROR));
+    n = prvExchange(seedReq, 2, rsp, NULL);
+    n = prvSendKey(UDS_SecurityKey(prvSeed(rsp)), rsp);
+    CHECK_END(n == 2u && rsp[0] == 0x67 && rsp[1] == 0x02);
+    CHECK_END(udsServer.sa_unlocked == UDS_SA_LEVEL);
+    n = prvExchange(seedReq, 2, rsp, NULL);
+    CHECK_END(n == 6u && prvSeed(rsp) == 0u);               /* 이미 해제: seed 0 */
+
+    /* 부하 중 반복 요청 */
+    static const uint8_t tp[2] = { 0x3E, 0x00 };
+    static const uint8_t rd1[3] = { 0x19, 0x01, 0xFF };
+    static const uint8_t rd2[3] = { 0x19, 0x02, 0x08 };
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        switch (r % 3u) {
+        case 0:  n = prvExchange(tp, 2, rsp, NULL);  CHECK_END(n == 2u && rsp[0] == 0x7E); break;
+        case 1:  n = prvExchange(rd1, 3, rsp, NULL); CHECK_END(n == 6u && rsp[0] == 0x59 && rsp[5] == 5u); break;
+        default: n = prvExchange(rd2, 3, rsp, NULL); CHECK_END(n == 7u && rsp[0] == 0x59 && rsp[3] == 0xC1); break;
+        }
+        osDelay(ROUND_GAP_MS);
+    }
+
+    /* 긴 작업: DTC 삭제 (EEPROM 기록) → 0x78 후 최종 응답 */
+    static const uint8_t clr[4] = { 0x14, 0xFF, 0xFF, 0xFF };
+    const osThreadAttr_t writer_attributes = {
+      .name = "EeWriter", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityAboveNormal,
+    };
+    (void)osThreadNew(prvEeWriter, NULL, &writer_attributes);
+    osDelay(1);
+    uint64_t t0 = HostSim_NowUs();
+    HostSim_Schedule(20000u, prvInjectQueued, NULL);
+    n = prvExchange(clr, 4, rsp, &pend);
+    uint64_t clear_us = HostSim_NowUs() - t0;
+    CHECK_END(n == 1u && rsp[0] == 0x54);
+    CHECK_END(pend >= 1u);
+    CHECK_END(DTCMem_CountByMask(&dtcMem, 0xFF) == 0u);
+    HostCAN_Frame_t qf;
+    CHECK_END(prvRecv(&qf));
+    uint32_t queued_us = (uint32_t)(qf.t_us - s_queued_us);
+    CHECK_END(queued_us <= UDS_P2_SERVER_MS * 1000u);
+    if (prvIsPending(&qf)) {
+        CHECK_END(qf.data[2] == 0x3E);
+        s_pending++;
+        CHECK_END(prvRecv(&qf));
+    }
+    CHECK_END(qf.data[0] == 2u && qf.data[1] == 0x7E);
+
+    /* programming 세션은 부트로더에서만 */
+    static const uint8_t sess2[2] = { 0x10, 0x02 };
+    n = prvExchange(sess2, 2, rsp, NULL);
+    CHECK_END(prvIsNrc(rsp, n, 0x10, UDS_NRC_CONDITIONS_NOT_CORRECT));
+    CHECK_END(udsServer.session == UDS_SESSION_EXTENDED);
+
+    /* 보안 시도 초과 → 지연 (세션 재진입으로 다시 잠금) */
+    n = prvExchange(sess3, 2, rsp, NULL);
+    CHECK_END(n == 6u && udsServer.sa_unlocked == 0u);
+    for (uint32_t i = 0; i < UDS_SA_MAX_ATTEMPTS; i++) {
+        n = prvExchange(seedReq, 2, rsp, NULL);
+        n = prvSendKey(UDS_SecurityKey(prvSeed(rsp)) ^ 0x80u, rsp);
+        CHECK_END(prvIsNrc(rsp, n, 0x27, (i + 1u < UDS_SA_MAX_ATTEMPTS) ? UDS_NRC_INVALID_KEY : UDS_NRC_EXCEEDED_ATTEMPTS));
+    }
+    n = prvExchange(seedReq, 2, rsp, NULL);
+    CHECK_END(prvIsNrc(rsp, n, 0x27, UDS_NRC_TIME_DELAY_NOT_EXPIRED));
+
+    /* S3: TesterPresent 중단 */
+    uint32_t timeouts = udsServer.s3_timeouts;
+    osDelay(UDS_S3_SERVER_MS - 500u);
+    CHECK_END(udsServer.session == UDS_SESSION_EXTENDED);
+    osDelay(1000u);
+    CHECK_END(udsServer.session == UDS_SESSION_DEFAULT && udsServer.s3_timeouts == timeouts + 1u);
+    CHECK_END((dvfs.demand & DVFS_DEMAND_DIAG) == 0u);
+    n = prvExchange(seedReq, 2, rsp, NULL);
+    CHECK_END(prvIsNrc(rsp, n, 0x27, UDS_NRC_SERVICE_NOT_IN_SESSION));
+
+    prvReport();
+    printf("clear          : %lu us total, %lu x 0x78, queued 3E first resp %lu us\n", (unsigned long)clear_us,
+           (unsigned long)pend, (unsigned long)queued_us);
+    printf("max first resp : %lu us (P2server %u ms), max 0x78 -> next %lu us (P2*server %u ms)\n",
+           (unsigned long)s_max_first_us, UDS_P2_SERVER_MS, (unsigned long)s_max_final_us, UDS_P2X_SERVER_MS);
+    printf("server         : requests=%lu pending=%lu s3_timeouts=%lu\n", (unsigned long)udsServer.requests,
+           (unsigned long)udsServer.pending_sent, (unsigned long)udsServer.s3_timeouts);
+    CHECK_END(s_max_first_us <= UDS_P2_SERVER_MS * 1000u);
+    CHECK_END(s_max_final_us <= UDS_P2X_SERVER_MS * 1000u);
+    CHECK_END(udsServer.pending_sent == s_pending);
+    if (s_rc == 0) printf("PASS uds_timing\n");
+    vTaskEndScheduler();
+}
+
+/* DTC 5 개 (confirmed 1 개) */
+static void prvSeedDtcs(void)
+{
+    static DTCMem_t img;
+    static const uint8_t dtc[5][3] = { { 0xC1, 0x23, 0 }, { 0x05, 0x62, 0 }, { 0x05, 0x63, 0 }, { 0x01, 0x23, 0x45 }, { 0xD1, 0, 0 } };
+
+    uint16_t len = DTCMEM_BANK_SIZE;
+
+    for (uint32_t i = 0; i < 5u; i++) {
+        img.slot[i].used = 1;
+        memcpy(img.slot[i].dtc, dtc[i], 3);
+        img.slot[i].status = (i == 0u) ? 0x2F : 0x24;
+        img.slot[i].occurrence = 1;
+    }
+    (void)DTCMem_EncodeBank(&img, 1u, &g_eeprom.mem[DTCMEM_BANK_A], &len);
+    DTCMem_EncodeIndex(&img, 0u, 1u, (uint8_t)(len / DTC_PK_PAGE_SIZE), &g_eeprom.mem[DTCMEM_INDEX_ADDR]);
+}
+
+int main(void)
+{
+    HostBoard_Init();
+    prvSeedDtcs();
+    HostCAN_AddNode(CAN1, prvNode, NULL);
+    HostSim_Schedule(BG_PERIOD_US, prvBgEvt, NULL);
+
+    HostBoard_CreateTasks();
+    const osThreadAttr_t load_attributes = {
+      .name = "LoadTask", .stack_size = 128 * 4, .priority = (osPriority_t)osPriorityAboveNormal1,
+    };
+    osThreadNew(prvLoadTask, NULL, &load_attributes);
+    const osThreadAttr_t tester_attributes = {
+      .name = "Tester", .stack_size = 256 * 4, .priority = (osPriority_t)osPriorityRealtime,
+    };
+    s_tester = osThreadNew(prvTester, NULL, &tester_attributes);
+
+    HostBoard_Run(0u);
+    return s_rc;
+}
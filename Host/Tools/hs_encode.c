@@ -0,0 +1,101 @@
+/*
+ * hs_encode.c  (Host tools)
+ *
+ *  LZSS 압축 (hs_encode.h 참조)
+ */
+
+#include <stdlib.h>
+
+#include "hs_encode.h"
+
+#define HS_W          11u
+#define HS_L          4u
+#define HS_WINDOW     (1u << HS_W)
+#define HS_MAX_MATCH  (1u << HS_L)
+#define HS_MIN_MATCH  2u           /* 뒤 참조 16 비트 < literal 2 개 18 비트 */
+#define HS_CHAIN      256u         /* 같은 해시 후보 검사 수 */
+#define HS_HASH       65536u
+
+typedef struct
+{
+    uint8_t *out;
+    uint32_t max, pos;
+    uint8_t  mask;
+    int      overflow;
+} BitWriter_t;
+
+static void prvPut(BitWriter_t *w, uint32_t v, uint8_t n)
+{
+    while (n--) {
+        if (w->mask == 0u) {
+            if (w->pos >= w->max) { w->overflow = 1; return; }
+            w->out[w->pos++] = 0;
+            w->mask = 0x80u;
+        }
+        if ((v >> n) & 1u) w->out[w->pos - 1u] |= w->mask;
+        w->mask >>= 1;
+    }
+}
+
+static uint32_t prvHash(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 8) | p[1];
+}
+
+uint32_t HsEncode(const uint8_t *in, uint32_t len, uint8_t *out, uint32_t max)
+{
+    BitWriter_t w = { .out = out, .max = max };
+    int32_t *head = malloc(HS_HASH * sizeof(int32_t));
+    int32_t *prev = malloc((len ? len : 1u) * sizeof(int32_t));
+
+    if (head == NULL || prev == NULL) {
+        free(head);
+        free(prev);
+        return 0;
+    }
+    for (uint32_t i = 0; i < HS_HASH; i++) head[i] = -1;
+
+    uint32_t i = 0;
+    while (i < len && !w.overflow) {
+        uint32_t best_len = 0, best_dist = 0;
+        uint32_t limit = (len - i < HS_MAX_MATCH) ? len - i : HS_MAX_MATCH;
+
+        if (limit >= HS_MIN_MATCH) {
+            int32_t cand = head[prvHash(&in[i])];
+            for (uint32_t k = 0; k < HS_CHAIN && cand >= 0 && i - (uint32_t)cand <= HS_WINDOW; k++) {
+                uint32_t n = 0;
+                while (n < limit && in[(uint32_t)cand + n] == in[i + n]) n++;
+                if (n > best_len) {
+                    best_len = n;
+                    best_dist = i - (uint32_t)cand;
+                    if (n == limit) break;
+                }
+                cand = prev[cand];
+            }
+        }
+
+        uint32_t step;
+        if (best_len >= HS_MIN_MATCH) {
+            prvPut(&w, 0u, 1);
+            prvPut(&w, best_dist - 1u, HS_W);
+            prvPut(&w, best_len - 1u, HS_L);
+            step = best_len;
+        } else {
+            prvPut(&w, 1u, 1);
+            prvPut(&w, in[i], 8);
+            step = 1;
+        }
+        /* 지나간 위치를 해시 체인에 */
+        for (uint32_t e = i + step; i < e; i++) {
+            if (i + 1u < len) {
+                uint32_t h = prvHash(&in[i]);
+                prev[i] = head[h];
+                head[h] = (int32_t)i;
+            }
+        }
+    }
+
+    free(head);
+    free(prev);
+    return w.overflow ? 0u : w.pos;
+}
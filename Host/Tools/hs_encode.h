@@ -0,0 +1,28 @@
+/*
+ * hs_encode.h  (Host tools)
+ *
+ *  LZSS 압축 (heatshrink 비트스트림 -w 11 -l 4, Bootloader/Inc/HsDecode.h 와 짝).
+ *  테스터가 0x34 dataFormatIdentifier 0x10 으로 보낼 이미지를 미리 압축할 때 사용.
+ *  한 번에 전체 입력을 압축 (해시 체인 + greedy), 마지막 바이트의 남는 비트는 0.
+ */
+
+#ifndef HS_ENCODE_H_
+#define HS_ENCODE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 최악의 출력 크기 (전부 literal: 9 비트/바이트) */
+#define HS_ENCODE_BOUND(n)   ((n) + (n) / 8u + 2u)
+
+/* in[0, len) → out. 반환: 압축 크기, out 이 모자라면 0 */
+uint32_t HsEncode(const uint8_t *in, uint32_t len, uint8_t *out, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HS_ENCODE_H_ */
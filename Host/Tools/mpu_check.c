@@ -0,0 +1,166 @@
+/*
+ * mpu_check.c  (Host tool)
+ *
+ *  MPU region 배치 검사 (Core/Src/Mpu.c 의 Mpu_Layout 표)
+ *    usage: mpu_check [-m <fw.map>]
+ *
+ *  - 기본: 호스트 빌드의 배치 (타입 정렬/패딩이 같으므로 크기/정렬 규칙을 그대로 확인)
+ *  - -m: 타깃 링크 map (CubeIDE Debug/<이름>.map) 에서 같은 변수의 주소/크기를 찾아 검사
+ *        (.bss.<이름> 입력 섹션, 또는 COMMON 블록 안의 심볼 줄)
+ *  - 규칙: 크기 2^n (>= 32), base 가 크기로 정렬, 변수 크기 = region 크기 (이웃 변수 없음),
+ *          region 끼리 겹치지 않음, 파이프라인 slice 가 subregion 경계와 일치
+ *  출력: REGION n= name= base= size= obj= ok|bad  (타깃은 TARGET ...)
+ *  반환: 위반이 있으면 1
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Mpu.h"
+#include "Task.h"
+
+#define LINE_LEN     512u
+
+static uint32_t s_bad;
+
+static void prvReport(const char *tag, const Mpu_Region_t *r)
+{
+    int ok = (Mpu_CheckRegion(r) == HAL_OK);
+    printf("%s n=%u name=%s base=0x%08lx size=%lu obj=%lu %s\n", tag, (unsigned)r->region, r->name,
+           (unsigned long)r->base, (unsigned long)r->size, (unsigned long)r->obj_size, ok ? "ok" : "bad");
+    if (!ok) s_bad++;
+}
+
+static void prvOverlap(const char *tag, const Mpu_Region_t *r, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        for (uint32_t j = i + 1u; j < n; j++) {
+            if (r[i].region == r[j].region) {
+                printf("%s region %u used twice (%s, %s)\n", tag, (unsigned)r[i].region, r[i].name, r[j].name);
+                s_bad++;
+            }
+            if (r[i].base < r[j].base + r[j].size && r[j].base < r[i].base + r[i].size) {
+                printf("%s overlap %s / %s\n", tag, r[i].name, r[j].name);
+                s_bad++;
+            }
+        }
+    }
+}
+
+/* 파이프라인 slice: 멤버 위치 = slice 번호 * 32B, 크기 <= 32B */
+static void prvSlices(void)
+{
+    static const struct { const char *name; size_t off, size; uint32_t slice; } s[] = {
+        { "i2c", offsetof(Task_PipeBuf_t, i2c), sizeof(((Task_PipeBuf_t *)0)->i2c), MPU_SLICE_I2C },
+        { "spi", offsetof(Task_PipeBuf_t, spi), sizeof(((Task_PipeBuf_t *)0)->spi), MPU_SLICE_SPI },
+    };
+    for (uint32_t i = 0; i < sizeof(s) / sizeof(s[0]); i++) {
+        int ok = (s[i].off == s[i].slice * MPU_PIPE_SLICE) && (s[i].size <= MPU_PIPE_SLICE);
+        printf("SLICE name=pipeBuf.%s sub=%lu off=%lu size=%lu %s\n", s[i].name, (unsigned long)s[i].slice,
+               (unsigned long)s[i].off, (unsigned long)s[i].size, ok ? "ok" : "bad");
+        if (!ok) s_bad++;
+    }
+}
+
+/* ===== 타깃 map ===== */
+
+/* .bss.<name> / .data.<name>: 같은 줄 또는 다음 줄에 "addr size file" */
+static int prvMapSection(FILE *fp, const char *name, uint32_t *addr, uint32_t *size)
+{
+    char line[LINE_LEN], want[2][96];
+    snprintf(want[0], sizeof(want[0]), ".bss.%s", name);
+    snprintf(want[1], sizeof(want[1]), ".data.%s", name);
+
+    rewind(fp);
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char sec[160];
+        unsigned long long a, s;
+        int n = sscanf(line, " %159s %llx %llx", sec, &a, &s);
+        if (n < 1 || (strcmp(sec, want[0]) != 0 && strcmp(sec, want[1]) != 0)) continue;
+        if (n < 3) {
+            if (fgets(line, sizeof(line), fp) == NULL || sscanf(line, " %llx %llx", &a, &s) != 2) continue;
+        }
+        *addr = (uint32_t)a;
+        *size = (uint32_t)s;
+        return 0;
+    }
+    return -1;
+}
+
+/* COMMON 블록: "COMMON addr size file" 뒤에 "addr symbol" 줄들. 크기 = 다음 심볼(또는 블록 끝)까지 */
+static int prvMapCommon(FILE *fp, const char *name, uint32_t *addr, uint32_t *size)
+{
+    char line[LINE_LEN];
+    unsigned long long blkEnd = 0, found = 0;
+    int have = 0;
+
+    rewind(fp);
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char sym[160];
+        unsigned long long a, s;
+        if (sscanf(line, " COMMON %llx %llx", &a, &s) == 2) {
+            if (have) break;
+            blkEnd = a + s;
+            continue;
+        }
+        if (blkEnd == 0u || sscanf(line, " %llx %159s", &a, sym) != 2 || line[1] == '.') {
+            if (have) break;
+            continue;
+        }
+        if (have) { blkEnd = a; break; }
+        if (strcmp(sym, name) == 0) { found = a; have = 1; }
+    }
+    if (!have) return -1;
+    *addr = (uint32_t)found;
+    *size = (uint32_t)(blkEnd - found);
+    return 0;
+}
+
+static int prvCheckMap(const char *path, const Mpu_Region_t *host, uint32_t n)
+{
+    Mpu_Region_t tgt[MPU_SWITCH_REGIONS];
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) { perror(path); return -1; }
+
+    for (uint32_t i = 0; i < n; i++) {
+        tgt[i] = host[i];
+        if (prvMapSection(fp, host[i].name, &tgt[i].base, &tgt[i].obj_size) != 0 &&
+            prvMapCommon(fp, host[i].name, &tgt[i].base, &tgt[i].obj_size) != 0) {
+            printf("TARGET n=%u name=%s missing\n", (unsigned)host[i].region, host[i].name);
+            s_bad++;
+            tgt[i].base = 0u;
+            tgt[i].size = 0u;
+            continue;
+        }
+        prvReport("TARGET", &tgt[i]);
+    }
+    prvOverlap("TARGET", tgt, n);
+    fclose(fp);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *map = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-m") && i + 1 < argc) map = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-m fw.map]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    uint32_t n = 0;
+    const Mpu_Region_t *r = Mpu_Layout(&n);
+    for (uint32_t i = 0; i < n; i++) prvReport("REGION", &r[i]);
+    prvOverlap("REGION", r, n);
+    prvSlices();
+    if (map != NULL && prvCheckMap(map, r, n) != 0) return 2;
+
+    printf("regions=%lu bad=%lu\n", (unsigned long)n, (unsigned long)s_bad);
+    return s_bad ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+/*
+ * stack_report.c  (Host tool)
+ *
+ *  Task 별 최악 스택 사용량: GCC -fstack-usage (.su) + 디스어셈블 (objdump -d, CubeIDE 의 .list)
+ *    usage: stack_report -l <fw.list> [-r <'S' 덤프>] [-x ctx_bytes] [-m msp_bytes]
+ *                        [-t name=Entry:bytes ...] <*.su ...>
+ *
+ *  - 함수 프레임: .su 값. .su 가 없는 함수(라이브러리, 어셈블리)는 프롤로그의 push/stmdb/vpush/sub sp 로 추정
+ *  - 호출 그래프: bl/blx <심볼>, 다른 함수로의 b/b.w (꼬리 호출). blx rN (함수 포인터) 은 따라갈 수 없어 표시만
+ *  - Task 필요량 = 엔트리부터 최악 경로 합 + 문맥 저장 (-x, 기본 Cortex-M4F 최대: HW frame 26 + PendSV 25 word)
+ *  - MSP: 예외 핸들러 중 최악 1 개 + HW frame (중첩은 우선순위 그룹 수만큼 더해야 함),
+ *         스케줄러 시작 전 main (Reset_Handler 부터) 도 같은 예약 (-m, _Min_Stack_Size) 을 씀
+ *  - -r: StackMon_Dump 출력 (STACK/HEAP/MSP/OVF 줄) 의 실측 최소 여유를 같은 표에 붙임
+ *  요약 라인: TASK name=<Task> entry=<함수> size= static= need= margin= [free_min=] flags=
+ *  flags: indirect (함수 포인터 호출 미포함 → 하한), recursive, dynamic (VLA/alloca), guess (.su 없는 함수 포함)
+ *  반환: 필요량이 스택 크기를 넘는 Task 가 있으면 1
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_FUNCS    8192u
+#define MAX_TASKS    16u
+#define NAME_LEN     64u
+
+#define F_INDIRECT   (1u << 0)
+#define F_RECURSIVE  (1u << 1)
+#define F_DYNAMIC    (1u << 2)
+#define F_GUESS      (1u << 3)
+
+typedef struct {
+    char      name[NAME_LEN];
+    int32_t   frame;             // -1 = 아직 모름
+    int32_t   guess;             // 프롤로그 추정값
+    uint32_t  flags;             // 자기 자신
+    uint32_t *callee;
+    uint32_t  ncallee, cap;
+
+    uint8_t   state;             // DFS: 0 미방문 1 방문 중 2 완료
+    uint32_t  worst;             // 자신 + 최악 호출 경로
+    uint32_t  wflags;            // 경로 전체 flags
+    int32_t   next;              // 최악 경로의 다음 함수
+} Func_t;
+
+typedef struct {
+    char     name[NAME_LEN];
+    char     entry[NAME_LEN];
+    uint32_t size;
+    int32_t  free_min;           // -1 = 덤프 없음
+} Task_t;
+
+static Func_t   s_fn[MAX_FUNCS];
+static uint32_t s_nfn;
+
+/* Task.h 의 TASK_STACK_* 와 맞춤, 커널 Task 는 FreeRTOSConfig.h. 이름은 StackMon_Dump 형식 (공백 → '_') */
+static Task_t   s_task[MAX_TASKS] = {
+    { "defaultTask",   "StartDefaultTask",   128u * 4u, -1 },
+    { "I2CTask",       "StartI2CTask",       128u * 4u, -1 },
+    { "SPITask",       "StartSPITask",       128u * 4u, -1 },
+    { "CANTask",       "StartCANTask",       128u * 4u, -1 },
+    { "UARTTask",      "StartUARTTask",      192u * 4u, -1 },
+    { "SupplyMonTask", "StartSupplyMonTask", 128u * 4u, -1 },
+    { "DvfsTask",      "StartDvfsTask",      128u * 4u, -1 },
+    { "LogTask",       "StartLogTask",       192u * 4u, -1 },
+    { "EECacheTask",   "StartEECacheTask",   192u * 4u, -1 },
+    { "UDSTask",       "StartUDSTask",       256u * 4u, -1 },
+    { "IDLE",          "prvIdleTask",        128u * 4u, -1 },
+    { "Tmr_Svc",       "prvTimerTask",       256u * 4u, -1 },
+};
+static uint32_t s_ntask = 12u;
+
+static int32_t prvFind(const char *name)
+{
+    for (uint32_t i = 0; i < s_nfn; i++) {
+        if (strcmp(s_fn[i].name, name) == 0) return (int32_t)i;
+    }
+    return -1;
+}
+
+static int32_t prvGet(const char *name)
+{
+    int32_t i = prvFind(name);
+    if (i >= 0) return i;
+    if (s_nfn >= MAX_FUNCS) return -1;
+    Func_t *f = &s_fn[s_nfn];
+    snprintf(f->name, sizeof(f->name), "%.*s", (int)NAME_LEN - 1, name);
+    f->frame = -1;
+    f->next = -1;
+    return (int32_t)s_nfn++;
+}
+
+static void prvAddCall(Func_t *f, uint32_t to)
+{
+    for (uint32_t i = 0; i < f->ncallee; i++) {
+        if (f->callee[i] == to) return;
+    }
+    if (f->ncallee == f->cap) {
+        f->cap = f->cap ? f->cap * 2u : 8u;
+        f->callee = realloc(f->callee, f->cap * sizeof(uint32_t));
+        if (f->callee == NULL) { perror("realloc"); exit(2); }
+    }
+    f->callee[f->ncallee++] = to;
+}
+
+/* ===== .su: "<file>:<line>:<col>:<func>\t<bytes>\t<static|dynamic[,bounded]>" ===== */
+static int prvLoadSu(const char *path)
+{
+    char line[512];
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) { perror(path); return -1; }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char *tab = strchr(line, '\t');
+        if (tab == NULL) continue;
+        *tab = '\0';
+        char *name = strrchr(line, ':');
+        name = (name != NULL) ? name + 1 : line;
+
+        char qual[32] = "";
+        long bytes = 0;
+        if (sscanf(tab + 1, "%ld %31s", &bytes, qual) < 1) continue;
+
+        int32_t i = prvGet(name);
+        if (i < 0) break;
+        // static 함수가 파일마다 같은 이름이면 큰 쪽 (보수적)
+        if (bytes > s_fn[i].frame) s_fn[i].frame = (int32_t)bytes;
+        if (strncmp(qual, "dynamic", 7) == 0) s_fn[i].flags |= F_DYNAMIC;
+    }
+    fclose(fp);
+    return 0;
+}
+
+/* {r4, r5, lr} / {r4-r7, lr} / {s16-s31} → 레지스터 수 */
+static uint32_t prvRegCount(const char *list)
+{
+    uint32_t n = 0;
+    const char *p = strchr(list, '{');
+    if (p == NULL) return 0;
+
+    for (p++; *p != '\0' && *p != '}'; ) {
+        while (*p == ' ' || *p == ',') p++;
+        if (*p == '}' || *p == '\0') break;
+        int a = -1, b = -1;
+        if (isalpha((unsigned char)p[0]) && isdigit((unsigned char)p[1])) a = atoi(p + 1);
+        const char *dash = p;
+        while (*dash != '\0' && *dash != ',' && *dash != '}' && *dash != '-') dash++;
+        if (*dash == '-' && isalpha((unsigned char)dash[1])) b = atoi(dash + 2);
+        n += (a >= 0 && b >= a) ? (uint32_t)(b - a + 1) : 1u;
+        while (*p != '\0' && *p != ',' && *p != '}') p++;
+    }
+    return n;
+}
+
+/* ===== 디스어셈블: 함수 라벨 / 호출 / 프롤로그 ===== */
+static int prvLoadList(const char *path)
+{
+    char line[512];
+    int32_t cur = -1;
+    uint32_t insn = 0;          // 현재 함수에서 본 명령 수 (프롤로그는 앞쪽 몇 개만)
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) { perror(path); return -1; }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        unsigned long addr;
+        char name[NAME_LEN + 8];
+
+        // "08000b78 <StartDefaultTask>:"
+        if (sscanf(line, "%lx <%71[^>]>:", &addr, name) == 2 && strstr(line, ">:") != NULL) {
+            cur = prvGet(name);
+            insn = 0;
+            continue;
+        }
+        // " 8000b82:\tf005 fd27 \tbl\t80065d4 <osDelay>"
+        if (cur < 0 || line[0] != ' ') continue;
+        char *t1 = strchr(line, '\t');
+        char *t2 = (t1 != NULL) ? strchr(t1 + 1, '\t') : NULL;
+        if (t1 == NULL || t2 == NULL || strchr(line, ':') == NULL || strchr(line, ':') > t1) continue;
+
+        char mnem[16] = "", *ops = "";
+        char *t3 = strchr(t2 + 1, '\t');
+        if (t3 != NULL) { *t3 = '\0'; ops = t3 + 1; }
+        snprintf(mnem, sizeof(mnem), "%s", t2 + 1);
+        mnem[strcspn(mnem, "\r\n")] = '\0';
+        Func_t *f = &s_fn[cur];
+        insn++;
+
+        if (insn <= 6u) {
+            if (strcmp(mnem, "push") == 0 || strcmp(mnem, "push.w") == 0 ||
+                (strncmp(mnem, "stmdb", 5) == 0 && strncmp(ops, "sp!", 3) == 0)) {
+                f->guess += (int32_t)(4u * prvRegCount(ops));
+            } else if (strcmp(mnem, "vpush") == 0) {
+                f->guess += (int32_t)((strchr(ops, 'd') != NULL ? 8u : 4u) * prvRegCount(ops));
+            } else if ((strcmp(mnem, "sub") == 0 || strcmp(mnem, "sub.w") == 0 || strcmp(mnem, "subw") == 0) &&
+                       strncmp(ops, "sp,", 3) == 0) {
+                const char *imm = strchr(ops, '#');
+                if (imm != NULL) f->guess += (int32_t)strtol(imm + 1, NULL, 0);
+            }
+        }
+
+        int call = (strcmp(mnem, "bl") == 0 || strcmp(mnem, "blx") == 0);
+        int jump = (strcmp(mnem, "b") == 0 || strcmp(mnem, "b.w") == 0 || strcmp(mnem, "b.n") == 0);
+        if (!call && !jump) continue;
+
+        char *lt = strchr(ops, '<');
+        if (lt == NULL) {
+            if (strcmp(mnem, "blx") == 0) f->flags |= F_INDIRECT;     // blx rN
+            continue;
+        }
+        if (sscanf(lt, "<%71[^>]>", name) != 1) continue;
+        if (strchr(name, '+') != NULL) continue;                       // 함수 안쪽 분기
+        int32_t to = prvGet(name);
+        if (to < 0 || to == cur) {
+            if (to == cur && call) f->flags |= F_RECURSIVE;
+            continue;
+        }
+        prvAddCall(&s_fn[cur], (uint32_t)to);
+    }
+    fclose(fp);
+    return 0;
+}
+
+/* 최악 경로 (메모이즈 DFS). 순환은 끊고 recursive 표시 */
+static void prvWorst(uint32_t i)
+{
+    Func_t *f = &s_fn[i];
+    if (f->state == 2u) return;
+    if (f->state == 1u) { f->wflags |= F_RECURSIVE; return; }
+    f->state = 1u;
+
+    uint32_t own = (f->frame >= 0) ? (uint32_t)f->frame : (uint32_t)f->guess;
+    uint32_t best = 0, fl = f->flags | ((f->frame < 0) ? F_GUESS : 0u);
+    for (uint32_t k = 0; k < f->ncallee; k++) {
+        uint32_t c = f->callee[k];
+        if (s_fn[c].state == 1u) { fl |= F_RECURSIVE; continue; }
+        prvWorst(c);
+        fl |= s_fn[c].wflags;
+        if (s_fn[c].worst > best) { best = s_fn[c].worst; f->next = (int32_t)c; }
+    }
+    f->worst = own + best;
+    f->wflags |= fl;
+    f->state = 2u;
+}
+
+static void prvFlags(uint32_t fl, char *out, size_t n)
+{
+    snprintf(out, n, "%s%s%s%s%s",
+             (fl & F_INDIRECT) ? "indirect," : "", (fl & F_RECURSIVE) ? "recursive," : "",
+             (fl & F_DYNAMIC) ? "dynamic," : "", (fl & F_GUESS) ? "guess," : "", fl ? "" : "-");
+    size_t len = strlen(out);
+    if (len > 1u && out[len - 1u] == ',') out[len - 1u] = '\0';
+}
+
+static void prvPath(int32_t i)
+{
+    printf("  path:");
+    for (uint32_t depth = 0; i >= 0 && depth < 32u; depth++, i = s_fn[i].next) {
+        int32_t own = (s_fn[i].frame >= 0) ? s_fn[i].frame : s_fn[i].guess;
+        printf("%s %s(%ld%s)", depth ? " >" : "", s_fn[i].name, (long)own, (s_fn[i].frame < 0) ? "?" : "");
+    }
+    putchar('\n');
+}
+
+/* ===== StackMon_Dump: "STACK v=1 task=<name> free_min=<B>" 외 줄은 그대로 출력 ===== */
+static int prvLoadRuntime(const char *path)
+{
+    char line[256];
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) { perror(path); return -1; }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        unsigned v; long freeMin; char name[NAME_LEN];
+        const char *st = strstr(line, "STACK v=");     // UART 캡처: 앞에 원시 DTC 바이트가 붙을 수 있음
+        if (st != NULL && sscanf(st, "STACK v=%u task=%63[^ ] free_min=%ld", &v, name, &freeMin) == 3) {
+            for (uint32_t t = 0; t < s_ntask; t++) {
+                // configMAX_TASK_NAME_LEN(16) 로 잘린 이름도 일치
+                if (strncmp(s_task[t].name, name, 15) == 0) s_task[t].free_min = (int32_t)freeMin;
+            }
+        } else if (!strncmp(line, "HEAP ", 5) || !strncmp(line, "MSP ", 4) || !strncmp(line, "OVF ", 4)) {
+            fputs(line, stdout);
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+/* -t name=Entry:bytes (같은 이름이면 교체) */
+static int prvTaskArg(const char *arg)
+{
+    char name[NAME_LEN], entry[NAME_LEN];
+    unsigned long size;
+    if (sscanf(arg, "%63[^=]=%63[^:]:%lu", name, entry, &size) != 3) return -1;
+
+    uint32_t t;
+    for (t = 0; t < s_ntask && strcmp(s_task[t].name, name) != 0; t++) { }
+    if (t == s_ntask) {
+        if (s_ntask >= MAX_TASKS) return -1;
+        s_ntask++;
+    }
+    snprintf(s_task[t].name, NAME_LEN, "%s", name);
+    snprintf(s_task[t].entry, NAME_LEN, "%s", entry);
+    s_task[t].size = (uint32_t)size;
+    s_task[t].free_min = -1;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *list = NULL, *runtime = NULL;
+    uint32_t ctx = 204u, msp = 0x400u, nsu = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-l") && i + 1 < argc)      list = argv[++i];
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) runtime = argv[++i];
+        else if (!strcmp(argv[i], "-x") && i + 1 < argc) ctx = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) msp = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            if (prvTaskArg(argv[++i]) != 0) { fprintf(stderr, "bad -t %s\n", argv[i]); return 2; }
+        } else if (argv[i][0] != '-') {
+            if (prvLoadSu(argv[i]) != 0) return 2;
+            nsu++;
+        } else {
+            list = NULL;
+            break;
+        }
+    }
+    if (list == NULL || nsu == 0u) {
+        fprintf(stderr, "usage: %s -l <fw.list> [-r dump] [-x ctx_bytes] [-m msp_bytes] [-t name=Entry:bytes] <*.su ...>\n", argv[0]);
+        return 2;
+    }
+    if (prvLoadList(list) != 0) return 2;
+    if (runtime != NULL && prvLoadRuntime(runtime) != 0) return 2;
+
+    uint32_t over = 0;
+    for (uint32_t t = 0; t < s_ntask; t++) {
+        Task_t *tk = &s_task[t];
+        int32_t i = prvFind(tk->entry);
+        if (i < 0) {
+            printf("TASK name=%s entry=%s size=%lu static=? (엔트리 없음)\n", tk->name, tk->entry, (unsigned long)tk->size);
+            continue;
+        }
+        prvWorst((uint32_t)i);
+        uint32_t need = s_fn[i].worst + ctx;
+        long margin = (long)tk->size - (long)need;
+        char fl[64];
+        prvFlags(s_fn[i].wflags, fl, sizeof(fl));
+
+        printf("TASK name=%s entry=%s size=%lu static=%lu need=%lu margin=%ld",
+               tk->name, tk->entry, (unsigned long)tk->size, (unsigned long)s_fn[i].worst,
+               (unsigned long)need, margin);
+        if (tk->free_min >= 0) printf(" free_min=%ld", (long)tk->free_min);
+        printf(" flags=%s\n", fl);
+        prvPath(i);
+        if (margin < 0) over++;
+    }
+
+    /* MSP: 예외 핸들러 (Reset_Handler 제외) 최악 1 개, 스케줄러 전 main */
+    int32_t worstIrq = -1, boot = prvFind("Reset_Handler");
+    for (uint32_t i = 0; i < s_nfn; i++) {
+        size_t n = strlen(s_fn[i].name);
+        if (n < 8u || strcmp(&s_fn[i].name[n - 7u], "Handler") != 0 || (int32_t)i == boot) continue;
+        prvWorst(i);
+        if (worstIrq < 0 || s_fn[i].worst > s_fn[worstIrq].worst) worstIrq = (int32_t)i;
+    }
+    if (worstIrq >= 0) {
+        char fl[64];
+        // 예외 진입 HW frame (FPU 포함 26 word) 도 MSP 에 쌓임
+        uint32_t need = s_fn[worstIrq].worst + 104u, bootNeed = 0;
+        if (boot >= 0) { prvWorst((uint32_t)boot); bootNeed = s_fn[boot].worst; }
+        prvFlags(s_fn[worstIrq].wflags | ((boot >= 0) ? s_fn[boot].wflags : 0u), fl, sizeof(fl));
+        printf("MSP irq=%s need=%lu boot=%lu size=%lu margin=%ld flags=%s\n", s_fn[worstIrq].name,
+               (unsigned long)need, (unsigned long)bootNeed, (unsigned long)msp,
+               (long)msp - (long)((need > bootNeed) ? need : bootNeed), fl);
+        prvPath(worstIrq);
+        if (boot >= 0) prvPath(boot);
+        if (need > msp || bootNeed > msp) over++;
+    }
+
+    uint32_t nosu = 0;
+    for (uint32_t i = 0; i < s_nfn; i++) nosu += (s_fn[i].frame < 0);
+    printf("functions=%lu without_su=%lu ctx=%lu over=%lu\n",
+           (unsigned long)s_nfn, (unsigned long)nosu, (unsigned long)ctx, (unsigned long)over);
+    return over ? 1 : 0;
+}
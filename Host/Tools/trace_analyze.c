@@ -0,0 +1,212 @@
+/*
+ * trace_analyze.c  (Host tool)
+ *
+ *  Trace_Dump() 출력(타깃 UART 캡처 또는 fw_sim --trace)을 읽어
+ *  fault→bus 단계별 지연 히스토그램을 출력한다.
+ *    usage: trace_analyze <dump.txt>
+ *
+ *  시각: 덤프마다 직전 이벤트와의 부호 있는 cycle 차를 그 구간 클럭으로 환산해 누적.
+ *        구간 클럭은 DVFS_SWITCH(arg = from<<8 | to) 에서 DVFS_OppTable 로 바꾸고,
+ *        첫 전환 이전은 그 전환의 from (전환이 없으면 헤더 hz = 덤프 시점 클럭).
+ *  기준점: FAULT_INJECT 가 있으면 주입 시각, 없으면 해당 회차의 I2C_READ_START.
+ *  각 fault 에 대해 첫 FAULT_DECIDED 회차(arg)를 찾아 같은 회차의 이후 단계를 매칭.
+ *  요약 라인: LAT name=<단계> n=<표본> min_us= p50_us= p99_us= max_us=
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DVFS.h"
+#include "Trace.h"
+
+#define MAX_EVENTS   (1u << 20)
+#define MAX_SAMPLES  65536u
+#define NBUCKET      24u
+#define MAX_DUMPS    64u
+
+typedef struct { uint32_t ts; uint16_t ev; uint16_t arg; double us; } Ev_t;
+
+typedef struct {
+    const char *name;
+    double      us[MAX_SAMPLES];
+    uint32_t    n;
+} Stage_t;
+
+static Ev_t   s_ev[MAX_EVENTS];
+static uint32_t s_nev;
+static double s_hz = 16e6;
+static uint32_t s_dumpStart[MAX_DUMPS];     // 덤프별 첫 이벤트
+static double   s_dumpHz[MAX_DUMPS];
+static uint32_t s_ndump, s_nswitch;
+
+enum { ST_DETECT, ST_I2C_TO_DECIDE, ST_DECIDE_TO_EE, ST_DECIDE_TO_CAN, ST_DECIDE_TO_UART, ST_END_TO_END_CAN, ST_COUNT };
+static Stage_t s_stage[ST_COUNT] = {
+    { .name = "inject_to_decided" },
+    { .name = "i2c_start_to_decided" },
+    { .name = "decided_to_eeprom" },
+    { .name = "decided_to_can_tx" },
+    { .name = "decided_to_uart_tx" },
+    { .name = "fault_to_can_tx" },
+};
+
+static double prvUs(int from, int to)
+{
+    return s_ev[to].us - s_ev[from].us;
+}
+
+static double prvOppHz(uint32_t opp, double dflt)
+{
+    return (opp < DVFS_OPP_COUNT) ? (double)DVFS_OppTable[opp].sysclk_hz : dflt;
+}
+
+/* 덤프 구간마다 ts → us (선점으로 약간 뒤바뀐 이웃, CYCCNT wrap 허용) */
+static void prvTimeline(void)
+{
+    for (uint32_t d = 0; d < s_ndump; d++) {
+        uint32_t a = s_dumpStart[d], b = (d + 1u < s_ndump) ? s_dumpStart[d + 1u] : s_nev;
+        double hz = s_dumpHz[d];
+
+        for (uint32_t i = a; i < b; i++) {
+            if (s_ev[i].ev == TRACE_EV_DVFS_SWITCH) { hz = prvOppHz(s_ev[i].arg >> 8, hz); break; }
+        }
+        for (uint32_t i = a; i < b; i++) {
+            s_ev[i].us = (i == a) ? 0.0 : s_ev[i - 1u].us + (double)(int32_t)(s_ev[i].ts - s_ev[i - 1u].ts) * 1e6 / hz;
+            if (s_ev[i].ev == TRACE_EV_DVFS_SWITCH) {
+                hz = prvOppHz(s_ev[i].arg & 0xFFu, hz);
+                s_nswitch++;
+            }
+        }
+    }
+}
+
+static void prvAdd(int st, double us)
+{
+    if (s_stage[st].n < MAX_SAMPLES) s_stage[st].us[s_stage[st].n++] = us;
+}
+
+static int prvCmp(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* 회차 arg 에서 idx 이후 첫 ev 검색 */
+static int prvFind(uint32_t from, uint16_t ev, int matchArg, uint16_t arg)
+{
+    for (uint32_t i = from; i < s_nev; i++) {
+        if (s_ev[i].ev == ev && (!matchArg || s_ev[i].arg == arg)) return (int)i;
+    }
+    return -1;
+}
+
+static void prvReport(Stage_t *s)
+{
+    if (s->n == 0u) {
+        printf("LAT name=%s n=0\n", s->name);
+        return;
+    }
+    qsort(s->us, s->n, sizeof(double), prvCmp);
+
+    double p50 = s->us[(s->n - 1u) * 50u / 100u];
+    double p99 = s->us[(s->n - 1u) * 99u / 100u];
+    printf("LAT name=%s n=%u min_us=%.1f p50_us=%.1f p99_us=%.1f max_us=%.1f\n",
+           s->name, s->n, s->us[0], p50, p99, s->us[s->n - 1u]);
+
+    /* log2 버킷 (us) */
+    uint32_t bucket[NBUCKET] = {0}, peak = 1;
+    for (uint32_t i = 0; i < s->n; i++) {
+        uint32_t b = 0;
+        double v = s->us[i];
+        while (v >= 1.0 && b < NBUCKET - 1u) { v /= 2.0; b++; }
+        bucket[b]++;
+    }
+    for (uint32_t b = 0; b < NBUCKET; b++) if (bucket[b] > peak) peak = bucket[b];
+    for (uint32_t b = 0; b < NBUCKET; b++) {
+        if (bucket[b] == 0u) continue;
+        unsigned lo = (b == 0u) ? 0u : (1u << (b - 1u));
+        unsigned bar = (unsigned)((uint64_t)bucket[b] * 40u / peak);
+        printf("  [%7u, %7u) us %6u |", lo, 1u << b, bucket[b]);
+        for (unsigned k = 0; k < bar; k++) putchar('#');
+        putchar('\n');
+    }
+}
+
+int main(int argc, char **argv)
+{
+    char line[128];
+    FILE *fp;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace dump>\n", argv[0]);
+        return 2;
+    }
+    fp = fopen(argv[1], "r");
+    if (fp == NULL) { perror(argv[1]); return 2; }
+
+    /* 덤프가 여러 번 이어붙어 있어도 순서대로 읽는다 */
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        unsigned long ts, hz; unsigned ev, arg, v;
+        if (sscanf(line, "TRACE v=%u hz=%lu", &v, &hz) == 2) {
+            if (v != TRACE_FORMAT_VERSION) { fprintf(stderr, "unsupported trace v=%u\n", v); return 2; }
+            s_hz = (double)hz;
+            if (s_ndump < MAX_DUMPS) {
+                s_dumpStart[s_ndump] = s_nev;
+                s_dumpHz[s_ndump++] = s_hz;
+            }
+        } else if (sscanf(line, "E %lu %x %u", &ts, &ev, &arg) == 3 && s_nev < MAX_EVENTS) {
+            s_ev[s_nev++] = (Ev_t){ (uint32_t)ts, (uint16_t)ev, (uint16_t)arg };
+        }
+    }
+    fclose(fp);
+    if (s_ndump == 0u) { s_dumpStart[0] = 0; s_dumpHz[0] = s_hz; s_ndump = 1; }
+    prvTimeline();
+
+    uint32_t faults = 0;
+    int hasInject = (prvFind(0, TRACE_EV_FAULT_INJECT, 0, 0) >= 0);
+    for (uint32_t i = 0; i < s_nev; i++) {
+        int d, t0;
+        int injected = (s_ev[i].ev == TRACE_EV_FAULT_INJECT);
+
+        if (injected) {
+            /* 주입 이후 첫 판정 */
+            d = prvFind(i, TRACE_EV_FAULT_DECIDED, 0, 0);
+            if (d < 0) continue;
+            t0 = (int)i;
+            prvAdd(ST_DETECT, prvUs(t0, d));
+        } else if (s_ev[i].ev == TRACE_EV_FAULT_DECIDED) {
+            /* 주입 정보가 없는 타깃 덤프: 모든 판정 회차를 표본으로 */
+            if (hasInject) continue;
+            d = (int)i;
+            int st = -1;
+            for (int k = d; k >= 0; k--) {
+                if (s_ev[k].ev == TRACE_EV_I2C_READ_START && s_ev[k].arg == s_ev[d].arg) { st = k; break; }
+            }
+            if (st < 0) continue;
+            t0 = st;
+        } else {
+            continue;
+        }
+
+        uint16_t seq = s_ev[d].arg;
+        int td = d, k;
+        for (k = d; k >= 0; k--) {
+            if (s_ev[k].ev == TRACE_EV_I2C_READ_START && s_ev[k].arg == seq) {
+                prvAdd(ST_I2C_TO_DECIDE, prvUs(k, td));
+                break;
+            }
+        }
+        if ((k = prvFind((uint32_t)d, TRACE_EV_EE_WRITE_DONE, 1, seq)) >= 0) prvAdd(ST_DECIDE_TO_EE, prvUs(td, k));
+        if ((k = prvFind((uint32_t)d, TRACE_EV_CAN_TX_DONE, 1, seq)) >= 0) {
+            prvAdd(ST_DECIDE_TO_CAN, prvUs(td, k));
+            prvAdd(ST_END_TO_END_CAN, prvUs(t0, k));
+        }
+        if ((k = prvFind((uint32_t)d, TRACE_EV_UART_TX_DONE, 1, seq)) >= 0) prvAdd(ST_DECIDE_TO_UART, prvUs(td, k));
+        faults++;
+    }
+
+    printf("trace: %u events, %u faults, %.0f Hz, %u dvfs switches\n", s_nev, faults, s_hz, s_nswitch);
+    for (int st = 0; st < ST_COUNT; st++) prvReport(&s_stage[st]);
+
+    return (s_stage[ST_END_TO_END_CAN].n > 0u) ? 0 : 1;
+}
@@ -0,0 +1,281 @@
+/*
+ * uds_client.c  (Host tools)
+ *
+ *  UDS 테스터 (uds_client.h 참조)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "uds_client.h"
+#include "hs_encode.h"
+
+#define UDSC_N_BS_MS     1000u
+#define UDSC_N_CR_MS     1000u
+#define UDSC_WFT_MAX     8u
+#define UDSC_PAD         0xAAu
+
+void UdsClient_Init(UdsClient_t *c)
+{
+    c->p2_ms = 150u;              /* P2 50ms + 버스/테스터 지연 여유 */
+    c->p2x_ms = 5000u + 500u;
+}
+
+static uint64_t prvNow(UdsClient_t *c)
+{
+    return c->now_us != NULL ? c->now_us(c->ctx) : 0u;
+}
+
+static int prvSend(UdsClient_t *c, const uint8_t *frame)
+{
+    if (c->send(c->ctx, frame) != 0) return UDSC_ERR_LINK;
+    c->frames_tx++;
+    return UDSC_OK;
+}
+
+static int prvRecv(UdsClient_t *c, uint8_t *frame, uint32_t timeout_ms)
+{
+    if (c->recv(c->ctx, frame, timeout_ms) != 0) return UDSC_ERR_TIMEOUT;
+    c->frames_rx++;
+    return UDSC_OK;
+}
+
+static int prvSendFc(UdsClient_t *c, uint8_t fs)
+{
+    uint8_t fc[8] = { (uint8_t)(0x30u | fs), 0x00, 0x00, UDSC_PAD, UDSC_PAD, UDSC_PAD, UDSC_PAD, UDSC_PAD };
+    return prvSend(c, fc);
+}
+
+/* STmin → us (예약 값은 127ms) */
+static uint32_t prvStMinUs(uint8_t st)
+{
+    if (st <= 0x7Fu) return st * 1000u;
+    if (st >= 0xF1u && st <= 0xF9u) return (st - 0xF0u) * 100u;
+    return 127000u;
+}
+
+/* SF 또는 FF + (FC 대기 → CF 블록) */
+static int prvSendMsg(UdsClient_t *c, const uint8_t *msg, uint32_t len)
+{
+    uint8_t f[8];
+    int rc;
+
+    memset(f, UDSC_PAD, sizeof(f));
+    if (len <= 7u) {
+        f[0] = (uint8_t)len;
+        memcpy(&f[1], msg, len);
+        return prvSend(c, f);
+    }
+    if (len > UDSC_MAX_MSG) return UDSC_ERR_PROTO;
+    f[0] = (uint8_t)(0x10u | (len >> 8));
+    f[1] = (uint8_t)len;
+    memcpy(&f[2], msg, 6);
+    if ((rc = prvSend(c, f)) != UDSC_OK) return rc;
+
+    uint32_t pos = 6;
+    uint8_t sn = 1;
+    while (pos < len) {
+        uint32_t wft = 0;
+        for (;;) {
+            if ((rc = prvRecv(c, f, UDSC_N_BS_MS)) != UDSC_OK) return rc;
+            if ((f[0] & 0xF0u) != 0x30u) continue;
+            if ((f[0] & 0x0Fu) == 0x00u) break;
+            if ((f[0] & 0x0Fu) == 0x01u && ++wft <= UDSC_WFT_MAX) continue;
+            return UDSC_ERR_PROTO;                      /* OVFLW / 예약 */
+        }
+        uint8_t  bs = f[1];
+        uint32_t st = prvStMinUs(f[2]);
+        for (uint32_t blk = 0; pos < len && (bs == 0u || blk < bs); blk++) {
+            if (blk != 0u && st != 0u && c->delay_us != NULL) c->delay_us(c->ctx, st);
+            uint32_t n = (len - pos > 7u) ? 7u : len - pos;
+            memset(f, UDSC_PAD, sizeof(f));
+            f[0] = (uint8_t)(0x20u | sn);
+            memcpy(&f[1], &msg[pos], n);
+            if ((rc = prvSend(c, f)) != UDSC_OK) return rc;
+            pos += n;
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+        }
+    }
+    return UDSC_OK;
+}
+
+/* 응답 1 개 (SF 또는 FF + CF). 0x78 은 건너뛰고 P2* 로 계속 대기 */
+static int prvRecvMsg(UdsClient_t *c, uint8_t *rsp, uint32_t max)
+{
+    uint32_t timeout = c->p2_ms;
+    uint8_t f[8];
+    int rc;
+
+    for (;;) {
+        if ((rc = prvRecv(c, f, timeout)) != UDSC_OK) return rc;
+        uint8_t type = f[0] & 0xF0u;
+        if (type == 0x00u) {
+            uint32_t n = f[0] & 0x0Fu;
+            if (n == 0u || n > 7u || n > max) return UDSC_ERR_PROTO;
+            memcpy(rsp, &f[1], n);
+            if (n >= 3u && rsp[0] == 0x7Fu && rsp[2] == 0x78u) {
+                c->pending++;
+                timeout = c->p2x_ms;
+                continue;
+            }
+            return (int)n;
+        }
+        if (type != 0x10u) continue;                    /* 남은 FC 등 */
+
+        uint32_t total = ((uint32_t)(f[0] & 0x0Fu) << 8) | f[1];
+        if (total > max) {
+            (void)prvSendFc(c, 0x02u);
+            return UDSC_ERR_PROTO;
+        }
+        memcpy(rsp, &f[2], 6);
+        if ((rc = prvSendFc(c, 0x00u)) != UDSC_OK) return rc;
+        uint32_t pos = 6;
+        uint8_t sn = 1;
+        while (pos < total) {
+            if ((rc = prvRecv(c, f, UDSC_N_CR_MS)) != UDSC_OK) return rc;
+            if (f[0] != (0x20u | sn)) return UDSC_ERR_PROTO;
+            uint32_t n = (total - pos > 7u) ? 7u : total - pos;
+            memcpy(&rsp[pos], &f[1], n);
+            pos += n;
+            sn = (uint8_t)((sn + 1u) & 0x0Fu);
+        }
+        return (int)total;
+    }
+}
+
+int UdsClient_Request(UdsClient_t *c, const uint8_t *req, uint32_t len, uint8_t *rsp, uint32_t max)
+{
+    int rc;
+
+    c->requests++;
+    c->last_nrc = 0;
+    if ((rc = prvSendMsg(c, req, len)) != UDSC_OK) return rc;
+    if ((rc = prvRecvMsg(c, rsp, max)) < 0) return rc;
+    if (rc >= 3 && rsp[0] == 0x7Fu && rsp[1] == req[0]) {
+        c->last_nrc = rsp[2];
+        return UDSC_ERR_NRC;
+    }
+    if (rsp[0] != (uint8_t)(req[0] + 0x40u)) return UDSC_ERR_PROTO;
+    return rc;
+}
+
+uint32_t UdsClient_Crc32(uint32_t crc, const uint8_t *p, uint32_t len)
+{
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+static void prvPut32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* 요청 1 개, 실패하면 rep->failed_sid */
+static int prvStep(UdsClient_t *c, UdsClient_Report_t *rep, const uint8_t *req, uint32_t len,
+                   uint8_t *rsp, uint32_t max)
+{
+    int rc = UdsClient_Request(c, req, len, rsp, max);
+    if (rc < 0) rep->failed_sid = req[0];
+    return rc;
+}
+
+/* 10 02 → 31 → 34 → 36 (data) → 37 → 11 01 */
+static int prvDownload(UdsClient_t *c, uint32_t addr, const uint8_t *data, uint32_t size,
+                       UdsClient_Report_t *rep, uint8_t *req)
+{
+    uint8_t rsp[16];
+    int rc;
+    uint64_t t0 = prvNow(c), t;
+
+    req[0] = 0x10; req[1] = 0x02;
+    if ((rc = prvStep(c, rep, req, 2, rsp, sizeof(rsp))) < 0) return rc;
+    t = prvNow(c);
+    rep->t_session_us = t - t0;
+
+    req[0] = 0x31; req[1] = 0x01; req[2] = 0xFF; req[3] = 0x00; req[4] = 0x44;
+    prvPut32(&req[5], addr);
+    prvPut32(&req[9], size);
+    if ((rc = prvStep(c, rep, req, 13, rsp, sizeof(rsp))) < 0) return rc;
+    rep->t_erase_us = prvNow(c) - t;
+    t = prvNow(c);
+
+    req[0] = 0x34; req[1] = rep->dfi; req[2] = 0x44;
+    prvPut32(&req[3], addr);
+    prvPut32(&req[7], size);
+    if ((rc = prvStep(c, rep, req, 11, rsp, sizeof(rsp))) < 0) return rc;
+    uint32_t nlen = rsp[1] >> 4, maxlen = 0;
+    if (rc < (int)(2u + nlen) || nlen == 0u || nlen > 4u) {
+        rep->failed_sid = 0x34;
+        return UDSC_ERR_PROTO;
+    }
+    for (uint32_t i = 0; i < nlen; i++) maxlen = (maxlen << 8) | rsp[2u + i];
+    if (maxlen > UDSC_MAX_MSG) maxlen = UDSC_MAX_MSG;
+    rep->block_len = (maxlen - 2u) & ~3u;               /* 마지막 블록 외에는 word 배수 */
+    if (maxlen < 6u) {
+        rep->failed_sid = 0x34;
+        return UDSC_ERR_PROTO;
+    }
+
+    uint8_t bsc = 1;
+    for (uint32_t pos = 0; pos < rep->sent; pos += rep->block_len, bsc++) {
+        uint32_t n = (rep->sent - pos > rep->block_len) ? rep->block_len : rep->sent - pos;
+        req[0] = 0x36;
+        req[1] = bsc;
+        memcpy(&req[2], &data[pos], n);
+        if ((rc = prvStep(c, rep, req, 2u + n, rsp, sizeof(rsp))) < 0) return rc;
+        if (rc < 2 || rsp[1] != bsc) {
+            rep->failed_sid = 0x36;
+            return UDSC_ERR_PROTO;
+        }
+        rep->blocks++;
+    }
+    rep->t_transfer_us = prvNow(c) - t;
+    t = prvNow(c);
+
+    req[0] = 0x37;
+    prvPut32(&req[1], rep->crc);
+    if ((rc = prvStep(c, rep, req, 5, rsp, sizeof(rsp))) < 0) return rc;
+    if (rc != 5 || rsp[1] != req[1] || rsp[2] != req[2] || rsp[3] != req[3] || rsp[4] != req[4]) {
+        rep->failed_sid = 0x37;
+        return UDSC_ERR_PROTO;
+    }
+    rep->t_exit_us = prvNow(c) - t;
+
+    req[0] = 0x11; req[1] = 0x01;
+    if ((rc = prvStep(c, rep, req, 2, rsp, sizeof(rsp))) < 0) return rc;
+    rep->t_total_us = prvNow(c) - t0;
+    return UDSC_OK;
+}
+
+int UdsClient_Download(UdsClient_t *c, uint32_t addr, const uint8_t *img, uint32_t size,
+                       UdsClient_Report_t *rep)
+{
+    static uint8_t req[UDSC_MAX_MSG];
+    int rc;
+
+    memset(rep, 0, sizeof(*rep));
+    rep->crc = UdsClient_Crc32(0, img, size);
+
+    /* 압축: 원래보다 작을 때만 (0x34 memorySize 는 그대로 원래 크기) */
+    const uint8_t *data = img;
+    uint8_t *packed = NULL;
+    rep->sent = size;
+    if (c->compress && (packed = malloc(HS_ENCODE_BOUND(size))) != NULL) {
+        uint32_t n = HsEncode(img, size, packed, HS_ENCODE_BOUND(size));
+        if (n != 0u && n < size) {
+            data = packed;
+            rep->sent = n;
+            rep->dfi = UDSC_DFI_HEATSHRINK;
+        }
+    }
+    rc = prvDownload(c, addr, data, size, rep, req);
+    free(packed);
+    return rc;
+}
@@ -0,0 +1,72 @@
+/*
+ * uds_client.h  (Host tools)
+ *
+ *  UDS 테스터 (ISO 14229 클라이언트 + ISO-TP 8B, normal addressing).
+ *  CAN 프레임 송수신은 주입: uds_flash (SocketCAN) / 시뮬레이션 테스터 (HostCAN).
+ *  RTOS/HAL 에 의존하지 않음.
+ */
+
+#ifndef UDS_CLIENT_H_
+#define UDS_CLIENT_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UDSC_OK           0
+#define UDSC_ERR_TIMEOUT  (-1)
+#define UDSC_ERR_NRC      (-2)     /* 부정 응답: last_nrc */
+#define UDSC_ERR_PROTO    (-3)     /* 잘못된 프레임/응답 */
+#define UDSC_ERR_LINK     (-4)     /* 송신 실패 */
+
+#define UDSC_MAX_MSG      4095u    /* ISO-TP FF 12 비트 */
+#define UDSC_DFI_HEATSHRINK 0x10u  /* hs_encode.h */
+
+typedef struct
+{
+    void *ctx;
+    /* 8B 프레임 1 개 송신 (요청 ID). 0 = 성공 */
+    int  (*send)(void *ctx, const uint8_t *frame);
+    /* 응답 ID 프레임 1 개 대기. 0 = 수신, <0 = 시간 초과 */
+    int  (*recv)(void *ctx, uint8_t *frame, uint32_t timeout_ms);
+    /* STmin 대기 (0 이면 호출 안 함) / 경과 시간 (보고용) */
+    void (*delay_us)(void *ctx, uint32_t us);
+    uint64_t (*now_us)(void *ctx);
+
+    uint32_t p2_ms;                /* 기본 50 + 여유 */
+    uint32_t p2x_ms;               /* 0x78 이후 */
+    uint8_t  compress;             /* Download: 압축해서 보냄 (0x34 DFI 0x10, 더 작을 때만) */
+
+    uint8_t  last_nrc;
+    uint32_t requests, pending, frames_tx, frames_rx;
+} UdsClient_t;
+
+/* 다운로드 결과 (시간 us) */
+typedef struct
+{
+    uint32_t block_len;            /* 0x34 응답 maxNumberOfBlockLength - 2 */
+    uint32_t blocks;
+    uint8_t  dfi;                  /* 보낸 dataFormatIdentifier */
+    uint32_t sent;                 /* 0x36 데이터 바이트 (압축이면 압축 크기) */
+    uint32_t crc;
+    uint64_t t_session_us, t_erase_us, t_transfer_us, t_exit_us, t_total_us;
+    uint8_t  failed_sid;           /* 실패한 요청 (0 = 성공) */
+} UdsClient_Report_t;
+
+/* p2/p2x 기본값 설정 */
+void     UdsClient_Init(UdsClient_t *c);
+/* 요청 → 최종 응답 (0x78 대기 포함). 반환: 응답 길이 (부정 응답이면 UDSC_ERR_NRC), <0 오류 */
+int      UdsClient_Request(UdsClient_t *c, const uint8_t *req, uint32_t len, uint8_t *rsp, uint32_t max);
+/* 10 02 → 31 01 FF00 (erase) → 34 → 36... → 37 crc → 11 01. crc 는 항상 원래 이미지 기준 */
+int      UdsClient_Download(UdsClient_t *c, uint32_t addr, const uint8_t *img, uint32_t size,
+                            UdsClient_Report_t *rep);
+/* CRC-32 (IEEE, zlib 과 같음) */
+uint32_t UdsClient_Crc32(uint32_t crc, const uint8_t *p, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDS_CLIENT_H_ */
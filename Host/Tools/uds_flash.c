@@ -0,0 +1,171 @@
+/*
+ * uds_flash.c  (Host tools, Linux SocketCAN)
+ *
+ *  CAN 부트로더로 앱 이미지 다운로드 (uds_client.c).
+ *  요청 0x7E0 / 응답 0x7E8, 클래식 CAN 8B. ECU 는 부트로더에 있어야 함
+ *  (앱이 유효하면 전원 투입 후 부팅 창 50ms 안에 10 02 를 보내거나, 앱이 없는 상태).
+ *    usage: uds_flash -i can0 [-a addr] [-t] [-z] image.bin
+ *      -a  시작 주소 (기본 0x08010000, 앱 벡터 테이블)
+ *      -t  부팅 창을 잡기 위해 응답이 올 때까지 10 02 를 반복 (ECU 전원 투입 전에 실행)
+ *      -z  압축 전송 (0x34 DFI 0x10, 압축해서 더 작을 때만)
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+#include "uds_client.h"
+
+#define REQ_CANID    0x7E0u
+#define RES_CANID    0x7E8u
+#define APP_START    0x08010000u
+#define APP_MAX      (1472u * 1024u)
+
+static int prvSend(void *ctx, const uint8_t *frame)
+{
+    struct can_frame f = { .can_id = REQ_CANID, .can_dlc = 8 };
+    int s = *(int *)ctx;
+
+    memcpy(f.data, frame, 8);
+    for (int retry = 0; retry < 100; retry++) {
+        if (write(s, &f, sizeof(f)) == (ssize_t)sizeof(f)) return 0;
+        if (errno != ENOBUFS && errno != EAGAIN) return -1;
+        usleep(200);                               /* 소켓 TX 큐 가득 참 */
+    }
+    return -1;
+}
+
+static int prvRecv(void *ctx, uint8_t *frame, uint32_t timeout_ms)
+{
+    struct pollfd p = { .fd = *(int *)ctx, .events = POLLIN };
+    struct can_frame f;
+
+    if (poll(&p, 1, (int)timeout_ms) <= 0) return -1;
+    if (read(p.fd, &f, sizeof(f)) != (ssize_t)sizeof(f)) return -1;
+    memset(frame, 0, 8);
+    memcpy(frame, f.data, f.can_dlc > 8 ? 8 : f.can_dlc);
+    return 0;
+}
+
+static void prvDelay(void *ctx, uint32_t us)
+{
+    (void)ctx;
+    usleep(us);
+}
+
+static uint64_t prvNow(void *ctx)
+{
+    struct timespec ts;
+    (void)ctx;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static int prvOpen(const char *ifname)
+{
+    struct sockaddr_can addr = { .can_family = AF_CAN };
+    struct can_filter flt = { .can_id = RES_CANID, .can_mask = CAN_SFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG };
+    struct ifreq ifr;
+    int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+
+    if (s < 0) return -1;
+    memset(&ifr, 0, sizeof(ifr));
+    snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", ifname);
+    if (ioctl(s, SIOCGIFINDEX, &ifr) < 0) { close(s); return -1; }
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (setsockopt(s, SOL_CAN_RAW, CAN_RAW_FILTER, &flt, sizeof(flt)) < 0 ||
+        bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(s);
+        return -1;
+    }
+    return s;
+}
+
+static uint8_t *prvLoad(const char *path, uint32_t *size)
+{
+    FILE *fp = fopen(path, "rb");
+    uint8_t *img;
+    long n;
+
+    if (fp == NULL) return NULL;
+    if (fseek(fp, 0, SEEK_END) != 0 || (n = ftell(fp)) <= 0 || n > (long)APP_MAX) { fclose(fp); return NULL; }
+    rewind(fp);
+    img = malloc((size_t)n);
+    if (img != NULL && fread(img, 1, (size_t)n, fp) != (size_t)n) { free(img); img = NULL; }
+    fclose(fp);
+    *size = (uint32_t)n;
+    return img;
+}
+
+int main(int argc, char **argv)
+{
+    const char *ifname = NULL, *path = NULL;
+    uint32_t addr = APP_START, size = 0;
+    int wait_boot = 0, compress = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-i") && i + 1 < argc) ifname = argv[++i];
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) addr = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-t")) wait_boot = 1;
+        else if (!strcmp(argv[i], "-z")) compress = 1;
+        else if (argv[i][0] != '-' && path == NULL) path = argv[i];
+        else path = NULL, ifname = NULL, i = argc;
+    }
+    if (ifname == NULL || path == NULL) {
+        fprintf(stderr, "usage: %s -i can0 [-a addr] [-t] [-z] image.bin\n", argv[0]);
+        return 2;
+    }
+
+    uint8_t *img = prvLoad(path, &size);
+    if (img == NULL) {
+        fprintf(stderr, "%s: cannot read image (max %u bytes)\n", path, APP_MAX);
+        return 1;
+    }
+    int s = prvOpen(ifname);
+    if (s < 0) {
+        perror(ifname);
+        free(img);
+        return 1;
+    }
+
+    UdsClient_t c = { .ctx = &s, .send = prvSend, .recv = prvRecv, .delay_us = prvDelay, .now_us = prvNow };
+    UdsClient_Init(&c);
+    c.compress = (uint8_t)compress;
+
+    if (wait_boot) {
+        /* 부팅 창 (50ms) 안에 들어가도록 5ms 간격으로 10 02 */
+        static const uint8_t req[2] = { 0x10, 0x02 };
+        uint8_t rsp[8];
+        uint32_t p2 = c.p2_ms;
+        c.p2_ms = 5;
+        while (UdsClient_Request(&c, req, 2, rsp, sizeof(rsp)) < 0) { }
+        c.p2_ms = p2;
+        printf("bootloader: programming session\n");
+    }
+
+    UdsClient_Report_t rep;
+    int rc = UdsClient_Download(&c, addr, img, size, &rep);
+    if (rc != UDSC_OK) {
+        fprintf(stderr, "download failed: sid 0x%02X rc %d nrc 0x%02X\n", rep.failed_sid, rc, c.last_nrc);
+    } else {
+        double sec = (double)rep.t_transfer_us / 1e6;
+        printf("%u bytes @ 0x%08X, crc %08X, %u blocks x %u B, sent %u B (dfi 0x%02X)\n",
+               size, addr, rep.crc, rep.blocks, rep.block_len, rep.sent, rep.dfi);
+        printf("session %.3f s, erase %.3f s, transfer %.3f s (%.1f KB/s), exit %.3f s, total %.3f s\n",
+               rep.t_session_us / 1e6, rep.t_erase_us / 1e6, sec, sec > 0 ? size / 1024.0 / sec : 0.0,
+               rep.t_exit_us / 1e6, rep.t_total_us / 1e6);
+    }
+    close(s);
+    free(img);
+    return rc == UDSC_OK ? 0 : 1;
+}